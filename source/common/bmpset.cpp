@@ -23,14 +23,151 @@
 #include "cmemory.h"
 #include "bmpset.h"
 #include "uassert.h"
+#include "umutex.h"
+
+/*
+ * U_BMPSET_USE_SSSE3 enables the vectorized ASCII spans.
+ * They are compiled for SSSE3 with function target attributes and selected
+ * at runtime, so the library still runs on CPUs without SSSE3.
+ * Define it to 0 to use only the scalar code.
+ */
+#ifndef U_BMPSET_USE_SSSE3
+#   if (defined(__x86_64__) || defined(__i386__)) && \
+        (U_GCC_MAJOR_MINOR >= 409 || defined(__clang__))
+#       define U_BMPSET_USE_SSSE3 1
+#   else
+#       define U_BMPSET_USE_SSSE3 0
+#   endif
+#endif
+
+#if U_BMPSET_USE_SSSE3
+#include <tmmintrin.h>
+#endif
 
 U_NAMESPACE_BEGIN
 
+#if U_BMPSET_USE_SSSE3
+
+static UBool gHaveSSSE3 = FALSE;
+static UInitOnce gHaveSSSE3InitOnce = U_INITONCE_INITIALIZER;
+
+static void U_CALLCONV initHaveSSSE3() {
+    __builtin_cpu_init();
+    gHaveSSSE3 = __builtin_cpu_supports("ssse3") != 0;
+}
+
+static inline UBool haveSSSE3() {
+    umtx_initOnce(gHaveSSSE3InitOnce, &initHaveSSSE3);
+    return gHaveSSSE3;
+}
+
+/*
+ * Returns a 16-bit mask with one bit set for each of the 16 bytes
+ * where an ASCII span must stop:
+ * at non-ASCII bytes, and at ASCII characters c with contains(c)!=spanCondition.
+ * The lower nibble of each byte selects an asciiBitmap[] byte,
+ * and the upper nibble selects one of its bits.
+ */
+__attribute__((target("ssse3")))
+static inline uint32_t
+asciiStopMask(__m128i bytes, __m128i bitmap, USetSpanCondition spanCondition) {
+    const __m128i nibbleMask=_mm_set1_epi8(0xf);
+    // Bytes with the high bit set select 0 bits, as if not contained.
+    const __m128i bitValues=_mm_setr_epi8(1, 2, 4, 8, 0x10, 0x20, 0x40, (char)0x80,
+                                          0, 0, 0, 0, 0, 0, 0, 0);
+    __m128i rows=_mm_shuffle_epi8(bitmap, _mm_and_si128(bytes, nibbleMask));
+    __m128i bits=_mm_shuffle_epi8(bitValues, _mm_and_si128(_mm_srli_epi16(bytes, 4), nibbleMask));
+    uint32_t notContained=
+        (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(rows, bits), _mm_setzero_si128()));
+    if(spanCondition) {
+        return notContained;
+    } else {
+        return (~notContained&0xffff)|(uint32_t)_mm_movemask_epi8(bytes);
+    }
+}
+
+/*
+ * Packs 16 UTF-16 code units into bytes, with 0x80 for each non-ASCII code unit.
+ */
+__attribute__((target("ssse3")))
+static inline __m128i
+packASCIIUnits(const UChar *s) {
+    const __m128i nonASCIIMask=_mm_set1_epi16((short)0xff80);
+    __m128i u0=_mm_loadu_si128((const __m128i *)s);
+    __m128i u1=_mm_loadu_si128((const __m128i *)(s+8));
+    __m128i ascii0=_mm_cmpeq_epi16(_mm_and_si128(u0, nonASCIIMask), _mm_setzero_si128());
+    __m128i ascii1=_mm_cmpeq_epi16(_mm_and_si128(u1, nonASCIIMask), _mm_setzero_si128());
+    u0=_mm_or_si128(_mm_and_si128(ascii0, u0), _mm_andnot_si128(ascii0, _mm_set1_epi16(0x80)));
+    u1=_mm_or_si128(_mm_and_si128(ascii1, u1), _mm_andnot_si128(ascii1, _mm_set1_epi16(0x80)));
+    return _mm_packus_epi16(u0, u1);
+}
+
+/*
+ * The ASCII span functions check 16 characters at a time
+ * and stop before a remainder of fewer than 16.
+ * They return where the caller has to continue with the scalar code.
+ */
+__attribute__((target("ssse3")))
+static const uint8_t *
+spanASCII(const uint8_t asciiBitmap[16], const uint8_t *s, const uint8_t *limit,
+          USetSpanCondition spanCondition) {
+    __m128i bitmap=_mm_loadu_si128((const __m128i *)asciiBitmap);
+    for(; (limit-s)>=16; s+=16) {
+        uint32_t stop=asciiStopMask(_mm_loadu_si128((const __m128i *)s), bitmap, spanCondition);
+        if(stop!=0) {
+            return s+__builtin_ctz(stop);
+        }
+    }
+    return s;
+}
+
+__attribute__((target("ssse3")))
+static const UChar *
+spanASCII(const uint8_t asciiBitmap[16], const UChar *s, const UChar *limit,
+          USetSpanCondition spanCondition) {
+    __m128i bitmap=_mm_loadu_si128((const __m128i *)asciiBitmap);
+    for(; (limit-s)>=16; s+=16) {
+        uint32_t stop=asciiStopMask(packASCIIUnits(s), bitmap, spanCondition);
+        if(stop!=0) {
+            return s+__builtin_ctz(stop);
+        }
+    }
+    return s;
+}
+
+__attribute__((target("ssse3")))
+static const uint8_t *
+spanBackASCII(const uint8_t asciiBitmap[16], const uint8_t *s, const uint8_t *limit,
+              USetSpanCondition spanCondition) {
+    __m128i bitmap=_mm_loadu_si128((const __m128i *)asciiBitmap);
+    for(; (limit-s)>=16; limit-=16) {
+        uint32_t stop=asciiStopMask(_mm_loadu_si128((const __m128i *)(limit-16)), bitmap, spanCondition);
+        if(stop!=0) {
+            return limit+16-__builtin_clz(stop);  // after the last stop byte
+        }
+    }
+    return limit;
+}
+
+__attribute__((target("ssse3")))
+static const UChar *
+spanBackASCII(const uint8_t asciiBitmap[16], const UChar *s, const UChar *limit,
+              USetSpanCondition spanCondition) {
+    __m128i bitmap=_mm_loadu_si128((const __m128i *)asciiBitmap);
+    for(; (limit-s)>=16; limit-=16) {
+        uint32_t stop=asciiStopMask(packASCIIUnits(limit-16), bitmap, spanCondition);
+        if(stop!=0) {
+            return limit+16-__builtin_clz(stop);  // after the last stop unit
+        }
+    }
+    return limit;
+}
+
+#endif
+
 BMPSet::BMPSet(const int32_t *parentList, int32_t parentListLength) :
-        list(parentList), listLength(parentListLength) {
-    uprv_memset(asciiBytes, 0, sizeof(asciiBytes));
-    uprv_memset(table7FF, 0, sizeof(table7FF));
-    uprv_memset(bmpBlockBits, 0, sizeof(bmpBlockBits));
+        tables(&ownTables), list(parentList), listLength(parentListLength) {
+    uprv_memset(&ownTables, 0, sizeof(ownTables));
 
     /*
      * Set the list indexes for binary searches for
@@ -39,23 +176,24 @@ BMPSet::BMPSet(const int32_t *parentList, int32_t parentListLength) :
      * looked up in the bit tables.
      * The last pair of indexes is for finding supplementary code points.
      */
-    list4kStarts[0]=findCodePoint(0x800, 0, listLength-1);
+    ownTables.list4kStarts[0]=findCodePoint(0x800, 0, listLength-1);
     int32_t i;
     for(i=1; i<=0x10; ++i) {
-        list4kStarts[i]=findCodePoint(i<<12, list4kStarts[i-1], listLength-1);
+        ownTables.list4kStarts[i]=findCodePoint(i<<12, ownTables.list4kStarts[i-1], listLength-1);
     }
-    list4kStarts[0x11]=listLength-1;
+    ownTables.list4kStarts[0x11]=listLength-1;
 
     initBits();
     overrideIllegal();
 }
 
 BMPSet::BMPSet(const BMPSet &otherBMPSet, const int32_t *newParentList, int32_t newParentListLength) :
-        list(newParentList), listLength(newParentListLength) {
-    uprv_memcpy(asciiBytes, otherBMPSet.asciiBytes, sizeof(asciiBytes));
-    uprv_memcpy(table7FF, otherBMPSet.table7FF, sizeof(table7FF));
-    uprv_memcpy(bmpBlockBits, otherBMPSet.bmpBlockBits, sizeof(bmpBlockBits));
-    uprv_memcpy(list4kStarts, otherBMPSet.list4kStarts, sizeof(list4kStarts));
+        tables(&ownTables), list(newParentList), listLength(newParentListLength) {
+    uprv_memcpy(&ownTables, otherBMPSet.tables, sizeof(ownTables));
+}
+
+BMPSet::BMPSet(const BMPSetTables *aliasTables, const int32_t *parentList, int32_t parentListLength) :
+        tables(aliasTables), list(parentList), listLength(parentListLength) {
 }
 
 BMPSet::~BMPSet() {
@@ -120,7 +258,7 @@ void BMPSet::initBits() {
     UChar32 start, limit;
     int32_t listIndex=0;
 
-    // Set asciiBytes[].
+    // Set ownTables.asciiBytes[].
     do {
         start=list[listIndex++];
         if(listIndex<listLength) {
@@ -132,13 +270,14 @@ void BMPSet::initBits() {
             break;
         }
         do {
-            asciiBytes[start++]=1;
+            ownTables.asciiBitmap[start&0xf]|=(uint8_t)(1<<(start>>4));
+            ownTables.asciiBytes[start++]=1;
         } while(start<limit && start<0x80);
     } while(limit<=0x80);
 
-    // Set table7FF[].
+    // Set ownTables.table7FF[].
     while(start<0x800) {
-        set32x64Bits(table7FF, start, limit<=0x800 ? limit : 0x800);
+        set32x64Bits(ownTables.table7FF, start, limit<=0x800 ? limit : 0x800);
         if(limit>0x800) {
             start=0x800;
             break;
@@ -152,7 +291,7 @@ void BMPSet::initBits() {
         }
     }
 
-    // Set bmpBlockBits[].
+    // Set ownTables.bmpBlockBits[].
     int32_t minStart=0x800;
     while(start<0x10000) {
         if(limit>0x10000) {
@@ -166,20 +305,20 @@ void BMPSet::initBits() {
             if(start&0x3f) {
                 // Mixed-value block of 64 code points.
                 start>>=6;
-                bmpBlockBits[start&0x3f]|=0x10001<<(start>>6);
+                ownTables.bmpBlockBits[start&0x3f]|=0x10001<<(start>>6);
                 start=(start+1)<<6;  // Round up to the next block boundary.
                 minStart=start;      // Ignore further ranges in this block.
             }
             if(start<limit) {
                 if(start<(limit&~0x3f)) {
                     // Multiple all-ones blocks of 64 code points each.
-                    set32x64Bits(bmpBlockBits, start>>6, limit>>6);
+                    set32x64Bits(ownTables.bmpBlockBits, start>>6, limit>>6);
                 }
 
                 if(limit&0x3f) {
                     // Mixed-value block of 64 code points.
                     limit>>=6;
-                    bmpBlockBits[limit&0x3f]|=0x10001<<(limit>>6);
+                    ownTables.bmpBlockBits[limit&0x3f]|=0x10001<<(limit>>6);
                     limit=(limit+1)<<6;  // Round up to the next block boundary.
                     minStart=limit;      // Ignore further ranges in this block.
                 }
@@ -204,39 +343,39 @@ void BMPSet::initBits() {
  * for faster validity checking at runtime.
  * No need to set 0 values where they were reset to 0 in the constructor
  * and not modified by initBits().
- * (asciiBytes[] trail bytes, table7FF[] 0..7F, bmpBlockBits[] 0..7FF)
+ * (ownTables.asciiBytes[] trail bytes, ownTables.table7FF[] 0..7F, ownTables.bmpBlockBits[] 0..7FF)
  * Need to set 0 values for surrogates D800..DFFF.
  */
 void BMPSet::overrideIllegal() {
     uint32_t bits, mask;
     int32_t i;
 
-    if(containsSlow(0xfffd, list4kStarts[0xf], list4kStarts[0x10])) {
+    if(containsSlow(0xfffd, ownTables.list4kStarts[0xf], ownTables.list4kStarts[0x10])) {
         // contains(FFFD)==TRUE
         for(i=0x80; i<0xc0; ++i) {
-            asciiBytes[i]=1;
+            ownTables.asciiBytes[i]=1;
         }
 
         bits=3;                 // Lead bytes 0xC0 and 0xC1.
         for(i=0; i<64; ++i) {
-            table7FF[i]|=bits;
+            ownTables.table7FF[i]|=bits;
         }
 
         bits=1;                 // Lead byte 0xE0.
         for(i=0; i<32; ++i) {   // First half of 4k block.
-            bmpBlockBits[i]|=bits;
+            ownTables.bmpBlockBits[i]|=bits;
         }
 
         mask=~(0x10001<<0xd);   // Lead byte 0xED.
         bits=1<<0xd;
         for(i=32; i<64; ++i) {  // Second half of 4k block.
-            bmpBlockBits[i]=(bmpBlockBits[i]&mask)|bits;
+            ownTables.bmpBlockBits[i]=(ownTables.bmpBlockBits[i]&mask)|bits;
         }
     } else {
         // contains(FFFD)==FALSE
         mask=~(0x10001<<0xd);   // Lead byte 0xED.
         for(i=32; i<64; ++i) {  // Second half of 4k block.
-            bmpBlockBits[i]&=mask;
+            ownTables.bmpBlockBits[i]&=mask;
         }
     }
 }
@@ -277,24 +416,25 @@ int32_t BMPSet::findCodePoint(UChar32 c, int32_t lo, int32_t hi) const {
 
 UBool
 BMPSet::contains(UChar32 c) const {
+    const BMPSetTables &t=*tables;  // Keeps the tables pointer in a register.
     if((uint32_t)c<=0x7f) {
-        return (UBool)asciiBytes[c];
+        return (UBool)t.asciiBytes[c];
     } else if((uint32_t)c<=0x7ff) {
-        return (UBool)((table7FF[c&0x3f]&((uint32_t)1<<(c>>6)))!=0);
+        return (UBool)((t.table7FF[c&0x3f]&((uint32_t)1<<(c>>6)))!=0);
     } else if((uint32_t)c<0xd800 || (c>=0xe000 && c<=0xffff)) {
         int lead=c>>12;
-        uint32_t twoBits=(bmpBlockBits[(c>>6)&0x3f]>>lead)&0x10001;
+        uint32_t twoBits=(t.bmpBlockBits[(c>>6)&0x3f]>>lead)&0x10001;
         if(twoBits<=1) {
             // All 64 code points with the same bits 15..6
             // are either in the set or not.
             return (UBool)twoBits;
         } else {
             // Look up the code point in its 4k block of code points.
-            return containsSlow(c, list4kStarts[lead], list4kStarts[lead+1]);
+            return containsSlow(c, t.list4kStarts[lead], t.list4kStarts[lead+1]);
         }
     } else if((uint32_t)c<=0x10ffff) {
         // surrogate or supplementary code point
-        return containsSlow(c, list4kStarts[0xd], list4kStarts[0x11]);
+        return containsSlow(c, t.list4kStarts[0xd], t.list4kStarts[0x11]);
     } else {
         // Out-of-range code points get FALSE, consistent with long-standing
         // behavior of UnicodeSet::contains(c).
@@ -308,23 +448,32 @@ BMPSet::contains(UChar32 c) const {
  */
 const UChar *
 BMPSet::span(const UChar *s, const UChar *limit, USetSpanCondition spanCondition) const {
+    const BMPSetTables &t=*tables;  // Keeps the tables pointer in a register.
     UChar c, c2;
+#if U_BMPSET_USE_SSSE3
+    UBool useSSSE3=haveSSSE3();
+#endif
 
     if(spanCondition) {
         // span
         do {
             c=*s;
             if(c<=0x7f) {
-                if(!asciiBytes[c]) {
+                if(!t.asciiBytes[c]) {
                     break;
                 }
+#if U_BMPSET_USE_SSSE3
+                if(useSSSE3 && (limit-s)>16) {
+                    s=spanASCII(t.asciiBitmap, s+1, limit, USET_SPAN_CONTAINED)-1;
+                }
+#endif
             } else if(c<=0x7ff) {
-                if((table7FF[c&0x3f]&((uint32_t)1<<(c>>6)))==0) {
+                if((t.table7FF[c&0x3f]&((uint32_t)1<<(c>>6)))==0) {
                     break;
                 }
             } else if(c<0xd800 || c>=0xe000) {
                 int lead=c>>12;
-                uint32_t twoBits=(bmpBlockBits[(c>>6)&0x3f]>>lead)&0x10001;
+                uint32_t twoBits=(t.bmpBlockBits[(c>>6)&0x3f]>>lead)&0x10001;
                 if(twoBits<=1) {
                     // All 64 code points with the same bits 15..6
                     // are either in the set or not.
@@ -333,18 +482,18 @@ BMPSet::span(const UChar *s, const UChar *limit, USetSpanCondition spanCondition
                     }
                 } else {
                     // Look up the code point in its 4k block of code points.
-                    if(!containsSlow(c, list4kStarts[lead], list4kStarts[lead+1])) {
+                    if(!containsSlow(c, t.list4kStarts[lead], t.list4kStarts[lead+1])) {
                         break;
                     }
                 }
             } else if(c>=0xdc00 || (s+1)==limit || (c2=s[1])<0xdc00 || c2>=0xe000) {
                 // surrogate code point
-                if(!containsSlow(c, list4kStarts[0xd], list4kStarts[0xe])) {
+                if(!containsSlow(c, t.list4kStarts[0xd], t.list4kStarts[0xe])) {
                     break;
                 }
             } else {
                 // surrogate pair
-                if(!containsSlow(U16_GET_SUPPLEMENTARY(c, c2), list4kStarts[0x10], list4kStarts[0x11])) {
+                if(!containsSlow(U16_GET_SUPPLEMENTARY(c, c2), t.list4kStarts[0x10], t.list4kStarts[0x11])) {
                     break;
                 }
                 ++s;
@@ -355,16 +504,21 @@ BMPSet::span(const UChar *s, const UChar *limit, USetSpanCondition spanCondition
         do {
             c=*s;
             if(c<=0x7f) {
-                if(asciiBytes[c]) {
+                if(t.asciiBytes[c]) {
                     break;
                 }
+#if U_BMPSET_USE_SSSE3
+                if(useSSSE3 && (limit-s)>16) {
+                    s=spanASCII(t.asciiBitmap, s+1, limit, USET_SPAN_NOT_CONTAINED)-1;
+                }
+#endif
             } else if(c<=0x7ff) {
-                if((table7FF[c&0x3f]&((uint32_t)1<<(c>>6)))!=0) {
+                if((t.table7FF[c&0x3f]&((uint32_t)1<<(c>>6)))!=0) {
                     break;
                 }
             } else if(c<0xd800 || c>=0xe000) {
                 int lead=c>>12;
-                uint32_t twoBits=(bmpBlockBits[(c>>6)&0x3f]>>lead)&0x10001;
+                uint32_t twoBits=(t.bmpBlockBits[(c>>6)&0x3f]>>lead)&0x10001;
                 if(twoBits<=1) {
                     // All 64 code points with the same bits 15..6
                     // are either in the set or not.
@@ -373,18 +527,18 @@ BMPSet::span(const UChar *s, const UChar *limit, USetSpanCondition spanCondition
                     }
                 } else {
                     // Look up the code point in its 4k block of code points.
-                    if(containsSlow(c, list4kStarts[lead], list4kStarts[lead+1])) {
+                    if(containsSlow(c, t.list4kStarts[lead], t.list4kStarts[lead+1])) {
                         break;
                     }
                 }
             } else if(c>=0xdc00 || (s+1)==limit || (c2=s[1])<0xdc00 || c2>=0xe000) {
                 // surrogate code point
-                if(containsSlow(c, list4kStarts[0xd], list4kStarts[0xe])) {
+                if(containsSlow(c, t.list4kStarts[0xd], t.list4kStarts[0xe])) {
                     break;
                 }
             } else {
                 // surrogate pair
-                if(containsSlow(U16_GET_SUPPLEMENTARY(c, c2), list4kStarts[0x10], list4kStarts[0x11])) {
+                if(containsSlow(U16_GET_SUPPLEMENTARY(c, c2), t.list4kStarts[0x10], t.list4kStarts[0x11])) {
                     break;
                 }
                 ++s;
@@ -397,23 +551,32 @@ BMPSet::span(const UChar *s, const UChar *limit, USetSpanCondition spanCondition
 /* Symmetrical with span(). */
 const UChar *
 BMPSet::spanBack(const UChar *s, const UChar *limit, USetSpanCondition spanCondition) const {
+    const BMPSetTables &t=*tables;  // Keeps the tables pointer in a register.
     UChar c, c2;
+#if U_BMPSET_USE_SSSE3
+    UBool useSSSE3=haveSSSE3();
+#endif
 
     if(spanCondition) {
         // span
         for(;;) {
             c=*(--limit);
             if(c<=0x7f) {
-                if(!asciiBytes[c]) {
+                if(!t.asciiBytes[c]) {
                     break;
                 }
+#if U_BMPSET_USE_SSSE3
+                if(useSSSE3 && (limit-s)>=16) {
+                    limit=spanBackASCII(t.asciiBitmap, s, limit, USET_SPAN_CONTAINED);
+                }
+#endif
             } else if(c<=0x7ff) {
-                if((table7FF[c&0x3f]&((uint32_t)1<<(c>>6)))==0) {
+                if((t.table7FF[c&0x3f]&((uint32_t)1<<(c>>6)))==0) {
                     break;
                 }
             } else if(c<0xd800 || c>=0xe000) {
                 int lead=c>>12;
-                uint32_t twoBits=(bmpBlockBits[(c>>6)&0x3f]>>lead)&0x10001;
+                uint32_t twoBits=(t.bmpBlockBits[(c>>6)&0x3f]>>lead)&0x10001;
                 if(twoBits<=1) {
                     // All 64 code points with the same bits 15..6
                     // are either in the set or not.
@@ -422,18 +585,18 @@ BMPSet::spanBack(const UChar *s, const UChar *limit, USetSpanCondition spanCondi
                     }
                 } else {
                     // Look up the code point in its 4k block of code points.
-                    if(!containsSlow(c, list4kStarts[lead], list4kStarts[lead+1])) {
+                    if(!containsSlow(c, t.list4kStarts[lead], t.list4kStarts[lead+1])) {
                         break;
                     }
                 }
             } else if(c<0xdc00 || s==limit || (c2=*(limit-1))<0xd800 || c2>=0xdc00) {
                 // surrogate code point
-                if(!containsSlow(c, list4kStarts[0xd], list4kStarts[0xe])) {
+                if(!containsSlow(c, t.list4kStarts[0xd], t.list4kStarts[0xe])) {
                     break;
                 }
             } else {
                 // surrogate pair
-                if(!containsSlow(U16_GET_SUPPLEMENTARY(c2, c), list4kStarts[0x10], list4kStarts[0x11])) {
+                if(!containsSlow(U16_GET_SUPPLEMENTARY(c2, c), t.list4kStarts[0x10], t.list4kStarts[0x11])) {
                     break;
                 }
                 --limit;
@@ -447,16 +610,21 @@ BMPSet::spanBack(const UChar *s, const UChar *limit, USetSpanCondition spanCondi
         for(;;) {
             c=*(--limit);
             if(c<=0x7f) {
-                if(asciiBytes[c]) {
+                if(t.asciiBytes[c]) {
                     break;
                 }
+#if U_BMPSET_USE_SSSE3
+                if(useSSSE3 && (limit-s)>=16) {
+                    limit=spanBackASCII(t.asciiBitmap, s, limit, USET_SPAN_NOT_CONTAINED);
+                }
+#endif
             } else if(c<=0x7ff) {
-                if((table7FF[c&0x3f]&((uint32_t)1<<(c>>6)))!=0) {
+                if((t.table7FF[c&0x3f]&((uint32_t)1<<(c>>6)))!=0) {
                     break;
                 }
             } else if(c<0xd800 || c>=0xe000) {
                 int lead=c>>12;
-                uint32_t twoBits=(bmpBlockBits[(c>>6)&0x3f]>>lead)&0x10001;
+                uint32_t twoBits=(t.bmpBlockBits[(c>>6)&0x3f]>>lead)&0x10001;
                 if(twoBits<=1) {
                     // All 64 code points with the same bits 15..6
                     // are either in the set or not.
@@ -465,18 +633,18 @@ BMPSet::spanBack(const UChar *s, const UChar *limit, USetSpanCondition spanCondi
                     }
                 } else {
                     // Look up the code point in its 4k block of code points.
-                    if(containsSlow(c, list4kStarts[lead], list4kStarts[lead+1])) {
+                    if(containsSlow(c, t.list4kStarts[lead], t.list4kStarts[lead+1])) {
                         break;
                     }
                 }
             } else if(c<0xdc00 || s==limit || (c2=*(limit-1))<0xd800 || c2>=0xdc00) {
                 // surrogate code point
-                if(containsSlow(c, list4kStarts[0xd], list4kStarts[0xe])) {
+                if(containsSlow(c, t.list4kStarts[0xd], t.list4kStarts[0xe])) {
                     break;
                 }
             } else {
                 // surrogate pair
-                if(containsSlow(U16_GET_SUPPLEMENTARY(c2, c), list4kStarts[0x10], list4kStarts[0x11])) {
+                if(containsSlow(U16_GET_SUPPLEMENTARY(c2, c), t.list4kStarts[0x10], t.list4kStarts[0x11])) {
                     break;
                 }
                 --limit;
@@ -495,24 +663,37 @@ BMPSet::spanBack(const UChar *s, const UChar *limit, USetSpanCondition spanCondi
  */
 const uint8_t *
 BMPSet::spanUTF8(const uint8_t *s, int32_t length, USetSpanCondition spanCondition) const {
+    const BMPSetTables &t=*tables;  // Keeps the tables pointer in a register.
     const uint8_t *limit=s+length;
     uint8_t b=*s;
+#if U_BMPSET_USE_SSSE3
+    UBool useSSSE3=haveSSSE3();
+#endif
     if((int8_t)b>=0) {
         // Initial all-ASCII span.
+#if U_BMPSET_USE_SSSE3
+        if(useSSSE3) {
+            s=spanASCII(t.asciiBitmap, s, limit, spanCondition);
+            if(s==limit) {
+                return s;
+            }
+            b=*s;
+        }
+#endif
         if(spanCondition) {
-            do {
-                if(!asciiBytes[b] || ++s==limit) {
+            while((int8_t)b>=0) {
+                if(!t.asciiBytes[b] || ++s==limit) {
                     return s;
                 }
                 b=*s;
-            } while((int8_t)b>=0);
+            }
         } else {
-            do {
-                if(asciiBytes[b] || ++s==limit) {
+            while((int8_t)b>=0) {
+                if(t.asciiBytes[b] || ++s==limit) {
                     return s;
                 }
                 b=*s;
-            } while((int8_t)b>=0);
+            }
         }
         length=(int32_t)(limit-s);
     }
@@ -540,20 +721,20 @@ BMPSet::spanUTF8(const uint8_t *s, int32_t length, USetSpanCondition spanConditi
             // single trail byte, check for preceding 3- or 4-byte lead byte
             if(length>=2 && (b=*(limit-2))>=0xe0) {
                 limit-=2;
-                if(asciiBytes[0x80]!=spanCondition) {
+                if(t.asciiBytes[0x80]!=spanCondition) {
                     limit0=limit;
                 }
             } else if(b<0xc0 && b>=0x80 && length>=3 && (b=*(limit-3))>=0xf0) {
                 // 4-byte lead byte with only two trail bytes
                 limit-=3;
-                if(asciiBytes[0x80]!=spanCondition) {
+                if(t.asciiBytes[0x80]!=spanCondition) {
                     limit0=limit;
                 }
             }
         } else {
             // lead byte with no trail bytes
             --limit;
-            if(asciiBytes[0x80]!=spanCondition) {
+            if(t.asciiBytes[0x80]!=spanCondition) {
                 limit0=limit;
             }
         }
@@ -565,24 +746,33 @@ BMPSet::spanUTF8(const uint8_t *s, int32_t length, USetSpanCondition spanConditi
         b=*s;
         if(b<0xc0) {
             // ASCII; or trail bytes with the result of contains(FFFD).
+#if U_BMPSET_USE_SSSE3
+            if(useSSSE3 && b<0x80) {
+                s=spanASCII(t.asciiBitmap, s, limit, spanCondition);
+                if(s==limit) {
+                    return limit0;
+                }
+                b=*s;
+            }
+#endif
             if(spanCondition) {
-                do {
-                    if(!asciiBytes[b]) {
+                while(b<0xc0) {
+                    if(!t.asciiBytes[b]) {
                         return s;
                     } else if(++s==limit) {
                         return limit0;
                     }
                     b=*s;
-                } while(b<0xc0);
+                }
             } else {
-                do {
-                    if(asciiBytes[b]) {
+                while(b<0xc0) {
+                    if(t.asciiBytes[b]) {
                         return s;
                     } else if(++s==limit) {
                         return limit0;
                     }
                     b=*s;
-                } while(b<0xc0);
+                }
             }
         }
         ++s;  // Advance past the lead byte.
@@ -593,7 +783,7 @@ BMPSet::spanUTF8(const uint8_t *s, int32_t length, USetSpanCondition spanConditi
                     (t2=(uint8_t)(s[1]-0x80)) <= 0x3f
                 ) {
                     b&=0xf;
-                    uint32_t twoBits=(bmpBlockBits[t1]>>b)&0x10001;
+                    uint32_t twoBits=(t.bmpBlockBits[t1]>>b)&0x10001;
                     if(twoBits<=1) {
                         // All 64 code points with this lead byte and middle trail byte
                         // are either in the set or not.
@@ -603,7 +793,7 @@ BMPSet::spanUTF8(const uint8_t *s, int32_t length, USetSpanCondition spanConditi
                     } else {
                         // Look up the code point in its 4k block of code points.
                         UChar32 c=(b<<12)|(t1<<6)|t2;
-                        if(containsSlow(c, list4kStarts[b], list4kStarts[b+1]) != spanCondition) {
+                        if(containsSlow(c, t.list4kStarts[b], t.list4kStarts[b+1]) != spanCondition) {
                             return s-1;
                         }
                     }
@@ -618,8 +808,8 @@ BMPSet::spanUTF8(const uint8_t *s, int32_t length, USetSpanCondition spanConditi
                 // Give an illegal sequence the same value as the result of contains(FFFD).
                 UChar32 c=((UChar32)(b-0xf0)<<18)|((UChar32)t1<<12)|(t2<<6)|t3;
                 if( (   (0x10000<=c && c<=0x10ffff) ?
-                            containsSlow(c, list4kStarts[0x10], list4kStarts[0x11]) :
-                            asciiBytes[0x80]
+                            containsSlow(c, t.list4kStarts[0x10], t.list4kStarts[0x11]) :
+                            t.asciiBytes[0x80]
                     ) != spanCondition
                 ) {
                     return s-1;
@@ -631,7 +821,7 @@ BMPSet::spanUTF8(const uint8_t *s, int32_t length, USetSpanCondition spanConditi
             if( /* handle U+0000..U+07FF inline */
                 (t1=(uint8_t)(*s-0x80)) <= 0x3f
             ) {
-                if((USetSpanCondition)((table7FF[t1]&((uint32_t)1<<(b&0x1f)))!=0) != spanCondition) {
+                if((USetSpanCondition)((t.table7FF[t1]&((uint32_t)1<<(b&0x1f)))!=0) != spanCondition) {
                     return s-1;
                 }
                 ++s;
@@ -642,7 +832,7 @@ BMPSet::spanUTF8(const uint8_t *s, int32_t length, USetSpanCondition spanConditi
         // Give an illegal sequence the same value as the result of contains(FFFD).
         // Handle each byte of an illegal sequence separately to simplify the code;
         // no need to optimize error handling.
-        if(asciiBytes[0x80]!=spanCondition) {
+        if(t.asciiBytes[0x80]!=spanCondition) {
             return s-1;
         }
     }
@@ -659,34 +849,49 @@ BMPSet::spanUTF8(const uint8_t *s, int32_t length, USetSpanCondition spanConditi
  */
 int32_t
 BMPSet::spanBackUTF8(const uint8_t *s, int32_t length, USetSpanCondition spanCondition) const {
+    const BMPSetTables &t=*tables;  // Keeps the tables pointer in a register.
     if(spanCondition!=USET_SPAN_NOT_CONTAINED) {
         spanCondition=USET_SPAN_CONTAINED;  // Pin to 0/1 values.
     }
 
     uint8_t b;
+#if U_BMPSET_USE_SSSE3
+    UBool useSSSE3=haveSSSE3();
+#endif
 
     do {
         b=s[--length];
         if((int8_t)b>=0) {
             // ASCII sub-span
+#if U_BMPSET_USE_SSSE3
+            if(useSSSE3 && length>=16) {
+                // s[length] is the last byte to be checked.
+                int32_t start=(int32_t)(spanBackASCII(t.asciiBitmap, s, s+length+1, spanCondition)-s);
+                if(start==0) {
+                    return 0;
+                }
+                length=start-1;
+                b=s[length];
+            }
+#endif
             if(spanCondition) {
-                do {
-                    if(!asciiBytes[b]) {
+                while((int8_t)b>=0) {
+                    if(!t.asciiBytes[b]) {
                         return length+1;
                     } else if(length==0) {
                         return 0;
                     }
                     b=s[--length];
-                } while((int8_t)b>=0);
+                }
             } else {
-                do {
-                    if(asciiBytes[b]) {
+                while((int8_t)b>=0) {
+                    if(t.asciiBytes[b]) {
                         return length+1;
                     } else if(length==0) {
                         return 0;
                     }
                     b=s[--length];
-                } while((int8_t)b>=0);
+                }
             }
         }
 
@@ -697,12 +902,12 @@ BMPSet::spanBackUTF8(const uint8_t *s, int32_t length, USetSpanCondition spanCon
         c=utf8_prevCharSafeBody(s, 0, &length, b, -3);
         // c is a valid code point, not ASCII, not a surrogate
         if(c<=0x7ff) {
-            if((USetSpanCondition)((table7FF[c&0x3f]&((uint32_t)1<<(c>>6)))!=0) != spanCondition) {
+            if((USetSpanCondition)((t.table7FF[c&0x3f]&((uint32_t)1<<(c>>6)))!=0) != spanCondition) {
                 return prev+1;
             }
         } else if(c<=0xffff) {
             int lead=c>>12;
-            uint32_t twoBits=(bmpBlockBits[(c>>6)&0x3f]>>lead)&0x10001;
+            uint32_t twoBits=(t.bmpBlockBits[(c>>6)&0x3f]>>lead)&0x10001;
             if(twoBits<=1) {
                 // All 64 code points with the same bits 15..6
                 // are either in the set or not.
@@ -711,12 +916,12 @@ BMPSet::spanBackUTF8(const uint8_t *s, int32_t length, USetSpanCondition spanCon
                 }
             } else {
                 // Look up the code point in its 4k block of code points.
-                if(containsSlow(c, list4kStarts[lead], list4kStarts[lead+1]) != spanCondition) {
+                if(containsSlow(c, t.list4kStarts[lead], t.list4kStarts[lead+1]) != spanCondition) {
                     return prev+1;
                 }
             }
         } else {
-            if(containsSlow(c, list4kStarts[0x10], list4kStarts[0x11]) != spanCondition) {
+            if(containsSlow(c, t.list4kStarts[0x10], t.list4kStarts[0x11]) != spanCondition) {
                 return prev+1;
             }
         }
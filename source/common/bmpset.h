@@ -24,6 +24,73 @@
 
 U_NAMESPACE_BEGIN
 
+/*
+ * The lookup tables of a BMPSet.
+ * Plain data with a fixed layout and no pointers, so that they can be
+ * serialized together with the inversion list and used in place.
+ * See uset_serializeFrozen().
+ */
+struct BMPSetTables {
+    /*
+     * One byte per ASCII character, or trail byte in lead position.
+     * 0 or 1 for ASCII characters.
+     * The value for trail bytes is the result of contains(FFFD)
+     * for faster validity checking at runtime.
+     */
+    UBool asciiBytes[0xc0];
+
+    /*
+     * One bit per ASCII character, for vectorized span() lookups.
+     * With code point parts
+     *   low=c{3..0}
+     *   high=c{6..4}
+     * it is set.contains(c)==(asciiBitmap[low] bit high)
+     */
+    uint8_t asciiBitmap[16];
+
+    /*
+     * One bit per code point from U+0000..U+07FF.
+     * The bits are organized vertically; consecutive code points
+     * correspond to the same bit positions in consecutive table words.
+     * With code point parts
+     *   lead=c{10..6}
+     *   trail=c{5..0}
+     * it is set.contains(c)==(table7FF[trail] bit lead)
+     *
+     * Bits for 0..7F (non-shortest forms) are set to the result of contains(FFFD)
+     * for faster validity checking at runtime.
+     */
+    uint32_t table7FF[64];
+
+    /*
+     * One bit per 64 BMP code points.
+     * The bits are organized vertically; consecutive 64-code point blocks
+     * correspond to the same bit position in consecutive table words.
+     * With code point parts
+     *   lead=c{15..12}
+     *   t1=c{11..6}
+     * test bits (lead+16) and lead in bmpBlockBits[t1].
+     * If the upper bit is 0, then the lower bit indicates if contains(c)
+     * for all code points in the 64-block.
+     * If the upper bit is 1, then the block is mixed and set.contains(c)
+     * must be called.
+     *
+     * Bits for 0..7FF (non-shortest forms) and D800..DFFF are set to
+     * the result of contains(FFFD) for faster validity checking at runtime.
+     */
+    uint32_t bmpBlockBits[64];
+
+    /*
+     * Inversion list indexes for restricted binary searches in
+     * findCodePoint(), from
+     * findCodePoint(U+0800, U+1000, U+2000, .., U+F000, U+10000).
+     * U+0800 is the first 3-byte-UTF-8 code point. Code points below U+0800 are
+     * always looked up in the bit tables.
+     * The last pair of indexes is for finding supplementary code points.
+     */
+    int32_t list4kStarts[18];
+};
+
 /*
  * Helper class for frozen UnicodeSets, implements contains() and span()
  * optimized for BMP code points. Structured to be UTF-8-friendly.
@@ -33,13 +100,23 @@ U_NAMESPACE_BEGIN
  * 3-byte characters: Use zero/one/mixed data per 64-block in U+0000..U+FFFF,
  *                    with mixed for illegal ranges.
  * Supplementary characters: Call contains() on the parent set.
+ *
+ * Where the CPU supports it (see U_BMPSET_USE_SSSE3 in bmpset.cpp),
+ * the span functions skip runs of ASCII characters 16 at a time.
  */
 class BMPSet : public UMemory {
 public:
     BMPSet(const int32_t *parentList, int32_t parentListLength);
     BMPSet(const BMPSet &otherBMPSet, const int32_t *newParentList, int32_t newParentListLength);
+    /*
+     * Aliases tables that were built by another BMPSet for the same inversion list,
+     * for example in serialized data. The tables and the list are not copied.
+     */
+    BMPSet(const BMPSetTables *aliasTables, const int32_t *parentList, int32_t parentListLength);
     virtual ~BMPSet();
 
+    const BMPSetTables &getTables() const { return *tables; }
+
     virtual UBool contains(UChar32 c) const;
 
     /*
@@ -95,55 +172,9 @@ private:
 
     inline UBool containsSlow(UChar32 c, int32_t lo, int32_t hi) const;
 
-    /*
-     * One byte per ASCII character, or trail byte in lead position.
-     * 0 or 1 for ASCII characters.
-     * The value for trail bytes is the result of contains(FFFD)
-     * for faster validity checking at runtime.
-     */
-    UBool asciiBytes[0xc0];
-
-    /*
-     * One bit per code point from U+0000..U+07FF.
-     * The bits are organized vertically; consecutive code points
-     * correspond to the same bit positions in consecutive table words.
-     * With code point parts
-     *   lead=c{10..6}
-     *   trail=c{5..0}
-     * it is set.contains(c)==(table7FF[trail] bit lead)
-     *
-     * Bits for 0..7F (non-shortest forms) are set to the result of contains(FFFD)
-     * for faster validity checking at runtime.
-     */
-    uint32_t table7FF[64];
-
-    /*
-     * One bit per 64 BMP code points.
-     * The bits are organized vertically; consecutive 64-code point blocks
-     * correspond to the same bit position in consecutive table words.
-     * With code point parts
-     *   lead=c{15..12}
-     *   t1=c{11..6}
-     * test bits (lead+16) and lead in bmpBlockBits[t1].
-     * If the upper bit is 0, then the lower bit indicates if contains(c)
-     * for all code points in the 64-block.
-     * If the upper bit is 1, then the block is mixed and set.contains(c)
-     * must be called.
-     *
-     * Bits for 0..7FF (non-shortest forms) and D800..DFFF are set to
-     * the result of contains(FFFD) for faster validity checking at runtime.
-     */
-    uint32_t bmpBlockBits[64];
-
-    /*
-     * Inversion list indexes for restricted binary searches in
-     * findCodePoint(), from
-     * findCodePoint(U+0800, U+1000, U+2000, .., U+F000, U+10000).
-     * U+0800 is the first 3-byte-UTF-8 code point. Code points below U+0800 are
-     * always looked up in the bit tables.
-     * The last pair of indexes is for finding supplementary code points.
-     */
-    int32_t list4kStarts[18];
+    BMPSetTables ownTables;
+    // The lookup tables: ownTables, or aliased tables from serialized data.
+    const BMPSetTables *tables;
 
     /*
      * The inversion list of the parent set, for the slower contains() implementation
@@ -16,6 +16,7 @@
 #include "unicode/uniset.h"
 #include "unicode/chariter.h"
 #include "unicode/ubrk.h"
+#include "unicode/utf16.h"
 #include "uvectr32.h"
 #include "uvector.h"
 #include "uassert.h"
@@ -1110,9 +1111,9 @@ static inline uint32_t getKatakanaCost(int32_t wordLength){
     return (wordLength > kMaxKatakanaLength) ? 8192 : katakanaCost[wordLength];
 }
 
-static inline bool isKatakana(uint16_t value) {
-    return (value >= 0x30A1u && value <= 0x30FEu && value != 0x30FBu) ||
-            (value >= 0xFF66u && value <= 0xFF9fu);
+static inline bool isKatakana(UChar32 value) {
+    return (value >= 0x30A1 && value <= 0x30FE && value != 0x30FB) ||
+            (value >= 0xFF66 && value <= 0xFF9f);
 }
 
 
@@ -1124,6 +1125,15 @@ static inline int32_t utext_i32_flag(int32_t bitIndex) {
 }
 
        
+// Ranges up to this many code units are segmented without heap allocations.
+static const int32_t kScratchLength = 128;
+
+template<typename T, int32_t stackCapacity>
+static inline UBool
+ensureCapacity(MaybeStackArray<T, stackCapacity> &array, int32_t capacity, int32_t length) {
+    return capacity <= array.getCapacity() || array.resize(2 * capacity, length) != NULL;
+}
+
 /*
  * @param text A UText representing the text
  * @param rangeStart The start of the range of dictionary characters
@@ -1140,12 +1150,17 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
         return 0;
     }
 
-    // UnicodeString version of input UText, NFKC normalized if necessary.
-    UnicodeString inString;
+    // The range as UTF-16 text, NFKC normalized if necessary.
+    // It aliases the UText chunk, or inString or normalizedInput.
+    const UChar   *text;
+    int32_t        length;
+    UnicodeString  inString;
 
-    // inputMap[inStringIndex] = corresponding native index from UText inText.
-    // If NULL then mapping is 1:1
-    LocalPointer<UVector32>     inputMap;
+    // map[text index] = corresponding native index from UText inText,
+    // with one more entry for the end of the text.
+    // If NULL then the native index is the text index + rangeStart.
+    const int32_t *map = NULL;
+    MaybeStackArray<int32_t, kScratchLength + 1> inputMap;
 
     UErrorCode     status      = U_ZERO_ERROR;
 
@@ -1157,10 +1172,9 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
          inText->nativeIndexingLimit >= rangeEnd - inText->chunkNativeStart) {
 
         // Input UText is in one contiguous UTF-16 chunk.
-        // Use Read-only aliasing UnicodeString.
-        inString.setTo(FALSE,
-                       inText->chunkContents + rangeStart - inText->chunkNativeStart,
-                       rangeEnd - rangeStart);
+        // Use it in place.
+        text = inText->chunkContents + rangeStart - inText->chunkNativeStart;
+        length = rangeEnd - rangeStart;
     } else {
         // Copy the text from the original inText (UText) to inString (UnicodeString).
         // Create a map from UnicodeString indices -> UText offsets.
@@ -1170,44 +1184,47 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
         if (limit > utext_nativeLength(inText)) {
             limit = (int32_t)utext_nativeLength(inText);
         }
-        inputMap.adoptInsteadAndCheckErrorCode(new UVector32(status), status);
-        if (U_FAILURE(status)) {
-            return 0;
-        }
+        int32_t mapLength = 0;
         while (utext_getNativeIndex(inText) < limit) {
             int32_t nativePosition = (int32_t)utext_getNativeIndex(inText);
             UChar32 c = utext_next32(inText);
             U_ASSERT(c != U_SENTINEL);
             inString.append(c);
-            while (inputMap->size() < inString.length()) {
-                inputMap->addElement(nativePosition, status);
+            if (!ensureCapacity(inputMap, inString.length() + 1, mapLength)) {
+                return 0;
             }
+            while (mapLength < inString.length()) {
+                inputMap[mapLength++] = nativePosition;
+            }
+        }
+        if (!ensureCapacity(inputMap, mapLength + 1, mapLength)) {
+            return 0;
         }
-        inputMap->addElement(limit, status);
+        inputMap[mapLength] = limit;
+        map = inputMap.getAlias();
+        text = inString.getBuffer();
+        length = inString.length();
     }
 
-
-    if (!nfkcNorm2->isNormalized(inString, status)) {
-        UnicodeString normalizedInput;
+    UnicodeString normalizedInput;
+    MaybeStackArray<int32_t, kScratchLength + 1> normalizedMap;
+    UnicodeString original(FALSE, text, length);  // read-only alias
+    if (!nfkcNorm2->isNormalized(original, status)) {
         //  normalizedMap[normalizedInput position] ==  original UText position.
-        LocalPointer<UVector32> normalizedMap(new UVector32(status), status);
-        if (U_FAILURE(status)) {
-            return 0;
-        }
-        
         UnicodeString fragment;
         UnicodeString normalizedFragment;
-        for (int32_t srcI = 0; srcI < inString.length();) {  // Once per normalization chunk
+        int32_t mapLength = 0;
+        for (int32_t srcI = 0; srcI < length;) {  // Once per normalization chunk
             fragment.remove();
             int32_t fragmentStartI = srcI;
-            UChar32 c = inString.char32At(srcI);
+            UChar32 c = original.char32At(srcI);
             for (;;) {
                 fragment.append(c);
-                srcI = inString.moveIndex32(srcI, 1);
-                if (srcI == inString.length()) {
+                srcI = original.moveIndex32(srcI, 1);
+                if (srcI == length) {
                     break;
                 }
-                c = inString.char32At(srcI);
+                c = original.char32At(srcI);
                 if (nfkcNorm2->hasBoundaryBefore(c)) {
                     break;
                 }
@@ -1217,114 +1234,82 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
 
             // Map every position in the normalized chunk to the start of the chunk
             //   in the original input.
-            int32_t fragmentOriginalStart = inputMap.isValid() ?
-                    inputMap->elementAti(fragmentStartI) : fragmentStartI+rangeStart;
-            while (normalizedMap->size() < normalizedInput.length()) {
-                normalizedMap->addElement(fragmentOriginalStart, status);
-                if (U_FAILURE(status)) {
-                    break;
-                }
-            }
-        }
-        U_ASSERT(normalizedMap->size() == normalizedInput.length());
-        int32_t nativeEnd = inputMap.isValid() ?
-                inputMap->elementAti(inString.length()) : inString.length()+rangeStart;
-        normalizedMap->addElement(nativeEnd, status);
-
-        inputMap.moveFrom(normalizedMap);
-        inString.moveFrom(normalizedInput);
-    }
-
-    int32_t numCodePts = inString.countChar32();
-    if (numCodePts != inString.length()) {
-        // There are supplementary characters in the input.
-        // The dictionary will produce boundary positions in terms of code point indexes,
-        //   not in terms of code unit string indexes.
-        // Use the inputMap mechanism to take care of this in addition to indexing differences
-        //    from normalization and/or UTF-8 input.
-        UBool hadExistingMap = inputMap.isValid();
-        if (!hadExistingMap) {
-            inputMap.adoptInsteadAndCheckErrorCode(new UVector32(status), status);
-            if (U_FAILURE(status)) {
+            int32_t fragmentOriginalStart = map != NULL ?
+                    map[fragmentStartI] : fragmentStartI+rangeStart;
+            if (!ensureCapacity(normalizedMap, normalizedInput.length() + 1, mapLength)) {
                 return 0;
             }
-        }
-        int32_t cpIdx = 0;
-        for (int32_t cuIdx = 0; ; cuIdx = inString.moveIndex32(cuIdx, 1)) {
-            U_ASSERT(cuIdx >= cpIdx);
-            if (hadExistingMap) {
-                inputMap->setElementAt(inputMap->elementAti(cuIdx), cpIdx);
-            } else {
-                inputMap->addElement(cuIdx+rangeStart, status);
-            }
-            cpIdx++;
-            if (cuIdx == inString.length()) {
-               break;
+            while (mapLength < normalizedInput.length()) {
+                normalizedMap[mapLength++] = fragmentOriginalStart;
             }
         }
-    }
-                
-    // bestSnlp[i] is the snlp of the best segmentation of the first i
-    // code points in the range to be matched.
-    UVector32 bestSnlp(numCodePts + 1, status);
-    bestSnlp.addElement(0, status);
-    for(int32_t i = 1; i <= numCodePts; i++) {
-        bestSnlp.addElement(kuint32max, status);
+        if (U_FAILURE(status)) {
+            return 0;
+        }
+        normalizedMap[mapLength] = map != NULL ? map[length] : length+rangeStart;
+        map = normalizedMap.getAlias();
+        text = normalizedInput.getBuffer();
+        length = normalizedInput.length();
     }
 
+    // The segmentation works on code unit indexes into text.
+    // Only code point boundaries are reached.
 
-    // prev[i] is the index of the last CJK code point in the previous word in 
-    // the best segmentation of the first i characters.
-    UVector32 prev(numCodePts + 1, status);
-    for(int32_t i = 0; i <= numCodePts; i++){
-        prev.addElement(-1, status);
+    // bestSnlp[i] is the snlp of the best segmentation of the first i
+    // code units in the range to be matched.
+    // prev[i] is the start index of the last word in the best segmentation
+    // of the first i code units.
+    MaybeStackArray<uint32_t, kScratchLength + 1> bestSnlp;
+    MaybeStackArray<int32_t, kScratchLength + 1> prev;
+    if (!ensureCapacity(bestSnlp, length + 1, 0) || !ensureCapacity(prev, length + 1, 0)) {
+        return 0;
+    }
+    bestSnlp[0] = 0;
+    prev[0] = -1;
+    for(int32_t i = 1; i <= length; i++) {
+        bestSnlp[i] = kuint32max;
+        prev[i] = -1;
     }
 
+    // Each match is at least one code unit long, and no longer than maxWordSize,
+    // plus there may be one for a character that is not in the dictionary.
     const int32_t maxWordSize = 20;
-    UVector32 values(numCodePts, status);
-    values.setSize(numCodePts);
-    UVector32 lengths(numCodePts, status);
-    lengths.setSize(numCodePts);
-
-    UText fu = UTEXT_INITIALIZER;
-    utext_openUnicodeString(&fu, &inString, &status);
+    int32_t values[maxWordSize + 1];
+    int32_t lengths[maxWordSize + 1];
 
     // Dynamic programming to find the best segmentation.
-
-    // In outer loop, i  is the code point index,
-    //                ix is the corresponding string (code unit) index.
-    //    They differ when the string contains supplementary characters.
-    int32_t ix = 0;
+    // The trie is searched from each reachable start position separately.
+    // One walk with a trie cursor per live start position would take the same
+    // trie steps, since every word from every start is needed, and it could not
+    // skip the start positions that no segmentation reaches.
     bool is_prev_katakana = false;
-    for (int32_t i = 0;  i < numCodePts;  ++i, ix = inString.moveIndex32(ix, 1)) {
-        if ((uint32_t)bestSnlp.elementAti(i) == kuint32max) {
+    for (int32_t ix = 0, next = 0;  ix < length;  ix = next) {
+        UChar32 c;
+        U16_NEXT(text, next, length, c);
+        if (bestSnlp[ix] == kuint32max) {
             continue;
         }
 
-        int32_t count;
-        utext_setNativeIndex(&fu, ix);
-        count = fDictionary->matches(&fu, maxWordSize, numCodePts,
-                             NULL, lengths.getBuffer(), values.getBuffer(), NULL);
-                             // Note: lengths is filled with code point lengths
-                             //       The NULL parameter is the ignored code unit lengths.
+        int32_t count = fDictionary->matches(text + ix, length - ix, maxWordSize, maxWordSize,
+                                             lengths, values);
 
         // if there are no single character matches found in the dictionary 
         // starting with this character, treat character as a 1-character word 
         // with the highest value possible, i.e. the least likely to occur.
         // Exclude Korean characters from this treatment, as they should be left
         // together by default.
-        if ((count == 0 || lengths.elementAti(0) != 1) &&
-                !fHangulWordSet.contains(inString.char32At(ix))) {
-            values.setElementAt(maxSnlp, count);   // 255
-            lengths.setElementAt(1, count++);
+        if ((count == 0 || lengths[0] != next - ix) &&
+                !fHangulWordSet.contains(c)) {
+            values[count] = maxSnlp;   // 255
+            lengths[count++] = next - ix;
         }
 
         for (int32_t j = 0; j < count; j++) {
-            uint32_t newSnlp = (uint32_t)bestSnlp.elementAti(i) + (uint32_t)values.elementAti(j);
-            int32_t ln_j_i = lengths.elementAti(j) + i;
-            if (newSnlp < (uint32_t)bestSnlp.elementAti(ln_j_i)) {
-                bestSnlp.setElementAt(newSnlp, ln_j_i);
-                prev.setElementAt(i, ln_j_i);
+            uint32_t newSnlp = bestSnlp[ix] + (uint32_t)values[j];
+            int32_t wordLimit = ix + lengths[j];
+            if (newSnlp < bestSnlp[wordLimit]) {
+                bestSnlp[wordLimit] = newSnlp;
+                prev[wordLimit] = ix;
             }
         }
 
@@ -1333,61 +1318,60 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
         // the following heuristic to Katakana: any continuous run of Katakana
         // characters is considered a candidate word with a default cost
         // specified in the katakanaCost table according to its length.
+        // Katakana are all in the BMP.
 
-        bool is_katakana = isKatakana(inString.char32At(ix));
+        bool is_katakana = isKatakana(c);
         int32_t katakanaRunLength = 1;
         if (!is_prev_katakana && is_katakana) {
-            int32_t j = inString.moveIndex32(ix, 1);
+            int32_t j = next;
             // Find the end of the continuous run of Katakana characters
-            while (j < inString.length() && katakanaRunLength < kMaxKatakanaGroupLength &&
-                    isKatakana(inString.char32At(j))) {
-                j = inString.moveIndex32(j, 1);
+            while (j < length && katakanaRunLength < kMaxKatakanaGroupLength &&
+                    isKatakana(text[j])) {
+                ++j;
                 katakanaRunLength++;
             }
             if (katakanaRunLength < kMaxKatakanaGroupLength) {
-                uint32_t newSnlp = bestSnlp.elementAti(i) + getKatakanaCost(katakanaRunLength);
-                if (newSnlp < (uint32_t)bestSnlp.elementAti(j)) {
-                    bestSnlp.setElementAt(newSnlp, j);
-                    prev.setElementAt(i, i+katakanaRunLength);  // prev[j] = i;
+                uint32_t newSnlp = bestSnlp[ix] + getKatakanaCost(katakanaRunLength);
+                if (newSnlp < bestSnlp[j]) {
+                    bestSnlp[j] = newSnlp;
+                    prev[j] = ix;
                 }
             }
         }
         is_prev_katakana = is_katakana;
     }
-    utext_close(&fu);
 
     // Start pushing the optimal offset index into t_boundary (t for tentative).
-    // prev[numCodePts] is guaranteed to be meaningful.
+    // prev[length] is guaranteed to be meaningful.
     // We'll first push in the reverse order, i.e.,
-    // t_boundary[0] = numCodePts, and afterwards do a swap.
-    UVector32 t_boundary(numCodePts+1, status);
+    // t_boundary[0] = length, and afterwards do a swap.
+    // There is at most one boundary per code unit, plus one for the start.
+    // bestSnlp[] is not needed any more; reuse it.
+    int32_t *t_boundary = (int32_t *)bestSnlp.getAlias();
 
     int32_t numBreaks = 0;
     // No segmentation found, set boundary to end of range
-    if ((uint32_t)bestSnlp.elementAti(numCodePts) == kuint32max) {
-        t_boundary.addElement(numCodePts, status);
-        numBreaks++;
+    if (bestSnlp[length] == kuint32max) {
+        t_boundary[numBreaks++] = length;
     } else {
-        for (int32_t i = numCodePts; i > 0; i = prev.elementAti(i)) {
-            t_boundary.addElement(i, status);
-            numBreaks++;
+        for (int32_t i = length; i > 0; i = prev[i]) {
+            t_boundary[numBreaks++] = i;
         }
-        U_ASSERT(prev.elementAti(t_boundary.elementAti(numBreaks - 1)) == 0);
+        U_ASSERT(prev[t_boundary[numBreaks - 1]] == 0);
     }
 
     // Add a break for the start of the dictionary range if there is not one
     // there already.
     if (foundBreaks.size() == 0 || foundBreaks.peeki() < rangeStart) {
-        t_boundary.addElement(0, status);
-        numBreaks++;
+        t_boundary[numBreaks++] = 0;
     }
 
     // Now that we're done, convert positions in t_boundary[] (indices in 
     // the normalized input string) back to indices in the original input UText
     // while reversing t_boundary and pushing values to foundBreaks.
     for (int32_t i = numBreaks-1; i >= 0; i--) {
-        int32_t cpPos = t_boundary.elementAti(i);
-        int32_t utextPos =  inputMap.isValid() ? inputMap->elementAti(cpPos) : cpPos + rangeStart;
+        int32_t cuPos = t_boundary[i];
+        int32_t utextPos =  map != NULL ? map[cuPos] : cuPos + rangeStart;
         // Boundaries are added to foundBreaks output in ascending order.
         U_ASSERT(foundBreaks.size() == 0 ||foundBreaks.peeki() < utextPos);
         foundBreaks.push(utextPos, status);
@@ -15,6 +15,7 @@
 #include "unicode/ucharstrie.h"
 #include "unicode/bytestrie.h"
 #include "unicode/udata.h"
+#include "unicode/utf16.h"
 #include "cmemory.h"
 
 #if !UCONFIG_NO_BREAK_ITERATION
@@ -34,6 +35,19 @@ const int32_t  DictionaryData::TRANSFORM_OFFSET_MASK = 0x1fffff;
 DictionaryMatcher::~DictionaryMatcher() {
 }
 
+int32_t DictionaryMatcher::matches(const UChar *text, int32_t textLength, int32_t maxLength, int32_t limit,
+                                   int32_t *lengths, int32_t *values) const {
+    UErrorCode errorCode = U_ZERO_ERROR;
+    UText ut = UTEXT_INITIALIZER;
+    utext_openUChars(&ut, text, textLength, &errorCode);
+    if (U_FAILURE(errorCode)) {
+        return 0;
+    }
+    int32_t count = matches(&ut, maxLength, limit, lengths, NULL, values, NULL);
+    utext_close(&ut);
+    return count;
+}
+
 UCharsDictionaryMatcher::~UCharsDictionaryMatcher() {
     udata_close(file);
 }
@@ -86,6 +100,40 @@ int32_t UCharsDictionaryMatcher::matches(UText *text, int32_t maxLength, int32_t
     return wordCount;
 }
 
+int32_t UCharsDictionaryMatcher::matches(const UChar *text, int32_t textLength, int32_t maxLength,
+                                         int32_t limit, int32_t *lengths, int32_t *values) const {
+    UCharsTrie uct(characters);
+    int32_t wordCount = 0;
+    int32_t i = 0;
+    while (i < textLength) {
+        int32_t start = i;
+        UChar32 c;
+        U16_NEXT(text, i, textLength, c);
+        UStringTrieResult result = (start == 0) ? uct.first(c) : uct.next(c);
+        if (USTRINGTRIE_HAS_VALUE(result)) {
+            if (wordCount < limit) {
+                if (values != NULL) {
+                    values[wordCount] = uct.getValue();
+                }
+                if (lengths != NULL) {
+                    lengths[wordCount] = i;
+                }
+                ++wordCount;
+            }
+            if (result == USTRINGTRIE_FINAL_VALUE) {
+                break;
+            }
+        }
+        else if (result == USTRINGTRIE_NO_MATCH) {
+            break;
+        }
+        if (i >= maxLength) {
+            break;
+        }
+    }
+    return wordCount;
+}
+
 BytesDictionaryMatcher::~BytesDictionaryMatcher() {
     udata_close(file);
 }
@@ -94,6 +94,22 @@ public:
                             int32_t *lengths, int32_t *cpLengths, int32_t *values,
                             int32_t *prefix) const = 0;
 
+    /*  Like the UText version, for text in a UTF-16 array, without a prefix output.
+     *  Avoids the UText overhead on hot paths that already have the text as UChars.
+     *  The default implementation wraps the array in a UText.
+     *  @param text       The text in which to look for matching words, from text[0].
+     *  @param textLength The length of the text.
+     *  @param maxLength  The max length of match to consider, in code units.
+     *  @param limit      Capacity of output arrays.
+     *  @param lengths    output array, filled with the code unit lengths of the matches,
+     *                    from shortest to longest. May be NULL.
+     *  @param values     Output array, filled with the values associated with the words found.
+     *                    May be NULL.
+     *  @return           Number of matching words found.
+     */
+    virtual int32_t matches(const UChar *text, int32_t textLength, int32_t maxLength, int32_t limit,
+                            int32_t *lengths, int32_t *values) const;
+
     /** @return DictionaryData::TRIE_TYPE_XYZ */
     virtual int32_t getType() const = 0;
 };
@@ -108,6 +124,8 @@ public:
     virtual int32_t matches(UText *text, int32_t maxLength, int32_t limit,
                             int32_t *lengths, int32_t *cpLengths, int32_t *values,
                             int32_t *prefix) const;
+    virtual int32_t matches(const UChar *text, int32_t textLength, int32_t maxLength, int32_t limit,
+                            int32_t *lengths, int32_t *values) const;
     virtual int32_t getType() const;
 private:
     const UChar *characters;
@@ -126,6 +144,7 @@ public:
     virtual int32_t matches(UText *text, int32_t maxLength, int32_t limit,
                             int32_t *lengths, int32_t *cpLengths, int32_t *values,
                             int32_t *prefix) const;
+    using DictionaryMatcher::matches;
     virtual int32_t getType() const;
 private:
     UChar32 transform(UChar32 c) const;
@@ -177,6 +177,38 @@ public:
     virtual const UChar *
     spanQuickCheckYes(const UChar *src, const UChar *limit, UErrorCode &errorCode) const = 0;
 
+    // UTF-8
+    virtual void
+    normalizeUTF8(StringPiece src, ByteSink &sink, UErrorCode &errorCode) const {
+        if(U_FAILURE(errorCode)) {
+            return;
+        }
+        const uint8_t *s=reinterpret_cast<const uint8_t *>(src.data());
+        normalizeUTF8(s, s+src.length(), TRUE, &sink, errorCode);
+    }
+    virtual UBool
+    isNormalizedUTF8(StringPiece s, UErrorCode &errorCode) const {
+        if(U_FAILURE(errorCode)) {
+            return FALSE;
+        }
+        const uint8_t *sArray=reinterpret_cast<const uint8_t *>(s.data());
+        const uint8_t *sLimit=sArray+s.length();
+        return sLimit==normalizeUTF8(sArray, sLimit, TRUE, NULL, errorCode);
+    }
+    virtual int32_t
+    spanQuickCheckYesUTF8(StringPiece s, UErrorCode &errorCode) const {
+        if(U_FAILURE(errorCode)) {
+            return 0;
+        }
+        const uint8_t *sArray=reinterpret_cast<const uint8_t *>(s.data());
+        return (int32_t)(normalizeUTF8(sArray, sArray+s.length(), FALSE, NULL, errorCode)-sArray);
+    }
+    // With a NULL sink, returns the end of the normalized prefix;
+    // resolveMaybe=FALSE stops at "maybe" characters as in spanQuickCheckYes().
+    virtual const uint8_t *
+    normalizeUTF8(const uint8_t *src, const uint8_t *limit, UBool resolveMaybe,
+                  ByteSink *sink, UErrorCode &errorCode) const = 0;
+
     virtual UNormalizationCheckResult getQuickCheck(UChar32) const {
         return UNORM_YES;
     }
@@ -207,6 +239,12 @@ private:
         return impl.decompose(src, limit, NULL, errorCode);
     }
     using Normalizer2WithImpl::spanQuickCheckYes;  // Avoid warning about hiding base class function.
+    virtual const uint8_t *
+    normalizeUTF8(const uint8_t *src, const uint8_t *limit, UBool /*resolveMaybe*/,
+                  ByteSink *sink, UErrorCode &errorCode) const {
+        return impl.decomposeUTF8(src, limit, sink, errorCode);
+    }
+    using Normalizer2WithImpl::normalizeUTF8;  // Avoid warning about hiding base class function.
     virtual UNormalizationCheckResult getQuickCheck(UChar32 c) const {
         return impl.isDecompYes(impl.getNorm16(c)) ? UNORM_YES : UNORM_NO;
     }
@@ -271,6 +309,12 @@ private:
         return impl.composeQuickCheck(src, limit, onlyContiguous, NULL);
     }
     using Normalizer2WithImpl::spanQuickCheckYes;  // Avoid warning about hiding base class function.
+    virtual const uint8_t *
+    normalizeUTF8(const uint8_t *src, const uint8_t *limit, UBool resolveMaybe,
+                  ByteSink *sink, UErrorCode &errorCode) const {
+        return impl.composeUTF8(src, limit, onlyContiguous, resolveMaybe, sink, errorCode);
+    }
+    using Normalizer2WithImpl::normalizeUTF8;  // Avoid warning about hiding base class function.
     virtual UNormalizationCheckResult getQuickCheck(UChar32 c) const {
         return impl.getCompQuickCheck(impl.getNorm16(c));
     }
@@ -310,6 +354,12 @@ private:
         return impl.makeFCD(src, limit, NULL, errorCode);
     }
     using Normalizer2WithImpl::spanQuickCheckYes;  // Avoid warning about hiding base class function.
+    virtual const uint8_t *
+    normalizeUTF8(const uint8_t *src, const uint8_t *limit, UBool /*resolveMaybe*/,
+                  ByteSink *sink, UErrorCode &errorCode) const {
+        return impl.makeFCDUTF8(src, limit, sink, errorCode);
+    }
+    using Normalizer2WithImpl::normalizeUTF8;  // Avoid warning about hiding base class function.
     virtual UBool hasBoundaryBefore(UChar32 c) const { return impl.hasFCDBoundaryBefore(c); }
     virtual UBool hasBoundaryAfter(UChar32 c) const { return impl.hasFCDBoundaryAfter(c); }
     virtual UBool isInert(UChar32 c) const { return impl.isFCDInert(c); }
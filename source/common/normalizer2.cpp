@@ -23,6 +23,7 @@
 #include "unicode/normalizer2.h"
 #include "unicode/unistr.h"
 #include "unicode/unorm.h"
+#include "unicode/utf8.h"
 #include "cstring.h"
 #include "mutex.h"
 #include "norm2allmodes.h"
@@ -57,6 +58,46 @@ Normalizer2::getCombiningClass(UChar32 /*c*/) const {
     return 0;
 }
 
+// The default UTF-8 implementations convert to and from UTF-16.
+void
+Normalizer2::normalizeUTF8(StringPiece src, ByteSink &sink, UErrorCode &errorCode) const {
+    if(U_FAILURE(errorCode)) {
+        return;
+    }
+    UnicodeString dest;
+    normalize(UnicodeString::fromUTF8(src), dest, errorCode);
+    if(U_SUCCESS(errorCode)) {
+        dest.toUTF8(sink);
+    }
+}
+
+UBool
+Normalizer2::isNormalizedUTF8(StringPiece s, UErrorCode &errorCode) const {
+    if(U_FAILURE(errorCode)) {
+        return FALSE;
+    }
+    return isNormalized(UnicodeString::fromUTF8(s), errorCode);
+}
+
+int32_t
+Normalizer2::spanQuickCheckYesUTF8(StringPiece s, UErrorCode &errorCode) const {
+    if(U_FAILURE(errorCode)) {
+        return 0;
+    }
+    int32_t spanLength16=spanQuickCheckYes(UnicodeString::fromUTF8(s), errorCode);
+    // Map the UTF-16 span back to UTF-8.
+    // fromUTF8() turns each ill-formed sequence into one U+FFFD.
+    const uint8_t *s8=(const uint8_t *)s.data();
+    int32_t length8=s.length();
+    int32_t i=0, length16=0;
+    while(length16<spanLength16 && i<length8) {
+        UChar32 c;
+        U8_NEXT(s8, i, length8, c);
+        length16+= c<0 ? 1 : U16_LENGTH(c);
+    }
+    return i;
+}
+
 // Normalizer2 implementation for the old UNORM_NONE.
 class NoopNormalizer2 : public Normalizer2 {
     virtual ~NoopNormalizer2();
@@ -117,6 +158,20 @@ class NoopNormalizer2 : public Normalizer2 {
     spanQuickCheckYes(const UnicodeString &s, UErrorCode &) const {
         return s.length();
     }
+    virtual void
+    normalizeUTF8(StringPiece src, ByteSink &sink, UErrorCode &errorCode) const {
+        if(U_SUCCESS(errorCode)) {
+            sink.Append(src.data(), src.length());
+        }
+    }
+    virtual UBool
+    isNormalizedUTF8(StringPiece, UErrorCode &) const {
+        return TRUE;
+    }
+    virtual int32_t
+    spanQuickCheckYesUTF8(StringPiece s, UErrorCode &) const {
+        return s.length();
+    }
     virtual UBool hasBoundaryBefore(UChar32) const { return TRUE; }
     virtual UBool hasBoundaryAfter(UChar32) const { return TRUE; }
     virtual UBool isInert(UChar32) const { return TRUE; }
@@ -20,9 +20,12 @@
 
 #if !UCONFIG_NO_NORMALIZATION
 
+#include "unicode/bytestream.h"
 #include "unicode/normalizer2.h"
+#include "unicode/stringpiece.h"
 #include "unicode/udata.h"
 #include "unicode/ustring.h"
+#include "unicode/utf8.h"
 #include "unicode/utf16.h"
 #include "cmemory.h"
 #include "mutex.h"
@@ -33,8 +36,33 @@
 #include "utrie2.h"
 #include "uvector.h"
 
+// SSE2 and NEON are baseline on x86-64 and AArch64; other platforms use only the scalar loops.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   include <emmintrin.h>
+#   if defined(_MSC_VER)
+#       include <intrin.h>
+#   endif
+#   define NORM2_SPAN_SSE2 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#   include <arm_neon.h>
+#   define NORM2_SPAN_NEON 1
+#endif
+
 U_NAMESPACE_BEGIN
 
+#if NORM2_SPAN_SSE2
+// Returns the index of the lowest 0 bit; mask must not be all 1s.
+static inline int32_t getLowestZeroBit(uint32_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, ~mask);
+    return (int32_t)index;
+#else
+    return __builtin_ctz(~mask);
+#endif
+}
+#endif
+
 // ReorderingBuffer -------------------------------------------------------- ***
 
 UBool ReorderingBuffer::init(int32_t destCapacity, UErrorCode &errorCode) {
@@ -419,6 +447,102 @@ Normalizer2Impl::addCanonIterPropertyStarts(const USetAdder *sa, UErrorCode &err
     }
 }
 
+const UChar *
+Normalizer2Impl::spanLongLow(const UChar *src, const UChar *limit, UChar32 minCP) {
+    if(minCP<=0) {
+        return src;
+    } else if(minCP>0xffff) {
+        return limit;
+    }
+#if NORM2_SPAN_SSE2
+    // Unsigned saturating subtraction yields 0 exactly for code units below minCP.
+    // The movemask has two bits per code unit; the lowest 0 bit locates the first unit to stop at.
+    const __m128i maxLow=_mm_set1_epi16((short)(minCP-1));
+    const __m128i zero=_mm_setzero_si128();
+    while((limit-src)>=16) {
+        __m128i units1=_mm_loadu_si128((const __m128i *)src);
+        __m128i units2=_mm_loadu_si128((const __m128i *)(src+8));
+        uint32_t lowMask=
+            (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_subs_epu16(units1, maxLow), zero))|
+            ((uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_subs_epu16(units2, maxLow), zero))<<16);
+        if(lowMask!=0xffffffff) {
+            return src+(getLowestZeroBit(lowMask)>>1);
+        }
+        src+=16;
+    }
+    if((limit-src)>=8) {
+        __m128i units=_mm_loadu_si128((const __m128i *)src);
+        uint32_t lowMask=
+            (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_subs_epu16(units, maxLow), zero))|
+            0xffff0000;
+        if(lowMask!=0xffffffff) {
+            return src+(getLowestZeroBit(lowMask)>>1);
+        }
+        src+=8;
+    }
+#elif NORM2_SPAN_NEON
+    while((limit-src)>=16) {
+        uint16x8_t units1=vld1q_u16((const uint16_t *)src);
+        uint16x8_t units2=vld1q_u16((const uint16_t *)(src+8));
+        if(vmaxvq_u16(vorrq_u16(units1, units2))>=minCP) {
+            break;
+        }
+        src+=16;
+    }
+    if((limit-src)>=8 && vmaxvq_u16(vld1q_u16((const uint16_t *)src))<minCP) {
+        src+=8;
+    }
+#endif
+    while(src!=limit && *src<minCP) {
+        ++src;
+    }
+    return src;
+}
+
+const uint8_t *
+Normalizer2Impl::spanLowUTF8(const uint8_t *src, const uint8_t *limit, UChar32 minCP) {
+    // Single bytes below minByte are code points below minCP.
+    int32_t minByte= minCP<0x80 ? minCP : 0x80;
+    if(minByte<=0) {
+        return src;
+    }
+    for(;;) {
+#if NORM2_SPAN_SSE2
+        const __m128i maxLow=_mm_set1_epi8((char)(minByte-1));
+        const __m128i zero=_mm_setzero_si128();
+        while((limit-src)>=16) {
+            __m128i high=_mm_subs_epu8(_mm_loadu_si128((const __m128i *)src), maxLow);
+            uint32_t lowMask=(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(high, zero))|0xffff0000;
+            if(lowMask!=0xffffffff) {
+                src+=getLowestZeroBit(lowMask);
+                break;
+            }
+            src+=16;
+        }
+#elif NORM2_SPAN_NEON
+        while((limit-src)>=16) {
+            if(vmaxvq_u8(vld1q_u8(src))>=minByte) {
+                break;
+            }
+            src+=16;
+        }
+#endif
+        while(src!=limit && *src<minByte) {
+            ++src;
+        }
+        // Skip a two-byte sequence below minCP, for example for Latin-1 letters,
+        // and go back to scanning for single bytes.
+        uint8_t t;
+        if( minCP>0x80 && (limit-src)>=2 && 0xc2<=*src && *src<=0xdf &&
+            U8_IS_TRAIL(t=src[1]) && ((((UChar32)*src&0x1f)<<6)|(t&0x3f))<minCP
+        ) {
+            src+=2;
+        } else {
+            return src;
+        }
+    }
+}
+
 const UChar *
 Normalizer2Impl::copyLowPrefixFromNulTerminated(const UChar *src,
                                                 UChar32 minNeedDataCP,
@@ -501,9 +625,13 @@ Normalizer2Impl::decompose(const UChar *src, const UChar *limit,
     for(;;) {
         // count code units below the minimum or with irrelevant data for the quick check
         for(prevSrc=src; src!=limit;) {
-            if( (c=*src)<minNoCP ||
-                isMostDecompYesAndZeroCC(norm16=UTRIE2_GET16_FROM_U16_SINGLE_LEAD(normTrie, c))
-            ) {
+            if((c=*src)<minNoCP) {
+                if((src=spanLow(src+1, limit, minNoCP))==limit) {
+                    break;
+                }
+                c=*src;
+            }
+            if(isMostDecompYesAndZeroCC(norm16=UTRIE2_GET16_FROM_U16_SINGLE_LEAD(normTrie, c))) {
                 ++src;
             } else if(!U16_IS_SURROGATE(c)) {
                 break;
@@ -1120,9 +1248,13 @@ Normalizer2Impl::compose(const UChar *src, const UChar *limit,
     for(;;) {
         // count code units below the minimum or with irrelevant data for the quick check
         for(prevSrc=src; src!=limit;) {
-            if( (c=*src)<minNoMaybeCP ||
-                isCompYesAndZeroCC(norm16=UTRIE2_GET16_FROM_U16_SINGLE_LEAD(normTrie, c))
-            ) {
+            if((c=*src)<minNoMaybeCP) {
+                if((src=spanLow(src+1, limit, minNoMaybeCP))==limit) {
+                    break;
+                }
+                c=*src;
+            }
+            if(isCompYesAndZeroCC(norm16=UTRIE2_GET16_FROM_U16_SINGLE_LEAD(normTrie, c))) {
                 ++src;
             } else if(!U16_IS_SURROGATE(c)) {
                 break;
@@ -1367,9 +1499,13 @@ Normalizer2Impl::composeQuickCheck(const UChar *src, const UChar *limit,
             if(src==limit) {
                 return src;
             }
-            if( (c=*src)<minNoMaybeCP ||
-                isCompYesAndZeroCC(norm16=UTRIE2_GET16_FROM_U16_SINGLE_LEAD(normTrie, c))
-            ) {
+            if((c=*src)<minNoMaybeCP) {
+                if((src=spanLow(src+1, limit, minNoMaybeCP))==limit) {
+                    return src;
+                }
+                c=*src;
+            }
+            if(isCompYesAndZeroCC(norm16=UTRIE2_GET16_FROM_U16_SINGLE_LEAD(normTrie, c))) {
                 ++src;
             } else if(!U16_IS_SURROGATE(c)) {
                 break;
@@ -1654,8 +1790,8 @@ Normalizer2Impl::makeFCD(const UChar *src, const UChar *limit,
         // count code units with lccc==0
         for(prevSrc=src; src!=limit;) {
             if((c=*src)<MIN_CCC_LCCC_CP) {
-                prevFCD16=~c;
-                ++src;
+                src=spanLow(src+1, limit, MIN_CCC_LCCC_CP);
+                prevFCD16=~*(src-1);
             } else if(!singleLeadMightHaveNonZeroFCD16(c)) {
                 prevFCD16=0;
                 ++src;
@@ -1806,6 +1942,304 @@ const UChar *Normalizer2Impl::findNextFCDBoundary(const UChar *p, const UChar *l
     return p;
 }
 
+// UTF-8 ------------------------------------------------------------------- ***
+
+UBool Normalizer2Impl::hasUTF8BoundaryBefore(UTF8Form form, UChar32 c) const {
+    switch(form) {
+    case UTF8_DECOMPOSE:
+        return hasDecompBoundary(c, TRUE);
+    case UTF8_COMPOSE:
+        return hasCompBoundaryBefore(c);
+    default:  // UTF8_FCD
+        return hasFCDBoundaryBefore(c);
+    }
+}
+
+UBool
+Normalizer2Impl::isUTF8SegmentNormalized(UTF8Form form, UBool onlyContiguous, UBool resolveMaybe,
+                                         const UnicodeString &segment,
+                                         UErrorCode &errorCode) const {
+    const UChar *s=segment.getBuffer();
+    const UChar *limit=s+segment.length();
+    switch(form) {
+    case UTF8_DECOMPOSE:
+        return decompose(s, limit, NULL, errorCode)==limit;
+    case UTF8_COMPOSE:
+        if(resolveMaybe) {
+            UnicodeString temp;
+            ReorderingBuffer buffer(*this, temp);
+            // small destCapacity for substring normalization
+            return buffer.init(5, errorCode) &&
+                compose(s, limit, onlyContiguous, FALSE, buffer, errorCode);
+        } else {
+            return composeQuickCheck(s, limit, onlyContiguous, NULL)==limit;
+        }
+    default:  // UTF8_FCD
+        return makeFCD(s, limit, NULL, errorCode)==limit;
+    }
+}
+
+// Segments that need work and are at most this many bytes apart
+// are converted to UTF-16 together, to amortize the per-conversion overhead.
+static const int32_t UTF8_MAX_CHUNK_GAP=64;
+// After this many bytes, if more than half of them had to be changed,
+// the rest of the text is normalized as a single chunk.
+static const int32_t UTF8_MIN_LENGTH_FOR_REST=256;
+
+// Checks or normalizes [start, limit[ via UTF-16.
+// The chunk starts and ends at boundaries, with no ill-formed sequence inside any segment.
+// sink==NULL: Returns FALSE if the text is not normalized.
+// sink!=NULL: Appends [unwritten, start[ and the normalized text to the sink
+// unless the text is already normalized.
+UBool
+Normalizer2Impl::flushUTF8Chunk(UTF8Form form, UBool onlyContiguous, UBool resolveMaybe,
+                                const uint8_t *start, const uint8_t *limit,
+                                const uint8_t *&unwritten, ByteSink *sink,
+                                UnicodeString &s16, UnicodeString &normalized,
+                                UErrorCode &errorCode) const {
+    // UTF-16 needs at most as many code units as there are UTF-8 bytes.
+    int32_t length8=(int32_t)(limit-start);
+    UChar *buffer16=s16.getBuffer(length8);
+    if(buffer16==NULL) {
+        errorCode=U_MEMORY_ALLOCATION_ERROR;
+        return FALSE;
+    }
+    int32_t length16=0, numSubstitutions=0;
+    u_strFromUTF8WithSub(buffer16, s16.getCapacity(), &length16,
+                         (const char *)start, length8,
+                         0xfffd, &numSubstitutions, &errorCode);
+    s16.releaseBuffer(U_SUCCESS(errorCode) ? length16 : 0);
+    if(U_FAILURE(errorCode)) {
+        return FALSE;
+    }
+    if(numSubstitutions!=0) {
+        // Ill-formed sequences between segments must be passed through unchanged:
+        // Process the segments one at a time.
+        if(sink!=NULL) {
+            sink->Append((const char *)unwritten, (int32_t)(start-unwritten));
+            unwritten=limit;
+        }
+        return normalizeUTF8(form, onlyContiguous, resolveMaybe, start, limit,
+                             sink, -1, errorCode)==limit;
+    }
+    if(sink==NULL) {
+        return isUTF8SegmentNormalized(form, onlyContiguous, resolveMaybe, s16, errorCode);
+    }
+    normalized.remove();
+    {
+        ReorderingBuffer buffer(*this, normalized);
+        if(!buffer.init(s16.length(), errorCode)) {
+            return FALSE;
+        }
+        const UChar *p=s16.getBuffer();
+        const UChar *pLimit=p+s16.length();
+        switch(form) {
+        case UTF8_DECOMPOSE:
+            decompose(p, pLimit, &buffer, errorCode);
+            break;
+        case UTF8_COMPOSE:
+            compose(p, pLimit, onlyContiguous, TRUE, buffer, errorCode);
+            break;
+        default:  // UTF8_FCD
+            makeFCD(p, pLimit, &buffer, errorCode);
+            break;
+        }
+    }  // The ReorderingBuffer destructor finalizes the normalized string.
+    if(U_FAILURE(errorCode)) {
+        return FALSE;
+    }
+    if(normalized!=s16) {
+        sink->Append((const char *)unwritten, (int32_t)(start-unwritten));
+        normalized.toUTF8(*sink);
+        unwritten=limit;
+    }
+    return TRUE;
+}
+
+const uint8_t *
+Normalizer2Impl::normalizeUTF8(UTF8Form form, UBool onlyContiguous, UBool resolveMaybe,
+                               const uint8_t *src, const uint8_t *limit,
+                               ByteSink *sink, int32_t maxChunkGap,
+                               UErrorCode &errorCode) const {
+    UChar32 minNoCP;
+    uint16_t minNoNorm16;  // characters with lower norm16 values pass the quick check
+    switch(form) {
+    case UTF8_DECOMPOSE:
+        minNoCP=minDecompNoCP;
+        minNoNorm16=minYesNo;
+        break;
+    case UTF8_COMPOSE:
+        minNoCP=minCompNoMaybeCP;
+        minNoNorm16=minNoNo;
+        break;
+    default:  // UTF8_FCD
+        minNoCP=MIN_CCC_LCCC_CP;
+        minNoNorm16=minYesNo+1;  // norm16<=minYesNo: fcd16=0
+        break;
+    }
+    // Lead bytes below this one start characters below minNoCP.
+    uint8_t minNoLead=
+        minNoCP<=0x80 ? (uint8_t)minNoCP :
+        minNoCP<0x800 ? (uint8_t)(0xc0|(minNoCP>>6)) : (uint8_t)0xe0;
+
+    // prevBoundary is the start of the last character with a boundary before it.
+    // [chunkStart, chunkLimit[ contains segments that still need to be checked or normalized,
+    // and [unwritten, chunkStart[ is normalized but not yet appended to the sink.
+    // prevCC is the ccc (decomposition) or tccc (FCD) of the previous character.
+    const uint8_t *prevBoundary=src;
+    const uint8_t *unwritten=src;
+    uint8_t prevCC=0;
+    const uint8_t *chunkStart=NULL;
+    const uint8_t *chunkLimit=NULL;
+    UnicodeString s16, normalized;
+    UBool ok=TRUE;
+    const uint8_t *start=src;
+    int32_t changedLength=0;
+    while(src!=limit) {
+        // Skip characters that pass the quick check, directly on the bytes.
+        if(*src<minNoLead) {
+            const uint8_t *p=spanLowUTF8(src, limit, minNoCP);
+            if(p!=src) {
+                src=p;
+                // The skipped characters are encoded with one or two bytes.
+                if(U8_IS_SINGLE(*(src-1))) {
+                    prevBoundary=src-1;
+                    prevCC=0;
+                } else {
+                    prevBoundary=src-2;
+                    // Below MIN_CCC_LCCC_CP, lccc=0 but tccc may not be 0.
+                    prevCC= form==UTF8_FCD ?
+                        (uint8_t)getFCD16(((*prevBoundary&0x1f)<<6)|(*(src-1)&0x3f)) : 0;
+                }
+                continue;
+            }
+        }
+        const uint8_t *cpStart=src;
+        uint16_t norm16;
+        UTRIE2_U8_NEXT16(normTrie, src, limit, norm16);
+        if(norm16<minNoNorm16) {
+            prevBoundary=cpStart;
+            prevCC=0;
+            continue;
+        }
+        int32_t i=0;
+        UChar32 c;
+        U8_NEXT(cpStart, i, (int32_t)(limit-cpStart), c);
+        src=cpStart+i;
+        if(c<0) {
+            // An ill-formed sequence is inert.
+            prevBoundary=cpStart;
+            prevCC=0;
+            continue;
+        }
+        // Pass characters that are normalized in context,
+        // including properly ordered combining marks.
+        if(form==UTF8_DECOMPOSE && isDecompYes(norm16)) {
+            uint8_t cc=getCCFromYesOrMaybe(norm16);
+            if(cc==0 || prevCC<=cc) {
+                if(cc==0) {
+                    prevBoundary=cpStart;
+                }
+                prevCC=cc;
+                continue;
+            }
+        } else if(form==UTF8_FCD) {
+            uint16_t fcd16=getFCD16(c);
+            uint8_t leadCC=(uint8_t)(fcd16>>8);
+            if(leadCC==0 || prevCC<=leadCC) {
+                if(leadCC==0) {
+                    prevBoundary=cpStart;
+                }
+                prevCC=(uint8_t)fcd16;
+                continue;
+            }
+        }
+
+        // The segment starts at prevBoundary, unless that is an ill-formed sequence
+        // which the fast path passed.
+        if(prevBoundary!=cpStart) {
+            UChar32 prev;
+            i=0;
+            U8_NEXT(prevBoundary, i, (int32_t)(cpStart-prevBoundary), prev);
+            if(prev<0) {
+                prevBoundary+=i;
+            }
+        }
+        // Find the end of the segment, at the next boundary.
+        while(src!=limit) {
+            i=0;
+            U8_NEXT(src, i, (int32_t)(limit-src), c);
+            if(c<0 || hasUTF8BoundaryBefore(form, c)) {
+                break;
+            }
+            src+=i;
+        }
+        if(chunkStart!=NULL && (prevBoundary-chunkLimit)>maxChunkGap) {
+            ok=flushUTF8Chunk(form, onlyContiguous, resolveMaybe, chunkStart, chunkLimit,
+                              unwritten, sink, s16, normalized, errorCode);
+            if(!ok) {
+                break;
+            }
+            if(sink!=NULL && maxChunkGap>=0 && unwritten==chunkLimit) {
+                // The chunk was changed. If that is true for most of the text so far,
+                // then normalize the rest in one chunk without looking for segments.
+                changedLength+=(int32_t)(chunkLimit-chunkStart);
+                int32_t doneLength=(int32_t)(chunkLimit-start);
+                if(doneLength>=UTF8_MIN_LENGTH_FOR_REST && changedLength>doneLength/2) {
+                    chunkStart=prevBoundary;
+                    chunkLimit=limit;
+                    break;
+                }
+            }
+            chunkStart=NULL;
+        }
+        if(chunkStart==NULL) {
+            chunkStart=prevBoundary;
+        }
+        chunkLimit=src;
+        prevBoundary=src;
+        prevCC=0;
+    }
+    if(ok && chunkStart!=NULL) {
+        ok=flushUTF8Chunk(form, onlyContiguous, resolveMaybe, chunkStart, chunkLimit,
+                          unwritten, sink, s16, normalized, errorCode);
+    }
+    if(!ok) {
+        if(sink!=NULL || U_FAILURE(errorCode) || maxChunkGap<0) {
+            return chunkStart;
+        }
+        // Find the exact end of the normalized prefix, checking one segment at a time.
+        return normalizeUTF8(form, onlyContiguous, resolveMaybe, chunkStart, chunkLimit,
+                             NULL, -1, errorCode);
+    }
+    if(sink!=NULL && unwritten!=limit) {
+        sink->Append((const char *)unwritten, (int32_t)(limit-unwritten));
+    }
+    return limit;
+}
+
+const uint8_t *
+Normalizer2Impl::decomposeUTF8(const uint8_t *src, const uint8_t *limit,
+                               ByteSink *sink, UErrorCode &errorCode) const {
+    return normalizeUTF8(UTF8_DECOMPOSE, FALSE, TRUE, src, limit,
+                         sink, UTF8_MAX_CHUNK_GAP, errorCode);
+}
+
+const uint8_t *
+Normalizer2Impl::composeUTF8(const uint8_t *src, const uint8_t *limit,
+                             UBool onlyContiguous, UBool resolveMaybe,
+                             ByteSink *sink, UErrorCode &errorCode) const {
+    return normalizeUTF8(UTF8_COMPOSE, onlyContiguous, resolveMaybe, src, limit,
+                         sink, UTF8_MAX_CHUNK_GAP, errorCode);
+}
+
+const uint8_t *
+Normalizer2Impl::makeFCDUTF8(const uint8_t *src, const uint8_t *limit,
+                             ByteSink *sink, UErrorCode &errorCode) const {
+    return normalizeUTF8(UTF8_FCD, FALSE, TRUE, src, limit,
+                         sink, UTF8_MAX_CHUNK_GAP, errorCode);
+}
+
 // CanonicalIterator data -------------------------------------------------- ***
 
 CanonIterData::CanonIterData(UErrorCode &errorCode) :
@@ -424,6 +424,28 @@ public:
 
     // higher-level functionality ------------------------------------------ ***
 
+    /**
+     * Returns the end of the longest prefix of [src, limit[
+     * whose code units are all below minCP.
+     * Short runs are checked inline; long runs are skipped
+     * 8 or 16 code units at a time where SIMD is available.
+     */
+    static inline const UChar *spanLow(const UChar *src, const UChar *limit, UChar32 minCP) {
+        const UChar *inlineLimit= (limit-src)>8 ? src+8 : limit;
+        for(; src!=inlineLimit; ++src) {
+            if(*src>=minCP) {
+                return src;
+            }
+        }
+        return src==limit ? src : spanLongLow(src, limit, minCP);
+    }
+    /**
+     * UTF-8 version of spanLow(): Returns the end of the longest prefix of [src, limit[
+     * which consists of well-formed one- and two-byte sequences for code points below minCP.
+     * Runs of single bytes are skipped 16 at a time where SIMD is available.
+     */
+    static const uint8_t *spanLowUTF8(const uint8_t *src, const uint8_t *limit, UChar32 minCP);
+
     // NFD without an NFD Normalizer2 instance.
     UnicodeString &decompose(const UnicodeString &src, UnicodeString &dest,
                              UErrorCode &errorCode) const;
@@ -465,6 +487,27 @@ public:
                           ReorderingBuffer &buffer,
                           UErrorCode &errorCode) const;
 
+    /**
+     * UTF-8 versions of decompose(), compose() and makeFCD().
+     * They check the text directly on its bytes; only segments around characters
+     * that may need to change are converted to UTF-16 and run through the code above.
+     * Ill-formed sequences are inert and passed through unchanged.
+     *
+     * sink!=NULL: Writes the normalized text to the sink and returns limit.
+     * Normalized spans are appended to the sink directly from the source.
+     *
+     * sink==NULL: Returns the end of the normalized prefix, at a boundary.
+     * For composition, resolveMaybe=FALSE stops before a quick check "maybe" segment
+     * (spanQuickCheckYes() semantics) rather than checking whether it is normalized.
+     */
+    const uint8_t *decomposeUTF8(const uint8_t *src, const uint8_t *limit,
+                                 ByteSink *sink, UErrorCode &errorCode) const;
+    const uint8_t *composeUTF8(const uint8_t *src, const uint8_t *limit,
+                               UBool onlyContiguous, UBool resolveMaybe,
+                               ByteSink *sink, UErrorCode &errorCode) const;
+    const uint8_t *makeFCDUTF8(const uint8_t *src, const uint8_t *limit,
+                               ByteSink *sink, UErrorCode &errorCode) const;
+
     UBool hasDecompBoundary(UChar32 c, UBool before) const;
     UBool isDecompInert(UChar32 c) const { return isDecompYesAndZeroCC(getNorm16(c)); }
 
@@ -559,6 +602,23 @@ private:
                 getCompositionsListForComposite(norm16);
     }
 
+    enum UTF8Form { UTF8_DECOMPOSE, UTF8_COMPOSE, UTF8_FCD };
+    UBool hasUTF8BoundaryBefore(UTF8Form form, UChar32 c) const;
+    UBool isUTF8SegmentNormalized(UTF8Form form, UBool onlyContiguous, UBool resolveMaybe,
+                                  const UnicodeString &segment, UErrorCode &errorCode) const;
+    UBool flushUTF8Chunk(UTF8Form form, UBool onlyContiguous, UBool resolveMaybe,
+                         const uint8_t *start, const uint8_t *limit,
+                         const uint8_t *&unwritten, ByteSink *sink,
+                         UnicodeString &s16, UnicodeString &normalized,
+                         UErrorCode &errorCode) const;
+    const uint8_t *normalizeUTF8(UTF8Form form, UBool onlyContiguous, UBool resolveMaybe,
+                                 const uint8_t *src, const uint8_t *limit,
+                                 ByteSink *sink, int32_t maxChunkGap,
+                                 UErrorCode &errorCode) const;
+
+    // Out-of-line part of spanLow() for runs longer than 8 code units.
+    static const UChar *spanLongLow(const UChar *src, const UChar *limit, UChar32 minCP);
+
     const UChar *copyLowPrefixFromNulTerminated(const UChar *src,
                                                 UChar32 minNeedDataCP,
                                                 ReorderingBuffer *buffer,
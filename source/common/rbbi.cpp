@@ -32,7 +32,9 @@
 #include "brkeng.h"
 
 #include "uassert.h"
+#include "uparallel.h"
 #include "uvector.h"
+#include "uvectr32.h"
 
 // if U_LOCAL_SERVICE_HOOK is defined, then localsvc.cpp is expected to be included.
 #if U_LOCAL_SERVICE_HOOK
@@ -244,6 +246,12 @@ RuleBasedBreakIterator::operator=(const RuleBasedBreakIterator& that) {
         fData = that.fData->addReference();
     }
 
+    uprv_memcpy(fBoundaries, that.fBoundaries, sizeof(fBoundaries));
+    uprv_memcpy(fStatuses, that.fStatuses, sizeof(fStatuses));
+    fStartBufIdx = that.fStartBufIdx;
+    fEndBufIdx   = that.fEndBufIdx;
+    fBufIdx      = that.fBufIdx;
+
     return *this;
 }
 
@@ -276,6 +284,12 @@ void RuleBasedBreakIterator::init() {
     fNumCachedBreakPositions = 0;
     fPositionInCache         = 0;
 
+    fBoundaries[0]           = 0;
+    fStatuses[0]             = 0;
+    fStartBufIdx             = 0;
+    fEndBufIdx               = 0;
+    fBufIdx                  = 0;
+
 #ifdef RBBI_DEBUG
     static UBool debugInitDone = FALSE;
     if (debugInitDone == FALSE) {
@@ -372,6 +386,7 @@ void RuleBasedBreakIterator::setText(UText *ut, UErrorCode &status) {
     }
     fCharIter = fDCharIter;
 
+    seedCache(0, 0);
     this->first();
 }
 
@@ -438,6 +453,7 @@ RuleBasedBreakIterator::adoptText(CharacterIterator* newText) {
     } else {
         fText = utext_openCharacterIterator(fText, newText, &status);
     }
+    seedCache(0, 0);
     this->first();
 }
 
@@ -468,6 +484,7 @@ RuleBasedBreakIterator::setText(const UnicodeString& newText) {
     }
     fCharIter = fSCharIter;
 
+    seedCache(0, 0);
     this->first();
 }
 
@@ -509,13 +526,12 @@ RuleBasedBreakIterator &RuleBasedBreakIterator::refreshInputText(UText *input, U
  * @return The new iterator position, which is zero.
  */
 int32_t RuleBasedBreakIterator::first(void) {
-    reset();
-    fLastRuleStatusIndex  = 0;
-    fLastStatusIndexValid = TRUE;
-    //if (fText == NULL)
-    //    return BreakIterator::DONE;
-
-    utext_setNativeIndex(fText, 0);
+    if (fBoundaries[fStartBufIdx] == 0) {
+        fBufIdx = fStartBufIdx;
+        utext_setNativeIndex(fText, 0);
+    } else {
+        seedCache(0, 0);
+    }
     return 0;
 }
 
@@ -524,16 +540,18 @@ int32_t RuleBasedBreakIterator::first(void) {
  * @return The text's past-the-end offset.
  */
 int32_t RuleBasedBreakIterator::last(void) {
-    reset();
     if (fText == NULL) {
-        fLastRuleStatusIndex  = 0;
-        fLastStatusIndexValid = TRUE;
+        seedCache(0, 0);
         return BreakIterator::DONE;
     }
 
-    fLastStatusIndexValid = FALSE;
     int32_t pos = (int32_t)utext_nativeLength(fText);
-    utext_setNativeIndex(fText, pos);
+    if (fBoundaries[fEndBufIdx] == pos) {
+        fBufIdx = fEndBufIdx;
+        utext_setNativeIndex(fText, pos);
+    } else {
+        seedCache(pos, -1);
+    }
     return pos;
 }
 
@@ -564,6 +582,358 @@ int32_t RuleBasedBreakIterator::next(int32_t n) {
  * @return The position of the first boundary after this one.
  */
 int32_t RuleBasedBreakIterator::next(void) {
+    if (fBufIdx == fEndBufIdx && !addFollowing()) {
+        utext_setNativeIndex(fText, fBoundaries[fBufIdx]);
+        return BreakIterator::DONE;
+    }
+    fBufIdx = (fBufIdx + 1) & (kBoundaryCacheSize - 1);
+    int32_t pos = fBoundaries[fBufIdx];
+    UTEXT_SETNATIVEINDEX(fText, pos);
+    return pos;
+}
+
+/**
+ * Advances the iterator backwards, to the last boundary preceding this one.
+ * @return The position of the last boundary position preceding this one.
+ */
+int32_t RuleBasedBreakIterator::previous(void) {
+    if (fBufIdx == fStartBufIdx && !addPreceding()) {
+        utext_setNativeIndex(fText, fBoundaries[fBufIdx]);
+        return BreakIterator::DONE;
+    }
+    fBufIdx = (fBufIdx - 1) & (kBoundaryCacheSize - 1);
+    int32_t pos = fBoundaries[fBufIdx];
+    UTEXT_SETNATIVEINDEX(fText, pos);
+    return pos;
+}
+
+/**
+ * Sets the iterator to refer to the first boundary position following
+ * the specified position.
+ * @offset The position from which to begin searching for a break position.
+ * @return The position of the first break after the current position.
+ */
+int32_t RuleBasedBreakIterator::following(int32_t offset) {
+    // if the offset passed in is already past the end of the text,
+    // just return DONE; if it's before the beginning, return the
+    // text's starting offset
+    if (fText == NULL || offset >= utext_nativeLength(fText)) {
+        last();
+        return next();
+    }
+    else if (offset < 0) {
+        return first();
+    }
+
+    // Move requested offset to a code point start. It might be on a trail surrogate,
+    // or on a trail byte if the input is UTF-8.
+    utext_setNativeIndex(fText, offset);
+    offset = (int32_t)utext_getNativeIndex(fText);
+
+    // Near the boundaries found so far, step from the last one at or before offset.
+    if (seekCache(offset)) {
+        return next();
+    }
+
+    // Far from them, start over.  The last boundary found is the one wanted.
+    if (seedCacheNear(offset)) {
+        fBufIdx = fEndBufIdx;
+        UTEXT_SETNATIVEINDEX(fText, fBoundaries[fBufIdx]);
+        return fBoundaries[fBufIdx];
+    }
+
+    // Rules without safe reverse rules start over from a boundary found by the state machine.
+    int32_t result = engineFollowing(offset);
+    if (result == BreakIterator::DONE) {
+        last();
+        return next();
+    }
+    seedCache(result, fLastStatusIndexValid ? fLastRuleStatusIndex : -1);
+    return result;
+}
+
+/**
+ * Sets the iterator to refer to the last boundary position before the
+ * specified position.
+ * @offset The position to begin searching for a break from.
+ * @return The position of the last boundary before the starting position.
+ */
+int32_t RuleBasedBreakIterator::preceding(int32_t offset) {
+    // if the offset passed in is already past the end of the text,
+    // just return DONE; if it's before the beginning, return the
+    // text's starting offset
+    if (fText == NULL || offset > utext_nativeLength(fText)) {
+        return last();
+    }
+    else if (offset < 0) {
+        return first();
+    }
+
+    // Move requested offset to a code point start. It might be on a trail surrogate,
+    // or on a trail byte if the input is UTF-8.
+    utext_setNativeIndex(fText, offset);
+    offset = (int32_t)utext_getNativeIndex(fText);
+
+    if (offset == 0) {
+        first();
+        return BreakIterator::DONE;
+    }
+
+    if (seekCache(offset)) {
+        if (fBoundaries[fBufIdx] == offset) {
+            return previous();
+        }
+        utext_setNativeIndex(fText, fBoundaries[fBufIdx]);
+        return fBoundaries[fBufIdx];
+    }
+
+    // Far from them, start over from the boundary found by the state machine.
+    int32_t result = enginePreceding(offset);
+    if (result == BreakIterator::DONE) {
+        first();
+        return BreakIterator::DONE;
+    }
+    seedCache(result, fLastStatusIndexValid ? fLastRuleStatusIndex : -1);
+    return result;
+}
+
+/**
+ * Returns true if the specfied position is a boundary position.  As a side
+ * effect, leaves the iterator pointing to the first boundary position at
+ * or after "offset".
+ * @param offset the offset to check.
+ * @return True if "offset" is a boundary position.
+ */
+UBool RuleBasedBreakIterator::isBoundary(int32_t offset) {
+    // Within the boundary cache, the answer is there.
+    if (offset > fBoundaries[fStartBufIdx] && offset < fBoundaries[fEndBufIdx]) {
+        int32_t lo = 1;
+        int32_t hi = (fEndBufIdx - fStartBufIdx) & (kBoundaryCacheSize - 1);
+        while (lo < hi) {
+            int32_t mid = (lo + hi) / 2;
+            if (fBoundaries[(fStartBufIdx + mid) & (kBoundaryCacheSize - 1)] < offset) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        fBufIdx = (fStartBufIdx + lo) & (kBoundaryCacheSize - 1);
+        utext_setNativeIndex(fText, fBoundaries[fBufIdx]);
+        return fBoundaries[fBufIdx] == offset;
+    }
+
+    // the beginning index of the iterator is always a boundary position by definition
+    if (offset == 0) {
+        first();       // For side effects on current position, tag values.
+        return TRUE;
+    }
+
+    if (offset == (int32_t)utext_nativeLength(fText)) {
+        last();       // For side effects on current position, tag values.
+        return TRUE;
+    }
+
+    // out-of-range indexes are never boundary positions
+    if (offset < 0) {
+        first();       // For side effects on current position, tag values.
+        return FALSE;
+    }
+
+    if (offset > utext_nativeLength(fText)) {
+        last();        // For side effects on current position, tag values.
+        return FALSE;
+    }
+
+    // otherwise, we can use following() on the position before the specified
+    // one and return true if the position we get back is the one the user
+    // specified.  Near recently visited text, following() is served from the
+    // boundary cache.
+    utext_previous32From(fText, offset);
+    int32_t backOne = (int32_t)UTEXT_GETNATIVEINDEX(fText);
+    UBool    result  = following(backOne) == offset;
+    return result;
+}
+
+/**
+ * Returns the current iteration position.
+ * @return The current iteration position.
+ */
+int32_t RuleBasedBreakIterator::current(void) const {
+    return fBoundaries[fBufIdx];
+}
+
+
+//-------------------------------------------------------------------------------
+//
+//   Boundary cache
+//
+//       fBoundaries holds a run of consecutive boundaries, each one the boundary
+//       that the state machine finds following the one before it.  The iteration
+//       functions above step through it, and extend it a boundary at a time when
+//       they step off either end.  Positions within kNearDistance of the cached
+//       range are reached by extending the cache; positions further away start
+//       a new cache from a boundary found with the safe rules.
+//
+//       Boundaries found going backwards do not get a rule status from the
+//       state machine.  makeRuleStatusValid() determines it when it is asked for.
+//
+//-------------------------------------------------------------------------------
+
+static const int32_t kNearDistance = 4;
+
+void RuleBasedBreakIterator::seedCache(int32_t pos, int32_t statusIndex) {
+    fStartBufIdx = 0;
+    fEndBufIdx   = 0;
+    fBufIdx      = 0;
+    fBoundaries[0] = pos;
+    fStatuses[0]   = statusIndex;
+    UTEXT_SETNATIVEINDEX(fText, pos);
+}
+
+
+void RuleBasedBreakIterator::positionEngine(int32_t pos) {
+    if (fCachedBreakPositions != NULL) {
+        if (fCachedBreakPositions[fPositionInCache] != pos) {
+            int32_t lo = 0;
+            int32_t hi = fNumCachedBreakPositions - 1;
+            while (lo < hi) {
+                int32_t mid = (lo + hi) / 2;
+                if (fCachedBreakPositions[mid] < pos) {
+                    lo = mid + 1;
+                } else {
+                    hi = mid;
+                }
+            }
+            if (fCachedBreakPositions[lo] == pos) {
+                fPositionInCache = lo;
+            } else {
+                reset();
+            }
+        }
+    }
+    UTEXT_SETNATIVEINDEX(fText, pos);
+}
+
+
+//
+//  seedCacheNear()   Start the boundary cache over, with the boundaries from a safe
+//                    position at or before pos to the first one after pos.
+//                    The first boundary following a safe position is a real one,
+//                    but its rule status is not known.
+//
+UBool RuleBasedBreakIterator::seedCacheNear(int32_t pos) {
+    if (fData->fSafeRevTable == NULL) {
+        return FALSE;
+    }
+    reset();
+    utext_setNativeIndex(fText, pos);
+    (void)UTEXT_NEXT32(fText);
+    handlePrevious(fData->fSafeRevTable);
+    if (UTEXT_GETNATIVEINDEX(fText) == 0) {
+        seedCache(0, 0);
+    } else {
+        int32_t result = engineNext();
+        if (result == BreakIterator::DONE) {
+            return FALSE;
+        }
+        seedCache(result, -1);
+    }
+    while (fBoundaries[fEndBufIdx] <= pos && addFollowing()) {
+    }
+    return TRUE;
+}
+
+
+UBool RuleBasedBreakIterator::addFollowing() {
+    int32_t from = fBoundaries[fEndBufIdx];
+    if (fCachedBreakPositions != NULL || UTEXT_GETNATIVEINDEX(fText) != from) {
+        positionEngine(from);
+    }
+    int32_t pos = engineNext();
+    if (pos == BreakIterator::DONE || pos <= from) {
+        return FALSE;
+    }
+    fEndBufIdx = (fEndBufIdx + 1) & (kBoundaryCacheSize - 1);
+    if (fEndBufIdx == fStartBufIdx) {
+        // The cache is full; drop its first boundary.
+        fStartBufIdx = (fStartBufIdx + 1) & (kBoundaryCacheSize - 1);
+    }
+    fBoundaries[fEndBufIdx] = pos;
+    fStatuses[fEndBufIdx]   = fLastStatusIndexValid ? fLastRuleStatusIndex : -1;
+    return TRUE;
+}
+
+
+UBool RuleBasedBreakIterator::addPreceding() {
+    int32_t from = fBoundaries[fStartBufIdx];
+    if (from == 0) {
+        return FALSE;
+    }
+    positionEngine(from);
+    int32_t pos = enginePrevious();
+    if (pos == BreakIterator::DONE || pos >= from) {
+        return FALSE;
+    }
+    fStartBufIdx = (fStartBufIdx - 1) & (kBoundaryCacheSize - 1);
+    if (fStartBufIdx == fEndBufIdx) {
+        // The cache is full; drop its last boundary.
+        fEndBufIdx = (fEndBufIdx - 1) & (kBoundaryCacheSize - 1);
+    }
+    fBoundaries[fStartBufIdx] = pos;
+    fStatuses[fStartBufIdx]   = -1;
+    return TRUE;
+}
+
+
+UBool RuleBasedBreakIterator::seekCache(int32_t pos) {
+    if (pos < fBoundaries[fStartBufIdx] - kNearDistance ||
+            pos > fBoundaries[fEndBufIdx] + kNearDistance) {
+        return FALSE;
+    }
+    while (fBoundaries[fStartBufIdx] > pos) {
+        if (!addPreceding()) {
+            return FALSE;
+        }
+    }
+    while (fBoundaries[fEndBufIdx] <= pos) {
+        if (!addFollowing()) {
+            break;
+        }
+    }
+
+    // Most often pos is at or just after the current position.
+    int32_t nextIdx = (fBufIdx + 1) & (kBoundaryCacheSize - 1);
+    if (fBoundaries[fBufIdx] <= pos && (fBufIdx == fEndBufIdx || fBoundaries[nextIdx] > pos)) {
+        UTEXT_SETNATIVEINDEX(fText, fBoundaries[fBufIdx]);
+        return TRUE;
+    }
+
+    // Otherwise, binary search, in cache order, for the last boundary at or before pos.
+    int32_t lo = 0;
+    int32_t hi = (fEndBufIdx - fStartBufIdx) & (kBoundaryCacheSize - 1);
+    while (lo < hi) {
+        int32_t mid = (lo + hi + 1) / 2;
+        if (fBoundaries[(fStartBufIdx + mid) & (kBoundaryCacheSize - 1)] <= pos) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    fBufIdx = (fStartBufIdx + lo) & (kBoundaryCacheSize - 1);
+    UTEXT_SETNATIVEINDEX(fText, fBoundaries[fBufIdx]);
+    return TRUE;
+}
+
+
+//-------------------------------------------------------------------------------
+//
+//   engineNext(), enginePrevious(), engineFollowing(), enginePreceding()
+//
+//       Find boundaries with the state machine, starting from the text position
+//       of fText.  Used to fill the boundary cache.
+//
+//-------------------------------------------------------------------------------
+int32_t RuleBasedBreakIterator::engineNext() {
     // if we have cached break positions and we're still in the range
     // covered by them, just move one step forward in the cache
     if (fCachedBreakPositions != NULL) {
@@ -578,7 +948,7 @@ int32_t RuleBasedBreakIterator::next(void) {
         }
     }
 
-    int32_t startPos = current();
+    int32_t startPos = (int32_t)UTEXT_GETNATIVEINDEX(fText);
     fDictionaryCharCount = 0;
     int32_t result = handleNext(fData->fForwardTable);
     if (fDictionaryCharCount > 0) {
@@ -587,11 +957,7 @@ int32_t RuleBasedBreakIterator::next(void) {
     return result;
 }
 
-/**
- * Advances the iterator backwards, to the last boundary preceding this one.
- * @return The position of the last boundary position preceding this one.
- */
-int32_t RuleBasedBreakIterator::previous(void) {
+int32_t RuleBasedBreakIterator::enginePrevious() {
     int32_t result;
     int32_t startPos;
 
@@ -615,7 +981,7 @@ int32_t RuleBasedBreakIterator::previous(void) {
     }
 
     // if we're already sitting at the beginning of the text, return DONE
-    if (fText == NULL || (startPos = current()) == 0) {
+    if (fText == NULL || (startPos = (int32_t)UTEXT_GETNATIVEINDEX(fText)) == 0) {
         fLastRuleStatusIndex  = 0;
         fLastStatusIndexValid = TRUE;
         return BreakIterator::DONE;
@@ -636,7 +1002,7 @@ int32_t RuleBasedBreakIterator::previous(void) {
     // the current position), but not necessarily the last one before
     // where we started
 
-    int32_t start = current();
+    int32_t start = startPos;
 
     (void)UTEXT_PREVIOUS32(fText);
     int32_t lastResult    = handlePrevious(fData->fReverseTable);
@@ -653,7 +1019,7 @@ int32_t RuleBasedBreakIterator::previous(void) {
     // point is our return value
 
     for (;;) {
-        result         = next();
+        result         = engineNext();
         if (result == BreakIterator::DONE || result >= start) {
             break;
         }
@@ -681,29 +1047,10 @@ int32_t RuleBasedBreakIterator::previous(void) {
     return lastResult;
 }
 
-/**
- * Sets the iterator to refer to the first boundary position following
- * the specified position.
- * @offset The position from which to begin searching for a break position.
- * @return The position of the first break after the current position.
- */
-int32_t RuleBasedBreakIterator::following(int32_t offset) {
-    // if the offset passed in is already past the end of the text,
-    // just return DONE; if it's before the beginning, return the
-    // text's starting offset
-    if (fText == NULL || offset >= utext_nativeLength(fText)) {
-        last();
-        return next();
-    }
-    else if (offset < 0) {
-        return first();
-    }
-
-    // Move requested offset to a code point start. It might be on a trail surrogate,
-    // or on a trail byte if the input is UTF-8.
-    utext_setNativeIndex(fText, offset);
-    offset = (int32_t)utext_getNativeIndex(fText);
-
+//
+//  engineFollowing()   offset is a code point start, 0 <= offset < the text length.
+//
+int32_t RuleBasedBreakIterator::engineFollowing(int32_t offset) {
     // if we have cached break positions and offset is in the range
     // covered by them, use them
     // TODO: could use binary search
@@ -741,9 +1088,9 @@ int32_t RuleBasedBreakIterator::following(int32_t offset) {
         (void)UTEXT_NEXT32(fText);
         // handlePrevious will move most of the time to < 1 boundary away
         handlePrevious(fData->fSafeRevTable);
-        int32_t result = next();
+        int32_t result = engineNext();
         while (result <= offset) {
-            result = next();
+            result = engineNext();
         }
         return result;
     }
@@ -756,17 +1103,18 @@ int32_t RuleBasedBreakIterator::following(int32_t offset) {
         // previous will give result 0 or 1 boundary away from offset,
         // most of the time
         // we have to
-        int32_t oldresult = previous();
+        int32_t oldresult = enginePrevious();
         while (oldresult > offset) {
-            int32_t result = previous();
+            int32_t result = enginePrevious();
             if (result <= offset) {
+                utext_setNativeIndex(fText, oldresult);
                 return oldresult;
             }
             oldresult = result;
         }
-        int32_t result = next();
+        int32_t result = engineNext();
         if (result <= offset) {
-            return next();
+            return engineNext();
         }
         return result;
     }
@@ -780,41 +1128,23 @@ int32_t RuleBasedBreakIterator::following(int32_t offset) {
     // old rule syntax
 
     utext_setNativeIndex(fText, offset);
-    if (offset==0 || 
+    if (offset==0 ||
         (offset==1  && utext_getNativeIndex(fText)==0)) {
-        return next();
+        return engineNext();
     }
-    result = previous();
+    result = enginePrevious();
 
     while (result != BreakIterator::DONE && result <= offset) {
-        result = next();
+        result = engineNext();
     }
 
     return result;
 }
 
-/**
- * Sets the iterator to refer to the last boundary position before the
- * specified position.
- * @offset The position to begin searching for a break from.
- * @return The position of the last boundary before the starting position.
- */
-int32_t RuleBasedBreakIterator::preceding(int32_t offset) {
-    // if the offset passed in is already past the end of the text,
-    // just return DONE; if it's before the beginning, return the
-    // text's starting offset
-    if (fText == NULL || offset > utext_nativeLength(fText)) {
-        return last();
-    }
-    else if (offset < 0) {
-        return first();
-    }
-
-    // Move requested offset to a code point start. It might be on a trail surrogate,
-    // or on a trail byte if the input is UTF-8.
-    utext_setNativeIndex(fText, offset);
-    offset = (int32_t)utext_getNativeIndex(fText);
-
+//
+//  enginePreceding()   offset is a code point start, 0 < offset <= the text length.
+//
+int32_t RuleBasedBreakIterator::enginePreceding(int32_t offset) {
     // if we have cached break positions and offset is in the range
     // covered by them, use them
     if (fCachedBreakPositions != NULL) {
@@ -867,7 +1197,7 @@ int32_t RuleBasedBreakIterator::preceding(int32_t offset) {
         handleNext(fData->fSafeFwdTable);
         int32_t result = (int32_t)UTEXT_GETNATIVEINDEX(fText);
         while (result >= offset) {
-            result = previous();
+            result = enginePrevious();
         }
         return result;
     }
@@ -879,79 +1209,32 @@ int32_t RuleBasedBreakIterator::preceding(int32_t offset) {
         //            to anyone how to work with just one safe table.
         utext_setNativeIndex(fText, offset);
         (void)UTEXT_NEXT32(fText);
-        
+
         // handle previous will give result <= offset
         handlePrevious(fData->fSafeRevTable);
 
         // next will give result 0 or 1 boundary away from offset,
         // most of the time
         // we have to
-        int32_t oldresult = next();
+        int32_t oldresult = engineNext();
         while (oldresult < offset) {
-            int32_t result = next();
+            int32_t result = engineNext();
             if (result >= offset) {
+                utext_setNativeIndex(fText, oldresult);
                 return oldresult;
             }
             oldresult = result;
         }
-        int32_t result = previous();
+        int32_t result = enginePrevious();
         if (result >= offset) {
-            return previous();
+            return enginePrevious();
         }
         return result;
     }
 
     // old rule syntax
     utext_setNativeIndex(fText, offset);
-    return previous();
-}
-
-/**
- * Returns true if the specfied position is a boundary position.  As a side
- * effect, leaves the iterator pointing to the first boundary position at
- * or after "offset".
- * @param offset the offset to check.
- * @return True if "offset" is a boundary position.
- */
-UBool RuleBasedBreakIterator::isBoundary(int32_t offset) {
-    // the beginning index of the iterator is always a boundary position by definition
-    if (offset == 0) {
-        first();       // For side effects on current position, tag values.
-        return TRUE;
-    }
-
-    if (offset == (int32_t)utext_nativeLength(fText)) {
-        last();       // For side effects on current position, tag values.
-        return TRUE;
-    }
-
-    // out-of-range indexes are never boundary positions
-    if (offset < 0) {
-        first();       // For side effects on current position, tag values.
-        return FALSE;
-    }
-
-    if (offset > utext_nativeLength(fText)) {
-        last();        // For side effects on current position, tag values.
-        return FALSE;
-    }
-
-    // otherwise, we can use following() on the position before the specified
-    // one and return true if the position we get back is the one the user
-    // specified
-    utext_previous32From(fText, offset);
-    int32_t backOne = (int32_t)UTEXT_GETNATIVEINDEX(fText);
-    UBool    result  = following(backOne) == offset;
-    return result;
-}
-
-/**
- * Returns the current iteration position.
- * @return The current iteration position.
- */
-int32_t RuleBasedBreakIterator::current(void) const {
-    int32_t  pos = (int32_t)UTEXT_GETNATIVEINDEX(fText);
-    return pos;
+    return enginePrevious();
 }
  
 //=======================================================================
@@ -1027,19 +1310,30 @@ struct LookAheadResults {
 //     of the text or the state machine transitions to state 0.  We update our return
 //     value every time the state machine passes through an accepting state.
 //
+//     The state machine is compiled once for each kind of table row.
+//
 //-----------------------------------------------------------------------------------
 int32_t RuleBasedBreakIterator::handleNext(const RBBIStateTable *statetable) {
+    if (statetable->fFlags & RBBI_8BITS_ROWS) {
+        return handleNextRows<RBBIStateTableRow8>(statetable);
+    }
+    return handleNextRows<RBBIStateTableRow>(statetable);
+}
+
+template<typename RowType>
+int32_t RuleBasedBreakIterator::handleNextRows(const RBBIStateTable *statetable) {
     int32_t             state;
     uint16_t            category        = 0;
     RBBIRunMode         mode;
     
-    RBBIStateTableRow  *row;
+    const RowType      *row;
     UChar32             c;
     LookAheadResults    lookAheadMatches;
     int32_t             result             = 0;
     int32_t             initialPosition    = 0;
     const char         *tableData          = statetable->fTableData;
     uint32_t            tableRowLen        = statetable->fRowLen;
+    const UTrie2       *trie               = fData != NULL ? fData->fTrie : NULL;
 
     #ifdef RBBI_DEBUG
         if (fTrace) {
@@ -1061,7 +1355,7 @@ int32_t RuleBasedBreakIterator::handleNext(const RBBIStateTable *statetable) {
 
     //  Set the initial state for the state machine
     state = START_STATE;
-    row = (RBBIStateTableRow *)
+    row = (const RowType *)
             //(statetable->fTableData + (statetable->fRowLen * state));
             (tableData + tableRowLen * state);
             
@@ -1097,10 +1391,10 @@ int32_t RuleBasedBreakIterator::handleNext(const RBBIStateTable *statetable) {
         if (mode == RBBI_RUN) {
             // look up the current character's character category, which tells us
             // which column in the state table to look at.
-            // Note:  the 16 in UTRIE_GET16 refers to the size of the data being returned,
+            // Note:  the 16 in UTRIE2_GET16 refers to the size of the data being returned,
             //        not the size of the character going in, which is a UChar32.
             //
-            UTRIE_GET16(&fData->fTrie, c, category);
+            category = UTRIE2_GET16(trie, c);
 
             // Check the dictionary bit in the character's category.
             //    Counter is only used by dictionary based iterators (subclasses).
@@ -1134,21 +1428,19 @@ int32_t RuleBasedBreakIterator::handleNext(const RBBIStateTable *statetable) {
         // actually have more than 2 categories.
         U_ASSERT(category<fData->fHeader->fCatCount);
         state = row->fNextState[category];  /*Not accessing beyond memory*/
-        row = (RBBIStateTableRow *)
+        row = (const RowType *)
             // (statetable->fTableData + (statetable->fRowLen * state));
             (tableData + tableRowLen * state);
 
 
-        if (row->fAccepting == -1) {
+        int16_t completedRule = row->fAccepting;
+        if (completedRule == RowType::kAcceptingUnconditional) {
             // Match found, common case.
             if (mode != RBBI_START) {
                 result = (int32_t)UTEXT_GETNATIVEINDEX(fText);
             }
             fLastRuleStatusIndex = row->fTagIdx;   // Remember the break status (tag) values.
-        }
-
-        int16_t completedRule = row->fAccepting;
-        if (completedRule > 0) {
+        } else if (completedRule > 0) {
             // Lookahead match is completed.  
             int32_t lookaheadResult = lookAheadMatches.getPosition(completedRule);
             if (lookaheadResult >= 0) {
@@ -1220,14 +1512,23 @@ int32_t RuleBasedBreakIterator::handleNext(const RBBIStateTable *statetable) {
 //
 //-----------------------------------------------------------------------------------
 int32_t RuleBasedBreakIterator::handlePrevious(const RBBIStateTable *statetable) {
+    if (statetable->fFlags & RBBI_8BITS_ROWS) {
+        return handlePreviousRows<RBBIStateTableRow8>(statetable);
+    }
+    return handlePreviousRows<RBBIStateTableRow>(statetable);
+}
+
+template<typename RowType>
+int32_t RuleBasedBreakIterator::handlePreviousRows(const RBBIStateTable *statetable) {
     int32_t             state;
     uint16_t            category        = 0;
     RBBIRunMode         mode;
-    RBBIStateTableRow  *row;
+    const RowType      *row;
     UChar32             c;
     LookAheadResults    lookAheadMatches;
     int32_t             result          = 0;
     int32_t             initialPosition = 0;
+    const UTrie2       *trie            = fData != NULL ? fData->fTrie : NULL;
 
     #ifdef RBBI_DEBUG
         if (fTrace) {
@@ -1254,7 +1555,7 @@ int32_t RuleBasedBreakIterator::handlePrevious(const RBBIStateTable *statetable)
 
     //  Set the initial state for the state machine
     state = START_STATE;
-    row = (RBBIStateTableRow *)
+    row = (const RowType *)
             (statetable->fTableData + (statetable->fRowLen * state));
     category = 3;
     mode     = RBBI_RUN;
@@ -1294,10 +1595,10 @@ int32_t RuleBasedBreakIterator::handlePrevious(const RBBIStateTable *statetable)
         if (mode == RBBI_RUN) {
             // look up the current character's character category, which tells us
             // which column in the state table to look at.
-            // Note:  the 16 in UTRIE_GET16 refers to the size of the data being returned,
+            // Note:  the 16 in UTRIE2_GET16 refers to the size of the data being returned,
             //        not the size of the character going in, which is a UChar32.
             //
-            UTRIE_GET16(&fData->fTrie, c, category);
+            category = UTRIE2_GET16(trie, c);
 
             // Check the dictionary bit in the character's category.
             //    Counter is only used by dictionary based iterators (subclasses).
@@ -1331,16 +1632,14 @@ int32_t RuleBasedBreakIterator::handlePrevious(const RBBIStateTable *statetable)
         // actually have more than 2 categories.
         U_ASSERT(category<fData->fHeader->fCatCount);
         state = row->fNextState[category];  /*Not accessing beyond memory*/
-        row = (RBBIStateTableRow *)
+        row = (const RowType *)
             (statetable->fTableData + (statetable->fRowLen * state));
 
-        if (row->fAccepting == -1) {
+        int16_t completedRule = row->fAccepting;
+        if (completedRule == RowType::kAcceptingUnconditional) {
             // Match found, common case.
             result = (int32_t)UTEXT_GETNATIVEINDEX(fText);
-        }
-
-        int16_t completedRule = row->fAccepting;
-        if (completedRule > 0) {
+        } else if (completedRule > 0) {
             // Lookahead match is completed.  
             int32_t lookaheadResult = lookAheadMatches.getPosition(completedRule);
             if (lookaheadResult >= 0) {
@@ -1414,39 +1713,44 @@ RuleBasedBreakIterator::reset()
 //-------------------------------------------------------------------------------
 //
 //   getRuleStatus()   Return the break rule tag associated with the current
-//                     iterator position.  If the iterator arrived at its current
-//                     position by iterating forwards, the value will have been
-//                     cached by the handleNext() function.
+//                     iterator position.  If the boundary was found by iterating
+//                     forwards, the value will have been saved in the boundary
+//                     cache along with it.
 //
-//                     If no cached status value is available, the status is
-//                     found by doing a previous() followed by a next(), which
-//                     leaves the iterator where it started, and computes the
-//                     status while doing the next().
+//                     If no saved status value is available, the status is
+//                     found by running the state machine forwards from the
+//                     preceding boundary, which computes the status while doing
+//                     the next().
 //
 //-------------------------------------------------------------------------------
 void RuleBasedBreakIterator::makeRuleStatusValid() {
-    if (fLastStatusIndexValid == FALSE) {
-        //  No cached status is available.
-        if (fText == NULL || current() == 0) {
-            //  At start of text, or there is no text.  Status is always zero.
-            fLastRuleStatusIndex = 0;
-            fLastStatusIndexValid = TRUE;
-        } else {
-            //  Not at start of text.  Find status the tedious way.
-            int32_t pa = current();
-            previous();
-            if (fNumCachedBreakPositions > 0) {
-                reset();                // Blow off the dictionary cache
-            }
-            int32_t pb = next();
-            if (pa != pb) {
-                // note: the if (pa != pb) test is here only to eliminate warnings for
-                //       unused local variables on gcc.  Logically, it isn't needed.
-                U_ASSERT(pa == pb);
-            }
-        }
+    if (fStatuses[fBufIdx] >= 0) {
+        return;
+    }
+    int32_t pos = fBoundaries[fBufIdx];
+    if (fText == NULL || pos == 0) {
+        //  At start of text, or there is no text.  Status is always zero.
+        fStatuses[fBufIdx] = 0;
+        return;
     }
-    U_ASSERT(fLastRuleStatusIndex >= 0  &&  fLastRuleStatusIndex < fData->fStatusMaxIdx);
+
+    //  Not at start of text.  Find status the tedious way.
+    if (fBufIdx == fStartBufIdx && !addPreceding()) {
+        fStatuses[fBufIdx] = 0;
+        return;
+    }
+    int32_t prev = fBoundaries[(fBufIdx - 1) & (kBoundaryCacheSize - 1)];
+    reset();                // Blow off the dictionary cache
+    utext_setNativeIndex(fText, prev);
+    int32_t pb = engineNext();
+    if (pos != pb) {
+        // note: the if (pos != pb) test is here only to eliminate warnings for
+        //       unused local variables on gcc.  Logically, it isn't needed.
+        U_ASSERT(pos == pb);
+    }
+    fStatuses[fBufIdx] = fLastStatusIndexValid ? fLastRuleStatusIndex : 0;
+    utext_setNativeIndex(fText, pos);
+    U_ASSERT(fStatuses[fBufIdx] >= 0  &&  fStatuses[fBufIdx] < fData->fStatusMaxIdx);
 }
 
 
@@ -1454,10 +1758,11 @@ int32_t  RuleBasedBreakIterator::getRuleStatus() const {
     RuleBasedBreakIterator *nonConstThis  = (RuleBasedBreakIterator *)this;
     nonConstThis->makeRuleStatusValid();
 
-    // fLastRuleStatusIndex indexes to the start of the appropriate status record
+    // The status index refers to the start of the appropriate status record
     //                                                 (the number of status values.)
     //   This function returns the last (largest) of the array of status values.
-    int32_t  idx = fLastRuleStatusIndex + fData->fRuleStatusTable[fLastRuleStatusIndex];
+    int32_t  statusIndex = fStatuses[fBufIdx];
+    int32_t  idx = statusIndex + fData->fRuleStatusTable[statusIndex];
     int32_t  tagVal = fData->fRuleStatusTable[idx];
 
     return tagVal;
@@ -1475,7 +1780,8 @@ int32_t RuleBasedBreakIterator::getRuleStatusVec(
 
     RuleBasedBreakIterator *nonConstThis  = (RuleBasedBreakIterator *)this;
     nonConstThis->makeRuleStatusValid();
-    int32_t  numVals = fData->fRuleStatusTable[fLastRuleStatusIndex];
+    int32_t  statusIndex = fStatuses[fBufIdx];
+    int32_t  numVals = fData->fRuleStatusTable[statusIndex];
     int32_t  numValsToCopy = numVals;
     if (numVals > capacity) {
         status = U_BUFFER_OVERFLOW_ERROR;
@@ -1483,12 +1789,303 @@ int32_t RuleBasedBreakIterator::getRuleStatusVec(
     }
     int i;
     for (i=0; i<numValsToCopy; i++) {
-        fillInVec[i] = fData->fRuleStatusTable[fLastRuleStatusIndex + i + 1];
+        fillInVec[i] = fData->fRuleStatusTable[statusIndex + i + 1];
     }
     return numVals;
 }
 
 
+//-------------------------------------------------------------------------------
+//
+//   getBoundaries()     Bulk next().  Steps through the boundary cache, extending
+//                       it with the state machine as needed, and copies out the
+//                       positions and (largest) status values.
+//
+//-------------------------------------------------------------------------------
+int32_t RuleBasedBreakIterator::getBoundaries(int32_t *offsets, int32_t *statuses, int32_t capacity,
+                                              UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    if (capacity < 0 || (capacity > 0 && offsets == NULL)) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    if (fText == NULL) {
+        return 0;
+    }
+
+    int32_t count = 0;
+    while (count < capacity) {
+        if (fBufIdx == fEndBufIdx && !addFollowing()) {
+            break;
+        }
+        fBufIdx = (fBufIdx + 1) & (kBoundaryCacheSize - 1);
+        offsets[count] = fBoundaries[fBufIdx];
+        if (statuses != NULL) {
+            if (fStatuses[fBufIdx] < 0) {
+                makeRuleStatusValid();
+            }
+            int32_t statusIndex = fStatuses[fBufIdx];
+            statuses[count] = fData->fRuleStatusTable[statusIndex + fData->fRuleStatusTable[statusIndex]];
+        }
+        ++count;
+    }
+    utext_setNativeIndex(fText, fBoundaries[fBufIdx]);
+    return count;
+}
+
+
+//-------------------------------------------------------------------------------
+//
+//   Multi-threaded getBoundaries()
+//
+//       The text following the current position is divided into chunks.  This
+//       iterator continues through the first chunk on the calling thread, while
+//       clones of it segment the other chunks, each starting from a position
+//       found with the safe reverse rules, if there are any, or else from the
+//       start of the chunk.
+//
+//       The chunks are then joined in order: from the end of each chunk, this
+//       iterator continues sequentially until it reaches a rule boundary that
+//       the next chunk also reached as a rule boundary.  A rule boundary is one
+//       that the state machine found itself, not one that came from a dictionary
+//       break engine; the boundaries following it depend only on its position,
+//       so from there on the chunk's boundaries are those of the sequential
+//       iteration and can be copied.  Usually this takes one or two steps.
+//
+//-------------------------------------------------------------------------------
+
+namespace {
+
+/** Below this many code units per chunk, a thread costs more than it saves. */
+const int32_t MIN_CHUNK_LENGTH = 0x8000;
+
+/** One chunk of the text, and its boundaries as found by a clone of the iterator. */
+struct BoundaryChunk {
+    RuleBasedBreakIterator *bi;  // owned
+    int32_t start, limit;        // native indexes
+    UVector32 *boundaries;       // pairs of (offset, statusIndex<<1 | isRuleBoundary)
+    UErrorCode errorCode;
+};
+
+struct BoundaryChunksContext {
+    RuleBasedBreakIterator *bi;  // the iterator itself, for the first chunk
+    BoundaryChunk *chunks;
+    int32_t *offsets;
+    int32_t *statuses;
+    int32_t capacity;
+    int32_t count;               // output of the first chunk
+    UBool atRuleBoundary;        // output of the first chunk
+};
+
+/**
+ * Binary search in a chunk's boundaries.
+ * @return the index of the pair for the rule boundary at pos, or -1 if there is none
+ */
+int32_t findRuleBoundary(const UVector32 &boundaries, int32_t pos) {
+    int32_t lo = 0;
+    int32_t hi = boundaries.size() / 2;
+    while (lo < hi) {
+        int32_t mid = (lo + hi) / 2;
+        int32_t offset = boundaries.elementAti(2 * mid);
+        if (offset < pos) {
+            lo = mid + 1;
+        } else if (offset > pos) {
+            hi = mid;
+        } else {
+            return (boundaries.elementAti(2 * mid + 1) & 1) != 0 ? 2 * mid : -1;
+        }
+    }
+    return -1;
+}
+
+}  // namespace
+
+int32_t RuleBasedBreakIterator::getBoundaries(int32_t *offsets, int32_t *statuses, int32_t capacity,
+                                              int32_t threadCount, UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    if (capacity < 0 || (capacity > 0 && offsets == NULL)) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    if (fText == NULL || fData == NULL) {
+        return getBoundaries(offsets, statuses, capacity, status);
+    }
+
+    // Each boundary takes at least one code unit, so at most capacity of them
+    // fit into the text up to windowLimit.  Only that much is worth dividing up.
+    int32_t start = fBoundaries[fBufIdx];
+    int32_t windowLimit = (int32_t)utext_nativeLength(fText);
+    if (windowLimit - start > capacity) {
+        windowLimit = start + capacity;
+    }
+    int32_t chunkCount = (windowLimit - start) / MIN_CHUNK_LENGTH;
+    if (chunkCount > threadCount) {
+        chunkCount = threadCount;
+    }
+    MaybeStackArray<BoundaryChunk, 8> chunks;
+    if (chunkCount <= 1 ||
+            (chunkCount > chunks.getCapacity() && chunks.resize(chunkCount) == NULL)) {
+        return getBoundaries(offsets, statuses, capacity, status);
+    }
+    for (int32_t i = 0; i < chunkCount; ++i) {
+        BoundaryChunk &chunk = chunks[i];
+        chunk.start = start + (int32_t)(((int64_t)(windowLimit - start) * i) / chunkCount);
+        chunk.limit = start + (int32_t)(((int64_t)(windowLimit - start) * (i + 1)) / chunkCount);
+        chunk.errorCode = U_ZERO_ERROR;
+        chunk.bi = NULL;
+        chunk.boundaries = NULL;
+        if (i > 0) {
+            chunk.bi = new RuleBasedBreakIterator(*this);
+            chunk.boundaries = new UVector32(chunk.errorCode);
+            if (chunk.bi == NULL || chunk.boundaries == NULL) {
+                chunk.errorCode = U_MEMORY_ALLOCATION_ERROR;
+            }
+        }
+    }
+
+    BoundaryChunksContext context = {
+        this, chunks.getAlias(), offsets, statuses, capacity, 0, FALSE
+    };
+    uprv_runWorkers(chunkCount, chunkBoundariesWorker, &context);
+
+    int32_t count = context.count;
+    UBool atRuleBoundary = context.atRuleBoundary;
+    for (int32_t i = 1; i < chunkCount; ++i) {
+        BoundaryChunk &chunk = chunks[i];
+        int32_t syncIdx;
+        if (count < capacity && U_SUCCESS(chunk.errorCode) && chunk.boundaries->size() > 0) {
+            const UVector32 &boundaries = *chunk.boundaries;
+            count = appendBoundaries(offsets, statuses, count, capacity,
+                                     boundaries.elementAti(0), &boundaries, atRuleBoundary);
+            if (count < capacity && atRuleBoundary &&
+                    (syncIdx = findRuleBoundary(boundaries, fBoundaries[fBufIdx])) >= 0) {
+                // Copy the rest of the chunk, then move this iterator to the last
+                // boundary copied, starting from the last rule boundary before it.
+                int32_t size = boundaries.size();
+                int32_t lastIdx = syncIdx;
+                int32_t lastRuleIdx = syncIdx;
+                for (int32_t j = syncIdx + 2; j < size && count < capacity; j += 2) {
+                    int32_t value = boundaries.elementAti(j + 1);
+                    offsets[count] = boundaries.elementAti(j);
+                    if (statuses != NULL) {
+                        int32_t statusIndex = value >> 1;
+                        statuses[count] = fData->fRuleStatusTable[statusIndex + fData->fRuleStatusTable[statusIndex]];
+                    }
+                    ++count;
+                    lastIdx = j;
+                    if ((value & 1) != 0) {
+                        lastRuleIdx = j;
+                    }
+                }
+                reset();
+                seedCache(boundaries.elementAti(lastRuleIdx), boundaries.elementAti(lastRuleIdx + 1) >> 1);
+                int32_t last = boundaries.elementAti(lastIdx);
+                while (fBoundaries[fEndBufIdx] < last && addFollowing()) {
+                }
+                fBufIdx = fEndBufIdx;
+                atRuleBoundary = isRuleBoundary();
+            }
+        }
+        delete chunk.bi;
+        delete chunk.boundaries;
+    }
+
+    // Whatever follows the window, up to capacity.
+    count = appendBoundaries(offsets, statuses, count, capacity, INT32_MAX, NULL, atRuleBoundary);
+    utext_setNativeIndex(fText, fBoundaries[fBufIdx]);
+    return count;
+}
+
+
+void U_CALLCONV
+RuleBasedBreakIterator::chunkBoundariesWorker(void *context, int32_t workerIndex) {
+    BoundaryChunksContext &c = *static_cast<BoundaryChunksContext *>(context);
+    if (workerIndex == 0) {
+        c.count = c.bi->appendBoundaries(c.offsets, c.statuses, 0, c.capacity,
+                                         c.chunks[1].start, NULL, c.atRuleBoundary);
+    } else {
+        BoundaryChunk &chunk = c.chunks[workerIndex];
+        if (U_SUCCESS(chunk.errorCode)) {
+            chunk.bi->findChunkBoundaries(chunk.start, chunk.limit, *chunk.boundaries, chunk.errorCode);
+        }
+    }
+}
+
+
+UBool RuleBasedBreakIterator::isRuleBoundary() const {
+    return fCachedBreakPositions == NULL || fPositionInCache == fNumCachedBreakPositions - 1;
+}
+
+
+int32_t RuleBasedBreakIterator::appendBoundaries(int32_t *offsets, int32_t *statuses, int32_t count,
+                                                 int32_t capacity, int32_t limit, const UVector32 *sync,
+                                                 UBool &atRuleBoundary) {
+    int32_t syncLast = sync != NULL ? sync->elementAti(sync->size() - 2) : INT32_MAX;
+    while (count < capacity) {
+        int32_t pos = fBoundaries[fBufIdx];
+        if (pos >= syncLast ||
+                (atRuleBoundary && pos >= limit && (sync == NULL || findRuleBoundary(*sync, pos) >= 0))) {
+            break;
+        }
+        if (fBufIdx == fEndBufIdx) {
+            if (!addFollowing()) {
+                break;
+            }
+            atRuleBoundary = isRuleBoundary();
+        } else {
+            // Already cached; how the state machine reached it is not known.
+            atRuleBoundary = FALSE;
+        }
+        fBufIdx = (fBufIdx + 1) & (kBoundaryCacheSize - 1);
+        offsets[count] = fBoundaries[fBufIdx];
+        if (statuses != NULL) {
+            if (fStatuses[fBufIdx] < 0) {
+                makeRuleStatusValid();
+            }
+            int32_t statusIndex = fStatuses[fBufIdx];
+            statuses[count] = fData->fRuleStatusTable[statusIndex + fData->fRuleStatusTable[statusIndex]];
+        }
+        ++count;
+    }
+    return count;
+}
+
+
+void RuleBasedBreakIterator::findChunkBoundaries(int32_t start, int32_t limit, UVector32 &boundaries,
+                                                 UErrorCode &status) {
+    if (fText == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    // Without safe reverse rules, start at the start of the chunk itself.
+    // Either way, the chunk's boundaries are only used from where they join up
+    // with those found sequentially.
+    reset();
+    utext_setNativeIndex(fText, start);
+    if (fData->fSafeRevTable != NULL) {
+        (void)UTEXT_NEXT32(fText);
+        handlePrevious(fData->fSafeRevTable);
+    }
+    for (;;) {
+        int32_t pos = engineNext();
+        if (pos == BreakIterator::DONE) {
+            break;
+        }
+        UBool isRule = isRuleBoundary();
+        int32_t statusIndex = fLastStatusIndexValid ? fLastRuleStatusIndex : 0;
+        boundaries.addElement(pos, status);
+        boundaries.addElement((statusIndex << 1) | isRule, status);
+        if (U_FAILURE(status) || (isRule && pos >= limit)) {
+            break;
+        }
+    }
+}
+
+
 
 //-------------------------------------------------------------------------------
 //
@@ -1547,7 +2144,7 @@ BreakIterator *  RuleBasedBreakIterator::createBufferClone(void * /*stackBuffer*
         return FALSE;
     }
     uint16_t category;
-    UTRIE_GET16(&fData->fTrie, c, category);
+    category = UTRIE2_GET16(fData->fTrie, c);
     return (category & 0x4000) != 0;
 }*/
 
@@ -1591,7 +2188,7 @@ int32_t RuleBasedBreakIterator::checkDictionary(int32_t startPos,
     int32_t     foundBreakCount = 0;
     UChar32     c = utext_current32(fText);
 
-    UTRIE_GET16(&fData->fTrie, c, category);
+    category = UTRIE2_GET16(fData->fTrie, c);
     
     // Is the character we're starting on a dictionary character? If so, we
     // need to back up to include the entire run; otherwise the results of
@@ -1603,7 +2200,7 @@ int32_t RuleBasedBreakIterator::checkDictionary(int32_t startPos,
             do {
                 utext_next32(fText);          // TODO:  recast to work directly with postincrement.
                 c = utext_current32(fText);
-                UTRIE_GET16(&fData->fTrie, c, category);
+                category = UTRIE2_GET16(fData->fTrie, c);
             } while (c != U_SENTINEL && (category & 0x4000));
             // Back up to the last dictionary character
             rangeEnd = (int32_t)UTEXT_GETNATIVEINDEX(fText);
@@ -1619,7 +2216,7 @@ int32_t RuleBasedBreakIterator::checkDictionary(int32_t startPos,
         else {
             do {
                 c = UTEXT_PREVIOUS32(fText);
-                UTRIE_GET16(&fData->fTrie, c, category);
+                category = UTRIE2_GET16(fData->fTrie, c);
             }
             while (c != U_SENTINEL && (category & 0x4000));
             // Back up to the last dictionary character
@@ -1633,7 +2230,7 @@ int32_t RuleBasedBreakIterator::checkDictionary(int32_t startPos,
             }
             rangeStart = (int32_t)UTEXT_GETNATIVEINDEX(fText);;
         }
-        UTRIE_GET16(&fData->fTrie, c, category);
+        category = UTRIE2_GET16(fData->fTrie, c);
     }
     
     // Loop through the text, looking for ranges of dictionary characters.
@@ -1644,13 +2241,13 @@ int32_t RuleBasedBreakIterator::checkDictionary(int32_t startPos,
     if (reverse) {
         utext_setNativeIndex(fText, rangeStart);
         c = utext_current32(fText);
-        UTRIE_GET16(&fData->fTrie, c, category);
+        category = UTRIE2_GET16(fData->fTrie, c);
     }
     while(U_SUCCESS(status)) {
         while((current = (int32_t)UTEXT_GETNATIVEINDEX(fText)) < rangeEnd && (category & 0x4000) == 0) {
             utext_next32(fText);           // TODO:  tweak for post-increment operation
             c = utext_current32(fText);
-            UTRIE_GET16(&fData->fTrie, c, category);
+            category = UTRIE2_GET16(fData->fTrie, c);
         }
         if (current >= rangeEnd) {
             break;
@@ -1668,7 +2265,7 @@ int32_t RuleBasedBreakIterator::checkDictionary(int32_t startPos,
         
         // Reload the loop variables for the next go-round
         c = utext_current32(fText);
-        UTRIE_GET16(&fData->fTrie, c, category);
+        category = UTRIE2_GET16(fData->fTrie, c);
     }
     
     // If we found breaks, build a new break cache. The first and last entries must
@@ -1699,10 +2296,10 @@ int32_t RuleBasedBreakIterator::checkDictionary(int32_t startPos,
             // proposed break by one of the breaks we found. Use following() and
             // preceding() to do the work. They should never recurse in this case.
             if (reverse) {
-                return preceding(endPos);
+                return enginePreceding(endPos);
             }
             else {
-                return following(startPos);
+                return engineFollowing(startPos);
             }
         }
         // If the allocation failed, just fall through to the "no breaks found" case.
@@ -1854,6 +2451,7 @@ RuleBasedBreakIterator::getLanguageBreakEngine(UChar32 c) {
 void RuleBasedBreakIterator::setBreakType(int32_t type) {
     fBreakType = type;
     reset();
+    seedCache(current(), -1);
 }
 
 U_NAMESPACE_END
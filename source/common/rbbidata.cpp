@@ -15,6 +15,7 @@
 #include "rbbidata.h"
 #include "rbbirb.h"
 #include "utrie.h"
+#include "utrie2.h"
 #include "udatamem.h"
 #include "cmemory.h"
 #include "cstring.h"
@@ -98,6 +99,7 @@ void RBBIDataWrapper::init0() {
     fSafeRevTable = NULL;
     fRuleSource = NULL;
     fRuleStatusTable = NULL;
+    fTrie = NULL;
     fUDataMem = NULL;
     fRefCount = 0;
     fDontFreeData = TRUE;
@@ -108,7 +110,8 @@ void RBBIDataWrapper::init(const RBBIDataHeader *data, UErrorCode &status) {
         return;
     }
     fHeader = data;
-    if (fHeader->fMagic != 0xb1a0 || fHeader->fFormatVersion[0] != 3) 
+    if (fHeader->fMagic != 0xb1a0 ||
+            (fHeader->fFormatVersion[0] != 3 && fHeader->fFormatVersion[0] != 4))
     {
         status = U_INVALID_FORMAT_ERROR;
         return;
@@ -116,6 +119,8 @@ void RBBIDataWrapper::init(const RBBIDataHeader *data, UErrorCode &status) {
     // Note: in ICU version 3.2 and earlier, there was a formatVersion 1
     //       that is no longer supported.  At that time fFormatVersion was
     //       an int32_t field, rather than an array of 4 bytes.
+    //       Format version 3 has a UTrie for the character categories, and
+    //       no tables with 8 bit rows; version 4 has a UTrie2.
 
     fDontFreeData = FALSE;
     if (data->fFTableLen != 0) {
@@ -132,14 +137,27 @@ void RBBIDataWrapper::init(const RBBIDataHeader *data, UErrorCode &status) {
     }
 
 
-    utrie_unserialize(&fTrie,
-                       (uint8_t *)data + fHeader->fTrie,
-                       fHeader->fTrieLen,
-                       &status);
+    if (fHeader->fFormatVersion[0] == 3) {
+        UTrie trie1;
+        utrie_unserialize(&trie1,
+                           (uint8_t *)data + fHeader->fTrie,
+                           fHeader->fTrieLen,
+                           &status);
+        if (U_FAILURE(status)) {
+            return;
+        }
+        trie1.getFoldingOffset=getFoldingOffset;
+        fTrie = utrie2_fromUTrie(&trie1, 0, &status);
+    } else {
+        fTrie = utrie2_openFromSerialized(UTRIE2_16_VALUE_BITS,
+                                          (uint8_t *)data + fHeader->fTrie,
+                                          fHeader->fTrieLen,
+                                          NULL,
+                                          &status);
+    }
     if (U_FAILURE(status)) {
         return;
     }
-    fTrie.getFoldingOffset=getFoldingOffset;
 
 
     fRuleSource   = (UChar *)((char *)data + fHeader->fRuleSource);
@@ -165,6 +183,7 @@ void RBBIDataWrapper::init(const RBBIDataHeader *data, UErrorCode &status) {
 //-----------------------------------------------------------------------------
 RBBIDataWrapper::~RBBIDataWrapper() {
     U_ASSERT(fRefCount == 0);
+    utrie2_close(fTrie);
     if (fUDataMem) {
         udata_close(fUDataMem);
     } else if (!fDontFreeData) {
@@ -258,11 +277,22 @@ void  RBBIDataWrapper::printTable(const char *heading, const RBBIStateTable *tab
         return;
     }
     for (s=0; s<table->fNumStates; s++) {
-        RBBIStateTableRow *row = (RBBIStateTableRow *)
-                                  (table->fTableData + (table->fRowLen * s));
-        RBBIDebugPrintf("%4d  |  %3d %3d %3d ", s, row->fAccepting, row->fLookAhead, row->fTagIdx);
-        for (c=0; c<fHeader->fCatCount; c++)  {
-            RBBIDebugPrintf("%3d ", row->fNextState[c]);
+        if (table->fFlags & RBBI_8BITS_ROWS) {
+            RBBIStateTableRow8 *row = (RBBIStateTableRow8 *)
+                                      (table->fTableData + (table->fRowLen * s));
+            RBBIDebugPrintf("%4d  |  %3d %3d %3d ", s,
+                            row->fAccepting == RBBIStateTableRow8::kAcceptingUnconditional ? -1 : row->fAccepting,
+                            row->fLookAhead, row->fTagIdx);
+            for (c=0; c<fHeader->fCatCount; c++)  {
+                RBBIDebugPrintf("%3d ", row->fNextState[c]);
+            }
+        } else {
+            RBBIStateTableRow *row = (RBBIStateTableRow *)
+                                      (table->fTableData + (table->fRowLen * s));
+            RBBIDebugPrintf("%4d  |  %3d %3d %3d ", s, row->fAccepting, row->fLookAhead, row->fTagIdx);
+            for (c=0; c<fHeader->fCatCount; c++)  {
+                RBBIDebugPrintf("%3d ", row->fNextState[c]);
+            }
         }
         RBBIDebugPrintf("\n");
     }
@@ -296,6 +326,36 @@ void  RBBIDataWrapper::printData() {
 U_NAMESPACE_END
 U_NAMESPACE_USE
 
+//-----------------------------------------------------------------------------
+//
+//  swapStateTable   -  byte swap one state table.  Each begins with several
+//                      32 bit fields, followed by rows of 16 bit values, or of
+//                      bytes, which need no swapping, if it has 8 bit rows.
+//
+//-----------------------------------------------------------------------------
+static void
+swapStateTable(const UDataSwapper *ds, const uint8_t *inBytes, uint8_t *outBytes,
+               int32_t tableStartOffset, int32_t tableLength, UErrorCode *status) {
+    if (tableLength <= 0) {
+        return;
+    }
+    const RBBIStateTable *inTable = (const RBBIStateTable *)(inBytes+tableStartOffset);
+    uint32_t flags   = ds->readUInt32(inTable->fFlags);     // Before an in-place swap.
+    int32_t  topSize = offsetof(RBBIStateTable, fTableData);
+    ds->swapArray32(ds, inBytes+tableStartOffset, topSize,
+                        outBytes+tableStartOffset, status);
+    if (flags & RBBI_8BITS_ROWS) {
+        if (inBytes != outBytes) {
+            uprv_memcpy(outBytes+tableStartOffset+topSize, inBytes+tableStartOffset+topSize,
+                        tableLength-topSize);
+        }
+    } else {
+        ds->swapArray16(ds, inBytes+tableStartOffset+topSize, tableLength-topSize,
+                            outBytes+tableStartOffset+topSize, status);
+    }
+}
+
+
 //-----------------------------------------------------------------------------
 //
 //  ubrk_swap   -  byte swap and char encoding swap of RBBI data
@@ -323,7 +383,7 @@ ubrk_swap(const UDataSwapper *ds, const void *inData, int32_t length, void *outD
            pInfo->dataFormat[1]==0x72 &&
            pInfo->dataFormat[2]==0x6b &&
            pInfo->dataFormat[3]==0x20 &&
-           pInfo->formatVersion[0]==3  )) {
+           (pInfo->formatVersion[0]==3 || pInfo->formatVersion[0]==4)  )) {
         udata_printError(ds, "ubrk_swap(): data format %02x.%02x.%02x.%02x (format version %02x) is not recognized\n",
                          pInfo->dataFormat[0], pInfo->dataFormat[1],
                          pInfo->dataFormat[2], pInfo->dataFormat[3],
@@ -347,12 +407,13 @@ ubrk_swap(const UDataSwapper *ds, const void *inData, int32_t length, void *outD
     //    Note:  ICU 3.2 and earlier, RBBIDataHeader::fDataFormat was actually 
     //           an int32_t with a value of 1.  Starting with ICU 3.4,
     //           RBBI's fDataFormat matches the dataFormat field from the
-    //           UDataInfo header, four int8_t bytes.  The value is {3,1,0,0}
+    //           UDataInfo header, four int8_t bytes.  The value is {3,1,0,0},
+    //           or {4,0,0,0} for data with a UTrie2 and possibly 8 bit table rows.
     //
     const uint8_t  *inBytes =(const uint8_t *)inData+headerSize;
     RBBIDataHeader *rbbiDH = (RBBIDataHeader *)inBytes;
     if (ds->readUInt32(rbbiDH->fMagic) != 0xb1a0 || 
-        rbbiDH->fFormatVersion[0] != 3 ||
+        rbbiDH->fFormatVersion[0] != pInfo->formatVersion[0] ||
         ds->readUInt32(rbbiDH->fLength)  <  sizeof(RBBIDataHeader)) 
     {
         udata_printError(ds, "ubrk_swap(): RBBI Data header is invalid.\n");
@@ -388,9 +449,6 @@ ubrk_swap(const UDataSwapper *ds, const void *inData, int32_t length, void *outD
     uint8_t         *outBytes = (uint8_t *)outData + headerSize;
     RBBIDataHeader  *outputDH = (RBBIDataHeader *)outBytes;
 
-    int32_t   tableStartOffset;
-    int32_t   tableLength;
-
     //
     // If not swapping in place, zero out the output buffer before starting.
     //    Individual tables and other data items within are aligned to 8 byte boundaries
@@ -400,59 +458,24 @@ ubrk_swap(const UDataSwapper *ds, const void *inData, int32_t length, void *outD
         uprv_memset(outBytes, 0, breakDataLength);
     }
 
-    //
-    // Each state table begins with several 32 bit fields.  Calculate the size
-    //   in bytes of these.
-    //
-    int32_t         topSize = offsetof(RBBIStateTable, fTableData);
-
-    // Forward state table.  
-    tableStartOffset = ds->readUInt32(rbbiDH->fFTable);
-    tableLength      = ds->readUInt32(rbbiDH->fFTableLen);
-
-    if (tableLength > 0) {
-        ds->swapArray32(ds, inBytes+tableStartOffset, topSize, 
-                            outBytes+tableStartOffset, status);
-        ds->swapArray16(ds, inBytes+tableStartOffset+topSize, tableLength-topSize,
-                            outBytes+tableStartOffset+topSize, status);
-    }
-    
-    // Reverse state table.  Same layout as forward table, above.
-    tableStartOffset = ds->readUInt32(rbbiDH->fRTable);
-    tableLength      = ds->readUInt32(rbbiDH->fRTableLen);
-
-    if (tableLength > 0) {
-        ds->swapArray32(ds, inBytes+tableStartOffset, topSize, 
-                            outBytes+tableStartOffset, status);
-        ds->swapArray16(ds, inBytes+tableStartOffset+topSize, tableLength-topSize,
-                            outBytes+tableStartOffset+topSize, status);
-    }
-
-    // Safe Forward state table.  Same layout as forward table, above.
-    tableStartOffset = ds->readUInt32(rbbiDH->fSFTable);
-    tableLength      = ds->readUInt32(rbbiDH->fSFTableLen);
-
-    if (tableLength > 0) {
-        ds->swapArray32(ds, inBytes+tableStartOffset, topSize, 
-                            outBytes+tableStartOffset, status);
-        ds->swapArray16(ds, inBytes+tableStartOffset+topSize, tableLength-topSize,
-                            outBytes+tableStartOffset+topSize, status);
-    }
-
-    // Safe Reverse state table.  Same layout as forward table, above.
-    tableStartOffset = ds->readUInt32(rbbiDH->fSRTable);
-    tableLength      = ds->readUInt32(rbbiDH->fSRTableLen);
-
-    if (tableLength > 0) {
-        ds->swapArray32(ds, inBytes+tableStartOffset, topSize, 
-                            outBytes+tableStartOffset, status);
-        ds->swapArray16(ds, inBytes+tableStartOffset+topSize, tableLength-topSize,
-                            outBytes+tableStartOffset+topSize, status);
-    }
+    // Forward, reverse, safe forward and safe reverse state tables.
+    swapStateTable(ds, inBytes, outBytes, ds->readUInt32(rbbiDH->fFTable),
+                   ds->readUInt32(rbbiDH->fFTableLen), status);
+    swapStateTable(ds, inBytes, outBytes, ds->readUInt32(rbbiDH->fRTable),
+                   ds->readUInt32(rbbiDH->fRTableLen), status);
+    swapStateTable(ds, inBytes, outBytes, ds->readUInt32(rbbiDH->fSFTable),
+                   ds->readUInt32(rbbiDH->fSFTableLen), status);
+    swapStateTable(ds, inBytes, outBytes, ds->readUInt32(rbbiDH->fSRTable),
+                   ds->readUInt32(rbbiDH->fSRTableLen), status);
 
     // Trie table for character categories
-    utrie_swap(ds, inBytes+ds->readUInt32(rbbiDH->fTrie), ds->readUInt32(rbbiDH->fTrieLen),
-                            outBytes+ds->readUInt32(rbbiDH->fTrie), status);
+    if (rbbiDH->fFormatVersion[0] == 3) {
+        utrie_swap(ds, inBytes+ds->readUInt32(rbbiDH->fTrie), ds->readUInt32(rbbiDH->fTrieLen),
+                                outBytes+ds->readUInt32(rbbiDH->fTrie), status);
+    } else {
+        utrie2_swap(ds, inBytes+ds->readUInt32(rbbiDH->fTrie), ds->readUInt32(rbbiDH->fTrieLen),
+                                outBytes+ds->readUInt32(rbbiDH->fTrie), status);
+    }
 
     // Source Rules Text.  It's UChar data
     ds->swapArray16(ds, inBytes+ds->readUInt32(rbbiDH->fRuleSource), ds->readUInt32(rbbiDH->fRuleSourceLen),
@@ -53,6 +53,7 @@ ubrk_swap(const UDataSwapper *ds,
 #include "unicode/unistr.h"
 #include "umutex.h"
 #include "utrie.h"
+#include "utrie2.h"
 
 U_NAMESPACE_BEGIN
 
@@ -85,6 +86,7 @@ struct RBBIDataHeader {
     uint32_t         fSRTable;        /*  safe point reverse transition table */
     uint32_t         fSRTableLen;
     uint32_t         fTrie;           /*  Offset to Trie data for character categories */
+                                      /*    Format version 3: a UTrie; 4: a UTrie2.        */
     uint32_t         fTrieLen;
     uint32_t         fRuleSource;     /*  Offset to the source for for the break */
     uint32_t         fRuleSourceLen;  /*    rules.  Stored UChar *. */
@@ -120,6 +122,23 @@ struct  RBBIStateTableRow {
                                     /*    Array Size is actually fData->fHeader->fCatCount         */
                                     /*    CAUTION:  see RBBITableBuilder::getTableSize()  */
                                     /*              before changing anything here.        */
+
+    enum { kAcceptingUnconditional = -1 };
+};
+
+
+/*
+ *   Row of a state table with the RBBI_8BITS_ROWS flag, used by format version 4
+ *   when every value fits in a byte.  The fields are the same as RBBIStateTableRow,
+ *   except that an unconditional accepting state has 0xff in fAccepting.
+ */
+struct  RBBIStateTableRow8 {
+    uint8_t          fAccepting;
+    uint8_t          fLookAhead;
+    uint8_t          fTagIdx;
+    uint8_t          fNextState[1]; /*  Array Size is actually fData->fHeader->fCatCount  */
+
+    enum { kAcceptingUnconditional = 0xff };
 };
 
 
@@ -135,7 +154,8 @@ struct RBBIStateTable {
 
 typedef enum {
     RBBI_LOOKAHEAD_HARD_BREAK = 1,
-    RBBI_BOF_REQUIRED = 2
+    RBBI_BOF_REQUIRED = 2,
+    RBBI_8BITS_ROWS = 4         /* Rows are RBBIStateTableRow8.  Format version 4 only. */
 } RBBIStateTableFlags;
 
 
@@ -181,7 +201,8 @@ public:
     /* number of int32_t values in the rule status table.   Used to sanity check indexing */
     int32_t             fStatusMaxIdx;
 
-    UTrie               fTrie;
+    UTrie2             *fTrie;           /* Character categories.  Converted from a  */
+                                        /*   UTrie for format version 3 data.        */
 
 private:
     u_atomic_int32_t    fRefCount;
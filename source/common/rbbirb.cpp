@@ -131,6 +131,39 @@ RBBIRuleBuilder::~RBBIRuleBuilder() {
 
 
 
+//----------------------------------------------------------------------------------------
+//
+//   optimizeTables() -  Merge character categories whose columns are identical in
+//                       all of the state tables, so that the rows of the tables are
+//                       shorter.  Categories 0-2 are reserved, and categories of
+//                       dictionary characters are only merged with each other.
+//
+//----------------------------------------------------------------------------------------
+void RBBIRuleBuilder::optimizeTables() {
+    if (U_FAILURE(*fStatus)) {
+        return;
+    }
+    for (int32_t left = 3; left < fSetBuilder->getNumCharCategories(); left++) {
+        UBool leftDictionary = fSetBuilder->isDictionaryCategory(left);
+        for (int32_t right = left + 1; right < fSetBuilder->getNumCharCategories(); ) {
+            if (fSetBuilder->isDictionaryCategory(right) == leftDictionary &&
+                    fForwardTables->columnsEqual(left, right) &&
+                    fReverseTables->columnsEqual(left, right) &&
+                    fSafeFwdTables->columnsEqual(left, right) &&
+                    fSafeRevTables->columnsEqual(left, right)) {
+                fForwardTables->removeColumn(right);
+                fReverseTables->removeColumn(right);
+                fSafeFwdTables->removeColumn(right);
+                fSafeRevTables->removeColumn(right);
+                fSetBuilder->mergeCategories(left, right);
+            } else {
+                right++;
+            }
+        }
+    }
+}
+
+
 //----------------------------------------------------------------------------------------
 //
 //   flattenData() -  Collect up the compiled RBBI rule data and put it into
@@ -177,8 +210,8 @@ RBBIDataHeader *RBBIRuleBuilder::flattenData() {
 
 
     data->fMagic            = 0xb1a0;
-    data->fFormatVersion[0] = 3;
-    data->fFormatVersion[1] = 1;
+    data->fFormatVersion[0] = 4;
+    data->fFormatVersion[1] = 0;
     data->fFormatVersion[2] = 0;
     data->fFormatVersion[3] = 0;
     data->fLength           = totalSize;
@@ -249,8 +282,6 @@ RBBIRuleBuilder::createRuleBasedBreakIterator( const UnicodeString    &rules,
     //
     // UnicodeSet processing.
     //    Munge the Unicode Sets to create a set of character categories.
-    //    Generate the mapping tables (TRIE) from input 32-bit characters to
-    //    the character categories.
     //
     builder.fSetBuilder->build();
 
@@ -284,6 +315,14 @@ RBBIRuleBuilder::createRuleBasedBreakIterator( const UnicodeString    &rules,
     }
 #endif
 
+    //
+    //   Merge the character categories that the tables do not distinguish,
+    //   then generate the mapping table (TRIE) from input 32-bit characters
+    //   to the character categories.
+    //
+    builder.optimizeTables();
+    builder.fSetBuilder->buildTrie();
+
     //
     //   Package up the compiled data into a memory image
     //      in the run-time format.
@@ -158,6 +158,8 @@ public:
     UVector                       *fRuleStatusVals;  // The values that can be returned
                                                      //   from getRuleStatus().
 
+    void                          optimizeTables();  // Merge character categories that all
+                                                     //   of the state tables treat alike.
     RBBIDataHeader                *flattenData();    // Create the flattened (runtime format)
                                                      // data tables..
 private:
@@ -15,10 +15,9 @@
 #include "unicode/utypes.h"
 #include "unicode/uobject.h"
 #include "rbbirb.h"
+#include "utrie2.h"
 #include "uvector.h"
 
-struct  UNewTrie;
-
 U_NAMESPACE_BEGIN
 
 //
@@ -81,6 +80,9 @@ public:
     ~RBBISetBuilder();
 
     void     build();
+    void     buildTrie();                    // Build the trie from the (possibly merged) categories.
+    void     mergeCategories(int32_t left, int32_t right);  // Merge category right into left.
+    UBool    isDictionaryCategory(int32_t category) const;
     void     addValToSets(UVector *sets,      uint32_t val);
     void     addValToSet (RBBINode *usetNode, uint32_t val);
     int32_t  getNumCharCategories() const;   // CharCategories are the same as input symbol set to the
@@ -109,7 +111,7 @@ private:
 
     RangeDescriptor       *fRangeList;      // Head of the linked list of RangeDescriptors
 
-    UNewTrie              *fTrie;           // The mapping TRIE that is the end result of processing
+    UTrie2                *fTrie;           // The mapping TRIE that is the end result of processing
     uint32_t              fTrieSize;        //  the Unicode Sets.
 
     // Groups correspond to character categories -
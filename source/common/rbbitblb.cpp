@@ -1079,6 +1079,67 @@ void RBBITableBuilder::printPosSets(RBBINode *n) {
 
 
 
+//-----------------------------------------------------------------------------
+//
+//   columnsEqual()    Check whether two input categories lead to the same
+//                     next state from every state, making them interchangeable
+//                     as far as this table is concerned.
+//
+//-----------------------------------------------------------------------------
+UBool RBBITableBuilder::columnsEqual(int32_t c1, int32_t c2) const {
+    if (fTree == NULL) {
+        return TRUE;
+    }
+    for (int32_t state=0; state<fDStates->size(); state++) {
+        const RBBIStateDescriptor *sd = (const RBBIStateDescriptor *)fDStates->elementAt(state);
+        if (sd->fDtran->elementAti(c1) != sd->fDtran->elementAti(c2)) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+
+//-----------------------------------------------------------------------------
+//
+//   removeColumn()    Remove an input category, after it has been merged
+//                     into another with the same transitions.
+//
+//-----------------------------------------------------------------------------
+void RBBITableBuilder::removeColumn(int32_t column) {
+    if (fTree == NULL) {
+        return;
+    }
+    for (int32_t state=0; state<fDStates->size(); state++) {
+        RBBIStateDescriptor *sd = (RBBIStateDescriptor *)fDStates->elementAt(state);
+        sd->fDtran->removeElementAt(column);
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+//
+//   use8BitRows()     Check whether every state number and every row value
+//                     fits in a byte, allowing the compact table format
+//                     with RBBIStateTableRow8 rows.
+//
+//-----------------------------------------------------------------------------
+UBool RBBITableBuilder::use8BitRows() const {
+    if (fDStates->size() > 0x100) {
+        return FALSE;
+    }
+    for (int32_t state=0; state<fDStates->size(); state++) {
+        const RBBIStateDescriptor *sd = (const RBBIStateDescriptor *)fDStates->elementAt(state);
+        if (sd->fAccepting < -1 || sd->fAccepting >= RBBIStateTableRow8::kAcceptingUnconditional ||
+                sd->fLookAhead < 0 || sd->fLookAhead > 0xff ||
+                sd->fTagsIdx < 0 || sd->fTagsIdx > 0xff) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+
 //-----------------------------------------------------------------------------
 //
 //   getTableSize()    Calculate the size of the runtime form of this
@@ -1103,7 +1164,12 @@ int32_t  RBBITableBuilder::getTableSize() const {
     //  Note  The declaration of RBBIStateTableRow is for a table of two columns.
     //        Therefore we subtract two from numCols when determining
     //        how much storage to add to a row for the total columns.
-    rowSize = sizeof(RBBIStateTableRow) + sizeof(uint16_t)*(numCols-2);
+    //        RBBIStateTableRow8 is declared with one column, and no padding.
+    if (use8BitRows()) {
+        rowSize = offsetof(RBBIStateTableRow8, fNextState) + numCols;
+    } else {
+        rowSize = sizeof(RBBIStateTableRow) + sizeof(uint16_t)*(numCols-2);
+    }
     size   += numRows * rowSize;
     return size;
 }
@@ -1121,19 +1187,24 @@ void RBBITableBuilder::exportTable(void *where) {
     RBBIStateTable    *table = (RBBIStateTable *)where;
     uint32_t           state;
     int                col;
+    int32_t            numCols = fRB->fSetBuilder->getNumCharCategories();
 
     if (U_FAILURE(*fStatus) || fTree == NULL) {
         return;
     }
 
-    if (fRB->fSetBuilder->getNumCharCategories() > 0x7fff ||
+    if (numCols > 0x7fff ||
         fDStates->size() > 0x7fff) {
         *fStatus = U_BRK_INTERNAL_ERROR;
         return;
     }
 
-    table->fRowLen    = sizeof(RBBIStateTableRow) +
-                            sizeof(uint16_t) * (fRB->fSetBuilder->getNumCharCategories() - 2);
+    UBool rows8 = use8BitRows();
+    if (rows8) {
+        table->fRowLen = offsetof(RBBIStateTableRow8, fNextState) + numCols;
+    } else {
+        table->fRowLen = sizeof(RBBIStateTableRow) + sizeof(uint16_t) * (numCols - 2);
+    }
     table->fNumStates = fDStates->size();
     table->fFlags     = 0;
     if (fRB->fLookAheadHardBreak) {
@@ -1142,17 +1213,31 @@ void RBBITableBuilder::exportTable(void *where) {
     if (fRB->fSetBuilder->sawBOF()) {
         table->fFlags  |= RBBI_BOF_REQUIRED;
     }
+    if (rows8) {
+        table->fFlags  |= RBBI_8BITS_ROWS;
+    }
     table->fReserved  = 0;
 
     for (state=0; state<table->fNumStates; state++) {
         RBBIStateDescriptor *sd = (RBBIStateDescriptor *)fDStates->elementAt(state);
+        if (rows8) {
+            RBBIStateTableRow8 *row = (RBBIStateTableRow8 *)(table->fTableData + state*table->fRowLen);
+            row->fAccepting = sd->fAccepting == -1 ?
+                (uint8_t)RBBIStateTableRow8::kAcceptingUnconditional : (uint8_t)sd->fAccepting;
+            row->fLookAhead = (uint8_t)sd->fLookAhead;
+            row->fTagIdx    = (uint8_t)sd->fTagsIdx;
+            for (col=0; col<numCols; col++) {
+                row->fNextState[col] = (uint8_t)sd->fDtran->elementAti(col);
+            }
+            continue;
+        }
         RBBIStateTableRow   *row = (RBBIStateTableRow *)(table->fTableData + state*table->fRowLen);
         U_ASSERT (-32768 < sd->fAccepting && sd->fAccepting <= 32767);
         U_ASSERT (-32768 < sd->fLookAhead && sd->fLookAhead <= 32767);
         row->fAccepting = (int16_t)sd->fAccepting;
         row->fLookAhead = (int16_t)sd->fLookAhead;
         row->fTagIdx    = (int16_t)sd->fTagsIdx;
-        for (col=0; col<fRB->fSetBuilder->getNumCharCategories(); col++) {
+        for (col=0; col<numCols; col++) {
             row->fNextState[col] = (uint16_t)sd->fDtran->elementAti(col);
         }
     }
@@ -45,6 +45,10 @@ public:
     void     exportTable(void *where);  // fill in the runtime state table.
                                         //     Sufficient memory must exist at
                                         //     the specified location.
+    UBool    columnsEqual(int32_t c1, int32_t c2) const;  // TRUE if input categories c1 and
+                                        //     c2 have the same transitions in every state.
+    void     removeColumn(int32_t column);  // Remove the transitions for a category
+                                        //     merged into another.
 
 
 private:
@@ -59,6 +63,7 @@ private:
     void     flagLookAheadStates();
     void     flagTaggedStates();
     void     mergeRuleStatusVals();
+    UBool    use8BitRows() const;
 
     void     addRuleRootNodes(UVector *dest, RBBINode *node);
 
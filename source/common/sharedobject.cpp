@@ -25,9 +25,10 @@ SharedObject::addRef(UBool fromWithinCache) const {
     if (umtx_atomic_inc(&hardRefCount) == 1 && cachePtr != NULL) {
         // If this object is cached, and the hardRefCount goes from 0 to 1,
         // then the increment must happen from within the cache while the
-        // cache global mutex is locked. In this way, we can be rest assured
-        // that data races can't happen if the cache performs some task if
-        // the hardRefCount is zero while the global cache mutex is locked.
+        // cache global mutex or one of its read stripes is locked. Eviction
+        // holds all of these, so we can be rest assured that data races
+        // can't happen if the cache performs some task if the hardRefCount
+        // is zero while they are locked.
         (void)fromWithinCache;   // Suppress unused variable warning in non-debug builds.
         U_ASSERT(fromWithinCache);
         cachePtr->incrementItemsInUse();
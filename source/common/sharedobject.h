@@ -86,7 +86,7 @@ public:
     /**
      * Increments the number of references to this object.
      * Must be called only from within the internals of UnifiedCache and
-     * only while the cache global mutex is held.
+     * only while the cache global mutex or one of its read stripes is held.
      */
     void addRefWhileHoldingCacheLock() const { addRef(TRUE); }
 
@@ -105,7 +105,7 @@ public:
     /**
      * Decrements the number of references to this object.
      * Must be called only from within the internals of UnifiedCache and
-     * only while the cache global mutex is held.
+     * only while the cache global mutex or one of its read stripes is held.
      */
     void removeRefWhileHoldingCacheLock() const { removeRef(TRUE); }
 
@@ -273,6 +273,57 @@ ubrk_getRuleStatusVec(UBreakIterator *bi, int32_t *fillInVec, int32_t capacity,
 }
 
 
+U_CAPI int32_t U_EXPORT2
+ubrk_getBoundaries(UBreakIterator *bi, int32_t *offsets, int32_t *statuses, int32_t capacity,
+                   UErrorCode *status)
+{
+    if (status == NULL || U_FAILURE(*status)) {
+        return 0;
+    }
+    if (bi == NULL || capacity < 0 || (capacity > 0 && offsets == NULL)) {
+        *status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    BreakIterator *brkit = reinterpret_cast<BreakIterator *>(bi);
+    RuleBasedBreakIterator *rbbi = dynamic_cast<RuleBasedBreakIterator *>(brkit);
+    if (rbbi != NULL) {
+        return rbbi->getBoundaries(offsets, statuses, capacity, *status);
+    }
+
+    // Other break iterators, one boundary at a time.
+    int32_t count = 0;
+    int32_t pos;
+    while (count < capacity && (pos = brkit->next()) != UBRK_DONE) {
+        offsets[count] = pos;
+        if (statuses != NULL) {
+            statuses[count] = brkit->getRuleStatus();
+        }
+        ++count;
+    }
+    return count;
+}
+
+
+U_CAPI int32_t U_EXPORT2
+ubrk_getBoundariesParallel(UBreakIterator *bi, int32_t *offsets, int32_t *statuses, int32_t capacity,
+                           int32_t threadCount, UErrorCode *status)
+{
+    if (status == NULL || U_FAILURE(*status)) {
+        return 0;
+    }
+    if (bi == NULL || capacity < 0 || (capacity > 0 && offsets == NULL)) {
+        *status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    RuleBasedBreakIterator *rbbi =
+        dynamic_cast<RuleBasedBreakIterator *>(reinterpret_cast<BreakIterator *>(bi));
+    if (rbbi != NULL) {
+        return rbbi->getBoundaries(offsets, statuses, capacity, threadCount, *status);
+    }
+    return ubrk_getBoundaries(bi, offsets, statuses, capacity, status);
+}
+
+
 U_CAPI const char* U_EXPORT2
 ubrk_getLocaleByType(const UBreakIterator *bi,
                      ULocDataLocaleType type,
@@ -216,24 +216,64 @@ static uint32_t offsetTOCEntryCount(const UDataMemory *pData) {
     return retVal;
 }
 
+U_CAPI uint32_t U_EXPORT2
+udata_hashTOCEntryName(const char *name) {
+    /* 32-bit FNV-1a */
+    uint32_t hash=0x811c9dc5;
+    uint8_t c;
+    while((c=(uint8_t)*name++)!=0) {
+        hash=(hash^c)*16777619;
+    }
+    return hash;
+}
+
+static int32_t
+offsetTOCHashSearch(const char *s, const char *names,
+                    const UDataOffsetTOC *toc) {
+    const UDataOffsetTOCHash *hash=(const UDataOffsetTOCHash *)(toc->entry+toc->count);
+    uint32_t mask=hash->length-1;
+    uint32_t i=udata_hashTOCEntryName(s)&mask;
+    uint32_t slot, probes;
+    /*
+     * Linear probing up to an empty slot.
+     * Do not trust the data to have one: Visit each slot at most once.
+     */
+    for(probes=0; probes<=mask; ++probes) {
+        slot=hash->slots[i];
+        if(slot==0 || slot>toc->count) {
+            break;
+        }
+        if(0==uprv_strcmp(s, names+toc->entry[slot-1].nameOffset)) {
+            return (int32_t)(slot-1);
+        }
+        i=(i+1)&mask;
+    }
+    return -1;
+}
+
 static const DataHeader *
-offsetTOCLookupFn(const UDataMemory *pData,
-                  const char *tocEntryName,
-                  int32_t *pLength,
-                  UErrorCode *pErrorCode) {
+offsetTOCLookup(const UDataMemory *pData,
+                const char *tocEntryName,
+                int32_t *pLength,
+                UBool useHash) {
     const UDataOffsetTOC  *toc = (UDataOffsetTOC *)pData->toc;
     if(toc!=NULL) {
         const char *base=(const char *)toc;
         int32_t number, count=(int32_t)toc->count;
 
-        /* perform a binary search for the data in the common data's table of contents */
 #if defined (UDATA_DEBUG_DUMP)
         /* list the contents of the TOC each time .. not recommended */
         for(number=0; number<count; ++number) {
             fprintf(stderr, "\tx%d: %s\n", number, &base[toc->entry[number].nameOffset]);
         }
 #endif
-        number=offsetTOCPrefixBinarySearch(tocEntryName, base, toc->entry, count);
+        if(useHash) {
+            /* look up the data in the hash index that follows the table of contents */
+            number=offsetTOCHashSearch(tocEntryName, base, toc);
+        } else {
+            /* perform a binary search for the data in the common data's table of contents */
+            number=offsetTOCPrefixBinarySearch(tocEntryName, base, toc->entry, count);
+        }
         if(number>=0) {
             /* found it */
             const UDataOffsetTOCEntry *entry=toc->entry+number;
@@ -242,6 +282,9 @@ offsetTOCLookupFn(const UDataMemory *pData,
 #endif
             if((number+1) < count) {
                 *pLength = (int32_t)(entry[1].dataOffset - entry->dataOffset);
+            } else if(pData->length >= 0) {
+                /* The last item extends to the end of the common data. */
+                *pLength = pData->length - (int32_t)(base + entry->dataOffset - (const char *)pData->pHeader);
             } else {
                 *pLength = -1;
             }
@@ -262,6 +305,22 @@ offsetTOCLookupFn(const UDataMemory *pData,
 }
 
 
+static const DataHeader *
+offsetTOCLookupFn(const UDataMemory *pData,
+                  const char *tocEntryName,
+                  int32_t *pLength,
+                  UErrorCode *pErrorCode) {
+    return offsetTOCLookup(pData, tocEntryName, pLength, FALSE);
+}
+
+static const DataHeader *
+offsetTOCHashLookupFn(const UDataMemory *pData,
+                      const char *tocEntryName,
+                      int32_t *pLength,
+                      UErrorCode *pErrorCode) {
+    return offsetTOCLookup(pData, tocEntryName, pLength, TRUE);
+}
+
 static uint32_t pointerTOCEntryCount(const UDataMemory *pData) {
     const PointerTOC *toc = (PointerTOC *)pData->toc;
     return (uint32_t)((toc != NULL) ? (toc->count) : 0);
@@ -302,6 +361,7 @@ static const DataHeader *pointerTOCLookupFn(const UDataMemory *pData,
 }
 
 static const commonDataFuncs CmnDFuncs = {offsetTOCLookupFn,  offsetTOCEntryCount};
+static const commonDataFuncs CmnDHashFuncs = {offsetTOCHashLookupFn,  offsetTOCEntryCount};
 static const commonDataFuncs ToCPFuncs = {pointerTOCLookupFn, pointerTOCEntryCount};
 
 
@@ -336,8 +396,29 @@ U_CFUNC void udata_checkCommonData(UDataMemory *udm, UErrorCode *err) {
         udm->pHeader->info.formatVersion[0]==1
         ) {
         /* dataFormat="CmnD" */
+        const UDataOffsetTOC *toc;
         udm->vFuncs = &CmnDFuncs;
-        udm->toc=(const char *)udm->pHeader+udata_getHeaderSize(udm->pHeader);
+        udm->toc=toc=(const UDataOffsetTOC *)((const char *)udm->pHeader+udata_getHeaderSize(udm->pHeader));
+        if(udm->pHeader->info.formatVersion[1]>=1) {
+            /*
+             * Format version 1.1 adds a hash index; use it if it looks valid
+             * and fits between the TOC entries and the first item's data.
+             */
+            uint32_t count=toc->count;
+            if(count>0) {
+                uint32_t limit=toc->entry[0].dataOffset;
+                if(limit>=12 && count<=(limit-12)/8) {
+                    uint32_t hashStart=4+8*count;
+                    const UDataOffsetTOCHash *hash=
+                        (const UDataOffsetTOCHash *)((const char *)toc+hashStart);
+                    uint32_t hashLength=hash->length;
+                    if(hashLength>count && (hashLength&(hashLength-1))==0 &&
+                            hashLength<=(limit-hashStart-4)/4) {
+                        udm->vFuncs = &CmnDHashFuncs;
+                    }
+                }
+            }
+        }
     }
     else if(udm->pHeader->info.dataFormat[0]==0x54 &&
         udm->pHeader->info.dataFormat[1]==0x6f &&
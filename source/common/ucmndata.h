@@ -55,6 +55,25 @@ typedef struct {
     UDataOffsetTOCEntry entry[2];    /* Actual size of array is from count. */
 } UDataOffsetTOC;
 
+/**
+ * Optional hash index for an offset TOC, in CmnD formatVersion 1.1 and higher.
+ * It immediately follows the TOC entries.
+ * Each non-zero slot is 1 + the index of a TOC entry, placed at or after
+ * udata_hashTOCEntryName(name)&(length-1) with linear probing.
+ */
+typedef struct {
+    uint32_t length;    /* Power of 2, greater than the TOC count. */
+    uint32_t slots[2];  /* Actual size of array is from length. 0=empty slot. */
+} UDataOffsetTOCHash;
+
+/**
+ * Hash function for the names in a UDataOffsetTOCHash.
+ *
+ * @internal
+ */
+U_CAPI uint32_t U_EXPORT2
+udata_hashTOCEntryName(const char *name);
+
 /**
  * Get the header size from a const DataHeader *udh.
  * Handles opposite-endian data.
@@ -2522,6 +2522,197 @@ ucnv_convert(const char *toConverterName, const char *fromConverterName,
     return targetLength;
 }
 
+/* ucnv_to/fromUCharsBatch() ------------------------------------------------ */
+
+/*
+ * The batch functions convert each item with flush=TRUE.
+ * After an item is converted successfully, the conversion function
+ * has already reset the converter without calling the callback,
+ * so that an explicit reset is only needed at the start and after errors.
+ */
+
+U_CAPI int32_t U_EXPORT2
+ucnv_fromUCharsBatch(UConverter *cnv,
+                     char *dest, int32_t destCapacity,
+                     const UChar *const *sources, const int32_t *sourceLengths, int32_t count,
+                     int32_t *destIndexes, UErrorCode *itemErrors,
+                     UErrorCode *pErrorCode) {
+    const UChar *src, *srcLimit;
+    char *d, *destLimit;
+    int32_t srcLength, destLength, i;
+    UBool overflow;
+
+    /* check arguments */
+    if(pErrorCode==NULL || U_FAILURE(*pErrorCode)) {
+        return 0;
+    }
+
+    if( cnv==NULL ||
+        destCapacity<0 || (destCapacity>0 && dest==NULL) ||
+        count<0 || (count>0 && sources==NULL)
+    ) {
+        *pErrorCode=U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+
+    /* initialize */
+    ucnv_resetFromUnicode(cnv);
+    destLimit=dest+destCapacity;
+
+    /* pin the destination limit to U_MAX_PTR; NULL check is for OS/400 */
+    if(destLimit<dest || (destLimit==NULL && dest!=NULL)) {
+        destLimit=(char *)U_MAX_PTR(dest);
+    }
+    destLength=0;
+    overflow=FALSE;
+
+    for(i=0; i<count; ++i) {
+        UErrorCode itemErrorCode=U_ZERO_ERROR;
+
+        if(destIndexes!=NULL) {
+            destIndexes[i]=destLength;
+        }
+        src=sources[i];
+        srcLength= sourceLengths==NULL ? -1 : sourceLengths[i];
+        if(srcLength<-1 || (srcLength!=0 && src==NULL)) {
+            itemErrorCode=U_ILLEGAL_ARGUMENT_ERROR;
+        } else {
+            if(srcLength==-1) {
+                srcLength=u_strlen(src);
+            }
+            if(srcLength>0) {
+                srcLimit=src+srcLength;
+                if(!overflow) {
+                    d=dest+destLength;
+                    ucnv_fromUnicode(cnv, &d, destLimit, &src, srcLimit, 0, TRUE, &itemErrorCode);
+                    destLength=(int32_t)(d-dest);
+                }
+
+                /* if an overflow occurs, then get the preflighting length */
+                if(overflow || itemErrorCode==U_BUFFER_OVERFLOW_ERROR) {
+                    char buffer[1024];
+
+                    overflow=TRUE;
+                    do {
+                        d=buffer;
+                        itemErrorCode=U_ZERO_ERROR;
+                        ucnv_fromUnicode(cnv, &d, buffer+sizeof(buffer), &src, srcLimit, 0, TRUE, &itemErrorCode);
+                        destLength+=(int32_t)(d-buffer);
+                    } while(itemErrorCode==U_BUFFER_OVERFLOW_ERROR);
+                }
+            }
+        }
+
+        if(itemErrors!=NULL) {
+            itemErrors[i]=itemErrorCode;
+        }
+        if(U_FAILURE(itemErrorCode)) {
+            if(itemErrors==NULL) {
+                *pErrorCode=itemErrorCode;
+                return destLength;
+            }
+            /* start the next item from a clean state */
+            ucnv_resetFromUnicode(cnv);
+        }
+    }
+
+    if(destIndexes!=NULL) {
+        destIndexes[count]=destLength;
+    }
+    return u_terminateChars(dest, destCapacity, destLength, pErrorCode);
+}
+
+U_CAPI int32_t U_EXPORT2
+ucnv_toUCharsBatch(UConverter *cnv,
+                   UChar *dest, int32_t destCapacity,
+                   const char *const *sources, const int32_t *sourceLengths, int32_t count,
+                   int32_t *destIndexes, UErrorCode *itemErrors,
+                   UErrorCode *pErrorCode) {
+    const char *src, *srcLimit;
+    UChar *d, *destLimit;
+    int32_t srcLength, destLength, i;
+    UBool overflow;
+
+    /* check arguments */
+    if(pErrorCode==NULL || U_FAILURE(*pErrorCode)) {
+        return 0;
+    }
+
+    if( cnv==NULL ||
+        destCapacity<0 || (destCapacity>0 && dest==NULL) ||
+        count<0 || (count>0 && sources==NULL)
+    ) {
+        *pErrorCode=U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+
+    /* initialize */
+    ucnv_resetToUnicode(cnv);
+    destLimit=dest+destCapacity;
+
+    /* pin the destination limit to U_MAX_PTR; NULL check is for OS/400 */
+    if(destLimit<dest || (destLimit==NULL && dest!=NULL)) {
+        destLimit=(UChar *)U_MAX_PTR(dest);
+    }
+    destLength=0;
+    overflow=FALSE;
+
+    for(i=0; i<count; ++i) {
+        UErrorCode itemErrorCode=U_ZERO_ERROR;
+
+        if(destIndexes!=NULL) {
+            destIndexes[i]=destLength;
+        }
+        src=sources[i];
+        srcLength= sourceLengths==NULL ? -1 : sourceLengths[i];
+        if(srcLength<-1 || (srcLength!=0 && src==NULL)) {
+            itemErrorCode=U_ILLEGAL_ARGUMENT_ERROR;
+        } else {
+            if(srcLength==-1) {
+                srcLength=(int32_t)uprv_strlen(src);
+            }
+            if(srcLength>0) {
+                srcLimit=src+srcLength;
+                if(!overflow) {
+                    d=dest+destLength;
+                    ucnv_toUnicode(cnv, &d, destLimit, &src, srcLimit, 0, TRUE, &itemErrorCode);
+                    destLength=(int32_t)(d-dest);
+                }
+
+                /* if an overflow occurs, then get the preflighting length */
+                if(overflow || itemErrorCode==U_BUFFER_OVERFLOW_ERROR) {
+                    UChar buffer[1024];
+
+                    overflow=TRUE;
+                    do {
+                        d=buffer;
+                        itemErrorCode=U_ZERO_ERROR;
+                        ucnv_toUnicode(cnv, &d, buffer+UPRV_LENGTHOF(buffer), &src, srcLimit, 0, TRUE, &itemErrorCode);
+                        destLength+=(int32_t)(d-buffer);
+                    } while(itemErrorCode==U_BUFFER_OVERFLOW_ERROR);
+                }
+            }
+        }
+
+        if(itemErrors!=NULL) {
+            itemErrors[i]=itemErrorCode;
+        }
+        if(U_FAILURE(itemErrorCode)) {
+            if(itemErrors==NULL) {
+                *pErrorCode=itemErrorCode;
+                return destLength;
+            }
+            /* start the next item from a clean state */
+            ucnv_resetToUnicode(cnv);
+        }
+    }
+
+    if(destIndexes!=NULL) {
+        destIndexes[count]=destLength;
+    }
+    return u_terminateUChars(dest, destCapacity, destLength, pErrorCode);
+}
+
 /* @internal */
 static int32_t
 ucnv_convertAlgorithmic(UBool convertToAlgorithmic,
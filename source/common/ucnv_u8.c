@@ -31,6 +31,7 @@
 #include "ucnv_bld.h"
 #include "ucnv_cnv.h"
 #include "cmemory.h"
+#include "ustr_imp.h"
 
 /* Prototypes --------------------------------------------------------------- */
 
@@ -129,7 +130,21 @@ static void ucnv_toUnicode_UTF8 (UConverterToUnicodeArgs * args,
         ch = *(mySource++);
         if (ch < 0x80)        /* Simple case */
         {
+            int32_t count;
             *(myTarget++) = (UChar) ch;
+
+            /* Convert the rest of a run of ASCII in bulk */
+            count = (int32_t)(sourceLimit - mySource);
+            if (count > (int32_t)(targetLimit - myTarget))
+            {
+                count = (int32_t)(targetLimit - myTarget);
+            }
+            if (count > 0 && *mySource < 0x80)
+            {
+                count = ustr_asciiToUChars(myTarget, mySource, count);
+                myTarget += count;
+                mySource += count;
+            }
         }
         else
         {
@@ -383,7 +398,21 @@ U_CFUNC void ucnv_fromUnicode_UTF8 (UConverterFromUnicodeArgs * args,
 
         if (ch < 0x80)        /* Single byte */
         {
+            int32_t count;
             *(myTarget++) = (uint8_t) ch;
+
+            /* Convert the rest of a run of ASCII in bulk */
+            count = (int32_t)(sourceLimit - mySource);
+            if (count > (int32_t)(targetLimit - myTarget))
+            {
+                count = (int32_t)(targetLimit - myTarget);
+            }
+            if (count > 0 && *mySource < 0x80)
+            {
+                count = ustr_ucharsToASCII(myTarget, mySource, count);
+                myTarget += count;
+                mySource += count;
+            }
         }
         else if (ch < 0x800)  /* Double byte */
         {
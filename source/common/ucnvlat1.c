@@ -23,6 +23,7 @@
 #include "unicode/utf8.h"
 #include "ucnv_bld.h"
 #include "ucnv_cnv.h"
+#include "ustr_imp.h"
 
 /* control optimizations according to the platform */
 #define LATIN1_UNROLL_FROM_UNICODE 1
@@ -61,7 +62,13 @@ _Latin1ToUnicodeWithOffsets(UConverterToUnicodeArgs *pArgs,
         length=targetCapacity;
     }
 
-    if(targetCapacity>=8) {
+    if(offsets==NULL) {
+        /* bulk mode: without offsets, widen the whole block at once */
+        ustr_latin1ToUChars(target, source, targetCapacity);
+        source+=targetCapacity;
+        target+=targetCapacity;
+        targetCapacity=0;
+    } else if(targetCapacity>=8) {
         /* This loop is unrolled for speed and improved pipelining. */
         int32_t count, loops;
 
@@ -179,6 +186,16 @@ _Latin1FromUnicodeWithOffsets(UConverterFromUnicodeArgs *pArgs,
         goto getTrail;
     }
 
+    if(offsets==NULL) {
+        /* bulk mode: without offsets, convert the leading run of mappable code units at once */
+        int32_t count= max==0xff ?
+            ustr_ucharsToLatin1(target, source, targetCapacity) :
+            ustr_ucharsToASCII(target, source, targetCapacity);
+        source+=count;
+        target+=count;
+        targetCapacity-=count;
+    }
+
 #if LATIN1_UNROLL_FROM_UNICODE
     /* unroll the loop with the most common case */
     if(targetCapacity>=16) {
@@ -497,7 +514,13 @@ _ASCIIToUnicodeWithOffsets(UConverterToUnicodeArgs *pArgs,
         targetCapacity=length;
     }
 
-    if(targetCapacity>=8) {
+    if(offsets==NULL) {
+        /* bulk mode: without offsets, convert the leading run of ASCII bytes at once */
+        int32_t count=ustr_asciiToUChars(target, source, targetCapacity);
+        source+=count;
+        target+=count;
+        targetCapacity-=count;
+    } else if(targetCapacity>=8) {
         /* This loop is unrolled for speed and improved pipelining. */
         int32_t count, loops;
         UChar oredChars;
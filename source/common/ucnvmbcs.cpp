@@ -59,6 +59,7 @@
 #include "cmemory.h"
 #include "cstring.h"
 #include "umutex.h"
+#include "ustr_imp.h"
 
 /* control optimizations according to the platform */
 #define MBCS_UNROLL_SINGLE_TO_BMP 1
@@ -1662,6 +1663,8 @@ ucnv_MBCSLoad(UConverterSharedData *sharedData,
         /*
          * The reconstitutedData must be deleted only when the base converter
          * is unloaded.
+         * The same is true for the sbcsDenseResults which are shared with
+         * the base converter because they only depend on the base table.
          */
         mbcsTable->reconstitutedData=NULL;
 
@@ -1852,6 +1855,29 @@ ucnv_MBCSLoad(UConverterSharedData *sharedData,
                 stage1Length/2;
             reconstituteData(mbcsTable, stage1Length, stage2Length, header->fullStage2Length, pErrorCode);
         }
+
+        /*
+         * Flatten the low BMP part of the SBCS fromUnicode trie for
+         * bulk conversion in ucnv_MBCSSingleFromBMPWithOffsets().
+         * This costs 4kB per loaded SBCS table and is optional:
+         * If the allocation fails, then the conversion just uses the trie.
+         */
+        if( U_SUCCESS(*pErrorCode) &&
+            mbcsTable->outputType==MBCS_OUTPUT_1 &&
+            (mbcsTable->unicodeMask&(UCNV_HAS_SUPPLEMENTARY|UCNV_HAS_SURROGATES))==0
+        ) {
+            uint16_t *denseResults=(uint16_t *)uprv_malloc(SBCS_DENSE_LIMIT*2);
+            if(denseResults!=NULL) {
+                const uint16_t *table=mbcsTable->fromUnicodeTable;
+                const uint16_t *results=(const uint16_t *)mbcsTable->fromUnicodeBytes;
+                UChar32 c;
+
+                for(c=0; c<SBCS_DENSE_LIMIT; ++c) {
+                    denseResults[c]=MBCS_SINGLE_RESULT_FROM_U(table, results, c);
+                }
+                mbcsTable->sbcsDenseResults=denseResults;
+            }
+        }
     }
 
     /* Set the impl pointer here so that it is set for both extension-only and base tables. */
@@ -1884,6 +1910,10 @@ ucnv_MBCSUnload(UConverterSharedData *sharedData) {
     if(mbcsTable->stateTableOwned) {
         uprv_free((void *)mbcsTable->stateTable);
     }
+    if(mbcsTable->sbcsDenseResults!=NULL && mbcsTable->baseSharedData==NULL) {
+        /* not owned by an extension-only converter */
+        uprv_free(mbcsTable->sbcsDenseResults);
+    }
     if(mbcsTable->baseSharedData!=NULL) {
         ucnv_unload(mbcsTable->baseSharedData);
     }
@@ -2191,6 +2221,8 @@ ucnv_MBCSSingleToBMPWithOffsets(UConverterToUnicodeArgs *pArgs,
     int32_t entry;
     uint8_t action;
 
+    UBool asciiBulk;
+
     /* set up the local pointers */
     cnv=pArgs->converter;
     source=(const uint8_t *)pArgs->source;
@@ -2205,6 +2237,15 @@ ucnv_MBCSSingleToBMPWithOffsets(UConverterToUnicodeArgs *pArgs,
         stateTable=cnv->sharedData->mbcs.stateTable;
     }
 
+    /*
+     * Bulk mode: Without offsets, runs of ASCII bytes are copied many at a time
+     * if all of ASCII round-trips through the (unswapped) state table.
+     */
+    asciiBulk=(UBool)(
+        offsets==NULL &&
+        cnv->sharedData->mbcs.asciiRoundtrips==0xffffffff &&
+        stateTable==cnv->sharedData->mbcs.stateTable);
+
     /* sourceIndex=-1 if the current character began in the previous buffer */
     sourceIndex=0;
     lastSource=source;
@@ -2222,7 +2263,44 @@ ucnv_MBCSSingleToBMPWithOffsets(UConverterToUnicodeArgs *pArgs,
     /* unrolling makes it faster on Pentium III/Windows 2000 */
     /* unroll the loop with the most common case */
 unrolled:
-    if(targetCapacity>=16) {
+    if(offsets==NULL) {
+        /*
+         * Bulk mode: Convert whole blocks of 16 bytes with direct lookups
+         * in the single state's 256 entries, and ASCII runs with SIMD where possible,
+         * until a byte needs the fallback, callback or extension handling below.
+         */
+        while(targetCapacity>=16) {
+            int32_t i, oredEntries;
+
+            if(asciiBulk) {
+                /* only switch to the ASCII run loop for runs of at least 16 bytes */
+                uint64_t words[2];
+                uprv_memcpy(words, source, 16);
+                if(((words[0]|words[1])&UINT64_C(0x8080808080808080))==0) {
+                    i=ustr_asciiToUChars(target, source, targetCapacity);
+                    source+=i;
+                    target+=i;
+                    targetCapacity-=i;
+                    continue;
+                }
+            }
+
+            oredEntries=0;
+            for(i=0; i<16; ++i) {
+                oredEntries|=entry=stateTable[0][source[i]];
+                target[i]=(UChar)MBCS_ENTRY_FINAL_VALUE_16(entry);
+            }
+
+            /* were all 16 entries really valid? */
+            if(!MBCS_ENTRY_FINAL_IS_VALID_DIRECT_16(oredEntries)) {
+                /* no, leave these 16 to the conversion loop */
+                break;
+            }
+            source+=16;
+            target+=16;
+            targetCapacity-=16;
+        }
+    } else if(targetCapacity>=16) {
         int32_t count, loops, oredEntries;
 
         loops=count=targetCapacity>>4;
@@ -3868,6 +3946,40 @@ ucnv_MBCSSingleFromBMPWithOffsets(UConverterFromUnicodeArgs *pArgs,
         goto getTrail;
     }
 
+    if(offsets==NULL && results==(const uint16_t *)cnv->sharedData->mbcs.fromUnicodeBytes) {
+        /*
+         * Bulk mode: Without offsets, look up the low BMP in the flat
+         * sbcsDenseResults table and convert ASCII runs with SIMD where possible,
+         * until a code unit needs the fallback, callback or extension handling below.
+         */
+        const uint16_t *denseResults=cnv->sharedData->mbcs.sbcsDenseResults;
+        UBool asciiBulk=(UBool)(asciiRoundtrips==0xffffffff);
+
+        while(targetCapacity>0) {
+            c=*source;
+            if(c<=0x7f && asciiBulk && targetCapacity>=16 && source[15]<=0x7f) {
+                /* likely a long ASCII run, convert it many at a time */
+                length=ustr_ucharsToASCII(target, source, targetCapacity);
+                source+=length;
+                target+=length;
+                targetCapacity-=length;
+                continue;
+            }
+            if(c<SBCS_DENSE_LIMIT && denseResults!=NULL) {
+                value=denseResults[c];
+            } else {
+                value=MBCS_SINGLE_RESULT_FROM_U(table, results, c);
+            }
+            if(value<minValue) {
+                break;
+            }
+            *target++=(uint8_t)value;
+            ++source;
+            --targetCapacity;
+        }
+        c=0;
+    }
+
 #if MBCS_UNROLL_SINGLE_FROM_BMP
     /* unrolling makes it slower on Pentium III/Windows 2000?! */
     /* unroll the loop with the most common case */
@@ -5130,6 +5242,28 @@ ucnv_SBCSFromUTF8(UConverterFromUnicodeArgs *pFromUArgs,
                 if(IS_ASCII_ROUNDTRIP(b, asciiRoundtrips)) {
                     *target++=(uint8_t)b;
                     --targetCapacity;
+                    if(asciiRoundtrips==0xffffffff) {
+                        /*
+                         * Bulk mode: UTF-8 and this codepage share all of ASCII,
+                         * so copy the rest of the ASCII run 8 bytes at a time.
+                         */
+                        int32_t count=(int32_t)(sourceLimit-source);
+                        uint64_t word;
+                        if(count>targetCapacity) {
+                            count=targetCapacity;
+                        }
+                        while(count>=8) {
+                            uprv_memcpy(&word, source, 8);
+                            if((word&UINT64_C(0x8080808080808080))!=0) {
+                                break;
+                            }
+                            uprv_memcpy(target, &word, 8);
+                            source+=8;
+                            target+=8;
+                            targetCapacity-=8;
+                            count-=8;
+                        }
+                    }
                     continue;
                 } else {
                     c=b;
@@ -358,7 +358,8 @@ enum {
     SBCS_FAST_MAX=0x0fff,               /* maximum code point with UTF-8-friendly SBCS runtime code, see makeconv SBCS_UTF8_MAX */
     SBCS_FAST_LIMIT=SBCS_FAST_MAX+1,    /* =0x1000 */
     MBCS_FAST_MAX=0xd7ff,               /* maximum code point with UTF-8-friendly MBCS runtime code, see makeconv MBCS_UTF8_MAX */
-    MBCS_FAST_LIMIT=MBCS_FAST_MAX+1     /* =0xd800 */
+    MBCS_FAST_LIMIT=MBCS_FAST_MAX+1,    /* =0xd800 */
+    SBCS_DENSE_LIMIT=0x800              /* U+0000..U+07FF have a flat SBCS fromUnicode results table, see sbcsDenseResults */
 };
 
 /**
@@ -391,6 +392,13 @@ typedef struct UConverterMBCSTable {
     /* roundtrips */
     uint32_t asciiRoundtrips;
 
+    /*
+     * SBCS fromUnicode results for U+0000..SBCS_DENSE_LIMIT-1 indexed directly by code point,
+     * for bulk conversion without the stage 1/2 lookups;
+     * owned by the base converter, NULL if not applicable or not allocated
+     */
+    uint16_t *sbcsDenseResults;
+
     /* reconstituted data that was omitted from the .cnv file */
     uint8_t *reconstitutedData;
 
@@ -426,6 +434,8 @@ typedef struct UConverterMBCSTable {
     /* roundtrips */ \
     0, \
      \
+    NULL, \
+     \
     /* reconstituted data that was omitted from the .cnv file */ \
     NULL, \
      \
@@ -0,0 +1,257 @@
+// Copyright (C) 2016 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+/*
+*******************************************************************************
+*
+*   Copyright (C) 2016, International Business Machines
+*   Corporation and others.  All Rights Reserved.
+*
+*******************************************************************************
+*   file name:  ucnvpool.cpp
+*   encoding:   US-ASCII
+*   tab size:   8 (not used)
+*   indentation:4
+*
+*   Bounded pool of open converters, keyed by canonical converter name,
+*   for code that would otherwise call ucnv_open()/ucnv_close() per request.
+*/
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_CONVERSION
+
+#include "unicode/ucnv.h"
+#include "unicode/ucnvpool.h"
+#include "ucnv_bld.h"
+#include "ucnv_imp.h"
+#include "ucnv_io.h"
+#include "cmemory.h"
+#include "cstring.h"
+
+/*
+ * One pool slot.
+ * The snapshot fields hold the substitution and fallback settings
+ * that the converter had right after ucnv_open(),
+ * so that check-in can undo ucnv_setSubstChars() and ucnv_setFallback().
+ */
+struct UConverterPoolEntry {
+    UConverter *cnv;
+    uint32_t lastUse;       /* pool clock value at the last check-in, for LRU eviction */
+    UBool inUse;
+    UBool useFallback;
+    int8_t subCharLen;
+    uint8_t subChar1;
+    UChar subUChars[UCNV_MAX_SUBCHAR_LEN/U_SIZEOF_UCHAR];
+    char name[UCNV_MAX_CONVERTER_NAME_LENGTH];  /* canonical name, the lookup key */
+    char alias[UCNV_MAX_CONVERTER_NAME_LENGTH]; /* name as last passed in, "" if too long */
+};
+
+struct UConverterPool {
+    UConverterPoolEntry *entries;
+    int32_t capacity;
+    int32_t length;
+    uint32_t clock;
+    int32_t counters[UCNV_POOL_SIZE];
+};
+
+/*
+ * Returns the key for the converter name: the canonical name if the alias
+ * is known and has no options, otherwise the name itself.
+ * Names with options (",swaplfnl" etc.) are compared verbatim.
+ */
+static const char *
+getPoolKey(const char *name) {
+    if(uprv_strchr(name, UCNV_OPTION_SEP_CHAR)==NULL) {
+        UErrorCode errorCode=U_ZERO_ERROR;
+        UBool containsOption;
+        const char *canonical=ucnv_io_getConverterName(name, &containsOption, &errorCode);
+        if(U_SUCCESS(errorCode) && canonical!=NULL) {
+            return canonical;
+        }
+    }
+    return name;
+}
+
+static void
+setAlias(UConverterPoolEntry *entry, const char *name) {
+    if(uprv_strlen(name)<UCNV_MAX_CONVERTER_NAME_LENGTH) {
+        uprv_strcpy(entry->alias, name);
+    } else {
+        entry->alias[0]=0;
+    }
+}
+
+/* Records the settings of a newly opened converter. */
+static void
+saveSettings(UConverterPoolEntry *entry, const UConverter *cnv) {
+    entry->useFallback=cnv->useFallback;
+    entry->subCharLen=cnv->subCharLen;
+    entry->subChar1=cnv->subChar1;
+    uprv_memcpy(entry->subUChars, cnv->subUChars, sizeof(entry->subUChars));
+}
+
+/* Resets the converter and undoes all ucnv_setXyz() calls since saveSettings(). */
+static void
+restoreSettings(const UConverterPoolEntry *entry, UConverter *cnv) {
+    ucnv_reset(cnv);
+
+    cnv->fromCharErrorBehaviour=UCNV_TO_U_DEFAULT_CALLBACK;
+    cnv->toUContext=NULL;
+    cnv->fromUCharErrorBehaviour=UCNV_FROM_U_DEFAULT_CALLBACK;
+    cnv->fromUContext=NULL;
+
+    if(cnv->subChars!=(uint8_t *)cnv->subUChars) {
+        /* ucnv_setSubstString() allocated a longer substitution string */
+        uprv_free(cnv->subChars);
+        cnv->subChars=(uint8_t *)cnv->subUChars;
+    }
+    cnv->subCharLen=entry->subCharLen;
+    cnv->subChar1=entry->subChar1;
+    uprv_memcpy(cnv->subUChars, entry->subUChars, sizeof(cnv->subUChars));
+
+    cnv->useFallback=entry->useFallback;
+}
+
+U_CAPI UConverterPool * U_EXPORT2
+ucnv_openPool(int32_t capacity, UErrorCode *pErrorCode) {
+    /* check arguments */
+    if(pErrorCode==NULL || U_FAILURE(*pErrorCode)) {
+        return NULL;
+    }
+    if(capacity<1) {
+        *pErrorCode=U_ILLEGAL_ARGUMENT_ERROR;
+        return NULL;
+    }
+
+    UConverterPool *pool=(UConverterPool *)uprv_malloc(sizeof(UConverterPool));
+    UConverterPoolEntry *entries=
+        (UConverterPoolEntry *)uprv_malloc((size_t)capacity*sizeof(UConverterPoolEntry));
+    if(pool==NULL || entries==NULL) {
+        uprv_free(pool);
+        uprv_free(entries);
+        *pErrorCode=U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+    uprv_memset(pool, 0, sizeof(UConverterPool));
+    pool->entries=entries;
+    pool->capacity=capacity;
+    return pool;
+}
+
+U_CAPI void U_EXPORT2
+ucnv_closePool(UConverterPool *pool) {
+    if(pool==NULL) {
+        return;
+    }
+    for(int32_t i=0; i<pool->length; ++i) {
+        ucnv_close(pool->entries[i].cnv);
+    }
+    uprv_free(pool->entries);
+    uprv_free(pool);
+}
+
+U_CAPI UConverter * U_EXPORT2
+ucnv_checkoutConverter(UConverterPool *pool, const char *name, UErrorCode *pErrorCode) {
+    /* check arguments */
+    if(pErrorCode==NULL || U_FAILURE(*pErrorCode)) {
+        return NULL;
+    }
+    if(pool==NULL) {
+        *pErrorCode=U_ILLEGAL_ARGUMENT_ERROR;
+        return NULL;
+    }
+
+    ++pool->counters[UCNV_POOL_CHECKOUTS];
+    if(name==NULL || *name==0) {
+        name=ucnv_getDefaultName();
+    }
+    UConverterPoolEntry *entries=pool->entries;
+    int32_t i;
+    /*
+     * Callers usually repeat the same spelling of a name,
+     * so try that before the more expensive alias lookup.
+     */
+    for(i=0; i<pool->length; ++i) {
+        if(!entries[i].inUse && uprv_strcmp(entries[i].alias, name)==0) {
+            ++pool->counters[UCNV_POOL_HITS];
+            entries[i].inUse=TRUE;
+            return entries[i].cnv;
+        }
+    }
+    const char *key=getPoolKey(name);
+    for(i=0; i<pool->length; ++i) {
+        if(!entries[i].inUse && uprv_strcmp(entries[i].name, key)==0) {
+            ++pool->counters[UCNV_POOL_HITS];
+            entries[i].inUse=TRUE;
+            setAlias(entries+i, name);
+            return entries[i].cnv;
+        }
+    }
+
+    ++pool->counters[UCNV_POOL_MISSES];
+    UConverter *cnv=ucnv_open(name, pErrorCode);
+    if(U_FAILURE(*pErrorCode)) {
+        return NULL;
+    }
+    if(uprv_strlen(key)>=UCNV_MAX_CONVERTER_NAME_LENGTH) {
+        return cnv;  /* long name with options: not pooled */
+    }
+
+    UConverterPoolEntry *entry;
+    if(pool->length<pool->capacity) {
+        entry=entries+pool->length++;
+    } else {
+        /* evict the least recently used idle converter */
+        entry=NULL;
+        for(i=0; i<pool->length; ++i) {
+            if(!entries[i].inUse && (entry==NULL || (int32_t)(entries[i].lastUse-entry->lastUse)<0)) {
+                entry=entries+i;
+            }
+        }
+        if(entry==NULL) {
+            return cnv;  /* all pooled converters are checked out */
+        }
+        ++pool->counters[UCNV_POOL_EVICTIONS];
+        ucnv_close(entry->cnv);
+    }
+    entry->cnv=cnv;
+    entry->inUse=TRUE;
+    entry->lastUse=pool->clock;
+    uprv_strcpy(entry->name, key);
+    setAlias(entry, name);
+    saveSettings(entry, cnv);
+    return cnv;
+}
+
+U_CAPI void U_EXPORT2
+ucnv_checkinConverter(UConverterPool *pool, UConverter *cnv) {
+    if(cnv==NULL) {
+        return;
+    }
+    if(pool!=NULL) {
+        for(int32_t i=0; i<pool->length; ++i) {
+            UConverterPoolEntry *entry=pool->entries+i;
+            if(entry->cnv==cnv) {
+                restoreSettings(entry, cnv);
+                entry->inUse=FALSE;
+                entry->lastUse=++pool->clock;
+                return;
+            }
+        }
+        ++pool->counters[UCNV_POOL_DISCARDS];
+    }
+    ucnv_close(cnv);
+}
+
+U_CAPI int32_t U_EXPORT2
+ucnv_getPoolStatistic(const UConverterPool *pool, UConverterPoolStatistic which) {
+    if(pool==NULL || which<0 || which>UCNV_POOL_SIZE) {
+        return 0;
+    }
+    if(which==UCNV_POOL_SIZE) {
+        return pool->length;
+    }
+    return pool->counters[which];
+}
+
+#endif  /* !UCONFIG_NO_CONVERSION */
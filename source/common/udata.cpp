@@ -986,6 +986,7 @@ static UDataMemory *doLoadFromIndividualFiles(const char *pkgName,
                 *  and return it.   */
                 pEntryData->mapAddr = dataMemory.mapAddr;
                 pEntryData->map     = dataMemory.map;
+                pEntryData->length  = dataMemory.length;
 
 #ifdef UDATA_DEBUG
                 fprintf(stderr, "** Mapped file: %s\n", pathBuffer);
@@ -1415,3 +1416,35 @@ U_CAPI void U_EXPORT2 udata_setFileAccess(UDataFileAccess access, UErrorCode * /
     // Note: this function is documented as not thread safe.
     gDataFileAccess = access;
 }
+
+U_CAPI void U_EXPORT2
+udata_prefault(const UDataMemory *pData, uint32_t options, UErrorCode *pErrorCode) {
+    if(pErrorCode==NULL || U_FAILURE(*pErrorCode)) {
+        return;
+    }
+    if(pData==NULL || pData->pHeader==NULL) {
+        *pErrorCode=U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    if(pData->length<0) {
+        *pErrorCode=U_UNSUPPORTED_ERROR;
+        return;
+    }
+    uprv_prefaultMemory(pData->pHeader, pData->length, options);
+}
+
+U_CAPI int32_t U_EXPORT2
+udata_getResidentPages(const UDataMemory *pData, int32_t *pTotalPages, UErrorCode *pErrorCode) {
+    if(pErrorCode==NULL || U_FAILURE(*pErrorCode)) {
+        return 0;
+    }
+    if(pData==NULL || pData->pHeader==NULL) {
+        *pErrorCode=U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    if(pData->length<0) {
+        *pErrorCode=U_UNSUPPORTED_ERROR;
+        return 0;
+    }
+    return uprv_countResidentPages(pData->pHeader, pData->length, pTotalPages, pErrorCode);
+}
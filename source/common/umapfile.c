@@ -20,8 +20,13 @@
 /* Defines _XOPEN_SOURCE for access to POSIX functions.
  * Must be before any other #includes. */
 #include "uposixdefs.h"
+#if defined(__linux__) && !defined(_DEFAULT_SOURCE)
+    /* madvise() and mincore() are not POSIX functions. */
+#   define _DEFAULT_SOURCE
+#endif
 
 #include "unicode/putil.h"
+#include "cmemory.h"
 #include "udatamem.h"
 #include "umapfile.h"
 
@@ -195,6 +200,7 @@
         pData->map = (char *)data + length;
         pData->pHeader=(const DataHeader *)data;
         pData->mapAddr = data;
+        pData->length = length;
 #if U_PLATFORM == U_PF_IPHONE
         posix_madvise(data, length, POSIX_MADV_RANDOM);
 #endif
@@ -268,6 +274,7 @@
         pData->map=p;
         pData->pHeader=(const DataHeader *)p;
         pData->mapAddr=p;
+        pData->length=fileLength;
         return TRUE;
     }
 
@@ -464,3 +471,111 @@
 #else
 #   error MAP_IMPLEMENTATION is set incorrectly
 #endif
+
+
+/*----------------------------------------------------------------------------*
+ *                                                                            *
+ *   Prefaulting of data memory, and reporting which of its pages are in RAM. *
+ *                                                                            *
+ *----------------------------------------------------------------------------*/
+#if MAP_IMPLEMENTATION==MAP_POSIX && U_PLATFORM_IS_LINUX_BASED
+#   define UMAP_HAVE_MADVISE 1
+#else
+#   define UMAP_HAVE_MADVISE 0
+#endif
+
+static size_t
+umap_getPageSize(void) {
+#if MAP_IMPLEMENTATION==MAP_POSIX
+    long pageSize=sysconf(_SC_PAGESIZE);
+    if(pageSize>0) {
+        return (size_t)pageSize;
+    }
+#endif
+    return 4096;
+}
+
+U_CFUNC void
+uprv_prefaultMemory(const void *start, int32_t length, uint32_t options) {
+    size_t pageSize;
+    const char *first, *limit;
+
+    if(start==NULL || length<=0) {
+        return;
+    }
+    pageSize=umap_getPageSize();
+    /* The page containing start. */
+    first=(const char *)start-U_POINTER_MASK_LSB(start, pageSize-1);
+    limit=(const char *)start+length;
+
+#if UMAP_HAVE_MADVISE
+    /* These are hints; ignore failures, e.g., for memory that cannot use huge pages. */
+#   ifdef MADV_HUGEPAGE
+    if(options&UDATA_PREFAULT_HUGEPAGE) {
+        madvise((void *)first, (size_t)(limit-first), MADV_HUGEPAGE);
+    }
+#   endif
+    if(options&UDATA_PREFAULT_WILLNEED) {
+        madvise((void *)first, (size_t)(limit-first), MADV_WILLNEED);
+    }
+#endif
+
+    if(options&UDATA_PREFAULT_TOUCH) {
+        /* Read one byte in each page. The volatile reads cannot be optimized away. */
+        const char *page;
+        (void)*(const volatile char *)start;
+        for(page=first+pageSize; page<limit; page+=pageSize) {
+            (void)*(const volatile char *)page;
+        }
+    }
+}
+
+U_CFUNC int32_t
+uprv_countResidentPages(const void *start, int32_t length,
+                        int32_t *pTotalPages, UErrorCode *pErrorCode) {
+    size_t pageSize, offset;
+    int32_t totalPages;
+
+    if(U_FAILURE(*pErrorCode)) {
+        return 0;
+    }
+    if(start==NULL || length<=0) {
+        totalPages=0;
+    } else {
+        pageSize=umap_getPageSize();
+        offset=(size_t)U_POINTER_MASK_LSB(start, pageSize-1);
+        totalPages=(int32_t)((offset+(size_t)length+pageSize-1)/pageSize);
+    }
+    if(pTotalPages!=NULL) {
+        *pTotalPages=totalPages;
+    }
+    if(totalPages==0) {
+        return 0;
+    }
+
+#if UMAP_HAVE_MADVISE
+    {
+        /* Query mincore() in chunks to bound the size of the result vector. */
+        unsigned char residency[256];
+        char *first=(char *)start-offset;
+        int32_t resident=0, i, j, count;
+        for(i=0; i<totalPages; i+=count) {
+            count=totalPages-i;
+            if(count>(int32_t)sizeof(residency)) {
+                count=(int32_t)sizeof(residency);
+            }
+            if(mincore(first+(size_t)i*pageSize, (size_t)count*pageSize, residency)!=0) {
+                *pErrorCode=U_UNSUPPORTED_ERROR;
+                return 0;
+            }
+            for(j=0; j<count; ++j) {
+                resident+=residency[j]&1;
+            }
+        }
+        return resident;
+    }
+#else
+    *pErrorCode=U_UNSUPPORTED_ERROR;
+    return 0;
+#endif
+}
@@ -32,6 +32,19 @@
 U_CFUNC UBool uprv_mapFile(UDataMemory *pdm, const char *path);
 U_CFUNC void  uprv_unmapFile(UDataMemory *pData);
 
+/**
+ * Applies udata_prefault() options to the memory range [start, start+length[.
+ */
+U_CFUNC void uprv_prefaultMemory(const void *start, int32_t length, uint32_t options);
+
+/**
+ * Counts the resident pages in the memory range [start, start+length[,
+ * and sets *pTotalPages to the number of pages that the range spans.
+ * Sets U_UNSUPPORTED_ERROR where the platform cannot report residency.
+ */
+U_CFUNC int32_t uprv_countResidentPages(const void *start, int32_t length,
+                                        int32_t *pTotalPages, UErrorCode *pErrorCode);
+
 /* MAP_NONE: no memory mapping, no file access at all */
 #define MAP_NONE        0
 #define MAP_WIN32       1
@@ -118,6 +118,17 @@ static int32_t gMaxNameLength=0;
  */
 static uint32_t gNameSet[8]={ 0 };
 
+/*
+ * Hash indexes for u_charFromName(), one per name choice, built on first use.
+ * See the "name index" section below.
+ */
+static uint32_t *gNameIndexes[U_CHAR_NAME_CHOICE_COUNT]={ NULL };
+static uint32_t gNameIndexMasks[U_CHAR_NAME_CHOICE_COUNT]={ 0 };
+static icu::UInitOnce gNameIndexInitOnce[U_CHAR_NAME_CHOICE_COUNT]={
+    U_INITONCE_INITIALIZER, U_INITONCE_INITIALIZER,
+    U_INITONCE_INITIALIZER, U_INITONCE_INITIALIZER
+};
+
 #define U_NONCHARACTER_CODE_POINT U_CHAR_CATEGORY_COUNT
 #define U_LEAD_SURROGATE U_CHAR_CATEGORY_COUNT + 1
 #define U_TRAIL_SURROGATE U_CHAR_CATEGORY_COUNT + 2
@@ -173,6 +184,12 @@ static UBool U_CALLCONV unames_cleanup(void)
     }
     gCharNamesInitOnce.reset();
     gMaxNameLength=0;
+    for(int32_t i=0; i<U_CHAR_NAME_CHOICE_COUNT; ++i) {
+        uprv_free(gNameIndexes[i]);
+        gNameIndexes[i]=NULL;
+        gNameIndexMasks[i]=0;
+        gNameIndexInitOnce[i].reset();
+    }
     return TRUE;
 }
 
@@ -1069,6 +1086,127 @@ enumAlgNames(AlgorithmicRange *range,
     return TRUE;
 }
 
+/* name index ------------------------------------------------------------- */
+
+/*
+ * Without an index, u_charFromName() compares the input with every name
+ * in every group, about 30k names for each lookup.
+ * The index is an open-addressing hash table over the expanded group names
+ * of one name choice. (Algorithmic names are found quickly by findAlgName().)
+ *
+ * Each 32-bit entry holds the code point in its low 21 bits and the top 11 bits
+ * of the name's hash value. A candidate whose hash bits match is confirmed by
+ * expanding its name with getName(), so the table stores no strings.
+ * The table has at least twice as many entries as there are names:
+ * with the Unicode 9 data that is 64k entries or 256kB per name choice,
+ * built in a few milliseconds from the first lookup with that choice.
+ */
+
+#define NAME_INDEX_EMPTY 0xffffffff
+#define NAME_INDEX_CODE_MASK 0x1fffff
+
+/* FNV-1a, which distributes the similar names well */
+static uint32_t
+hashName(const char *name) {
+    uint32_t hash=0x811c9dc5;
+    uint8_t c;
+    while((c=(uint8_t)*name++)!=0) {
+        hash=(hash^c)*0x01000193;
+    }
+    return hash;
+}
+
+static UBool
+isNameIndexMatch(uint32_t entry, uint32_t hash, UCharNameChoice nameChoice, const char *name) {
+    char buffer[200];
+    if(((entry^hash)&~NAME_INDEX_CODE_MASK)!=0) {
+        return FALSE;
+    }
+    getName(uCharNames, entry&NAME_INDEX_CODE_MASK, nameChoice, buffer, sizeof(buffer));
+    return (UBool)(uprv_strcmp(buffer, name)==0);
+}
+
+/*
+ * Builds gNameIndexes[nameChoice]. Leaves it NULL if memory allocation fails,
+ * in which case u_charFromName() falls back to enumerating the names.
+ * Where several code points share a name, the index keeps the lowest one,
+ * as the enumeration would find.
+ */
+static void U_CALLCONV
+buildNameIndex(UCharNameChoice nameChoice) {
+    uint16_t offsets[LINES_PER_GROUP+2], lengths[LINES_PER_GROUP+2];
+    char buffer[200];
+    const uint16_t *groups=GET_GROUPS(uCharNames);
+    uint16_t groupCount=*groups++;
+    uint32_t *table=NULL;
+    uint32_t mask=0;
+    int32_t count=0;
+
+    /* pass 0 counts the names, pass 1 adds them to the table */
+    for(int32_t pass=0; pass<2; ++pass) {
+        const uint16_t *group=groups;
+        for(uint16_t g=0; g<groupCount; ++g, group=NEXT_GROUP(group)) {
+            const uint8_t *s=(uint8_t *)uCharNames+uCharNames->groupStringOffset+GET_GROUP_OFFSET(group);
+            s=expandGroupLengths(s, offsets, lengths);
+            for(uint16_t line=0; line<LINES_PER_GROUP; ++line) {
+                uint16_t length=expandName(uCharNames, s+offsets[line], lengths[line], nameChoice,
+                                           buffer, (uint16_t)sizeof(buffer));
+                if(length==0) {
+                    continue;
+                }
+                if(pass==0) {
+                    ++count;
+                    continue;
+                }
+                uint32_t code=((uint32_t)group[GROUP_MSB]<<GROUP_SHIFT)|line;
+                uint32_t hash=hashName(buffer);
+                uint32_t i=hash&mask;
+                while(table[i]!=NAME_INDEX_EMPTY && !isNameIndexMatch(table[i], hash, nameChoice, buffer)) {
+                    i=(i+1)&mask;
+                }
+                if(table[i]==NAME_INDEX_EMPTY) {
+                    table[i]=(hash&~NAME_INDEX_CODE_MASK)|code;
+                }
+            }
+        }
+        if(pass==0) {
+            uint32_t capacity=64;
+            while(capacity<2*(uint32_t)count) {
+                capacity<<=1;
+            }
+            table=(uint32_t *)uprv_malloc(capacity*4);
+            if(table==NULL) {
+                return;
+            }
+            uprv_memset(table, 0xff, capacity*4);
+            mask=capacity-1;
+        }
+    }
+    gNameIndexMasks[nameChoice]=mask;
+    gNameIndexes[nameChoice]=table;
+}
+
+/*
+ * Looks up a group name in the index.
+ * The name must be uppercase, as in the data.
+ * @return the code point, or -1 if there is no such name
+ */
+static UChar32
+findIndexedName(UCharNameChoice nameChoice, const char *name) {
+    const uint32_t *table=gNameIndexes[nameChoice];
+    uint32_t mask=gNameIndexMasks[nameChoice];
+    uint32_t hash=hashName(name);
+    uint32_t i=hash&mask;
+    uint32_t entry;
+    while((entry=table[i])!=NAME_INDEX_EMPTY) {
+        if(isNameIndexMatch(entry, hash, nameChoice, name)) {
+            return (UChar32)(entry&NAME_INDEX_CODE_MASK);
+        }
+        i=(i+1)&mask;
+    }
+    return -1;
+}
+
 /*
  * findAlgName() is almost the same as enumAlgNames() except that it
  * returns the code point for a name if it fits into the range.
@@ -1615,6 +1753,15 @@ u_charFromName(UCharNameChoice nameChoice,
     }
 
     /* normal character name */
+    umtx_initOnce(gNameIndexInitOnce[nameChoice], &buildNameIndex, nameChoice);
+    if(gNameIndexes[nameChoice]!=NULL) {
+        cp=findIndexedName(nameChoice, upper);
+        if(cp<0) {
+            *pErrorCode=U_ILLEGAL_CHAR_FOUND;
+            return error;
+        }
+        return cp;
+    }
     findName.otherName=upper;
     findName.code=error;
     enumNames(uCharNames, 0, UCHAR_MAX_VALUE + 1, DO_FIND_NAME, &findName, nameChoice);
@@ -384,6 +384,57 @@ public:
     virtual int32_t
     spanQuickCheckYes(const UnicodeString &s, UErrorCode &errorCode) const = 0;
 
+    /* Cannot use #ifndef U_HIDE_DRAFT_API for the following draft methods since they are virtual. */
+    /**
+     * Normalizes a UTF-8 string and writes the result to the sink.
+     * Runs of text that are already normalized are appended to the sink
+     * as they are, without conversion to UTF-16.
+     * Ill-formed UTF-8 sequences are copied unchanged by ICU's own normalizers;
+     * the default implementation, which converts via UTF-16,
+     * replaces them with U+FFFD.
+     * @param src source UTF-8 string
+     * @param sink output sink
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     * @draft ICU 58
+     */
+    virtual void
+    normalizeUTF8(StringPiece src, ByteSink &sink, UErrorCode &errorCode) const;
+
+    /**
+     * Tests if the UTF-8 string is normalized.
+     * Like isNormalized() but without conversion to UTF-16.
+     * Ill-formed UTF-8 sequences are treated as inert.
+     * @param s UTF-8 input string
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     * @return TRUE if s is normalized
+     * @draft ICU 58
+     */
+    virtual UBool
+    isNormalizedUTF8(StringPiece s, UErrorCode &errorCode) const;
+
+    /**
+     * Returns the end of the normalized UTF-8 substring of the input string,
+     * like spanQuickCheckYes() but without conversion to UTF-16.
+     * The result is a byte index into s at a code point boundary
+     * and at a normalization boundary.
+     * Ill-formed UTF-8 sequences are treated as inert.
+     * @param s UTF-8 input string
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     * @return "yes" span end index in bytes
+     * @draft ICU 58
+     */
+    virtual int32_t
+    spanQuickCheckYesUTF8(StringPiece s, UErrorCode &errorCode) const;
+
     /**
      * Tests if the character always has a normalization boundary before it,
      * regardless of context.
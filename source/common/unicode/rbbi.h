@@ -42,6 +42,7 @@ class  RuleBasedBreakIteratorTables;
 class  BreakIterator;
 class  RBBIDataWrapper;
 class  UStack;
+class  UVector32;
 class  LanguageBreakEngine;
 class  UnhandledEngine;
 struct RBBIStateTable;
@@ -138,6 +139,39 @@ private:
      */
     int32_t             fPositionInCache;
 
+    /**
+     * Size of the boundary cache, below.  A power of two.
+     * @internal
+     */
+    enum { kBoundaryCacheSize = 128 };
+
+    /**
+     * The boundary cache: a ring buffer holding a run of consecutive boundaries,
+     * in ascending order, that were found by earlier operations.  It grows
+     * in either direction as the iterator moves, and lets next(), previous(),
+     * following(), preceding() and isBoundary() near recently visited text
+     * return without running the state machine again.
+     * The current iteration position is always one of its entries.
+     * @internal
+     */
+    int32_t             fBoundaries[kBoundaryCacheSize];
+
+    /**
+     * For each entry in fBoundaries, the index of its rule status values,
+     * or -1 if it has not been determined yet.
+     * @internal
+     */
+    int32_t             fStatuses[kBoundaryCacheSize];
+
+    /**
+     * Indexes in fBoundaries of the first and last cached boundaries,
+     * and of the current iteration position.
+     * @internal
+     */
+    int32_t             fStartBufIdx;
+    int32_t             fEndBufIdx;
+    int32_t             fBufIdx;
+
     /**
      *
      * If present, UStack of LanguageBreakEngine objects that might handle
@@ -535,6 +569,69 @@ public:
     */
     virtual int32_t getRuleStatusVec(int32_t *fillInVec, int32_t capacity, UErrorCode &status);
 
+    /* Cannot use #ifndef U_HIDE_DRAFT_API for the following draft method since it is virtual. */
+    /**
+     * Advance the iterator over up to capacity boundaries in one call, storing
+     * the boundary positions, and optionally their rule status values, into
+     * arrays provided by the caller.  The results are the same as from calling
+     * <code>next()</code> and <code>getRuleStatus()</code> repeatedly, without the
+     * per-boundary call overhead.
+     * <p>
+     * The first boundary stored is the one following the current position, so
+     * after <code>first()</code> the start of the text is not included.
+     * The iterator is left at the last boundary stored.  To enumerate all of the
+     * boundaries of a text, call repeatedly until the return value is less than
+     * capacity.
+     *
+     * @param offsets   an array to be filled in with the boundary positions.
+     * @param statuses  an array to be filled in with the status value of each
+     *                  boundary, as returned by <code>getRuleStatus()</code>,
+     *                  or NULL if the status values are not wanted.
+     * @param capacity  the length of the supplied arrays.
+     * @param status    receives error codes.
+     * @return          The number of boundaries stored; zero if the iterator
+     *                  is already at the end of the text.
+     * @see next
+     * @see getRuleStatus
+     * @draft ICU 58
+     */
+    virtual int32_t getBoundaries(int32_t *offsets, int32_t *statuses, int32_t capacity,
+                                  UErrorCode &status);
+
+#ifndef U_HIDE_DRAFT_API
+    /**
+     * Like <code>getBoundaries(offsets, statuses, capacity, status)</code>, but
+     * for long texts the work is divided among up to threadCount threads.
+     * <p>
+     * The text following the current position is split into chunks, each starting
+     * at a position found with the safe reverse rules, and each chunk is segmented
+     * by a clone of this iterator on its own thread, including the dictionary-based
+     * segmentation of Thai, CJK and the like.  The chunks are joined at boundaries
+     * that the state machine reached on its own in both of them, from where it
+     * necessarily continues the same way, so the results and the final iterator
+     * position do not depend on the number of threads.
+     * <p>
+     * Short texts are handled on the calling thread.
+     * The text must support shallow cloning with utext_clone().
+     *
+     * @param offsets     an array to be filled in with the boundary positions.
+     * @param statuses    an array to be filled in with the status value of each
+     *                    boundary, as returned by <code>getRuleStatus()</code>,
+     *                    or NULL if the status values are not wanted.
+     * @param capacity    the length of the supplied arrays.
+     * @param threadCount the maximum number of threads to use, including the
+     *                    calling one.  Values <=1 find the boundaries on the
+     *                    calling thread.
+     * @param status      receives error codes.
+     * @return            The number of boundaries stored; zero if the iterator
+     *                    is already at the end of the text.
+     * @see getBoundaries
+     * @draft ICU 58
+     */
+    int32_t getBoundaries(int32_t *offsets, int32_t *statuses, int32_t capacity,
+                          int32_t threadCount, UErrorCode &status);
+#endif  /* U_HIDE_DRAFT_API */
+
     /**
      * Returns a unique class ID POLYMORPHICALLY.  Pure virtual override.
      * This method is to implement a simple version of RTTI, since not all
@@ -684,6 +781,22 @@ private:
      */
     int32_t handleNext(const RBBIStateTable *statetable);
 
+    /**
+     * handlePrevious() for a state table with rows of type RowType,
+     * RBBIStateTableRow or RBBIStateTableRow8.
+     * @internal
+     */
+    template<typename RowType>
+    int32_t handlePreviousRows(const RBBIStateTable *statetable);
+
+    /**
+     * handleNext() for a state table with rows of type RowType,
+     * RBBIStateTableRow or RBBIStateTableRow8.
+     * @internal
+     */
+    template<typename RowType>
+    int32_t handleNextRows(const RBBIStateTable *statetable);
+
 
     /**
      * This is the function that actually implements dictionary-based
@@ -711,10 +824,102 @@ private:
     const LanguageBreakEngine *getLanguageBreakEngine(UChar32 c);
 
     /**
+     * Determines the rule status of the current boundary cache entry,
+     * if it is not yet known.
      *  @internal
      */
     void makeRuleStatusValid();
 
+    /**
+     * The state machine implementations of next(), previous(), following()
+     * and preceding().  They work from the text position of fText, and know
+     * nothing of the boundary cache; only the dictionary cache is used.
+     * @internal
+     */
+    int32_t engineNext();
+    int32_t enginePrevious();
+    int32_t engineFollowing(int32_t offset);
+    int32_t enginePreceding(int32_t offset);
+
+    /**
+     * Moves the state machine to the boundary pos, keeping the dictionary cache
+     * if pos is one of its entries.
+     * @internal
+     */
+    void positionEngine(int32_t pos);
+
+    /**
+     * Empties the boundary cache, leaving only the boundary pos, with the given
+     * rule status index (or -1), as the current iteration position.
+     * @internal
+     */
+    void seedCache(int32_t pos, int32_t statusIndex);
+
+    /**
+     * Adds the boundary following the last cached one to the boundary cache.
+     * @return FALSE if the last cached boundary is the end of the text.
+     * @internal
+     */
+    UBool addFollowing();
+
+    /**
+     * Adds the boundary preceding the first cached one to the boundary cache.
+     * @return FALSE if the first cached boundary is the start of the text.
+     * @internal
+     */
+    UBool addPreceding();
+
+    /**
+     * Starts the boundary cache over, using the safe reverse rules, with boundaries
+     * up to the first one after pos.
+     * @return FALSE if the rules have no safe reverse rules.
+     * @internal
+     */
+    UBool seedCacheNear(int32_t pos);
+
+    /**
+     * If pos is in or near the range of the boundary cache, extends the cache
+     * to cover pos and sets the current position to the last boundary at or
+     * before pos.
+     * @return FALSE, leaving the cache unchanged, if pos is too far away.
+     * @internal
+     */
+    UBool seekCache(int32_t pos);
+
+    /**
+     * TRUE if the state machine found the boundary most recently returned by
+     * engineNext() itself, rather than taking it from the dictionary cache.
+     * The boundaries following such a boundary do not depend on how it was reached.
+     * @internal
+     */
+    UBool isRuleBoundary() const;
+
+    /**
+     * The sequential part of the multi-threaded getBoundaries().  Stores the
+     * boundaries following the current position at offsets[count] and up,
+     * until capacity is reached, or until the current boundary is a rule
+     * boundary at or after limit that is also a rule boundary in sync (if not NULL).
+     * Also stops when the current boundary is past the last one in sync.
+     * @param atRuleBoundary whether the current boundary is known to be a rule
+     *                       boundary; updated on return.
+     * @return the new count
+     * @internal
+     */
+    int32_t appendBoundaries(int32_t *offsets, int32_t *statuses, int32_t count, int32_t capacity,
+                             int32_t limit, const UVector32 *sync, UBool &atRuleBoundary);
+
+    /**
+     * Finds the boundaries of one chunk for the multi-threaded getBoundaries(),
+     * from a safe position at or before start up to the first rule boundary
+     * at or after limit.  Appends (offset, statusIndex<<1 | isRuleBoundary) pairs
+     * to boundaries.
+     * @internal
+     */
+    void findChunkBoundaries(int32_t start, int32_t limit, UVector32 &boundaries, UErrorCode &status);
+
+    /** uprv_runWorkers() function for the multi-threaded getBoundaries(). @internal */
+    static void U_CALLCONV chunkBoundariesWorker(void *context, int32_t workerIndex);
+
 };
 
 //------------------------------------------------------------------------------
@@ -524,6 +524,64 @@ ubrk_getRuleStatus(UBreakIterator *bi);
 U_STABLE  int32_t U_EXPORT2
 ubrk_getRuleStatusVec(UBreakIterator *bi, int32_t *fillInVec, int32_t capacity, UErrorCode *status);
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Advance the break iterator over up to capacity boundaries in one call,
+ * storing the boundary positions, and optionally their rule status values,
+ * into arrays provided by the caller.  The results are the same as from calling
+ * ubrk_next() and ubrk_getRuleStatus() repeatedly, without the per-boundary
+ * call overhead.
+ * <p>
+ * The first boundary stored is the one following the current position, so
+ * after ubrk_first() the start of the text is not included.  The iterator is
+ * left at the last boundary stored.  To enumerate all of the boundaries of a
+ * text, call repeatedly until the return value is less than capacity.
+ * <p>
+ * For word break iterators, the status values are defined in enum UWordBreak.
+ * @param bi        The break iterator to use
+ * @param offsets   an array to be filled in with the boundary positions.
+ * @param statuses  an array to be filled in with the status value of each
+ *                  boundary, as returned by ubrk_getRuleStatus(),
+ *                  or NULL if the status values are not wanted.
+ * @param capacity  the length of the supplied arrays.
+ * @param status    receives error codes.
+ * @return          The number of boundaries stored; zero if the iterator
+ *                  is already at the end of the text.
+ * @draft ICU 58
+ */
+U_DRAFT int32_t U_EXPORT2
+ubrk_getBoundaries(UBreakIterator *bi, int32_t *offsets, int32_t *statuses, int32_t capacity,
+                   UErrorCode *status);
+
+/**
+ * Like ubrk_getBoundaries(), but for long texts the work is divided among up
+ * to threadCount threads.  The text is split into chunks at positions found
+ * with the rules' safe reverse rules, each chunk is segmented on its own
+ * thread, and the chunks are joined such that the results are the same as
+ * from ubrk_getBoundaries(), whatever the number of threads.
+ * <p>
+ * Break iterators that are not rule-based, and short texts, are handled
+ * on the calling thread.
+ * @param bi          The break iterator to use
+ * @param offsets     an array to be filled in with the boundary positions.
+ * @param statuses    an array to be filled in with the status value of each
+ *                    boundary, as returned by ubrk_getRuleStatus(),
+ *                    or NULL if the status values are not wanted.
+ * @param capacity    the length of the supplied arrays.
+ * @param threadCount the maximum number of threads to use, including the
+ *                    calling one.  Values <=1 find the boundaries on the
+ *                    calling thread.
+ * @param status      receives error codes.
+ * @return            The number of boundaries stored; zero if the iterator
+ *                    is already at the end of the text.
+ * @see ubrk_getBoundaries
+ * @draft ICU 58
+ */
+U_DRAFT int32_t U_EXPORT2
+ubrk_getBoundariesParallel(UBreakIterator *bi, int32_t *offsets, int32_t *statuses, int32_t capacity,
+                           int32_t threadCount, UErrorCode *status);
+#endif  /* U_HIDE_DRAFT_API */
+
 /**
  * Return the locale of the break iterator. You can choose between the valid and
  * the actual locale.
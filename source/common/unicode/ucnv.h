@@ -1284,6 +1284,92 @@ ucnv_toUChars(UConverter *cnv,
               const char *src, int32_t srcLength,
               UErrorCode *pErrorCode);
 
+#ifndef U_HIDE_DRAFT_API
+
+/**
+ * Convert many independent Unicode strings into codepage strings with one call,
+ * writing the results one after another into a single destination buffer.
+ * Each string is converted as if by ucnv_fromUChars(), but the converter is
+ * reset only once and after items with errors, and there is no per-item
+ * argument setup or memory allocation.
+ * This is useful for converting many short strings like database fields or protocol headers.
+ *
+ * The results are not NUL-terminated individually; use destIndexes to find them.
+ * The whole output is NUL-terminated if possible, as with ucnv_fromUChars().
+ *
+ * If the output does not fit, then the function continues to count the output length
+ * of all items (preflighting), sets U_BUFFER_OVERFLOW_ERROR
+ * and returns the total length that would be needed.
+ * destIndexes are set for all items in this case as well.
+ *
+ * @param cnv the converter object to be used (ucnv_resetFromUnicode() will be called)
+ * @param dest destination buffer for all of the output, can be NULL if destCapacity==0
+ * @param destCapacity the number of chars available at dest
+ * @param sources array of count input Unicode strings
+ * @param sourceLengths array of count input string lengths, each can be -1 if that
+ *                      string is NUL-terminated; if NULL, then all strings are NUL-terminated
+ * @param count the number of input strings
+ * @param destIndexes if not NULL, an array of count+1 elements that receives the
+ *                    start index in dest of each item's output, and the total output length
+ *                    at destIndexes[count]; item i's output is at
+ *                    dest[destIndexes[i]..destIndexes[i+1][
+ * @param itemErrors if not NULL, an array of count elements that receives the error code
+ *                   for each item; an item with a conversion error keeps the output
+ *                   up to the error and does not stop the batch.
+ *                   If NULL, then the first item error stops the batch and is returned
+ *                   in pErrorCode.
+ * @param pErrorCode normal ICU error code;
+ *                  common error codes that may be set by this function include
+ *                  U_BUFFER_OVERFLOW_ERROR, U_STRING_NOT_TERMINATED_WARNING,
+ *                  U_ILLEGAL_ARGUMENT_ERROR, and (if itemErrors==NULL) conversion errors
+ * @return the total length of the output, not counting the terminating NUL
+ * @see ucnv_fromUChars
+ * @see ucnv_toUCharsBatch
+ * @draft ICU 58
+ */
+U_DRAFT int32_t U_EXPORT2
+ucnv_fromUCharsBatch(UConverter *cnv,
+                     char *dest, int32_t destCapacity,
+                     const UChar *const *sources, const int32_t *sourceLengths, int32_t count,
+                     int32_t *destIndexes, UErrorCode *itemErrors,
+                     UErrorCode *pErrorCode);
+
+/**
+ * Convert many independent codepage strings into Unicode strings with one call,
+ * writing the results one after another into a single destination buffer.
+ * Same as ucnv_fromUCharsBatch() but in the other direction;
+ * each string is converted as if by ucnv_toUChars().
+ *
+ * @param cnv the converter object to be used (ucnv_resetToUnicode() will be called)
+ * @param dest destination buffer for all of the output, can be NULL if destCapacity==0
+ * @param destCapacity the number of UChars available at dest
+ * @param sources array of count input codepage strings
+ * @param sourceLengths array of count input string lengths, each can be -1 if that
+ *                      string is NUL-terminated; if NULL, then all strings are NUL-terminated
+ * @param count the number of input strings
+ * @param destIndexes if not NULL, an array of count+1 elements that receives the
+ *                    start index in dest of each item's output, and the total output length
+ *                    at destIndexes[count]
+ * @param itemErrors if not NULL, an array of count elements that receives the error code
+ *                   for each item; see ucnv_fromUCharsBatch()
+ * @param pErrorCode normal ICU error code;
+ *                  common error codes that may be set by this function include
+ *                  U_BUFFER_OVERFLOW_ERROR, U_STRING_NOT_TERMINATED_WARNING,
+ *                  U_ILLEGAL_ARGUMENT_ERROR, and (if itemErrors==NULL) conversion errors
+ * @return the total length of the output, not counting the terminating NUL
+ * @see ucnv_toUChars
+ * @see ucnv_fromUCharsBatch
+ * @draft ICU 58
+ */
+U_DRAFT int32_t U_EXPORT2
+ucnv_toUCharsBatch(UConverter *cnv,
+                   UChar *dest, int32_t destCapacity,
+                   const char *const *sources, const int32_t *sourceLengths, int32_t count,
+                   int32_t *destIndexes, UErrorCode *itemErrors,
+                   UErrorCode *pErrorCode);
+
+#endif  /* U_HIDE_DRAFT_API */
+
 /**
  * Convert a codepage buffer into Unicode one character at a time.
  * The input is completely consumed when the U_INDEX_OUTOFBOUNDS_ERROR is set.
@@ -0,0 +1,196 @@
+// Copyright (C) 2016 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+/*
+*******************************************************************************
+*
+*   Copyright (C) 2016, International Business Machines
+*   Corporation and others.  All Rights Reserved.
+*
+*******************************************************************************
+*   file name:  ucnvpool.h
+*   encoding:   US-ASCII
+*   tab size:   8 (not used)
+*   indentation:4
+*/
+
+#ifndef __UCNVPOOL_H__
+#define __UCNVPOOL_H__
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_CONVERSION
+
+#include "unicode/ucnv.h"
+#include "unicode/localpointer.h"
+
+/**
+ * \file
+ * \brief C API: Converter pool
+ *
+ * A converter pool keeps idle UConverter objects around
+ * for reuse, so that code which needs a converter for a short time
+ * (for example, once per request) does not pay for ucnv_open() and ucnv_close()
+ * every time.
+ * Opening a converter allocates memory and takes the global converter
+ * cache mutex; checking out a pooled converter does neither.
+ *
+ * Like a UConverter, a UConverterPool is not thread-safe.
+ * The intended use is one pool per thread, for example stored with
+ * other per-thread or per-worker state, so that there is no contention
+ * between threads at all.
+ *
+ * Converters are keyed by canonical converter name, so that checking out
+ * "Shift_JIS" can reuse a converter that was opened as "sjis".
+ * The pool holds at most a fixed number of converters; when it is full,
+ * the least recently used idle converter is closed to make room,
+ * and if all of the converters are checked out, then additional ones are
+ * opened and closed as usual.
+ *
+ * On check-in, the converter's conversion state is reset and its callbacks,
+ * substitution characters and fallback setting are restored to the values
+ * it had when it was opened.
+ */
+
+#ifndef U_HIDE_DRAFT_API
+
+/**
+ * @{
+ * The converter pool data structure.
+ * @draft ICU 58
+ */
+struct UConverterPool;
+typedef struct UConverterPool UConverterPool;
+/** @} */
+
+/**
+ * Selectors for ucnv_getPoolStatistic().
+ * @draft ICU 58
+ */
+typedef enum UConverterPoolStatistic {
+    /**
+     * Number of ucnv_checkoutConverter() calls.
+     * @draft ICU 58
+     */
+    UCNV_POOL_CHECKOUTS,
+    /**
+     * Number of checkouts that reused a pooled converter
+     * without ucnv_open().
+     * @draft ICU 58
+     */
+    UCNV_POOL_HITS,
+    /**
+     * Number of checkouts that had to open a new converter,
+     * taking the global converter cache mutex and allocating memory.
+     * @draft ICU 58
+     */
+    UCNV_POOL_MISSES,
+    /**
+     * Number of idle converters that were closed to make room for
+     * a converter with a different name.
+     * @draft ICU 58
+     */
+    UCNV_POOL_EVICTIONS,
+    /**
+     * Number of check-ins that closed the converter instead of pooling it,
+     * because it was opened while the pool was full of checked-out converters.
+     * @draft ICU 58
+     */
+    UCNV_POOL_DISCARDS,
+    /**
+     * Current number of converters held by the pool, checked out or idle.
+     * @draft ICU 58
+     */
+    UCNV_POOL_SIZE
+} UConverterPoolStatistic;
+
+/**
+ * Opens an empty converter pool.
+ *
+ * @param capacity the maximum number of converters that the pool holds,
+ *                 checked out or idle; must be at least 1
+ * @param pErrorCode ICU error code
+ * @return the new pool, or NULL if an error occurred
+ * @draft ICU 58
+ */
+U_DRAFT UConverterPool * U_EXPORT2
+ucnv_openPool(int32_t capacity, UErrorCode *pErrorCode);
+
+/**
+ * Closes a converter pool and all of its idle converters.
+ * Converters that are still checked out are closed as well
+ * and must not be used any more.
+ *
+ * @param pool the pool to be closed; can be NULL
+ * @draft ICU 58
+ */
+U_DRAFT void U_EXPORT2
+ucnv_closePool(UConverterPool *pool);
+
+/**
+ * Checks out a converter for the given name from the pool.
+ * Returns an idle pooled converter for the same canonical name if there is one,
+ * otherwise opens a new one like ucnv_open().
+ * The converter must be returned with ucnv_checkinConverter(), not closed.
+ *
+ * @param pool the converter pool
+ * @param name the converter name, as for ucnv_open();
+ *             NULL selects the default converter
+ * @param pErrorCode ICU error code
+ * @return the converter, or NULL if an error occurred
+ * @see ucnv_open
+ * @draft ICU 58
+ */
+U_DRAFT UConverter * U_EXPORT2
+ucnv_checkoutConverter(UConverterPool *pool, const char *name, UErrorCode *pErrorCode);
+
+/**
+ * Returns a converter to the pool.
+ * The converter is reset and its callbacks, substitution characters and
+ * fallback setting are restored, so that the next checkout gets it in the
+ * same state as a newly opened converter.
+ * If the converter is not held by the pool, then it is closed.
+ *
+ * @param pool the converter pool
+ * @param cnv the converter from ucnv_checkoutConverter(); can be NULL
+ * @draft ICU 58
+ */
+U_DRAFT void U_EXPORT2
+ucnv_checkinConverter(UConverterPool *pool, UConverter *cnv);
+
+/**
+ * Returns one of the pool's usage counters.
+ * These measure how well the pool avoids ucnv_open()
+ * and thus the global converter cache mutex and memory allocation.
+ *
+ * @param pool the converter pool
+ * @param which the counter to return
+ * @return the value of the counter, or 0 if which is out of range
+ * @draft ICU 58
+ */
+U_DRAFT int32_t U_EXPORT2
+ucnv_getPoolStatistic(const UConverterPool *pool, UConverterPoolStatistic which);
+
+#if U_SHOW_CPLUSPLUS_API
+
+U_NAMESPACE_BEGIN
+
+/**
+ * \class LocalUConverterPoolPointer
+ * "Smart pointer" class, closes a UConverterPool via ucnv_closePool().
+ * For most methods see the LocalPointerBase base class.
+ *
+ * @see LocalPointerBase
+ * @see LocalPointer
+ * @draft ICU 58
+ */
+U_DEFINE_LOCAL_OPEN_POINTER(LocalUConverterPoolPointer, UConverterPool, ucnv_closePool);
+
+U_NAMESPACE_END
+
+#endif
+
+#endif  /* U_HIDE_DRAFT_API */
+
+#endif  /* !UCONFIG_NO_CONVERSION */
+
+#endif  /* __UCNVPOOL_H__ */
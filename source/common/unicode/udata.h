@@ -432,6 +432,72 @@ typedef enum UDataFileAccess {
 U_STABLE void U_EXPORT2
 udata_setFileAccess(UDataFileAccess access, UErrorCode *status);
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Options for udata_prefault(), combined with bitwise OR.
+ * @see udata_prefault
+ * @draft ICU 58
+ */
+typedef enum UDataPrefaultOption {
+    /**
+     * Asks the operating system to start reading the data item's pages
+     * in the background (madvise(MADV_WILLNEED)).
+     * @draft ICU 58
+     */
+    UDATA_PREFAULT_WILLNEED = 1,
+    /**
+     * Asks the operating system to back the data item with huge pages
+     * where supported (madvise(MADV_HUGEPAGE)), for fewer TLB misses.
+     * @draft ICU 58
+     */
+    UDATA_PREFAULT_HUGEPAGE = 2,
+    /**
+     * Reads every page of the data item before returning, so that later
+     * accesses do not take page faults.
+     * @draft ICU 58
+     */
+    UDATA_PREFAULT_TOUCH = 4
+} UDataPrefaultOption;
+
+/**
+ * Brings the memory of an opened data item into RAM ahead of its use,
+ * for predictable latency of the first access.
+ * ICU shares the memory of a data item among all of the UDataMemory objects
+ * for it. So opening an item like the collation root "ucadata" or a converter
+ * table with udata_open() and prefaulting it also speeds up ICU's own first
+ * use of the item.
+ *
+ * The options are hints. They are ignored where the platform does not
+ * support them, except that UDATA_PREFAULT_TOUCH is supported everywhere.
+ *
+ * @param pData pointer to an opened data item
+ * @param options a combination of UDataPrefaultOption values
+ * @param pErrorCode ICU error code; U_UNSUPPORTED_ERROR if the length
+ *                   of the data item is unknown
+ * @see udata_getResidentPages
+ * @draft ICU 58
+ */
+U_DRAFT void U_EXPORT2
+udata_prefault(const UDataMemory *pData, uint32_t options, UErrorCode *pErrorCode);
+
+/**
+ * Reports how much of an opened data item is currently in RAM.
+ * An access to a page that is not resident takes a page fault.
+ *
+ * @param pData pointer to an opened data item
+ * @param pTotalPages if not NULL, receives the number of memory pages
+ *                    that the data item occupies
+ * @param pErrorCode ICU error code; U_UNSUPPORTED_ERROR if the length
+ *                   of the data item is unknown or if the platform
+ *                   cannot report residency
+ * @return the number of resident pages of the data item
+ * @see udata_prefault
+ * @draft ICU 58
+ */
+U_DRAFT int32_t U_EXPORT2
+udata_getResidentPages(const UDataMemory *pData, int32_t *pTotalPages, UErrorCode *pErrorCode);
+#endif  /* U_HIDE_DRAFT_API */
+
 U_CDECL_END
 
 #endif
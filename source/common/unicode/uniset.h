@@ -1523,6 +1523,29 @@ private:
                       UnicodeSet& (UnicodeSet::*caseClosure)(int32_t attribute),
                       UErrorCode& ec);
 
+    /**
+     * Sets this set to the one parsed from the start of the whole pattern,
+     * sharing parse results through the UnifiedCache, and sets pos to the
+     * end of the parsed text.
+     * Returns FALSE without modifying pos if the cache cannot supply the set,
+     * including when the pattern is malformed;
+     * the caller then parses the pattern itself.
+     */
+    UBool applyPatternFromCache(const UnicodeString& pattern,
+                                ParsePosition& pos,
+                                uint32_t options,
+                                UnicodeSet& (UnicodeSet::*caseClosure)(int32_t attribute),
+                                UErrorCode& status);
+
+    /**
+     * Shares this set, just parsed from pattern[start, limit[,
+     * through the UnifiedCache under that text.
+     */
+    void addPatternToCache(const UnicodeString& pattern, int32_t start, int32_t limit,
+                           uint32_t options);
+
+    friend class UnicodeSetPatternCacheKey;
+
     //----------------------------------------------------------------
     // Implementation: Utility methods
     //----------------------------------------------------------------
@@ -483,6 +483,8 @@
 #define ubrk_first U_ICU_ENTRY_POINT_RENAME(ubrk_first)
 #define ubrk_following U_ICU_ENTRY_POINT_RENAME(ubrk_following)
 #define ubrk_getAvailable U_ICU_ENTRY_POINT_RENAME(ubrk_getAvailable)
+#define ubrk_getBoundaries U_ICU_ENTRY_POINT_RENAME(ubrk_getBoundaries)
+#define ubrk_getBoundariesParallel U_ICU_ENTRY_POINT_RENAME(ubrk_getBoundariesParallel)
 #define ubrk_getLocaleByType U_ICU_ENTRY_POINT_RENAME(ubrk_getLocaleByType)
 #define ubrk_getRuleStatus U_ICU_ENTRY_POINT_RENAME(ubrk_getRuleStatus)
 #define ubrk_getRuleStatusVec U_ICU_ENTRY_POINT_RENAME(ubrk_getRuleStatusVec)
@@ -603,7 +605,10 @@
 #define ucnv_cbFromUWriteUChars U_ICU_ENTRY_POINT_RENAME(ucnv_cbFromUWriteUChars)
 #define ucnv_cbToUWriteSub U_ICU_ENTRY_POINT_RENAME(ucnv_cbToUWriteSub)
 #define ucnv_cbToUWriteUChars U_ICU_ENTRY_POINT_RENAME(ucnv_cbToUWriteUChars)
+#define ucnv_checkinConverter U_ICU_ENTRY_POINT_RENAME(ucnv_checkinConverter)
+#define ucnv_checkoutConverter U_ICU_ENTRY_POINT_RENAME(ucnv_checkoutConverter)
 #define ucnv_close U_ICU_ENTRY_POINT_RENAME(ucnv_close)
+#define ucnv_closePool U_ICU_ENTRY_POINT_RENAME(ucnv_closePool)
 #define ucnv_compareNames U_ICU_ENTRY_POINT_RENAME(ucnv_compareNames)
 #define ucnv_convert U_ICU_ENTRY_POINT_RENAME(ucnv_convert)
 #define ucnv_convertEx U_ICU_ENTRY_POINT_RENAME(ucnv_convertEx)
@@ -626,6 +631,7 @@
 #define ucnv_flushCache U_ICU_ENTRY_POINT_RENAME(ucnv_flushCache)
 #define ucnv_fromAlgorithmic U_ICU_ENTRY_POINT_RENAME(ucnv_fromAlgorithmic)
 #define ucnv_fromUChars U_ICU_ENTRY_POINT_RENAME(ucnv_fromUChars)
+#define ucnv_fromUCharsBatch U_ICU_ENTRY_POINT_RENAME(ucnv_fromUCharsBatch)
 #define ucnv_fromUCountPending U_ICU_ENTRY_POINT_RENAME(ucnv_fromUCountPending)
 #define ucnv_fromUWriteBytes U_ICU_ENTRY_POINT_RENAME(ucnv_fromUWriteBytes)
 #define ucnv_fromUnicode U_ICU_ENTRY_POINT_RENAME(ucnv_fromUnicode)
@@ -648,6 +654,7 @@
 #define ucnv_getNextUChar U_ICU_ENTRY_POINT_RENAME(ucnv_getNextUChar)
 #define ucnv_getNonSurrogateUnicodeSet U_ICU_ENTRY_POINT_RENAME(ucnv_getNonSurrogateUnicodeSet)
 #define ucnv_getPlatform U_ICU_ENTRY_POINT_RENAME(ucnv_getPlatform)
+#define ucnv_getPoolStatistic U_ICU_ENTRY_POINT_RENAME(ucnv_getPoolStatistic)
 #define ucnv_getStandard U_ICU_ENTRY_POINT_RENAME(ucnv_getStandard)
 #define ucnv_getStandardName U_ICU_ENTRY_POINT_RENAME(ucnv_getStandardName)
 #define ucnv_getStarters U_ICU_ENTRY_POINT_RENAME(ucnv_getStarters)
@@ -668,6 +675,7 @@
 #define ucnv_openAllNames U_ICU_ENTRY_POINT_RENAME(ucnv_openAllNames)
 #define ucnv_openCCSID U_ICU_ENTRY_POINT_RENAME(ucnv_openCCSID)
 #define ucnv_openPackage U_ICU_ENTRY_POINT_RENAME(ucnv_openPackage)
+#define ucnv_openPool U_ICU_ENTRY_POINT_RENAME(ucnv_openPool)
 #define ucnv_openStandardNames U_ICU_ENTRY_POINT_RENAME(ucnv_openStandardNames)
 #define ucnv_openU U_ICU_ENTRY_POINT_RENAME(ucnv_openU)
 #define ucnv_reset U_ICU_ENTRY_POINT_RENAME(ucnv_reset)
@@ -684,6 +692,7 @@
 #define ucnv_swapAliases U_ICU_ENTRY_POINT_RENAME(ucnv_swapAliases)
 #define ucnv_toAlgorithmic U_ICU_ENTRY_POINT_RENAME(ucnv_toAlgorithmic)
 #define ucnv_toUChars U_ICU_ENTRY_POINT_RENAME(ucnv_toUChars)
+#define ucnv_toUCharsBatch U_ICU_ENTRY_POINT_RENAME(ucnv_toUCharsBatch)
 #define ucnv_toUCountPending U_ICU_ENTRY_POINT_RENAME(ucnv_toUCountPending)
 #define ucnv_toUWriteCodePoint U_ICU_ENTRY_POINT_RENAME(ucnv_toUWriteCodePoint)
 #define ucnv_toUWriteUChars U_ICU_ENTRY_POINT_RENAME(ucnv_toUWriteUChars)
@@ -724,6 +733,7 @@
 #define ucol_getRulesEx U_ICU_ENTRY_POINT_RENAME(ucol_getRulesEx)
 #define ucol_getShortDefinitionString U_ICU_ENTRY_POINT_RENAME(ucol_getShortDefinitionString)
 #define ucol_getSortKey U_ICU_ENTRY_POINT_RENAME(ucol_getSortKey)
+#define ucol_getSortKeys U_ICU_ENTRY_POINT_RENAME(ucol_getSortKeys)
 #define ucol_getStrength U_ICU_ENTRY_POINT_RENAME(ucol_getStrength)
 #define ucol_getTailoredSet U_ICU_ENTRY_POINT_RENAME(ucol_getTailoredSet)
 #define ucol_getUCAVersion U_ICU_ENTRY_POINT_RENAME(ucol_getUCAVersion)
@@ -734,6 +744,8 @@
 #define ucol_greaterOrEqual U_ICU_ENTRY_POINT_RENAME(ucol_greaterOrEqual)
 #define ucol_keyHashCode U_ICU_ENTRY_POINT_RENAME(ucol_keyHashCode)
 #define ucol_looksLikeCollationBinary U_ICU_ENTRY_POINT_RENAME(ucol_looksLikeCollationBinary)
+#define ucol_mergeSortedRuns U_ICU_ENTRY_POINT_RENAME(ucol_mergeSortedRuns)
+#define ucol_mergeSortedRunsUTF8 U_ICU_ENTRY_POINT_RENAME(ucol_mergeSortedRunsUTF8)
 #define ucol_mergeSortkeys U_ICU_ENTRY_POINT_RENAME(ucol_mergeSortkeys)
 #define ucol_next U_ICU_ENTRY_POINT_RENAME(ucol_next)
 #define ucol_nextSortKeyPart U_ICU_ENTRY_POINT_RENAME(ucol_nextSortKeyPart)
@@ -758,6 +770,8 @@
 #define ucol_setStrength U_ICU_ENTRY_POINT_RENAME(ucol_setStrength)
 #define ucol_setText U_ICU_ENTRY_POINT_RENAME(ucol_setText)
 #define ucol_setVariableTop U_ICU_ENTRY_POINT_RENAME(ucol_setVariableTop)
+#define ucol_sortStrings U_ICU_ENTRY_POINT_RENAME(ucol_sortStrings)
+#define ucol_sortStringsUTF8 U_ICU_ENTRY_POINT_RENAME(ucol_sortStringsUTF8)
 #define ucol_strcoll U_ICU_ENTRY_POINT_RENAME(ucol_strcoll)
 #define ucol_strcollIter U_ICU_ENTRY_POINT_RENAME(ucol_strcollIter)
 #define ucol_strcollUTF8 U_ICU_ENTRY_POINT_RENAME(ucol_strcollUTF8)
@@ -841,10 +855,13 @@
 #define udata_getLength U_ICU_ENTRY_POINT_RENAME(udata_getLength)
 #define udata_getMemory U_ICU_ENTRY_POINT_RENAME(udata_getMemory)
 #define udata_getRawMemory U_ICU_ENTRY_POINT_RENAME(udata_getRawMemory)
+#define udata_getResidentPages U_ICU_ENTRY_POINT_RENAME(udata_getResidentPages)
+#define udata_hashTOCEntryName U_ICU_ENTRY_POINT_RENAME(udata_hashTOCEntryName)
 #define udata_open U_ICU_ENTRY_POINT_RENAME(udata_open)
 #define udata_openChoice U_ICU_ENTRY_POINT_RENAME(udata_openChoice)
 #define udata_openSwapper U_ICU_ENTRY_POINT_RENAME(udata_openSwapper)
 #define udata_openSwapperForInputData U_ICU_ENTRY_POINT_RENAME(udata_openSwapperForInputData)
+#define udata_prefault U_ICU_ENTRY_POINT_RENAME(udata_prefault)
 #define udata_printError U_ICU_ENTRY_POINT_RENAME(udata_printError)
 #define udata_readInt16 U_ICU_ENTRY_POINT_RENAME(udata_readInt16)
 #define udata_readInt32 U_ICU_ENTRY_POINT_RENAME(udata_readInt32)
@@ -1105,6 +1122,7 @@
 #define umtx_condWait U_ICU_ENTRY_POINT_RENAME(umtx_condWait)
 #define umtx_lock U_ICU_ENTRY_POINT_RENAME(umtx_lock)
 #define umtx_unlock U_ICU_ENTRY_POINT_RENAME(umtx_unlock)
+#define uniset_getPatternCacheCounts U_ICU_ENTRY_POINT_RENAME(uniset_getPatternCacheCounts)
 #define uniset_getUnicode32Instance U_ICU_ENTRY_POINT_RENAME(uniset_getUnicode32Instance)
 #define unorm2_append U_ICU_ENTRY_POINT_RENAME(unorm2_append)
 #define unorm2_close U_ICU_ENTRY_POINT_RENAME(unorm2_close)
@@ -1322,6 +1340,7 @@
 #define uprv_getRawUTCtime U_ICU_ENTRY_POINT_RENAME(uprv_getRawUTCtime)
 #define uprv_getStaticCurrencyName U_ICU_ENTRY_POINT_RENAME(uprv_getStaticCurrencyName)
 #define uprv_getUTCtime U_ICU_ENTRY_POINT_RENAME(uprv_getUTCtime)
+#define uprv_getUTF8TextContents U_ICU_ENTRY_POINT_RENAME(uprv_getUTF8TextContents)
 #define uprv_haveProperties U_ICU_ENTRY_POINT_RENAME(uprv_haveProperties)
 #define uprv_int32Comparator U_ICU_ENTRY_POINT_RENAME(uprv_int32Comparator)
 #define uprv_isASCIILetter U_ICU_ENTRY_POINT_RENAME(uprv_isASCIILetter)
@@ -1346,6 +1365,7 @@
 #define uprv_pow10 U_ICU_ENTRY_POINT_RENAME(uprv_pow10)
 #define uprv_realloc U_ICU_ENTRY_POINT_RENAME(uprv_realloc)
 #define uprv_round U_ICU_ENTRY_POINT_RENAME(uprv_round)
+#define uprv_runWorkers U_ICU_ENTRY_POINT_RENAME(uprv_runWorkers)
 #define uprv_sortArray U_ICU_ENTRY_POINT_RENAME(uprv_sortArray)
 #define uprv_stableBinarySearch U_ICU_ENTRY_POINT_RENAME(uprv_stableBinarySearch)
 #define uprv_strCompare U_ICU_ENTRY_POINT_RENAME(uprv_strCompare)
@@ -1428,6 +1448,7 @@
 #define uregex_setStackLimit U_ICU_ENTRY_POINT_RENAME(uregex_setStackLimit)
 #define uregex_setText U_ICU_ENTRY_POINT_RENAME(uregex_setText)
 #define uregex_setTimeLimit U_ICU_ENTRY_POINT_RENAME(uregex_setTimeLimit)
+#define uregex_setUTF8Text U_ICU_ENTRY_POINT_RENAME(uregex_setUTF8Text)
 #define uregex_setUText U_ICU_ENTRY_POINT_RENAME(uregex_setUText)
 #define uregex_split U_ICU_ENTRY_POINT_RENAME(uregex_split)
 #define uregex_splitUText U_ICU_ENTRY_POINT_RENAME(uregex_splitUText)
@@ -1437,6 +1458,10 @@
 #define uregex_useAnchoringBounds U_ICU_ENTRY_POINT_RENAME(uregex_useAnchoringBounds)
 #define uregex_useTransparentBounds U_ICU_ENTRY_POINT_RENAME(uregex_useTransparentBounds)
 #define uregex_utext_unescape_charAt U_ICU_ENTRY_POINT_RENAME(uregex_utext_unescape_charAt)
+#define uregexset_close U_ICU_ENTRY_POINT_RENAME(uregexset_close)
+#define uregexset_find U_ICU_ENTRY_POINT_RENAME(uregexset_find)
+#define uregexset_open U_ICU_ENTRY_POINT_RENAME(uregexset_open)
+#define uregexset_size U_ICU_ENTRY_POINT_RENAME(uregexset_size)
 #define uregion_areEqual U_ICU_ENTRY_POINT_RENAME(uregion_areEqual)
 #define uregion_contains U_ICU_ENTRY_POINT_RENAME(uregion_contains)
 #define uregion_getAvailable U_ICU_ENTRY_POINT_RENAME(uregion_getAvailable)
@@ -1576,6 +1601,7 @@
 #define uset_freeze U_ICU_ENTRY_POINT_RENAME(uset_freeze)
 #define uset_getItem U_ICU_ENTRY_POINT_RENAME(uset_getItem)
 #define uset_getItemCount U_ICU_ENTRY_POINT_RENAME(uset_getItemCount)
+#define uset_getSerializedFrozenSet U_ICU_ENTRY_POINT_RENAME(uset_getSerializedFrozenSet)
 #define uset_getSerializedRange U_ICU_ENTRY_POINT_RENAME(uset_getSerializedRange)
 #define uset_getSerializedRangeCount U_ICU_ENTRY_POINT_RENAME(uset_getSerializedRangeCount)
 #define uset_getSerializedSet U_ICU_ENTRY_POINT_RENAME(uset_getSerializedSet)
@@ -1596,6 +1622,12 @@
 #define uset_retainAll U_ICU_ENTRY_POINT_RENAME(uset_retainAll)
 #define uset_serialize U_ICU_ENTRY_POINT_RENAME(uset_serialize)
 #define uset_serializedContains U_ICU_ENTRY_POINT_RENAME(uset_serializedContains)
+#define uset_serializeFrozen U_ICU_ENTRY_POINT_RENAME(uset_serializeFrozen)
+#define uset_serializedFrozenContains U_ICU_ENTRY_POINT_RENAME(uset_serializedFrozenContains)
+#define uset_serializedFrozenSpan U_ICU_ENTRY_POINT_RENAME(uset_serializedFrozenSpan)
+#define uset_serializedFrozenSpanBack U_ICU_ENTRY_POINT_RENAME(uset_serializedFrozenSpanBack)
+#define uset_serializedFrozenSpanBackUTF8 U_ICU_ENTRY_POINT_RENAME(uset_serializedFrozenSpanBackUTF8)
+#define uset_serializedFrozenSpanUTF8 U_ICU_ENTRY_POINT_RENAME(uset_serializedFrozenSpanUTF8)
 #define uset_set U_ICU_ENTRY_POINT_RENAME(uset_set)
 #define uset_setSerializedToOne U_ICU_ENTRY_POINT_RENAME(uset_setSerializedToOne)
 #define uset_size U_ICU_ENTRY_POINT_RENAME(uset_size)
@@ -1640,9 +1672,13 @@
 #define usprep_openByType U_ICU_ENTRY_POINT_RENAME(usprep_openByType)
 #define usprep_prepare U_ICU_ENTRY_POINT_RENAME(usprep_prepare)
 #define usprep_swap U_ICU_ENTRY_POINT_RENAME(usprep_swap)
+#define ustr_asciiToUChars U_ICU_ENTRY_POINT_RENAME(ustr_asciiToUChars)
 #define ustr_hashCharsN U_ICU_ENTRY_POINT_RENAME(ustr_hashCharsN)
 #define ustr_hashICharsN U_ICU_ENTRY_POINT_RENAME(ustr_hashICharsN)
 #define ustr_hashUCharsN U_ICU_ENTRY_POINT_RENAME(ustr_hashUCharsN)
+#define ustr_latin1ToUChars U_ICU_ENTRY_POINT_RENAME(ustr_latin1ToUChars)
+#define ustr_ucharsToASCII U_ICU_ENTRY_POINT_RENAME(ustr_ucharsToASCII)
+#define ustr_ucharsToLatin1 U_ICU_ENTRY_POINT_RENAME(ustr_ucharsToLatin1)
 #define ustrcase_internalFold U_ICU_ENTRY_POINT_RENAME(ustrcase_internalFold)
 #define ustrcase_internalToLower U_ICU_ENTRY_POINT_RENAME(ustrcase_internalToLower)
 #define ustrcase_internalToTitle U_ICU_ENTRY_POINT_RENAME(ustrcase_internalToTitle)
@@ -1127,4 +1127,139 @@ U_STABLE UBool U_EXPORT2
 uset_getSerializedRange(const USerializedSet* set, int32_t rangeIndex,
                         UChar32* pStart, UChar32* pEnd);
 
+#ifndef U_HIDE_DRAFT_API
+
+/**
+ * A frozen set in the serialized form written by uset_serializeFrozen().
+ * Fill it in with uset_getSerializedFrozenSet(); it aliases the serialized data
+ * and does not own any memory.
+ * The fields are internal.
+ * @draft ICU 58
+ */
+typedef struct USerializedFrozenSet {
+    /** @internal */
+    const void *tables;
+    /** @internal */
+    const int32_t *list;
+    /** @internal */
+    int32_t listLength;
+} USerializedFrozenSet;
+
+/**
+ * Serializes the code points of a set together with the lookup tables
+ * that UnicodeSet::freeze() builds for it.
+ * The serialized form can be used in place, for example from a memory-mapped
+ * file or from a binary resource item, via uset_getSerializedFrozenSet(),
+ * with the speed of a frozen set's contains() and span() functions and
+ * without any heap memory allocation.
+ *
+ * The format consists of 32-bit integers and bytes in platform endianness.
+ * It must be 4-aligned, and it can only be used on platforms with the same
+ * endianness as the one that wrote it.
+ * Strings in the set are ignored.
+ *
+ * @param set the set
+ * @param dest pointer to a 4-aligned buffer of destCapacity bytes.
+ * May be NULL only if destCapacity is zero.
+ * @param destCapacity size of dest in bytes, or zero.  Must not be negative.
+ * @param pErrorCode pointer to the error code.  Will be set to
+ * U_BUFFER_OVERFLOW_ERROR if the serialized form is longer than destCapacity.
+ * @return the length of the serialized form in bytes
+ * @draft ICU 58
+ */
+U_DRAFT int32_t U_EXPORT2
+uset_serializeFrozen(const USet *set, void *dest, int32_t destCapacity, UErrorCode *pErrorCode);
+
+/**
+ * Given data written by uset_serializeFrozen(), fill in the given
+ * serialized frozen set object. The data is not copied; it must remain
+ * valid and unchanged as long as fillSet is used.
+ * @param fillSet pointer to result
+ * @param src pointer to the 4-aligned serialized data
+ * @param srcLength length of the data in bytes, or -1 if the data is trusted
+ * to be at least as long as its internal length field
+ * @param pErrorCode pointer to the error code.  Will be set to
+ * U_INVALID_FORMAT_ERROR if the data is not a valid serialized frozen set,
+ * or if it was written on a platform with different endianness.
+ * If fillSet was not filled, then the uset_serializedFrozen...() functions
+ * treat it as an empty set.
+ * @draft ICU 58
+ */
+U_DRAFT void U_EXPORT2
+uset_getSerializedFrozenSet(USerializedFrozenSet *fillSet, const void *src, int32_t srcLength,
+                            UErrorCode *pErrorCode);
+
+/**
+ * Returns TRUE if the given serialized frozen set contains the given code point.
+ * Same as uset_contains() on the frozen set that was serialized.
+ * @param set the serialized frozen set
+ * @param c The codepoint to check for within the set
+ * @return true if set contains c
+ * @draft ICU 58
+ */
+U_DRAFT UBool U_EXPORT2
+uset_serializedFrozenContains(const USerializedFrozenSet *set, UChar32 c);
+
+/**
+ * Same as uset_span() on the frozen set that was serialized.
+ * @param set the serialized frozen set
+ * @param s start of the string
+ * @param length of the string; can be -1 for NUL-terminated
+ * @param spanCondition specifies the containment condition
+ * @return the length of the initial substring according to the spanCondition;
+ *         0 if the start of the string does not fit the spanCondition
+ * @see uset_span
+ * @draft ICU 58
+ */
+U_DRAFT int32_t U_EXPORT2
+uset_serializedFrozenSpan(const USerializedFrozenSet *set, const UChar *s, int32_t length,
+                          USetSpanCondition spanCondition);
+
+/**
+ * Same as uset_spanBack() on the frozen set that was serialized.
+ * @param set the serialized frozen set
+ * @param s start of the string
+ * @param length of the string; can be -1 for NUL-terminated
+ * @param spanCondition specifies the containment condition
+ * @return the start of the trailing substring according to the spanCondition;
+ *         the string length if the end of the string does not fit the spanCondition
+ * @see uset_spanBack
+ * @draft ICU 58
+ */
+U_DRAFT int32_t U_EXPORT2
+uset_serializedFrozenSpanBack(const USerializedFrozenSet *set, const UChar *s, int32_t length,
+                              USetSpanCondition spanCondition);
+
+/**
+ * Same as uset_spanUTF8() on the frozen set that was serialized.
+ * @param set the serialized frozen set
+ * @param s start of the string (UTF-8)
+ * @param length of the string; can be -1 for NUL-terminated
+ * @param spanCondition specifies the containment condition
+ * @return the length of the initial substring according to the spanCondition;
+ *         0 if the start of the string does not fit the spanCondition
+ * @see uset_spanUTF8
+ * @draft ICU 58
+ */
+U_DRAFT int32_t U_EXPORT2
+uset_serializedFrozenSpanUTF8(const USerializedFrozenSet *set, const char *s, int32_t length,
+                              USetSpanCondition spanCondition);
+
+/**
+ * Same as uset_spanBackUTF8() on the frozen set that was serialized.
+ * @param set the serialized frozen set
+ * @param s start of the string (UTF-8)
+ * @param length of the string; can be -1 for NUL-terminated
+ * @param spanCondition specifies the containment condition
+ * @return the start of the trailing substring according to the spanCondition;
+ *         the string length if the end of the string does not fit the spanCondition
+ * @see uset_spanBackUTF8
+ * @draft ICU 58
+ */
+U_DRAFT int32_t U_EXPORT2
+uset_serializedFrozenSpanBackUTF8(const USerializedFrozenSet *set, const char *s, int32_t length,
+                                  USetSpanCondition spanCondition);
+
+#endif  /* U_HIDE_DRAFT_API */
+
 #endif
@@ -21,6 +21,32 @@ static icu::UnifiedCache *gCache = NULL;
 static icu::SharedObject *gNoValue = NULL;
 static UMutex gCacheMutex = U_MUTEX_INITIALIZER;
 static UConditionVar gInProgressValueAddedCond = U_CONDITION_INITIALIZER;
+
+// Read stripes. Cache hits lock only one of these rather than gCacheMutex.
+// Any code that modifies a hash table must hold gCacheMutex AND every read
+// stripe, so holding either gCacheMutex or any single stripe is enough to
+// read a hash table safely. Each stripe is padded to its own cache line so
+// that readers on different stripes do not share a line.
+#define CACHE_READ_STRIPE_COUNT 16
+
+union CacheReadStripe {
+    UMutex mutex;
+    char padding[64];
+};
+
+#define CACHE_READ_STRIPE_INITIALIZER {U_MUTEX_INITIALIZER}
+
+static CacheReadStripe gCacheReadStripes[CACHE_READ_STRIPE_COUNT] = {
+    CACHE_READ_STRIPE_INITIALIZER, CACHE_READ_STRIPE_INITIALIZER,
+    CACHE_READ_STRIPE_INITIALIZER, CACHE_READ_STRIPE_INITIALIZER,
+    CACHE_READ_STRIPE_INITIALIZER, CACHE_READ_STRIPE_INITIALIZER,
+    CACHE_READ_STRIPE_INITIALIZER, CACHE_READ_STRIPE_INITIALIZER,
+    CACHE_READ_STRIPE_INITIALIZER, CACHE_READ_STRIPE_INITIALIZER,
+    CACHE_READ_STRIPE_INITIALIZER, CACHE_READ_STRIPE_INITIALIZER,
+    CACHE_READ_STRIPE_INITIALIZER, CACHE_READ_STRIPE_INITIALIZER,
+    CACHE_READ_STRIPE_INITIALIZER, CACHE_READ_STRIPE_INITIALIZER
+};
+
 static icu::UInitOnce gCacheInitOnce = U_INITONCE_INITIALIZER;
 static const int32_t MAX_EVICT_ITERATIONS = 10;
 
@@ -68,6 +94,41 @@ ucache_deleteKey(void *obj) {
 CacheKeyBase::~CacheKeyBase() {
 }
 
+// Returns the read stripe for the calling thread.
+// Thread stacks never overlap, so hashing the page address of a local
+// variable spreads concurrent threads across the stripes without needing
+// thread local storage. Any stripe is correct; this only reduces contention.
+static UMutex *getReadStripeMutex() {
+    char marker = 0;
+    uint32_t page = (uint32_t) (((uintptr_t) &marker) >> 12);
+    uint32_t index = (page * 2654435761u) >> 28;
+    U_ASSERT(index < CACHE_READ_STRIPE_COUNT);
+    return &gCacheReadStripes[index].mutex;
+}
+
+/**
+ * Locks all the read stripes for the lifetime of this object so that the
+ * cache hash table may be modified. gCacheMutex must already be held, which
+ * guarantees that only one thread at a time ever waits on more than one
+ * stripe.
+ */
+class CacheWriteLock : public UMemory {
+public:
+    CacheWriteLock() {
+        for (int32_t i = 0; i < CACHE_READ_STRIPE_COUNT; ++i) {
+            umtx_lock(&gCacheReadStripes[i].mutex);
+        }
+    }
+    ~CacheWriteLock() {
+        for (int32_t i = CACHE_READ_STRIPE_COUNT - 1; i >= 0; --i) {
+            umtx_unlock(&gCacheReadStripes[i].mutex);
+        }
+    }
+private:
+    CacheWriteLock(const CacheWriteLock &other);
+    CacheWriteLock &operator=(const CacheWriteLock &other);
+};
+
 static void U_CALLCONV cacheInit(UErrorCode &status) {
     U_ASSERT(gCache == NULL);
     ucln_common_registerCleanup(
@@ -105,6 +166,7 @@ UnifiedCache::UnifiedCache(UErrorCode &status) :
         fHashtable(NULL),
         fEvictPos(UHASH_FIRST),
         fItemsInUseCount(0),
+        fEvictionThreshold(0),
         fMaxUnused(DEFAULT_MAX_UNUSED),
         fMaxPercentageOfInUse(DEFAULT_PERCENTAGE_OF_IN_USE),
         fAutoEvictedCount(0) {
@@ -135,11 +197,12 @@ void UnifiedCache::setEvictionPolicy(
     Mutex lock(&gCacheMutex);
     fMaxUnused = count;
     fMaxPercentageOfInUse = percentageOfInUseItems;
+    _updateEvictionThreshold();
 }
 
 int32_t UnifiedCache::unusedCount() const {
     Mutex lock(&gCacheMutex);
-    return uhash_count(fHashtable) - fItemsInUseCount;
+    return uhash_count(fHashtable) - umtx_loadAcquire(fItemsInUseCount);
 }
 
 int64_t UnifiedCache::autoEvictedCount() const {
@@ -154,6 +217,7 @@ int32_t UnifiedCache::keyCount() const {
 
 void UnifiedCache::flush() const {
     Mutex lock(&gCacheMutex);
+    CacheWriteLock writeLock;
 
     // Use a loop in case cache items that are flushed held hard references to
     // other cache items making those additional cache items eligible for
@@ -216,6 +280,7 @@ UnifiedCache::~UnifiedCache() {
         // each other and entries with hard references from outside the cache. 
         // Nothing we can do about these so proceed to wipe out the cache.
         Mutex lock(&gCacheMutex);
+        CacheWriteLock writeLock;
         _flush(TRUE);
     }
     uhash_close(fHashtable);
@@ -235,7 +300,7 @@ UnifiedCache::_nextElement() const {
 
 // Flushes the contents of the cache. If cache values hold references to other
 // cache values then _flush should be called in a loop until it returns FALSE.
-// On entry, gCacheMutex must be held.
+// On entry, gCacheMutex and all read stripes must be held.
 // On exit, those values with are evictable are flushed. If all is true
 // then every value is flushed even if it is not evictable.
 // Returns TRUE if any value in cache was flushed or FALSE otherwise.
@@ -252,6 +317,7 @@ UBool UnifiedCache::_flush(UBool all) const {
             result = TRUE;
         }
     }
+    _updateEvictionThreshold();
     return result;
 }
 
@@ -260,17 +326,24 @@ UBool UnifiedCache::_flush(UBool all) const {
 // Returns number of items that should be evicted or a value <= 0 if no
 // items need to be evicted.
 int32_t UnifiedCache::_computeCountOfItemsToEvict() const {
+    return _computeCountOfItemsToEvict(umtx_loadAcquire(fItemsInUseCount));
+}
+
+// Computes how many items should be evicted if itemsInUseCount items
+// were in use.
+// On entry, gCacheMutex must be held.
+int32_t UnifiedCache::_computeCountOfItemsToEvict(int32_t itemsInUseCount) const {
     int32_t maxPercentageOfInUseCount =
-            fItemsInUseCount * fMaxPercentageOfInUse / 100;
+            itemsInUseCount * fMaxPercentageOfInUse / 100;
     int32_t maxUnusedCount = fMaxUnused;
     if (maxUnusedCount < maxPercentageOfInUseCount) {
         maxUnusedCount = maxPercentageOfInUseCount;
     }
-    return uhash_count(fHashtable) - fItemsInUseCount - maxUnusedCount;
+    return uhash_count(fHashtable) - itemsInUseCount - maxUnusedCount;
 }
 
 // Run an eviction slice.
-// On entry, gCacheMutex must be held.
+// On entry, gCacheMutex and all read stripes must be held.
 // _runEvictionSlice runs a slice of the evict pipeline by examining the next
 // 10 entries in the cache round robin style evicting them if they are eligible.
 void UnifiedCache::_runEvictionSlice() const {
@@ -291,11 +364,33 @@ void UnifiedCache::_runEvictionSlice() const {
             }
         }
     }
+    _updateEvictionThreshold();
+}
+
+// Sets fEvictionThreshold to the lowest items in use count that needs no
+// eviction, so that releasing a value can tell without a lock whether it
+// may have to evict. The count of items to evict decreases as the items in
+// use count increases.
+// On entry, gCacheMutex must be held, and the hash table or eviction policy
+// must not have changed since without calling this again.
+void UnifiedCache::_updateEvictionThreshold() const {
+    int32_t low = 0;
+    int32_t high = uhash_count(fHashtable);  // never needs eviction
+    while (low < high) {
+        int32_t mid = low + (high - low) / 2;
+        if (_computeCountOfItemsToEvict(mid) <= 0) {
+            high = mid;
+        } else {
+            low = mid + 1;
+        }
+    }
+    umtx_storeRelease(fEvictionThreshold, low);
 }
 
 
 // Places a new value and creationStatus in the cache for the given key.
-// On entry, gCacheMutex must be held. key must not exist in the cache. 
+// On entry, gCacheMutex and all read stripes must be held. key must not exist
+// in the cache.
 // On exit, value and creation status placed under key. Soft reference added
 // to value on successful add. On error sets status.
 void UnifiedCache::_putNew(
@@ -319,6 +414,7 @@ void UnifiedCache::_putNew(
     if (U_SUCCESS(status)) {
         value->addSoftRef();
     }
+    _updateEvictionThreshold();
 }
 
 // Places value and status at key if there is no value at key or if cache
@@ -335,6 +431,7 @@ void UnifiedCache::_putIfAbsentAndGet(
         const SharedObject *&value,
         UErrorCode &status) const {
     Mutex lock(&gCacheMutex);
+    CacheWriteLock writeLock;
     const UHashElement *element = uhash_find(fHashtable, &key);
     if (element != NULL && !_inProgress(element)) {
         _fetch(element, value, status);
@@ -377,10 +474,43 @@ UBool UnifiedCache::_poll(
         _fetch(element, value, status);
         return TRUE;
     }
+    CacheWriteLock writeLock;
     _putNew(key, gNoValue, U_ZERO_ERROR, status);
     return FALSE;
 }
 
+// Attempts to fetch a completed value and status for key from cache while
+// holding only one read stripe.
+// On entry, gCacheMutex and the read stripes must not be held. value must be
+// NULL and status must be U_ZERO_ERROR.
+// On exit, returns TRUE with value pointing to the fetched value and status
+// set to fetched status, in which case caller must call removeRef() on value.
+// Returns FALSE if key is absent or in progress leaving value and status
+// unchanged; caller should then fall back to _poll().
+UBool UnifiedCache::_pollWithReadStripe(
+        const CacheKeyBase &key,
+        const SharedObject *&value,
+        UErrorCode &status) const {
+    U_ASSERT(value == NULL);
+    U_ASSERT(status == U_ZERO_ERROR);
+    Mutex lock(getReadStripeMutex());
+    const UHashElement *element = uhash_find(fHashtable, &key);
+    if (element == NULL) {
+        return FALSE;
+    }
+    const CacheKeyBase *theKey = (const CacheKeyBase *) element->key.pointer;
+    const SharedObject *theValue =
+            (const SharedObject *) element->value.pointer;
+
+    // Checked without copying theValue so that concurrent hits do not all
+    // touch the reference count of gNoValue.
+    if (_inProgress(theValue, theKey->fCreationStatus)) {
+        return FALSE;
+    }
+    _fetch(element, value, status);
+    return TRUE;
+}
+
 // Gets value out of cache.
 // On entry. gCacheMutex must not be held. value must be NULL. status
 // must be U_ZERO_ERROR.
@@ -397,7 +527,8 @@ void UnifiedCache::_get(
         UErrorCode &status) const {
     U_ASSERT(value == NULL);
     U_ASSERT(status == U_ZERO_ERROR);
-    if (_poll(key, value, status)) {
+    if (_pollWithReadStripe(key, value, status) ||
+            _poll(key, value, status)) {
         if (value == gNoValue) {
             SharedObject::clearPtr(value);
         }
@@ -418,34 +549,47 @@ void UnifiedCache::_get(
     }
 }
 
+// Called on every hard reference 1->0 transition, which follows almost every
+// cache hit, so it takes no lock unless the items in use count is below the
+// eviction threshold. The threshold may be slightly stale; then eviction
+// happens on a later release or insertion instead.
 void UnifiedCache::decrementItemsInUseWithLockingAndEviction() const {
+    if (umtx_atomic_dec(&fItemsInUseCount) >= umtx_loadAcquire(fEvictionThreshold)) {
+        return;
+    }
+    // Recheck: another thread may have evicted or added references meanwhile.
     Mutex mutex(&gCacheMutex);
-    decrementItemsInUse();
-    _runEvictionSlice();
+    if (_computeCountOfItemsToEvict() > 0) {
+        CacheWriteLock writeLock;
+        _runEvictionSlice();
+    }
 }
 
+// Atomic because cache hits add references while holding only a read
+// stripe.
 void UnifiedCache::incrementItemsInUse() const {
-    ++fItemsInUseCount;
+    umtx_atomic_inc(&fItemsInUseCount);
 }
 
 void UnifiedCache::decrementItemsInUse() const {
-    --fItemsInUseCount;
+    umtx_atomic_dec(&fItemsInUseCount);
 }
 
 // Register a master cache entry.
-// On entry, gCacheMutex must be held.
+// On entry, gCacheMutex and all read stripes must be held.
 // On exit, items in use count incremented, entry is marked as a master
 // entry, and value registered with cache so that subsequent calls to
 // addRef() and removeRef() on it correctly updates items in use count
 void UnifiedCache::_registerMaster(
         const CacheKeyBase *theKey, const SharedObject *value) const {
     theKey->fIsMaster = TRUE;
-    ++fItemsInUseCount;
+    umtx_atomic_inc(&fItemsInUseCount);
     value->registerWithCache(this);
 }
 
 // Store a value and error in given hash entry.
-// On entry, gCacheMutex must be held. Hash entry element must be in progress.
+// On entry, gCacheMutex and all read stripes must be held. Hash entry element
+// must be in progress.
 // value must be non NULL.
 // On Exit, soft reference added to value. value and status stored in hash
 // entry. Soft reference removed from previous stored value. Waiting
@@ -494,8 +638,8 @@ UnifiedCache::clearPtr(const SharedObject *&ptr) {
 
 
 // Fetch value and error code from a particular hash entry.
-// On entry, gCacheMutex must be held. value must be either NULL or must be
-// included in the ref count of the object to which it points.
+// On entry, gCacheMutex or a read stripe must be held. value must be either
+// NULL or must be included in the ref count of the object to which it points.
 // On exit, value and status set to what is in the hash entry. Caller must
 // eventually call removeRef on value.
 // If hash entry is in progress, value will be set to gNoValue and status will
@@ -536,7 +680,7 @@ UBool UnifiedCache::_inProgress(
 }
 
 // Determine if given hash entry is eligible for eviction.
-// On entry, gCacheMutex must be held.
+// On entry, gCacheMutex and all read stripes must be held.
 UBool UnifiedCache::_isEvictable(const UHashElement *element) {
     const CacheKeyBase *theKey = (const CacheKeyBase *) element->key.pointer;
     const SharedObject *theValue =
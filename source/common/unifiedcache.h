@@ -177,6 +177,10 @@ class LocaleCacheKey : public CacheKey<T> {
 
 /**
  * The unified cache. A singleton type.
+ * Cache hits lock only one of several read stripes; misses, insertions and
+ * eviction lock a global mutex plus all of the read stripes.
+ * Releasing a value takes no lock unless the number of items in use drops
+ * below the eviction threshold.
  * Design doc here:
  * https://docs.google.com/document/d/1RwGQJs4N4tawNbf809iYDRCvXoMKqDJihxzYt1ysmd8/edit?usp=sharing
  */
@@ -348,7 +352,9 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
  private:
    UHashtable *fHashtable;
    mutable int32_t fEvictPos;
-   mutable int32_t fItemsInUseCount;
+   mutable u_atomic_int32_t fItemsInUseCount;
+   // Eviction is needed while fItemsInUseCount is below this value.
+   mutable u_atomic_int32_t fEvictionThreshold;
    int32_t fMaxUnused;
    int32_t fMaxPercentageOfInUse;
    mutable int64_t fAutoEvictedCount;
@@ -364,6 +370,10 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
            const CacheKeyBase &key,
            const SharedObject *&value,
            UErrorCode &status) const;
+   UBool _pollWithReadStripe(
+           const CacheKeyBase &key,
+           const SharedObject *&value,
+           UErrorCode &status) const;
    void _putNew(
            const CacheKeyBase &key,
            const SharedObject *value,
@@ -375,6 +385,8 @@ class U_COMMON_API UnifiedCache : public UnifiedCacheBase {
            UErrorCode &status) const;
    const UHashElement *_nextElement() const;
    int32_t _computeCountOfItemsToEvict() const;
+   int32_t _computeCountOfItemsToEvict(int32_t itemsInUseCount) const;
+   void _updateEvictionThreshold() const;
    void _runEvictionSlice() const;
    void _registerMaster( 
         const CacheKeyBase *theKey, const SharedObject *value) const;
@@ -97,7 +97,10 @@ UnicodeSet& UnicodeSet::applyPattern(const UnicodeString& pattern,
                                      const SymbolTable* symbols,
                                      UErrorCode& status) {
     ParsePosition pos(0);
-    applyPattern(pattern, pos, options, symbols, status);
+    if (symbols != NULL ||
+            !applyPatternFromCache(pattern, pos, options, &UnicodeSet::closeOver, status)) {
+        applyPattern(pattern, pos, options, symbols, status);
+    }
     if (U_FAILURE(status)) return *this;
 
     int32_t i = pos.getIndex();
@@ -125,6 +128,7 @@ UnicodeSet& UnicodeSet::applyPattern(const UnicodeString& pattern,
         status = U_NO_WRITE_PERMISSION;
         return *this;
     }
+    int32_t start = pos.getIndex();
     // Need to build the pattern in a temporary string because
     // _applyPattern calls add() etc., which set pat to empty.
     UnicodeString rebuiltPat;
@@ -137,6 +141,9 @@ UnicodeSet& UnicodeSet::applyPattern(const UnicodeString& pattern,
         return *this;
     }
     setPattern(rebuiltPat);
+    if (symbols == NULL) {
+        addPatternToCache(pattern, start, pos.getIndex(), options);
+    }
     return *this;
 }
 
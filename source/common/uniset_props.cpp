@@ -46,6 +46,8 @@
 #include "umutex.h"
 #include "uassert.h"
 #include "hash.h"
+#include "sharedobject.h"
+#include "unifiedcache.h"
 
 U_NAMESPACE_USE
 
@@ -277,6 +279,193 @@ uniset_getUnicode32Instance(UErrorCode &errorCode) {
     return uni32Singleton;
 }
 
+// Cache of parsed patterns ------------------------------------------------ ***
+// Pattern parsing recomputes property sets every time, and regular expressions,
+// collation rules etc. parse the same patterns over and over.
+// Parse results for patterns without a symbol table are shared through the
+// UnifiedCache, which also evicts unused entries.
+// A whole pattern is looked up before parsing. A set embedded in longer text
+// is parsed first, because only the parse tells where it ends, and its result
+// is then shared under the text that it consumed.
+
+static u_atomic_int32_t gPatternCacheHits = ATOMIC_INT32_T_INITIALIZER(0);
+static u_atomic_int32_t gPatternCacheMisses = ATOMIC_INT32_T_INITIALIZER(0);
+
+/**
+ * A set parsed from a pattern, shared through the UnifiedCache.
+ * It is only read after creation, so it need not be frozen.
+ */
+class SharedPatternSet : public SharedObject {
+public:
+    SharedPatternSet() : parsedLength(0) {}
+    virtual ~SharedPatternSet();
+
+    UnicodeSet set;
+    /** Number of pattern code units that the parser consumed. */
+    int32_t parsedLength;
+};
+
+SharedPatternSet::~SharedPatternSet() {}
+
+/**
+ * Creation context passed through the UnifiedCache to createObject().
+ * If parse is TRUE, then createObject() parses the key's pattern into set,
+ * otherwise set already contains the parse result.
+ */
+struct PatternCacheContext {
+    UnicodeSet *set;
+    UBool parse;
+    UnicodeSet& (UnicodeSet::*caseClosure)(int32_t attribute);
+    int32_t parsedLength;
+    UBool created;
+};
+
+/**
+ * Cache key for the text of a set pattern and its parsing options.
+ */
+class UnicodeSetPatternCacheKey : public CacheKey<SharedPatternSet> {
+private:
+    UnicodeString fPattern;
+    uint32_t fOptions;
+public:
+    UnicodeSetPatternCacheKey(const UnicodeString &pattern, uint32_t options)
+            : fPattern(pattern), fOptions(options) {}
+    UnicodeSetPatternCacheKey(const UnicodeSetPatternCacheKey &other)
+            : CacheKey<SharedPatternSet>(other),
+              fPattern(other.fPattern), fOptions(other.fOptions) {}
+    virtual ~UnicodeSetPatternCacheKey();
+    virtual int32_t hashCode() const {
+        return (int32_t)(37u * (37u * (uint32_t)CacheKey<SharedPatternSet>::hashCode() +
+                                (uint32_t)fPattern.hashCode()) + fOptions);
+    }
+    virtual UBool operator == (const CacheKeyBase &other) const {
+        // reflexive
+        if (this == &other) {
+            return TRUE;
+        }
+        if (!CacheKey<SharedPatternSet>::operator == (other)) {
+            return FALSE;
+        }
+        // We know that this and other are of the same class because
+        // operator== on CacheKey returned true.
+        const UnicodeSetPatternCacheKey *fOther =
+                static_cast<const UnicodeSetPatternCacheKey *>(&other);
+        return fOptions == fOther->fOptions && fPattern == fOther->fPattern;
+    }
+    virtual CacheKeyBase *clone() const {
+        // The copy constructor copies the text of a read-only alias pattern.
+        return new UnicodeSetPatternCacheKey(*this);
+    }
+    virtual const SharedPatternSet *createObject(
+            const void *creationContext, UErrorCode &status) const;
+};
+
+UnicodeSetPatternCacheKey::~UnicodeSetPatternCacheKey() {}
+
+const SharedPatternSet *
+UnicodeSetPatternCacheKey::createObject(
+        const void *creationContext, UErrorCode &status) const {
+    PatternCacheContext *context = (PatternCacheContext *)creationContext;
+    context->created = TRUE;
+    UnicodeSet &parsed = *context->set;
+    if (context->parse) {
+        // Parse directly into the caller's set, as without the cache.
+        ParsePosition pos(0);
+        UnicodeString rebuiltPat;
+        RuleCharacterIterator chars(fPattern, NULL, pos);
+        parsed.applyPattern(chars, NULL, rebuiltPat, fOptions, context->caseClosure, status);
+        if (U_FAILURE(status)) {
+            return NULL;
+        }
+        parsed.setPattern(rebuiltPat);
+        context->parsedLength = pos.getIndex();
+    }
+    SharedPatternSet *shared = new SharedPatternSet();
+    if (shared == NULL || shared->set.isBogus()) {
+        delete shared;
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+    shared->set.addAll(parsed);
+    if (parsed.pat != NULL) {
+        shared->set.setPattern(UnicodeString(parsed.pat, parsed.patLen));
+    }
+    if (shared->set.isBogus()) {
+        delete shared;
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+    shared->parsedLength = context->parsedLength;
+    shared->addRef();
+    return shared;
+}
+
+UBool
+UnicodeSet::applyPatternFromCache(const UnicodeString& pattern,
+                                  ParsePosition& pos,
+                                  uint32_t options,
+                                  UnicodeSet& (UnicodeSet::*caseClosure)(int32_t attribute),
+                                  UErrorCode& status) {
+    if (U_FAILURE(status) || isFrozen()) {
+        return FALSE;
+    }
+    UErrorCode cacheStatus = U_ZERO_ERROR;
+    const UnifiedCache *cache = UnifiedCache::getInstance(cacheStatus);
+    if (U_FAILURE(cacheStatus)) {
+        return FALSE;
+    }
+    PatternCacheContext context = { this, TRUE, caseClosure, 0, FALSE };
+    const SharedPatternSet *shared = NULL;
+    cache->get(UnicodeSetPatternCacheKey(pattern, options), &context, shared, cacheStatus);
+    umtx_atomic_inc(context.created ? &gPatternCacheMisses : &gPatternCacheHits);
+    if (U_FAILURE(cacheStatus)) {
+        // Let the caller parse the pattern again to report the error
+        // with this set and pos in the same state as without the cache.
+        return FALSE;
+    }
+    if (!context.created) {
+        const UnicodeSet &set = shared->set;
+        clear();
+        addAll(set);
+        if (set.pat != NULL) {
+            setPattern(UnicodeString(set.pat, set.patLen));
+        }
+    }
+    pos.setIndex(shared->parsedLength);
+    shared->removeRef();
+    if (isBogus()) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+    } else if (status == U_ZERO_ERROR) {
+        status = cacheStatus;
+    }
+    return TRUE;
+}
+
+void
+UnicodeSet::addPatternToCache(const UnicodeString& pattern, int32_t start, int32_t limit,
+                              uint32_t options) {
+    UErrorCode cacheStatus = U_ZERO_ERROR;
+    const UnifiedCache *cache = UnifiedCache::getInstance(cacheStatus);
+    if (U_FAILURE(cacheStatus) || isBogus()) {
+        return;
+    }
+    PatternCacheContext context = { this, FALSE, NULL, limit - start, FALSE };
+    const SharedPatternSet *shared = NULL;
+    cache->get(UnicodeSetPatternCacheKey(pattern.tempSubString(start, limit - start), options),
+               &context, shared, cacheStatus);
+    SharedObject::clearPtr(shared);
+}
+
+U_CAPI void U_EXPORT2
+uniset_getPatternCacheCounts(int32_t *hits, int32_t *misses) {
+    if (hits != NULL) {
+        *hits = umtx_loadAcquire(gPatternCacheHits);
+    }
+    if (misses != NULL) {
+        *misses = umtx_loadAcquire(gPatternCacheMisses);
+    }
+}
+
 // helper functions for matching of pattern syntax pieces ------------------ ***
 // these functions are parallel to the PERL_OPEN etc. strings above
 
@@ -354,7 +543,9 @@ UnicodeSet& UnicodeSet::applyPattern(const UnicodeString& pattern,
     //   return applyPattern(pattern, USET_IGNORE_SPACE, NULL, status);
     // but without dependency on closeOver().
     ParsePosition pos(0);
-    applyPatternIgnoreSpace(pattern, pos, NULL, status);
+    if (!applyPatternFromCache(pattern, pos, USET_IGNORE_SPACE, NULL, status)) {
+        applyPatternIgnoreSpace(pattern, pos, NULL, status);
+    }
     if (U_FAILURE(status)) return *this;
 
     int32_t i = pos.getIndex();
@@ -378,6 +569,7 @@ UnicodeSet::applyPatternIgnoreSpace(const UnicodeString& pattern,
         status = U_NO_WRITE_PERMISSION;
         return;
     }
+    int32_t start = pos.getIndex();
     // Need to build the pattern in a temporary string because
     // _applyPattern calls add() etc., which set pat to empty.
     UnicodeString rebuiltPat;
@@ -390,6 +582,9 @@ UnicodeSet::applyPatternIgnoreSpace(const UnicodeString& pattern,
         return;
     }
     setPattern(rebuiltPat);
+    if (symbols == NULL) {
+        addPatternToCache(pattern, start, pos.getIndex(), USET_IGNORE_SPACE);
+    }
 }
 
 /**
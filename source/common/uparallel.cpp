@@ -0,0 +1,121 @@
+// Copyright (C) 2016 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+/*
+*******************************************************************************
+*
+*   Copyright (C) 2016, International Business Machines
+*   Corporation and others.  All Rights Reserved.
+*
+*******************************************************************************
+*   file name:  uparallel.cpp
+*   encoding:   US-ASCII
+*   tab size:   8 (not used)
+*   indentation:4
+*/
+
+#include "unicode/utypes.h"
+#include "cmemory.h"
+#include "umutex.h"  // includes <windows.h> or <pthread.h> as appropriate
+#include "uparallel.h"
+
+namespace {
+
+struct WorkerArgs {
+    UWorkerFn *fn;
+    void *context;
+    int32_t workerIndex;
+};
+
+#if defined(U_USER_MUTEX_H)
+// Unknown threading library: run the workers sequentially.
+#elif U_PLATFORM_HAS_WIN32_API
+
+typedef HANDLE WorkerThread;
+
+DWORD WINAPI
+workerMain(LPVOID param) {
+    WorkerArgs *args = static_cast<WorkerArgs *>(param);
+    args->fn(args->context, args->workerIndex);
+    return 0;
+}
+
+UBool
+startWorker(WorkerThread &thread, WorkerArgs *args) {
+    thread = CreateThread(NULL, 0, workerMain, args, 0, NULL);
+    return thread != NULL;
+}
+
+void
+joinWorker(WorkerThread &thread) {
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+}
+
+#define HAVE_WORKER_THREADS 1
+
+#elif U_PLATFORM_IMPLEMENTS_POSIX
+
+typedef pthread_t WorkerThread;
+
+void *
+workerMain(void *param) {
+    WorkerArgs *args = static_cast<WorkerArgs *>(param);
+    args->fn(args->context, args->workerIndex);
+    return NULL;
+}
+
+UBool
+startWorker(WorkerThread &thread, WorkerArgs *args) {
+    return pthread_create(&thread, NULL, workerMain, args) == 0;
+}
+
+void
+joinWorker(WorkerThread &thread) {
+    pthread_join(thread, NULL);
+}
+
+#define HAVE_WORKER_THREADS 1
+
+#endif
+
+}  // namespace
+
+U_CAPI void U_EXPORT2
+uprv_runWorkers(int32_t workerCount, UWorkerFn *fn, void *context) {
+    if (workerCount <= 0) {
+        return;
+    }
+#ifdef HAVE_WORKER_THREADS
+    if (workerCount > 1) {
+        WorkerArgs *args = (WorkerArgs *)uprv_malloc(workerCount * sizeof(WorkerArgs));
+        WorkerThread *threads = (WorkerThread *)uprv_malloc(workerCount * sizeof(WorkerThread));
+        UBool *started = (UBool *)uprv_malloc(workerCount * sizeof(UBool));
+        if (args != NULL && threads != NULL && started != NULL) {
+            for (int32_t i = 1; i < workerCount; ++i) {
+                args[i].fn = fn;
+                args[i].context = context;
+                args[i].workerIndex = i;
+                started[i] = startWorker(threads[i], args + i);
+            }
+            fn(context, 0);
+            for (int32_t i = 1; i < workerCount; ++i) {
+                if (started[i]) {
+                    joinWorker(threads[i]);
+                } else {
+                    fn(context, i);
+                }
+            }
+            uprv_free(started);
+            uprv_free(threads);
+            uprv_free(args);
+            return;
+        }
+        uprv_free(started);
+        uprv_free(threads);
+        uprv_free(args);
+    }
+#endif
+    for (int32_t i = 0; i < workerCount; ++i) {
+        fn(context, i);
+    }
+}
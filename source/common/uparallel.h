@@ -0,0 +1,52 @@
+// Copyright (C) 2016 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+/*
+*******************************************************************************
+*
+*   Copyright (C) 2016, International Business Machines
+*   Corporation and others.  All Rights Reserved.
+*
+*******************************************************************************
+*   file name:  uparallel.h
+*   encoding:   US-ASCII
+*   tab size:   8 (not used)
+*   indentation:4
+*
+*   Minimal fork/join helper for bulk APIs that let the caller
+*   choose a number of worker threads.
+*/
+
+#ifndef __UPARALLEL_H__
+#define __UPARALLEL_H__
+
+#include "unicode/utypes.h"
+
+/**
+ * Function run by each worker of uprv_runWorkers().
+ * @param context the context pointer passed to uprv_runWorkers()
+ * @param workerIndex 0..workerCount-1
+ * @internal
+ */
+typedef void U_CALLCONV
+UWorkerFn(void *context, int32_t workerIndex);
+
+/**
+ * Calls fn(context, i) for each i in 0..workerCount-1, concurrently,
+ * and returns when all of the calls have returned.
+ * Worker 0 runs on the calling thread, the others on new threads.
+ * If the platform has no thread support known to ICU, or if a thread
+ * cannot be started, then the affected workers run on the calling thread
+ * one after another; the results must not depend on concurrency.
+ *
+ * The workers must not call uprv_runWorkers() themselves and must not
+ * throw exceptions.
+ *
+ * @param workerCount number of workers; nothing happens if <=0
+ * @param fn the worker function
+ * @param context passed through to fn
+ * @internal
+ */
+U_CAPI void U_EXPORT2
+uprv_runWorkers(int32_t workerCount, UWorkerFn *fn, void *context);
+
+#endif
@@ -455,6 +455,17 @@ class UnicodeSet;
 U_CFUNC UnicodeSet *
 uniset_getUnicode32Instance(UErrorCode &errorCode);
 
+/**
+ * Returns how often UnicodeSet pattern parsing found its result in the
+ * pattern cache (hits) and how often it had to parse the pattern (misses),
+ * counted since the library was loaded.
+ * Patterns parsed with a symbol table bypass the cache and are not counted.
+ * Either pointer may be NULL.
+ * @internal
+ */
+U_CAPI void U_EXPORT2
+uniset_getPatternCacheCounts(int32_t *hits, int32_t *misses);
+
 U_NAMESPACE_END
 
 #endif
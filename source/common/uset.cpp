@@ -18,6 +18,8 @@
 *   There are functions to efficiently serialize a USet into an array of uint16_t
 *   and functions to use such a serialized form efficiently without
 *   instantiating a new USet.
+*   The serialized frozen set functions do the same with a form that
+*   includes the frozen set's BMPSet lookup tables.
 */
 
 #include "unicode/utypes.h"
@@ -25,8 +27,10 @@
 #include "unicode/uset.h"
 #include "unicode/uniset.h"
 #include "cmemory.h"
+#include "cstring.h"
 #include "unicode/ustring.h"
 #include "unicode/parsepos.h"
+#include "bmpset.h"
 
 U_NAMESPACE_USE
 
@@ -518,6 +522,196 @@ uset_getSerializedRange(const USerializedSet* set, int32_t rangeIndex,
     }
 }
 
+/*
+ * Serialized frozen set format, see uset_serializeFrozen():
+ *
+ *   int32_t indexes[UFS_IX_COUNT];
+ *   BMPSetTables tables;
+ *   int32_t list[listLength];  // inversion list, ends with 0x110000
+ *
+ * All of the items are 4-aligned. The signature detects data
+ * in the wrong endianness.
+ */
+enum {
+    UFS_IX_SIGNATURE,
+    UFS_IX_FORMAT_VERSION,
+    UFS_IX_TOTAL_LENGTH,  // in bytes
+    UFS_IX_LIST_LENGTH,
+    UFS_IX_COUNT
+};
+
+static const int32_t UFS_SIGNATURE=0x46536574;  // "FSet"
+static const int32_t UFS_FORMAT_VERSION=1;
+static const int32_t UFS_HEADER_LENGTH=(int32_t)(UFS_IX_COUNT*4+sizeof(BMPSetTables));
+
+U_CAPI int32_t U_EXPORT2
+uset_serializeFrozen(const USet *set, void *dest, int32_t destCapacity, UErrorCode *pErrorCode) {
+    if(pErrorCode==NULL || U_FAILURE(*pErrorCode)) {
+        return 0;
+    }
+    if( set==NULL || destCapacity<0 || (dest==NULL && destCapacity>0) ||
+        U_POINTER_MASK_LSB(dest, 3)!=0
+    ) {
+        *pErrorCode=U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+
+    const UnicodeSet &uniset=*(const UnicodeSet *)set;
+    int32_t rangeCount=uniset.getRangeCount();
+    // One list item for the start and one for the limit of each range,
+    // plus the terminator unless the last range ends at U+10FFFF.
+    int32_t listLength=2*rangeCount+1;
+    if(rangeCount>0 && uniset.getRangeEnd(rangeCount-1)==0x10ffff) {
+        --listLength;
+    }
+    int32_t totalLength=UFS_HEADER_LENGTH+listLength*4;
+    if(totalLength>destCapacity) {
+        *pErrorCode=U_BUFFER_OVERFLOW_ERROR;
+        return totalLength;
+    }
+
+    int32_t *indexes=(int32_t *)dest;
+    int32_t *list=(int32_t *)((char *)dest+UFS_HEADER_LENGTH);
+    for(int32_t i=0; i<rangeCount; ++i) {
+        list[2*i]=uniset.getRangeStart(i);
+        list[2*i+1]=uniset.getRangeEnd(i)+1;
+    }
+    list[listLength-1]=0x110000;
+
+    BMPSet bmpSet(list, listLength);
+    uprv_memcpy(indexes+UFS_IX_COUNT, &bmpSet.getTables(), sizeof(BMPSetTables));
+    indexes[UFS_IX_SIGNATURE]=UFS_SIGNATURE;
+    indexes[UFS_IX_FORMAT_VERSION]=UFS_FORMAT_VERSION;
+    indexes[UFS_IX_TOTAL_LENGTH]=totalLength;
+    indexes[UFS_IX_LIST_LENGTH]=listLength;
+    return totalLength;
+}
+
+U_CAPI void U_EXPORT2
+uset_getSerializedFrozenSet(USerializedFrozenSet *fillSet, const void *src, int32_t srcLength,
+                            UErrorCode *pErrorCode) {
+    if(pErrorCode==NULL || U_FAILURE(*pErrorCode)) {
+        return;
+    }
+    if(fillSet==NULL || src==NULL || srcLength<-1 || U_POINTER_MASK_LSB(src, 3)!=0) {
+        *pErrorCode=U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    fillSet->tables=NULL;
+    fillSet->list=NULL;
+    fillSet->listLength=0;
+
+    const int32_t *indexes=(const int32_t *)src;
+    if( (srcLength>=0 && srcLength<UFS_HEADER_LENGTH) ||
+        indexes[UFS_IX_SIGNATURE]!=UFS_SIGNATURE ||
+        indexes[UFS_IX_FORMAT_VERSION]!=UFS_FORMAT_VERSION
+    ) {
+        *pErrorCode=U_INVALID_FORMAT_ERROR;
+        return;
+    }
+    int32_t listLength=indexes[UFS_IX_LIST_LENGTH];
+    if( listLength<1 || listLength>0x110001 ||
+        indexes[UFS_IX_TOTAL_LENGTH]!=UFS_HEADER_LENGTH+listLength*4 ||
+        (srcLength>=0 && srcLength<indexes[UFS_IX_TOTAL_LENGTH])
+    ) {
+        *pErrorCode=U_INVALID_FORMAT_ERROR;
+        return;
+    }
+    const BMPSetTables *tables=(const BMPSetTables *)(indexes+UFS_IX_COUNT);
+    const int32_t *list=(const int32_t *)((const char *)src+UFS_HEADER_LENGTH);
+    if(list[listLength-1]!=0x110000) {
+        *pErrorCode=U_INVALID_FORMAT_ERROR;
+        return;
+    }
+    // The binary searches must stay within the list.
+    int32_t prevStart=0;
+    for(int32_t i=0; i<UPRV_LENGTHOF(tables->list4kStarts); ++i) {
+        int32_t start=tables->list4kStarts[i];
+        if(start<prevStart || start>=listLength) {
+            *pErrorCode=U_INVALID_FORMAT_ERROR;
+            return;
+        }
+        prevStart=start;
+    }
+    fillSet->tables=tables;
+    fillSet->list=list;
+    fillSet->listLength=listLength;
+}
+
+U_CAPI UBool U_EXPORT2
+uset_serializedFrozenContains(const USerializedFrozenSet *set, UChar32 c) {
+    if(set==NULL || set->tables==NULL) {
+        return FALSE;
+    }
+    BMPSet bmpSet((const BMPSetTables *)set->tables, set->list, set->listLength);
+    return bmpSet.contains(c);
+}
+
+U_CAPI int32_t U_EXPORT2
+uset_serializedFrozenSpan(const USerializedFrozenSet *set, const UChar *s, int32_t length,
+                          USetSpanCondition spanCondition) {
+    if(length<0) {
+        length=u_strlen(s);
+    }
+    if(length==0) {
+        return 0;
+    }
+    if(set==NULL || set->tables==NULL) {
+        return 0;
+    }
+    BMPSet bmpSet((const BMPSetTables *)set->tables, set->list, set->listLength);
+    return (int32_t)(bmpSet.span(s, s+length, spanCondition)-s);
+}
+
+U_CAPI int32_t U_EXPORT2
+uset_serializedFrozenSpanBack(const USerializedFrozenSet *set, const UChar *s, int32_t length,
+                              USetSpanCondition spanCondition) {
+    if(length<0) {
+        length=u_strlen(s);
+    }
+    if(length==0) {
+        return 0;
+    }
+    if(set==NULL || set->tables==NULL) {
+        return length;
+    }
+    BMPSet bmpSet((const BMPSetTables *)set->tables, set->list, set->listLength);
+    return (int32_t)(bmpSet.spanBack(s, s+length, spanCondition)-s);
+}
+
+U_CAPI int32_t U_EXPORT2
+uset_serializedFrozenSpanUTF8(const USerializedFrozenSet *set, const char *s, int32_t length,
+                              USetSpanCondition spanCondition) {
+    if(length<0) {
+        length=(int32_t)uprv_strlen(s);
+    }
+    if(length==0) {
+        return 0;
+    }
+    if(set==NULL || set->tables==NULL) {
+        return 0;
+    }
+    BMPSet bmpSet((const BMPSetTables *)set->tables, set->list, set->listLength);
+    const uint8_t *s0=(const uint8_t *)s;
+    return (int32_t)(bmpSet.spanUTF8(s0, length, spanCondition)-s0);
+}
+
+U_CAPI int32_t U_EXPORT2
+uset_serializedFrozenSpanBackUTF8(const USerializedFrozenSet *set, const char *s, int32_t length,
+                                  USetSpanCondition spanCondition) {
+    if(length<0) {
+        length=(int32_t)uprv_strlen(s);
+    }
+    if(length==0) {
+        return 0;
+    }
+    if(set==NULL || set->tables==NULL) {
+        return length;
+    }
+    BMPSet bmpSet((const BMPSetTables *)set->tables, set->list, set->listLength);
+    return bmpSet.spanBackUTF8((const uint8_t *)s, length, spanCondition);
+}
+
 // TODO The old, internal uset.c had an efficient uset_containsOne function.
 // Returned the one and only code point, or else -1 or something.
 // Consider adding such a function to both C and C++ UnicodeSet/uset.
@@ -19,6 +19,7 @@
 
 #include "unicode/utypes.h"
 #include "unicode/uiter.h"
+#include "unicode/utext.h"
 #include "ucase.h"
 
 /** Simple declaration to avoid including unicode/ubrk.h. */
@@ -229,6 +230,16 @@ ustr_hashCharsN(const char *str, int32_t length);
 U_CAPI int32_t U_EXPORT2
 ustr_hashICharsN(const char *str, int32_t length);
 
+/**
+ * Internal API, used by the regular expression matcher for its UTF-8 fast path.
+ * If ut was opened with utext_openUTF8() (or is a clone of such a UText),
+ * returns its UTF-8 string and sets *pLength to the string length in bytes,
+ * determining the length first if the string was NUL-terminated.
+ * Otherwise returns NULL and leaves *pLength unchanged.
+ */
+U_CAPI const char * U_EXPORT2
+uprv_getUTF8TextContents(UText *ut, int32_t *pLength);
+
 /**
  * NUL-terminate a UChar * string if possible.
  * If length  < destCapacity then NUL-terminate.
@@ -265,4 +276,56 @@ u_terminateUChar32s(UChar32 *dest, int32_t destCapacity, int32_t length, UErrorC
 U_CAPI int32_t U_EXPORT2
 u_terminateWChars(wchar_t *dest, int32_t destCapacity, int32_t length, UErrorCode *pErrorCode);
 
+/**
+ * Converts the initial run of ASCII bytes (<=0x7f) from src to UTF-16,
+ * stopping before the first non-ASCII byte or after length bytes.
+ * Uses SIMD instructions where available, many bytes at a time.
+ * NUL bytes are ASCII and are converted like any other byte.
+ *
+ * @param dest Destination buffer with room for at least length UChars.
+ * @param src Source bytes.
+ * @param length Maximum number of bytes to convert.
+ * @return The number of bytes converted, which equals the number of UChars written.
+ */
+U_CAPI int32_t U_EXPORT2
+ustr_asciiToUChars(UChar *dest, const uint8_t *src, int32_t length);
+
+/**
+ * Converts the initial run of ASCII code units (<=0x7f) from src to bytes,
+ * stopping before the first non-ASCII code unit or after length code units.
+ * Same as ustr_asciiToUChars() but in the other direction.
+ *
+ * @param dest Destination buffer with room for at least length bytes.
+ * @param src Source UChars.
+ * @param length Maximum number of UChars to convert.
+ * @return The number of UChars converted, which equals the number of bytes written.
+ */
+U_CAPI int32_t U_EXPORT2
+ustr_ucharsToASCII(uint8_t *dest, const UChar *src, int32_t length);
+
+/**
+ * Converts length ISO-8859-1 bytes from src to UTF-16.
+ * Every byte value maps to the code point with the same value,
+ * so this never stops early.
+ *
+ * @param dest Destination buffer with room for at least length UChars.
+ * @param src Source bytes.
+ * @param length Number of bytes to convert.
+ */
+U_CAPI void U_EXPORT2
+ustr_latin1ToUChars(UChar *dest, const uint8_t *src, int32_t length);
+
+/**
+ * Converts the initial run of Latin-1 code units (<=0xff) from src to bytes,
+ * stopping before the first code unit above 0xff or after length code units.
+ * Same as ustr_ucharsToASCII() but for ISO-8859-1.
+ *
+ * @param dest Destination buffer with room for at least length bytes.
+ * @param src Source UChars.
+ * @param length Maximum number of UChars to convert.
+ * @return The number of UChars converted, which equals the number of bytes written.
+ */
+U_CAPI int32_t U_EXPORT2
+ustr_ucharsToLatin1(uint8_t *dest, const UChar *src, int32_t length);
+
 #endif
@@ -36,6 +36,150 @@
 #include "ustr_imp.h"
 #include "uassert.h"
 
+/*
+ * SSE2 and NEON are part of the base instruction sets of x86-64 and AArch64,
+ * so they are selected at compile time and need no runtime CPU check.
+ * Other platforms use only the scalar loops.
+ */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   include <emmintrin.h>
+#   define USTR_ASCII_SSE2 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#   include <arm_neon.h>
+#   define USTR_ASCII_NEON 1
+#endif
+
+/*
+ * Bulk ASCII and Latin-1 conversion used by the UTF-8 <-> UTF-16 string functions here
+ * and by the UTF-8, Latin-1, US-ASCII and SBCS converters for runs of such text.
+ */
+
+U_CAPI int32_t U_EXPORT2
+ustr_asciiToUChars(UChar *dest, const uint8_t *src, int32_t length) {
+    int32_t i = 0;
+#if USTR_ASCII_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    while ((length - i) >= 16) {
+        __m128i bytes = _mm_loadu_si128((const __m128i *)(src + i));
+        if (_mm_movemask_epi8(bytes) != 0) {
+            break;  /* some byte has its high bit set */
+        }
+        _mm_storeu_si128((__m128i *)(dest + i), _mm_unpacklo_epi8(bytes, zero));
+        _mm_storeu_si128((__m128i *)(dest + i + 8), _mm_unpackhi_epi8(bytes, zero));
+        i += 16;
+    }
+#elif USTR_ASCII_NEON
+    while ((length - i) >= 16) {
+        uint8x16_t bytes = vld1q_u8(src + i);
+        if (vmaxvq_u8(bytes) > 0x7f) {
+            break;
+        }
+        vst1q_u16((uint16_t *)(dest + i), vmovl_u8(vget_low_u8(bytes)));
+        vst1q_u16((uint16_t *)(dest + i + 8), vmovl_high_u8(bytes));
+        i += 16;
+    }
+#endif
+    /* Finish the run one byte at a time. */
+    while (i < length && src[i] <= 0x7f) {
+        dest[i] = (UChar)src[i];
+        ++i;
+    }
+    return i;
+}
+
+U_CAPI int32_t U_EXPORT2
+ustr_ucharsToASCII(uint8_t *dest, const UChar *src, int32_t length) {
+    int32_t i = 0;
+#if USTR_ASCII_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i nonASCIIMask = _mm_set1_epi16((short)0xff80);
+    while ((length - i) >= 16) {
+        __m128i units1 = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i units2 = _mm_loadu_si128((const __m128i *)(src + i + 8));
+        __m128i high = _mm_and_si128(_mm_or_si128(units1, units2), nonASCIIMask);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, zero)) != 0xffff) {
+            break;  /* some code unit is above 0x7f */
+        }
+        _mm_storeu_si128((__m128i *)(dest + i), _mm_packus_epi16(units1, units2));
+        i += 16;
+    }
+#elif USTR_ASCII_NEON
+    while ((length - i) >= 16) {
+        uint16x8_t units1 = vld1q_u16((const uint16_t *)(src + i));
+        uint16x8_t units2 = vld1q_u16((const uint16_t *)(src + i + 8));
+        if (vmaxvq_u16(vorrq_u16(units1, units2)) > 0x7f) {
+            break;
+        }
+        vst1q_u8(dest + i, vcombine_u8(vmovn_u16(units1), vmovn_u16(units2)));
+        i += 16;
+    }
+#endif
+    while (i < length && src[i] <= 0x7f) {
+        dest[i] = (uint8_t)src[i];
+        ++i;
+    }
+    return i;
+}
+
+U_CAPI void U_EXPORT2
+ustr_latin1ToUChars(UChar *dest, const uint8_t *src, int32_t length) {
+    int32_t i = 0;
+#if USTR_ASCII_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    while ((length - i) >= 16) {
+        __m128i bytes = _mm_loadu_si128((const __m128i *)(src + i));
+        _mm_storeu_si128((__m128i *)(dest + i), _mm_unpacklo_epi8(bytes, zero));
+        _mm_storeu_si128((__m128i *)(dest + i + 8), _mm_unpackhi_epi8(bytes, zero));
+        i += 16;
+    }
+#elif USTR_ASCII_NEON
+    while ((length - i) >= 16) {
+        uint8x16_t bytes = vld1q_u8(src + i);
+        vst1q_u16((uint16_t *)(dest + i), vmovl_u8(vget_low_u8(bytes)));
+        vst1q_u16((uint16_t *)(dest + i + 8), vmovl_high_u8(bytes));
+        i += 16;
+    }
+#endif
+    while (i < length) {
+        dest[i] = (UChar)src[i];
+        ++i;
+    }
+}
+
+U_CAPI int32_t U_EXPORT2
+ustr_ucharsToLatin1(uint8_t *dest, const UChar *src, int32_t length) {
+    int32_t i = 0;
+#if USTR_ASCII_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i nonLatin1Mask = _mm_set1_epi16((short)0xff00);
+    while ((length - i) >= 16) {
+        __m128i units1 = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i units2 = _mm_loadu_si128((const __m128i *)(src + i + 8));
+        __m128i high = _mm_and_si128(_mm_or_si128(units1, units2), nonLatin1Mask);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, zero)) != 0xffff) {
+            break;  /* some code unit is above 0xff */
+        }
+        _mm_storeu_si128((__m128i *)(dest + i), _mm_packus_epi16(units1, units2));
+        i += 16;
+    }
+#elif USTR_ASCII_NEON
+    while ((length - i) >= 16) {
+        uint16x8_t units1 = vld1q_u16((const uint16_t *)(src + i));
+        uint16x8_t units2 = vld1q_u16((const uint16_t *)(src + i + 8));
+        if (vmaxvq_u16(vorrq_u16(units1, units2)) > 0xff) {
+            break;
+        }
+        vst1q_u8(dest + i, vcombine_u8(vmovn_u16(units1), vmovn_u16(units2)));
+        i += 16;
+    }
+#endif
+    while (i < length && src[i] <= 0xff) {
+        dest[i] = (uint8_t)src[i];
+        ++i;
+    }
+    return i;
+}
+
 U_CAPI UChar* U_EXPORT2 
 u_strFromUTF32WithSub(UChar *dest,
                int32_t destCapacity,
@@ -569,6 +713,13 @@ u_strFromUTF8WithSub(UChar *dest,
                 if(ch <= 0x7f){
                     *pDest++=(UChar)ch;
                     ++pSrc;
+                    /* Convert the rest of a run of ASCII in bulk. */
+                    if(count > 1 && *pSrc <= 0x7f) {
+                        int32_t asciiLength = ustr_asciiToUChars(pDest, pSrc, count - 1);
+                        pDest += asciiLength;
+                        pSrc += asciiLength;
+                        count -= asciiLength;
+                    }
                 } else {
                     if(ch > 0xe0) {
                         if( /* handle U+1000..U+CFFF inline */
@@ -1111,6 +1262,13 @@ u_strToUTF8WithSub(char *dest,
                 ch=*pSrc++;
                 if(ch <= 0x7f) {
                     *pDest++ = (uint8_t)ch;
+                    /* Convert the rest of a run of ASCII in bulk. */
+                    if(count > 1 && *pSrc <= 0x7f) {
+                        int32_t asciiLength = ustr_ucharsToASCII(pDest, pSrc, count - 1);
+                        pDest += asciiLength;
+                        pSrc += asciiLength;
+                        count -= asciiLength;
+                    }
                 } else if(ch <= 0x7ff) {
                     *pDest++=(uint8_t)((ch>>6)|0xc0);
                     *pDest++=(uint8_t)((ch&0x3f)|0x80);
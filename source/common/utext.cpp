@@ -1645,6 +1645,15 @@ utext_openUTF8(UText *ut, const char *s, int64_t length, UErrorCode *status) {
 
 }
 
+U_CAPI const char * U_EXPORT2
+uprv_getUTF8TextContents(UText *ut, int32_t *pLength) {
+    if (ut == NULL || ut->pFuncs != &utf8Funcs) {
+        return NULL;
+    }
+    *pLength = (int32_t)utf8TextLength(ut);
+    return (const char *)ut->context;
+}
+
 
 
 
@@ -284,6 +284,7 @@ CollationBuilder::parseAndBuild(const UnicodeString &ruleString,
     ownedSettings.fastLatinOptions = CollationFastLatin::getOptions(
         tailoring->data, ownedSettings,
         ownedSettings.fastLatinPrimaries, UPRV_LENGTHOF(ownedSettings.fastLatinPrimaries));
+    CollationFastLatin::setScriptOptions(tailoring->data, ownedSettings);
     tailoring->rules = ruleString;
     tailoring->rules.getTerminatedBuffer();  // ensure NUL-termination
     tailoring->setVersion(base->version, rulesVersion);
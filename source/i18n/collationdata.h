@@ -21,6 +21,7 @@
 #include "unicode/ucol.h"
 #include "unicode/uniset.h"
 #include "collation.h"
+#include "collationfastlatin.h"
 #include "normalizer2impl.h"
 #include "utrie2.h"
 
@@ -63,7 +64,12 @@ struct U_I18N_API CollationData : public UMemory {
               unsafeBackwardSet(NULL),
               fastLatinTable(NULL), fastLatinTableLength(0),
               numScripts(0), scriptsIndex(NULL), scriptStarts(NULL), scriptStartsLength(0),
-              rootElements(NULL), rootElementsLength(0) {}
+              rootElements(NULL), rootElementsLength(0) {
+        for(int32_t i = 0; i < CollationFastLatin::NUM_SCRIPT_BLOCKS; ++i) {
+            fastScriptTables[i] = NULL;
+            fastScriptTableLengths[i] = 0;
+        }
+    }
 
     uint32_t getCE32(UChar32 c) const {
         return UTRIE2_GET32(trie, c);
@@ -214,6 +220,15 @@ struct U_I18N_API CollationData : public UMemory {
     const uint16_t *fastLatinTable;
     int32_t fastLatinTableLength;
 
+    /**
+     * Fast tables for some other scripts, indexed by CollationFastLatin script block.
+     * Same structure as the fastLatinTable, but not serialized:
+     * Built at runtime by CollationFastLatinBuilder::buildScriptTables().
+     * A NULL table means that the block's text takes the normal comparison path.
+     */
+    const uint16_t *fastScriptTables[CollationFastLatin::NUM_SCRIPT_BLOCKS];
+    int32_t fastScriptTableLengths[CollationFastLatin::NUM_SCRIPT_BLOCKS];
+
     /**
      * Data for scripts and reordering groups.
      * Uses include building a reordering permutation table and
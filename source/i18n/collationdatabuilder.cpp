@@ -285,6 +285,9 @@ CollationDataBuilder::CollationDataBuilder(UErrorCode &errorCode)
           modified(FALSE),
           fastLatinEnabled(FALSE), fastLatinBuilder(NULL),
           collIter(NULL) {
+    for(int32_t i = 0; i < CollationFastLatin::NUM_SCRIPT_BLOCKS; ++i) {
+        fastScriptBuilders[i] = NULL;
+    }
     // Reserve the first CE32 for U+0000.
     ce32s.addElement(0, errorCode);
     conditionalCE32s.setDeleter(uprv_deleteConditionalCE32);
@@ -293,6 +296,9 @@ CollationDataBuilder::CollationDataBuilder(UErrorCode &errorCode)
 CollationDataBuilder::~CollationDataBuilder() {
     utrie2_close(trie);
     delete fastLatinBuilder;
+    for(int32_t i = 0; i < CollationFastLatin::NUM_SCRIPT_BLOCKS; ++i) {
+        delete fastScriptBuilders[i];
+    }
     delete collIter;
 }
 
@@ -1502,6 +1508,11 @@ CollationDataBuilder::buildFastLatinTable(CollationData &data, UErrorCode &error
         delete fastLatinBuilder;
         fastLatinBuilder = NULL;
     }
+
+    for(int32_t i = 0; i < CollationFastLatin::NUM_SCRIPT_BLOCKS; ++i) {
+        delete fastScriptBuilders[i];
+    }
+    CollationFastLatinBuilder::buildScriptTables(data, fastScriptBuilders, errorCode);
 }
 
 int32_t
@@ -249,6 +249,7 @@ protected:
 
     UBool fastLatinEnabled;
     CollationFastLatinBuilder *fastLatinBuilder;
+    CollationFastLatinBuilder *fastScriptBuilders[CollationFastLatin::NUM_SCRIPT_BLOCKS];
 
     DataBuilderCollationIterator *collIter;
 };
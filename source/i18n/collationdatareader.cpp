@@ -23,6 +23,7 @@
 #include "collationdata.h"
 #include "collationdatareader.h"
 #include "collationfastlatin.h"
+#include "collationfastlatinbuilder.h"
 #include "collationkeys.h"
 #include "collationrootelements.h"
 #include "collationsettings.h"
@@ -412,18 +413,39 @@ CollationDataReader::read(const CollationTailoring *base, const uint8_t *inBytes
         return;
     }
 
+    // The script tables are not serialized.
+    // Build them from the data, now that it is complete.
+    if(data != NULL && data->fastLatinTable != NULL) {
+        CollationFastLatinBuilder::buildScriptTables(*data, tailoring.fastScriptBuilders, errorCode);
+        if(U_FAILURE(errorCode)) { return; }
+    }
+
     const CollationSettings &ts = *tailoring.settings;
     int32_t options = inIndexes[IX_OPTIONS] & 0xffff;
     uint16_t fastLatinPrimaries[CollationFastLatin::LATIN_LIMIT];
     int32_t fastLatinOptions = CollationFastLatin::getOptions(
             tailoring.data, ts, fastLatinPrimaries, UPRV_LENGTHOF(fastLatinPrimaries));
+    UBool sameFastScriptOptions = TRUE;
+    for(int32_t block = 0; block < CollationFastLatin::NUM_SCRIPT_BLOCKS; ++block) {
+        uint16_t fastScriptPrimaries[CollationFastLatin::LATIN1_LIMIT];
+        int32_t fastScriptOptions = CollationFastLatin::getScriptOptions(
+                tailoring.data, ts, block, fastScriptPrimaries, UPRV_LENGTHOF(fastScriptPrimaries));
+        if(fastScriptOptions != ts.fastScriptOptions[block] ||
+                (fastScriptOptions >= 0 &&
+                    uprv_memcmp(fastScriptPrimaries, ts.fastScriptPrimaries->primaries[block],
+                                sizeof(fastScriptPrimaries)) != 0)) {
+            sameFastScriptOptions = FALSE;
+            break;
+        }
+    }
     if(options == ts.options && ts.variableTop != 0 &&
             reorderCodesLength == ts.reorderCodesLength &&
             uprv_memcmp(reorderCodes, ts.reorderCodes, reorderCodesLength * 4) == 0 &&
             fastLatinOptions == ts.fastLatinOptions &&
             (fastLatinOptions < 0 ||
                 uprv_memcmp(fastLatinPrimaries, ts.fastLatinPrimaries,
-                            sizeof(fastLatinPrimaries)) == 0)) {
+                            sizeof(fastLatinPrimaries)) == 0) &&
+            sameFastScriptOptions) {
         return;
     }
 
@@ -450,6 +472,7 @@ CollationDataReader::read(const CollationTailoring *base, const uint8_t *inBytes
     settings->fastLatinOptions = CollationFastLatin::getOptions(
         tailoring.data, *settings,
         settings->fastLatinPrimaries, UPRV_LENGTHOF(settings->fastLatinPrimaries));
+    CollationFastLatin::setScriptOptions(tailoring.data, *settings);
 }
 
 UBool U_CALLCONV
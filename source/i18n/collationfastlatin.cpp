@@ -19,17 +19,92 @@
 #include "collationdata.h"
 #include "collationfastlatin.h"
 #include "collationsettings.h"
+#include "cmemory.h"
 #include "uassert.h"
 
 U_NAMESPACE_BEGIN
 
+namespace {
+
+const UChar32 scriptBlockStarts[CollationFastLatin::NUM_SCRIPT_BLOCKS] = {
+    0x370, 0x400, 0x3000
+};
+
+const int32_t scriptBlockScripts[CollationFastLatin::NUM_SCRIPT_BLOCKS] = {
+    USCRIPT_GREEK, USCRIPT_CYRILLIC, USCRIPT_HIRAGANA
+};
+
+}  // namespace
+
+UChar32
+CollationFastLatin::getScriptBlockStart(int32_t block) {
+    U_ASSERT(0 <= block && block < NUM_SCRIPT_BLOCKS);
+    return scriptBlockStarts[block];
+}
+
+int32_t
+CollationFastLatin::getScriptBlockScript(int32_t block) {
+    U_ASSERT(0 <= block && block < NUM_SCRIPT_BLOCKS);
+    return scriptBlockScripts[block];
+}
+
 int32_t
 CollationFastLatin::getOptions(const CollationData *data, const CollationSettings &settings,
                                uint16_t *primaries, int32_t capacity) {
-    const uint16_t *table = data->fastLatinTable;
-    if(table == NULL) { return -1; }
     U_ASSERT(capacity == LATIN_LIMIT);
     if(capacity != LATIN_LIMIT) { return -1; }
+    return getTableOptions(data, settings, data->fastLatinTable, USCRIPT_LATIN,
+                           primaries, capacity);
+}
+
+int32_t
+CollationFastLatin::getScriptOptions(const CollationData *data, const CollationSettings &settings,
+                                     int32_t block, uint16_t *primaries, int32_t capacity) {
+    U_ASSERT(capacity == LATIN1_LIMIT);
+    if(capacity != LATIN1_LIMIT) { return -1; }
+    return getTableOptions(data, settings, data->fastScriptTables[block],
+                           getScriptBlockScript(block), primaries, capacity);
+}
+
+void
+CollationFastLatin::setScriptOptions(const CollationData *data, CollationSettings &settings) {
+    uint16_t primaries[NUM_SCRIPT_BLOCKS][LATIN1_LIMIT];
+    UBool anyEnabled = FALSE;
+    for(int32_t block = 0; block < NUM_SCRIPT_BLOCKS; ++block) {
+        settings.fastScriptOptions[block] =
+            getScriptOptions(data, settings, block, primaries[block], LATIN1_LIMIT);
+        if(settings.fastScriptOptions[block] >= 0) {
+            anyEnabled = TRUE;
+        } else {
+            uprv_memset(primaries[block], 0, sizeof(primaries[block]));
+        }
+    }
+    if(!anyEnabled) {
+        SharedObject::clearPtr(settings.fastScriptPrimaries);
+        return;
+    }
+    if(settings.fastScriptPrimaries != NULL &&
+            uprv_memcmp(settings.fastScriptPrimaries->primaries, primaries, sizeof(primaries)) == 0) {
+        return;
+    }
+    CollationFastScriptPrimaries *shared = new CollationFastScriptPrimaries();
+    if(shared == NULL) {
+        // Out of memory: Use the normal comparison path.
+        for(int32_t block = 0; block < NUM_SCRIPT_BLOCKS; ++block) {
+            settings.fastScriptOptions[block] = -1;
+        }
+        SharedObject::clearPtr(settings.fastScriptPrimaries);
+        return;
+    }
+    uprv_memcpy(shared->primaries, primaries, sizeof(primaries));
+    SharedObject::copyPtr(shared, settings.fastScriptPrimaries);
+}
+
+int32_t
+CollationFastLatin::getTableOptions(const CollationData *data, const CollationSettings &settings,
+                                    const uint16_t *table, int32_t script,
+                                    uint16_t *primaries, int32_t capacity) {
+    if(table == NULL) { return -1; }
 
     uint32_t miniVarTop;
     if((settings.options & CollationSettings::ALTERNATE_MASK) == 0) {
@@ -38,6 +113,9 @@ CollationFastLatin::getOptions(const CollationData *data, const CollationSetting
         miniVarTop = MIN_LONG - 1;
     } else {
         int32_t headerLength = *table & 0xff;
+        if(headerLength >= SCRIPT_TABLE_HEADER_LENGTH) {
+            --headerLength;  // The last header unit is the script block start.
+        }
         int32_t i = 1 + settings.getMaxVariable();
         if(i >= headerLength) {
             return -1;  // variableTop >= digits, should not occur
@@ -61,7 +139,7 @@ CollationFastLatin::getOptions(const CollationData *data, const CollationSetting
                 digitStart = start;
             } else if(start != 0) {
                 if(start < prevStart) {
-                    // The permutation affects the groups up to Latin.
+                    // The permutation affects the groups up to the table's letters.
                     return -1;
                 }
                 // In the future, there might be a special group between digits & Latin.
@@ -71,13 +149,15 @@ CollationFastLatin::getOptions(const CollationData *data, const CollationSetting
                 prevStart = start;
             }
         }
-        uint32_t latinStart = data->getFirstPrimaryForGroup(USCRIPT_LATIN);
-        latinStart = settings.reorder(latinStart);
-        if(latinStart < prevStart) {
+        // The letters of a table are all in one script, so only the start of that script
+        // matters, not its position relative to other scripts.
+        uint32_t letterStart = data->getFirstPrimaryForGroup(script);
+        letterStart = settings.reorder(letterStart);
+        if(letterStart < prevStart) {
             return -1;
         }
         if(afterDigitStart == 0) {
-            afterDigitStart = latinStart;
+            afterDigitStart = letterStart;
         }
         if(!(beforeDigitStart < digitStart && digitStart < afterDigitStart)) {
             digitsAreReordered = TRUE;
@@ -85,7 +165,7 @@ CollationFastLatin::getOptions(const CollationData *data, const CollationSetting
     }
 
     table += (table[0] & 0xff);  // skip the header
-    for(UChar32 c = 0; c < LATIN_LIMIT; ++c) {
+    for(UChar32 c = 0; c < capacity; ++c) {
         uint32_t p = table[c];
         if(p >= MIN_SHORT) {
             p &= SHORT_PRIMARY_MASK;
@@ -96,13 +176,17 @@ CollationFastLatin::getOptions(const CollationData *data, const CollationSetting
         }
         primaries[c] = (uint16_t)p;
     }
-    if(digitsAreReordered || (settings.options & CollationSettings::NUMERIC) != 0) {
+    int32_t options = settings.options;
+    if(digitsAreReordered || (options & CollationSettings::NUMERIC) != 0) {
         // Bail out for digits.
         for(UChar32 c = 0x30; c <= 0x39; ++c) { primaries[c] = 0; }
+        // The compare functions bail out for digits only with the numeric option;
+        // otherwise they would fall back to the unreordered table values.
+        options |= CollationSettings::NUMERIC;
     }
 
     // Shift the miniVarTop above other options.
-    return ((int32_t)miniVarTop << 16) | settings.options;
+    return ((int32_t)miniVarTop << 16) | options;
 }
 
 int32_t
@@ -115,6 +199,9 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
     // Keep compareUTF16() and compareUTF8() in sync very closely!
 
     U_ASSERT((table[0] >> 8) == VERSION);
+    // A script table stores only U+0000..U+00FF at their code point indexes.
+    UChar32 blockStart = getTableBlockStart(table);
+    UChar32 directMax = blockStart == 0 ? LATIN_MAX : LATIN1_MAX;
     table += (table[0] & 0xff);  // skip the header
     uint32_t variableTop = (uint32_t)options >> 16;  // see getOptions()
     options &= 0xffff;  // needed for CollationSettings::getStrength() to work
@@ -135,17 +222,19 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                 break;
             }
             UChar32 c = left[leftIndex++];
-            if(c <= LATIN_MAX) {
+            if(c <= directMax) {
                 leftPair = primaries[c];
                 if(leftPair != 0) { break; }
                 if(c <= 0x39 && c >= 0x30 && (options & CollationSettings::NUMERIC) != 0) {
                     return BAIL_OUT_RESULT;
                 }
                 leftPair = table[c];
+            } else if((uint32_t)(c - blockStart) < SCRIPT_BLOCK_LENGTH) {
+                leftPair = table[c - blockStart + LATIN1_LIMIT];  // never for the fast Latin table
             } else if(PUNCT_START <= c && c < PUNCT_LIMIT) {
                 leftPair = table[c - PUNCT_START + LATIN_LIMIT];
             } else {
-                leftPair = lookup(table, c);
+                leftPair = lookup(table, blockStart, c);
             }
             if(leftPair >= MIN_SHORT) {
                 leftPair &= SHORT_PRIMARY_MASK;
@@ -154,7 +243,7 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                 leftPair &= LONG_PRIMARY_MASK;
                 break;
             } else {
-                leftPair = nextPair(table, c, leftPair, left, NULL, leftIndex, leftLength);
+                leftPair = nextPair(table, blockStart, c, leftPair, left, NULL, leftIndex, leftLength);
                 if(leftPair == BAIL_OUT) { return BAIL_OUT_RESULT; }
                 leftPair = getPrimaries(variableTop, leftPair);
             }
@@ -166,17 +255,19 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                 break;
             }
             UChar32 c = right[rightIndex++];
-            if(c <= LATIN_MAX) {
+            if(c <= directMax) {
                 rightPair = primaries[c];
                 if(rightPair != 0) { break; }
                 if(c <= 0x39 && c >= 0x30 && (options & CollationSettings::NUMERIC) != 0) {
                     return BAIL_OUT_RESULT;
                 }
                 rightPair = table[c];
+            } else if((uint32_t)(c - blockStart) < SCRIPT_BLOCK_LENGTH) {
+                rightPair = table[c - blockStart + LATIN1_LIMIT];  // never for the fast Latin table
             } else if(PUNCT_START <= c && c < PUNCT_LIMIT) {
                 rightPair = table[c - PUNCT_START + LATIN_LIMIT];
             } else {
-                rightPair = lookup(table, c);
+                rightPair = lookup(table, blockStart, c);
             }
             if(rightPair >= MIN_SHORT) {
                 rightPair &= SHORT_PRIMARY_MASK;
@@ -185,7 +276,7 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                 rightPair &= LONG_PRIMARY_MASK;
                 break;
             } else {
-                rightPair = nextPair(table, c, rightPair, right, NULL, rightIndex, rightLength);
+                rightPair = nextPair(table, blockStart, c, rightPair, right, NULL, rightIndex, rightLength);
                 if(rightPair == BAIL_OUT) { return BAIL_OUT_RESULT; }
                 rightPair = getPrimaries(variableTop, rightPair);
             }
@@ -222,12 +313,14 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                     break;
                 }
                 UChar32 c = left[leftIndex++];
-                if(c <= LATIN_MAX) {
+                if(c <= directMax) {
                     leftPair = table[c];
+                } else if((uint32_t)(c - blockStart) < SCRIPT_BLOCK_LENGTH) {
+                    leftPair = table[c - blockStart + LATIN1_LIMIT];  // never for the fast Latin table
                 } else if(PUNCT_START <= c && c < PUNCT_LIMIT) {
                     leftPair = table[c - PUNCT_START + LATIN_LIMIT];
                 } else {
-                    leftPair = lookup(table, c);
+                    leftPair = lookup(table, blockStart, c);
                 }
                 if(leftPair >= MIN_SHORT) {
                     leftPair = getSecondariesFromOneShortCE(leftPair);
@@ -236,7 +329,7 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                     leftPair = COMMON_SEC_PLUS_OFFSET;
                     break;
                 } else {
-                    leftPair = nextPair(table, c, leftPair, left, NULL, leftIndex, leftLength);
+                    leftPair = nextPair(table, blockStart, c, leftPair, left, NULL, leftIndex, leftLength);
                     leftPair = getSecondaries(variableTop, leftPair);
                 }
             }
@@ -247,12 +340,14 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                     break;
                 }
                 UChar32 c = right[rightIndex++];
-                if(c <= LATIN_MAX) {
+                if(c <= directMax) {
                     rightPair = table[c];
+                } else if((uint32_t)(c - blockStart) < SCRIPT_BLOCK_LENGTH) {
+                    rightPair = table[c - blockStart + LATIN1_LIMIT];  // never for the fast Latin table
                 } else if(PUNCT_START <= c && c < PUNCT_LIMIT) {
                     rightPair = table[c - PUNCT_START + LATIN_LIMIT];
                 } else {
-                    rightPair = lookup(table, c);
+                    rightPair = lookup(table, blockStart, c);
                 }
                 if(rightPair >= MIN_SHORT) {
                     rightPair = getSecondariesFromOneShortCE(rightPair);
@@ -261,7 +356,7 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                     rightPair = COMMON_SEC_PLUS_OFFSET;
                     break;
                 } else {
-                    rightPair = nextPair(table, c, rightPair, right, NULL, rightIndex, rightLength);
+                    rightPair = nextPair(table, blockStart, c, rightPair, right, NULL, rightIndex, rightLength);
                     rightPair = getSecondaries(variableTop, rightPair);
                 }
             }
@@ -298,9 +393,9 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                     break;
                 }
                 UChar32 c = left[leftIndex++];
-                leftPair = (c <= LATIN_MAX) ? table[c] : lookup(table, c);
+                leftPair = (c <= directMax) ? table[c] : lookup(table, blockStart, c);
                 if(leftPair < MIN_LONG) {
-                    leftPair = nextPair(table, c, leftPair, left, NULL, leftIndex, leftLength);
+                    leftPair = nextPair(table, blockStart, c, leftPair, left, NULL, leftIndex, leftLength);
                 }
                 leftPair = getCases(variableTop, strengthIsPrimary, leftPair);
             }
@@ -311,9 +406,9 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                     break;
                 }
                 UChar32 c = right[rightIndex++];
-                rightPair = (c <= LATIN_MAX) ? table[c] : lookup(table, c);
+                rightPair = (c <= directMax) ? table[c] : lookup(table, blockStart, c);
                 if(rightPair < MIN_LONG) {
-                    rightPair = nextPair(table, c, rightPair, right, NULL, rightIndex, rightLength);
+                    rightPair = nextPair(table, blockStart, c, rightPair, right, NULL, rightIndex, rightLength);
                 }
                 rightPair = getCases(variableTop, strengthIsPrimary, rightPair);
             }
@@ -351,9 +446,9 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                 break;
             }
             UChar32 c = left[leftIndex++];
-            leftPair = (c <= LATIN_MAX) ? table[c] : lookup(table, c);
+            leftPair = (c <= directMax) ? table[c] : lookup(table, blockStart, c);
             if(leftPair < MIN_LONG) {
-                leftPair = nextPair(table, c, leftPair, left, NULL, leftIndex, leftLength);
+                leftPair = nextPair(table, blockStart, c, leftPair, left, NULL, leftIndex, leftLength);
             }
             leftPair = getTertiaries(variableTop, withCaseBits, leftPair);
         }
@@ -364,9 +459,9 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                 break;
             }
             UChar32 c = right[rightIndex++];
-            rightPair = (c <= LATIN_MAX) ? table[c] : lookup(table, c);
+            rightPair = (c <= directMax) ? table[c] : lookup(table, blockStart, c);
             if(rightPair < MIN_LONG) {
-                rightPair = nextPair(table, c, rightPair, right, NULL, rightIndex, rightLength);
+                rightPair = nextPair(table, blockStart, c, rightPair, right, NULL, rightIndex, rightLength);
             }
             rightPair = getTertiaries(variableTop, withCaseBits, rightPair);
         }
@@ -407,9 +502,9 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                 break;
             }
             UChar32 c = left[leftIndex++];
-            leftPair = (c <= LATIN_MAX) ? table[c] : lookup(table, c);
+            leftPair = (c <= directMax) ? table[c] : lookup(table, blockStart, c);
             if(leftPair < MIN_LONG) {
-                leftPair = nextPair(table, c, leftPair, left, NULL, leftIndex, leftLength);
+                leftPair = nextPair(table, blockStart, c, leftPair, left, NULL, leftIndex, leftLength);
             }
             leftPair = getQuaternaries(variableTop, leftPair);
         }
@@ -420,9 +515,9 @@ CollationFastLatin::compareUTF16(const uint16_t *table, const uint16_t *primarie
                 break;
             }
             UChar32 c = right[rightIndex++];
-            rightPair = (c <= LATIN_MAX) ? table[c] : lookup(table, c);
+            rightPair = (c <= directMax) ? table[c] : lookup(table, blockStart, c);
             if(rightPair < MIN_LONG) {
-                rightPair = nextPair(table, c, rightPair, right, NULL, rightIndex, rightLength);
+                rightPair = nextPair(table, blockStart, c, rightPair, right, NULL, rightIndex, rightLength);
             }
             rightPair = getQuaternaries(variableTop, rightPair);
         }
@@ -451,6 +546,9 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
     // Keep compareUTF16() and compareUTF8() in sync very closely!
 
     U_ASSERT((table[0] >> 8) == VERSION);
+    // A script table stores only U+0000..U+00FF at their code point indexes.
+    UChar32 blockStart = getTableBlockStart(table);
+    int32_t directMaxLead = blockStart == 0 ? LATIN_MAX_UTF8_LEAD : LATIN1_MAX_UTF8_LEAD;
     table += (table[0] & 0xff);  // skip the header
     uint32_t variableTop = (uint32_t)options >> 16;  // see RuleBasedCollator::getFastLatinOptions()
     options &= 0xffff;  // needed for CollationSettings::getStrength() to work
@@ -482,7 +580,7 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                     return BAIL_OUT_RESULT;
                 }
                 leftPair = table[c];
-            } else if(c <= LATIN_MAX_UTF8_LEAD && 0xc2 <= c && leftIndex != leftLength &&
+            } else if(c <= directMaxLead && 0xc2 <= c && leftIndex != leftLength &&
                     0x80 <= (t = left[leftIndex]) && t <= 0xbf) {
                 ++leftIndex;
                 c = ((c - 0xc2) << 6) + t;
@@ -490,7 +588,7 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 if(leftPair != 0) { break; }
                 leftPair = table[c];
             } else {
-                leftPair = lookupUTF8(table, c, left, leftIndex, leftLength);
+                leftPair = lookupUTF8(table, blockStart, c, left, leftIndex, leftLength);
             }
             if(leftPair >= MIN_SHORT) {
                 leftPair &= SHORT_PRIMARY_MASK;
@@ -499,7 +597,7 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 leftPair &= LONG_PRIMARY_MASK;
                 break;
             } else {
-                leftPair = nextPair(table, c, leftPair, NULL, left, leftIndex, leftLength);
+                leftPair = nextPair(table, blockStart, c, leftPair, NULL, left, leftIndex, leftLength);
                 if(leftPair == BAIL_OUT) { return BAIL_OUT_RESULT; }
                 leftPair = getPrimaries(variableTop, leftPair);
             }
@@ -519,7 +617,7 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                     return BAIL_OUT_RESULT;
                 }
                 rightPair = table[c];
-            } else if(c <= LATIN_MAX_UTF8_LEAD && 0xc2 <= c && rightIndex != rightLength &&
+            } else if(c <= directMaxLead && 0xc2 <= c && rightIndex != rightLength &&
                     0x80 <= (t = right[rightIndex]) && t <= 0xbf) {
                 ++rightIndex;
                 c = ((c - 0xc2) << 6) + t;
@@ -527,7 +625,7 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 if(rightPair != 0) { break; }
                 rightPair = table[c];
             } else {
-                rightPair = lookupUTF8(table, c, right, rightIndex, rightLength);
+                rightPair = lookupUTF8(table, blockStart, c, right, rightIndex, rightLength);
             }
             if(rightPair >= MIN_SHORT) {
                 rightPair &= SHORT_PRIMARY_MASK;
@@ -536,7 +634,7 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 rightPair &= LONG_PRIMARY_MASK;
                 break;
             } else {
-                rightPair = nextPair(table, c, rightPair, NULL, right, rightIndex, rightLength);
+                rightPair = nextPair(table, blockStart, c, rightPair, NULL, right, rightIndex, rightLength);
                 if(rightPair == BAIL_OUT) { return BAIL_OUT_RESULT; }
                 rightPair = getPrimaries(variableTop, rightPair);
             }
@@ -575,10 +673,10 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 UChar32 c = left[leftIndex++];
                 if(c <= 0x7f) {
                     leftPair = table[c];
-                } else if(c <= LATIN_MAX_UTF8_LEAD) {
+                } else if(c <= directMaxLead) {
                     leftPair = table[((c - 0xc2) << 6) + left[leftIndex++]];
                 } else {
-                    leftPair = lookupUTF8Unsafe(table, c, left, leftIndex);
+                    leftPair = lookupUTF8Unsafe(table, blockStart, c, left, leftIndex);
                 }
                 if(leftPair >= MIN_SHORT) {
                     leftPair = getSecondariesFromOneShortCE(leftPair);
@@ -587,7 +685,7 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                     leftPair = COMMON_SEC_PLUS_OFFSET;
                     break;
                 } else {
-                    leftPair = nextPair(table, c, leftPair, NULL, left, leftIndex, leftLength);
+                    leftPair = nextPair(table, blockStart, c, leftPair, NULL, left, leftIndex, leftLength);
                     leftPair = getSecondaries(variableTop, leftPair);
                 }
             }
@@ -600,10 +698,10 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 UChar32 c = right[rightIndex++];
                 if(c <= 0x7f) {
                     rightPair = table[c];
-                } else if(c <= LATIN_MAX_UTF8_LEAD) {
+                } else if(c <= directMaxLead) {
                     rightPair = table[((c - 0xc2) << 6) + right[rightIndex++]];
                 } else {
-                    rightPair = lookupUTF8Unsafe(table, c, right, rightIndex);
+                    rightPair = lookupUTF8Unsafe(table, blockStart, c, right, rightIndex);
                 }
                 if(rightPair >= MIN_SHORT) {
                     rightPair = getSecondariesFromOneShortCE(rightPair);
@@ -612,7 +710,7 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                     rightPair = COMMON_SEC_PLUS_OFFSET;
                     break;
                 } else {
-                    rightPair = nextPair(table, c, rightPair, NULL, right, rightIndex, rightLength);
+                    rightPair = nextPair(table, blockStart, c, rightPair, NULL, right, rightIndex, rightLength);
                     rightPair = getSecondaries(variableTop, rightPair);
                 }
             }
@@ -649,9 +747,9 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                     break;
                 }
                 UChar32 c = left[leftIndex++];
-                leftPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, c, left, leftIndex);
+                leftPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, blockStart, c, left, leftIndex);
                 if(leftPair < MIN_LONG) {
-                    leftPair = nextPair(table, c, leftPair, NULL, left, leftIndex, leftLength);
+                    leftPair = nextPair(table, blockStart, c, leftPair, NULL, left, leftIndex, leftLength);
                 }
                 leftPair = getCases(variableTop, strengthIsPrimary, leftPair);
             }
@@ -662,9 +760,9 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                     break;
                 }
                 UChar32 c = right[rightIndex++];
-                rightPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, c, right, rightIndex);
+                rightPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, blockStart, c, right, rightIndex);
                 if(rightPair < MIN_LONG) {
-                    rightPair = nextPair(table, c, rightPair, NULL, right, rightIndex, rightLength);
+                    rightPair = nextPair(table, blockStart, c, rightPair, NULL, right, rightIndex, rightLength);
                 }
                 rightPair = getCases(variableTop, strengthIsPrimary, rightPair);
             }
@@ -702,9 +800,9 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 break;
             }
             UChar32 c = left[leftIndex++];
-            leftPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, c, left, leftIndex);
+            leftPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, blockStart, c, left, leftIndex);
             if(leftPair < MIN_LONG) {
-                leftPair = nextPair(table, c, leftPair, NULL, left, leftIndex, leftLength);
+                leftPair = nextPair(table, blockStart, c, leftPair, NULL, left, leftIndex, leftLength);
             }
             leftPair = getTertiaries(variableTop, withCaseBits, leftPair);
         }
@@ -715,9 +813,9 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 break;
             }
             UChar32 c = right[rightIndex++];
-            rightPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, c, right, rightIndex);
+            rightPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, blockStart, c, right, rightIndex);
             if(rightPair < MIN_LONG) {
-                rightPair = nextPair(table, c, rightPair, NULL, right, rightIndex, rightLength);
+                rightPair = nextPair(table, blockStart, c, rightPair, NULL, right, rightIndex, rightLength);
             }
             rightPair = getTertiaries(variableTop, withCaseBits, rightPair);
         }
@@ -758,9 +856,9 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 break;
             }
             UChar32 c = left[leftIndex++];
-            leftPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, c, left, leftIndex);
+            leftPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, blockStart, c, left, leftIndex);
             if(leftPair < MIN_LONG) {
-                leftPair = nextPair(table, c, leftPair, NULL, left, leftIndex, leftLength);
+                leftPair = nextPair(table, blockStart, c, leftPair, NULL, left, leftIndex, leftLength);
             }
             leftPair = getQuaternaries(variableTop, leftPair);
         }
@@ -771,9 +869,9 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
                 break;
             }
             UChar32 c = right[rightIndex++];
-            rightPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, c, right, rightIndex);
+            rightPair = (c <= 0x7f) ? table[c] : lookupUTF8Unsafe(table, blockStart, c, right, rightIndex);
             if(rightPair < MIN_LONG) {
-                rightPair = nextPair(table, c, rightPair, NULL, right, rightIndex, rightLength);
+                rightPair = nextPair(table, blockStart, c, rightPair, NULL, right, rightIndex, rightLength);
             }
             rightPair = getQuaternaries(variableTop, rightPair);
         }
@@ -796,24 +894,23 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
 }
 
 uint32_t
-CollationFastLatin::lookup(const uint16_t *table, UChar32 c) {
-    U_ASSERT(c > LATIN_MAX);
-    if(PUNCT_START <= c && c < PUNCT_LIMIT) {
-        return table[c - PUNCT_START + LATIN_LIMIT];
-    } else if(c == 0xfffe) {
-        return MERGE_WEIGHT;
-    } else if(c == 0xffff) {
-        return MAX_SHORT | COMMON_SEC | LOWER_CASE | COMMON_TER;
-    } else {
-        return BAIL_OUT;
-    }
-}
-
-uint32_t
-CollationFastLatin::lookupUTF8(const uint16_t *table, UChar32 c,
+CollationFastLatin::lookupUTF8(const uint16_t *table, UChar32 blockStart, UChar32 c,
                                const uint8_t *s8, int32_t &sIndex, int32_t sLength) {
     // The caller handled ASCII and valid/supported Latin.
     U_ASSERT(c > 0x7f);
+    if(c < 0xe0) {
+        // Only a script table supports other two-byte characters.
+        uint8_t t;
+        if(blockStart != 0 && c >= 0xc2 && sIndex != sLength &&
+                (t = (uint8_t)(s8[sIndex] - 0x80)) <= 0x3f) {
+            c = ((c & 0x1f) << 6) | t;
+            if(blockStart <= c && c < blockStart + SCRIPT_BLOCK_LENGTH) {
+                ++sIndex;
+                return table[c - blockStart + LATIN1_LIMIT];
+            }
+        }
+        return BAIL_OUT;
+    }
     int32_t i2 = sIndex + 1;
     if(i2 < sLength || sLength < 0) {
         uint8_t t1 = s8[sIndex];
@@ -827,24 +924,37 @@ CollationFastLatin::lookupUTF8(const uint16_t *table, UChar32 c,
             } else if(t2 == 0xbf) {
                 return MAX_SHORT | COMMON_SEC | LOWER_CASE | COMMON_TER;  // U+FFFF
             }
+        } else if(blockStart != 0 && c <= 0xef &&
+                (t1 -= 0x80) <= 0x3f && (t2 -= 0x80) <= 0x3f) {
+            c = ((c & 0xf) << 12) | (t1 << 6) | t2;
+            if(blockStart <= c && c < blockStart + SCRIPT_BLOCK_LENGTH) {
+                return table[c - blockStart + LATIN1_LIMIT];
+            }
         }
     }
     return BAIL_OUT;
 }
 
 uint32_t
-CollationFastLatin::lookupUTF8Unsafe(const uint16_t *table, UChar32 c,
+CollationFastLatin::lookupUTF8Unsafe(const uint16_t *table, UChar32 blockStart, UChar32 c,
                                      const uint8_t *s8, int32_t &sIndex) {
     // The caller handled ASCII.
     // The string is well-formed and contains only supported characters.
     U_ASSERT(c > 0x7f);
     if(c <= LATIN_MAX_UTF8_LEAD) {
         return table[((c - 0xc2) << 6) + s8[sIndex++]];  // 0080..017F
+    } else if(c < 0xe0) {
+        c = ((c & 0x1f) << 6) | (s8[sIndex++] & 0x3f);
+        return table[c - blockStart + LATIN1_LIMIT];  // script block -> 0100..017F
     }
+    uint8_t t1 = s8[sIndex];
     uint8_t t2 = s8[sIndex + 1];
     sIndex += 2;
     if(c == 0xe2) {
         return table[(LATIN_LIMIT - 0x80) + t2];  // 2000..203F -> 0180..01BF
+    } else if(c != 0xef || t1 != 0xbf) {
+        c = ((c & 0xf) << 12) | ((t1 & 0x3f) << 6) | (t2 & 0x3f);
+        return table[c - blockStart + LATIN1_LIMIT];  // script block -> 0100..017F
     } else if(t2 == 0xbe) {
         return MERGE_WEIGHT;  // U+FFFE
     } else {
@@ -853,7 +963,7 @@ CollationFastLatin::lookupUTF8Unsafe(const uint16_t *table, UChar32 c,
 }
 
 uint32_t
-CollationFastLatin::nextPair(const uint16_t *table, UChar32 c, uint32_t ce,
+CollationFastLatin::nextPair(const uint16_t *table, UChar32 blockStart, UChar32 c, uint32_t ce,
                              const UChar *s16, const uint8_t *s8, int32_t &sIndex, int32_t &sLength) {
     if(ce >= MIN_LONG || ce < CONTRACTION) {
         return ce;  // simple or special mini CE
@@ -874,42 +984,44 @@ CollationFastLatin::nextPair(const uint16_t *table, UChar32 c, uint32_t ce,
             int32_t nextIndex = sIndex;
             if(s16 != NULL) {
                 c2 = s16[nextIndex++];
-                if(c2 > LATIN_MAX) {
-                    if(PUNCT_START <= c2 && c2 < PUNCT_LIMIT) {
-                        c2 = c2 - PUNCT_START + LATIN_LIMIT;  // 2000..203F -> 0180..01BF
-                    } else if(c2 == 0xfffe || c2 == 0xffff) {
-                        c2 = -1;  // U+FFFE & U+FFFF cannot occur in contractions.
-                    } else {
-                        return BAIL_OUT;
-                    }
-                }
             } else {
                 c2 = s8[nextIndex++];
                 if(c2 > 0x7f) {
-                    uint8_t t;
-                    if(c2 <= 0xc5 && 0xc2 <= c2 && nextIndex != sLength &&
-                            0x80 <= (t = s8[nextIndex]) && t <= 0xbf) {
-                        c2 = ((c2 - 0xc2) << 6) + t;  // 0080..017F
-                        ++nextIndex;
+                    uint8_t t1, t2;
+                    if(c2 < 0xe0) {
+                        if(0xc2 <= c2 && nextIndex != sLength &&
+                                (t1 = (uint8_t)(s8[nextIndex] - 0x80)) <= 0x3f) {
+                            c2 = ((c2 & 0x1f) << 6) | t1;  // 0080..07FF
+                            ++nextIndex;
+                        } else {
+                            return BAIL_OUT;
+                        }
                     } else {
                         int32_t i2 = nextIndex + 1;
-                        if(i2 < sLength || sLength < 0) {
-                            if(c2 == 0xe2 && s8[nextIndex] == 0x80 &&
-                                    0x80 <= (t = s8[i2]) && t <= 0xbf) {
-                                c2 = (LATIN_LIMIT - 0x80) + t;  // 2000..203F -> 0180..01BF
-                            } else if(c2 == 0xef && s8[nextIndex] == 0xbf &&
-                                    ((t = s8[i2]) == 0xbe || t == 0xbf)) {
-                                c2 = -1;  // U+FFFE & U+FFFF cannot occur in contractions.
-                            } else {
-                                return BAIL_OUT;
+                        if(c2 <= 0xef && (i2 < sLength || sLength < 0) &&
+                                (t1 = (uint8_t)(s8[nextIndex] - 0x80)) <= 0x3f &&
+                                (t2 = (uint8_t)(s8[i2] - 0x80)) <= 0x3f) {
+                            c2 = ((c2 & 0xf) << 12) | (t1 << 6) | t2;
+                            if(c2 < 0x800) {
+                                return BAIL_OUT;  // non-shortest form
                             }
+                            nextIndex += 2;
                         } else {
                             return BAIL_OUT;
                         }
-                        nextIndex += 2;
                     }
                 }
             }
+            if(c2 > LATIN1_MAX) {
+                int32_t x = getCharIndex((UChar)c2, blockStart);
+                if(x >= 0) {
+                    c2 = x;  // for example, 2000..203F -> 0180..01BF
+                } else if(c2 == 0xfffe || c2 == 0xffff) {
+                    c2 = -1;  // U+FFFE & U+FFFF cannot occur in contractions.
+                } else {
+                    return BAIL_OUT;
+                }
+            }
             if(c2 == 0 && sLength < 0) {
                 sLength = sIndex;
                 c2 = -1;
@@ -46,6 +46,25 @@ public:
     // excludes U+FFFE & U+FFFF
     static const int32_t NUM_FAST_CHARS = LATIN_LIMIT + (PUNCT_LIMIT - PUNCT_START);
 
+    static const int32_t LATIN1_MAX = 0xff;
+    static const int32_t LATIN1_LIMIT = LATIN1_MAX + 1;
+
+    static const int32_t LATIN1_MAX_UTF8_LEAD = 0xc3;  // UTF-8 lead byte of LATIN1_MAX
+
+    /**
+     * Script blocks with their own fast tables (see the format description below).
+     * A script table stores the SCRIPT_BLOCK_LENGTH characters starting at the block start
+     * where the fast Latin table stores U+0100..U+017F.
+     */
+    enum {
+        GREEK_BLOCK,  // U+0370..U+03EF
+        CYRILLIC_BLOCK,  // U+0400..U+047F
+        CJK_PUNCT_BLOCK,  // U+3000..U+307F (CJK symbols & punctuation, most of Hiragana)
+        NUM_SCRIPT_BLOCKS
+    };
+
+    static const int32_t SCRIPT_BLOCK_LENGTH = 0x80;
+
     // Note on the supported weight ranges:
     // Analysis of UCA 6.3 and CLDR 23 non-search tailorings shows that
     // the CEs for characters in the above ranges, excluding expansions with length >2,
@@ -188,11 +207,25 @@ public:
      */
     static const int32_t BAIL_OUT_RESULT = -2;
 
-    static inline int32_t getCharIndex(UChar c) {
-        if(c <= LATIN_MAX) {
+    /**
+     * Header length of a script table: version & length, one varTop per
+     * special reorder group, and the block start.
+     */
+    static const int32_t SCRIPT_TABLE_HEADER_LENGTH = 6;
+
+    /**
+     * Returns the index of c in the table's miniCEs,
+     * or -1 if the table does not store c.
+     * @param blockStart 0 for the fast Latin table,
+     *                   or the first code point of a script table's block
+     */
+    static inline int32_t getCharIndex(UChar c, UChar32 blockStart) {
+        if(c <= LATIN1_MAX || (c <= LATIN_MAX && blockStart == 0)) {
             return c;
         } else if(PUNCT_START <= c && c < PUNCT_LIMIT) {
             return c - (PUNCT_START - LATIN_LIMIT);
+        } else if(blockStart != 0 && blockStart <= c && c < blockStart + SCRIPT_BLOCK_LENGTH) {
+            return c - (blockStart - LATIN1_LIMIT);
         } else {
             // Not a fast Latin character.
             // Note: U+FFFE & U+FFFF are forbidden in tailorings
@@ -201,6 +234,39 @@ public:
         }
     }
 
+    /**
+     * Returns the script block that contains c, or -1 if none does.
+     */
+    static inline int32_t getScriptBlock(UChar32 c) {
+        if(c < 0x370) {
+            return -1;
+        } else if(c < 0x3f0) {
+            return GREEK_BLOCK;
+        } else if(0x400 <= c && c < 0x480) {
+            return CYRILLIC_BLOCK;
+        } else if(0x3000 <= c && c < 0x3080) {
+            return CJK_PUNCT_BLOCK;
+        } else {
+            return -1;
+        }
+    }
+
+    static UChar32 getScriptBlockStart(int32_t block);
+
+    /**
+     * Returns the script whose letters a script block's table supports.
+     */
+    static int32_t getScriptBlockScript(int32_t block);
+
+    /**
+     * Returns the first code point of the table's script block,
+     * or 0 if the table is a fast Latin table.
+     */
+    static inline UChar32 getTableBlockStart(const uint16_t *table) {
+        int32_t headerLength = *table & 0xff;
+        return headerLength >= SCRIPT_TABLE_HEADER_LENGTH ? table[headerLength - 1] : 0;
+    }
+
     /**
      * Computes the options value for the compare functions
      * and writes the precomputed primary weights.
@@ -210,6 +276,21 @@ public:
     static int32_t getOptions(const CollationData *data, const CollationSettings &settings,
                               uint16_t *primaries, int32_t capacity);
 
+    /**
+     * Same as getOptions() but for the data's table for the script block.
+     * Returns -1 if there is no such table, or if it is not supported for the settings.
+     * The capacity must be LATIN1_LIMIT.
+     */
+    static int32_t getScriptOptions(const CollationData *data, const CollationSettings &settings,
+                                    int32_t block, uint16_t *primaries, int32_t capacity);
+
+    /**
+     * Sets settings.fastScriptOptions[] and settings.fastScriptPrimaries
+     * via getScriptOptions().
+     * Keeps sharing the current fastScriptPrimaries object if the primaries are unchanged.
+     */
+    static void setScriptOptions(const CollationData *data, CollationSettings &settings);
+
     static int32_t compareUTF16(const uint16_t *table, const uint16_t *primaries, int32_t options,
                                 const UChar *left, int32_t leftLength,
                                 const UChar *right, int32_t rightLength);
@@ -219,13 +300,33 @@ public:
                                const uint8_t *right, int32_t rightLength);
 
 private:
-    static uint32_t lookup(const uint16_t *table, UChar32 c);
-    static uint32_t lookupUTF8(const uint16_t *table, UChar32 c,
+    static int32_t getTableOptions(const CollationData *data, const CollationSettings &settings,
+                                   const uint16_t *table, int32_t script,
+                                   uint16_t *primaries, int32_t capacity);
+
+    /**
+     * Looks up the mini CE for a character above U+00FF.
+     * Inline for the script block characters, which are common in script table text.
+     */
+    static inline uint32_t lookup(const uint16_t *table, UChar32 blockStart, UChar32 c) {
+        if(blockStart <= c && c < blockStart + SCRIPT_BLOCK_LENGTH) {
+            return table[c - blockStart + LATIN1_LIMIT];  // script block -> 0100..017F
+        } else if(PUNCT_START <= c && c < PUNCT_LIMIT) {
+            return table[c - PUNCT_START + LATIN_LIMIT];
+        } else if(c == 0xfffe) {
+            return MERGE_WEIGHT;
+        } else if(c == 0xffff) {
+            return MAX_SHORT | COMMON_SEC | LOWER_CASE | COMMON_TER;
+        } else {
+            return BAIL_OUT;
+        }
+    }
+    static uint32_t lookupUTF8(const uint16_t *table, UChar32 blockStart, UChar32 c,
                                const uint8_t *s8, int32_t &sIndex, int32_t sLength);
-    static uint32_t lookupUTF8Unsafe(const uint16_t *table, UChar32 c,
+    static uint32_t lookupUTF8Unsafe(const uint16_t *table, UChar32 blockStart, UChar32 c,
                                      const uint8_t *s8, int32_t &sIndex);
 
-    static uint32_t nextPair(const uint16_t *table, UChar32 c, uint32_t ce,
+    static uint32_t nextPair(const uint16_t *table, UChar32 blockStart, UChar32 c, uint32_t ce,
                              const UChar *s16, const uint8_t *s8, int32_t &sIndex, int32_t &sLength);
 
     static inline uint32_t getPrimaries(uint32_t variableTop, uint32_t pair) {
@@ -303,6 +404,22 @@ private:
  *   for when there is no contraction match.
  *
  * -----------------
+ * Script tables
+ *
+ * Text in some other scripts gets a fastpath with script tables,
+ * one per script block (see GREEK_BLOCK etc.).
+ * They are not stored in the binary data but built at runtime
+ * for each CollationData with its own mappings.
+ * A script table has the same format and version as the fast Latin table,
+ * with the following differences:
+ * - The header has one more unit at the end, with the first code point of the script block.
+ * - miniCEs[0x100..0x17F] are for the script block rather than for U+0100..U+017F.
+ * - Letters have mini primaries only if they are in the block's script.
+ *   Latin letters are not supported.
+ * Because letters of two scripts never share a table,
+ * each script table has the full range of short mini primaries.
+ *
+ * -----------------
  * Changes for version 2 (ICU 55)
  *
  * Special reorder groups do not necessarily start on whole primary lead bytes any more.
@@ -31,6 +31,7 @@
 #include "collationdata.h"
 #include "collationfastlatin.h"
 #include "collationfastlatinbuilder.h"
+#include "normalizer2impl.h"
 #include "uassert.h"
 #include "uvectr64.h"
 
@@ -40,6 +41,26 @@ struct CollationData;
 
 namespace {
 
+/**
+ * @return TRUE if the tailoring data does not map any of the characters
+ *         covered by the script table for the block, so that the table would be
+ *         identical to the base data's table
+ */
+UBool
+isUntailoredScriptBlock(const CollationData &data, int32_t block) {
+    UChar32 blockStart = CollationFastLatin::getScriptBlockStart(block);
+    for(UChar32 c = 0; c < CollationFastLatin::LATIN1_LIMIT; ++c) {
+        if(data.getCE32(c) != Collation::FALLBACK_CE32) { return FALSE; }
+    }
+    for(UChar32 c = CollationFastLatin::PUNCT_START; c < CollationFastLatin::PUNCT_LIMIT; ++c) {
+        if(data.getCE32(c) != Collation::FALLBACK_CE32) { return FALSE; }
+    }
+    for(UChar32 c = blockStart; c < blockStart + CollationFastLatin::SCRIPT_BLOCK_LENGTH; ++c) {
+        if(data.getCE32(c) != Collation::FALLBACK_CE32) { return FALSE; }
+    }
+    return TRUE;
+}
+
 /**
  * Compare two signed int64_t values as if they were unsigned.
  */
@@ -90,7 +111,9 @@ CollationFastLatinBuilder::CollationFastLatinBuilder(UErrorCode &errorCode)
         : ce0(0), ce1(0),
           contractionCEs(errorCode), uniqueCEs(errorCode),
           miniCEs(NULL),
-          firstDigitPrimary(0), firstLatinPrimary(0), lastLatinPrimary(0),
+          blockStart(0), letterScript(USCRIPT_LATIN),
+          firstDigitPrimary(0), firstLatinPrimary(0),
+          firstLetterPrimary(0), lastLetterPrimary(0),
           firstShortPrimary(0), shortPrimaryOverflow(FALSE),
           headerLength(0) {
 }
@@ -106,6 +129,68 @@ CollationFastLatinBuilder::forData(const CollationData &data, UErrorCode &errorC
         errorCode = U_INVALID_STATE_ERROR;
         return FALSE;
     }
+    blockStart = 0;
+    letterScript = USCRIPT_LATIN;
+    return build(data, errorCode);
+}
+
+UBool
+CollationFastLatinBuilder::forScriptBlock(const CollationData &data, int32_t block,
+                                          UErrorCode &errorCode) {
+    if(U_FAILURE(errorCode)) { return FALSE; }
+    if(!result.isEmpty()) {  // This builder is not reusable.
+        errorCode = U_INVALID_STATE_ERROR;
+        return FALSE;
+    }
+    blockStart = CollationFastLatin::getScriptBlockStart(block);
+    letterScript = CollationFastLatin::getScriptBlockScript(block);
+    return build(data, errorCode);
+}
+
+void
+CollationFastLatinBuilder::buildScriptTables(CollationData &data,
+                                             CollationFastLatinBuilder *builders[],
+                                             UErrorCode &errorCode) {
+    for(int32_t block = 0; block < CollationFastLatin::NUM_SCRIPT_BLOCKS; ++block) {
+        builders[block] = NULL;
+        data.fastScriptTables[block] = NULL;
+        data.fastScriptTableLengths[block] = 0;
+    }
+    if(U_FAILURE(errorCode)) { return; }
+    const CollationData *base = data.base;
+    for(int32_t block = 0; block < CollationFastLatin::NUM_SCRIPT_BLOCKS; ++block) {
+        if(base != NULL && isUntailoredScriptBlock(data, block)) {
+            // Share the base table without building an identical one.
+            data.fastScriptTables[block] = base->fastScriptTables[block];
+            data.fastScriptTableLengths[block] = base->fastScriptTableLengths[block];
+            continue;
+        }
+        CollationFastLatinBuilder *builder = new CollationFastLatinBuilder(errorCode);
+        if(builder == NULL) {
+            errorCode = U_MEMORY_ALLOCATION_ERROR;
+            return;
+        }
+        if(builder->forScriptBlock(data, block, errorCode)) {
+            const uint16_t *table = builder->getTable();
+            int32_t length = builder->lengthOfTable();
+            if(base != NULL && length == base->fastScriptTableLengths[block] &&
+                    uprv_memcmp(table, base->fastScriptTables[block], length * 2) == 0) {
+                // Same script table as in the base, use that one instead.
+                delete builder;
+                builder = NULL;
+                table = base->fastScriptTables[block];
+            }
+            builders[block] = builder;
+            data.fastScriptTables[block] = table;
+            data.fastScriptTableLengths[block] = length;
+        } else {
+            delete builder;
+        }
+    }
+}
+
+UBool
+CollationFastLatinBuilder::build(const CollationData &data, UErrorCode &errorCode) {
     if(!loadGroups(data, errorCode)) { return FALSE; }
 
     // Fast handling of digits.
@@ -115,7 +200,7 @@ CollationFastLatinBuilder::forData(const CollationData &data, UErrorCode &errorC
     if(shortPrimaryOverflow) {
         // Give digits long mini primaries,
         // so that there are more short primaries for letters.
-        firstShortPrimary = firstLatinPrimary;
+        firstShortPrimary = firstLetterPrimary;
         resetCEs();
         getCEs(data, errorCode);
         if(!encodeUniqueCEs(errorCode)) { return FALSE; }
@@ -139,6 +224,9 @@ UBool
 CollationFastLatinBuilder::loadGroups(const CollationData &data, UErrorCode &errorCode) {
     if(U_FAILURE(errorCode)) { return FALSE; }
     headerLength = 1 + NUM_SPECIAL_GROUPS;
+    if(blockStart != 0) {
+        ++headerLength;  // for the script block start
+    }
     uint32_t r0 = (CollationFastLatin::VERSION << 8) | headerLength;
     result.append((UChar)r0);
     // The first few reordering groups should be special groups
@@ -152,16 +240,30 @@ CollationFastLatinBuilder::loadGroups(const CollationData &data, UErrorCode &err
         result.append((UChar)0);  // reserve a slot for this group
     }
 
+    if(blockStart != 0) {
+        result.append((UChar)blockStart);
+    }
+
     firstDigitPrimary = data.getFirstPrimaryForGroup(UCOL_REORDER_CODE_DIGIT);
     firstLatinPrimary = data.getFirstPrimaryForGroup(USCRIPT_LATIN);
-    lastLatinPrimary = data.getLastPrimaryForGroup(USCRIPT_LATIN);
-    if(firstDigitPrimary == 0 || firstLatinPrimary == 0) {
+    firstLetterPrimary = data.getFirstPrimaryForGroup(letterScript);
+    lastLetterPrimary = data.getLastPrimaryForGroup(letterScript);
+    if(firstDigitPrimary == 0 || firstLatinPrimary == 0 || firstLetterPrimary == 0) {
         // missing data
         return FALSE;
     }
     return TRUE;
 }
 
+UBool
+CollationFastLatinBuilder::isSupportedPrimary(uint32_t p) const {
+    // We support primaries before Latin, and those of the table's letters.
+    if(p < firstLetterPrimary) {
+        return blockStart == 0 || p < firstLatinPrimary;
+    }
+    return p <= lastLetterPrimary;
+}
+
 UBool
 CollationFastLatinBuilder::inSameGroup(uint32_t p, uint32_t q) const {
     // Both or neither need to be encoded as short primaries,
@@ -204,9 +306,14 @@ CollationFastLatinBuilder::resetCEs() {
 void
 CollationFastLatinBuilder::getCEs(const CollationData &data, UErrorCode &errorCode) {
     if(U_FAILURE(errorCode)) { return; }
+    // A script table stores its block where the fast Latin table stores U+0100..U+017F.
+    UChar32 secondStart = blockStart != 0 ? blockStart : CollationFastLatin::LATIN1_LIMIT;
+    UChar32 secondLimit = secondStart + CollationFastLatin::SCRIPT_BLOCK_LENGTH;
     int32_t i = 0;
-    for(UChar c = 0;; ++i, ++c) {
-        if(c == CollationFastLatin::LATIN_LIMIT) {
+    for(UChar32 c = 0;; ++i, ++c) {
+        if(c == CollationFastLatin::LATIN1_LIMIT) {
+            c = secondStart;
+        } else if(c == secondLimit) {
             c = CollationFastLatin::PUNCT_START;
         } else if(c == CollationFastLatin::PUNCT_LIMIT) {
             break;
@@ -219,7 +326,9 @@ CollationFastLatinBuilder::getCEs(const CollationData &data, UErrorCode &errorCo
         } else {
             d = &data;
         }
-        if(getCEsFromCE32(*d, c, ce32, errorCode)) {
+        // Bail out for characters that might need canonical reordering.
+        // (There are none in U+0000..U+017F.)
+        if(data.nfcImpl.getFCD16(c) <= 0xff && getCEsFromCE32(*d, c, ce32, errorCode)) {
             charCEs[i][0] = ce0;
             charCEs[i][1] = ce1;
             addUniqueCE(ce0, errorCode);
@@ -303,8 +412,9 @@ CollationFastLatinBuilder::getCEsFromCE32(const CollationData &data, UChar32 c,
     // We do not support an ignorable ce0 unless it is completely ignorable.
     uint32_t p0 = (uint32_t)(ce0 >> 32);
     if(p0 == 0) { return FALSE; }
-    // We only support primaries up to the Latin script.
-    if(p0 > lastLatinPrimary) { return FALSE; }
+    // We only support primaries up to the Latin script,
+    // or those of the script table's letters.
+    if(!isSupportedPrimary(p0)) { return FALSE; }
     // We support non-common secondary and case weights only together with short primaries.
     uint32_t lower32_0 = (uint32_t)ce0;
     if(p0 < firstShortPrimary) {
@@ -320,7 +430,8 @@ CollationFastLatinBuilder::getCEsFromCE32(const CollationData &data, UChar32 c,
         // This is so that we can test the first primary and use the same mask for both,
         // and determine for both whether they are variable.
         uint32_t p1 = (uint32_t)(ce1 >> 32);
-        if(p1 == 0 ? p0 < firstShortPrimary : !inSameGroup(p0, p1)) { return FALSE; }
+        if(p1 == 0 ? p0 < firstShortPrimary :
+                !inSameGroup(p0, p1) || !isSupportedPrimary(p1)) { return FALSE; }
         uint32_t lower32_1 = (uint32_t)ce1;
         // No tertiary CEs.
         if((lower32_1 >> 16) == 0) { return FALSE; }
@@ -361,8 +472,15 @@ CollationFastLatinBuilder::getCEsFromContractionCE32(const CollationData &data,
     UCharsTrie::Iterator suffixes(p + 2, 0, errorCode);
     while(suffixes.next(errorCode)) {
         const UnicodeString &suffix = suffixes.getString();
-        int32_t x = CollationFastLatin::getCharIndex(suffix.charAt(0));
+        int32_t x = CollationFastLatin::getCharIndex(suffix.charAt(0), blockStart);
         if(x < 0) { continue; }  // ignore anything but fast Latin text
+        if(x < prevX) {
+            // The runtime code requires the suffix list to be in ascending index order.
+            // The CJK punctuation block starts after the General Punctuation block
+            // but is stored before it.
+            contractionCEs.setSize(contractionIndex);
+            return FALSE;
+        }
         if(x == prevX) {
             if(addContraction) {
                 // Bail out for all contractions starting with this character.
@@ -650,6 +768,8 @@ CollationFastLatinBuilder::encodeContractions(UErrorCode &errorCode) {
         UChar32 c = i - headerLength;
         if(c >= CollationFastLatin::LATIN_LIMIT) {
             c = CollationFastLatin::PUNCT_START + c - CollationFastLatin::LATIN_LIMIT;
+        } else if(c >= CollationFastLatin::LATIN1_LIMIT && blockStart != 0) {
+            c = blockStart + c - CollationFastLatin::LATIN1_LIMIT;
         }
         printf("\n %04x:", c);
         for(int32_t j = 0; j < 16; ++j) {
@@ -36,6 +36,21 @@ public:
 
     UBool forData(const CollationData &data, UErrorCode &errorCode);
 
+    /**
+     * Builds the script table for one of the CollationFastLatin script blocks.
+     */
+    UBool forScriptBlock(const CollationData &data, int32_t block, UErrorCode &errorCode);
+
+    /**
+     * Builds the tables for all of the CollationFastLatin script blocks
+     * and sets data.fastScriptTables[].
+     * Where the table would be the same as the base data's, that one is used.
+     * Sets builders[block] to the builder that owns a new table, or to NULL.
+     */
+    static void buildScriptTables(CollationData &data,
+                                  CollationFastLatinBuilder *builders[],
+                                  UErrorCode &errorCode);
+
     const uint16_t *getTable() const {
         return reinterpret_cast<const uint16_t *>(result.getBuffer());
     }
@@ -45,8 +60,10 @@ private:
     // space, punct, symbol, currency (not digit)
     enum { NUM_SPECIAL_GROUPS = UCOL_REORDER_CODE_CURRENCY - UCOL_REORDER_CODE_FIRST + 1 };
 
+    UBool build(const CollationData &data, UErrorCode &errorCode);
     UBool loadGroups(const CollationData &data, UErrorCode &errorCode);
     UBool inSameGroup(uint32_t p, uint32_t q) const;
+    UBool isSupportedPrimary(uint32_t p) const;
 
     void resetCEs();
     void getCEs(const CollationData &data, UErrorCode &errorCode);
@@ -79,11 +96,17 @@ private:
     /** One 16-bit mini CE per unique CE. */
     uint16_t *miniCEs;
 
+    // 0 for the fast Latin table, otherwise the first code point of the script block.
+    UChar32 blockStart;
+    // The script of the letters in the table: Latin, or the script block's script.
+    int32_t letterScript;
+
     // These are constant for a given root collator.
     uint32_t lastSpecialPrimaries[NUM_SPECIAL_GROUPS];
     uint32_t firstDigitPrimary;
     uint32_t firstLatinPrimary;
-    uint32_t lastLatinPrimary;
+    uint32_t firstLetterPrimary;
+    uint32_t lastLetterPrimary;
     // This determines the first normal primary weight which is mapped to
     // a short mini primary. It must be >=firstDigitPrimary.
     uint32_t firstShortPrimary;
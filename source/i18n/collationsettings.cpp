@@ -27,6 +27,8 @@
 
 U_NAMESPACE_BEGIN
 
+CollationFastScriptPrimaries::~CollationFastScriptPrimaries() {}
+
 CollationSettings::CollationSettings(const CollationSettings &other)
         : SharedObject(other),
           options(other.options), variableTop(other.variableTop),
@@ -34,15 +36,20 @@ CollationSettings::CollationSettings(const CollationSettings &other)
           minHighNoReorder(other.minHighNoReorder),
           reorderRanges(NULL), reorderRangesLength(0),
           reorderCodes(NULL), reorderCodesLength(0), reorderCodesCapacity(0),
-          fastLatinOptions(other.fastLatinOptions) {
+          fastLatinOptions(other.fastLatinOptions), fastScriptPrimaries(NULL) {
     UErrorCode errorCode = U_ZERO_ERROR;
     copyReorderingFrom(other, errorCode);
     if(fastLatinOptions >= 0) {
         uprv_memcpy(fastLatinPrimaries, other.fastLatinPrimaries, sizeof(fastLatinPrimaries));
     }
+    for(int32_t i = 0; i < CollationFastLatin::NUM_SCRIPT_BLOCKS; ++i) {
+        fastScriptOptions[i] = other.fastScriptOptions[i];
+    }
+    SharedObject::copyPtr(other.fastScriptPrimaries, fastScriptPrimaries);
 }
 
 CollationSettings::~CollationSettings() {
+    SharedObject::clearPtr(fastScriptPrimaries);
     if(reorderCodesCapacity != 0) {
         uprv_free(const_cast<int32_t *>(reorderCodes));
     }
@@ -20,6 +20,7 @@
 
 #include "unicode/ucol.h"
 #include "collation.h"
+#include "collationfastlatin.h"
 #include "sharedobject.h"
 #include "umutex.h"
 
@@ -27,6 +28,17 @@ U_NAMESPACE_BEGIN
 
 struct CollationData;
 
+/**
+ * Primaries for the CollationFastLatin script tables, for one set of settings.
+ * Shared among CollationSettings objects rather than copied with each one.
+ */
+struct U_I18N_API CollationFastScriptPrimaries : public SharedObject {
+    CollationFastScriptPrimaries() {}
+    virtual ~CollationFastScriptPrimaries();
+
+    uint16_t primaries[CollationFastLatin::NUM_SCRIPT_BLOCKS][CollationFastLatin::LATIN1_LIMIT];
+};
+
 /**
  * Collation settings/options/attributes.
  * These are the values that can be changed via API.
@@ -110,7 +122,11 @@ struct U_I18N_API CollationSettings : public SharedObject {
               minHighNoReorder(0),
               reorderRanges(NULL), reorderRangesLength(0),
               reorderCodes(NULL), reorderCodesLength(0), reorderCodesCapacity(0),
-              fastLatinOptions(-1) {}
+              fastLatinOptions(-1), fastScriptPrimaries(NULL) {
+        for(int32_t i = 0; i < CollationFastLatin::NUM_SCRIPT_BLOCKS; ++i) {
+            fastScriptOptions[i] = -1;
+        }
+    }
 
     CollationSettings(const CollationSettings &other);
     virtual ~CollationSettings();
@@ -260,6 +276,10 @@ struct U_I18N_API CollationSettings : public SharedObject {
     /** Options for CollationFastLatin. Negative if disabled. */
     int32_t fastLatinOptions;
     uint16_t fastLatinPrimaries[0x180];
+    /** Options for the CollationFastLatin script tables. Negative if disabled. */
+    int32_t fastScriptOptions[CollationFastLatin::NUM_SCRIPT_BLOCKS];
+    /** NULL if all of the fastScriptOptions are negative. */
+    const CollationFastScriptPrimaries *fastScriptPrimaries;
 
 private:
     void setReorderArrays(const int32_t *codes, int32_t codesLength,
@@ -22,6 +22,7 @@
 #include "unicode/uvernum.h"
 #include "cmemory.h"
 #include "collationdata.h"
+#include "collationfastlatinbuilder.h"
 #include "collationsettings.h"
 #include "collationtailoring.h"
 #include "normalizer2impl.h"
@@ -51,6 +52,9 @@ CollationTailoring::CollationTailoring(const CollationSettings *baseSettings)
     }
     rules.getTerminatedBuffer();  // ensure NUL-termination
     version[0] = version[1] = version[2] = version[3] = 0;
+    for(int32_t i = 0; i < CollationFastLatin::NUM_SCRIPT_BLOCKS; ++i) {
+        fastScriptBuilders[i] = NULL;
+    }
     maxExpansionsInitOnce.reset();
 }
 
@@ -62,6 +66,9 @@ CollationTailoring::~CollationTailoring() {
     ures_close(bundle);
     utrie2_close(trie);
     delete unsafeBackwardSet;
+    for(int32_t i = 0; i < CollationFastLatin::NUM_SCRIPT_BLOCKS; ++i) {
+        delete fastScriptBuilders[i];
+    }
     uhash_close(maxExpansions);
     maxExpansionsInitOnce.reset();
 }
@@ -21,6 +21,7 @@
 #include "unicode/locid.h"
 #include "unicode/unistr.h"
 #include "unicode/uversion.h"
+#include "collationfastlatin.h"
 #include "collationsettings.h"
 #include "uhash.h"
 #include "umutex.h"
@@ -33,6 +34,7 @@ U_NAMESPACE_BEGIN
 
 struct CollationData;
 
+class CollationFastLatinBuilder;
 class UnicodeSet;
 
 /**
@@ -81,6 +83,8 @@ struct U_I18N_API CollationTailoring : public SharedObject {
     UResourceBundle *bundle;
     UTrie2 *trie;
     UnicodeSet *unsafeBackwardSet;
+    // Owners of the ownedData's script tables when the data was deserialized.
+    CollationFastLatinBuilder *fastScriptBuilders[CollationFastLatin::NUM_SCRIPT_BLOCKS];
     mutable UHashtable *maxExpansions;
     mutable UInitOnce maxExpansionsInitOnce;
 
@@ -38,6 +38,7 @@
 #include "regexcst.h"   // Contains state table for the regex pattern parser.
                         //   generated by a Perl script.
 #include "regexcmp.h"
+#include "regexdfa.h"
 #include "regexst.h"
 #include "regextxt.h"
 
@@ -318,6 +319,11 @@ void    RegexCompile::compile(
     //
     matchStartType();
 
+    //
+    // Optimization pass 3: required string
+    //
+    requiredString();
+
     //
     // Set up fast latin-1 range sets
     //
@@ -334,6 +340,10 @@ void    RegexCompile::compile(
         fRXPat->fSets8[i].init(s);
     }
 
+    //
+    // Optimization pass 4: NFA, for patterns that find() can match with a DFA.
+    //
+    fRXPat->fNFA = RegexNFA::createNFA(fRXPat, *fStatus);
 }
 
 
@@ -3737,6 +3747,160 @@ int32_t   RegexCompile::maxMatchLength(int32_t start, int32_t end) {
 }
 
 
+//------------------------------------------------------------------------------
+//
+//   requiredString    Find the longest literal string that every match must contain,
+//                     and how far from the start of a match it can be.
+//                     Used to optimize find() operations, which can skip input
+//                     that is not followed, within reach, by the string.
+//
+//                     Walk the compiled pattern.  An op is on every path through the
+//                     pattern unless some forward jump or state save passes over it.
+//                     A run of such ops that match literal characters, with only
+//                     captures between them, matches a string that is in every match.
+//
+//------------------------------------------------------------------------------
+void   RegexCompile::requiredString() {
+    if (U_FAILURE(*fStatus)) {
+        return;
+    }
+
+    // Only when the start of match hints leave many positions to try.
+    //   A required string at the start of the pattern is already used by START_STRING.
+    int32_t startType = fRXPat->fStartType;
+    if (startType != START_NO_INFO && startType != START_CHAR &&
+            startType != START_SET && startType != START_STRING) {
+        return;
+    }
+
+    int32_t       end       = fRXPat->fCompiledPat->size() - 1;
+    int32_t       skipUntil = 0;       // Ops before this location may be jumped over.
+    UnicodeString run;                 // The literal string matched by the current run of ops.
+    int32_t       runLoc    = -1;      // Location of the first op of the run.
+    UnicodeString best;
+    int32_t       bestLoc   = -1;
+    int32_t       loc;
+
+    for (loc = 3; loc <= end + 1; loc++) {
+        int32_t  op     = loc <= end ? (int32_t)fRXPat->fCompiledPat->elementAti(loc) : 0;
+        int32_t  opType = URX_TYPE(op);
+        UBool    onEveryPath = (loc >= skipUntil);
+        UBool    extendsRun  = FALSE;
+
+        if (loc <= end) {
+            switch (opType) {
+            case URX_START_CAPTURE:
+            case URX_END_CAPTURE:
+            case URX_NOP:
+                // Match nothing; the run continues across them.
+                extendsRun = onEveryPath && run.length() > 0;
+                break;
+
+            case URX_ONECHAR:
+                // U+FFFD and surrogates are left out; they could match ill-formed input.
+                if (onEveryPath && URX_VAL(op) != 0xfffd && !U_IS_SURROGATE(URX_VAL(op))) {
+                    if (run.length() == 0) {
+                        runLoc = loc;
+                    }
+                    run.append((UChar32)URX_VAL(op));
+                    extendsRun = TRUE;
+                }
+                break;
+
+            case URX_STRING:
+                {
+                    int32_t stringStart = URX_VAL(op);
+                    int32_t stringLen   = URX_VAL(fRXPat->fCompiledPat->elementAti(loc+1));
+                    UnicodeString s(fRXPat->fLiteralText, stringStart, stringLen);
+                    UBool isLiteral = onEveryPath;
+                    for (int32_t i = 0; isLiteral && i < s.length(); i = s.moveIndex32(i, 1)) {
+                        UChar32 c = s.char32At(i);
+                        isLiteral = (c != 0xfffd && !U_IS_SURROGATE(c));
+                    }
+                    if (isLiteral) {
+                        if (run.length() == 0) {
+                            runLoc = loc;
+                        }
+                        run.append(s);
+                        extendsRun = TRUE;
+                    }
+                    loc++;
+                }
+                break;
+
+            case URX_STATE_SAVE:
+            case URX_JMP:
+                if (URX_VAL(op) > skipUntil) {
+                    skipUntil = URX_VAL(op);
+                }
+                break;
+
+            case URX_JMPX:
+                if (URX_VAL(op) > skipUntil) {
+                    skipUntil = URX_VAL(op);
+                }
+                loc++;
+                break;
+
+            case URX_CTR_INIT:
+            case URX_CTR_INIT_NG:
+                {
+                    // A loop with a minimum count of zero may be skipped entirely.
+                    int32_t loopEndLoc   = URX_VAL(fRXPat->fCompiledPat->elementAti(loc+1));
+                    int32_t minLoopCount = (int32_t)fRXPat->fCompiledPat->elementAti(loc+2);
+                    if (minLoopCount == 0 && loopEndLoc + 1 > skipUntil) {
+                        skipUntil = loopEndLoc + 1;
+                    }
+                    loc += 3;
+                }
+                break;
+
+            case URX_LA_START:
+            case URX_LB_START:
+                // Look-around can examine input outside of the match.
+                //   Give up rather than work out what that means for the reach of the string.
+                return;
+
+            default:
+                // Ops that match something other than a literal, or test a condition.
+                break;
+            }
+        }
+
+        if (!extendsRun && run.length() > 0) {
+            if (run.length() > best.length()) {
+                best    = run;
+                bestLoc = runLoc;
+            }
+            run.remove();
+        }
+    }
+
+    if (best.length() == 0) {
+        return;
+    }
+    int32_t offset = 0;
+    if (bestLoc > 3) {
+        // No forward jump passes over bestLoc, so none leaves the range being measured.
+        offset = maxMatchLength(3, bestLoc - 1);
+    }
+    if (offset == 0 && startType == START_STRING) {
+        // The required string starts the pattern, and find() already looks for it.
+        return;
+    }
+
+    // Long strings are hardly more selective than their beginnings.
+    if (best.length() > MAX_REQUIRED_STRING_LEN) {
+        best.truncate(U16_IS_LEAD(best.charAt(MAX_REQUIRED_STRING_LEN - 1)) ?
+                      MAX_REQUIRED_STRING_LEN - 1 : MAX_REQUIRED_STRING_LEN);
+    }
+    fRXPat->fRequiredStringIdx    = fRXPat->fLiteralText.length();
+    fRXPat->fRequiredStringLen    = best.length();
+    fRXPat->fRequiredStringOffset = offset == INT32_MAX ? -1 : offset;
+    fRXPat->fLiteralText.append(best);
+}
+
+
 //------------------------------------------------------------------------------
 //
 //   stripNOPs    Remove any NOP operations from the compiled pattern code.
@@ -119,6 +119,7 @@ private:
     int32_t     maxMatchLength(int32_t start,
                                int32_t end);
     void        matchStartType();
+    void        requiredString();
     void        stripNOPs();
 
     void        setEval(int32_t op);
@@ -0,0 +1,1111 @@
+// Copyright (C) 2016 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+//
+//   file:  regexdfa.cpp
+//
+//           ICU Regular Expressions,
+//             NFA and lazily built DFA, for finding matches of patterns
+//             that need no backtracking, alone or as members of a RegexSet.
+//
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_REGULAR_EXPRESSIONS
+
+#include "unicode/regex.h"
+#include "unicode/uchar.h"
+#include "unicode/uniset.h"
+#include "unicode/ustring.h"
+#include "unicode/utf16.h"
+#include "cmemory.h"
+#include "uarrsort.h"
+#include "ucase.h"
+#include "uvector.h"
+#include "uvectr64.h"
+#include "regeximp.h"
+#include "regexdfa.h"
+
+U_NAMESPACE_BEGIN
+
+// Patterns needing more NFA nodes than this are left to the backtracking engine.
+static const int32_t MAX_NFA_NODES = 4096;
+
+// Memory budget of a RegexDFACache, in 32 bit words.
+static const int32_t MAX_DFA_CACHE_SIZE = 256 * 1024;
+
+// Number of times a cache may be flushed during one scan before the scan gives up.
+static const int32_t MAX_DFA_FLUSHES = 8;
+
+static const int32_t INITIAL_HASH_SIZE = 256;
+
+
+//------------------------------------------------------------------------------
+//
+//   RegexNFA
+//
+//------------------------------------------------------------------------------
+
+RegexNFA::RegexNFA(const RegexPattern *pattern) :
+        fPattern(pattern), fNodes(NULL), fNodeCount(0), fStartNode(-1), fMatchNode(-1),
+        fSetSize(0), fConsumers(NULL), fConsumerCount(0), fPredecessors(NULL), fPredecessorStart(NULL),
+        fClassCount(1) {
+    uprv_memset(fClassMap, 0, sizeof(fClassMap));
+}
+
+
+RegexNFA::~RegexNFA() {
+    uprv_free(fNodes);
+    uprv_free(fConsumers);
+    uprv_free(fPredecessors);
+    uprv_free(fPredecessorStart);
+}
+
+
+RegexNFA *RegexNFA::createNFA(const RegexPattern *pattern, UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return NULL;
+    }
+    RegexNFA *nfa = new RegexNFA(pattern);
+    if (nfa == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+    nfa->build(status);
+    if (U_FAILURE(status) || nfa->fNodes == NULL) {
+        delete nfa;
+        return NULL;
+    }
+    return nfa;
+}
+
+
+RegexNFA *RegexNFA::createSetNFA(const RegexNFA * const *members, int32_t count, UErrorCode &status) {
+    if (U_FAILURE(status) || count <= 0) {
+        return NULL;
+    }
+    LocalPointer<RegexNFA> nfa(new RegexNFA(NULL), status);
+    if (U_FAILURE(status)) {
+        return NULL;
+    }
+
+    //  The nodes are the match nodes of the members, the splits that choose
+    //    among the members, in the order given, then the nodes of each member.
+    int32_t nodeCount     = 2 * count - 1;
+    int32_t consumerCount = 0;
+    for (int32_t i = 0; i < count; i++) {
+        nodeCount     += members[i]->fNodeCount;
+        consumerCount += members[i]->fConsumerCount;
+    }
+    nfa->fNodes     = (Node *)uprv_malloc(nodeCount * sizeof(Node));
+    nfa->fConsumers = (int32_t *)uprv_malloc((consumerCount + 1) * sizeof(int32_t));
+    if (nfa->fNodes == NULL || nfa->fConsumers == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+    nfa->fNodeCount = nodeCount;
+    nfa->fSetSize   = count;
+
+    int32_t base = 2 * count - 1;
+    for (int32_t i = 0; i < count; i++) {
+        const RegexNFA *member = members[i];
+        Node &match = nfa->fNodes[i];
+        match.fPattern = member->fPattern;
+        match.fType    = kMatch;
+        match.fValue   = i;
+        match.fValue2  = 0;
+        match.fNext    = -1;
+        match.fAlt     = -1;
+
+        int32_t entry = base + member->fStartNode;
+        if (i < count - 1) {
+            Node &split = nfa->fNodes[count + i];
+            split.fPattern = NULL;
+            split.fType    = kSplit;
+            split.fValue   = 0;
+            split.fValue2  = 0;
+            split.fNext    = entry;
+            split.fAlt     = -1;        // Set to the entry of the next member.
+            entry = count + i;
+        }
+        if (i == 0) {
+            nfa->fStartNode = entry;
+        } else {
+            nfa->fNodes[count + i - 1].fAlt = entry;
+        }
+
+        for (int32_t n = 0; n < member->fNodeCount; n++) {
+            Node &node = nfa->fNodes[base + n];
+            node = member->fNodes[n];
+            if (node.fType == kMatch) {
+                node.fType = kEps;
+                node.fNext = i;
+            } else {
+                if (node.fNext >= 0) {
+                    node.fNext += base;
+                }
+                if (node.fAlt >= 0) {
+                    node.fAlt += base;
+                }
+            }
+        }
+        for (int32_t c = 0; c < member->fConsumerCount; c++) {
+            nfa->fConsumers[nfa->fConsumerCount++] = base + member->fConsumers[c];
+        }
+        base += member->fNodeCount;
+    }
+    nfa->buildClasses();
+    return nfa.orphan();
+}
+
+
+//
+//  build    Translate the compiled pattern into NFA nodes.
+//           Leaves fNodes NULL if the pattern contains an op that the NFA can not express.
+//
+void RegexNFA::build(UErrorCode &status) {
+    const UVector64 *pat     = fPattern->fCompiledPat;
+    const UChar     *litText = fPattern->fLiteralText.getBuffer();
+    int32_t          patSize = pat->size();
+
+    LocalMemory<int32_t> nodeOf((int32_t *)uprv_malloc((patSize + 1) * sizeof(int32_t)));
+    if (nodeOf.isNull()) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+
+    //
+    //  Pass 1:  Check the ops, and number the nodes.
+    //           Ops that are only operands of the preceding op get no node, -1.
+    //
+    //           Reads the ops directly rather than with elementAti(), whose range check
+    //           lets the compiler assume that loc might be negative.
+    //
+    const int64_t *ops = pat->getBuffer();
+    int32_t loc;
+    int32_t nodeCount = 0;
+    for (loc = 0; loc < patSize; loc++) {
+        int32_t op      = (int32_t)ops[loc];
+        int32_t opValue = URX_VAL(op);
+        nodeOf[loc] = nodeCount;
+        switch (URX_TYPE(op)) {
+        case URX_NOP:
+        case URX_START_CAPTURE:
+        case URX_END_CAPTURE:
+        case URX_STO_INP_LOC:
+        case URX_JMP:
+        case URX_STATE_SAVE:
+        case URX_JMP_SAV:
+        case URX_JMP_SAV_X:
+        case URX_FAIL:
+        case URX_BACKTRACK:
+        case URX_END:
+        case URX_ONECHAR:
+        case URX_ONECHAR_I:
+        case URX_SETREF:
+        case URX_STATIC_SETREF:
+        case URX_STAT_SETREF_N:
+        case URX_DOTANY:
+        case URX_DOTANY_UNIX:
+        case URX_BACKSLASH_D:
+        case URX_BACKSLASH_H:
+        case URX_BACKSLASH_V:
+            nodeCount++;
+            break;
+
+        case URX_STRING:
+        case URX_STRING_I:
+            {
+                if (loc + 1 >= patSize) {
+                    return;
+                }
+                int32_t lenOp = (int32_t)ops[loc+1];
+                if (URX_TYPE(lenOp) != URX_STRING_LEN) {
+                    return;
+                }
+                int32_t stringLen = URX_VAL(lenOp);
+                const UChar *s = litText + opValue;
+                int32_t i = 0;
+                while (i < stringLen) {
+                    UChar32 c;
+                    U16_NEXT(s, i, stringLen, c);
+                    if (U_IS_SURROGATE(c)) {
+                        // The match engine compares strings by code unit, so an unpaired
+                        //   surrogate could match half of a pair in the input.
+                        return;
+                    }
+                    if (URX_TYPE(op) == URX_STRING) {
+                        nodeCount++;
+                    }
+                }
+                if (URX_TYPE(op) == URX_STRING_I) {
+                    // One node for each code unit offset into the folded string.
+                    nodeCount += stringLen;
+                }
+                nodeOf[++loc] = -1;
+            }
+            break;
+
+        case URX_LOOP_DOT_I:
+            if ((opValue & 1) != 0) {
+                // .* in dot-all mode; the match engine backs up over a CR LF as a unit.
+                return;
+            }
+            U_FALLTHROUGH;
+        case URX_LOOP_SR_I:
+            if (loc + 1 >= patSize || URX_TYPE(ops[loc+1]) != URX_LOOP_C) {
+                return;
+            }
+            nodeCount += 2;
+            nodeOf[++loc] = -1;
+            break;
+
+        default:
+            // Anchors, boundaries, back references, look-around, atomic and
+            //   possessive constructs, counted loops.
+            return;
+        }
+    }
+    nodeOf[patSize] = -1;
+    if (nodeCount > MAX_NFA_NODES) {
+        return;
+    }
+
+    fNodes = (Node *)uprv_malloc(nodeCount * sizeof(Node));
+    if (fNodes == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    fNodeCount = nodeCount;
+
+    //
+    //  Pass 2:  Fill in the nodes.
+    //
+    //    The match engine continues with the op following a URX_STATE_SAVE, and comes
+    //    back to the saved location only if that fails.  URX_JMP_SAV and URX_JMP_SAV_X
+    //    jump first, and save the following op.  The split nodes keep that order.
+    //
+    for (loc = 0; loc < patSize; loc++) {
+        int32_t op      = (int32_t)pat->elementAti(loc);
+        int32_t opValue = URX_VAL(op);
+        int32_t n       = nodeOf[loc];
+        Node   *node    = fNodes + n;
+        node->fType   = kEps;
+        node->fValue  = 0;
+        node->fValue2 = 0;
+        node->fNext   = nodeOf[loc+1];
+        node->fAlt    = -1;
+
+        switch (URX_TYPE(op)) {
+        case URX_JMP:
+            node->fNext = nodeOf[opValue];
+            break;
+
+        case URX_STATE_SAVE:
+            node->fType = kSplit;
+            node->fAlt  = nodeOf[opValue];
+            break;
+
+        case URX_JMP_SAV:
+        case URX_JMP_SAV_X:
+            // URX_JMP_SAV_X does not repeat a loop body that matched an empty string.
+            //   Repeating it could not match anything new, so a plain split will do.
+            node->fType = kSplit;
+            node->fNext = nodeOf[opValue];
+            node->fAlt  = nodeOf[loc+1];
+            break;
+
+        case URX_FAIL:
+        case URX_BACKTRACK:
+            node->fType = kFail;
+            break;
+
+        case URX_END:
+            node->fType = kMatch;
+            fMatchNode  = n;
+            break;
+
+        case URX_ONECHAR:
+            node->fType  = kChar;
+            node->fValue = opValue;
+            break;
+
+        case URX_ONECHAR_I:
+            node->fType  = kCharI;
+            node->fValue = opValue;
+            break;
+
+        case URX_SETREF:
+            node->fType  = kSet;
+            node->fValue = opValue;
+            break;
+
+        case URX_STATIC_SETREF:
+            node->fType   = kStaticSet;
+            node->fValue  = opValue & ~URX_NEG_SET;
+            node->fValue2 = (opValue & URX_NEG_SET) != 0;
+            break;
+
+        case URX_STAT_SETREF_N:
+            node->fType   = kStaticSet;
+            node->fValue  = opValue;
+            node->fValue2 = TRUE;
+            break;
+
+        case URX_DOTANY:
+            node->fType  = kDot;
+            break;
+
+        case URX_DOTANY_UNIX:
+            node->fType  = kDot;
+            node->fValue = TRUE;
+            break;
+
+        case URX_BACKSLASH_D:
+            node->fType  = kDigit;
+            node->fValue = opValue != 0;
+            break;
+
+        case URX_BACKSLASH_H:
+            node->fType  = kHSpace;
+            node->fValue = opValue != 0;
+            break;
+
+        case URX_BACKSLASH_V:
+            node->fType  = kVSpace;
+            node->fValue = opValue != 0;
+            break;
+
+        case URX_STRING:
+            {
+                // A chain of nodes, one per code point.
+                int32_t stringLen = URX_VAL(pat->elementAti(loc+1));
+                const UChar *s = litText + opValue;
+                int32_t i = 0;
+                while (i < stringLen) {
+                    UChar32 c;
+                    U16_NEXT(s, i, stringLen, c);
+                    node->fType   = kChar;
+                    node->fValue  = c;
+                    node->fValue2 = 0;
+                    node->fNext   = i < stringLen ? n + 1 : nodeOf[loc+2];
+                    node->fAlt    = -1;
+                    node++;
+                    n++;
+                }
+                loc++;
+            }
+            break;
+
+        case URX_STRING_I:
+            {
+                int32_t stringLen = URX_VAL(pat->elementAti(loc+1));
+                for (int32_t i = 0; i < stringLen; i++) {
+                    node[i].fType   = kStringI;
+                    node[i].fValue  = opValue + i;
+                    node[i].fValue2 = stringLen - i;
+                    node[i].fNext   = nodeOf[loc+2];
+                    node[i].fAlt    = -1;
+                }
+                loc++;
+            }
+            break;
+
+        case URX_LOOP_SR_I:
+        case URX_LOOP_DOT_I:
+            // [set]* or .*, greedy:  a split, preferring the node that consumes a
+            //   character and loops back to the split.
+            node[0].fType   = kSplit;
+            node[0].fNext   = n + 1;
+            node[0].fAlt    = nodeOf[loc+2];
+            if (URX_TYPE(op) == URX_LOOP_SR_I) {
+                node[1].fType   = kSet;
+                node[1].fValue  = opValue;
+            } else {
+                node[1].fType   = kDot;
+                node[1].fValue  = (opValue & 2) != 0;
+            }
+            node[1].fValue2 = 0;
+            node[1].fNext   = n;
+            node[1].fAlt    = -1;
+            loc++;
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    for (int32_t n = 0; n < fNodeCount; n++) {
+        fNodes[n].fPattern = fPattern;
+    }
+
+    //
+    //  Check that every transition leads to a node.
+    //    Jumps into the operands of an op would not.
+    //
+    int32_t consumerCount = 0;
+    int32_t epsCount = 0;
+    for (int32_t n = 0; n < fNodeCount; n++) {
+        const Node &node = fNodes[n];
+        if (node.fType == kMatch || node.fType == kFail) {
+            continue;
+        }
+        if (node.fNext < 0 || (node.fType == kSplit && node.fAlt < 0)) {
+            uprv_free(fNodes);
+            fNodes = NULL;
+            return;
+        }
+        if (node.fType == kEps) {
+            epsCount++;
+        } else if (node.fType == kSplit) {
+            epsCount += 2;
+        } else {
+            consumerCount++;
+        }
+    }
+    fStartNode = nodeOf[0];
+    if (fMatchNode < 0 || fStartNode < 0) {
+        uprv_free(fNodes);
+        fNodes = NULL;
+        return;
+    }
+
+    //
+    //  The consuming nodes, and the reverse of the empty transitions,
+    //    for the reverse scan.
+    //
+    fConsumers        = (int32_t *)uprv_malloc((consumerCount + 1) * sizeof(int32_t));
+    fPredecessors     = (int32_t *)uprv_malloc((epsCount + 1) * sizeof(int32_t));
+    fPredecessorStart = (int32_t *)uprv_malloc((fNodeCount + 1) * sizeof(int32_t));
+    if (fConsumers == NULL || fPredecessors == NULL || fPredecessorStart == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    uprv_memset(fPredecessorStart, 0, (fNodeCount + 1) * sizeof(int32_t));
+    for (int32_t n = 0; n < fNodeCount; n++) {
+        const Node &node = fNodes[n];
+        if (node.fType == kEps || node.fType == kSplit) {
+            fPredecessorStart[node.fNext + 1]++;
+            if (node.fType == kSplit) {
+                fPredecessorStart[node.fAlt + 1]++;
+            }
+        } else if (node.fType != kMatch && node.fType != kFail) {
+            fConsumers[fConsumerCount++] = n;
+        }
+    }
+    for (int32_t n = 0; n < fNodeCount; n++) {
+        fPredecessorStart[n + 1] += fPredecessorStart[n];
+    }
+    LocalMemory<int32_t> fillPos((int32_t *)uprv_malloc(fNodeCount * sizeof(int32_t)));
+    if (fillPos.isNull()) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    uprv_memcpy(fillPos.getAlias(), fPredecessorStart, fNodeCount * sizeof(int32_t));
+    for (int32_t n = 0; n < fNodeCount; n++) {
+        const Node &node = fNodes[n];
+        if (node.fType == kEps || node.fType == kSplit) {
+            fPredecessors[fillPos[node.fNext]++] = n;
+            if (node.fType == kSplit) {
+                fPredecessors[fillPos[node.fAlt]++] = n;
+            }
+        }
+    }
+
+    buildClasses();
+}
+
+
+//
+//  buildClasses    Partition Latin-1 into classes of code points that lead from every
+//                  consuming node to the same target.  Refines the partition one node
+//                  at a time, splitting each class by where the node goes on each code point.
+//
+void RegexNFA::buildClasses() {
+    enum { kMaxAdvance = 4 };        // Case folded Latin-1 is at most 2 code units.
+    int16_t  newClass[256 * kMaxAdvance];
+    uint8_t  newMap[256];
+
+    uprv_memset(fClassMap, 0, sizeof(fClassMap));
+    fClassCount = 1;
+    for (int32_t i = 0; i < fConsumerCount && fClassCount < 256; i++) {
+        int32_t n = fConsumers[i];
+        int32_t newCount = 0;
+        uprv_memset(newClass, 0xff, sizeof(newClass));
+        for (UChar32 c = 0; c < 256; c++) {
+            // 0: no match.  1: on to fNext.  2, 3: on within a folded string.
+            int32_t t = target(n, c);
+            int32_t advance = t < 0 ? 0 : (t == fNodes[n].fNext ? 1 : t - n + 1);
+            U_ASSERT(advance >= 0 && advance < kMaxAdvance);
+            int32_t key = fClassMap[c] * kMaxAdvance + advance;
+            if (newClass[key] < 0) {
+                newClass[key] = (int16_t)newCount++;
+            }
+            newMap[c] = (uint8_t)newClass[key];
+        }
+        uprv_memcpy(fClassMap, newMap, sizeof(fClassMap));
+        fClassCount = newCount;
+    }
+}
+
+
+int32_t RegexNFA::target(int32_t n, UChar32 c) const {
+    const Node &node = fNodes[n];
+    UBool matched;
+    switch (node.fType) {
+    case kChar:
+        matched = (c == node.fValue);
+        break;
+
+    case kCharI:
+        matched = (u_foldCase(c, U_FOLD_CASE_DEFAULT) == node.fValue);
+        break;
+
+    case kStringI:
+        {
+            // The folding of c must match the next code units of the folded string,
+            //   and not run past its end, as in URX_STRING_I.
+            const UChar *folding;
+            UChar        buf[U16_MAX_LENGTH];
+            int32_t      foldLength = ucase_toFullFolding(ucase_getSingleton(), c, &folding,
+                                                          U_FOLD_CASE_DEFAULT);
+            if (foldLength >= UCASE_MAX_STRING_LENGTH || foldLength < 0) {
+                // c folds to a single code point, possibly itself.
+                UChar32 foldedC = foldLength < 0 ? ~foldLength : foldLength;
+                foldLength = 0;
+                U16_APPEND_UNSAFE(buf, foldLength, foldedC);
+                folding = buf;
+            }
+            if (foldLength > node.fValue2 ||
+                    u_memcmp(folding, node.fPattern->fLiteralText.getBuffer() + node.fValue, foldLength) != 0) {
+                return -1;
+            }
+            return foldLength == node.fValue2 ? node.fNext : n + foldLength;
+        }
+
+    case kSet:
+        if (c < 256) {
+            matched = node.fPattern->fSets8[node.fValue].contains(c);
+        } else {
+            matched = ((UnicodeSet *)node.fPattern->fSets->elementAt(node.fValue))->contains(c);
+        }
+        break;
+
+    case kStaticSet:
+        if (c < 256) {
+            matched = node.fPattern->fStaticSets8[node.fValue].contains(c);
+        } else {
+            matched = node.fPattern->fStaticSets[node.fValue]->contains(c);
+        }
+        matched = (matched != (UBool)node.fValue2);
+        break;
+
+    case kDot:
+        matched = node.fValue ? c != 0x0a : !isLineTerminator(c);
+        break;
+
+    case kDigit:
+        matched = ((u_charType(c) == U_DECIMAL_DIGIT_NUMBER) != (UBool)node.fValue);
+        break;
+
+    case kHSpace:
+        matched = ((u_charType(c) == U_SPACE_SEPARATOR || c == 9) != (UBool)node.fValue);
+        break;
+
+    case kVSpace:
+        matched = (isLineTerminator(c) != (UBool)node.fValue);
+        break;
+
+    default:
+        return -1;
+    }
+    return matched ? node.fNext : -1;
+}
+
+
+//------------------------------------------------------------------------------
+//
+//   RegexDFACache
+//
+//------------------------------------------------------------------------------
+
+RegexDFACache::RegexDFACache(const RegexNFA *nfa, ScanKind kind, UErrorCode &status) :
+        fNFA(nfa), fKind(kind),
+        fStateData(status), fStateOffsets(status), fTransitions(status),
+        fHashTable(NULL), fHashSize(0),
+        fMarks(NULL), fMembers(NULL), fMarkGeneration(0),
+        fStack(NULL), fWork(NULL), fWorkLength(0), fFlushes(0) {
+    if (U_FAILURE(status)) {
+        return;
+    }
+    int32_t nodeCount = nfa->fNodeCount;
+    fHashSize  = INITIAL_HASH_SIZE;
+    fHashTable = (int32_t *)uprv_malloc(fHashSize * sizeof(int32_t));
+    fMarks     = (int32_t *)uprv_malloc(nodeCount * sizeof(int32_t));
+    fMembers   = (int32_t *)uprv_malloc(nodeCount * sizeof(int32_t));
+    fStack     = (int32_t *)uprv_malloc((2 * nodeCount + 1) * sizeof(int32_t));
+    fWork      = (int32_t *)uprv_malloc(nodeCount * sizeof(int32_t));
+    if (fHashTable == NULL || fMarks == NULL || fMembers == NULL || fStack == NULL || fWork == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    uprv_memset(fMarks, 0, nodeCount * sizeof(int32_t));
+    uprv_memset(fMembers, 0, nodeCount * sizeof(int32_t));
+    flush();
+}
+
+
+RegexDFACache::~RegexDFACache() {
+    uprv_free(fHashTable);
+    uprv_free(fMarks);
+    uprv_free(fMembers);
+    uprv_free(fStack);
+    uprv_free(fWork);
+}
+
+
+void RegexDFACache::flush() {
+    fStateData.removeAllElements();
+    fStateOffsets.removeAllElements();
+    fTransitions.removeAllElements();
+    uprv_memset(fHashTable, 0xff, fHashSize * sizeof(int32_t));
+    for (int32_t i = 0; i < kWideCacheSize; i++) {
+        fWideStates[i] = -1;
+    }
+}
+
+
+void RegexDFACache::beginScan() {
+    fFlushes = 0;
+}
+
+
+//
+//  sortSetState    Sort the nodes of a set state, making it canonical, with the match
+//                  nodes first.  Returns the flags of the state.
+//
+static int32_t sortSetState(int32_t *nodes, int32_t length, int32_t setSize, UErrorCode &status) {
+    uprv_sortArray(nodes, length, sizeof(int32_t), uprv_int32Comparator, NULL, FALSE, &status);
+    return length > 0 && nodes[0] < setSize ? RegexDFACache::kMatch : 0;
+}
+
+
+//
+//  newGeneration    Start a fresh set of marks, without clearing the mark arrays.
+//
+static inline void newGeneration(int32_t &generation, int32_t *marks, int32_t *members, int32_t count) {
+    if (++generation == INT32_MAX) {
+        uprv_memset(marks, 0, count * sizeof(int32_t));
+        uprv_memset(members, 0, count * sizeof(int32_t));
+        generation = 1;
+    }
+}
+
+
+int32_t RegexDFACache::startState(UErrorCode &status) {
+    newGeneration(fMarkGeneration, fMarks, fMembers, fNFA->fNodeCount);
+    fWorkLength = 0;
+    int32_t flags;
+    if (fKind == kReverseScan) {
+        // The nodes from which the end of the pattern can be reached without input.
+        fMarks[fNFA->fMatchNode] = fMarkGeneration;
+        fWork[fWorkLength++] = fNFA->fMatchNode;
+        addReverseClosure();
+        flags = fMarks[fNFA->fStartNode] == fMarkGeneration ? kHasStart : 0;
+    } else if (fKind == kSetScan) {
+        addSetClosure(fNFA->fStartNode);
+        flags = sortSetState(fWork, fWorkLength, fNFA->fSetSize, status);
+    } else {
+        flags = addClosure(fNFA->fStartNode) ? kMatch : kSearching;
+    }
+    return addState(flags, status);
+}
+
+
+//
+//  addClosure    Forward: add the consuming nodes reachable from node without input
+//                to fWork, in priority order.  Returns TRUE if the end of the pattern
+//                is reached; the nodes of lower priority paths are then left out.
+//
+UBool RegexDFACache::addClosure(int32_t node) {
+    const RegexNFA::Node *nodes = fNFA->fNodes;
+    int32_t sp = 0;
+    fStack[sp++] = node;
+    while (sp > 0) {
+        int32_t n = fStack[--sp];
+        if (fMarks[n] == fMarkGeneration) {
+            continue;
+        }
+        fMarks[n] = fMarkGeneration;
+        switch (nodes[n].fType) {
+        case RegexNFA::kEps:
+            fStack[sp++] = nodes[n].fNext;
+            break;
+        case RegexNFA::kSplit:
+            fStack[sp++] = nodes[n].fAlt;
+            fStack[sp++] = nodes[n].fNext;
+            break;
+        case RegexNFA::kMatch:
+            return TRUE;
+        case RegexNFA::kFail:
+            break;
+        default:
+            fWork[fWorkLength++] = n;
+            break;
+        }
+    }
+    return FALSE;
+}
+
+
+//
+//  addSetClosure    Set: add the consuming and match nodes reachable from node without
+//                   input to fWork.
+//
+void RegexDFACache::addSetClosure(int32_t node) {
+    const RegexNFA::Node *nodes = fNFA->fNodes;
+    int32_t sp = 0;
+    fStack[sp++] = node;
+    while (sp > 0) {
+        int32_t n = fStack[--sp];
+        if (fMarks[n] == fMarkGeneration) {
+            continue;
+        }
+        fMarks[n] = fMarkGeneration;
+        switch (nodes[n].fType) {
+        case RegexNFA::kEps:
+            fStack[sp++] = nodes[n].fNext;
+            break;
+        case RegexNFA::kSplit:
+            fStack[sp++] = nodes[n].fAlt;
+            fStack[sp++] = nodes[n].fNext;
+            break;
+        case RegexNFA::kFail:
+            break;
+        default:
+            fWork[fWorkLength++] = n;
+            break;
+        }
+    }
+}
+
+
+//
+//  addReverseClosure    Reverse: add to the nodes in fWork all the nodes that lead to
+//                       them without input, then sort fWork, making the state canonical.
+//
+void RegexDFACache::addReverseClosure() {
+    for (int32_t i = 0; i < fWorkLength; i++) {
+        int32_t n = fWork[i];
+        for (int32_t p = fNFA->fPredecessorStart[n]; p < fNFA->fPredecessorStart[n + 1]; p++) {
+            int32_t pred = fNFA->fPredecessors[p];
+            if (fMarks[pred] != fMarkGeneration) {
+                fMarks[pred] = fMarkGeneration;
+                fWork[fWorkLength++] = pred;
+            }
+        }
+    }
+    if (fWorkLength > 1) {
+        fWorkLength = 0;
+        for (int32_t n = 0; n < fNFA->fNodeCount; n++) {
+            if (fMarks[n] == fMarkGeneration) {
+                fWork[fWorkLength++] = n;
+            }
+        }
+    }
+}
+
+
+int32_t RegexDFACache::computeNext(int32_t state, UChar32 c, UErrorCode &status) {
+    const int32_t *data   = fStateData.getBuffer() + fStateOffsets.getBuffer()[state];
+    int32_t        flags  = data[0];
+    int32_t        length = data[1];
+    const int32_t *nodes  = data + 2;
+
+    newGeneration(fMarkGeneration, fMarks, fMembers, fNFA->fNodeCount);
+    fWorkLength = 0;
+    int32_t newFlags;
+    if (fKind == kReverseScan) {
+        for (int32_t i = 0; i < length; i++) {
+            fMembers[nodes[i]] = fMarkGeneration;
+        }
+        for (int32_t i = 0; i < fNFA->fConsumerCount; i++) {
+            int32_t n = fNFA->fConsumers[i];
+            int32_t t = fNFA->target(n, c);
+            if (t >= 0 && fMembers[t] == fMarkGeneration) {
+                fMarks[n] = fMarkGeneration;
+                fWork[fWorkLength++] = n;
+            }
+        }
+        addReverseClosure();
+        newFlags = fWorkLength > 0 && fMarks[fNFA->fStartNode] == fMarkGeneration ? kHasStart : 0;
+    } else if (fKind == kSetScan) {
+        for (int32_t i = 0; i < length; i++) {
+            int32_t t = fNFA->target(nodes[i], c);
+            if (t >= 0) {
+                addSetClosure(t);
+            }
+        }
+        addSetClosure(fNFA->fStartNode);
+        newFlags = sortSetState(fWork, fWorkLength, fNFA->fSetSize, status);
+    } else {
+        UBool matched = FALSE;
+        for (int32_t i = 0; i < length && !matched; i++) {
+            int32_t t = fNFA->target(nodes[i], c);
+            if (t >= 0) {
+                matched = addClosure(t);
+            }
+        }
+        if (!matched && (flags & kSearching) != 0) {
+            matched = addClosure(fNFA->fStartNode);
+        }
+        newFlags = matched ? kMatch : (flags & kSearching);
+    }
+
+    int32_t flushes = fFlushes;
+    int32_t result  = kDead;
+    if (fWorkLength > 0 || newFlags != 0) {
+        result = addState(newFlags, status);
+        if (result == kGaveUp) {
+            return result;
+        }
+    }
+    // Remember the transition, unless a flush took the old state with it.
+    if (fFlushes == flushes) {
+        if (c < 256) {
+            fTransitions.getBuffer()[state * fNFA->fClassCount + fNFA->fClassMap[c]] = result;
+        } else {
+            int32_t slot = (state * 31 + c) & (kWideCacheSize - 1);
+            fWideStates[slot] = state;
+            fWideChars[slot]  = c;
+            fWideNext[slot]   = result;
+        }
+    }
+    return result;
+}
+
+
+static inline int32_t hashState(int32_t flags, const int32_t *nodes, int32_t length) {
+    uint32_t hash = (uint32_t)flags;
+    for (int32_t i = 0; i < length; i++) {
+        hash = hash * 37 + (uint32_t)nodes[i];
+    }
+    return (int32_t)((hash ^ (hash >> 15)) & 0x7fffffff);
+}
+
+
+//
+//  addState    Find or add the state with the given flags and the nodes in fWork.
+//
+int32_t RegexDFACache::addState(int32_t flags, UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return kGaveUp;
+    }
+    int32_t mask = fHashSize - 1;
+    int32_t slot = hashState(flags, fWork, fWorkLength) & mask;
+    for (;;) {
+        int32_t s = fHashTable[slot];
+        if (s < 0) {
+            break;
+        }
+        const int32_t *data = fStateData.getBuffer() + fStateOffsets.getBuffer()[s];
+        if (data[0] == flags && data[1] == fWorkLength &&
+                uprv_memcmp(data + 2, fWork, fWorkLength * sizeof(int32_t)) == 0) {
+            return s;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    // A new state.  Flush the cache first if it would outgrow its budget.
+    if (fStateData.size() + fTransitions.size() + fWorkLength + 2 + fNFA->fClassCount > MAX_DFA_CACHE_SIZE) {
+        if (++fFlushes > MAX_DFA_FLUSHES) {
+            return kGaveUp;
+        }
+        flush();
+        return addState(flags, status);
+    }
+
+    int32_t stateNum = fStateOffsets.size();
+    if (stateNum * 2 >= fHashSize) {
+        int32_t *newTable = (int32_t *)uprv_malloc(fHashSize * 2 * sizeof(int32_t));
+        if (newTable == NULL) {
+            status = U_MEMORY_ALLOCATION_ERROR;
+            return kGaveUp;
+        }
+        uprv_free(fHashTable);
+        fHashTable = newTable;
+        fHashSize *= 2;
+        mask = fHashSize - 1;
+        uprv_memset(fHashTable, 0xff, fHashSize * sizeof(int32_t));
+        for (int32_t s = 0; s < stateNum; s++) {
+            const int32_t *data = fStateData.getBuffer() + fStateOffsets.getBuffer()[s];
+            int32_t i = hashState(data[0], data + 2, data[1]) & mask;
+            while (fHashTable[i] >= 0) {
+                i = (i + 1) & mask;
+            }
+            fHashTable[i] = s;
+        }
+        slot = hashState(flags, fWork, fWorkLength) & mask;
+        while (fHashTable[slot] >= 0) {
+            slot = (slot + 1) & mask;
+        }
+    }
+
+    int32_t offset = fStateData.size();
+    int32_t *data = fStateData.reserveBlock(fWorkLength + 2, status);
+    int32_t *transitions = fTransitions.reserveBlock(fNFA->fClassCount, status);
+    fStateOffsets.addElement(offset, status);
+    if (U_FAILURE(status)) {
+        return kGaveUp;
+    }
+    data[0] = flags;
+    data[1] = fWorkLength;
+    uprv_memcpy(data + 2, fWork, fWorkLength * sizeof(int32_t));
+    for (int32_t i = 0; i < fNFA->fClassCount; i++) {
+        transitions[i] = kUnknown;
+    }
+    fHashTable[slot] = stateNum;
+    return stateNum;
+}
+
+
+//------------------------------------------------------------------------------
+//
+//   RegexLazyDFA
+//
+//------------------------------------------------------------------------------
+
+RegexLazyDFA::RegexLazyDFA(const RegexNFA *nfa, UErrorCode &status) :
+        fForward(nfa, RegexDFACache::kForwardScan, status),
+        fReverse(nfa, RegexDFACache::kReverseScan, status) {
+}
+
+
+RegexLazyDFA::~RegexLazyDFA() {
+}
+
+
+int32_t RegexLazyDFA::findMatchStart(const UChar *input, int32_t start, int32_t limit, UChar32 firstChar,
+                                     UBool &hitEnd, UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return kGaveUp;
+    }
+
+    // Scan forward for the end of the leftmost match.  Until some thread reaches the
+    //   end of the pattern, a new thread starts at each position, with the lowest
+    //   priority.  Once one does, the threads of lower priority are dropped, and the
+    //   others run until they die out, each match they reach moving the end forward.
+    //   While only the thread started at the current position is alive, the scan is
+    //   in the start state, and can skip to the next occurrence of firstChar.
+    fForward.beginScan();
+    int32_t state    = fForward.startState(status);
+    int32_t idle     = firstChar >= 0 && firstChar <= 0xffff ? state : RegexDFACache::kDead;
+    int32_t matchEnd = kNoMatch;
+    int32_t idx      = start;
+    while (state >= 0) {
+        if ((fForward.flags(state) & RegexDFACache::kMatch) != 0) {
+            matchEnd = idx;
+        } else if (state == idle && fForward.flushes() == 0) {
+            // A flush may have renumbered the start state; stop skipping then.
+            const UChar *p = u_memchr(input + idx, (UChar)firstChar, limit - idx);
+            idx = p != NULL ? (int32_t)(p - input) : limit;
+        }
+        if (idx >= limit) {
+            break;
+        }
+        UChar32 c;
+        U16_NEXT(input, idx, limit, c);
+        state = fForward.next(state, c, status);
+    }
+    if (state == RegexDFACache::kGaveUp) {
+        return kGaveUp;
+    }
+    if (matchEnd < 0) {
+        return kNoMatch;
+    }
+    // Threads still alive at the limit would have read past it.  None started after the
+    //   match start, so the match engine would have seen the end of input while trying
+    //   the match start or an earlier position.
+    if (state >= 0 && fForward.length(state) > 0) {
+        hitEnd = TRUE;
+    }
+
+    // Scan backward from the match end for the leftmost position the pattern can be
+    //   matched from.  No match starts before it, so that is where the leftmost match starts.
+    fReverse.beginScan();
+    state = fReverse.startState(status);
+    int32_t matchStart = kNoMatch;
+    idx = matchEnd;
+    while (state >= 0) {
+        if ((fReverse.flags(state) & RegexDFACache::kHasStart) != 0) {
+            matchStart = idx;
+        }
+        if (idx <= start) {
+            break;
+        }
+        UChar32 c;
+        U16_PREV(input, start, idx, c);
+        state = fReverse.next(state, c, status);
+    }
+    if (state == RegexDFACache::kGaveUp || matchStart < 0) {
+        return kGaveUp;
+    }
+    return matchStart;
+}
+
+
+//------------------------------------------------------------------------------
+//
+//   RegexSetDFA
+//
+//------------------------------------------------------------------------------
+
+RegexSetDFA::RegexSetDFA(const RegexNFA *nfa, UErrorCode &status) :
+        fNFA(nfa), fCache(nfa, RegexDFACache::kSetScan, status) {
+}
+
+
+RegexSetDFA::~RegexSetDFA() {
+}
+
+
+UBool RegexSetDFA::findMatches(const UChar *input, int32_t length, UBool *matched, UErrorCode &status) {
+    int32_t setSize = fNFA->fSetSize;
+    uprv_memset(matched, 0, setSize * sizeof(UBool));
+    if (U_FAILURE(status)) {
+        return FALSE;
+    }
+
+    // A new thread starts at every position, so the scan reaches each match of each
+    //   member.  It can stop early once every member has matched.
+    int32_t unmatched = setSize;
+    fCache.beginScan();
+    int32_t state = fCache.startState(status);
+    int32_t idx   = 0;
+    while (state >= 0) {
+        if ((fCache.flags(state) & RegexDFACache::kMatch) != 0) {
+            const int32_t *nodes       = fCache.nodes(state);
+            int32_t        stateLength = fCache.length(state);
+            for (int32_t i = 0; i < stateLength && nodes[i] < setSize; i++) {
+                if (!matched[nodes[i]]) {
+                    matched[nodes[i]] = TRUE;
+                    if (--unmatched == 0) {
+                        return TRUE;
+                    }
+                }
+            }
+        }
+        if (idx >= length) {
+            break;
+        }
+        UChar32 c;
+        U16_NEXT(input, idx, length, c);
+        state = fCache.next(state, c, status);
+    }
+    // A dead state means that no member can match any more.
+    return state != RegexDFACache::kGaveUp;
+}
+
+U_NAMESPACE_END
+
+#endif  // !UCONFIG_NO_REGULAR_EXPRESSIONS
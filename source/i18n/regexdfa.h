@@ -0,0 +1,276 @@
+// Copyright (C) 2016 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+//
+//  regexdfa.h
+//
+//  This file contains declarations for the classes RegexNFA, RegexDFACache,
+//  RegexLazyDFA and RegexSetDFA.
+//
+//  These classes are internal to the regular expression implementation.
+//  For the public Regular Expression API, see the file "unicode/regex.h"
+//
+//  Patterns that use nothing but characters, sets, literal strings, alternation
+//  and simple repetition describe a regular language, and find() does not need
+//  to backtrack to locate their matches.  For these patterns, the compiler
+//  builds a RegexNFA from the compiled pattern, and each matcher lazily turns it
+//  into a DFA, one state at a time as the input requires them.  find() uses the
+//  DFA to locate the start of the leftmost match in time linear in the input
+//  length, then runs the regular match engine once, from that start, to get the
+//  match end and the capture groups.
+//
+//  A RegexSet joins the NFAs of its patterns into one, and scans its input once
+//  with the resulting DFA to learn which of those patterns match.
+//
+
+#ifndef REGEXDFA_H
+#define REGEXDFA_H
+
+#include "unicode/utypes.h"
+#if !UCONFIG_NO_REGULAR_EXPRESSIONS
+
+#include "unicode/uobject.h"
+#include "uvectr32.h"
+
+U_NAMESPACE_BEGIN
+
+class RegexPattern;
+
+//
+//  RegexNFA    A Thompson NFA equivalent to a compiled pattern.
+//
+//              Built by the pattern compiler, for patterns without anchors, word
+//              boundaries, back references, look-around, atomic or possessive
+//              constructs, counted loops and the '.' of dot-all mode.  Immutable
+//              once built, and owned by its RegexPattern.
+//
+//              The split nodes keep the priorities of the match engine's state saves,
+//              so that a simulation that keeps its threads in priority order finds
+//              the same leftmost match as the backtracking engine.
+//
+class RegexNFA : public UMemory {
+  public:
+    // Create the NFA for a compiled pattern.
+    //   Returns NULL if the pattern uses constructs that the NFA can not express.
+    static RegexNFA *createNFA(const RegexPattern *pattern, UErrorCode &status);
+
+    // Create a set NFA, the alternation of the NFAs of several patterns, with a
+    //   match node for each of them.  For RegexSetDFA only; the reverse scan
+    //   of RegexLazyDFA is not supported.
+    static RegexNFA *createSetNFA(const RegexNFA * const *members, int32_t count, UErrorCode &status);
+    ~RegexNFA();
+
+    enum NodeType {
+        kEps,           // Empty transition to fNext.
+        kSplit,         // Empty transitions to fNext, then, with lower priority, to fAlt.
+        kMatch,         // End of the pattern.
+        kFail,          // No transitions.
+        // Nodes above this point consume no input; the following ones each consume one code point.
+        kChar,          // fValue is the code point.
+        kCharI,         // fValue is the case folded code point.
+        kStringI,       // Position in a case folded string.  fValue is the index in the
+                        //   pattern's literal text, fValue2 the remaining length of the string.
+        kSet,           // fValue is the index of the set in the pattern's sets.
+        kStaticSet,     // fValue is the index of the static set, fValue2 is TRUE if negated.
+        kDot,           // fValue is TRUE in UNIX_LINES mode.
+        kDigit,         // \d.  fValue is TRUE if negated.
+        kHSpace,        // \h.  fValue is TRUE if negated.
+        kVSpace         // \v.  fValue is TRUE if negated.
+    };
+
+    struct Node {
+        const RegexPattern *fPattern;   // The pattern whose sets and literal text the node refers to.
+        int32_t     fType;
+        int32_t     fValue;
+        int32_t     fValue2;
+        int32_t     fNext;
+        int32_t     fAlt;
+    };
+
+    // The node following a consuming node that matched c, or -1 if c does not match.
+    int32_t     target(int32_t node, UChar32 c) const;
+
+    const RegexPattern *fPattern;
+    Node       *fNodes;
+    int32_t     fNodeCount;
+    int32_t     fStartNode;
+    int32_t     fMatchNode;
+    int32_t     fSetSize;           // Set NFA: the number of members.  Nodes 0 .. fSetSize-1
+                                    //   are their match nodes; fValue is the member index.
+
+    int32_t    *fConsumers;         // The consuming nodes, in ascending order.
+    int32_t     fConsumerCount;
+
+    int32_t    *fPredecessors;      // The nodes with an empty transition to node n are
+    int32_t    *fPredecessorStart;  //   fPredecessors[fPredecessorStart[n] .. fPredecessorStart[n+1]).
+
+    // Latin-1 code points that no node of the NFA can tell apart share a class,
+    //   so that DFA states need a transition per class rather than per code point.
+    uint8_t     fClassMap[256];     // Class of each Latin-1 code point.
+    int32_t     fClassCount;
+
+  private:
+    RegexNFA(const RegexPattern *pattern);
+    void        build(UErrorCode &status);
+    void        buildClasses();
+};
+
+
+//
+//  RegexDFACache    The DFA states built so far for one direction of a RegexLazyDFA,
+//                   or for a RegexSetDFA.
+//
+//                   A forward state is the list of consuming NFA nodes reachable at
+//                   an input position, in priority order.  Lower priority threads are
+//                   dropped once a thread reaches the end of the pattern.
+//                   A reverse state is the set of NFA nodes from which the input
+//                   between its position and the end of the match found by the
+//                   forward scan can be matched.
+//                   A set state is the set of consuming and match nodes of a set NFA
+//                   reachable at an input position, with a new thread starting at
+//                   every position.  Its match nodes, if any, come first.
+//
+//                   When the cache outgrows its memory budget, it is flushed and
+//                   rebuilt as the scan continues.
+//
+class RegexDFACache : public UMemory {
+  public:
+    enum ScanKind {
+        kForwardScan,
+        kReverseScan,
+        kSetScan
+    };
+
+    RegexDFACache(const RegexNFA *nfa, ScanKind kind, UErrorCode &status);
+    ~RegexDFACache();
+
+    enum {
+        kUnknown = -1,      // Transition not computed yet.
+        kDead    = -2,      // No thread survives.
+        kGaveUp  = -3       // The cache was flushed too often during one scan, or an error occurred.
+    };
+
+    enum {
+        kMatch     = 1,     // Forward, set: a thread reached the end of a pattern.
+        kSearching = 2,     // Forward: no match found yet, a new thread starts at each position.
+        kHasStart  = 4      // Reverse: the start of the pattern is in the set.
+    };
+
+    void            beginScan();
+    int32_t         startState(UErrorCode &status);
+    inline int32_t  next(int32_t state, UChar32 c, UErrorCode &status);
+    inline int32_t  flags(int32_t state) const;
+    inline int32_t  length(int32_t state) const;
+    inline const int32_t *nodes(int32_t state) const;
+    int32_t         flushes() const { return fFlushes; }
+
+  private:
+    int32_t         computeNext(int32_t state, UChar32 c, UErrorCode &status);
+    UBool           addClosure(int32_t node);
+    void            addReverseClosure();
+    void            addSetClosure(int32_t node);
+    int32_t         addState(int32_t flags, UErrorCode &status);
+    void            flush();
+
+    const RegexNFA *fNFA;
+    ScanKind        fKind;
+
+    UVector32       fStateData;     // For each state, its flags, its length and its nodes.
+    UVector32       fStateOffsets;  // Index of each state in fStateData.
+    UVector32       fTransitions;   // Next state, for each state and Latin-1 class.
+    int32_t        *fHashTable;     // Open addressing table of state numbers, -1 if empty.
+    int32_t         fHashSize;
+
+    enum { kWideCacheSize = 256 };
+    int32_t         fWideStates[kWideCacheSize];    // Direct mapped cache of recent
+    UChar32         fWideChars[kWideCacheSize];     //   transitions on code points
+    int32_t         fWideNext[kWideCacheSize];      //   beyond Latin-1.
+
+    int32_t        *fMarks;         // Per NFA node, fMarkGeneration when visited.
+    int32_t        *fMembers;       // Per NFA node, fMarkGeneration when in the state being left (reverse).
+    int32_t         fMarkGeneration;
+    int32_t        *fStack;
+    int32_t        *fWork;          // Nodes of the state being computed.
+    int32_t         fWorkLength;
+
+    int32_t         fFlushes;       // Flushes during the current scan.
+};
+
+inline int32_t RegexDFACache::flags(int32_t state) const {
+    return fStateData.getBuffer()[fStateOffsets.getBuffer()[state]];
+}
+
+inline int32_t RegexDFACache::length(int32_t state) const {
+    return fStateData.getBuffer()[fStateOffsets.getBuffer()[state] + 1];
+}
+
+inline const int32_t *RegexDFACache::nodes(int32_t state) const {
+    return fStateData.getBuffer() + fStateOffsets.getBuffer()[state] + 2;
+}
+
+inline int32_t RegexDFACache::next(int32_t state, UChar32 c, UErrorCode &status) {
+    if (c < 256) {
+        int32_t n = fTransitions.getBuffer()[state * fNFA->fClassCount + fNFA->fClassMap[c]];
+        if (n != kUnknown) {
+            return n;
+        }
+    } else {
+        int32_t slot = (state * 31 + c) & (kWideCacheSize - 1);
+        if (fWideStates[slot] == state && fWideChars[slot] == c) {
+            return fWideNext[slot];
+        }
+    }
+    return computeNext(state, c, status);
+}
+
+
+//
+//  RegexLazyDFA    The DFA for a matcher.  Each RegexMatcher of a pattern with a
+//                  RegexNFA has its own, created on the first find().
+//
+class RegexLazyDFA : public UMemory {
+  public:
+    RegexLazyDFA(const RegexNFA *nfa, UErrorCode &status);
+    ~RegexLazyDFA();
+
+    enum {
+        kNoMatch = -1,      // There is no match.
+        kGaveUp  = -2       // Use the backtracking engine instead.
+    };
+
+    // Find the start of the leftmost match in input[start, limit).
+    //   Returns the match start, kNoMatch or kGaveUp.
+    //   Sets hitEnd if, while searching, the backtracking engine would have touched
+    //   the limit in attempts to match at positions before the match start.
+    //   firstChar is the BMP code point that every match starts with, or -1 if there
+    //   is none; the scan skips the input between possible match starts with u_memchr().
+    int32_t     findMatchStart(const UChar *input, int32_t start, int32_t limit, UChar32 firstChar,
+                               UBool &hitEnd, UErrorCode &status);
+
+  private:
+    RegexDFACache   fForward;
+    RegexDFACache   fReverse;
+};
+
+
+//
+//  RegexSetDFA    The DFA for the members of a RegexSet that have a RegexNFA.
+//
+class RegexSetDFA : public UMemory {
+  public:
+    // nfa is a set NFA, owned by the caller.
+    RegexSetDFA(const RegexNFA *nfa, UErrorCode &status);
+    ~RegexSetDFA();
+
+    // Find which members match somewhere in input[0, length).
+    //   Sets matched[i] to TRUE or FALSE for each member i.
+    //   Returns FALSE if the scan gave up; the backtracking engine must then be used.
+    UBool       findMatches(const UChar *input, int32_t length, UBool *matched, UErrorCode &status);
+
+  private:
+    const RegexNFA *fNFA;
+    RegexDFACache   fCache;
+};
+
+U_NAMESPACE_END
+#endif   // !UCONFIG_NO_REGULAR_EXPRESSIONS
+#endif   // REGEXDFA_H
@@ -14,6 +14,7 @@
 
 #if !UCONFIG_NO_REGULAR_EXPRESSIONS
 #include "regeximp.h"
+#include "unicode/utf8.h"
 #include "unicode/utf16.h"
 
 U_NAMESPACE_BEGIN
@@ -116,6 +117,57 @@ int64_t CaseFoldingUCharIterator::getIndex() {
 }
 
 
+CaseFoldingUTF8Iterator::CaseFoldingUTF8Iterator(const uint8_t *chars, int64_t start, int64_t limit) :
+   fChars(chars), fIndex((int32_t)start), fLimit((int32_t)limit), fcsp(NULL), fFoldChars(NULL), fFoldLength(0) {
+   fcsp = ucase_getSingleton();
+}
+
+
+CaseFoldingUTF8Iterator::~CaseFoldingUTF8Iterator() {}
+
+
+UChar32 CaseFoldingUTF8Iterator::next() {
+    UChar32  foldedC;
+    UChar32  originalC;
+    if (fFoldChars == NULL) {
+        // We are not in a string folding of an earlier character.
+        // Start handling the next char from the input bytes.
+        if (fIndex >= fLimit) {
+            return U_SENTINEL;
+        }
+        U8_NEXT_OR_FFFD(fChars, fIndex, fLimit, originalC);
+
+        fFoldLength = ucase_toFullFolding(fcsp, originalC, &fFoldChars, U_FOLD_CASE_DEFAULT);
+        if (fFoldLength >= UCASE_MAX_STRING_LENGTH || fFoldLength < 0) {
+            // input code point folds to a single code point, possibly itself.
+            if (fFoldLength < 0) {
+                fFoldLength = ~fFoldLength;
+            }
+            foldedC = (UChar32)fFoldLength;
+            fFoldChars = NULL;
+            return foldedC;
+        }
+        // String foldings fall through here.
+        fFoldIndex = 0;
+    }
+
+    U16_NEXT(fFoldChars, fFoldIndex, fFoldLength, foldedC);
+    if (fFoldIndex >= fFoldLength) {
+        fFoldChars = NULL;
+    }
+    return foldedC;
+}
+
+
+UBool CaseFoldingUTF8Iterator::inExpansion() {
+    return fFoldChars != NULL;
+}
+
+int64_t CaseFoldingUTF8Iterator::getIndex() {
+    return fIndex;
+}
+
+
 U_NAMESPACE_END
 
 #endif
@@ -317,6 +317,22 @@ enum StartOfMatch {
                                (v)==START_STRING?  "START_STRING"  : \
                                                    "ILLEGAL")
 
+//
+//  Longest required string kept for find(), in UTF-16 code units.
+//    find() on UTF-8 input converts the string into a buffer of three times this size.
+//
+#define MAX_REQUIRED_STRING_LEN 32
+
+//
+//  Test for any of the Unicode line terminating characters.
+//
+inline UBool isLineTerminator(UChar32 c) {
+    if (c & ~(0x0a | 0x0b | 0x0c | 0x0d | 0x85 | 0x2028 | 0x2029)) {
+        return false;
+    }
+    return (c<=0x0d && c>=0x0a) || c==0x85 || c==0x2028 || c==0x2029;
+}
+
 //
 //  8 bit set, to fast-path latin-1 set membership tests.
 //
@@ -411,6 +427,37 @@ class CaseFoldingUCharIterator: public UMemory {
 
 };
 
+
+// Case folded UTF-8 string iterator.
+//  Wraps a UTF-8 byte string, provides a case-folded enumeration over its contents.
+//  Ill-formed sequences are returned as U+FFFD, the same as from a UTF-8 UText.
+//  Used in implementing case insensitive matching constructs on UTF-8 input.
+//  Implementation in regeximp.cpp
+
+class CaseFoldingUTF8Iterator: public UMemory {
+      public:
+        CaseFoldingUTF8Iterator(const uint8_t *chars, int64_t start, int64_t limit);
+        ~CaseFoldingUTF8Iterator();
+
+        UChar32 next();           // Next case folded character
+
+        UBool   inExpansion();    // True if last char returned from next() and the
+                                  //  next to be returned both originated from a string
+                                  //  folding of the same code point from the orignal text.
+
+        int64_t  getIndex();      // Return the current input buffer (byte) index.
+
+      private:
+        const  uint8_t    *fChars;
+        int32_t            fIndex;
+        int32_t            fLimit;
+        const  UCaseProps *fcsp;
+        const  UChar      *fFoldChars;
+        int32_t            fFoldLength;
+        int32_t            fFoldIndex;
+
+};
+
 U_NAMESPACE_END
 #endif
 
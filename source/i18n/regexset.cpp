@@ -0,0 +1,253 @@
+// Copyright (C) 2016 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+//
+//  file:  regexset.cpp
+//
+//         ICU Regular Expressions, RegexSet:  which of a list of patterns
+//         match an input string, found in one pass.
+//
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_REGULAR_EXPRESSIONS
+
+#include "unicode/regex.h"
+#include "unicode/uniset.h"
+#include "cmemory.h"
+#include "uvector.h"
+#include "regexdfa.h"
+#include "regeximp.h"
+
+U_NAMESPACE_BEGIN
+
+//--------------------------------------------------------------------------
+//
+//    RegexSet    Constructor.  Compiles the patterns, and joins the NFAs
+//                of those that have one into a single set NFA.
+//
+//--------------------------------------------------------------------------
+RegexSet::RegexSet(const UnicodeString patterns[], int32_t count, uint32_t flags,
+                   UParseError &pe, UErrorCode &status) :
+        fPatterns(NULL), fMatchers(NULL), fMemberIndexes(NULL), fMemberMatched(NULL),
+        fNFA(NULL), fDFA(NULL), fNeedStartChars(FALSE), fDeferredStatus(U_ZERO_ERROR) {
+    if (U_FAILURE(status)) {
+        fDeferredStatus = status;
+        return;
+    }
+    if (count < 0 || (count > 0 && patterns == NULL)) {
+        status = fDeferredStatus = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+
+    fPatterns      = new UVector(status);
+    fMatchers      = new UVector(status);
+    fMemberIndexes = (int32_t *)uprv_malloc((count + 1) * sizeof(int32_t));
+    fMemberMatched = (UBool *)uprv_malloc((count + 1) * sizeof(UBool));
+    LocalMemory<const RegexNFA *> members((const RegexNFA **)uprv_malloc((count + 1) * sizeof(RegexNFA *)));
+    if (U_SUCCESS(status) && (fPatterns == NULL || fMatchers == NULL ||
+            fMemberIndexes == NULL || fMemberMatched == NULL || members.isNull())) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+    }
+
+    int32_t memberCount = 0;
+    for (int32_t i = 0; i < count && U_SUCCESS(status); i++) {
+        RegexPattern *pat = RegexPattern::compile(patterns[i], flags, pe, status);
+        if (U_FAILURE(status)) {
+            break;
+        }
+        fPatterns->addElement(pat, status);
+        if (U_FAILURE(status)) {
+            delete pat;
+            break;
+        }
+        RegexMatcher *matcher = pat->matcher(status);
+        if (U_FAILURE(status)) {
+            delete matcher;
+            break;
+        }
+        fMatchers->addElement(matcher, status);
+        if (U_FAILURE(status)) {
+            delete matcher;
+            break;
+        }
+
+        if (pat->fNFA != NULL) {
+            fMemberIndexes[i] = memberCount;
+            members[memberCount++] = pat->fNFA;
+        } else {
+            fMemberIndexes[i] = -1;
+            if (pat->fStartType == START_CHAR || pat->fStartType == START_SET ||
+                    pat->fStartType == START_STRING) {
+                fNeedStartChars = TRUE;
+            }
+        }
+    }
+
+    if (U_SUCCESS(status) && memberCount > 0) {
+        fNFA = RegexNFA::createSetNFA(members.getAlias(), memberCount, status);
+        if (U_SUCCESS(status)) {
+            fDFA = new RegexSetDFA(fNFA, status);
+            if (fDFA == NULL) {
+                status = U_MEMORY_ALLOCATION_ERROR;
+            }
+        }
+    }
+    fDeferredStatus = status;
+}
+
+
+//--------------------------------------------------------------------------
+//
+//    Destructor
+//
+//--------------------------------------------------------------------------
+RegexSet::~RegexSet() {
+    delete fDFA;
+    delete fNFA;
+    int32_t i;
+    if (fMatchers != NULL) {
+        for (i = 0; i < fMatchers->size(); i++) {
+            delete (RegexMatcher *)fMatchers->elementAt(i);
+        }
+        delete fMatchers;
+    }
+    if (fPatterns != NULL) {
+        for (i = 0; i < fPatterns->size(); i++) {
+            delete (RegexPattern *)fPatterns->elementAt(i);
+        }
+        delete fPatterns;
+    }
+    uprv_free(fMemberIndexes);
+    uprv_free(fMemberMatched);
+}
+
+
+int32_t RegexSet::size() const {
+    return fPatterns == NULL ? 0 : fPatterns->size();
+}
+
+
+const RegexPattern *RegexSet::getPattern(int32_t index) const {
+    if (index < 0 || index >= size()) {
+        return NULL;
+    }
+    return (const RegexPattern *)fPatterns->elementAt(index);
+}
+
+
+//
+//  startCharsPresent    A pattern whose matches can only begin with one of its initial
+//                       characters can not match an input that contains none of them.
+//                       present holds the Latin-1 characters of the input, and
+//                       hasOtherChars tells whether it contains any others.
+//
+static UBool startCharsPresent(int32_t startType, const Regex8BitSet &initialChars8,
+                               const UnicodeSet &initialChars,
+                               const Regex8BitSet &present, UBool hasOtherChars) {
+    if (startType != START_CHAR && startType != START_SET && startType != START_STRING) {
+        return TRUE;
+    }
+    for (int32_t i = 0; i < UPRV_LENGTHOF(present.d); i++) {
+        if ((initialChars8.d[i] & present.d[i]) != 0) {
+            return TRUE;
+        }
+    }
+    return hasOtherChars && !initialChars.containsNone(0x100, 0x10ffff);
+}
+
+
+//--------------------------------------------------------------------------
+//
+//    find
+//
+//--------------------------------------------------------------------------
+int32_t RegexSet::find(const UnicodeString &input, int32_t *indexes, int32_t *starts, int32_t *ends,
+                       int32_t capacity, UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    if (U_FAILURE(fDeferredStatus)) {
+        status = fDeferredStatus;
+        return 0;
+    }
+    const UChar *inputBuf    = input.getBuffer();
+    int32_t      inputLength = input.length();
+    if (inputBuf == NULL || capacity < 0 || (capacity > 0 && indexes == NULL)) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+
+    // One scan of the input finds which of the members of the set NFA match.
+    //   Should it give up, each member is run by its own matcher instead.
+    UBool scanned = fDFA != NULL && fDFA->findMatches(inputBuf, inputLength, fMemberMatched, status);
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+
+    // Another collects the characters that the other patterns' matches could start with.
+    Regex8BitSet present;
+    UBool        hasOtherChars = FALSE;
+    if (fNeedStartChars) {
+        for (int32_t i = 0; i < inputLength; i++) {
+            UChar c = inputBuf[i];
+            if (c < 256) {
+                present.add(c);
+            } else {
+                hasOtherChars = TRUE;
+            }
+        }
+    }
+
+    int32_t matchCount = 0;
+    for (int32_t i = 0; i < fPatterns->size(); i++) {
+        const RegexPattern *pat     = (const RegexPattern *)fPatterns->elementAt(i);
+        RegexMatcher       *matcher = (RegexMatcher *)fMatchers->elementAt(i);
+        int32_t             member  = fMemberIndexes[i];
+        UBool               matched;
+        UBool               located = FALSE;    // TRUE if matcher holds the first match.
+        if (member >= 0 && scanned) {
+            matched = fMemberMatched[member];
+        } else if (member < 0 && fNeedStartChars &&
+                !startCharsPresent(pat->fStartType, *pat->fInitialChars8, *pat->fInitialChars,
+                                   present, hasOtherChars)) {
+            matched = FALSE;
+        } else {
+            matched = matcher->reset(input).find(status);
+            located = TRUE;
+        }
+        if (U_FAILURE(status)) {
+            return 0;
+        }
+        if (!matched) {
+            continue;
+        }
+        if (matchCount < capacity) {
+            indexes[matchCount] = i;
+            if (starts != NULL || ends != NULL) {
+                if (!located) {
+                    matcher->reset(input).find(status);
+                }
+                if (starts != NULL) {
+                    starts[matchCount] = matcher->start(status);
+                }
+                if (ends != NULL) {
+                    ends[matchCount] = matcher->end(status);
+                }
+                if (U_FAILURE(status)) {
+                    return 0;
+                }
+            }
+        }
+        matchCount++;
+    }
+    if (matchCount > capacity) {
+        status = U_BUFFER_OVERFLOW_ERROR;
+    }
+    return matchCount;
+}
+
+UOBJECT_DEFINE_RTTI_IMPLEMENTATION(RegexSet)
+
+U_NAMESPACE_END
+
+#endif  // !UCONFIG_NO_REGULAR_EXPRESSIONS
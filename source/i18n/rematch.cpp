@@ -22,6 +22,7 @@
 #include "unicode/ustring.h"
 #include "unicode/rbbi.h"
 #include "unicode/utf.h"
+#include "unicode/utf8.h"
 #include "unicode/utf16.h"
 #include "uassert.h"
 #include "cmemory.h"
@@ -29,10 +30,12 @@
 #include "uvector.h"
 #include "uvectr32.h"
 #include "uvectr64.h"
+#include "regexdfa.h"
 #include "regeximp.h"
 #include "regexst.h"
 #include "regextxt.h"
 #include "ucase.h"
+#include "ustr_imp.h"
 
 // #include <malloc.h>        // Needed for heapcheck testing
 
@@ -54,13 +57,110 @@ static const int32_t DEFAULT_BACKTRACK_STACK_CAPACITY = 8000000;
 static const int32_t TIMER_INITIAL_VALUE = 10000;
 
 
-// Test for any of the Unicode line terminating characters.
-static inline UBool isLineTerminator(UChar32 c) {
-    if (c & ~(0x0a | 0x0b | 0x0c | 0x0d | 0x85 | 0x2028 | 0x2029)) {
-        return false;
+// Code unit access for the chunk match engine, MatchChunkAt(), which runs either
+//   on the UTF-16 chunk of the input UText or directly on the bytes of a UTF-8
+//   UText.  Indexes are code unit indexes in both cases.
+//   Ill-formed UTF-8 sequences yield U+FFFD, as they do from a UTF-8 UText.
+template<typename CharT> struct ChunkChars;
+
+template<> struct ChunkChars<UChar> {
+    typedef CaseFoldingUCharIterator CaseFoldingIterator;
+    static const UBool   IS_UTF8 = FALSE;
+    static const int32_t MAX_LINE_END_LENGTH = 2;         // CR LF
+    static const int32_t MAX_LENGTH_PER_UTF16_UNIT = 1;
+
+    template<typename IndexT>
+    static inline UChar32 next(const UChar *s, IndexT &i, int64_t limit) {
+        UChar32 c;
+        U16_NEXT(s, i, limit, c);
+        return c;
     }
-    return (c<=0x0d && c>=0x0a) || c==0x85 || c==0x2028 || c==0x2029;
-}
+    static inline UChar32 prev(const UChar *s, int64_t start, int64_t &i) {
+        UChar32 c;
+        U16_PREV(s, start, i, c);
+        return c;
+    }
+    static inline void setCpStart(const UChar *s, int64_t &i) {
+        U16_SET_CP_START(s, 0, i);
+    }
+    static inline void back1(const UChar *s, int64_t &i) {
+        U16_BACK_1(s, 0, i);
+    }
+    // Match the literal string at i, advancing i past it on success.
+    static inline UBool matchString(const UChar *s, int64_t &i, int64_t limit,
+                                    const UChar *str, int32_t strLength, UBool &hitEnd) {
+        const UChar * pInp = s + i;
+        const UChar * pInpLimit = s + limit;
+        const UChar * pEnd = pInp + strLength;
+        while (pInp < pEnd) {
+            if (pInp >= pInpLimit) {
+                hitEnd = TRUE;
+                return FALSE;
+            }
+            if (*pInp++ != *str++) {
+                return FALSE;
+            }
+        }
+        i += strLength;
+        return TRUE;
+    }
+};
+
+template<> struct ChunkChars<uint8_t> {
+    typedef CaseFoldingUTF8Iterator CaseFoldingIterator;
+    static const UBool   IS_UTF8 = TRUE;
+    static const int32_t MAX_LINE_END_LENGTH = 3;         // U+2028, U+2029
+    // The pattern compiler measures match lengths in UTF-16 code units.
+    static const int32_t MAX_LENGTH_PER_UTF16_UNIT = 3;
+
+    template<typename IndexT>
+    static inline UChar32 next(const uint8_t *s, IndexT &i, int64_t limit) {
+        int32_t ix = (int32_t)i;
+        UChar32 c;
+        U8_NEXT_OR_FFFD(s, ix, (int32_t)limit, c);
+        i = ix;
+        return c;
+    }
+    static inline UChar32 prev(const uint8_t *s, int64_t start, int64_t &i) {
+        int32_t ix = (int32_t)i;
+        UChar32 c;
+        U8_PREV_OR_FFFD(s, (int32_t)start, ix, c);
+        i = ix;
+        return c;
+    }
+    static inline void setCpStart(const uint8_t *s, int64_t &i) {
+        int32_t ix = (int32_t)i;
+        U8_SET_CP_START(s, 0, ix);
+        i = ix;
+    }
+    static inline void back1(const uint8_t *s, int64_t &i) {
+        int32_t ix = (int32_t)i;
+        U8_BACK_1(s, 0, ix);
+        i = ix;
+    }
+    // Match the UTF-16 literal string at i, advancing i past it on success.
+    //   Compares code point by code point.
+    static inline UBool matchString(const uint8_t *s, int64_t &i, int64_t limit,
+                                    const UChar *str, int32_t strLength, UBool &hitEnd) {
+        int32_t ix = (int32_t)i;
+        int32_t strIdx = 0;
+        while (strIdx < strLength) {
+            if (ix >= limit) {
+                hitEnd = TRUE;
+                return FALSE;
+            }
+            UChar32 inputChar;
+            UChar32 strChar;
+            U8_NEXT_OR_FFFD(s, ix, (int32_t)limit, inputChar);
+            U16_NEXT(str, strIdx, strLength, strChar);
+            if (inputChar != strChar) {
+                return FALSE;
+            }
+        }
+        i = ix;
+        return TRUE;
+    }
+};
 
 //-----------------------------------------------------------------------------
 //
@@ -178,6 +278,7 @@ RegexMatcher::~RegexMatcher() {
     #if UCONFIG_NO_BREAK_ITERATION==0
     delete fWordBreakItr;
     #endif
+    delete fDFA;
 }
 
 //
@@ -228,7 +329,9 @@ void RegexMatcher::init(UErrorCode &status) {
     fAltInputText      = NULL;
     fInput             = NULL;
     fInputLength       = 0;
+    fInputUTF8         = NULL;
     fInputUniStrMaybeMutable = FALSE;
+    fDFA               = NULL;
 }
 
 //
@@ -635,6 +738,9 @@ UBool RegexMatcher::find(UErrorCode &status) {
         return FALSE;
     }
 
+    if (fInputUTF8 != NULL) {
+        return findUsingChunkUTF8(status);
+    }
     if (UTEXT_FULL_TEXT_IN_CHUNK(fInputText, fInputLength)) {
         return findUsingChunk(status);
     }
@@ -911,6 +1017,111 @@ UBool RegexMatcher::find(int64_t start, UErrorCode &status) {
 }
 
 
+//--------------------------------------------------------------------------------
+//
+//   skipToRequiredString()  For patterns with a required string, find its next
+//                           occurrence at or after startPos, and set requiredPos to it.
+//                           No match can start after that occurrence without reaching
+//                           a later one, and none can start more than the pattern's
+//                           required string offset before it; move startPos up to
+//                           that point if it is before it.
+//
+//                           Return FALSE if there is no further occurrence, and so
+//                           no further match.
+//
+//                           Starts that are skipped here could not have reached the end
+//                           of the input, so hitEnd() is unaffected.  That holds for
+//                           strings of two or more code units; with one, $ just before
+//                           a final line end could, so those strings never move startPos.
+//
+//--------------------------------------------------------------------------------
+UBool RegexMatcher::skipToRequiredString(const UChar *inputBuf, int32_t &startPos, int32_t &requiredPos) {
+    const UChar *required       = fPattern->fLiteralText.getBuffer() + fPattern->fRequiredStringIdx;
+    int32_t      requiredLength = fPattern->fRequiredStringLen;
+    int32_t      lastPos        = (int32_t)fActiveLimit - requiredLength;
+    int32_t      pos            = startPos;
+    for (;;) {
+        if (pos > lastPos) {
+            return FALSE;
+        }
+        const UChar *p;
+        if (U16_IS_SURROGATE(required[0])) {
+            // u_memchr() will not find a surrogate that is part of a pair.
+            for (p = inputBuf + pos; *p != required[0]; p++) {
+                if (p >= inputBuf + lastPos) {
+                    return FALSE;
+                }
+            }
+        } else {
+            p = u_memchr(inputBuf + pos, required[0], lastPos - pos + 1);
+            if (p == NULL) {
+                return FALSE;
+            }
+        }
+        pos = (int32_t)(p - inputBuf);
+        if (u_memcmp(p + 1, required + 1, requiredLength - 1) == 0) {
+            break;
+        }
+        pos++;
+    }
+    requiredPos = pos;
+
+    if (fPattern->fRequiredStringOffset >= 0 && requiredLength >= 2) {
+        int32_t reachPos = pos - fPattern->fRequiredStringOffset;
+        if (reachPos > startPos) {
+            U16_SET_CP_START(inputBuf, startPos, reachPos);
+            startPos = reachPos;
+        }
+    }
+    return TRUE;
+}
+
+
+//--------------------------------------------------------------------------------
+//
+//   skipToRequiredStringUTF8()  Like skipToRequiredString(), for UTF-8 input, with the
+//                               required string converted to UTF-8 by the caller.
+//
+//--------------------------------------------------------------------------------
+UBool RegexMatcher::skipToRequiredStringUTF8(const char *required, int32_t requiredLength,
+                                             int32_t &startPos, int32_t &requiredPos) {
+    const char *inputBuf = (const char *)fInputUTF8;
+    int32_t     lastPos  = (int32_t)fActiveLimit - requiredLength;
+    int32_t     pos      = startPos;
+    for (;;) {
+        if (pos > lastPos) {
+            return FALSE;
+        }
+        const char *p = (const char *)uprv_memchr(inputBuf + pos, required[0], lastPos - pos + 1);
+        if (p == NULL) {
+            return FALSE;
+        }
+        pos = (int32_t)(p - inputBuf);
+        if (uprv_memcmp(p + 1, required + 1, requiredLength - 1) == 0) {
+            break;
+        }
+        pos++;
+    }
+    requiredPos = pos;
+
+    // The offset is in UTF-16 code units.  Each of them takes at most three bytes,
+    //   counting ill-formed sequences, which match as U+FFFD.
+    int32_t offset = fPattern->fRequiredStringOffset;
+    if (offset >= 0 && offset <= INT32_MAX / 3 && fPattern->fRequiredStringLen >= 2) {
+        int32_t reachPos = pos - 3 * offset;
+        if (reachPos > startPos) {
+            // Back up to a byte that is not a trail byte.  Stepping forward from startPos,
+            //   as find() does, reaches every such byte, even in ill-formed input.
+            while (reachPos > startPos && U8_IS_TRAIL(fInputUTF8[reachPos])) {
+                --reachPos;
+            }
+            startPos = reachPos;
+        }
+    }
+    return TRUE;
+}
+
+
 //--------------------------------------------------------------------------------
 //
 //   findUsingChunk() -- like find(), but with the advance knowledge that the
@@ -966,14 +1177,72 @@ UBool RegexMatcher::findUsingChunk(UErrorCode &status) {
         return FALSE;
     }
 
+    // For patterns with a required string, requiredPos is the position of its next
+    //   occurrence.  Whenever the search passes it, skip ahead to the next one.
+    //   Callbacks expect to see each start position tried, so they turn this off.
+    int32_t requiredPos = INT32_MAX;
+    if (fPattern->fRequiredStringLen > 0 && fCallbackFn == NULL && fFindProgressCallbackFn == NULL) {
+        if (!skipToRequiredString(inputBuf, startPos, requiredPos)) {
+            fMatch = FALSE;
+            fHitEnd = TRUE;
+            return FALSE;
+        }
+    }
+
     UChar32  c;
     U_ASSERT(startPos >= 0);
 
+    // Patterns that need no backtracking: locate the match start with the DFA, then
+    //   run the match engine once, from there, for the match end and capture groups.
+    //   Callbacks expect to see each start position tried, so they disable the DFA.
+    if (fPattern->fNFA != NULL && fCallbackFn == NULL && fFindProgressCallbackFn == NULL) {
+        if (fDFA == NULL) {
+            fDFA = new RegexLazyDFA(fPattern->fNFA, status);
+            if (fDFA == NULL) {
+                status = U_MEMORY_ALLOCATION_ERROR;
+            }
+            if (U_FAILURE(status)) {
+                delete fDFA;
+                fDFA = NULL;
+                return FALSE;
+            }
+        }
+        UBool   hitEnd = FALSE;
+        UChar32 firstChar = fPattern->fStartType == START_CHAR || fPattern->fStartType == START_STRING ?
+            fPattern->fInitialChar : -1;
+        int32_t matchStart = fDFA->findMatchStart(inputBuf, startPos, (int32_t)fActiveLimit, firstChar,
+                                                  hitEnd, status);
+        if (U_FAILURE(status)) {
+            return FALSE;
+        }
+        if (matchStart == RegexLazyDFA::kNoMatch) {
+            fMatch = FALSE;
+            fHitEnd = TRUE;
+            return FALSE;
+        }
+        if (matchStart >= 0) {
+            MatchChunkAt(matchStart, FALSE, status);
+            if (U_FAILURE(status)) {
+                return FALSE;
+            }
+            if (fMatch) {
+                fHitEnd |= hitEnd;
+                return TRUE;
+            }
+            // The DFA and the match engine disagree; fall back to trying each position.
+        }
+    }
+
     switch (fPattern->fStartType) {
     case START_NO_INFO:
         // No optimization was found.
         //  Try a match at each input position.
         for (;;) {
+            if (startPos > requiredPos && !skipToRequiredString(inputBuf, startPos, requiredPos)) {
+                fMatch = FALSE;
+                fHitEnd = TRUE;
+                return FALSE;
+            }
             MatchChunkAt(startPos, FALSE, status);
             if (U_FAILURE(status)) {
                 return FALSE;
@@ -1013,6 +1282,11 @@ UBool RegexMatcher::findUsingChunk(UErrorCode &status) {
         // Match may start on any char from a pre-computed set.
         U_ASSERT(fPattern->fMinMatchLen > 0);
         for (;;) {
+            if (startPos > requiredPos && !skipToRequiredString(inputBuf, startPos, requiredPos)) {
+                fMatch = FALSE;
+                fHitEnd = TRUE;
+                return FALSE;
+            }
             int32_t pos = startPos;
             U16_NEXT(inputBuf, startPos, fActiveLimit, c);  // like c = inputBuf[startPos++];
             if ((c<256 && fPattern->fInitialChars8->contains(c)) ||
@@ -1043,6 +1317,11 @@ UBool RegexMatcher::findUsingChunk(UErrorCode &status) {
         U_ASSERT(fPattern->fMinMatchLen > 0);
         UChar32 theChar = fPattern->fInitialChar;
         for (;;) {
+            if (startPos > requiredPos && !skipToRequiredString(inputBuf, startPos, requiredPos)) {
+                fMatch = FALSE;
+                fHitEnd = TRUE;
+                return FALSE;
+            }
             int32_t pos = startPos;
             U16_NEXT(inputBuf, startPos, fActiveLimit, c);  // like c = inputBuf[startPos++];
             if (c == theChar) {
@@ -1141,6 +1420,311 @@ UBool RegexMatcher::findUsingChunk(UErrorCode &status) {
     return FALSE;
 }
 
+//--------------------------------------------------------------------------------
+//
+//   findUsingChunkUTF8() -- like findUsingChunk(), but for input text opened with
+//                           utext_openUTF8().  Works directly on the UTF-8 bytes,
+//                           with byte indexes, which are also the native indexes.
+//
+//--------------------------------------------------------------------------------
+UBool RegexMatcher::findUsingChunkUTF8(UErrorCode &status) {
+    // Start at the position of the last match end.  (Will be zero if the
+    //   matcher has been reset.
+    //
+
+    int32_t startPos = (int32_t)fMatchEnd;
+    if (startPos==0) {
+        startPos = (int32_t)fActiveStart;
+    }
+
+    const uint8_t *inputBuf = fInputUTF8;
+
+    if (fMatch) {
+        // Save the position of any previous successful match.
+        fLastMatchEnd = fMatchEnd;
+
+        if (fMatchStart == fMatchEnd) {
+            // Previous match had zero length.  Move start position up one position
+            //  to avoid sending find() into a loop on zero-length matches.
+            if (startPos >= fActiveLimit) {
+                fMatch = FALSE;
+                fHitEnd = TRUE;
+                return FALSE;
+            }
+            U8_FWD_1(inputBuf, startPos, fInputLength);
+        }
+    } else {
+        if (fLastMatchEnd >= 0) {
+            // A previous find() failed to match.  Don't try again.
+            //   (without this test, a pattern with a zero-length match
+            //    could match again at the end of an input string.)
+            fHitEnd = TRUE;
+            return FALSE;
+        }
+    }
+
+
+    // Compute the position in the input string beyond which a match can not begin.
+    //   The minimum match length is in UTF-16 code units; every code unit takes
+    //   at least one UTF-8 byte, so it is also a lower bound on the match length in bytes.
+    //   Note:  some patterns that cannot match anything will have fMinMatchLength==Max Int.
+    //          Be aware of possible overflows if making changes here.
+    //   Note:  a match can begin at inputBuf + testLen; it is an inclusive limit.
+    int32_t testLen  = (int32_t)(fActiveLimit - fPattern->fMinMatchLen);
+    if (startPos > testLen) {
+        fMatch = FALSE;
+        fHitEnd = TRUE;
+        return FALSE;
+    }
+
+    // For patterns with a required string, requiredPos is the position of its next
+    //   occurrence.  Whenever the search passes it, skip ahead to the next one.
+    //   Callbacks expect to see each start position tried, so they turn this off.
+    char    required8[3 * MAX_REQUIRED_STRING_LEN];
+    int32_t required8Length = 0;
+    int32_t requiredPos = INT32_MAX;
+    if (fPattern->fRequiredStringLen > 0 && fCallbackFn == NULL && fFindProgressCallbackFn == NULL) {
+        const UChar *required = fPattern->fLiteralText.getBuffer() + fPattern->fRequiredStringIdx;
+        for (int32_t i = 0; i < fPattern->fRequiredStringLen;) {
+            UChar32 requiredC;
+            U16_NEXT_UNSAFE(required, i, requiredC);
+            U8_APPEND_UNSAFE(required8, required8Length, requiredC);
+        }
+        if (!skipToRequiredStringUTF8(required8, required8Length, startPos, requiredPos)) {
+            fMatch = FALSE;
+            fHitEnd = TRUE;
+            return FALSE;
+        }
+    }
+
+    UChar32  c;
+    U_ASSERT(startPos >= 0);
+
+    switch (fPattern->fStartType) {
+    case START_NO_INFO:
+        // No optimization was found.
+        //  Try a match at each input position.
+        for (;;) {
+            if (startPos > requiredPos && !skipToRequiredStringUTF8(required8, required8Length, startPos, requiredPos)) {
+                fMatch = FALSE;
+                fHitEnd = TRUE;
+                return FALSE;
+            }
+            MatchChunkAtUTF8(startPos, FALSE, status);
+            if (U_FAILURE(status)) {
+                return FALSE;
+            }
+            if (fMatch) {
+                return TRUE;
+            }
+            if (startPos >= testLen) {
+                fHitEnd = TRUE;
+                return FALSE;
+            }
+            U8_FWD_1(inputBuf, startPos, fActiveLimit);
+            // Note that it's perfectly OK for a pattern to have a zero-length
+            //   match at the end of a string, so we must make sure that the loop
+            //   runs with startPos == testLen the last time through.
+            if  (findProgressInterrupt(startPos, status))
+                return FALSE;
+        }
+        U_ASSERT(FALSE);
+
+    case START_START:
+        // Matches are only possible at the start of the input string
+        //   (pattern begins with ^ or \A)
+        if (startPos > fActiveStart) {
+            fMatch = FALSE;
+            return FALSE;
+        }
+        MatchChunkAtUTF8(startPos, FALSE, status);
+        if (U_FAILURE(status)) {
+            return FALSE;
+        }
+        return fMatch;
+
+
+    case START_SET:
+    {
+        // Match may start on any char from a pre-computed set.
+        U_ASSERT(fPattern->fMinMatchLen > 0);
+        for (;;) {
+            if (startPos > requiredPos && !skipToRequiredStringUTF8(required8, required8Length, startPos, requiredPos)) {
+                fMatch = FALSE;
+                fHitEnd = TRUE;
+                return FALSE;
+            }
+            int32_t pos = startPos;
+            U8_NEXT_OR_FFFD(inputBuf, startPos, fActiveLimit, c);
+            if ((c<256 && fPattern->fInitialChars8->contains(c)) ||
+                (c>=256 && fPattern->fInitialChars->contains(c))) {
+                MatchChunkAtUTF8(pos, FALSE, status);
+                if (U_FAILURE(status)) {
+                    return FALSE;
+                }
+                if (fMatch) {
+                    return TRUE;
+                }
+            }
+            if (startPos > testLen) {
+                fMatch = FALSE;
+                fHitEnd = TRUE;
+                return FALSE;
+            }
+            if  (findProgressInterrupt(startPos, status))
+                return FALSE;
+        }
+    }
+        U_ASSERT(FALSE);
+
+    case START_STRING:
+    case START_CHAR:
+    {
+        // Match starts on exactly one char.
+        U_ASSERT(fPattern->fMinMatchLen > 0);
+        UChar32 theChar = fPattern->fInitialChar;
+        if (theChar < 0x80) {
+            // An ASCII byte is always a whole character in UTF-8, even in ill-formed text,
+            //   so candidate positions can be found with a plain byte search.
+            for (;;) {
+                if (startPos > requiredPos && !skipToRequiredStringUTF8(required8, required8Length, startPos, requiredPos)) {
+                    fMatch = FALSE;
+                    fHitEnd = TRUE;
+                    return FALSE;
+                }
+                const uint8_t *p = (const uint8_t *)uprv_memchr(inputBuf + startPos, theChar,
+                                                                testLen + 1 - startPos);
+                if (p == NULL) {
+                    fMatch = FALSE;
+                    fHitEnd = TRUE;
+                    return FALSE;
+                }
+                int32_t pos = (int32_t)(p - inputBuf);
+                MatchChunkAtUTF8(pos, FALSE, status);
+                if (U_FAILURE(status)) {
+                    return FALSE;
+                }
+                if (fMatch) {
+                    return TRUE;
+                }
+                startPos = pos + 1;
+                if (startPos > testLen) {
+                    fMatch = FALSE;
+                    fHitEnd = TRUE;
+                    return FALSE;
+                }
+                if  (findProgressInterrupt(startPos, status))
+                    return FALSE;
+            }
+        }
+        for (;;) {
+            if (startPos > requiredPos && !skipToRequiredStringUTF8(required8, required8Length, startPos, requiredPos)) {
+                fMatch = FALSE;
+                fHitEnd = TRUE;
+                return FALSE;
+            }
+            int32_t pos = startPos;
+            U8_NEXT_OR_FFFD(inputBuf, startPos, fActiveLimit, c);
+            if (c == theChar) {
+                MatchChunkAtUTF8(pos, FALSE, status);
+                if (U_FAILURE(status)) {
+                    return FALSE;
+                }
+                if (fMatch) {
+                    return TRUE;
+                }
+            }
+            if (startPos > testLen) {
+                fMatch = FALSE;
+                fHitEnd = TRUE;
+                return FALSE;
+            }
+            if  (findProgressInterrupt(startPos, status))
+                return FALSE;
+        }
+    }
+    U_ASSERT(FALSE);
+
+    case START_LINE:
+    {
+        UChar32  c;
+        if (startPos == fAnchorStart) {
+            MatchChunkAtUTF8(startPos, FALSE, status);
+            if (U_FAILURE(status)) {
+                return FALSE;
+            }
+            if (fMatch) {
+                return TRUE;
+            }
+            U8_FWD_1(inputBuf, startPos, fActiveLimit);
+        }
+
+        if (fPattern->fFlags & UREGEX_UNIX_LINES) {
+            for (;;) {
+                c = inputBuf[startPos-1];
+                if (c == 0x0a) {
+                    MatchChunkAtUTF8(startPos, FALSE, status);
+                    if (U_FAILURE(status)) {
+                        return FALSE;
+                    }
+                    if (fMatch) {
+                        return TRUE;
+                    }
+                }
+                if (startPos >= testLen) {
+                    fMatch = FALSE;
+                    fHitEnd = TRUE;
+                    return FALSE;
+                }
+                U8_FWD_1(inputBuf, startPos, fActiveLimit);
+                // Note that it's perfectly OK for a pattern to have a zero-length
+                //   match at the end of a string, so we must make sure that the loop
+                //   runs with startPos == testLen the last time through.
+                if  (findProgressInterrupt(startPos, status))
+                    return FALSE;
+            }
+        } else {
+            for (;;) {
+                // Line terminators other than CR and LF (U+0085, U+2028, U+2029)
+                //   are multi-byte sequences; decode the whole preceding character.
+                int32_t prevPos = startPos;
+                U8_PREV_OR_FFFD(inputBuf, 0, prevPos, c);
+                if (isLineTerminator(c)) {
+                    if (c == 0x0d && startPos < fActiveLimit && inputBuf[startPos] == 0x0a) {
+                        startPos++;
+                    }
+                    MatchChunkAtUTF8(startPos, FALSE, status);
+                    if (U_FAILURE(status)) {
+                        return FALSE;
+                    }
+                    if (fMatch) {
+                        return TRUE;
+                    }
+                }
+                if (startPos >= testLen) {
+                    fMatch = FALSE;
+                    fHitEnd = TRUE;
+                    return FALSE;
+                }
+                U8_FWD_1(inputBuf, startPos, fActiveLimit);
+                // Note that it's perfectly OK for a pattern to have a zero-length
+                //   match at the end of a string, so we must make sure that the loop
+                //   runs with startPos == testLen the last time through.
+                if  (findProgressInterrupt(startPos, status))
+                    return FALSE;
+            }
+        }
+    }
+
+    default:
+        U_ASSERT(FALSE);
+    }
+
+    U_ASSERT(FALSE);
+    return FALSE;
+}
+
+
 
 
 //--------------------------------------------------------------------------------
@@ -1469,7 +2053,9 @@ UBool RegexMatcher::lookingAt(UErrorCode &status) {
     else {
         resetPreserveRegion();
     }
-    if (UTEXT_FULL_TEXT_IN_CHUNK(fInputText, fInputLength)) {
+    if (fInputUTF8 != NULL) {
+        MatchChunkAtUTF8((int32_t)fActiveStart, FALSE, status);
+    } else if (UTEXT_FULL_TEXT_IN_CHUNK(fInputText, fInputLength)) {
         MatchChunkAt((int32_t)fActiveStart, FALSE, status);
     } else {
         MatchAt(fActiveStart, FALSE, status);
@@ -1507,7 +2093,9 @@ UBool RegexMatcher::lookingAt(int64_t start, UErrorCode &status) {
         return FALSE;
     }
 
-    if (UTEXT_FULL_TEXT_IN_CHUNK(fInputText, fInputLength)) {
+    if (fInputUTF8 != NULL) {
+        MatchChunkAtUTF8((int32_t)nativeStart, FALSE, status);
+    } else if (UTEXT_FULL_TEXT_IN_CHUNK(fInputText, fInputLength)) {
         MatchChunkAt((int32_t)nativeStart, FALSE, status);
     } else {
         MatchAt(nativeStart, FALSE, status);
@@ -1541,7 +2129,9 @@ UBool RegexMatcher::matches(UErrorCode &status) {
         resetPreserveRegion();
     }
 
-    if (UTEXT_FULL_TEXT_IN_CHUNK(fInputText, fInputLength)) {
+    if (fInputUTF8 != NULL) {
+        MatchChunkAtUTF8((int32_t)fActiveStart, TRUE, status);
+    } else if (UTEXT_FULL_TEXT_IN_CHUNK(fInputText, fInputLength)) {
         MatchChunkAt((int32_t)fActiveStart, TRUE, status);
     } else {
         MatchAt(fActiveStart, TRUE, status);
@@ -1579,7 +2169,9 @@ UBool RegexMatcher::matches(int64_t start, UErrorCode &status) {
         return FALSE;
     }
 
-    if (UTEXT_FULL_TEXT_IN_CHUNK(fInputText, fInputLength)) {
+    if (fInputUTF8 != NULL) {
+        MatchChunkAtUTF8((int32_t)nativeStart, TRUE, status);
+    } else if (UTEXT_FULL_TEXT_IN_CHUNK(fInputText, fInputLength)) {
         MatchChunkAt((int32_t)nativeStart, TRUE, status);
     } else {
         MatchAt(nativeStart, TRUE, status);
@@ -1847,6 +2439,7 @@ RegexMatcher &RegexMatcher::reset(const UnicodeString &input) {
         return *this;
     }
     fInputLength = utext_nativeLength(fInputText);
+    fInputUTF8 = NULL;
 
     reset();
     delete fInput;
@@ -1875,6 +2468,10 @@ RegexMatcher &RegexMatcher::reset(UText *input) {
         }
         fInputLength = utext_nativeLength(fInputText);
 
+        // UTF-8 input gets the byte-indexed match engine.
+        int32_t utf8Length;
+        fInputUTF8 = (const uint8_t *)uprv_getUTF8TextContents(fInputText, &utf8Length);
+
         delete fInput;
         fInput = NULL;
 
@@ -1935,6 +2532,8 @@ RegexMatcher &RegexMatcher::refreshInputText(UText *input, UErrorCode &status) {
         return *this;
     }
     utext_setNativeIndex(fInputText, pos);
+    int32_t utf8Length;
+    fInputUTF8 = (const uint8_t *)uprv_getUTF8TextContents(fInputText, &utf8Length);
 
     if (fAltInputText != NULL) {
         pos = utext_getNativeIndex(fAltInputText);
@@ -2604,6 +3203,46 @@ UBool RegexMatcher::isChunkWordBoundary(int32_t pos) {
     return isBoundary;
 }
 
+UBool RegexMatcher::isChunkWordBoundaryUTF8(int32_t pos) {
+    UBool isBoundary = FALSE;
+    UBool cIsWord    = FALSE;
+
+    const uint8_t *inputBuf = fInputUTF8;
+
+    if (pos >= fLookLimit) {
+        fHitEnd = TRUE;
+    } else {
+        // Determine whether char c at current position is a member of the word set of chars.
+        // If we're off the end of the string, behave as though we're not at a word char.
+        UChar32 c;
+        int32_t ix = pos;
+        U8_NEXT_OR_FFFD(inputBuf, ix, fLookLimit, c);
+        if (u_hasBinaryProperty(c, UCHAR_GRAPHEME_EXTEND) || u_charType(c) == U_FORMAT_CHAR) {
+            // Current char is a combining one.  Not a boundary.
+            return FALSE;
+        }
+        cIsWord = fPattern->fStaticSets[URX_ISWORD_SET]->contains(c);
+    }
+
+    // Back up until we come to a non-combining char, determine whether
+    //  that char is a word char.
+    UBool prevCIsWord = FALSE;
+    for (;;) {
+        if (pos <= fLookStart) {
+            break;
+        }
+        UChar32 prevChar;
+        U8_PREV_OR_FFFD(inputBuf, fLookStart, pos, prevChar);
+        if (!(u_hasBinaryProperty(prevChar, UCHAR_GRAPHEME_EXTEND)
+              || u_charType(prevChar) == U_FORMAT_CHAR)) {
+            prevCIsWord = fPattern->fStaticSets[URX_ISWORD_SET]->contains(prevChar);
+            break;
+        }
+    }
+    isBoundary = cIsWord ^ prevCIsWord;
+    return isBoundary;
+}
+
 //--------------------------------------------------------------------------------
 //
 //   isUWordBoundary
@@ -2633,11 +3272,7 @@ UBool RegexMatcher::isUWordBoundary(int64_t pos) {
                             //    words are not boundaries.  All non-word chars stand by themselves,
                             //    with word boundaries on both sides.
     } else {
-        if (!UTEXT_USES_U16(fInputText)) {
-            // !!!: Would like a better way to do this!
-            UErrorCode status = U_ZERO_ERROR;
-            pos = utext_extract(fInputText, 0, pos, NULL, 0, &status);
-        }
+        // The break iterator works on the same UText, so pos is already a native index.
         returnVal = fWordBreakItr->isBoundary((int32_t)pos);
     }
 #endif
@@ -4308,11 +4943,19 @@ breakFromLoop:
 //                  except for anything that needs to be saved (like group starts
 //                  and ends).
 //
+//                  The same engine runs directly on the bytes of a UTF-8 UText,
+//                  with byte indexes, which are also the UText native indexes.
+//                  ChunkChars<CharT> supplies the code unit access.
+//
+//                  inputBuf:    the UText's chunk contents, or its UTF-8 bytes.
 //                  startIdx:    begin matching a this index.
 //                  toEnd:       if true, match must extend to end of the input region
 //
 //--------------------------------------------------------------------------------
-void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &status) {
+template<typename CharT>
+void RegexMatcher::MatchChunkAt(const CharT *inputBuf, int32_t startIdx, UBool toEnd, UErrorCode &status) {
+    typedef ChunkChars<CharT> Chars;
+
     UBool       isMatch  = FALSE;      // True if the we have a match.
 
     int32_t     backSearchIndex = INT32_MAX; // used after greedy single-character matches for searching backwards
@@ -4340,8 +4983,6 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
     const UChar         *litText       = fPattern->fLiteralText.getBuffer();
     UVector             *sets          = fPattern->fSets;
 
-    const UChar         *inputBuf      = fInputText->chunkContents;
-
     fFrameSize = fPattern->fFrameSize;
     REStackFrame        *fp            = resetStack();
     if (U_FAILURE(fDeferredStatus)) {
@@ -4393,8 +5034,7 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
 
         case URX_ONECHAR:
             if (fp->fInputIdx < fActiveLimit) {
-                UChar32 c;
-                U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+                UChar32 c = Chars::next(inputBuf, fp->fInputIdx, fActiveLimit);
                 if (c == opValue) {
                     break;
                 }
@@ -4420,26 +5060,8 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                 U_ASSERT(opType == URX_STRING_LEN);
                 U_ASSERT(stringLen >= 2);
 
-                const UChar * pInp = inputBuf + fp->fInputIdx;
-                const UChar * pInpLimit = inputBuf + fActiveLimit;
-                const UChar * pPat = litText+stringStartIdx;
-                const UChar * pEnd = pInp + stringLen;
-                UBool success = TRUE;
-                while (pInp < pEnd) {
-                    if (pInp >= pInpLimit) {
-                        fHitEnd = TRUE;
-                        success = FALSE;
-                        break;
-                    }
-                    if (*pInp++ != *pPat++) {
-                        success = FALSE;
-                        break;
-                    }
-                }
-
-                if (success) {
-                    fp->fInputIdx += stringLen;
-                } else {
+                if (!Chars::matchString(inputBuf, fp->fInputIdx, fActiveLimit,
+                                        litText+stringStartIdx, stringLen, fHitEnd)) {
                     fp = (REStackFrame *)fStack->popFrame(fFrameSize);
                 }
             }
@@ -4484,7 +5106,7 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
 
         case URX_DOLLAR:                   //  $, test for End of line
             //     or for position before new line at end of input
-            if (fp->fInputIdx < fAnchorLimit-2) {
+            if (fp->fInputIdx < fAnchorLimit-Chars::MAX_LINE_END_LENGTH) {
                 // We are no where near the end of input.  Fail.
                 //   This is the common case.  Keep it first.
                 fp = (REStackFrame *)fStack->popFrame(fFrameSize);
@@ -4499,23 +5121,22 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
 
             // If we are positioned just before a new-line that is located at the
             //   end of input, succeed.
-            if (fp->fInputIdx == fAnchorLimit-1) {
-                UChar32 c;
-                U16_GET(inputBuf, fAnchorStart, fp->fInputIdx, fAnchorLimit, c);
+            {
+                int64_t ix = fp->fInputIdx;
+                UChar32 c = Chars::next(inputBuf, ix, fAnchorLimit);
 
-                if (isLineTerminator(c)) {
+                if (ix == fAnchorLimit && isLineTerminator(c)) {
                     if ( !(c==0x0a && fp->fInputIdx>fAnchorStart && inputBuf[fp->fInputIdx-1]==0x0d)) {
                         // At new-line at end of input. Success
                         fHitEnd = TRUE;
                         fRequireEnd = TRUE;
                         break;
                     }
-                }
-            } else if (fp->fInputIdx == fAnchorLimit-2 &&
-                inputBuf[fp->fInputIdx]==0x0d && inputBuf[fp->fInputIdx+1]==0x0a) {
+                } else if (c == 0x0d && ix == fAnchorLimit-1 && inputBuf[ix] == 0x0a) {
                     fHitEnd = TRUE;
                     fRequireEnd = TRUE;
                     break;                         // At CR/LF at end of input.  Success
+                }
             }
 
             fp = (REStackFrame *)fStack->popFrame(fFrameSize);
@@ -4556,7 +5177,8 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                 }
                 // If we are positioned just before a new-line, succeed.
                 // It makes no difference where the new-line is within the input.
-                UChar32 c = inputBuf[fp->fInputIdx];
+                int64_t ix = fp->fInputIdx;
+                UChar32 c = Chars::next(inputBuf, ix, fAnchorLimit);
                 if (isLineTerminator(c)) {
                     // At a line end, except for the odd chance of  being in the middle of a CR/LF sequence
                     //  In multi-line mode, hitting a new-line just before the end of input does not
@@ -4603,7 +5225,8 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                 }
                 // Check whether character just before the current pos is a new-line
                 //   unless we are at the end of input
-                UChar  c = inputBuf[fp->fInputIdx - 1];
+                int64_t ix = fp->fInputIdx;
+                UChar32 c = Chars::prev(inputBuf, 0, ix);
                 if ((fp->fInputIdx < fAnchorLimit) &&
                     isLineTerminator(c)) {
                     //  It's a new-line.  ^ is true.  Success.
@@ -4625,7 +5248,7 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                 }
                 // Check whether character just before the current pos is a new-line
                 U_ASSERT(fp->fInputIdx <= fAnchorLimit);
-                UChar  c = inputBuf[fp->fInputIdx - 1];
+                CharT  c = inputBuf[fp->fInputIdx - 1];
                 if (c != 0x0a) {
                     // Not at the start of a line.  Back-track out.
                     fp = (REStackFrame *)fStack->popFrame(fFrameSize);
@@ -4635,7 +5258,8 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
 
         case URX_BACKSLASH_B:          // Test for word boundaries
             {
-                UBool success = isChunkWordBoundary((int32_t)fp->fInputIdx);
+                UBool success = Chars::IS_UTF8 ? isChunkWordBoundaryUTF8((int32_t)fp->fInputIdx) :
+                                                 isChunkWordBoundary((int32_t)fp->fInputIdx);
                 success ^= (UBool)(opValue != 0);     // flip sense for \B
                 if (!success) {
                     fp = (REStackFrame *)fStack->popFrame(fFrameSize);
@@ -4663,8 +5287,7 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                     break;
                 }
 
-                UChar32 c;
-                U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+                UChar32 c = Chars::next(inputBuf, fp->fInputIdx, fActiveLimit);
                 int8_t ctype = u_charType(c);     // TODO:  make a unicode set for this.  Will be faster.
                 UBool success = (ctype == U_DECIMAL_DIGIT_NUMBER);
                 success ^= (UBool)(opValue != 0);        // flip sense for \D
@@ -4689,8 +5312,7 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                     fp = (REStackFrame *)fStack->popFrame(fFrameSize);
                     break;
                 }
-                UChar32 c;
-                U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+                UChar32 c = Chars::next(inputBuf, fp->fInputIdx, fActiveLimit);
                 int8_t ctype = u_charType(c);
                 UBool success = (ctype == U_SPACE_SEPARATOR || c == 9);  // SPACE_SEPARATOR || TAB
                 success ^= (UBool)(opValue != 0);        // flip sense for \H
@@ -4708,15 +5330,12 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                     fp = (REStackFrame *)fStack->popFrame(fFrameSize);
                     break;
                 }
-                UChar32 c;
-                U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+                UChar32 c = Chars::next(inputBuf, fp->fInputIdx, fActiveLimit);
                 if (isLineTerminator(c)) {
                     if (c == 0x0d && fp->fInputIdx < fActiveLimit) {
                         // Check for CR/LF sequence. Consume both together when found.
-                        UChar c2;
-                        U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c2);
-                        if (c2 != 0x0a) {
-                            U16_PREV(inputBuf, 0, fp->fInputIdx, c2);
+                        if (inputBuf[fp->fInputIdx] == 0x0a) {
+                            fp->fInputIdx++;
                         }
                     }
                 } else {
@@ -4733,8 +5352,7 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
                     fp = (REStackFrame *)fStack->popFrame(fFrameSize);
                     break;
                 }
-                UChar32 c;
-                U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+                UChar32 c = Chars::next(inputBuf, fp->fInputIdx, fActiveLimit);
                 UBool success = isLineTerminator(c);
                 success ^= (UBool)(opValue != 0);        // flip sense for \V
                 if (!success) {
@@ -4760,8 +5378,8 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
 
             // Examine (and consume) the current char.
             //   Dispatch into a little state machine, based on the char.
-            UChar32  c;
-            U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+            UChar32  c = Chars::next(inputBuf, fp->fInputIdx, fActiveLimit);
+            int64_t  charStart;      // Start of the most recently fetched char, for un-getting it.
             UnicodeSet **sets = fPattern->fStaticSets;
             if (sets[URX_GC_NORMAL]->contains(c))  goto GC_Extend;
             if (sets[URX_GC_CONTROL]->contains(c)) goto GC_Control;
@@ -4776,27 +5394,30 @@ void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &statu
 
 GC_L:
             if (fp->fInputIdx >= fActiveLimit)         goto GC_Done;
-            U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+            charStart = fp->fInputIdx;
+            c = Chars::next(inputBuf, fp->fInputIdx, fActiveLimit);
             if (sets[URX_GC_L]->contains(c))       goto GC_L;
             if (sets[URX_GC_LV]->contains(c))      goto GC_V;
             if (sets[URX_GC_LVT]->contains(c))     goto GC_T;
             if (sets[URX_GC_V]->contains(c))       goto GC_V;
-            U16_PREV(inputBuf, 0, fp->fInputIdx, c);
+            fp->fInputIdx = charStart;
             goto GC_Extend;
 
 GC_V:
             if (fp->fInputIdx >= fActiveLimit)         goto GC_Done;
-            U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+            charStart = fp->fInputIdx;
+            c = Chars::next(inputBuf, fp->fInputIdx, fActiveLimit);
             if (sets[URX_GC_V]->contains(c))       goto GC_V;
             if (sets[URX_GC_T]->contains(c))       goto GC_T;
-            U16_PREV(inputBuf, 0, fp->fInputIdx, c);
+            fp->fInputIdx = charStart;
             goto GC_Extend;
 
 GC_T:
             if (fp->fInputIdx >= fActiveLimit)         goto GC_Done;
-            U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+            charStart = fp->fInputIdx;
+            c = Chars::next(inputBuf, fp->fInputIdx, fActiveLimit);
             if (sets[URX_GC_T]->contains(c))       goto GC_T;
-            U16_PREV(inputBuf, 0, fp->fInputIdx, c);
+            fp->fInputIdx = charStart;
             goto GC_Extend;
 
 GC_Extend:
@@ -4805,9 +5426,10 @@ GC_Extend:
                 if (fp->fInputIdx >= fActiveLimit) {
                     break;
                 }
-                U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+                charStart = fp->fInputIdx;
+                c = Chars::next(inputBuf, fp->fInputIdx, fActiveLimit);
                 if (sets[URX_GC_EXTEND]->contains(c) == FALSE) {
-                    U16_BACK_1(inputBuf, 0, fp->fInputIdx);
+                    fp->fInputIdx = charStart;
                     break;
                 }
             }
@@ -4858,8 +5480,7 @@ GC_Done:
                 opValue &= ~URX_NEG_SET;
                 U_ASSERT(opValue > 0 && opValue < URX_LAST_SET);
 
-                UChar32 c;
-                U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+                UChar32 c = Chars::next(inputBuf, fp->fInputIdx, fActiveLimit);
                 if (c < 256) {
                     Regex8BitSet *s8 = &fPattern->fStaticSets8[opValue];
                     if (s8->contains(c)) {
@@ -4890,8 +5511,7 @@ GC_Done:
 
                 U_ASSERT(opValue > 0 && opValue < URX_LAST_SET);
 
-                UChar32  c;
-                U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+                UChar32 c = Chars::next(inputBuf, fp->fInputIdx, fActiveLimit);
                 if (c < 256) {
                     Regex8BitSet *s8 = &fPattern->fStaticSets8[opValue];
                     if (s8->contains(c) == FALSE) {
@@ -4919,8 +5539,7 @@ GC_Done:
                 U_ASSERT(opValue > 0 && opValue < sets->size());
 
                 // There is input left.  Pick up one char and test it for set membership.
-                UChar32  c;
-                U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+                UChar32 c = Chars::next(inputBuf, fp->fInputIdx, fActiveLimit);
                 if (c<256) {
                     Regex8BitSet *s8 = &fPattern->fSets8[opValue];
                     if (s8->contains(c)) {
@@ -4952,8 +5571,7 @@ GC_Done:
                 }
 
                 // There is input left.  Advance over one char, unless we've hit end-of-line
-                UChar32  c;
-                U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+                UChar32 c = Chars::next(inputBuf, fp->fInputIdx, fActiveLimit);
                 if (isLineTerminator(c)) {
                     // End of line in normal mode.   . does not match.
                     fp = (REStackFrame *)fStack->popFrame(fFrameSize);
@@ -4975,12 +5593,11 @@ GC_Done:
 
                 // There is input left.  Advance over one char, except if we are
                 //   at a cr/lf, advance over both of them.
-                UChar32 c;
-                U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+                UChar32 c = Chars::next(inputBuf, fp->fInputIdx, fActiveLimit);
                 if (c==0x0d && fp->fInputIdx < fActiveLimit) {
                     // In the case of a CR/LF, we need to advance over both.
                     if (inputBuf[fp->fInputIdx] == 0x0a) {
-                        U16_FWD_1(inputBuf, fp->fInputIdx, fActiveLimit);
+                        fp->fInputIdx++;
                     }
                 }
             }
@@ -4999,8 +5616,7 @@ GC_Done:
                 }
 
                 // There is input left.  Advance over one char, unless we've hit end-of-line
-                UChar32 c;
-                U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+                UChar32 c = Chars::next(inputBuf, fp->fInputIdx, fActiveLimit);
                 if (c == 0x0a) {
                     // End of line in normal mode.   '.' does not match the \n
                     fp = (REStackFrame *)fStack->popFrame(fFrameSize);
@@ -5213,24 +5829,25 @@ GC_Done:
                     fp = (REStackFrame *)fStack->popFrame(fFrameSize);   // FAIL, no match.
                     break;
                 }
+                // Compare code points rather than code units, so that the back reference
+                //   can not end in the middle of an input character, for example on
+                //   the lead surrogate of a pair when the capture group ended with an
+                //   unpaired lead surrogate.
                 UBool success = TRUE;
-                for (int64_t groupIndex = groupStartIdx; groupIndex < groupEndIdx; ++groupIndex,++inputIndex) {
+                int64_t groupIndex = groupStartIdx;
+                while (groupIndex < groupEndIdx) {
                     if (inputIndex >= fActiveLimit) {
                         success = FALSE;
                         fHitEnd = TRUE;
                         break;
                     }
-                    if (inputBuf[groupIndex] != inputBuf[inputIndex]) {
+                    UChar32 groupChar = Chars::next(inputBuf, groupIndex, groupEndIdx);
+                    UChar32 inputChar = Chars::next(inputBuf, inputIndex, fActiveLimit);
+                    if (groupChar != inputChar) {
                         success = FALSE;
                         break;
                     }
                 }
-                if (success && groupStartIdx < groupEndIdx && U16_IS_LEAD(inputBuf[groupEndIdx-1]) &&
-                        inputIndex < fActiveLimit && U16_IS_TRAIL(inputBuf[inputIndex])) {
-                    // Capture group ended with an unpaired lead surrogate.
-                    // Back reference is not permitted to match lead only of a surrogatge pair.
-                    success = FALSE;
-                }
                 if (success) {
                     fp->fInputIdx = inputIndex;
                 } else {
@@ -5250,8 +5867,8 @@ GC_Done:
                     fp = (REStackFrame *)fStack->popFrame(fFrameSize);   // FAIL, no match.
                     break;
                 }
-                CaseFoldingUCharIterator captureGroupItr(inputBuf, groupStartIdx, groupEndIdx);
-                CaseFoldingUCharIterator inputItr(inputBuf, fp->fInputIdx, fActiveLimit);
+                typename Chars::CaseFoldingIterator captureGroupItr(inputBuf, groupStartIdx, groupEndIdx);
+                typename Chars::CaseFoldingIterator inputItr(inputBuf, fp->fInputIdx, fActiveLimit);
 
                 //   Note: if the capture group match was of an empty string the backref
                 //         match succeeds.  Verified by testing:  Perl matches succeed
@@ -5357,8 +5974,7 @@ GC_Done:
 
         case URX_ONECHAR_I:
             if (fp->fInputIdx < fActiveLimit) {
-                UChar32 c;
-                U16_NEXT(inputBuf, fp->fInputIdx, fActiveLimit, c);
+                UChar32 c = Chars::next(inputBuf, fp->fInputIdx, fActiveLimit);
                 if (u_foldCase(c, U_FOLD_CASE_DEFAULT) == opValue) {
                     break;
                 }
@@ -5387,7 +6003,7 @@ GC_Done:
                 UChar32      cPattern;
                 UBool        success = TRUE;
                 int32_t      patternStringIdx  = 0;
-                CaseFoldingUCharIterator inputIterator(inputBuf, fp->fInputIdx, fActiveLimit);
+                typename Chars::CaseFoldingIterator inputIterator(inputBuf, fp->fInputIdx, fActiveLimit);
                 while (patternStringIdx < patternStringLen) {
                     U16_NEXT(patternString, patternStringIdx, patternStringLen, cPattern);
                     cText = inputIterator.next();
@@ -5440,6 +6056,9 @@ GC_Done:
                 int32_t maxML = (int32_t)pat[fp->fPatIdx++];
                 U_ASSERT(minML <= maxML);
                 U_ASSERT(minML >= 0);
+                // The pattern compiler measures the match lengths in UTF-16 code units.
+                // The max length need not be exact; it just needs to be >= actual maximum.
+                maxML *= Chars::MAX_LENGTH_PER_UTF16_UNIT;
 
                 // Fetch (from data) the last input index where a match was attempted.
                 U_ASSERT(opValue>=0 && opValue+1<fPattern->fDataSize);
@@ -5448,7 +6067,7 @@ GC_Done:
                     // First time through loop.
                     lbStartIdx = fp->fInputIdx - minML;
                     if (lbStartIdx > 0) {
-                        U16_SET_CP_START(inputBuf, 0, lbStartIdx);
+                        Chars::setCpStart(inputBuf, lbStartIdx);
                     }
                 } else {
                     // 2nd through nth time through the loop.
@@ -5456,7 +6075,7 @@ GC_Done:
                     if (lbStartIdx == 0) {
                         lbStartIdx--;
                     } else {
-                        U16_BACK_1(inputBuf, 0, lbStartIdx);
+                        Chars::back1(inputBuf, lbStartIdx);
                     }
                 }
 
@@ -5517,6 +6136,8 @@ GC_Done:
                 U_ASSERT(minML <= maxML);
                 U_ASSERT(minML >= 0);
                 U_ASSERT(continueLoc > fp->fPatIdx);
+                // The pattern compiler measures the match lengths in UTF-16 code units.
+                maxML *= Chars::MAX_LENGTH_PER_UTF16_UNIT;
 
                 // Fetch (from data) the last input index where a match was attempted.
                 U_ASSERT(opValue>=0 && opValue+1<fPattern->fDataSize);
@@ -5525,15 +6146,15 @@ GC_Done:
                     // First time through loop.
                     lbStartIdx = fp->fInputIdx - minML;
                     if (lbStartIdx > 0) {
-                        U16_SET_CP_START(inputBuf, 0, lbStartIdx);
+                        Chars::setCpStart(inputBuf, lbStartIdx);
                     }
                 } else {
                     // 2nd through nth time through the loop.
                     // Back up start position for match by one.
                     if (lbStartIdx == 0) {
-                        lbStartIdx--;   // Because U16_BACK is unsafe starting at 0.
+                        lbStartIdx--;   // Because back1() is unsafe starting at 0.
                     } else {
-                        U16_BACK_1(inputBuf, 0, lbStartIdx);
+                        Chars::back1(inputBuf, lbStartIdx);
                     }
                 }
 
@@ -5613,16 +6234,16 @@ GC_Done:
                         fHitEnd = TRUE;
                         break;
                     }
-                    UChar32   c;
-                    U16_NEXT(inputBuf, ix, fActiveLimit, c);
+                    int32_t   charStart = ix;
+                    UChar32   c = Chars::next(inputBuf, ix, fActiveLimit);
                     if (c<256) {
                         if (s8->contains(c) == FALSE) {
-                            U16_BACK_1(inputBuf, 0, ix);
+                            ix = charStart;
                             break;
                         }
                     } else {
                         if (s->contains(c) == FALSE) {
-                            U16_BACK_1(inputBuf, 0, ix);
+                            ix = charStart;
                             break;
                         }
                     }
@@ -5675,15 +6296,15 @@ GC_Done:
                             fHitEnd = TRUE;
                             break;
                         }
-                        UChar32   c;
-                        U16_NEXT(inputBuf, ix, fActiveLimit, c);   // c = inputBuf[ix++]
+                        int32_t   charStart = ix;
+                        UChar32   c = Chars::next(inputBuf, ix, fActiveLimit);   // c = inputBuf[ix++]
                         if ((c & 0x7f) <= 0x29) {          // Fast filter of non-new-line-s
                             if ((c == 0x0a) ||             //  0x0a is newline in both modes.
                                 (((opValue & 2) == 0) &&    // IF not UNIX_LINES mode
                                    isLineTerminator(c))) {
                                 //  char is a line ending.  Put the input pos back to the
                                 //    line ending char, and exit the scanning loop.
-                                U16_BACK_1(inputBuf, 0, ix);
+                                ix = charStart;
                                 break;
                             }
                         }
@@ -5732,9 +6353,10 @@ GC_Done:
                 //   and a state save to this instruction in case the following code fails again.
                 //   (We're going backwards because this loop emulates stack unwinding, not
                 //    the initial scan forward.)
+                //   Stepping back is bounded by the loop start, so that a character
+                //   split by the loop start can not take us back past it.
                 U_ASSERT(fp->fInputIdx > 0);
-                UChar32 prevC;
-                U16_PREV(inputBuf, 0, fp->fInputIdx, prevC); // !!!: should this 0 be one of f*Limit?
+                UChar32 prevC = Chars::prev(inputBuf, backSearchIndex, fp->fInputIdx);
 
                 if (prevC == 0x0a &&
                     fp->fInputIdx > backSearchIndex &&
@@ -5742,7 +6364,7 @@ GC_Done:
                     int32_t prevOp = (int32_t)pat[fp->fPatIdx-2];
                     if (URX_TYPE(prevOp) == URX_LOOP_DOT_I) {
                         // .*, stepping back over CRLF pair.
-                        U16_BACK_1(inputBuf, 0, fp->fInputIdx);
+                        fp->fInputIdx--;
                     }
                 }
 
@@ -5791,6 +6413,21 @@ breakFromLoop:
 }
 
 
+//--------------------------------------------------------------------------------
+//
+//   MatchChunkAt, MatchChunkAtUTF8   Run the chunk match engine on the UTF-16
+//                  chunk of the input UText, or on the bytes of a UTF-8 UText.
+//
+//--------------------------------------------------------------------------------
+void RegexMatcher::MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &status) {
+    MatchChunkAt(fInputText->chunkContents, startIdx, toEnd, status);
+}
+
+void RegexMatcher::MatchChunkAtUTF8(int32_t startIdx, UBool toEnd, UErrorCode &status) {
+    MatchChunkAt(fInputUTF8, startIdx, toEnd, status);
+}
+
+
 UOBJECT_DEFINE_RTTI_IMPLEMENTATION(RegexMatcher)
 
 U_NAMESPACE_END
@@ -24,6 +24,7 @@
 #include "uvectr32.h"
 #include "uvectr64.h"
 #include "regexcmp.h"
+#include "regexdfa.h"
 #include "regeximp.h"
 #include "regexst.h"
 
@@ -107,6 +108,9 @@ RegexPattern &RegexPattern::operator = (const RegexPattern &other) {
     fInitialChar      = other.fInitialChar;
     *fInitialChars8   = *other.fInitialChars8;
     fNeedsAltInput    = other.fNeedsAltInput;
+    fRequiredStringIdx    = other.fRequiredStringIdx;
+    fRequiredStringLen    = other.fRequiredStringLen;
+    fRequiredStringOffset = other.fRequiredStringOffset;
 
     //  Copy the pattern.  It's just values, nothing deep to copy.
     fCompiledPat->assign(*other.fCompiledPat, fDeferredStatus);
@@ -152,6 +156,11 @@ RegexPattern &RegexPattern::operator = (const RegexPattern &other) {
             uhash_puti(fNamedCaptureMap, key, val, &fDeferredStatus);
         }
     }
+
+    // The NFA refers to the pattern's sets and literal text; build a new one for the copies.
+    if (other.fNFA != NULL && U_SUCCESS(fDeferredStatus)) {
+        fNFA = RegexNFA::createNFA(this, fDeferredStatus);
+    }
     return *this;
 }
 
@@ -182,7 +191,11 @@ void RegexPattern::init() {
     fInitialChar      = 0;
     fInitialChars8    = NULL;
     fNeedsAltInput    = FALSE;
+    fRequiredStringIdx    = 0;
+    fRequiredStringLen    = 0;
+    fRequiredStringOffset = -1;
     fNamedCaptureMap  = NULL;
+    fNFA              = NULL;
 
     fPattern          = NULL; // will be set later
     fPatternString    = NULL; // may be set later
@@ -248,6 +261,8 @@ void RegexPattern::zap() {
     }
     uhash_close(fNamedCaptureMap);
     fNamedCaptureMap = NULL;
+    delete fNFA;
+    fNFA = NULL;
 }
 
 
@@ -833,6 +848,11 @@ void RegexPattern::dumpPattern() const {
                 printf("%#x\n", fInitialChar);
             }
     }
+    if (fRequiredStringLen > 0) {
+        UnicodeString requiredString(fLiteralText, fRequiredStringIdx, fRequiredStringLen);
+        printf("   Required string: \"%s\", at most %d from the match start\n",
+               CStr(requiredString)(), fRequiredStringOffset);
+    }
 
     printf("Named Capture Groups:\n");
     if (uhash_count(fNamedCaptureMap) == 0) {
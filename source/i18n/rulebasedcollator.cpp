@@ -50,6 +50,7 @@
 #include "ucol_imp.h"
 #include "uhash.h"
 #include "uitercollationiterator.h"
+#include "uparallel.h"
 #include "ustr_imp.h"
 #include "utf16collationiterator.h"
 #include "utf8collationiterator.h"
@@ -694,6 +695,18 @@ RuleBasedCollator::setFastLatinOptions(CollationSettings &ownedSettings) const {
     ownedSettings.fastLatinOptions = CollationFastLatin::getOptions(
             data, ownedSettings,
             ownedSettings.fastLatinPrimaries, UPRV_LENGTHOF(ownedSettings.fastLatinPrimaries));
+    CollationFastLatin::setScriptOptions(data, ownedSettings);
+}
+
+UBool
+RuleBasedCollator::internalHasFastLatin() const {
+    return settings->fastLatinOptions >= 0;
+}
+
+UBool
+RuleBasedCollator::internalHasFastScriptTable(int32_t block) const {
+    return 0 <= block && block < CollationFastLatin::NUM_SCRIPT_BLOCKS &&
+            settings->fastScriptOptions[block] >= 0;
 }
 
 UCollationResult
@@ -1020,24 +1033,45 @@ RuleBasedCollator::doCompare(const UChar *left, int32_t leftLength,
     }
 
     int32_t result;
-    int32_t fastLatinOptions = settings->fastLatinOptions;
-    if(fastLatinOptions >= 0 &&
-            (equalPrefixLength == leftLength ||
-                left[equalPrefixLength] <= CollationFastLatin::LATIN_MAX) &&
-            (equalPrefixLength == rightLength ||
-                right[equalPrefixLength] <= CollationFastLatin::LATIN_MAX)) {
+    const uint16_t *fastTable = NULL;
+    const uint16_t *fastPrimaries = NULL;
+    int32_t fastOptions = -1;
+    UChar leftChar = equalPrefixLength == leftLength ? 0 : left[equalPrefixLength];
+    UChar rightChar = equalPrefixLength == rightLength ? 0 : right[equalPrefixLength];
+    if(leftChar <= CollationFastLatin::LATIN_MAX && rightChar <= CollationFastLatin::LATIN_MAX) {
+        fastTable = data->fastLatinTable;
+        fastPrimaries = settings->fastLatinPrimaries;
+        fastOptions = settings->fastLatinOptions;
+    } else {
+        // The higher character determines the script block.
+        // The other one must be in the same block, or in Latin-1.
+        int32_t block = CollationFastLatin::getScriptBlock(
+            leftChar > rightChar ? leftChar : rightChar);
+        if(block >= 0 &&
+                (leftChar <= CollationFastLatin::LATIN1_MAX ||
+                    CollationFastLatin::getScriptBlock(leftChar) == block) &&
+                (rightChar <= CollationFastLatin::LATIN1_MAX ||
+                    CollationFastLatin::getScriptBlock(rightChar) == block)) {
+            fastTable = data->fastScriptTables[block];
+            fastOptions = settings->fastScriptOptions[block];
+            if(fastOptions >= 0) {
+                fastPrimaries = settings->fastScriptPrimaries->primaries[block];
+            }
+        }
+    }
+    if(fastOptions >= 0) {
         if(leftLength >= 0) {
-            result = CollationFastLatin::compareUTF16(data->fastLatinTable,
-                                                      settings->fastLatinPrimaries,
-                                                      fastLatinOptions,
+            result = CollationFastLatin::compareUTF16(fastTable,
+                                                      fastPrimaries,
+                                                      fastOptions,
                                                       left + equalPrefixLength,
                                                       leftLength - equalPrefixLength,
                                                       right + equalPrefixLength,
                                                       rightLength - equalPrefixLength);
         } else {
-            result = CollationFastLatin::compareUTF16(data->fastLatinTable,
-                                                      settings->fastLatinPrimaries,
-                                                      fastLatinOptions,
+            result = CollationFastLatin::compareUTF16(fastTable,
+                                                      fastPrimaries,
+                                                      fastOptions,
                                                       left + equalPrefixLength, -1,
                                                       right + equalPrefixLength, -1);
         }
@@ -1149,24 +1183,55 @@ RuleBasedCollator::doCompare(const uint8_t *left, int32_t leftLength,
     }
 
     int32_t result;
-    int32_t fastLatinOptions = settings->fastLatinOptions;
-    if(fastLatinOptions >= 0 &&
-            (equalPrefixLength == leftLength ||
-                left[equalPrefixLength] <= CollationFastLatin::LATIN_MAX_UTF8_LEAD) &&
-            (equalPrefixLength == rightLength ||
-                right[equalPrefixLength] <= CollationFastLatin::LATIN_MAX_UTF8_LEAD)) {
+    const uint16_t *fastTable = NULL;
+    const uint16_t *fastPrimaries = NULL;
+    int32_t fastOptions = -1;
+    uint8_t leftLead = equalPrefixLength == leftLength ? 0 : left[equalPrefixLength];
+    uint8_t rightLead = equalPrefixLength == rightLength ? 0 : right[equalPrefixLength];
+    if(leftLead <= CollationFastLatin::LATIN_MAX_UTF8_LEAD &&
+            rightLead <= CollationFastLatin::LATIN_MAX_UTF8_LEAD) {
+        fastTable = data->fastLatinTable;
+        fastPrimaries = settings->fastLatinPrimaries;
+        fastOptions = settings->fastLatinOptions;
+    } else {
+        // See the notes in the UTF-16 version.
+        UChar32 leftChar = leftLead, rightChar = rightLead;
+        int32_t i;
+        if(leftLead > 0x7f) {
+            i = equalPrefixLength;
+            U8_NEXT_OR_FFFD(left, i, leftLength, leftChar);
+        }
+        if(rightLead > 0x7f) {
+            i = equalPrefixLength;
+            U8_NEXT_OR_FFFD(right, i, rightLength, rightChar);
+        }
+        int32_t block = CollationFastLatin::getScriptBlock(
+            leftChar > rightChar ? leftChar : rightChar);
+        if(block >= 0 &&
+                (leftChar <= CollationFastLatin::LATIN1_MAX ||
+                    CollationFastLatin::getScriptBlock(leftChar) == block) &&
+                (rightChar <= CollationFastLatin::LATIN1_MAX ||
+                    CollationFastLatin::getScriptBlock(rightChar) == block)) {
+            fastTable = data->fastScriptTables[block];
+            fastOptions = settings->fastScriptOptions[block];
+            if(fastOptions >= 0) {
+                fastPrimaries = settings->fastScriptPrimaries->primaries[block];
+            }
+        }
+    }
+    if(fastOptions >= 0) {
         if(leftLength >= 0) {
-            result = CollationFastLatin::compareUTF8(data->fastLatinTable,
-                                                     settings->fastLatinPrimaries,
-                                                     fastLatinOptions,
+            result = CollationFastLatin::compareUTF8(fastTable,
+                                                     fastPrimaries,
+                                                     fastOptions,
                                                      left + equalPrefixLength,
                                                      leftLength - equalPrefixLength,
                                                      right + equalPrefixLength,
                                                      rightLength - equalPrefixLength);
         } else {
-            result = CollationFastLatin::compareUTF8(data->fastLatinTable,
-                                                     settings->fastLatinPrimaries,
-                                                     fastLatinOptions,
+            result = CollationFastLatin::compareUTF8(fastTable,
+                                                     fastPrimaries,
+                                                     fastOptions,
                                                      left + equalPrefixLength, -1,
                                                      right + equalPrefixLength, -1);
         }
@@ -1381,6 +1446,205 @@ RuleBasedCollator::writeIdenticalLevel(const UChar *s, const UChar *limit,
 
 namespace {
 
+/**
+ * Maximum number of strings per worker thread and round in internalGetSortKeys().
+ * Large enough that starting the threads for a round costs little,
+ * small enough to bound the work that is wasted when the keys
+ * no longer fit into the destination buffer.
+ */
+const int32_t SORT_KEYS_PER_WORKER = 2048;
+/** Below this, a worker thread costs more than it saves. */
+const int32_t MIN_SORT_KEYS_PER_WORKER = 256;
+
+const UChar emptyString[1] = { 0 };
+
+/**
+ * One worker's strings in one round, and the worker's own buffer for their keys.
+ * The buffer is kept for the next round.
+ */
+struct SortKeysWorkerData {
+    int32_t start, limit;  // string indexes
+    int32_t next;  // output: index of the first string whose key was not written
+    uint8_t *keys;
+    int32_t capacity;
+    UErrorCode errorCode;
+};
+
+struct SortKeysContext {
+    const RuleBasedCollator *collator;
+    const UChar *const *sources;
+    const int32_t *sourceLengths;
+    int32_t *offsets;
+    SortKeysWorkerData *workers;
+};
+
+}  // namespace
+
+int32_t
+RuleBasedCollator::internalGetSortKeys(const UChar *const *sources, const int32_t *sourceLengths,
+                                       int32_t count, uint8_t *dest, int32_t destCapacity,
+                                       int32_t *offsets, int32_t threadCount,
+                                       UErrorCode &errorCode) const {
+    if(U_FAILURE(errorCode)) { return 0; }
+    uint8_t noDest[1] = { 0 };
+    if(dest == NULL) {
+        dest = noDest;
+        destCapacity = 0;
+    }
+    offsets[0] = 0;
+    int32_t next = 0;
+    int32_t destLength = 0;
+    UBool full = FALSE;
+    int32_t maxWorkers = count / MIN_SORT_KEYS_PER_WORKER;
+    if(maxWorkers > threadCount) { maxWorkers = threadCount; }
+    MaybeStackArray<SortKeysWorkerData, 8> workers;
+    if(maxWorkers > 1 && maxWorkers > workers.getCapacity() &&
+            workers.resize(maxWorkers) == NULL) {
+        maxWorkers = 1;
+    }
+    if(maxWorkers > 1) {
+        // The workers write into their own buffers, and this thread copies the keys
+        // into dest in order, for as long as they fit.
+        for(int32_t w = 0; w < maxWorkers; ++w) {
+            workers[w].keys = NULL;
+            workers[w].capacity = 0;
+        }
+        SortKeysContext context = { this, sources, sourceLengths, offsets, workers.getAlias() };
+        while(U_SUCCESS(errorCode) && !full) {
+            int32_t roundCount = count - next;
+            if(roundCount > maxWorkers * SORT_KEYS_PER_WORKER) {
+                roundCount = maxWorkers * SORT_KEYS_PER_WORKER;
+            }
+            int32_t workerCount = roundCount / MIN_SORT_KEYS_PER_WORKER;
+            if(workerCount > maxWorkers) { workerCount = maxWorkers; }
+            // Write the rest on this thread, directly into dest,
+            // if there are few strings left or if this round would probably overflow dest.
+            if(workerCount <= 1 ||
+                    (next > 0 && (int64_t)destLength * roundCount / next > destCapacity - destLength)) {
+                break;
+            }
+            for(int32_t w = 0; w < workerCount; ++w) {
+                SortKeysWorkerData &worker = workers[w];
+                worker.start = next + (int32_t)(((int64_t)roundCount * w) / workerCount);
+                worker.limit = next + (int32_t)(((int64_t)roundCount * (w + 1)) / workerCount);
+                worker.errorCode = U_ZERO_ERROR;
+            }
+            uprv_runWorkers(workerCount, sortKeysWorker, &context);
+            for(int32_t w = 0; w < workerCount; ++w) {
+                const SortKeysWorkerData &worker = workers[w];
+                if(U_FAILURE(worker.errorCode)) {
+                    errorCode = worker.errorCode;
+                    break;
+                }
+                // The worker's offsets are relative to its buffer.
+                int32_t i = worker.start;
+                int32_t available = destCapacity - destLength;
+                while(i < worker.limit && offsets[i + 1] <= available) { ++i; }
+                int32_t length = i > worker.start ? offsets[i] : 0;
+                uprv_memcpy(dest + destLength, worker.keys, length);
+                for(int32_t j = worker.start + 1; j <= i; ++j) {
+                    offsets[j] += destLength;
+                }
+                destLength += length;
+                next = i;
+                if(i < worker.limit) {
+                    full = TRUE;
+                    break;
+                }
+            }
+        }
+        for(int32_t w = 0; w < maxWorkers; ++w) {
+            uprv_free(workers[w].keys);
+        }
+    }
+    if(U_SUCCESS(errorCode) && !full && next < count) {
+        next = writeSortKeys(sources, sourceLengths, next, count,
+                             dest, destLength, destCapacity, offsets, errorCode);
+    }
+    if(next == 0 && count > 0 && U_SUCCESS(errorCode)) {
+        errorCode = U_BUFFER_OVERFLOW_ERROR;
+    }
+    return next;
+}
+
+void U_CALLCONV
+RuleBasedCollator::sortKeysWorker(void *context, int32_t workerIndex) {
+    const SortKeysContext &c = *static_cast<const SortKeysContext *>(context);
+    SortKeysWorkerData &worker = c.workers[workerIndex];
+    worker.next = worker.start;
+    int32_t length = 0;
+    for(;;) {
+        if(worker.keys != NULL) {
+            worker.next = c.collator->writeSortKeys(c.sources, c.sourceLengths,
+                                                    worker.next, worker.limit,
+                                                    worker.keys, length, worker.capacity,
+                                                    c.offsets, worker.errorCode);
+            if(worker.next > worker.start) { length = c.offsets[worker.next]; }
+            if(worker.next == worker.limit || U_FAILURE(worker.errorCode)) { return; }
+        }
+        // Grow the buffer and continue with the key that did not fit.
+        int32_t newCapacity = worker.capacity > 0 ? 2 * worker.capacity : 64 * SORT_KEYS_PER_WORKER;
+        uint8_t *newKeys = (uint8_t *)uprv_realloc(worker.keys, newCapacity);
+        if(newKeys == NULL) {
+            worker.errorCode = U_MEMORY_ALLOCATION_ERROR;
+            return;
+        }
+        worker.keys = newKeys;
+        worker.capacity = newCapacity;
+    }
+}
+
+int32_t
+RuleBasedCollator::writeSortKeys(const UChar *const *sources, const int32_t *sourceLengths,
+                                 int32_t start, int32_t limit,
+                                 uint8_t *dest, int32_t destIndex, int32_t destLimit,
+                                 int32_t *offsets, UErrorCode &errorCode) const {
+    if(U_FAILURE(errorCode)) { return start; }
+    // Same as writeSortKey() but with one iterator for all of the strings.
+    UBool numeric = settings->isNumeric();
+    UBool checkFCD = !settings->dontCheckFCD();
+    UBool identical = settings->getStrength() == UCOL_IDENTICAL;
+    UTF16CollationIterator iter(data, numeric, emptyString, emptyString, emptyString);
+    FCDUTF16CollationIterator fcdIter(data, numeric, emptyString, emptyString, emptyString);
+    CollationKeys::LevelCallback callback;
+    static const char terminator = 0;  // TERMINATOR_BYTE
+    int32_t i;
+    for(i = start; i < limit; ++i) {
+        const UChar *s = sources[i];
+        int32_t length = sourceLengths != NULL ? sourceLengths[i] : -1;
+        if(s == NULL) {
+            if(length != 0) {
+                errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+                break;
+            }
+            s = emptyString;
+        }
+        const UChar *sLimit = (length >= 0) ? s + length : NULL;
+        FixedSortKeyByteSink sink(reinterpret_cast<char *>(dest) + destIndex, destLimit - destIndex);
+        if(checkFCD) {
+            fcdIter.setText(s, sLimit);
+            CollationKeys::writeSortKeyUpToQuaternary(fcdIter, data->compressibleBytes, *settings,
+                                                      sink, Collation::PRIMARY_LEVEL,
+                                                      callback, TRUE, errorCode);
+        } else {
+            iter.setText(s, sLimit);
+            CollationKeys::writeSortKeyUpToQuaternary(iter, data->compressibleBytes, *settings,
+                                                      sink, Collation::PRIMARY_LEVEL,
+                                                      callback, TRUE, errorCode);
+        }
+        if(identical) {
+            writeIdenticalLevel(s, sLimit, sink, errorCode);
+        }
+        sink.Append(&terminator, 1);
+        if(U_FAILURE(errorCode) || sink.Overflowed()) { break; }
+        destIndex += sink.NumberOfBytesAppended();
+        offsets[i + 1] = destIndex;
+    }
+    return i;
+}
+
+namespace {
+
 /**
  * internalNextSortKeyPart() calls CollationKeys::writeSortKeyUpToQuaternary()
  * with an instance of this callback class.
@@ -208,6 +208,50 @@ ucol_getSortKey(const    UCollator    *coll,
     return keySize;
 }
 
+U_CAPI int32_t U_EXPORT2
+ucol_getSortKeys(const UCollator *coll,
+                 const UChar *const *sources, const int32_t *sourceLengths, int32_t count,
+                 uint8_t *dest, int32_t destCapacity, int32_t *offsets,
+                 int32_t threadCount, UErrorCode *pErrorCode) {
+    if(pErrorCode == NULL || U_FAILURE(*pErrorCode)) {
+        return 0;
+    }
+    if(coll == NULL || count < 0 || (sources == NULL && count > 0) || offsets == NULL ||
+            destCapacity < 0 || (dest == NULL && destCapacity > 0)) {
+        *pErrorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    const RuleBasedCollator *rbc = RuleBasedCollator::rbcFromUCollator(coll);
+    if(rbc != NULL) {
+        return rbc->internalGetSortKeys(sources, sourceLengths, count,
+                                        dest, destCapacity, offsets,
+                                        threadCount, *pErrorCode);
+    }
+    // Other Collator subclasses: one key at a time.
+    const Collator *c = Collator::fromUCollator(coll);
+    offsets[0] = 0;
+    int32_t destLength = 0;
+    int32_t i;
+    for(i = 0; i < count; ++i) {
+        int32_t length = sourceLengths != NULL ? sourceLengths[i] : -1;
+        int32_t keyLength = c->getSortKey(sources[i], length,
+                                          dest + destLength, destCapacity - destLength);
+        if(keyLength == 0) {
+            *pErrorCode = U_ILLEGAL_ARGUMENT_ERROR;
+            break;
+        }
+        if(keyLength > destCapacity - destLength) {
+            if(i == 0) {
+                *pErrorCode = U_BUFFER_OVERFLOW_ERROR;
+            }
+            break;
+        }
+        destLength += keyLength;
+        offsets[i + 1] = destLength;
+    }
+    return i;
+}
+
 U_CAPI int32_t U_EXPORT2
 ucol_nextSortKeyPart(const UCollator *coll,
                      UCharIterator *iter,
@@ -0,0 +1,671 @@
+// Copyright (C) 2016 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+/*
+*******************************************************************************
+*   Copyright (C) 2016, International Business Machines
+*   Corporation and others.  All Rights Reserved.
+*******************************************************************************
+*   file name:  ucol_sort.cpp
+*   encoding:   US-ASCII
+*   tab size:   8 (not used)
+*   indentation:4
+*
+*   Sorting and merging arrays of strings with a collator:
+*   ucol_sortStrings(), ucol_mergeSortedRuns() and their UTF-8 versions.
+*/
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_COLLATION
+
+#include "unicode/coll.h"
+#include "unicode/tblcoll.h"
+#include "unicode/ucol.h"
+#include "unicode/ustring.h"
+#include "unicode/utf8.h"
+#include "cmemory.h"
+#include "collationfastlatin.h"
+#include "cstring.h"
+#include "uarrsort.h"
+#include "uparallel.h"
+
+U_NAMESPACE_USE
+
+namespace {
+
+/**
+ * Up to this many strings, comparing them is faster than generating sort keys,
+ * if compare() can use its fast Latin path for all of them.
+ */
+const int32_t MAX_FAST_LATIN_SORT_COUNT = 100000;
+/** Up to this many strings, comparing them is always faster. */
+const int32_t MAX_COMPARE_SORT_COUNT = 32;
+/** Minimum number of strings per sort worker thread. */
+const int32_t MIN_STRINGS_PER_SORT_WORKER = 4096;
+
+/**
+ * The strings to be sorted or merged, and their sort keys if there are any.
+ * Each thread sorts with its own copy because of the errorCode.
+ */
+struct SortInput {
+    const Collator *coll;
+    const UChar *const *strings16;  // NULL for UTF-8 input
+    const char *const *strings8;
+    const int32_t *lengths;
+    const uint8_t *keys;  // NULL when comparing the strings
+    const int32_t *keyOffsets;
+    /** The first failure of comparing strings; the comparator cannot return it. */
+    mutable UErrorCode errorCode;
+};
+
+/** Sets errorCode to the first comparison failure, if there was one. */
+inline void
+getCompareError(const SortInput &in, UErrorCode &errorCode) {
+    if(U_FAILURE(in.errorCode) && U_SUCCESS(errorCode)) {
+        errorCode = in.errorCode;
+    }
+}
+
+inline int32_t
+getLength(const SortInput &in, int32_t i) {
+    return in.lengths != NULL ? in.lengths[i] : -1;
+}
+
+/**
+ * Returns FALSE if a string is NULL but not empty.
+ * compare() and the sort key functions treat such a string as an error,
+ * so it is rejected before choosing between them.
+ */
+UBool
+checkStrings(const SortInput &in, int32_t count) {
+    for(int32_t i = 0; i < count; ++i) {
+        if((in.strings16 != NULL ? in.strings16[i] == NULL : in.strings8[i] == NULL) &&
+                getLength(in, i) != 0) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/**
+ * UComparator for indexes of strings.
+ * Equal strings are ordered by index, which makes the order total,
+ * so that unstable sorting and merging yield stable results.
+ */
+int32_t U_CALLCONV
+compareStrings(const void *context, const void *left, const void *right) {
+    const SortInput &in = *static_cast<const SortInput *>(context);
+    int32_t l = *static_cast<const int32_t *>(left);
+    int32_t r = *static_cast<const int32_t *>(right);
+    if(in.keys != NULL) {
+        // Sort keys contain no 00 bytes except for the terminator.
+        int32_t result = uprv_strcmp(
+            reinterpret_cast<const char *>(in.keys + in.keyOffsets[l]),
+            reinterpret_cast<const char *>(in.keys + in.keyOffsets[r]));
+        if(result != 0) { return result; }
+    } else if(U_SUCCESS(in.errorCode)) {
+        // After a failure, the order does not matter any more.
+        UCollationResult result;
+        if(in.strings16 != NULL) {
+            result = in.coll->compare(in.strings16[l], getLength(in, l),
+                                      in.strings16[r], getLength(in, r), in.errorCode);
+        } else {
+            result = in.coll->internalCompareUTF8(in.strings8[l], getLength(in, l),
+                                                  in.strings8[r], getLength(in, r), in.errorCode);
+        }
+        if(result != UCOL_EQUAL && U_SUCCESS(in.errorCode)) { return result; }
+    }
+    return l - r;
+}
+
+/** A sort key's first 8 bytes, for radix sorting. */
+struct KeyPrefix {
+    uint64_t prefix;  // big-endian, padded with 00 after the terminator
+    int32_t index;
+};
+
+inline uint64_t
+getKeyPrefix(const uint8_t *key) {
+    uint64_t prefix = 0;
+    int32_t i = 0;
+    uint8_t b;
+    do {
+        b = key[i++];
+        prefix = (prefix << 8) | b;
+    } while(b != 0 && i < 8);
+    return prefix << ((8 - i) * 8);
+}
+
+/**
+ * Sorts order[0..length-1], which must be ascending indexes, by the strings' sort keys.
+ * LSD radix sort on the first 8 key bytes, then a comparison sort
+ * for each group of longer keys that share those bytes.
+ * @param buffer scratch space for 2*length items
+ */
+void
+sortByKeyPrefixes(const SortInput &in, int32_t *order, int32_t length,
+                  KeyPrefix *buffer, UErrorCode &errorCode) {
+    KeyPrefix *items = buffer;
+    KeyPrefix *temp = buffer + length;
+    // counts[j] for the byte that is j bytes from the end of the prefix
+    int32_t counts[8][256];
+    uprv_memset(counts, 0, sizeof(counts));
+    for(int32_t i = 0; i < length; ++i) {
+        uint64_t prefix = getKeyPrefix(in.keys + in.keyOffsets[order[i]]);
+        items[i].prefix = prefix;
+        items[i].index = order[i];
+        for(int32_t j = 0; j < 8; ++j) {
+            ++counts[j][(int32_t)(prefix >> (j * 8)) & 0xff];
+        }
+    }
+    for(int32_t j = 0; j < 8; ++j) {
+        int32_t *count = counts[j];
+        if(count[(int32_t)(items[0].prefix >> (j * 8)) & 0xff] == length) {
+            continue;  // all prefixes have the same byte here
+        }
+        int32_t sum = 0;
+        for(int32_t b = 0; b < 256; ++b) {
+            int32_t n = count[b];
+            count[b] = sum;
+            sum += n;
+        }
+        for(int32_t i = 0; i < length; ++i) {
+            temp[count[(int32_t)(items[i].prefix >> (j * 8)) & 0xff]++] = items[i];
+        }
+        KeyPrefix *swap = items;
+        items = temp;
+        temp = swap;
+    }
+    // The radix sort is stable, so items with equal prefixes are still in index order.
+    int32_t start = 0;
+    while(start < length) {
+        uint64_t prefix = items[start].prefix;
+        int32_t limit = start;
+        do {
+            order[limit] = items[limit].index;
+        } while(++limit < length && items[limit].prefix == prefix);
+        if((limit - start) > 1 && (prefix & 0xff) != 0) {
+            // The keys are longer than the prefix.
+            uprv_sortArray(order + start, limit - start, (int32_t)sizeof(int32_t),
+                           compareStrings, &in, FALSE, &errorCode);
+        }
+        start = limit;
+    }
+}
+
+/** Sorts order[0..length-1], which must be ascending indexes. */
+void
+sortChunk(const SortInput &in, int32_t *order, int32_t length,
+          KeyPrefix *buffer, UErrorCode &errorCode) {
+    if(in.keys != NULL) {
+        sortByKeyPrefixes(in, order, length, buffer, errorCode);
+    } else {
+        uprv_sortArray(order, length, (int32_t)sizeof(int32_t),
+                       compareStrings, &in, FALSE, &errorCode);
+        getCompareError(in, errorCode);
+    }
+}
+
+struct SortWorkers {
+    const SortInput *in;
+    int32_t *order;
+    const int32_t *chunkLimits;
+    KeyPrefix *buffer;  // 2 items per string, NULL when comparing the strings
+    UErrorCode *errorCodes;
+};
+
+void U_CALLCONV
+sortWorker(void *context, int32_t workerIndex) {
+    const SortWorkers &workers = *static_cast<const SortWorkers *>(context);
+    int32_t start = workerIndex == 0 ? 0 : workers.chunkLimits[workerIndex - 1];
+    SortInput in = *workers.in;
+    sortChunk(in, workers.order + start, workers.chunkLimits[workerIndex] - start,
+              workers.buffer != NULL ? workers.buffer + 2 * (size_t)start : NULL,
+              workers.errorCodes[workerIndex]);
+}
+
+/**
+ * k-way merge of sorted runs of string indexes, using compareStrings().
+ * Run r is items[runLimits[r-1]..runLimits[r]-1];
+ * if items is NULL, then the items are the indexes 0..runLimits[runCount-1]-1 themselves.
+ * The items of earlier runs must be lower indexes, so that ties go to the earlier run.
+ */
+class RunMerger {
+public:
+    RunMerger(const SortInput &input, const int32_t *runItems,
+              const int32_t *limits, int32_t count)
+            : in(input), items(runItems), runLimits(limits), runCount(count), heapLength(0) {}
+
+    /**
+     * Writes the merged items to dest.
+     * If stopWhenRunEnds, then stops after the last item of the first run that runs out.
+     * @return the number of items written
+     */
+    int32_t merge(int32_t *dest, UBool stopWhenRunEnds, UErrorCode &errorCode);
+
+private:
+    int32_t item(int32_t run) const {
+        return items != NULL ? items[positions[run]] : positions[run];
+    }
+    UBool isLess(int32_t run1, int32_t run2) const {
+        int32_t item1 = item(run1), item2 = item(run2);
+        return compareStrings(&in, &item1, &item2) < 0;
+    }
+    void siftDown(int32_t i);
+
+    const SortInput &in;
+    const int32_t *items;
+    const int32_t *runLimits;
+    int32_t runCount;
+    MaybeStackArray<int32_t, 16> positions;  // next item of each run
+    MaybeStackArray<int32_t, 16> heap;  // runs, with the one with the lowest next item first
+    int32_t heapLength;
+};
+
+void
+RunMerger::siftDown(int32_t i) {
+    int32_t run = heap[i];
+    for(;;) {
+        int32_t child = 2 * i + 1;
+        if(child >= heapLength) { break; }
+        if((child + 1) < heapLength && isLess(heap[child + 1], heap[child])) {
+            ++child;
+        }
+        if(!isLess(heap[child], run)) { break; }
+        heap[i] = heap[child];
+        i = child;
+    }
+    heap[i] = run;
+}
+
+int32_t
+RunMerger::merge(int32_t *dest, UBool stopWhenRunEnds, UErrorCode &errorCode) {
+    if(U_FAILURE(errorCode)) { return 0; }
+    if(runCount > positions.getCapacity() &&
+            (positions.resize(runCount) == NULL || heap.resize(runCount) == NULL)) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+        return 0;
+    }
+    int32_t start = 0;
+    for(int32_t r = 0; r < runCount; ++r) {
+        positions[r] = start;
+        if(runLimits[r] > start) {
+            heap[heapLength++] = r;  // empty runs have no more strings
+        }
+        start = runLimits[r];
+    }
+    for(int32_t i = heapLength / 2 - 1; i >= 0; --i) {
+        siftDown(i);
+    }
+    int32_t length = 0;
+    while(heapLength > 0) {
+        int32_t run = heap[0];
+        dest[length++] = item(run);
+        if(++positions[run] == runLimits[run]) {
+            if(stopWhenRunEnds) { break; }
+            heap[0] = heap[--heapLength];
+            if(heapLength == 0) { break; }
+        }
+        siftDown(0);
+    }
+    getCompareError(in, errorCode);
+    return length;
+}
+
+/**
+ * Which of compare()'s fast tables the strings so far need:
+ * the fast Latin table, and at most one script table.
+ */
+struct FastTableUsage {
+    FastTableUsage() : block(-1), latinExtended(FALSE) {}
+
+    /** @return FALSE if no fast table supports c together with the earlier characters */
+    UBool add(UChar32 c) {
+        if(c <= CollationFastLatin::LATIN1_MAX ||
+                (CollationFastLatin::PUNCT_START <= c && c < CollationFastLatin::PUNCT_LIMIT)) {
+            return TRUE;
+        }
+        if(c <= CollationFastLatin::LATIN_MAX) {
+            latinExtended = TRUE;  // only in the fast Latin table
+            return block < 0;
+        }
+        int32_t b = CollationFastLatin::getScriptBlock(c);
+        if(b < 0 || (block >= 0 && b != block) || latinExtended) { return FALSE; }
+        block = b;
+        return TRUE;
+    }
+
+    int32_t block;
+    UBool latinExtended;
+};
+
+/** Records which fast tables compare() needs for the string. */
+UBool
+addFastTableUsage(const UChar *s, int32_t length, FastTableUsage &usage) {
+    for(int32_t i = 0; length < 0 ? s[i] != 0 : i < length; ++i) {
+        // Surrogates are not in any fast table.
+        if(!usage.add(s[i])) { return FALSE; }
+    }
+    return TRUE;
+}
+
+UBool
+addFastTableUsageUTF8(const char *s, int32_t length, FastTableUsage &usage) {
+    if(length < 0) { length = (int32_t)uprv_strlen(s); }
+    const uint8_t *p = reinterpret_cast<const uint8_t *>(s);
+    for(int32_t i = 0; i < length;) {
+        UChar32 c;
+        U8_NEXT(p, i, length, c);
+        if(c < 0 || !usage.add(c)) { return FALSE; }
+    }
+    return TRUE;
+}
+
+/**
+ * Returns TRUE if the strings should be compared with the collator
+ * rather than sorted by their sort keys.
+ */
+UBool
+compareForSorting(const SortInput &in, int32_t count) {
+    if(count <= MAX_COMPARE_SORT_COUNT) { return TRUE; }
+    if(count > MAX_FAST_LATIN_SORT_COUNT) { return FALSE; }
+    const RuleBasedCollator *rbc = dynamic_cast<const RuleBasedCollator *>(in.coll);
+    if(rbc == NULL || !rbc->internalHasFastLatin()) { return FALSE; }
+    FastTableUsage usage;
+    for(int32_t i = 0; i < count; ++i) {
+        // checkStrings() allows NULL only for empty strings.
+        int32_t length = getLength(in, i);
+        UBool fast;
+        if(in.strings16 != NULL) {
+            fast = in.strings16[i] == NULL || addFastTableUsage(in.strings16[i], length, usage);
+        } else {
+            fast = in.strings8[i] == NULL || addFastTableUsageUTF8(in.strings8[i], length, usage);
+        }
+        if(!fast) { return FALSE; }
+    }
+    return usage.block < 0 || rbc->internalHasFastScriptTable(usage.block);
+}
+
+/**
+ * Generates the sort keys for all of the strings.
+ * @return a buffer with all of the keys, to be released with uprv_free()
+ */
+uint8_t *
+getAllSortKeys(const UCollator *coll,
+               const UChar *const *strings, const int32_t *lengths, int32_t count,
+               int32_t *offsets, int32_t capacity, int32_t threadCount,
+               UErrorCode &errorCode) {
+    uint8_t *keys = (uint8_t *)uprv_malloc(capacity);
+    if(keys == NULL) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+    int32_t next = 0;
+    int32_t keysLength = 0;
+    for(;;) {
+        // Writes offsets[next..next+n] relative to keys+keysLength.
+        int32_t n = ucol_getSortKeys(coll, strings + next, lengths != NULL ? lengths + next : NULL,
+                                     count - next, keys + keysLength, capacity - keysLength,
+                                     offsets + next, threadCount, &errorCode);
+        if(errorCode == U_BUFFER_OVERFLOW_ERROR) {
+            errorCode = U_ZERO_ERROR;
+        }
+        if(U_FAILURE(errorCode)) { break; }
+        for(int32_t i = next; i <= next + n; ++i) {
+            offsets[i] += keysLength;
+        }
+        next += n;
+        keysLength = offsets[next];
+        if(next == count) {
+            return keys;
+        }
+        if(capacity == 0x7fffffff) {
+            errorCode = U_INDEX_OUTOFBOUNDS_ERROR;
+            break;
+        }
+        capacity = capacity <= 0x3fffffff ? 2 * capacity : 0x7fffffff;
+        uint8_t *newKeys = (uint8_t *)uprv_realloc(keys, capacity);
+        if(newKeys == NULL) {
+            errorCode = U_MEMORY_ALLOCATION_ERROR;
+            break;
+        }
+        keys = newKeys;
+    }
+    uprv_free(keys);
+    return NULL;
+}
+
+/**
+ * Converts the UTF-8 strings to one buffer of UTF-16 strings
+ * with the same treatment of ill-formed sequences as ucol_strcollUTF8().
+ * @return the UTF-16 text, to be released with uprv_free()
+ */
+UChar *
+convertToUTF16(const char *const *strings, const int32_t *lengths, int32_t count,
+               const UChar **strings16, int32_t *lengths16, UErrorCode &errorCode) {
+    int64_t capacity = 1;
+    for(int32_t i = 0; i < count; ++i) {
+        int32_t length = lengths != NULL ? lengths[i] : -1;
+        if(length < 0) {
+            length = strings[i] != NULL ? (int32_t)uprv_strlen(strings[i]) : 0;
+        }
+        lengths16[i] = length;  // temporarily
+        capacity += length;  // at most one UChar per byte
+    }
+    if(capacity > 0x7fffffff) {
+        errorCode = U_INDEX_OUTOFBOUNDS_ERROR;
+        return NULL;
+    }
+    UChar *buffer = (UChar *)uprv_malloc(capacity * U_SIZEOF_UCHAR);
+    if(buffer == NULL) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+    int32_t start = 0;
+    for(int32_t i = 0; i < count && U_SUCCESS(errorCode); ++i) {
+        int32_t length16 = 0;
+        if(lengths16[i] > 0) {
+            u_strFromUTF8WithSub(buffer + start, (int32_t)capacity - start, &length16,
+                                 strings[i], lengths16[i], 0xfffd, NULL, &errorCode);
+        }
+        strings16[i] = buffer + start;
+        lengths16[i] = length16;
+        start += length16;
+    }
+    if(U_FAILURE(errorCode)) {
+        uprv_free(buffer);
+        return NULL;
+    }
+    return buffer;
+}
+
+void
+sortStrings(const UCollator *coll,
+            const UChar *const *strings16, const char *const *strings8,
+            const int32_t *lengths, int32_t count,
+            int32_t *order, int32_t threadCount, UErrorCode &errorCode) {
+    for(int32_t i = 0; i < count; ++i) {
+        order[i] = i;
+    }
+    SortInput in = {
+        Collator::fromUCollator(coll), strings16, strings8, lengths, NULL, NULL, U_ZERO_ERROR
+    };
+    if(!checkStrings(in, count)) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    if(count <= 1) { return; }
+
+    uint8_t *keys = NULL;
+    int32_t *keyOffsets = NULL;
+    KeyPrefix *buffer = NULL;
+    if(!compareForSorting(in, count)) {
+        // Sort by sort keys. Keys are generated for UTF-16 text.
+        const UChar **converted = NULL;
+        int32_t *convertedLengths = NULL;
+        UChar *text16 = NULL;
+        if(strings16 == NULL) {
+            converted = (const UChar **)uprv_malloc((size_t)count * sizeof(const UChar *));
+            convertedLengths = (int32_t *)uprv_malloc((size_t)count * 4);
+            if(converted == NULL || convertedLengths == NULL) {
+                errorCode = U_MEMORY_ALLOCATION_ERROR;
+            } else {
+                text16 = convertToUTF16(strings8, lengths, count,
+                                        converted, convertedLengths, errorCode);
+            }
+            strings16 = converted;
+            lengths = convertedLengths;
+        }
+        keyOffsets = (int32_t *)uprv_malloc(((size_t)count + 1) * 4);
+        buffer = (KeyPrefix *)uprv_malloc((size_t)2 * count * sizeof(KeyPrefix));
+        if(keyOffsets == NULL || buffer == NULL) {
+            errorCode = U_MEMORY_ALLOCATION_ERROR;
+        }
+        if(U_SUCCESS(errorCode)) {
+            // Most keys are shorter than twice the string length plus a few bytes;
+            // the buffer grows if necessary.
+            int32_t estimate = count < 0x1000000 ? 16 * count : 0x10000000;
+            keys = getAllSortKeys(coll, strings16, lengths, count,
+                                  keyOffsets, estimate, threadCount, errorCode);
+        }
+        uprv_free(text16);
+        uprv_free(convertedLengths);
+        uprv_free(converted);
+        in.keys = keys;
+        in.keyOffsets = keyOffsets;
+    }
+
+    if(U_SUCCESS(errorCode)) {
+        int32_t chunkCount = count / MIN_STRINGS_PER_SORT_WORKER;
+        if(chunkCount > threadCount) { chunkCount = threadCount; }
+        if(chunkCount <= 1) {
+            sortChunk(in, order, count, buffer, errorCode);
+        } else {
+            // Sort chunks in parallel, then merge them.
+            MaybeStackArray<int32_t, 8> chunkLimits;
+            MaybeStackArray<UErrorCode, 8> errorCodes;
+            int32_t *sorted = (int32_t *)uprv_malloc((size_t)count * 4);
+            if(sorted == NULL ||
+                    (chunkCount > chunkLimits.getCapacity() &&
+                        (chunkLimits.resize(chunkCount) == NULL ||
+                            errorCodes.resize(chunkCount) == NULL))) {
+                errorCode = U_MEMORY_ALLOCATION_ERROR;
+            } else {
+                uprv_memcpy(sorted, order, (size_t)count * 4);
+                for(int32_t w = 0; w < chunkCount; ++w) {
+                    chunkLimits[w] = (int32_t)(((int64_t)count * (w + 1)) / chunkCount);
+                    errorCodes[w] = U_ZERO_ERROR;
+                }
+                SortWorkers workers = {
+                    &in, sorted, chunkLimits.getAlias(), buffer, errorCodes.getAlias()
+                };
+                uprv_runWorkers(chunkCount, sortWorker, &workers);
+                for(int32_t w = 0; w < chunkCount; ++w) {
+                    if(U_FAILURE(errorCodes[w])) {
+                        errorCode = errorCodes[w];
+                        break;
+                    }
+                }
+                RunMerger merger(in, sorted, chunkLimits.getAlias(), chunkCount);
+                merger.merge(order, FALSE, errorCode);
+            }
+            uprv_free(sorted);
+        }
+    }
+    uprv_free(buffer);
+    uprv_free(keyOffsets);
+    uprv_free(keys);
+}
+
+int32_t
+mergeSortedRuns(const UCollator *coll,
+                const UChar *const *strings16, const char *const *strings8,
+                const int32_t *lengths, const int32_t *runLimits, int32_t runCount,
+                int32_t *order, UBool stopWhenRunEnds, UErrorCode &errorCode) {
+    SortInput in = {
+        Collator::fromUCollator(coll), strings16, strings8, lengths, NULL, NULL, U_ZERO_ERROR
+    };
+    if(!checkStrings(in, runCount > 0 ? runLimits[runCount - 1] : 0)) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    RunMerger merger(in, NULL, runLimits, runCount);
+    return merger.merge(order, stopWhenRunEnds, errorCode);
+}
+
+UBool
+checkRunLimits(const int32_t *runLimits, int32_t runCount) {
+    if(runCount < 0 || (runLimits == NULL && runCount > 0)) { return FALSE; }
+    int32_t start = 0;
+    for(int32_t r = 0; r < runCount; ++r) {
+        if(runLimits[r] < start) { return FALSE; }
+        start = runLimits[r];
+    }
+    return TRUE;
+}
+
+}  // namespace
+
+U_CAPI void U_EXPORT2
+ucol_sortStrings(const UCollator *coll,
+                 const UChar *const *strings, const int32_t *lengths, int32_t count,
+                 int32_t *order, int32_t threadCount, UErrorCode *pErrorCode) {
+    if(pErrorCode == NULL || U_FAILURE(*pErrorCode)) {
+        return;
+    }
+    if(coll == NULL || count < 0 || ((strings == NULL || order == NULL) && count > 0)) {
+        *pErrorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    sortStrings(coll, strings, NULL, lengths, count, order, threadCount, *pErrorCode);
+}
+
+U_CAPI void U_EXPORT2
+ucol_sortStringsUTF8(const UCollator *coll,
+                     const char *const *strings, const int32_t *lengths, int32_t count,
+                     int32_t *order, int32_t threadCount, UErrorCode *pErrorCode) {
+    if(pErrorCode == NULL || U_FAILURE(*pErrorCode)) {
+        return;
+    }
+    if(coll == NULL || count < 0 || ((strings == NULL || order == NULL) && count > 0)) {
+        *pErrorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    sortStrings(coll, NULL, strings, lengths, count, order, threadCount, *pErrorCode);
+}
+
+U_CAPI int32_t U_EXPORT2
+ucol_mergeSortedRuns(const UCollator *coll,
+                     const UChar *const *strings, const int32_t *lengths,
+                     const int32_t *runLimits, int32_t runCount,
+                     int32_t *order, UBool stopWhenRunEnds, UErrorCode *pErrorCode) {
+    if(pErrorCode == NULL || U_FAILURE(*pErrorCode)) {
+        return 0;
+    }
+    if(coll == NULL || !checkRunLimits(runLimits, runCount) ||
+            ((strings == NULL || order == NULL) && runCount > 0 && runLimits[runCount - 1] > 0)) {
+        *pErrorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    return mergeSortedRuns(coll, strings, NULL, lengths, runLimits, runCount,
+                           order, stopWhenRunEnds, *pErrorCode);
+}
+
+U_CAPI int32_t U_EXPORT2
+ucol_mergeSortedRunsUTF8(const UCollator *coll,
+                         const char *const *strings, const int32_t *lengths,
+                         const int32_t *runLimits, int32_t runCount,
+                         int32_t *order, UBool stopWhenRunEnds, UErrorCode *pErrorCode) {
+    if(pErrorCode == NULL || U_FAILURE(*pErrorCode)) {
+        return 0;
+    }
+    if(coll == NULL || !checkRunLimits(runLimits, runCount) ||
+            ((strings == NULL || order == NULL) && runCount > 0 && runLimits[runCount - 1] > 0)) {
+        *pErrorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    return mergeSortedRuns(coll, NULL, strings, lengths, runLimits, runCount,
+                           order, stopWhenRunEnds, *pErrorCode);
+}
+
+#endif  // !UCONFIG_NO_COLLATION
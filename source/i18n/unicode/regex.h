@@ -42,6 +42,9 @@
  * expression pattern strings application code can be simplified and the explicit
  * need for <code>RegexPattern</code> objects can usually be eliminated.
  * </p>
+ *
+ * <p>Class <code>RegexSet</code> compiles a list of patterns together, and finds
+ *  out in one pass over an input string which of them match it.</p>
  */
 
 #include "unicode/utypes.h"
@@ -63,8 +66,11 @@ U_NAMESPACE_BEGIN
 
 struct Regex8BitSet;
 class  RegexCImpl;
+class  RegexLazyDFA;
 class  RegexMatcher;
+class  RegexNFA;
 class  RegexPattern;
+class  RegexSetDFA;
 struct REStackFrame;
 class  RuleBasedBreakIterator;
 class  UnicodeSet;
@@ -626,11 +632,23 @@ private:
     Regex8BitSet   *fInitialChars8;
     UBool           fNeedsAltInput;
 
+    int32_t         fRequiredStringIdx;     // A literal string that every match contains,
+    int32_t         fRequiredStringLen;     //   as an index into fLiteralText and a length.
+                                            //   Length zero if there is none.
+    int32_t         fRequiredStringOffset;  // Maximum distance from the start of a match to the
+                                            //   required string, or -1 if unbounded.
+
     UHashtable     *fNamedCaptureMap;  // Map from capture group names to numbers.
 
+    RegexNFA       *fNFA;          // For patterns that find() can match without
+                                   //   backtracking, an NFA for the matchers' lazy DFAs.
+                                   //   NULL for other patterns.
+
     friend class RegexCompile;
     friend class RegexMatcher;
     friend class RegexCImpl;
+    friend class RegexNFA;
+    friend class RegexSet;
 
     //
     //  Implementation Methods
@@ -1795,7 +1813,16 @@ private:
     
     UBool                findUsingChunk(UErrorCode &status);
     void                 MatchChunkAt(int32_t startIdx, UBool toEnd, UErrorCode &status);
+    template<typename CharT>
+    void                 MatchChunkAt(const CharT *inputBuf, int32_t startIdx, UBool toEnd, UErrorCode &status);
     UBool                isChunkWordBoundary(int32_t pos);
+    UBool                skipToRequiredString(const UChar *inputBuf, int32_t &startPos, int32_t &requiredPos);
+
+    UBool                findUsingChunkUTF8(UErrorCode &status);
+    void                 MatchChunkAtUTF8(int32_t startIdx, UBool toEnd, UErrorCode &status);
+    UBool                isChunkWordBoundaryUTF8(int32_t pos);
+    UBool                skipToRequiredStringUTF8(const char *required, int32_t requiredLength,
+                                                  int32_t &startPos, int32_t &requiredPos);
 
     const RegexPattern  *fPattern;
     RegexPattern        *fPatternOwned;    // Non-NULL if this matcher owns the pattern, and
@@ -1806,6 +1833,9 @@ private:
     UText               *fAltInputText;    // A shallow copy of the text being matched.
                                            //   Only created if the pattern contains backreferences.
     int64_t              fInputLength;     // Full length of the input text.
+    const uint8_t       *fInputUTF8;       // The input bytes if fInputText was opened with
+                                           //   utext_openUTF8(), else NULL. Selects
+                                           //   byte-indexed matching, MatchChunkAtUTF8().
     int32_t              fFrameSize;       // The size of a frame in the backtrack stack.
     
     int64_t              fRegionStart;     // Start of the input region, default = 0.
@@ -1872,6 +1902,9 @@ private:
 
     UBool               fInputUniStrMaybeMutable;  // Set when fInputText wraps a UnicodeString that may be mutable - compatibility.
 
+    RegexLazyDFA       *fDFA;              // DFA for find(), created when first needed.
+                                           //   Only for patterns with an NFA.
+
     UBool               fTraceDebug;       // Set true for debug tracing of match engine.
 
     UErrorCode          fDeferredStatus;   // Save error state that cannot be immediately
@@ -1880,6 +1913,125 @@ private:
     RuleBasedBreakIterator  *fWordBreakItr;
 };
 
+
+/**
+ * Class RegexSet holds a list of compiled regular expressions, and tells, in one
+ * pass over an input string, which of them have a match in it.
+ *
+ * <p>The patterns that need no backtracking, ones without anchors, boundaries,
+ * back references, look-around, atomic, possessive or counted constructs, are joined
+ * into a single automaton that scans the input once, however many of them there are.
+ * The others are skipped without being run when none of the characters that can start
+ * their matches occurs in the input, and otherwise each run with its own RegexMatcher.</p>
+ *
+ * <p>A RegexSet keeps matching state, as a RegexMatcher does, so one RegexSet must not
+ * be used from several threads at once.</p>
+ *
+ * <p>Class RegexSet is not intended to be subclassed.</p>
+ *
+ * @draft ICU 58
+ */
+class U_I18N_API RegexSet U_FINAL : public UObject {
+public:
+#ifndef U_HIDE_DRAFT_API
+    /**
+     * Construct a RegexSet from a list of patterns.
+     *
+     * @param patterns  An array of regular expression patterns.
+     * @param count     The number of patterns.
+     * @param flags     The match mode flags to compile every pattern with, as for
+     *                  RegexPattern::compile().  Patterns can use the embedded
+     *                  flag settings, such as (?i), to differ from them.
+     * @param pe        Receives the position of a syntax error within the first
+     *                  pattern that fails to compile.
+     * @param status    A reference to a UErrorCode to receive any errors.
+     * @draft ICU 58
+     */
+    RegexSet(const UnicodeString patterns[], int32_t count, uint32_t flags,
+             UParseError &pe, UErrorCode &status);
+#endif  /* U_HIDE_DRAFT_API */
+
+    /**
+     * Destructor.
+     * @draft ICU 58
+     */
+    virtual ~RegexSet();
+
+#ifndef U_HIDE_DRAFT_API
+    /**
+     * Get the number of patterns in the set.
+     * @return the number of patterns.
+     * @draft ICU 58
+     */
+    int32_t size() const;
+
+    /**
+     * Get one of the compiled patterns of the set.
+     * @param index  The index of the pattern, in the order given to the constructor.
+     * @return the pattern, or NULL if index is out of range.  It is owned by the set.
+     * @draft ICU 58
+     */
+    const RegexPattern *getPattern(int32_t index) const;
+
+    /**
+     * Find which of the patterns match somewhere in an input string, as
+     * RegexMatcher::find() would, starting from the beginning of the input.
+     *
+     * The indexes of the matching patterns are stored in ascending order.
+     * If more than capacity patterns match, the first capacity of them are stored,
+     * the total number is returned, and status is set to U_BUFFER_OVERFLOW_ERROR.
+     *
+     * @param input     The string to match.
+     * @param indexes   Receives the indexes of the matching patterns.  May be NULL
+     *                  if capacity is 0.
+     * @param starts    If not NULL, receives, for each pattern in indexes, the start
+     *                  of its first match.
+     * @param ends      If not NULL, receives, for each pattern in indexes, the end
+     *                  of its first match.
+     * @param capacity  The number of elements that indexes, starts and ends can hold.
+     * @param status    A reference to a UErrorCode to receive any errors.
+     * @return the number of patterns that match.
+     * @draft ICU 58
+     */
+    int32_t find(const UnicodeString &input, int32_t *indexes, int32_t *starts, int32_t *ends,
+                 int32_t capacity, UErrorCode &status);
+#endif  /* U_HIDE_DRAFT_API */
+
+    /**
+     * ICU "poor man's RTTI", returns a UClassID for this class.
+     *
+     * @draft ICU 58
+     */
+    static UClassID U_EXPORT2 getStaticClassID();
+
+    /**
+     * ICU "poor man's RTTI", returns a UClassID for the actual class.
+     *
+     * @draft ICU 58
+     */
+    virtual UClassID getDynamicClassID() const;
+
+private:
+    // Instances of RegexSet can not be assigned, copied, cloned, etc.
+    RegexSet();                                 // default constructor not implemented
+    RegexSet(const RegexSet &other);            // not implemented
+    RegexSet &operator =(const RegexSet &rhs);  // not implemented
+
+    UVector             *fPatterns;        // The compiled patterns, in the order given.
+    UVector             *fMatchers;        // A RegexMatcher for each pattern.
+    int32_t             *fMemberIndexes;   // For each pattern, its index in the set NFA,
+                                           //   or -1 if it has no NFA.
+    UBool               *fMemberMatched;   // For each member of the set NFA, TRUE if it
+                                           //   matched during the current find().
+    RegexNFA            *fNFA;             // The NFAs of the patterns that have one, joined.
+    RegexSetDFA         *fDFA;             // DFA for fNFA.
+
+    UBool               fNeedStartChars;   // TRUE if a pattern without an NFA can only
+                                           //   start matches with certain characters.
+
+    UErrorCode          fDeferredStatus;   // Error from the constructor.
+};
+
 U_NAMESPACE_END
 #endif  // UCONFIG_NO_REGULAR_EXPRESSIONS
 #endif
@@ -790,6 +790,32 @@ public:
      * @internal for tests & tools
      */
     void internalGetCEs(const UnicodeString &str, UVector64 &ces, UErrorCode &errorCode) const;
+
+    /**
+     * Implements ucol_getSortKeys().
+     * @internal
+     */
+    int32_t internalGetSortKeys(const UChar *const *sources, const int32_t *sourceLengths,
+                                int32_t count, uint8_t *dest, int32_t destCapacity,
+                                int32_t *offsets, int32_t threadCount,
+                                UErrorCode &errorCode) const;
+
+    /**
+     * Returns TRUE if compare() has a fast path for strings with
+     * only Latin characters and common punctuation.
+     * Used by ucol_sortStrings() to choose a strategy.
+     * @internal
+     */
+    UBool internalHasFastLatin() const;
+
+    /**
+     * Returns TRUE if compare() has a fast path for strings with
+     * only Latin-1 characters, common punctuation and characters
+     * of the given CollationFastLatin script block.
+     * Used by ucol_sortStrings() to choose a strategy.
+     * @internal
+     */
+    UBool internalHasFastScriptTable(int32_t block) const;
 #endif  // U_HIDE_INTERNAL_API
 
 protected:
@@ -834,6 +860,21 @@ private:
     void writeIdenticalLevel(const UChar *s, const UChar *limit,
                              SortKeyByteSink &sink, UErrorCode &errorCode) const;
 
+    /**
+     * Writes the sort keys for sources[start..limit-1] to dest,
+     * starting at destIndex, and sets offsets[start+1..].
+     * Stops at the first key that does not fit below destLimit,
+     * after writing as many of its bytes as fit.
+     * @return the index of the first string whose key was not written
+     */
+    int32_t writeSortKeys(const UChar *const *sources, const int32_t *sourceLengths,
+                          int32_t start, int32_t limit,
+                          uint8_t *dest, int32_t destIndex, int32_t destLimit,
+                          int32_t *offsets, UErrorCode &errorCode) const;
+
+    /** uprv_runWorkers() function for internalGetSortKeys(). */
+    static void U_CALLCONV sortKeysWorker(void *context, int32_t workerIndex);
+
     const CollationSettings &getDefaultSettings() const;
 
     void setAttributeDefault(int32_t attribute) {
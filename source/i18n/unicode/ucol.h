@@ -1018,6 +1018,166 @@ ucol_getSortKey(const    UCollator    *coll,
         uint8_t        *result,
         int32_t        resultLength);
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Gets the sort keys for an array of strings, written one after another
+ * into a single caller-supplied buffer.
+ * This is much faster than calling ucol_getSortKey() for each string,
+ * and with threadCount>1 the work is split across that many threads.
+ *
+ * Key i is written to dest+offsets[i] and is offsets[i+1]-offsets[i] bytes long,
+ * including its terminating zero byte. The keys are the same as those
+ * from ucol_getSortKey().
+ *
+ * Keys are written in order, as many as fit completely into destCapacity,
+ * so the caller can process the keys that were written and call again for the rest.
+ * The bytes of the first key that does not fit may partially fill
+ * dest[offsets[n]..destCapacity-1]; they are not part of the result.
+ * If not even the first key fits, then U_BUFFER_OVERFLOW_ERROR is set.
+ *
+ * @param coll The UCollator containing the collation rules.
+ * @param sources The strings.
+ * @param sourceLengths The lengths of the strings, or -1 for NUL-terminated ones.
+ *                      If NULL, then all of the strings are NUL-terminated.
+ * @param count The number of strings.
+ * @param dest The buffer for the sort keys.
+ * @param destCapacity The size of dest in bytes.
+ * @param offsets Receives count+1 offsets into dest; offsets[0] is always 0.
+ *                On return, offsets[0..n] are set where n is the return value.
+ * @param threadCount The maximum number of threads to use, including the calling one.
+ *                    Values <=1 generate the keys on the calling thread.
+ *                    The result does not depend on this value.
+ * @param pErrorCode ICU error code
+ * @return The number n of strings whose sort keys were written.
+ *         The keys fill dest[0..offsets[n]-1].
+ * @see ucol_getSortKey
+ * @draft ICU 58
+ */
+U_DRAFT int32_t U_EXPORT2
+ucol_getSortKeys(const UCollator *coll,
+                 const UChar *const *sources, const int32_t *sourceLengths, int32_t count,
+                 uint8_t *dest, int32_t destCapacity, int32_t *offsets,
+                 int32_t threadCount, UErrorCode *pErrorCode);
+
+/**
+ * Sorts an array of strings according to the collator.
+ * The strings themselves are not moved; instead, the sorted order is written
+ * as an array of indexes into the input.
+ * The sort is stable: Strings that compare equal keep their input order.
+ *
+ * Depending on the collator and on the number and contents of the strings,
+ * this compares strings directly (fast for short Latin-script strings with most collators),
+ * or it generates sort keys and sorts those,
+ * which avoids evaluating the collation rules O(n log n) times.
+ * Either way, the result is the same as for sorting with ucol_strcoll().
+ *
+ * @param coll The UCollator containing the collation rules.
+ * @param strings The strings to be sorted.
+ * @param lengths The lengths of the strings, or -1 for NUL-terminated ones.
+ *                If NULL, then all of the strings are NUL-terminated.
+ *                A string may be NULL only if its length is 0.
+ * @param count The number of strings.
+ * @param order Receives count indexes: order[0] is the index of the first string
+ *              in collation order, etc.
+ * @param threadCount The maximum number of threads to use, including the calling one.
+ *                    Values <=1 sort on the calling thread.
+ *                    The result does not depend on this value.
+ * @param pErrorCode ICU error code
+ * @see ucol_strcoll
+ * @see ucol_mergeSortedRuns
+ * @draft ICU 58
+ */
+U_DRAFT void U_EXPORT2
+ucol_sortStrings(const UCollator *coll,
+                 const UChar *const *strings, const int32_t *lengths, int32_t count,
+                 int32_t *order, int32_t threadCount, UErrorCode *pErrorCode);
+
+/**
+ * Sorts an array of UTF-8 strings according to the collator.
+ * Same as ucol_sortStrings() but for UTF-8 input;
+ * the result is the same as for sorting with ucol_strcollUTF8().
+ *
+ * @param coll The UCollator containing the collation rules.
+ * @param strings The UTF-8 strings to be sorted.
+ * @param lengths The lengths of the strings in bytes, or -1 for NUL-terminated ones.
+ *                If NULL, then all of the strings are NUL-terminated.
+ *                A string may be NULL only if its length is 0.
+ * @param count The number of strings.
+ * @param order Receives count indexes: order[0] is the index of the first string
+ *              in collation order, etc.
+ * @param threadCount The maximum number of threads to use, including the calling one.
+ * @param pErrorCode ICU error code
+ * @see ucol_sortStrings
+ * @see ucol_strcollUTF8
+ * @draft ICU 58
+ */
+U_DRAFT void U_EXPORT2
+ucol_sortStringsUTF8(const UCollator *coll,
+                     const char *const *strings, const int32_t *lengths, int32_t count,
+                     int32_t *order, int32_t threadCount, UErrorCode *pErrorCode);
+
+/**
+ * Merges runs of strings that are each already sorted according to the collator,
+ * for example sorted with ucol_sortStrings(), or read back from files
+ * during an external sort.
+ * The runs are consecutive in the strings array: run r is
+ * strings[runLimits[r-1]..runLimits[r]-1], and run 0 starts at index 0.
+ * The merged order is written as indexes into the strings array.
+ * Strings that compare equal are output in run order.
+ *
+ * For an external merge, where each run holds only the next block of strings
+ * from a longer sorted sequence, set stopWhenRunEnds to TRUE.
+ * The merge then stops right after the last string of the first run that
+ * runs out, because the following strings depend on that run's next block.
+ * The caller refills that run (keeping the other runs' remaining strings)
+ * and calls this function again.
+ * Empty runs are treated as having no more strings.
+ *
+ * @param coll The UCollator containing the collation rules.
+ * @param strings The strings of all of the runs.
+ * @param lengths The lengths of the strings, or -1 for NUL-terminated ones.
+ *                If NULL, then all of the strings are NUL-terminated.
+ *                A string may be NULL only if its length is 0.
+ * @param runLimits The exclusive end index of each run, in ascending order.
+ * @param runCount The number of runs.
+ * @param order Receives the merged order, up to runLimits[runCount-1] indexes.
+ * @param stopWhenRunEnds If TRUE, stop when the first run has been output completely.
+ * @param pErrorCode ICU error code
+ * @return The number of indexes written to order.
+ * @see ucol_sortStrings
+ * @draft ICU 58
+ */
+U_DRAFT int32_t U_EXPORT2
+ucol_mergeSortedRuns(const UCollator *coll,
+                     const UChar *const *strings, const int32_t *lengths,
+                     const int32_t *runLimits, int32_t runCount,
+                     int32_t *order, UBool stopWhenRunEnds, UErrorCode *pErrorCode);
+
+/**
+ * Merges runs of UTF-8 strings that are each already sorted according to the collator.
+ * Same as ucol_mergeSortedRuns() but for UTF-8 input.
+ *
+ * @param coll The UCollator containing the collation rules.
+ * @param strings The UTF-8 strings of all of the runs.
+ * @param lengths The lengths of the strings in bytes, or -1 for NUL-terminated ones.
+ *                If NULL, then all of the strings are NUL-terminated.
+ *                A string may be NULL only if its length is 0.
+ * @param runLimits The exclusive end index of each run, in ascending order.
+ * @param runCount The number of runs.
+ * @param order Receives the merged order, up to runLimits[runCount-1] indexes.
+ * @param stopWhenRunEnds If TRUE, stop when the first run has been output completely.
+ * @param pErrorCode ICU error code
+ * @return The number of indexes written to order.
+ * @see ucol_mergeSortedRuns
+ * @draft ICU 58
+ */
+U_DRAFT int32_t U_EXPORT2
+ucol_mergeSortedRunsUTF8(const UCollator *coll,
+                         const char *const *strings, const int32_t *lengths,
+                         const int32_t *runLimits, int32_t runCount,
+                         int32_t *order, UBool stopWhenRunEnds, UErrorCode *pErrorCode);
+#endif  /* U_HIDE_DRAFT_API */
+
 
 /** Gets the next count bytes of a sort key. Caller needs
  *  to preserve state array between calls and to provide
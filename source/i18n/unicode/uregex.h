@@ -19,7 +19,7 @@
  * \file
  * \brief C API: Regular Expressions
  *
- * <p>This is a C wrapper around the C++ RegexPattern and RegexMatcher classes.</p>
+ * <p>This is a C wrapper around the C++ RegexPattern, RegexMatcher and RegexSet classes.</p>
  */
 
 #ifndef UREGEX_H
@@ -41,6 +41,13 @@ struct URegularExpression;
   */
 typedef struct URegularExpression URegularExpression;
 
+struct URegexSet;
+/**
+  * Structure representing a compiled set of regular expressions.
+  * @draft ICU 58
+  */
+typedef struct URegexSet URegexSet;
+
 
 /**
  * Constants for Regular Expression Match Modes.
@@ -348,6 +355,35 @@ uregex_setUText(URegularExpression *regexp,
                 UText              *text,
                 UErrorCode         *status);
 
+#ifndef U_HIDE_DRAFT_API
+/**
+  *  Set the subject text string, in UTF-8, upon which the regular expression
+  *  will look for matches.
+  *  This is equivalent to opening the text with utext_openUTF8() and passing
+  *  it to uregex_setUText(); match operations on it use an engine that works
+  *  directly on the UTF-8 bytes.  All indexes, such as those returned by
+  *  uregex_start() and uregex_end(), are UTF-8 byte offsets.
+  *  <p>
+  *  Regular expression matching operations work directly on the application's
+  *  string data.  No copy is made.  The subject string data must not be
+  *  altered after calling this function until after all regular expression
+  *  operations involving this string data are completed.  
+  *
+  * @param regexp     The compiled regular expression.
+  * @param text       The subject text string, in UTF-8.
+  * @param textLength The length of the subject text in bytes, or -1 if the
+  *                   string is NUL terminated.
+  * @param status     Receives errors detected by this function.
+  *
+  * @draft ICU 58
+  */
+U_DRAFT void U_EXPORT2 
+uregex_setUTF8Text(URegularExpression *regexp,
+                   const char         *text,
+                   int32_t             textLength,
+                   UErrorCode         *status);
+#endif  /* U_HIDE_DRAFT_API */
+
 /**
   *  Get the subject text that is currently associated with this 
   *   regular expression object.  If the input was supplied using uregex_setText(),
@@ -1610,5 +1646,103 @@ uregex_getFindProgressCallback(const URegularExpression          *regexp,
                                 const void                        **context,
                                 UErrorCode                        *status);
 
+#ifndef U_HIDE_DRAFT_API
+/**
+  *  Open (compile) a set of regular expressions.  A URegexSet finds out, in one
+  *  pass over a string, which of its regular expressions match it.
+  *  See the C++ class RegexSet for details.
+  *
+  * @param patterns        An array of the regular expressions to compile.
+  * @param patternLengths  The length of each pattern, or -1 for a pattern that is
+  *                        NUL terminated.  May be NULL if all of them are.
+  * @param count           The number of patterns.
+  * @param flags           Flags that alter the default matching behavior for all
+  *                        of the patterns, as for uregex_open().
+  * @param pe              Receives the position (line and column numbers) of any
+  *                        syntax error within the first pattern that fails to
+  *                        compile.  May be NULL if the caller does not need it.
+  * @param status          Receives error detected by this function.
+  * @return                The URegexSet object.  It must be closed with uregexset_close().
+  * @draft ICU 58
+  */
+U_DRAFT URegexSet * U_EXPORT2
+uregexset_open(const UChar * const *patterns,
+               const int32_t       *patternLengths,
+               int32_t              count,
+               uint32_t             flags,
+               UParseError         *pe,
+               UErrorCode          *status);
+
+/**
+  *  Close a URegexSet, freeing all memory that it uses.
+  *
+  * @param set   The set to be closed.
+  * @draft ICU 58
+  */
+U_DRAFT void U_EXPORT2
+uregexset_close(URegexSet *set);
+
+#if U_SHOW_CPLUSPLUS_API
+
+U_NAMESPACE_BEGIN
+
+/**
+ * \class LocalURegexSetPointer
+ * "Smart pointer" class, closes a URegexSet via uregexset_close().
+ * For most methods see the LocalPointerBase base class.
+ *
+ * @see LocalPointerBase
+ * @see LocalPointer
+ * @draft ICU 58
+ */
+U_DEFINE_LOCAL_OPEN_POINTER(LocalURegexSetPointer, URegexSet, uregexset_close);
+
+U_NAMESPACE_END
+
+#endif
+
+/**
+  *  Get the number of regular expressions in a URegexSet.
+  *
+  * @param set   The set.
+  * @return      The number of regular expressions.
+  * @draft ICU 58
+  */
+U_DRAFT int32_t U_EXPORT2
+uregexset_size(const URegexSet *set);
+
+/**
+  *  Find which of the regular expressions of a set match somewhere in a string,
+  *  as uregex_find() would, starting from the beginning of the string.
+  *
+  *  The indexes of the matching regular expressions are stored in ascending order.
+  *  If more than capacity of them match, the first capacity of them are stored,
+  *  the total number is returned, and status is set to U_BUFFER_OVERFLOW_ERROR.
+  *
+  * @param set        The set.
+  * @param text       The string to match.
+  * @param textLength The length of the string, or -1 if it is NUL terminated.
+  * @param indexes    Receives the indexes of the matching regular expressions.
+  *                   May be NULL if capacity is 0.
+  * @param starts     If not NULL, receives, for each regular expression in indexes,
+  *                   the start of its first match.
+  * @param ends       If not NULL, receives, for each regular expression in indexes,
+  *                   the end of its first match.
+  * @param capacity   The number of elements that indexes, starts and ends can hold.
+  * @param status     Receives errors detected by this function.
+  * @return           The number of regular expressions that match.
+  * @draft ICU 58
+  */
+U_DRAFT int32_t U_EXPORT2
+uregexset_find(URegexSet   *set,
+               const UChar *text,
+               int32_t      textLength,
+               int32_t     *indexes,
+               int32_t     *starts,
+               int32_t     *ends,
+               int32_t      capacity,
+               UErrorCode  *status);
+#endif  /* U_HIDE_DRAFT_API */
+
 #endif   /*  !UCONFIG_NO_REGULAR_EXPRESSIONS  */
 #endif   /*  UREGEX_H  */
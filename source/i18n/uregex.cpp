@@ -427,6 +427,40 @@ uregex_setUText(URegularExpression *regexp2,
 }
 
 
+//------------------------------------------------------------------------------
+//
+//    uregex_setUTF8Text
+//
+//------------------------------------------------------------------------------
+U_CAPI void U_EXPORT2
+uregex_setUTF8Text(URegularExpression *regexp2,
+                   const char         *text,
+                   int32_t             textLength,
+                   UErrorCode         *status) {
+    RegularExpression *regexp = (RegularExpression*)regexp2;
+    if (validateRE(regexp, FALSE, status) == FALSE) {
+        return;
+    }
+    if (text == NULL || textLength < -1) {
+        *status = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+
+    if (regexp->fOwnsText && regexp->fText != NULL) {
+        uprv_free((void *)regexp->fText);
+    }
+
+    regexp->fText       = NULL; // only fill it in on request
+    regexp->fTextLength = -1;
+    regexp->fOwnsText   = TRUE;
+
+    UText input = UTEXT_INITIALIZER;
+    utext_openUTF8(&input, text, textLength, status);
+    regexp->fMatcher->reset(&input);
+    utext_close(&input); // reset() made a shallow clone, so we don't need this copy
+}
+
+
 
 //------------------------------------------------------------------------------
 //
@@ -1973,5 +2007,112 @@ uregex_splitUText(URegularExpression    *regexp2,
 }
 
 
+//----------------------------------------------------------------------------------------
+//
+//    uregexset_open
+//
+//----------------------------------------------------------------------------------------
+U_CAPI URegexSet * U_EXPORT2
+uregexset_open(const UChar * const *patterns,
+               const int32_t       *patternLengths,
+               int32_t              count,
+               uint32_t             flags,
+               UParseError         *pe,
+               UErrorCode          *status) {
+    if (U_FAILURE(*status)) {
+        return NULL;
+    }
+    if (count < 0 || (count > 0 && patterns == NULL)) {
+        *status = U_ILLEGAL_ARGUMENT_ERROR;
+        return NULL;
+    }
+    UnicodeString *patternStrings = new UnicodeString[count > 0 ? count : 1];
+    if (patternStrings == NULL) {
+        *status = U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+    for (int32_t i = 0; i < count; i++) {
+        int32_t patternLength = patternLengths == NULL ? -1 : patternLengths[i];
+        if (patterns[i] == NULL || patternLength < -1 || patternLength == 0) {
+            *status = U_ILLEGAL_ARGUMENT_ERROR;
+            delete [] patternStrings;
+            return NULL;
+        }
+        // Read-only aliases; compiling the patterns copies them.
+        patternStrings[i].setTo(patternLength == -1, patterns[i], patternLength);
+    }
+
+    UParseError localPE;
+    if (pe == NULL) {
+        pe = &localPE;
+    }
+    RegexSet *set = new RegexSet(patternStrings, count, flags, *pe, *status);
+    delete [] patternStrings;
+    if (set == NULL) {
+        *status = U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+    if (U_FAILURE(*status)) {
+        delete set;
+        return NULL;
+    }
+    return (URegexSet *)set;
+}
+
+
+//----------------------------------------------------------------------------------------
+//
+//    uregexset_close
+//
+//----------------------------------------------------------------------------------------
+U_CAPI void U_EXPORT2
+uregexset_close(URegexSet *set) {
+    delete (RegexSet *)set;
+}
+
+
+//----------------------------------------------------------------------------------------
+//
+//    uregexset_size
+//
+//----------------------------------------------------------------------------------------
+U_CAPI int32_t U_EXPORT2
+uregexset_size(const URegexSet *set) {
+    if (set == NULL) {
+        return 0;
+    }
+    return ((const RegexSet *)set)->size();
+}
+
+
+//----------------------------------------------------------------------------------------
+//
+//    uregexset_find
+//
+//----------------------------------------------------------------------------------------
+U_CAPI int32_t U_EXPORT2
+uregexset_find(URegexSet   *set,
+               const UChar *text,
+               int32_t      textLength,
+               int32_t     *indexes,
+               int32_t     *starts,
+               int32_t     *ends,
+               int32_t      capacity,
+               UErrorCode  *status) {
+    if (U_FAILURE(*status)) {
+        return 0;
+    }
+    if (set == NULL || textLength < -1 || (text == NULL && textLength != 0)) {
+        *status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    UnicodeString input;
+    if (text != NULL) {
+        input.setTo(textLength == -1, text, textLength);
+    }
+    return ((RegexSet *)set)->find(input, indexes, starts, ends, capacity, *status);
+}
+
+
 #endif   // !UCONFIG_NO_REGULAR_EXPRESSIONS
 
@@ -34,6 +34,7 @@
 #include "cmemory.h"
 #include "cstring.h"
 #include "ucol_imp.h"
+#include "uarrsort.h"
 
 static void TestAttribute(void);
 static void TestDefault(void);
@@ -89,6 +90,8 @@ void addCollAPITest(TestNode** root)
     addTest(root, &TestBengaliSortKey, "tscoll/capitst/TestBengaliSortKey");
     addTest(root, &TestGetKeywordValuesForLocale, "tscoll/capitst/TestGetKeywordValuesForLocale");
     addTest(root, &TestStrcollNull, "tscoll/capitst/TestStrcollNull");
+    addTest(root, &TestGetSortKeys, "tscoll/capitst/TestGetSortKeys");
+    addTest(root, &TestSortStrings, "tscoll/capitst/TestSortStrings");
 }
 
 void TestGetSetAttr(void) {
@@ -2560,4 +2563,308 @@ static void TestStrcollNull(void) {
     ucol_close(coll);
 }
 
+/*
+ * Compares the keys from one ucol_getSortKeys() call with those from ucol_getSortKey().
+ * Returns the number of keys that were written.
+ */
+static int32_t checkSortKeys(const UCollator *coll, const char *name,
+                             const UChar *const *strings, const int32_t *lengths, int32_t count,
+                             uint8_t *dest, int32_t destCapacity, int32_t *offsets,
+                             int32_t threadCount) {
+    UErrorCode status = U_ZERO_ERROR;
+    uint8_t key[256];
+    int32_t i, keyLength;
+    int32_t n = ucol_getSortKeys(coll, strings, lengths, count,
+                                 dest, destCapacity, offsets, threadCount, &status);
+    if (U_FAILURE(status)) {
+        log_err("ucol_getSortKeys(%s, threads=%d) failed - %s\n", name, threadCount, u_errorName(status));
+        return 0;
+    }
+    if (offsets[0] != 0 || offsets[n] > destCapacity) {
+        log_err("ucol_getSortKeys(%s, threads=%d) offsets[0]=%d offsets[n]=%d out of bounds\n",
+                name, threadCount, offsets[0], offsets[n]);
+        return n;
+    }
+    for (i = 0; i < n; ++i) {
+        keyLength = ucol_getSortKey(coll, strings[i], lengths != NULL ? lengths[i] : -1,
+                                    key, UPRV_LENGTHOF(key));
+        if (keyLength != offsets[i + 1] - offsets[i] ||
+                uprv_memcmp(key, dest + offsets[i], keyLength) != 0) {
+            log_err("ucol_getSortKeys(%s, threads=%d) key %d differs from ucol_getSortKey()\n",
+                    name, threadCount, i);
+            break;
+        }
+    }
+    return n;
+}
+
+static void TestGetSortKeys(void) {
+    /* includes text that fails the FCD check, supplementary and empty strings */
+    static const char *const words[] = {
+        "apple", "Apple", "\\u00e4pfel", "a\\u0308pfel", "\\u1e0b\\u0323x", "co-op", "coop",
+        "\\u0915\\u094d\\u0937", "\\u4e00\\u4e8c", "\\ud800\\udc00x", "", "ZZ top 9"
+    };
+    enum { COUNT = 3000, CAPACITY = 24 };
+    UErrorCode status = U_ZERO_ERROR;
+    UCollator *coll = ucol_open("de", &status);
+    UChar *buffer = (UChar *)malloc(COUNT * CAPACITY * U_SIZEOF_UCHAR);
+    const UChar **strings = (const UChar **)malloc(COUNT * sizeof(const UChar *));
+    int32_t *lengths = (int32_t *)malloc(COUNT * sizeof(int32_t));
+    int32_t *offsets = (int32_t *)malloc((COUNT + 1) * sizeof(int32_t));
+    int32_t destCapacity = COUNT * 80;
+    uint8_t *dest = (uint8_t *)malloc(destCapacity);
+    int32_t i, n, total;
+
+    if (U_FAILURE(status)) {
+        log_err_status(status, "ucol_open(de) failed - %s\n", u_errorName(status));
+        ucol_close(coll);
+        return;
+    }
+    for (i = 0; i < COUNT; ++i) {
+        UChar *s = buffer + i * CAPACITY;
+        int32_t length = u_unescape(words[i % UPRV_LENGTHOF(words)], s, CAPACITY);
+        int32_t number = i / UPRV_LENGTHOF(words);
+        do {
+            s[length++] = (UChar)(0x30 + number % 10);
+            number /= 10;
+        } while (number > 0);
+        s[length] = 0;
+        strings[i] = s;
+        /* mix NUL-terminated strings with ones with explicit lengths */
+        lengths[i] = (i % 3) == 0 ? -1 : length;
+    }
+
+    n = checkSortKeys(coll, "tertiary", strings, lengths, COUNT, dest, destCapacity, offsets, 1);
+    if (n != COUNT) {
+        log_err("ucol_getSortKeys(tertiary, threads=1) wrote %d keys, expected %d\n", n, COUNT);
+    }
+    total = offsets[n];
+    n = checkSortKeys(coll, "tertiary", strings, lengths, COUNT, dest, destCapacity, offsets, 3);
+    if (n != COUNT || offsets[n] != total) {
+        log_err("ucol_getSortKeys(tertiary, threads=3) wrote %d keys, expected %d\n", n, COUNT);
+    }
+    n = checkSortKeys(coll, "NUL-terminated", strings, NULL, COUNT, dest, destCapacity, offsets, 3);
+    if (n != COUNT) {
+        log_err("ucol_getSortKeys(NUL-terminated, threads=3) wrote %d keys, expected %d\n", n, COUNT);
+    }
+
+    /* the keys must stop exactly where the capacity is reached */
+    n = checkSortKeys(coll, "partial", strings, lengths, COUNT, dest, total - 1, offsets, 3);
+    if (n != COUNT - 1) {
+        log_err("ucol_getSortKeys(partial, threads=3) wrote %d keys, expected %d\n", n, COUNT - 1);
+    }
+    n = checkSortKeys(coll, "partial", strings, lengths, COUNT, dest, total / 2, offsets, 1);
+    if (n <= 0 || n >= COUNT || offsets[n] > total / 2) {
+        log_err("ucol_getSortKeys(partial, threads=1) wrote %d keys\n", n);
+    }
+
+    ucol_setStrength(coll, UCOL_IDENTICAL);
+    ucol_setAttribute(coll, UCOL_NORMALIZATION_MODE, UCOL_ON, &status);
+    n = checkSortKeys(coll, "identical", strings, lengths, COUNT, dest, destCapacity, offsets, 3);
+    if (n != COUNT) {
+        log_err("ucol_getSortKeys(identical, threads=3) wrote %d keys, expected %d\n", n, COUNT);
+    }
+
+    status = U_ZERO_ERROR;
+    n = ucol_getSortKeys(coll, strings, lengths, COUNT, dest, 1, offsets, 3, &status);
+    if (n != 0 || status != U_BUFFER_OVERFLOW_ERROR) {
+        log_err("ucol_getSortKeys(capacity 1) returned %d - %s, expected U_BUFFER_OVERFLOW_ERROR\n",
+                n, u_errorName(status));
+    }
+    status = U_ZERO_ERROR;
+    n = ucol_getSortKeys(coll, strings, lengths, 0, NULL, 0, offsets, 3, &status);
+    if (n != 0 || U_FAILURE(status) || offsets[0] != 0) {
+        log_err("ucol_getSortKeys(count 0) returned %d - %s\n", n, u_errorName(status));
+    }
+
+    free(dest);
+    free(offsets);
+    free(lengths);
+    free(strings);
+    free(buffer);
+    ucol_close(coll);
+}
+
+typedef struct {
+    const UCollator *coll;
+    const UChar *const *strings;
+} SortStringsContext;
+
+static int32_t U_CALLCONV
+compareIndexesWithStrcoll(const void *context, const void *left, const void *right) {
+    const SortStringsContext *c = (const SortStringsContext *)context;
+    return ucol_strcoll(c->coll, c->strings[*(const int32_t *)left], -1,
+                        c->strings[*(const int32_t *)right], -1);
+}
+
+/* Checks a sort result against a stable sort with ucol_strcoll(). */
+static void checkSortOrder(const UCollator *coll, const char *name,
+                           const UChar *const *strings, int32_t count, const int32_t *order) {
+    SortStringsContext context;
+    UErrorCode status = U_ZERO_ERROR;
+    int32_t *expected = (int32_t *)malloc(count * sizeof(int32_t));
+    int32_t i;
+    context.coll = coll;
+    context.strings = strings;
+    for (i = 0; i < count; ++i) {
+        expected[i] = i;
+    }
+    uprv_sortArray(expected, count, sizeof(int32_t), compareIndexesWithStrcoll, &context, TRUE, &status);
+    for (i = 0; i < count; ++i) {
+        if (order[i] != expected[i]) {
+            log_err("%s: order[%d]=%d but a stable sort with ucol_strcoll() yields %d\n",
+                    name, i, order[i], expected[i]);
+            break;
+        }
+    }
+    free(expected);
+}
+
+static void TestSortStrings(void) {
+    /* Latin, other scripts, non-FCD text, and duplicates for checking stability */
+    static const char *const words[] = {
+        "apple", "Apple", "\\u00e4pfel", "a\\u0308pfel", "\\u1e0b\\u0323x", "co-op", "coop",
+        "\\u03b1\\u03b2\\u03b3", "\\u0436\\u0443\\u043a", "\\uac00\\ub098", "\\u4e00\\u4e8c",
+        "\\ud800\\udc00x", "", "ZZ top 9", "r\\u00e9sum\\u00e9", "resume"
+    };
+    enum { COUNT = 9000, CAPACITY = 24, RUN_COUNT = 3 };
+    UErrorCode status = U_ZERO_ERROR;
+    UCollator *coll = ucol_open("de", &status);
+    UChar *buffer = (UChar *)malloc(COUNT * CAPACITY * U_SIZEOF_UCHAR);
+    char *buffer8 = (char *)malloc(COUNT * CAPACITY * 3);
+    const UChar **strings = (const UChar **)malloc(COUNT * sizeof(const UChar *));
+    const char **strings8 = (const char **)malloc(COUNT * sizeof(const char *));
+    const UChar **runStrings = (const UChar **)malloc(COUNT * sizeof(const UChar *));
+    int32_t *order = (int32_t *)malloc(COUNT * sizeof(int32_t));
+    int32_t *merged = (int32_t *)malloc(COUNT * sizeof(int32_t));
+    int32_t runLimits[RUN_COUNT];
+    int32_t i, r, start, length;
+
+    if (U_FAILURE(status)) {
+        log_err_status(status, "ucol_open(de) failed - %s\n", u_errorName(status));
+        ucol_close(coll);
+        return;
+    }
+    for (i = 0; i < COUNT; ++i) {
+        UChar *s = buffer + i * CAPACITY;
+        int32_t number = (i / UPRV_LENGTHOF(words)) % 500;
+        length = u_unescape(words[i % UPRV_LENGTHOF(words)], s, CAPACITY);
+        /* numbers repeat, and some strings have none, so there are many equal strings */
+        if ((i % 7) != 0) {
+            do {
+                s[length++] = (UChar)(0x30 + number % 10);
+                number /= 10;
+            } while (number > 0);
+        }
+        s[length] = 0;
+        strings[i] = s;
+        strings8[i] = buffer8 + i * CAPACITY * 3;
+        u_strToUTF8(buffer8 + i * CAPACITY * 3, CAPACITY * 3, NULL, s, -1, &status);
+    }
+    if (U_FAILURE(status)) {
+        log_err("u_strToUTF8() failed - %s\n", u_errorName(status));
+    }
+
+    /* Few Latin strings are compared directly, many strings are sorted by sort keys. */
+    ucol_sortStrings(coll, strings, NULL, 30, order, 1, &status);
+    checkSortOrder(coll, "ucol_sortStrings(30)", strings, 30, order);
+    ucol_sortStrings(coll, strings, NULL, 400, order, 1, &status);
+    checkSortOrder(coll, "ucol_sortStrings(400)", strings, 400, order);
+    ucol_sortStrings(coll, strings, NULL, COUNT, order, 1, &status);
+    checkSortOrder(coll, "ucol_sortStrings(all)", strings, COUNT, order);
+    ucol_sortStrings(coll, strings, NULL, COUNT, order, 3, &status);
+    checkSortOrder(coll, "ucol_sortStrings(all, threads=3)", strings, COUNT, order);
+    ucol_sortStringsUTF8(coll, strings8, NULL, 400, order, 1, &status);
+    checkSortOrder(coll, "ucol_sortStringsUTF8(400)", strings, 400, order);
+    ucol_sortStringsUTF8(coll, strings8, NULL, COUNT, order, 3, &status);
+    checkSortOrder(coll, "ucol_sortStringsUTF8(all, threads=3)", strings, COUNT, order);
+    if (U_FAILURE(status)) {
+        log_err("ucol_sortStrings() failed - %s\n", u_errorName(status));
+    }
+
+    /* Sort three runs separately, then merge them. */
+    start = 0;
+    for (r = 0; r < RUN_COUNT; ++r) {
+        int32_t limit = (COUNT * (r + 1)) / RUN_COUNT - r * 100;
+        ucol_sortStrings(coll, strings + start, NULL, limit - start, order + start, 1, &status);
+        for (i = start; i < limit; ++i) {
+            order[i] += start;
+            runStrings[i] = strings[order[i]];
+        }
+        runLimits[r] = start = limit;
+    }
+    length = ucol_mergeSortedRuns(coll, runStrings, NULL, runLimits, RUN_COUNT, merged, FALSE, &status);
+    if (U_FAILURE(status) || length != start) {
+        log_err("ucol_mergeSortedRuns() failed - %s, length %d\n", u_errorName(status), length);
+    } else {
+        for (i = 0; i < length; ++i) {
+            merged[i] = order[merged[i]];
+        }
+        checkSortOrder(coll, "ucol_mergeSortedRuns()", strings, length, merged);
+    }
+    /* Stop where one run ends: All of that run must be output, and a prefix of the others. */
+    length = ucol_mergeSortedRuns(coll, runStrings, NULL, runLimits, RUN_COUNT, merged, TRUE, &status);
+    if (U_FAILURE(status) || length <= 0 || length >= start) {
+        log_err("ucol_mergeSortedRuns(stopWhenRunEnds) failed - %s, length %d\n",
+                u_errorName(status), length);
+    } else {
+        int32_t runEnds = 0;
+        for (r = 0; r < RUN_COUNT; ++r) {
+            for (i = 0; i < length; ++i) {
+                if (merged[i] == runLimits[r] - 1) {
+                    ++runEnds;
+                    if (i != length - 1) {
+                        log_err("ucol_mergeSortedRuns(stopWhenRunEnds) did not stop after run %d\n", r);
+                    }
+                }
+            }
+        }
+        if (runEnds != 1) {
+            log_err("ucol_mergeSortedRuns(stopWhenRunEnds) output the ends of %d runs\n", runEnds);
+        }
+    }
+
+    /*
+     * A NULL string is an error unless its length is 0,
+     * whether the strings are compared directly (few) or via sort keys (many).
+     */
+    for (i = 0; i < 400; ++i) {
+        runStrings[i] = strings[i];
+        merged[i] = -1;
+    }
+    runStrings[5] = NULL;
+    for (i = 30; i <= 400; i += 370) {
+        status = U_ZERO_ERROR;
+        ucol_sortStrings(coll, runStrings, NULL, i, order, 1, &status);
+        if (status != U_ILLEGAL_ARGUMENT_ERROR) {
+            log_err("ucol_sortStrings(%d, NULL string) - %s, expected U_ILLEGAL_ARGUMENT_ERROR\n",
+                    i, u_errorName(status));
+        }
+        status = U_ZERO_ERROR;
+        merged[5] = 0;
+        ucol_sortStrings(coll, runStrings, merged, i, order, 1, &status);
+        merged[5] = -1;
+        if (U_FAILURE(status) || order[0] != 5) {
+            log_err("ucol_sortStrings(%d, empty NULL string) - %s, order[0]=%d\n",
+                    i, u_errorName(status), order[0]);
+        }
+    }
+
+    status = U_ZERO_ERROR;
+    ucol_sortStrings(coll, strings, NULL, -1, order, 1, &status);
+    if (status != U_ILLEGAL_ARGUMENT_ERROR) {
+        log_err("ucol_sortStrings(count=-1) - %s, expected U_ILLEGAL_ARGUMENT_ERROR\n",
+                u_errorName(status));
+    }
+
+    free(merged);
+    free(order);
+    free(runStrings);
+    free(strings8);
+    free(strings);
+    free(buffer8);
+    free(buffer);
+    ucol_close(coll);
+}
+
 #endif /* #if !UCONFIG_NO_COLLATION */
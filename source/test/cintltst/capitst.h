@@ -137,6 +137,16 @@
      */
     static void TestStrcollNull(void);
 
+    /**
+     * Test ucol_getSortKeys() against ucol_getSortKey()
+     */
+    static void TestGetSortKeys(void);
+
+    /**
+     * Test ucol_sortStrings() and ucol_mergeSortedRuns() against sorting with ucol_strcoll()
+     */
+    static void TestSortStrings(void);
+
 #endif /* #if !UCONFIG_NO_COLLATION */
 
 #endif
@@ -665,6 +665,28 @@ static void TestBreakIteratorStatusVec() {
         numVals = ubrk_getRuleStatusVec(bi, vals, 0, &status);
         TEST_ASSERT(status == U_BUFFER_OVERFLOW_ERROR);
         TEST_ASSERT(numVals == 2);
+
+        /* ubrk_getBoundaries() returns the largest status value, like ubrk_getRuleStatus(). */
+        status = U_ZERO_ERROR;
+        ubrk_first(bi);
+        memset(vals, -1, sizeof(vals));
+        numVals = ubrk_getBoundaries(bi, vals, vals + 5, 5, &status);
+        TEST_ASSERT_SUCCESS(status);
+        TEST_ASSERT(numVals == 3);
+        TEST_ASSERT(vals[0] == 1 && vals[1] == 2 && vals[2] == 3 && vals[3] == -1);
+        TEST_ASSERT(vals[5] == 300 && vals[6] == 300 && vals[7] == 300 && vals[8] == -1);
+        TEST_ASSERT(ubrk_current(bi) == 3);
+        TEST_ASSERT(ubrk_getBoundaries(bi, vals, NULL, 5, &status) == 0);
+
+        /* ubrk_getBoundariesParallel() finds the same boundaries, whatever the thread count. */
+        ubrk_first(bi);
+        memset(vals, -1, sizeof(vals));
+        numVals = ubrk_getBoundariesParallel(bi, vals, vals + 5, 5, 4, &status);
+        TEST_ASSERT_SUCCESS(status);
+        TEST_ASSERT(numVals == 3);
+        TEST_ASSERT(vals[0] == 1 && vals[1] == 2 && vals[2] == 3 && vals[3] == -1);
+        TEST_ASSERT(vals[5] == 300 && vals[6] == 300 && vals[7] == 300 && vals[8] == -1);
+        TEST_ASSERT(ubrk_current(bi) == 3);
     }
 
     ubrk_close(bi);
@@ -1017,6 +1039,23 @@ static void TestBreakIteratorSuppressions(void) {
                 log_err("FAIL: ubrk_next loc \"%s\", expected UBRK_DONE & expOffset -1, got %d and %d\n", itemPtr->locale, offset, *expOffsetPtr);
             }
 
+            expOffsetPtr = itemPtr->expFwdOffsets;
+            ubrk_first(bi);
+            do {
+                int32_t offsets[2];
+                int32_t i;
+                offset = ubrk_getBoundaries(bi, offsets, NULL, 2, &status);
+                for (i = 0; i < offset; i++, expOffsetPtr++) {
+                    if (*expOffsetPtr < 0 || offsets[i] != *expOffsetPtr) {
+                        log_err("FAIL: ubrk_getBoundaries loc \"%s\", expected %d, got %d\n", itemPtr->locale, *expOffsetPtr, offsets[i]);
+                        break;
+                    }
+                }
+            } while (offset == 2 && *expOffsetPtr >= 0 && U_SUCCESS(status));
+            if (U_FAILURE(status) || *expOffsetPtr >= 0) {
+                log_err("FAIL: ubrk_getBoundaries loc \"%s\", status %s, expOffset %d\n", itemPtr->locale, u_errorName(status), *expOffsetPtr);
+            }
+
             expOffsetStart = expOffsetPtr = itemPtr->expFwdOffsets;
             start = ubrk_first(bi) + 1;
             for (; (offset = ubrk_following(bi, start)) != UBRK_DONE && *expOffsetPtr >= 0; expOffsetPtr++) {
@@ -21,6 +21,7 @@
 #include "unicode/uloc.h"
 #include "unicode/ucnv.h"
 #include "unicode/ucnv_err.h"
+#include "unicode/ucnvpool.h"
 #include "unicode/putil.h"
 #include "unicode/uset.h"
 #include "unicode/ustring.h"
@@ -69,6 +70,8 @@ static void TestConvertEx(void);
 static void TestConvertExFromUTF8(void);
 static void TestConvertExFromUTF8_C5F0(void);
 static void TestConvertAlgorithmic(void);
+static void TestBatchConversion(void);
+static void TestConverterPool(void);
        void TestDefaultConverterError(void);    /* defined in cctest.c */
        void TestDefaultConverterSet(void);    /* defined in cctest.c */
 static void TestToUCountPending(void);
@@ -104,6 +107,8 @@ void addTestConvert(TestNode** root)
     addTest(root, &TestConvertExFromUTF8,       "tsconv/ccapitst/TestConvertExFromUTF8");
     addTest(root, &TestConvertExFromUTF8_C5F0,  "tsconv/ccapitst/TestConvertExFromUTF8_C5F0");
     addTest(root, &TestConvertAlgorithmic,      "tsconv/ccapitst/TestConvertAlgorithmic");
+    addTest(root, &TestBatchConversion,         "tsconv/ccapitst/TestBatchConversion");
+    addTest(root, &TestConverterPool,           "tsconv/ccapitst/TestConverterPool");
     addTest(root, &TestDefaultConverterError,   "tsconv/ccapitst/TestDefaultConverterError");
     addTest(root, &TestDefaultConverterSet,     "tsconv/ccapitst/TestDefaultConverterSet");
 #if !UCONFIG_NO_FILE_IO
@@ -2738,6 +2743,256 @@ static void TestConvertExFromUTF8_C5F0() {
     ucnv_close(utf8Cnv);
 }
 
+static void
+TestBatchConversion() {
+    static const char *const bytes[]={
+        "abc", "\xc3\xa4x", "", "z", "\xff", "q"
+    };
+    static const int32_t byteLengths[]={ 3, 3, 0, -1, 1, 1 };
+    static const UChar expected[]={
+        0x61, 0x62, 0x63, 0xe4, 0x78, 0x7a, 0x71
+    };
+    static const int32_t expectedIndexes[]={ 0, 3, 5, 5, 6, 6, 7 };
+
+    UChar dest[20];
+    char bytesOut[20];
+    const UChar *uSources[3];
+    int32_t uLengths[3];
+    int32_t destIndexes[7];
+    UErrorCode itemErrors[6];
+    UConverter *cnv;
+    UErrorCode errorCode;
+    int32_t i, length;
+
+    errorCode=U_ZERO_ERROR;
+    cnv=ucnv_open("UTF-8", &errorCode);
+    ucnv_setToUCallBack(cnv, UCNV_TO_U_CALLBACK_STOP, NULL, NULL, NULL, &errorCode);
+    if(U_FAILURE(errorCode)) {
+        log_data_err("unable to open a UTF-8 converter - %s\n", u_errorName(errorCode));
+        ucnv_close(cnv);
+        return;
+    }
+
+    /* the illegal item fails without stopping the batch */
+    length=ucnv_toUCharsBatch(cnv, dest, UPRV_LENGTHOF(dest),
+                              bytes, byteLengths, UPRV_LENGTHOF(bytes),
+                              destIndexes, itemErrors, &errorCode);
+    if( U_FAILURE(errorCode) || length!=UPRV_LENGTHOF(expected) ||
+        u_memcmp(dest, expected, length)!=0 || dest[length]!=0 ||
+        memcmp(destIndexes, expectedIndexes, sizeof(expectedIndexes))!=0
+    ) {
+        log_err("ucnv_toUCharsBatch() fails (%s), returns %d expect %d\n",
+                u_errorName(errorCode), length, UPRV_LENGTHOF(expected));
+    }
+    for(i=0; i<UPRV_LENGTHOF(bytes); ++i) {
+        UErrorCode expectedError= i==4 ? U_ILLEGAL_CHAR_FOUND : U_ZERO_ERROR;
+        if(itemErrors[i]!=expectedError) {
+            log_err("ucnv_toUCharsBatch() item %d: %s expect %s\n",
+                    i, u_errorName(itemErrors[i]), u_errorName(expectedError));
+        }
+    }
+
+    /* preflighting: the output does not fit but all of the indexes are set */
+    errorCode=U_ZERO_ERROR;
+    memset(destIndexes, 0, sizeof(destIndexes));
+    length=ucnv_toUCharsBatch(cnv, dest, 4,
+                              bytes, byteLengths, UPRV_LENGTHOF(bytes),
+                              destIndexes, itemErrors, &errorCode);
+    if( errorCode!=U_BUFFER_OVERFLOW_ERROR || length!=UPRV_LENGTHOF(expected) ||
+        u_memcmp(dest, expected, 4)!=0 ||
+        memcmp(destIndexes, expectedIndexes, sizeof(expectedIndexes))!=0
+    ) {
+        log_err("ucnv_toUCharsBatch(preflighting) fails (%s expect U_BUFFER_OVERFLOW_ERROR), returns %d expect %d\n",
+                u_errorName(errorCode), length, UPRV_LENGTHOF(expected));
+    }
+
+    /* without itemErrors the first item error stops the batch */
+    errorCode=U_ZERO_ERROR;
+    length=ucnv_toUCharsBatch(cnv, dest, UPRV_LENGTHOF(dest),
+                              bytes, byteLengths, UPRV_LENGTHOF(bytes),
+                              NULL, NULL, &errorCode);
+    if(errorCode!=U_ILLEGAL_CHAR_FOUND || length!=6) {
+        log_err("ucnv_toUCharsBatch(no itemErrors) fails (%s expect U_ILLEGAL_CHAR_FOUND), returns %d expect 6\n",
+                u_errorName(errorCode), length);
+    }
+
+    /* back to UTF-8, with NUL-terminated and length-specified items */
+    uSources[0]=expected;
+    uLengths[0]=3;
+    uSources[1]=expected+3;
+    uLengths[1]=4;
+    uSources[2]=expected;  /* empty item */
+    uLengths[2]=0;
+    errorCode=U_ZERO_ERROR;
+    length=ucnv_fromUCharsBatch(cnv, bytesOut, UPRV_LENGTHOF(bytesOut),
+                                uSources, uLengths, 3,
+                                destIndexes, itemErrors, &errorCode);
+    if( U_FAILURE(errorCode) || length!=8 ||
+        memcmp(bytesOut, "abc\xc3\xa4xzq", 9)!=0 ||
+        destIndexes[0]!=0 || destIndexes[1]!=3 || destIndexes[2]!=8 || destIndexes[3]!=8 ||
+        itemErrors[0]!=U_ZERO_ERROR || itemErrors[1]!=U_ZERO_ERROR || itemErrors[2]!=U_ZERO_ERROR
+    ) {
+        log_err("ucnv_fromUCharsBatch() fails (%s), returns %d expect 8\n",
+                u_errorName(errorCode), length);
+    }
+
+    /* bad arguments */
+    errorCode=U_ZERO_ERROR;
+    ucnv_fromUCharsBatch(cnv, bytesOut, -1, uSources, uLengths, 3, NULL, NULL, &errorCode);
+    if(errorCode!=U_ILLEGAL_ARGUMENT_ERROR) {
+        log_err("ucnv_fromUCharsBatch(destCapacity<0) fails (%s expect U_ILLEGAL_ARGUMENT_ERROR)\n",
+                u_errorName(errorCode));
+    }
+    errorCode=U_ZERO_ERROR;
+    ucnv_toUCharsBatch(cnv, dest, UPRV_LENGTHOF(dest), NULL, NULL, 1, NULL, NULL, &errorCode);
+    if(errorCode!=U_ILLEGAL_ARGUMENT_ERROR) {
+        log_err("ucnv_toUCharsBatch(sources==NULL) fails (%s expect U_ILLEGAL_ARGUMENT_ERROR)\n",
+                u_errorName(errorCode));
+    }
+
+    ucnv_close(cnv);
+}
+
+static UBool
+checkPoolStatistics(const UConverterPool *pool, const char *name,
+                    int32_t checkouts, int32_t hits, int32_t misses,
+                    int32_t evictions, int32_t discards, int32_t size) {
+    int32_t actual[6];
+    actual[0]=ucnv_getPoolStatistic(pool, UCNV_POOL_CHECKOUTS);
+    actual[1]=ucnv_getPoolStatistic(pool, UCNV_POOL_HITS);
+    actual[2]=ucnv_getPoolStatistic(pool, UCNV_POOL_MISSES);
+    actual[3]=ucnv_getPoolStatistic(pool, UCNV_POOL_EVICTIONS);
+    actual[4]=ucnv_getPoolStatistic(pool, UCNV_POOL_DISCARDS);
+    actual[5]=ucnv_getPoolStatistic(pool, UCNV_POOL_SIZE);
+    if( actual[0]!=checkouts || actual[1]!=hits || actual[2]!=misses ||
+        actual[3]!=evictions || actual[4]!=discards || actual[5]!=size
+    ) {
+        log_err("%s: pool statistics %d/%d/%d/%d/%d/%d expect %d/%d/%d/%d/%d/%d\n", name,
+                actual[0], actual[1], actual[2], actual[3], actual[4], actual[5],
+                checkouts, hits, misses, evictions, discards, size);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+static void
+TestConverterPool() {
+    static const UChar longSub[]={ 0x5b, 0x3f, 0x3f, 0x3f, 0x3f, 0x5d, 0 };  /* "[????]" */
+    UConverterPool *pool;
+    UConverter *cnv1, *cnv2, *cnv3;
+    UConverterToUCallback toUAction;
+    UConverterFromUCallback fromUAction;
+    const void *context;
+    char subChars[8];
+    int8_t subCharsLength;
+    UErrorCode errorCode;
+
+    errorCode=U_ZERO_ERROR;
+    pool=ucnv_openPool(0, &errorCode);
+    if(errorCode!=U_ILLEGAL_ARGUMENT_ERROR || pool!=NULL) {
+        log_err("ucnv_openPool(capacity=0) fails (%s expect U_ILLEGAL_ARGUMENT_ERROR)\n",
+                u_errorName(errorCode));
+    }
+    errorCode=U_ZERO_ERROR;
+    pool=ucnv_openPool(2, &errorCode);
+    if(U_FAILURE(errorCode)) {
+        log_err("ucnv_openPool(2) failed - %s\n", u_errorName(errorCode));
+        return;
+    }
+
+    /* modify all of the settings that check-in must restore */
+    cnv1=ucnv_checkoutConverter(pool, "UTF-8", &errorCode);
+    if(U_FAILURE(errorCode)) {
+        log_data_err("unable to check out a UTF-8 converter - %s\n", u_errorName(errorCode));
+        ucnv_closePool(pool);
+        return;
+    }
+    ucnv_setToUCallBack(cnv1, UCNV_TO_U_CALLBACK_STOP, NULL, NULL, NULL, &errorCode);
+    ucnv_setFromUCallBack(cnv1, UCNV_FROM_U_CALLBACK_SKIP, pool, NULL, NULL, &errorCode);
+    ucnv_setSubstChars(cnv1, "?", 1, &errorCode);
+    ucnv_setFallback(cnv1, TRUE);
+    ucnv_checkinConverter(pool, cnv1);
+    checkPoolStatistics(pool, "first checkout", 1, 0, 1, 0, 0, 1);
+
+    /* a different alias for the same converter is a hit */
+    cnv2=ucnv_checkoutConverter(pool, "utf8", &errorCode);
+    if(U_FAILURE(errorCode) || cnv2!=cnv1) {
+        log_err("ucnv_checkoutConverter(utf8) did not reuse the UTF-8 converter - %s\n",
+                u_errorName(errorCode));
+    }
+    checkPoolStatistics(pool, "alias checkout", 2, 1, 1, 0, 0, 1);
+    ucnv_getToUCallBack(cnv2, &toUAction, &context);
+    if(toUAction!=UCNV_TO_U_CALLBACK_SUBSTITUTE || context!=NULL) {
+        log_err("ucnv_checkinConverter() did not restore the toUnicode callback\n");
+    }
+    ucnv_getFromUCallBack(cnv2, &fromUAction, &context);
+    if(fromUAction!=UCNV_FROM_U_CALLBACK_SUBSTITUTE || context!=NULL) {
+        log_err("ucnv_checkinConverter() did not restore the fromUnicode callback\n");
+    }
+    subCharsLength=(int8_t)sizeof(subChars);
+    ucnv_getSubstChars(cnv2, subChars, &subCharsLength, &errorCode);
+    if(U_FAILURE(errorCode) || subCharsLength!=3 || memcmp(subChars, "\xef\xbf\xbd", 3)!=0) {
+        log_err("ucnv_checkinConverter() did not restore the substitution character\n");
+    }
+    if(ucnv_usesFallback(cnv2)) {
+        log_err("ucnv_checkinConverter() did not restore the fallback setting\n");
+    }
+
+    /* an allocated substitution string is released and the default restored */
+    ucnv_setSubstString(cnv2, longSub, -1, &errorCode);
+    if(U_FAILURE(errorCode)) {
+        log_err("ucnv_setSubstString(UTF-8, long) failed - %s\n", u_errorName(errorCode));
+        errorCode=U_ZERO_ERROR;
+    }
+
+    /* the converter is checked out, so this opens another one */
+    cnv3=ucnv_checkoutConverter(pool, "UTF-8", &errorCode);
+    if(U_FAILURE(errorCode) || cnv3==cnv2) {
+        log_err("ucnv_checkoutConverter() returned a converter that is in use - %s\n",
+                u_errorName(errorCode));
+    }
+    checkPoolStatistics(pool, "second converter", 3, 1, 2, 0, 0, 2);
+
+    /* the pool is full of checked-out converters: the third one is not pooled */
+    cnv1=ucnv_checkoutConverter(pool, "UTF-8", &errorCode);
+    ucnv_checkinConverter(pool, cnv1);
+    checkPoolStatistics(pool, "pool full", 4, 1, 3, 0, 1, 2);
+
+    ucnv_checkinConverter(pool, cnv2);
+    ucnv_checkinConverter(pool, cnv3);
+    subCharsLength=(int8_t)sizeof(subChars);
+    ucnv_getSubstChars(cnv2, subChars, &subCharsLength, &errorCode);
+    if(U_FAILURE(errorCode) || subCharsLength!=3 || memcmp(subChars, "\xef\xbf\xbd", 3)!=0) {
+        log_err("ucnv_checkinConverter() did not restore the substitution string\n");
+    }
+
+    /* a new name evicts the least recently checked-in converter */
+    cnv1=ucnv_checkoutConverter(pool, "ISO-8859-1", &errorCode);
+    if(U_FAILURE(errorCode)) {
+        log_err("ucnv_checkoutConverter(ISO-8859-1) failed - %s\n", u_errorName(errorCode));
+    }
+    checkPoolStatistics(pool, "eviction", 5, 1, 4, 1, 1, 2);
+    ucnv_checkinConverter(pool, cnv1);
+    cnv1=ucnv_checkoutConverter(pool, "UTF-8", &errorCode);
+    if(cnv1!=cnv3) {
+        log_err("ucnv_checkoutConverter() evicted the more recently used converter\n");
+    }
+    ucnv_checkinConverter(pool, cnv1);
+
+    /* converters from elsewhere are closed */
+    ucnv_checkinConverter(pool, ucnv_open("UTF-16", &errorCode));
+    ucnv_checkinConverter(pool, NULL);
+    checkPoolStatistics(pool, "foreign checkin", 6, 2, 4, 1, 2, 2);
+
+    errorCode=U_ZERO_ERROR;
+    if(ucnv_checkoutConverter(NULL, "UTF-8", &errorCode)!=NULL || errorCode!=U_ILLEGAL_ARGUMENT_ERROR) {
+        log_err("ucnv_checkoutConverter(pool=NULL) fails (%s expect U_ILLEGAL_ARGUMENT_ERROR)\n",
+                u_errorName(errorCode));
+    }
+    ucnv_closePool(pool);
+    ucnv_closePool(NULL);
+}
+
 static void
 TestConvertAlgorithmic() {
 #if !UCONFIG_NO_LEGACY_CONVERSION
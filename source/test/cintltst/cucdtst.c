@@ -1629,6 +1629,15 @@ enumCharNamesFn(void *context,
     }
 
     ++*pCount;
+    if(nameChoice==U_UNICODE_CHAR_NAME) {
+        /* every modern name is unique and must map back to its code point */
+        UErrorCode errorCode=U_ZERO_ERROR;
+        UChar32 c=u_charFromName(nameChoice, name, &errorCode);
+        if(U_FAILURE(errorCode) || c!=code) {
+            log_err("u_charFromName(%s) gets 0x%lx instead of 0x%lx (%s)\n",
+                    name, c, code, u_errorName(errorCode));
+        }
+    }
     for(i=0; i<UPRV_LENGTHOF(names); ++i) {
         if(code==(UChar32)names[i].code) {
             switch (nameChoice) {
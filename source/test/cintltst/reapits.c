@@ -162,6 +162,8 @@ static void TestUTextAPI(void);
 static void TestRefreshInput(void);
 static void TestBug8421(void);
 static void TestBug10815(void);
+static void TestUTF8Text(void);
+static void TestRegexSet(void);
 
 void addURegexTest(TestNode** root);
 
@@ -173,6 +175,8 @@ void addURegexTest(TestNode** root)
     addTest(root, &TestRefreshInput, "regex/TestRefreshInput");
     addTest(root, &TestBug8421,   "regex/TestBug8421");
     addTest(root, &TestBug10815,   "regex/TestBug10815");
+    addTest(root, &TestUTF8Text,   "regex/TestUTF8Text");
+    addTest(root, &TestRegexSet,   "regex/TestRegexSet");
 }
 
 /*
@@ -2305,5 +2309,116 @@ static void TestBug10815() {
     uregex_close(re);
 }
 
+static void TestUTF8Text(void) {
+    /*
+     *  uregex_setUTF8Text() matches directly on the UTF-8 bytes.
+     *    Match positions are byte offsets into the UTF-8 text.
+     */
+    static const char text[] = "caf\xc3\xa9 \xe4\xb8\x80x \xf0\x9f\x98\x80yz";
+    static const UChar expected[] = {0x63, 0x61, 0x66, 0xe9, 0x20, 0x4e00, 0x78, 0x20,
+                                     0xd83d, 0xde00, 0x79, 0x7a, 0};
+    UChar    buf[20];
+    const UChar *resultText;
+    int32_t  length;
+    URegularExpression *re;
+    UErrorCode status = U_ZERO_ERROR;
+
+    re = uregex_openC("(\\S)([a-z])", 0, 0, &status);
+    TEST_ASSERT_SUCCESS(status);
+
+    uregex_setUTF8Text(re, text, -1, &status);
+    TEST_ASSERT_SUCCESS(status);
+
+    TEST_ASSERT(uregex_findNext(re, &status));
+    TEST_ASSERT(uregex_start(re, 0, &status) == 0);
+    TEST_ASSERT(uregex_end(re, 0, &status) == 2);
+
+    TEST_ASSERT(uregex_findNext(re, &status));
+    TEST_ASSERT(uregex_start(re, 0, &status) == 6);
+    TEST_ASSERT(uregex_start(re, 2, &status) == 9);
+    TEST_ASSERT(uregex_end(re, 0, &status) == 10);
+    length = uregex_group(re, 0, buf, UPRV_LENGTHOF(buf), &status);
+    TEST_ASSERT(length == 2 && buf[0] == 0x4e00 && buf[1] == 0x78);
+
+    TEST_ASSERT(uregex_findNext(re, &status));
+    TEST_ASSERT(uregex_start(re, 0, &status) == 11);
+    TEST_ASSERT(uregex_end(re, 0, &status) == 16);
+
+    TEST_ASSERT(FALSE == uregex_findNext(re, &status));
+    TEST_ASSERT(uregex_hitEnd(re, &status));
+    TEST_ASSERT_SUCCESS(status);
+
+    /* The text is reported back as UTF-16. */
+    resultText = uregex_getText(re, &length, &status);
+    TEST_ASSERT_SUCCESS(status);
+    TEST_ASSERT(length == UPRV_LENGTHOF(expected) - 1);
+    TEST_ASSERT(resultText != NULL && u_strcmp(resultText, expected) == 0);
+
+    /* An explicit length limits the text to its first bytes. */
+    uregex_setUTF8Text(re, text, 5, &status);
+    TEST_ASSERT(uregex_matches(re, 0, &status) == FALSE);
+    TEST_ASSERT(uregex_findNext(re, &status));
+    TEST_ASSERT(uregex_end(re, 0, &status) == 2);
+    TEST_ASSERT(FALSE == uregex_findNext(re, &status));
+    TEST_ASSERT_SUCCESS(status);
+
+    uregex_setUTF8Text(re, NULL, 0, &status);
+    TEST_ASSERT(status == U_ILLEGAL_ARGUMENT_ERROR);
+
+    uregex_close(re);
+}
+
+static void TestRegexSet(void) {
+    /*
+     *  uregexset_find() reports which of the patterns match, and where
+     *    each first matches.
+     */
+    static const UChar pat0[] = {0x5c, 0x64, 0x2b, 0x45, 0x52, 0x52, 0x4f, 0x52, 0};   /* \d+ERROR  */
+    static const UChar pat1[] = {0x28, 0x3f, 0x69, 0x29, 0x77, 0x61, 0x72, 0x6e, 0};   /* (?i)warn  */
+    static const UChar pat2[] = {0x5e, 0x6e, 0x6f, 0};                                /* ^no       */
+    static const UChar pat3[] = {0x28, 0x5c, 0x77, 0x29, 0x5c, 0x31, 0};              /* (\w)\1    */
+    static const UChar *patterns[] = {pat0, pat1, pat2, pat3};
+    static const UChar text[] = {0x57, 0x41, 0x52, 0x4e, 0x20, 0x31, 0x32, 0x45, 0x52, 0x52, 0x4f, 0x52,
+                                 0x20, 0x6f, 0x6b, 0};                               /* WARN 12ERROR ok */
+    static const UChar bad[] = {0x61, 0x28, 0x62, 0};                                /* a(b       */
+    const UChar *badPatterns[] = {pat0, bad};
+    int32_t  indexes[4];
+    int32_t  starts[4];
+    int32_t  ends[4];
+    int32_t  count;
+    UParseError pe;
+    URegexSet *set;
+    UErrorCode status = U_ZERO_ERROR;
+
+    set = uregexset_open(patterns, NULL, UPRV_LENGTHOF(patterns), 0, &pe, &status);
+    TEST_ASSERT_SUCCESS(status);
+    TEST_ASSERT(uregexset_size(set) == 4);
+
+    count = uregexset_find(set, text, -1, indexes, starts, ends, UPRV_LENGTHOF(indexes), &status);
+    TEST_ASSERT_SUCCESS(status);
+    TEST_ASSERT(count == 3);
+    TEST_ASSERT(indexes[0] == 0 && starts[0] == 5 && ends[0] == 12);
+    TEST_ASSERT(indexes[1] == 1 && starts[1] == 0 && ends[1] == 4);
+    TEST_ASSERT(indexes[2] == 3 && starts[2] == 8 && ends[2] == 10);
+
+    /* Preflighting. */
+    count = uregexset_find(set, text, 4, NULL, NULL, NULL, 0, &status);
+    TEST_ASSERT(count == 1 && status == U_BUFFER_OVERFLOW_ERROR);
+    status = U_ZERO_ERROR;
+
+    count = uregexset_find(set, NULL, 0, indexes, NULL, NULL, UPRV_LENGTHOF(indexes), &status);
+    TEST_ASSERT_SUCCESS(status);
+    TEST_ASSERT(count == 0);
+
+    count = uregexset_find(set, text, -1, NULL, NULL, NULL, 1, &status);
+    TEST_ASSERT(count == 0 && status == U_ILLEGAL_ARGUMENT_ERROR);
+    status = U_ZERO_ERROR;
+    uregexset_close(set);
+
+    set = uregexset_open(badPatterns, NULL, UPRV_LENGTHOF(badPatterns), 0, &pe, &status);
+    TEST_ASSERT(status == U_REGEX_MISMATCHED_PAREN && set == NULL);
+    uregexset_close(set);
+}
+
     
 #endif   /*  !UCONFIG_NO_REGULAR_EXPRESSIONS */
@@ -28,6 +28,7 @@
 #include "cstring.h"
 #include "filestrm.h"
 #include "udatamem.h"
+#include "ucmndata.h"
 #include "cintltst.h"
 #include "ubrkimpl.h"
 #include "toolutil.h" /* for uprv_fileExists() */
@@ -73,6 +74,8 @@ static void TestICUDataName(void);
 static void PointerTableOfContents(void);
 static void SetBadCommonData(void);
 static void TestUDataFileAccess(void);
+static void TestUDataPrefault(void);
+static void HashedTableOfContents(void);
 #if !UCONFIG_NO_FORMATTING && !UCONFIG_NO_FILE_IO && !UCONFIG_NO_LEGACY_CONVERSION
 static void TestTZDataDir(void); 
 #endif
@@ -95,8 +98,10 @@ addUDataTest(TestNode** root)
     addTest(root, &TestUDataSetAppData, "udatatst/TestUDataSetAppData" );
     addTest(root, &TestICUDataName, "udatatst/TestICUDataName" );
     addTest(root, &PointerTableOfContents, "udatatst/PointerTableOfContents" );
+    addTest(root, &HashedTableOfContents, "udatatst/HashedTableOfContents" );
     addTest(root, &SetBadCommonData, "udatatst/SetBadCommonData" );
     addTest(root, &TestUDataFileAccess, "udatatst/TestUDataFileAccess" );
+    addTest(root, &TestUDataPrefault, "udatatst/TestUDataPrefault" );
 #if !UCONFIG_NO_FORMATTING && !UCONFIG_NO_FILE_IO && !UCONFIG_NO_LEGACY_CONVERSION
     addTest(root, &TestTZDataDir, "udatatst/TestTZDataDir" );
 #endif
@@ -554,6 +559,59 @@ static void TestUDataFileAccess(){
 }
 
 
+static void TestUDataPrefault(){
+    /* Collation root, Unicode character names, a normalizer and a converter. */
+    static const char *const items[][3]={
+        { U_ICUDATA_NAME U_TREE_SEPARATOR_STRING "coll", "icu", "ucadata" },
+        { NULL, "icu", "unames" },
+        { NULL, "nrm", "nfkc" },
+        { NULL, "cnv", "gb18030" }
+    };
+    UErrorCode status;
+    UDataMemory *result;
+    int32_t i, resident, totalPages;
+
+    for(i=0; i<UPRV_LENGTHOF(items); ++i) {
+        status=U_ZERO_ERROR;
+        result=udata_open(items[i][0], items[i][1], items[i][2], &status);
+        if(U_FAILURE(status)) {
+            log_data_err("FAIL: udata_open(%s.%s) failed - %s\n", items[i][2], items[i][1], u_errorName(status));
+            continue;
+        }
+        udata_prefault(result, UDATA_PREFAULT_WILLNEED|UDATA_PREFAULT_HUGEPAGE|UDATA_PREFAULT_TOUCH, &status);
+        if(status==U_UNSUPPORTED_ERROR) {
+            log_verbose("udata_prefault(%s.%s): length of the data item is unknown\n", items[i][2], items[i][1]);
+            udata_close(result);
+            continue;
+        } else if(U_FAILURE(status)) {
+            log_err("FAIL: udata_prefault(%s.%s) failed - %s\n", items[i][2], items[i][1], u_errorName(status));
+        }
+        totalPages=-1;
+        resident=udata_getResidentPages(result, &totalPages, &status);
+        if(status==U_UNSUPPORTED_ERROR) {
+            log_verbose("udata_getResidentPages() is not supported on this platform\n");
+        } else if(U_FAILURE(status)) {
+            log_err("FAIL: udata_getResidentPages(%s.%s) failed - %s\n", items[i][2], items[i][1], u_errorName(status));
+        } else if(totalPages<=0 || resident!=totalPages) {
+            /* All pages were just touched. */
+            log_err("FAIL: udata_getResidentPages(%s.%s) = %d of %d pages after prefaulting\n",
+                    items[i][2], items[i][1], (int)resident, (int)totalPages);
+        }
+        udata_close(result);
+    }
+
+    status=U_ZERO_ERROR;
+    udata_prefault(NULL, UDATA_PREFAULT_TOUCH, &status);
+    if(status!=U_ILLEGAL_ARGUMENT_ERROR) {
+        log_err("FAIL: udata_prefault(NULL) set %s instead of U_ILLEGAL_ARGUMENT_ERROR\n", u_errorName(status));
+    }
+    status=U_ZERO_ERROR;
+    udata_getResidentPages(NULL, NULL, &status);
+    if(status!=U_ILLEGAL_ARGUMENT_ERROR) {
+        log_err("FAIL: udata_getResidentPages(NULL) set %s instead of U_ILLEGAL_ARGUMENT_ERROR\n", u_errorName(status));
+    }
+}
+
 static UBool U_CALLCONV
 isAcceptable1(void *context,
              const char *type, const char *name,
@@ -1792,6 +1850,150 @@ static void PointerTableOfContents() {
 
 }
 
+#define HASHED_TOC_ITEM_COUNT 40
+
+static uint32_t gHashedTOCPackages[4][1024];
+
+/*
+ * Builds an in-memory .dat package with HASHED_TOC_ITEM_COUNT items
+ * "<pkgName>/itemNN", each a 32-byte header followed by 16 bytes with its number.
+ * With a hash index (format version 1.1), the ToC entries are deliberately
+ * in reverse order so that binary search would miss most items.
+ * Returns the byte offset of the first item, or 0 if the buffer is too small.
+ */
+static int32_t
+buildHashedTOCPackage(uint32_t *pkg, int32_t capacity, const char *pkgName, UBool withHash) {
+    static const UDataInfo itemInfo={
+        sizeof(UDataInfo), 0,
+        U_IS_BIG_ENDIAN, U_CHARSET_FAMILY, sizeof(UChar), 0,
+        {0x31, 0x31, 0x31, 0x31},     /* dataFormat="1111" */
+        {1, 0, 0, 0},                 /* formatVersion */
+        {0, 0, 0, 0}                  /* dataVersion */
+    };
+    uint8_t *bytes=(uint8_t *)pkg;
+    uint8_t *toc;
+    UDataOffsetTOC *pTOC;
+    UDataOffsetTOCHash *pHash=NULL;
+    char name[32];
+    int32_t i, entryIndex, hashLength, namesOffset, itemsOffset, length;
+
+    hashLength= withHash ? 128 : 0;
+    namesOffset=4+8*HASHED_TOC_ITEM_COUNT+(withHash ? 4+4*hashLength : 0);
+    itemsOffset=(int32_t)(namesOffset+HASHED_TOC_ITEM_COUNT*(uprv_strlen(pkgName)+8)+15)&~15;
+    length=32+itemsOffset+HASHED_TOC_ITEM_COUNT*48;
+    if(length>capacity) {
+        return 0;
+    }
+    uprv_memset(bytes, 0, length);
+
+    /* package header */
+    *(uint16_t *)bytes=32;
+    bytes[2]=0xda;
+    bytes[3]=0x27;
+    uprv_memcpy(bytes+4, &itemInfo, sizeof(UDataInfo));
+    ((UDataInfo *)(bytes+4))->dataFormat[0]=0x43;   /* dataFormat="CmnD" */
+    ((UDataInfo *)(bytes+4))->dataFormat[1]=0x6d;
+    ((UDataInfo *)(bytes+4))->dataFormat[2]=0x6e;
+    ((UDataInfo *)(bytes+4))->dataFormat[3]=0x44;
+    ((UDataInfo *)(bytes+4))->formatVersion[1]=(uint8_t)(withHash ? 1 : 0);
+
+    toc=bytes+32;
+    pTOC=(UDataOffsetTOC *)toc;
+    pTOC->count=HASHED_TOC_ITEM_COUNT;
+    if(withHash) {
+        pHash=(UDataOffsetTOCHash *)(pTOC->entry+HASHED_TOC_ITEM_COUNT);
+        pHash->length=(uint32_t)hashLength;
+    }
+    for(i=0; i<HASHED_TOC_ITEM_COUNT; ++i) {
+        entryIndex= withHash ? HASHED_TOC_ITEM_COUNT-1-i : i;
+        sprintf(name, "%s/item%02d", pkgName, (int)i);
+        uprv_strcpy((char *)toc+namesOffset, name);
+        pTOC->entry[entryIndex].nameOffset=(uint32_t)namesOffset;
+        pTOC->entry[entryIndex].dataOffset=(uint32_t)(itemsOffset+48*entryIndex);
+        namesOffset+=(int32_t)uprv_strlen(name)+1;
+
+        /* the item: a data header and its number */
+        *(uint16_t *)(toc+itemsOffset+48*entryIndex)=32;
+        toc[itemsOffset+48*entryIndex+2]=0xda;
+        toc[itemsOffset+48*entryIndex+3]=0x27;
+        uprv_memcpy(toc+itemsOffset+48*entryIndex+4, &itemInfo, sizeof(UDataInfo));
+        *(int32_t *)(toc+itemsOffset+48*entryIndex+32)=i;
+
+        if(withHash) {
+            uint32_t slot=udata_hashTOCEntryName(name)&(hashLength-1);
+            while(pHash->slots[slot]!=0) {
+                slot=(slot+1)&(hashLength-1);
+            }
+            pHash->slots[slot]=(uint32_t)(entryIndex+1);
+        }
+    }
+    return 32+itemsOffset;
+}
+
+/*
+ * Packages 0 and 1 are well-formed, without and with a hash index.
+ * Package 2 has a hash index without empty slots, which must not make lookups loop.
+ * Package 3 has a hash index length that overlaps the item data;
+ * it must be ignored, and its items are not checked because
+ * the binary search does not find most of them in the reversed ToC.
+ */
+static void HashedTableOfContents() {
+    static const char *const pkgNames[4]={
+        "HashedTOC10", "HashedTOC11", "HashedTOCFull", "HashedTOCLong"
+    };
+    char name[16];
+    UDataMemory *dataItem;
+    const void *p;
+    UErrorCode status;
+    int32_t i, j;
+
+    for(j=0; j<4; ++j) {
+        UDataOffsetTOC *pTOC;
+        UDataOffsetTOCHash *pHash;
+        if(buildHashedTOCPackage(gHashedTOCPackages[j], (int32_t)sizeof(gHashedTOCPackages[j]), pkgNames[j], (UBool)(j>=1))==0) {
+            log_err("FAIL: the hashed ToC test package buffer is too small\n");
+            return;
+        }
+        pTOC=(UDataOffsetTOC *)((uint8_t *)gHashedTOCPackages[j]+32);
+        pHash=(UDataOffsetTOCHash *)(pTOC->entry+HASHED_TOC_ITEM_COUNT);
+        if(j==2) {
+            for(i=0; i<(int32_t)pHash->length; ++i) {
+                if(pHash->slots[i]==0) {
+                    pHash->slots[i]=1;
+                }
+            }
+        } else if(j==3) {
+            pHash->length=0x10000000;
+        }
+        status=U_ZERO_ERROR;
+        udata_setAppData(pkgNames[j], gHashedTOCPackages[j], &status);
+        if(U_FAILURE(status)) {
+            log_err("FAIL: udata_setAppData(%s) failed - %s\n", pkgNames[j], u_errorName(status));
+            continue;
+        }
+        for(i=0; j<3 && i<HASHED_TOC_ITEM_COUNT; ++i) {
+            sprintf(name, "item%02d", (int)i);
+            status=U_ZERO_ERROR;
+            dataItem=udata_open(pkgNames[j], NULL, name, &status);
+            if(U_FAILURE(status)) {
+                log_err("FAIL: udata_open(%s, %s) failed - %s\n", pkgNames[j], name, u_errorName(status));
+                continue;
+            }
+            p=udata_getMemory(dataItem);
+            if(p==NULL || *(const int32_t *)p!=i) {
+                log_err("FAIL: udata_open(%s, %s) returned the wrong item\n", pkgNames[j], name);
+            }
+            udata_close(dataItem);
+        }
+        status=U_ZERO_ERROR;
+        dataItem=udata_open(pkgNames[j], NULL, "item99", &status);
+        if(U_SUCCESS(status)) {
+            log_err("FAIL: udata_open(%s, item99) should not have found a nonexistent item\n", pkgNames[j]);
+            udata_close(dataItem);
+        }
+    }
+}
+
 static void SetBadCommonData(void) {
     /* It's difficult to test that udata_setCommonData really works within the test framework.
        So we just test that foolish people can't do bad things. */
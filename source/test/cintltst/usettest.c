@@ -22,6 +22,7 @@ static void TestNonInvariantPattern(void);
 static void TestBadPattern(void);
 static void TestFreezable(void);
 static void TestSpan(void);
+static void TestSerializedFrozen(void);
 
 void addUSetTest(TestNode** root);
 
@@ -45,6 +46,7 @@ addUSetTest(TestNode** root) {
     TEST(TestBadPattern);
     TEST(TestFreezable);
     TEST(TestSpan);
+    TEST(TestSerializedFrozen);
 }
 
 /*------------------------------------------------------------------
@@ -652,4 +654,120 @@ static void TestSpan() {
     uset_close(idSet);
 }
 
+/* Compares a serialized frozen set with the frozen set that was serialized. */
+static void checkSerializedFrozen(const USet *set, const char *name) {
+    static const UChar s16[]={
+        0x61, 0x62, 0x5f, 0x31, 0x20, 0xe01, 0x3000, 0xd800, 0xdc00, 0xdbff, 0xdfff,
+        0x4e00, 0xffff, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4a,
+        0x4b, 0x4c, 0x4d, 0x4e, 0x4f, 0x50, 0x51, 0x52, 0x2e, 0x20, 0xd83d
+    };
+    char s8[200];
+    int32_t length8, i, j, length;
+    UErrorCode errorCode=U_ZERO_ERROR;
+    USerializedFrozenSet sfs;
+    int32_t *data;
+    UChar32 c;
+
+    length=uset_serializeFrozen(set, NULL, 0, &errorCode);
+    if(errorCode!=U_BUFFER_OVERFLOW_ERROR || length<=0) {
+        log_err("uset_serializeFrozen(%s, preflighting) failed - %s\n", name, u_errorName(errorCode));
+        return;
+    }
+    errorCode=U_ZERO_ERROR;
+    data=(int32_t *)malloc(length);
+    if(length!=uset_serializeFrozen(set, data, length, &errorCode) || U_FAILURE(errorCode)) {
+        log_err("uset_serializeFrozen(%s) failed - %s\n", name, u_errorName(errorCode));
+        free(data);
+        return;
+    }
+    uset_getSerializedFrozenSet(&sfs, data, length, &errorCode);
+    if(U_FAILURE(errorCode)) {
+        log_err("uset_getSerializedFrozenSet(%s) failed - %s\n", name, u_errorName(errorCode));
+        free(data);
+        return;
+    }
+
+    for(c=-1; c<=0x110000; ++c) {
+        if(uset_serializedFrozenContains(&sfs, c)!=uset_contains(set, c)) {
+            log_err("uset_serializedFrozenContains(%s, U+%04lx) is wrong\n", name, (long)c);
+            break;
+        }
+    }
+
+    u_strToUTF8WithSub(s8, UPRV_LENGTHOF(s8), &length8, s16, UPRV_LENGTHOF(s16),
+                       0xfffd, NULL, &errorCode);
+    for(i=0; i<UPRV_LENGTHOF(s16); ++i) {
+        for(j=0; j<=USET_SPAN_SIMPLE; ++j) {
+            USetSpanCondition spanCondition=(USetSpanCondition)j;
+            if( uset_serializedFrozenSpan(&sfs, s16+i, UPRV_LENGTHOF(s16)-i, spanCondition)!=
+                    uset_span(set, s16+i, UPRV_LENGTHOF(s16)-i, spanCondition) ||
+                uset_serializedFrozenSpanBack(&sfs, s16, i, spanCondition)!=
+                    uset_spanBack(set, s16, i, spanCondition)
+            ) {
+                log_err("uset_serializedFrozenSpan/Back(%s) is wrong at %d\n", name, (int)i);
+            }
+        }
+    }
+    for(i=0; i<length8; ++i) {
+        for(j=0; j<=USET_SPAN_SIMPLE; ++j) {
+            USetSpanCondition spanCondition=(USetSpanCondition)j;
+            if( uset_serializedFrozenSpanUTF8(&sfs, s8+i, length8-i, spanCondition)!=
+                    uset_spanUTF8(set, s8+i, length8-i, spanCondition) ||
+                uset_serializedFrozenSpanBackUTF8(&sfs, s8, i, spanCondition)!=
+                    uset_spanBackUTF8(set, s8, i, spanCondition)
+            ) {
+                log_err("uset_serializedFrozenSpanUTF8/BackUTF8(%s) is wrong at %d\n", name, (int)i);
+            }
+        }
+    }
+
+    /* Truncated and corrupted data must be rejected. */
+    uset_getSerializedFrozenSet(&sfs, data, length-4, &errorCode);
+    if(errorCode!=U_INVALID_FORMAT_ERROR) {
+        log_err("uset_getSerializedFrozenSet(%s, truncated) - %s\n", name, u_errorName(errorCode));
+    }
+    errorCode=U_ZERO_ERROR;
+    data[0]^=0xff;
+    uset_getSerializedFrozenSet(&sfs, data, length, &errorCode);
+    if(errorCode!=U_INVALID_FORMAT_ERROR) {
+        log_err("uset_getSerializedFrozenSet(%s, bad signature) - %s\n", name, u_errorName(errorCode));
+    }
+    /* A set that was not filled behaves like an empty set. */
+    if( uset_serializedFrozenContains(&sfs, 0x61) ||
+        uset_serializedFrozenContains(NULL, 0x61) ||
+        uset_serializedFrozenSpan(&sfs, s16, UPRV_LENGTHOF(s16), USET_SPAN_CONTAINED)!=0 ||
+        uset_serializedFrozenSpanBack(&sfs, s16, UPRV_LENGTHOF(s16), USET_SPAN_CONTAINED)!=
+            UPRV_LENGTHOF(s16) ||
+        uset_serializedFrozenSpanUTF8(&sfs, s8, length8, USET_SPAN_CONTAINED)!=0 ||
+        uset_serializedFrozenSpanBackUTF8(&sfs, s8, length8, USET_SPAN_CONTAINED)!=length8
+    ) {
+        log_err("uset_serializedFrozen...(%s, not filled) did not behave like an empty set\n", name);
+    }
+    free(data);
+}
+
+static void TestSerializedFrozen() {
+    static const char *const patterns[]={
+        "[]", "[a-z_0-9]", "[:ID_Continue:]", "[^\\u0000-\\u007f]",
+        "[\\U00010000-\\U0010ffff]", "[[:L:][\\ud800-\\udfff]]"
+    };
+    UChar pattern[40];
+    int32_t i;
+
+    for(i=0; i<UPRV_LENGTHOF(patterns); ++i) {
+        UErrorCode errorCode=U_ZERO_ERROR;
+        USet *set;
+        u_uastrcpy(pattern, patterns[i]);
+        set=uset_openPattern(pattern, -1, &errorCode);
+        if(U_FAILURE(errorCode)) {
+            log_data_err("uset_openPattern(%s) failed - %s (Are you missing data?)\n",
+                         patterns[i], u_errorName(errorCode));
+            continue;
+        }
+        uset_freeze(set);
+        checkSerializedFrozen(set, patterns[i]);
+        uset_close(set);
+    }
+}
+
 /*eof*/
@@ -2214,6 +2214,32 @@ void TestCollator::setLocales(const Locale& requestedLocale, const Locale& valid
     Collator::setLocales(requestedLocale, validLocale, actualLocale);
 }
 
+/** A TestCollator whose comparisons fail for strings that start with '!'. */
+class FailingCollator : public TestCollator
+{
+public:
+    using TestCollator::compare;
+
+    virtual UCollationResult compare(const UChar* source,
+                                      int32_t sourceLength,
+                                      const UChar* target,
+                                      int32_t targetLength,
+                                      UErrorCode& status) const;
+};
+
+UCollationResult FailingCollator::compare(const UChar* source,
+                                          int32_t sourceLength,
+                                          const UChar* target,
+                                          int32_t targetLength,
+                                          UErrorCode& status) const
+{
+    if(U_SUCCESS(status) &&
+            ((sourceLength != 0 && source[0] == 0x21) || (targetLength != 0 && target[0] == 0x21))) {
+        status = U_INTERNAL_PROGRAM_ERROR;
+        return UCOL_EQUAL;
+    }
+    return TestCollator::compare(source, sourceLength, target, targetLength, status);
+}
 
 void CollationAPITest::TestSubclass()
 {
@@ -2268,6 +2294,28 @@ void CollationAPITest::TestSubclass()
     if(col1.compare(a.getBuffer(), a.length(), b.getBuffer(), b.length()) != result) {
       errln("Collator doesn't give default result");
     }
+
+    // Sorting and merging must report a failing comparison.
+    FailingCollator failing;
+    static const UChar s0[] = { 0x63, 0 }, s1[] = { 0x61, 0 }, s2[] = { 0x21, 0 }, s3[] = { 0x62, 0 };
+    const UChar *strings[] = { s0, s1, s2, s3 };
+    int32_t order[4];
+    status = U_ZERO_ERROR;
+    ucol_sortStrings(failing.toUCollator(), strings, NULL, 2, order, 1, &status);
+    if(U_FAILURE(status) || order[0] != 1 || order[1] != 0) {
+        errln("ucol_sortStrings(TestCollator) failed - %s", u_errorName(status));
+    }
+    status = U_ZERO_ERROR;
+    ucol_sortStrings(failing.toUCollator(), strings, NULL, 4, order, 1, &status);
+    if(status != U_INTERNAL_PROGRAM_ERROR) {
+        errln("ucol_sortStrings() did not report the comparison error - %s", u_errorName(status));
+    }
+    int32_t runLimits[2] = { 2, 4 };
+    status = U_ZERO_ERROR;
+    ucol_mergeSortedRuns(failing.toUCollator(), strings, NULL, runLimits, 2, order, FALSE, &status);
+    if(status != U_INTERNAL_PROGRAM_ERROR) {
+        errln("ucol_mergeSortedRuns() did not report the comparison error - %s", u_errorName(status));
+    }
 }
 
 void CollationAPITest::TestNULLCharTailoring()
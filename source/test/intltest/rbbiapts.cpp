@@ -1105,6 +1105,53 @@ void RBBIAPITest::TestGetBinaryRules() {
 }
 
 
+// Check that rules compiled from source produce format version 4 data with
+//   8-bit state table rows, and that the compiled iterator agrees with the
+//   iterator loaded from ICU data.
+
+void RBBIAPITest::TestCompactStateTables() {
+    UErrorCode status=U_ZERO_ERROR;
+    LocalPointer<BreakIterator> bi(BreakIterator::createWordInstance(Locale::getEnglish(), status));
+    TEST_ASSERT_SUCCESS(status);
+    RuleBasedBreakIterator *rbbi = dynamic_cast<RuleBasedBreakIterator *>(bi.getAlias());
+    TEST_ASSERT(rbbi != NULL);
+    if (rbbi == NULL) {
+        return;
+    }
+
+    UParseError parseError;
+    RuleBasedBreakIterator compiledBI(rbbi->getRules(), parseError, status);
+    TEST_ASSERT_SUCCESS(status);
+    if (U_FAILURE(status)) {
+        return;
+    }
+
+    uint32_t ruleLength;
+    const RBBIDataHeader *header = (const RBBIDataHeader *)compiledBI.getBinaryRules(ruleLength);
+    TEST_ASSERT(header != NULL && ruleLength > 0);
+    TEST_ASSERT(header->fFormatVersion[0] == 4);
+    const RBBIStateTable *fwdTable = (const RBBIStateTable *)((const char *)header + header->fFTable);
+    TEST_ASSERT((fwdTable->fFlags & RBBI_8BITS_ROWS) != 0);
+    TEST_ASSERT(fwdTable->fRowLen == offsetof(RBBIStateTableRow8, fNextState) + header->fCatCount);
+
+    UnicodeString text("Hello, World! 3.14 isn't \\u0e01\\u0e32\\u0e23 #99 ok.", -1, US_INV);
+    text = text.unescape();
+    rbbi->setText(text);
+    compiledBI.setText(text);
+    int32_t expected = rbbi->first();
+    int32_t actual = compiledBI.first();
+    while (expected != UBRK_DONE) {
+        if (expected != actual || rbbi->getRuleStatus() != compiledBI.getRuleStatus()) {
+            errln("%s:%d boundary mismatch, expected %d, got %d", __FILE__, __LINE__, expected, actual);
+            break;
+        }
+        expected = rbbi->next();
+        actual = compiledBI.next();
+    }
+    TEST_ASSERT(actual == UBRK_DONE);
+}
+
+
 void RBBIAPITest::TestRefreshInputText() {
     /*
      *  RefreshInput changes out the input of a Break Iterator without
@@ -1421,6 +1468,7 @@ void RBBIAPITest::runIndexedTest( int32_t index, UBool exec, const char* &name,
     TESTCASE_AUTO(TestRuleStatus);
     TESTCASE_AUTO(TestRoundtripRules);
     TESTCASE_AUTO(TestGetBinaryRules);
+    TESTCASE_AUTO(TestCompactStateTables);
 #endif
     TESTCASE_AUTO(TestRefreshInputText);
 #if !UCONFIG_NO_BREAK_ITERATION && U_HAVE_STD_STRING
@@ -71,6 +71,11 @@ public:
      **/
     void TestGetBinaryRules(void);
 
+    /**
+     * Test that the compiled rules use the compact, 8-bit row state tables.
+     **/
+    void TestCompactStateTables(void);
+
     /**
      * Tests grouping effect of 'single quotes' in rules.
      **/
@@ -102,6 +102,9 @@ void RBBITest::runIndexedTest( int32_t index, UBool exec, const char* &name, cha
     TESTCASE_AUTO(TestDictRules);
     TESTCASE_AUTO(TestBug5532);
     TESTCASE_AUTO(TestBug7547);
+    TESTCASE_AUTO(TestBoundaryCache);
+    TESTCASE_AUTO(TestGetBoundaries);
+    TESTCASE_AUTO(TestGetBoundariesParallel);
     TESTCASE_AUTO_END;
 }
 
@@ -4633,6 +4636,335 @@ void RBBITest::TestBug7547() {
 }
 
 
+//
+//  TestBoundaryCache    Random access, served from or near the boundary cache,
+//                       must agree with plain forward iteration.
+//
+void RBBITest::TestBoundaryCache() {
+    UErrorCode status = U_ZERO_ERROR;
+    UnicodeString text;
+    for (int32_t i = 0; i < 60; i++) {
+        text.append(UnicodeString(
+            "The quick (\"brown\") fox can't jump 32.3 feet, right? "
+            "\\u0e20\\u0e32\\u0e29\\u0e32\\u0e44\\u0e17\\u0e22\\u0e20\\u0e32\\u0e29\\u0e32\\u0e44\\u0e17\\u0e22 "
+            "\\U0001F600\\U0001F600 Mr. Smith.\\n", -1, US_INV).unescape());
+    }
+    const int32_t textLength = text.length();
+
+    for (int32_t type = 0; type < 3; type++) {
+        LocalPointer<BreakIterator> bi(
+            type == 0 ? BreakIterator::createWordInstance(Locale::getEnglish(), status) :
+            type == 1 ? BreakIterator::createLineInstance(Locale::getEnglish(), status) :
+                        BreakIterator::createSentenceInstance(Locale::getEnglish(), status));
+        LocalPointer<BreakIterator> forward(bi.isValid() ? bi->clone() : NULL);
+        if (U_FAILURE(status) || !forward.isValid()) {
+            dataerrln("%s:%d Failure creating break iterator: %s", __FILE__, __LINE__, u_errorName(status));
+            return;
+        }
+
+        // The boundaries and rule status values found by iterating forwards.
+        UVector32 expected(status);
+        UVector32 expectedStatus(status);
+        forward->setText(text);
+        for (int32_t p = forward->first(); p != BreakIterator::DONE; p = forward->next()) {
+            expected.addElement(p, status);
+            expectedStatus.addElement(forward->getRuleStatus(), status);
+        }
+        if (expected.size() < 150) {
+            errln("%s:%d Test text is too short, only %d boundaries", __FILE__, __LINE__, expected.size());
+        }
+
+        // For each offset, the index of the first boundary at or after it.
+        int32_t *atOrAfter = new int32_t[textLength + 1];
+        for (int32_t i = 0, b = 0; i <= textLength; i++) {
+            while (expected.elementAti(b) < i) {
+                b++;
+            }
+            atOrAfter[i] = b;
+        }
+
+        // Backwards iteration.
+        bi->setText(text);
+        int32_t b = expected.size() - 1;
+        for (int32_t p = bi->last(); p != BreakIterator::DONE; p = bi->previous(), b--) {
+            if (b < 0 || p != expected.elementAti(b) || bi->getRuleStatus() != expectedStatus.elementAti(b)) {
+                errln("%s:%d type %d previous() returned %d, expected %d", __FILE__, __LINE__,
+                      type, p, b < 0 ? -1 : expected.elementAti(b));
+                break;
+            }
+        }
+
+        // Random access, nearby and far away, mixed with stepping.
+        uint32_t seed = 12345;
+        int32_t offset = 0;
+        for (int32_t i = 0; i < 20000; i++) {
+            seed = seed * 1103515245 + 12345;
+            int32_t op = (seed >> 16) % 6;
+            seed = seed * 1103515245 + 12345;
+            int32_t r = (seed >> 16) & 0x7fff;
+            offset = (r & 1) ? r % (textLength + 1) : offset + (r % 41) - 20;
+            if (offset < 0 || offset > textLength) {
+                offset = textLength / 2;
+            }
+            offset = text.getChar32Start(offset);
+            int32_t at = atOrAfter[offset];
+            int32_t result, expectedResult;
+            switch (op) {
+            case 0:
+                result = bi->following(offset);
+                expectedResult = offset == textLength ? BreakIterator::DONE :
+                    expected.elementAti(expected.elementAti(at) == offset ? at + 1 : at);
+                break;
+            case 1:
+                result = bi->preceding(offset);
+                expectedResult = at == 0 ? BreakIterator::DONE : expected.elementAti(at - 1);
+                break;
+            case 2:
+                result = bi->isBoundary(offset);
+                expectedResult = expected.elementAti(at) == offset;
+                if (bi->current() != expected.elementAti(at)) {
+                    errln("%s:%d type %d isBoundary(%d) left the iterator at %d, expected %d",
+                          __FILE__, __LINE__, type, offset, bi->current(), expected.elementAti(at));
+                }
+                break;
+            case 3:
+                at = atOrAfter[bi->current()];
+                result = bi->next();
+                expectedResult = at + 1 < expected.size() ? expected.elementAti(at + 1) : BreakIterator::DONE;
+                break;
+            case 4:
+                at = atOrAfter[bi->current()];
+                result = bi->previous();
+                expectedResult = at > 0 ? expected.elementAti(at - 1) : BreakIterator::DONE;
+                break;
+            default:
+                result = bi->current();
+                expectedResult = expected.elementAti(atOrAfter[result]);
+                break;
+            }
+            if (result != expectedResult) {
+                errln("%s:%d type %d op %d at offset %d returned %d, expected %d",
+                      __FILE__, __LINE__, type, op, offset, result, expectedResult);
+                break;
+            }
+            int32_t pos = bi->current();
+            int32_t statusIdx = atOrAfter[pos];
+            if (expected.elementAti(statusIdx) != pos ||
+                    bi->getRuleStatus() != expectedStatus.elementAti(statusIdx)) {
+                errln("%s:%d type %d op %d at offset %d: bad position %d or rule status %d",
+                      __FILE__, __LINE__, type, op, offset, pos, bi->getRuleStatus());
+                break;
+            }
+        }
+        delete [] atOrAfter;
+    }
+}
+
+//
+//  TestGetBoundaries    Bulk boundaries must match those from next() and getRuleStatus().
+//
+void RBBITest::TestGetBoundaries() {
+    UErrorCode status = U_ZERO_ERROR;
+    UnicodeString text;
+    for (int32_t i = 0; i < 20; i++) {
+        text.append(UnicodeString(
+            "Hello, world!  It's 12:30 \u0e20\u0e32\u0e29\u0e32\u0e44\u0e17\u0e22 "
+            "\u65e5\u672c\u8a9e\u306e\u6587\u7ae0. \U0001F600 Dr. No.\n", -1, US_INV).unescape());
+    }
+
+    for (int32_t type = 0; type < 3; type++) {
+        LocalPointer<RuleBasedBreakIterator> bi((RuleBasedBreakIterator *)(
+            type == 0 ? BreakIterator::createWordInstance(Locale::getEnglish(), status) :
+            type == 1 ? BreakIterator::createLineInstance(Locale::getEnglish(), status) :
+                        BreakIterator::createSentenceInstance(Locale::getEnglish(), status)));
+        if (U_FAILURE(status)) {
+            dataerrln("%s:%d Failure creating break iterator: %s", __FILE__, __LINE__, u_errorName(status));
+            return;
+        }
+
+        UVector32 expected(status);
+        UVector32 expectedStatus(status);
+        bi->setText(text);
+        for (int32_t p = bi->next(); p != BreakIterator::DONE; p = bi->next()) {
+            expected.addElement(p, status);
+            expectedStatus.addElement(bi->getRuleStatus(), status);
+        }
+
+        static const int32_t capacities[] = {1, 7, 64, 1000};
+        int32_t offsets[1000];
+        int32_t statuses[1000];
+        for (int32_t c = 0; c < UPRV_LENGTHOF(capacities); c++) {
+            // From the start of the text, and from a boundary found in reverse,
+            // whose rule status is not yet known.
+            for (int32_t from = 0; from < 2; from++) {
+                int32_t b = 0;
+                if (from == 0) {
+                    bi->first();
+                } else {
+                    b = expected.size() / 2;
+                    bi->preceding(expected.elementAti(b));
+                }
+                for (;;) {
+                    int32_t n = bi->getBoundaries(offsets, statuses, capacities[c], status);
+                    if (U_FAILURE(status)) {
+                        errln("%s:%d getBoundaries() failed: %s", __FILE__, __LINE__, u_errorName(status));
+                        return;
+                    }
+                    for (int32_t i = 0; i < n; i++, b++) {
+                        if (b >= expected.size() || offsets[i] != expected.elementAti(b) ||
+                                statuses[i] != expectedStatus.elementAti(b)) {
+                            errln("%s:%d type %d capacity %d: boundary %d is %d status %d, expected %d status %d",
+                                  __FILE__, __LINE__, type, capacities[c], b, offsets[i], statuses[i],
+                                  b < expected.size() ? expected.elementAti(b) : -1,
+                                  b < expected.size() ? expectedStatus.elementAti(b) : -1);
+                            return;
+                        }
+                    }
+                    if (n > 0 && bi->current() != offsets[n - 1]) {
+                        errln("%s:%d type %d: iterator at %d, expected %d",
+                              __FILE__, __LINE__, type, bi->current(), offsets[n - 1]);
+                    }
+                    if (n < capacities[c]) {
+                        break;
+                    }
+                }
+                if (b != expected.size()) {
+                    errln("%s:%d type %d capacity %d: got %d boundaries, expected %d",
+                          __FILE__, __LINE__, type, capacities[c], b, expected.size());
+                }
+                if (expected.size() > 1 && bi->previous() != expected.elementAti(expected.size() - 2)) {
+                    errln("%s:%d type %d: previous() after getBoundaries() failed", __FILE__, __LINE__, type);
+                }
+            }
+        }
+
+        // Without status values; a zero capacity stores nothing.
+        bi->first();
+        if (bi->getBoundaries(NULL, NULL, 0, status) != 0 || bi->current() != 0) {
+            errln("%s:%d getBoundaries() with zero capacity moved the iterator", __FILE__, __LINE__);
+        }
+        int32_t n = bi->getBoundaries(offsets, NULL, 3, status);
+        if (U_FAILURE(status) || n != 3 || offsets[2] != expected.elementAti(2)) {
+            errln("%s:%d getBoundaries() without statuses failed", __FILE__, __LINE__);
+        }
+        status = U_ZERO_ERROR;
+        bi->getBoundaries(NULL, NULL, 3, status);
+        if (status != U_ILLEGAL_ARGUMENT_ERROR) {
+            errln("%s:%d getBoundaries(NULL) returned %s", __FILE__, __LINE__, u_errorName(status));
+        }
+        status = U_ZERO_ERROR;
+    }
+}
+
+//
+//  TestGetBoundariesParallel    Boundaries found by several threads must be the same
+//                               as those found sequentially.  The text is long enough
+//                               to be divided into chunks, and has long runs of
+//                               dictionary text that straddle the chunk limits.
+//
+void RBBITest::TestGetBoundariesParallel() {
+    UErrorCode status = U_ZERO_ERROR;
+    static const char *const pieces[] = {
+        "Hello, world! ", "It's 12:30. ", "Dr. No. ", "3.14159 ", "\\u201cquoted\\u201d ",
+        "\\u0e20\\u0e32\\u0e29\\u0e32\\u0e44\\u0e17\\u0e22", "\\u65e5\\u672c\\u8a9e\\u306e\\u6587\\u7ae0\\u3002",
+        "\\U0001F600 ", "\\u05e9\\u05dc\\u05d5\\u05dd ", "\n", "  ", "(ok) "
+    };
+    UnicodeString thaiRun = UnicodeString(
+        "\\u0e01\\u0e32\\u0e23\\u0e17\\u0e14\\u0e2a\\u0e2d\\u0e1a\\u0e20\\u0e32\\u0e29\\u0e32\\u0e44\\u0e17\\u0e22", -1, US_INV).unescape();
+    UnicodeString text;
+    uint32_t seed = 1;
+    while (text.length() < 150000) {
+        seed = seed * 1103515245 + 12345;
+        int32_t r = (int32_t)((seed >> 16) % (UPRV_LENGTHOF(pieces) + 1));
+        if (r < UPRV_LENGTHOF(pieces)) {
+            text.append(UnicodeString(pieces[r], -1, US_INV).unescape());
+        } else {
+            // A long run without spaces, segmented by the dictionary.
+            for (int32_t i = (int32_t)((seed >> 8) % 400); i >= 0; --i) {
+                text.append(thaiRun);
+            }
+        }
+    }
+
+    for (int32_t type = 0; type < 3; type++) {
+        LocalPointer<RuleBasedBreakIterator> bi((RuleBasedBreakIterator *)(
+            type == 0 ? BreakIterator::createWordInstance(Locale::getEnglish(), status) :
+            type == 1 ? BreakIterator::createLineInstance(Locale::getEnglish(), status) :
+                        BreakIterator::createSentenceInstance(Locale::getEnglish(), status)));
+        if (U_FAILURE(status)) {
+            dataerrln("%s:%d Failure creating break iterator: %s", __FILE__, __LINE__, u_errorName(status));
+            return;
+        }
+
+        UVector32 expected(status);
+        UVector32 expectedStatus(status);
+        bi->setText(text);
+        for (int32_t p = bi->next(); p != BreakIterator::DONE; p = bi->next()) {
+            expected.addElement(p, status);
+            expectedStatus.addElement(bi->getRuleStatus(), status);
+        }
+
+        static const int32_t capacities[] = {150000, 60000, 5000};
+        static const int32_t threadCounts[] = {2, 3, 8};
+        LocalArray<int32_t> offsets(new int32_t[150000]);
+        LocalArray<int32_t> statuses(new int32_t[150000]);
+        for (int32_t c = 0; c < UPRV_LENGTHOF(capacities); c++) {
+            for (int32_t t = 0; t < UPRV_LENGTHOF(threadCounts); t++) {
+                // From the start of the text, and from the middle.
+                for (int32_t from = 0; from < 2; from++) {
+                    int32_t b = 0;
+                    if (from == 0) {
+                        bi->first();
+                    } else {
+                        b = expected.size() / 3;
+                        bi->following(expected.elementAti(b) - 1);
+                        ++b;
+                    }
+                    for (;;) {
+                        int32_t n = bi->getBoundaries(offsets.getAlias(), statuses.getAlias(), capacities[c],
+                                                      threadCounts[t], status);
+                        if (U_FAILURE(status)) {
+                            errln("%s:%d getBoundaries() failed: %s", __FILE__, __LINE__, u_errorName(status));
+                            return;
+                        }
+                        for (int32_t i = 0; i < n; i++, b++) {
+                            if (b >= expected.size() || offsets[i] != expected.elementAti(b) ||
+                                    statuses[i] != expectedStatus.elementAti(b)) {
+                                errln("%s:%d type %d capacity %d threads %d: boundary %d is %d status %d, expected %d status %d",
+                                      __FILE__, __LINE__, type, capacities[c], threadCounts[t], b, offsets[i], statuses[i],
+                                      b < expected.size() ? expected.elementAti(b) : -1,
+                                      b < expected.size() ? expectedStatus.elementAti(b) : -1);
+                                return;
+                            }
+                        }
+                        if (n > 0 && bi->current() != offsets[n - 1]) {
+                            errln("%s:%d type %d: iterator at %d, expected %d",
+                                  __FILE__, __LINE__, type, bi->current(), offsets[n - 1]);
+                        }
+                        if (n < capacities[c]) {
+                            break;
+                        }
+                    }
+                    if (b != expected.size()) {
+                        errln("%s:%d type %d capacity %d threads %d: got %d boundaries, expected %d",
+                              __FILE__, __LINE__, type, capacities[c], threadCounts[t], b, expected.size());
+                    }
+                }
+            }
+        }
+
+        // Mid-way through the text, the iterator continues where the threads left off.
+        bi->first();
+        int32_t half = expected.size() / 2;
+        int32_t n = bi->getBoundaries(offsets.getAlias(), NULL, half, 4, status);
+        if (U_FAILURE(status) || n != half || bi->next() != expected.elementAti(n) ||
+                bi->getRuleStatus() != expectedStatus.elementAti(n) ||
+                bi->previous() != expected.elementAti(n - 1)) {
+            errln("%s:%d type %d: iteration after getBoundaries() failed", __FILE__, __LINE__, type);
+        }
+    }
+}
+
 //
 //  TestDebug    -  A place-holder test for debugging purposes.
 //                  For putting in fragments of other tests that can be invoked
@@ -75,6 +75,9 @@ public:
     void TestBug5532();
     void TestBug9983();
     void TestBug7547();
+    void TestBoundaryCache();
+    void TestGetBoundaries();
+    void TestGetBoundariesParallel();
 
     void TestDebug();
     void TestProperties();
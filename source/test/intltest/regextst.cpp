@@ -38,6 +38,7 @@
 #include "unicode/usetiter.h"
 #include "unicode/ustring.h"
 #include "unicode/utext.h"
+#include "unicode/utf8.h"
 
 #include "regextst.h"
 #include "regexcmp.h"
@@ -162,6 +163,18 @@ void RegexTest::runIndexedTest( int32_t index, UBool exec, const char* &name, ch
         case 28: name = "NamedCaptureLimits";
             if (exec) NamedCaptureLimits();
             break;
+        case 29: name = "TestUTF8ChunkMatch";
+            if (exec) TestUTF8ChunkMatch();
+            break;
+        case 30: name = "TestLazyDFA";
+            if (exec) TestLazyDFA();
+            break;
+        case 31: name = "TestRequiredString";
+            if (exec) TestRequiredString();
+            break;
+        case 32: name = "TestRegexSet";
+            if (exec) TestRegexSet();
+            break;
         default: name = "";
             break; //needed to end loop
     }
@@ -5834,4 +5847,498 @@ void RegexTest::TestBug11480() {
 }
 
 
+//--------------------------------------------------------------
+//
+//  TestUTF8ChunkMatch   Input opened with utext_openUTF8() is matched
+//                       directly on the UTF-8 bytes.  Check that it finds
+//                       the same matches as the equivalent UTF-16 string,
+//                       with the indexes mapped to byte offsets.
+//
+//---------------------------------------------------------------
+void RegexTest::TestUTF8ChunkMatch() {
+    static const struct {
+        const char *pattern;
+        uint32_t    flags;
+    } patterns[] = {
+        { "abc", 0 },
+        { "a.c", 0 },
+        { "x", 0 },
+        { "\\u00e9x", 0 },
+        { "\\w+", 0 },
+        { "\\b\\w+\\b", 0 },
+        { "\\B.", 0 },
+        { "^\\w*", 0 },
+        { "\\w*$", 0 },
+        { "^.", UREGEX_MULTILINE },
+        { ".$", UREGEX_MULTILINE },
+        { ".$", UREGEX_MULTILINE | UREGEX_UNIX_LINES },
+        { "^.", UREGEX_MULTILINE | UREGEX_UNIX_LINES },
+        { ".", UREGEX_UNIX_LINES },
+        { ".*", 0 },
+        { ".*x", 0 },
+        { ".+?\\s", UREGEX_DOTALL },
+        { "[\\u00e9\\u4e00-\\u4e0f]+", 0 },
+        { "[^a-z ]", 0 },
+        { "\\u4e00\\u4e01", 0 },
+        { "stra\\u00dfe", UREGEX_CASE_INSENSITIVE },
+        { "\\u00c9", UREGEX_CASE_INSENSITIVE },
+        { "(\\w)\\1", 0 },
+        { "(\\w+) \\1", UREGEX_CASE_INSENSITIVE },
+        { "(.)(.)\\2\\1", 0 },
+        { "\\X", 0 },
+        { "\\R", 0 },
+        { "\\v", 0 },
+        { "\\h+", 0 },
+        { "\\d+", 0 },
+        { "\\p{L}+", 0 },
+        { "\\S+", 0 },
+        { "(?<=\\u00e9)x", 0 },
+        { "(?<!\\u00e9)x", 0 },
+        { "(?<=\\u4e00\\u4e01 ?)\\w", 0 },
+        { "x(?=\\u4e00)", 0 },
+        { "a{2,3}", 0 },
+        { "\\u00e9*?x", 0 },
+        { "\\U0001f600", 0 },
+        { "\\ufffd+", 0 },
+        { "(a|\\u00e9|\\u4e00)+b?", 0 },
+        { "\\Z", 0 },
+        { "\\z", 0 },
+        { "\\b", UREGEX_UWORD },
+        { "(?:\\u00e9|e\\u0301)\\b", 0 }
+    };
+    static const char *inputs[] = {
+        "abc \xC3\xA9x \xE4\xB8\x80\xE4\xB8\x81 xx aaa stra\xC3\x9F" "e STRASSE abc",
+        "one\r\ntwo\xC2\x85three\xE2\x80\xA8" "four\nfive\r",
+        "\xF0\x9F\x98\x80 aa bb 11 \xD9\xA2\xD9\xA3 \xE4\xB8\x80x \xC3\xA9\xC3\xA9\xC3\xA9x",
+        "e\xCC\x81 x\xCC\x81\xCC\x82 ga\xCC\x80 \xE1\x84\x80\xE1\x85\xA1\xE1\x86\xA8 \xC3\x89\xC3\xA9",
+        "a\x80" "b\xE2\x80x\xC3 \xFF" "c\xED\xA0\x80" "d\xF0\x9F\x98\xE4\xB8",
+        "\xE2\x80\xA9",
+        "xyz\xC2\x85",
+        ""
+    };
+    for (int32_t i = 0; i < UPRV_LENGTHOF(patterns); ++i) {
+        UErrorCode status = U_ZERO_ERROR;
+        UnicodeString pattern(patterns[i].pattern, -1, US_INV);
+        LocalPointer<RegexPattern> pat(RegexPattern::compile(pattern, patterns[i].flags, status));
+        if (U_FAILURE(status)) {
+            dataerrln("%s:%d: RegexPattern::compile(%s) failed - %s",
+                      __FILE__, __LINE__, patterns[i].pattern, u_errorName(status));
+            return;
+        }
+        for (int32_t j = 0; j < UPRV_LENGTHOF(inputs); ++j) {
+            // The UTF-16 equivalent of the input, and the byte offset for each UTF-16 index.
+            const uint8_t *s8 = (const uint8_t *)inputs[j];
+            int32_t length8 = (int32_t)strlen(inputs[j]);
+            UnicodeString s16;
+            int32_t map16to8[100];
+            int32_t i8 = 0;
+            while (i8 < length8) {
+                int32_t start8 = i8;
+                UChar32 c;
+                U8_NEXT_OR_FFFD(s8, i8, length8, c);
+                map16to8[s16.length()] = start8;
+                if (U_IS_SUPPLEMENTARY(c)) {
+                    map16to8[s16.length() + 1] = start8;
+                }
+                s16.append(c);
+            }
+            map16to8[s16.length()] = length8;
+
+            UText ut8 = UTEXT_INITIALIZER;
+            utext_openUTF8(&ut8, inputs[j], length8, &status);
+            LocalPointer<RegexMatcher> m16(pat->matcher(s16, status));
+            LocalPointer<RegexMatcher> m8(pat->matcher(status));
+            if (U_FAILURE(status)) {
+                errln("%s:%d: matcher creation failed - %s", __FILE__, __LINE__, u_errorName(status));
+                return;
+            }
+            m8->reset(&ut8);
+            // Look-behind minimum lengths are in UTF-16 units, so on UTF-8 input
+            //   more start positions are tried, and those may set hitEnd.
+            UBool checkHitEnd = uprv_strstr(patterns[i].pattern, "(?<") == NULL;
+
+            for (int32_t n = 0; n < 100; ++n) {
+                UBool found16 = m16->find(status);
+                UBool found8 = m8->find(status);
+                if (found16 != found8 || (checkHitEnd && m16->hitEnd() != m8->hitEnd())) {
+                    errln("%s:%d: pattern %d \"%s\" input %d, match %d: find() %d vs. UTF-8 %d, hitEnd() %d vs. UTF-8 %d",
+                          __FILE__, __LINE__, i, patterns[i].pattern, j, n,
+                          found16, found8, m16->hitEnd(), m8->hitEnd());
+                    break;
+                }
+                if (!found16) {
+                    break;
+                }
+                for (int32_t group = 0; group <= m16->groupCount(); ++group) {
+                    int64_t start16 = m16->start64(group, status);
+                    int64_t end16 = m16->end64(group, status);
+                    int64_t expectedStart = start16 < 0 ? -1 : map16to8[start16];
+                    int64_t expectedEnd = end16 < 0 ? -1 : map16to8[end16];
+                    if (expectedStart != m8->start64(group, status) || expectedEnd != m8->end64(group, status)) {
+                        errln("%s:%d: pattern %d \"%s\" input %d, match %d group %d: expected [%d, %d) got [%d, %d)",
+                              __FILE__, __LINE__, i, patterns[i].pattern, j, n, group,
+                              (int32_t)expectedStart, (int32_t)expectedEnd,
+                              (int32_t)m8->start64(group, status), (int32_t)m8->end64(group, status));
+                    }
+                }
+            }
+            if (m16->lookingAt(status) != m8->lookingAt(status) ||
+                    m16->matches(status) != m8->matches(status)) {
+                errln("%s:%d: pattern %d \"%s\" input %d: lookingAt() or matches() differ for UTF-8 input",
+                      __FILE__, __LINE__, i, patterns[i].pattern, j);
+            }
+            REGEX_CHECK_STATUS;
+            utext_close(&ut8);
+        }
+    }
+}
+
+
+//--------------------------------------------------------------
+//
+//  TestLazyDFA   find() locates the matches of patterns that need no
+//                backtracking with a DFA.  Check that it finds the same
+//                matches as the match engine alone, which a find progress
+//                callback forces.
+//
+//---------------------------------------------------------------
+void RegexTest::TestLazyDFA() {
+    static const struct {
+        const char *pattern;
+        uint32_t    flags;
+    } patterns[] = {
+        { "abc", 0 },
+        { "a.c", 0 },
+        { "a|ab|abc", 0 },
+        { "abc|ab|a", 0 },
+        { "(a|b)*c", 0 },
+        { "(a|ab)(c|bcd)(d*)", 0 },
+        { "(?:a*)*b", 0 },
+        { "(a*|b)*", 0 },
+        { "a*", 0 },
+        { "x*y*", 0 },
+        { "[a-c]+d?", 0 },
+        { "[^a-z ]+", 0 },
+        { ".*x", 0 },
+        { ".*", UREGEX_UNIX_LINES },
+        { "a.+?c", 0 },
+        { "\\d+\\h*\\v?", 0 },
+        { "\\D\\H\\V", 0 },
+        { "\\w+\\s\\W", 0 },
+        { "\\p{L}+|\\p{N}+", 0 },
+        { "stra\\u00dfe", UREGEX_CASE_INSENSITIVE },
+        { "ss|\\u00df", UREGEX_CASE_INSENSITIVE },
+        { "[a-z]+ing", UREGEX_CASE_INSENSITIVE },
+        { "\\u00e9x|\\u00c9", UREGEX_CASE_INSENSITIVE },
+        { "\\U0001f600+|\\u4e00\\u4e01", 0 },
+        { "[\\U0001f600-\\U0001f64f]\\u4e00?", 0 },
+        { "(?:ab)+?b", 0 },
+        { "a??b", 0 },
+        { "[abc]*?c", 0 },
+        { "(\\w+)@(\\w+)\\.com", 0 },
+        { "ab+c|ad", 0 },
+        { "xy+z", 0 }
+    };
+    static const char *inputs[] = {
+        "abc abcd aabbcc xxyy cbacba",
+        "ab abd abcd bcd aaaaab bb",
+        "one\\r\\ntwo\\u0085three 12 \\u0662\\u0663 \\t 45\\n x\\u2028",
+        "Strasse STRA\\u00dfE stra\\u00dfe SS \\u00df running SING \\u00c9x \\u00e9X",
+        "\\U0001f600\\U0001f600 \\u4e00\\u4e01 \\U0001f601\\u4e00 \\U0001f64f",
+        "mail joe@example.com and ann@test.com.",
+        "axxxc ac abc abcabc",
+        "xyz xx xyyyz xy xxyz ab abbbc ad abd",
+        ""
+    };
+    progressCallBackContext cbInfo;
+    cbInfo.reset(0x7fffffff);
+    for (int32_t i = 0; i < UPRV_LENGTHOF(patterns); ++i) {
+        UErrorCode status = U_ZERO_ERROR;
+        UnicodeString pattern(patterns[i].pattern, -1, US_INV);
+        LocalPointer<RegexPattern> pat(RegexPattern::compile(pattern, patterns[i].flags, status));
+        if (U_FAILURE(status)) {
+            dataerrln("%s:%d: RegexPattern::compile(%s) failed - %s",
+                      __FILE__, __LINE__, patterns[i].pattern, u_errorName(status));
+            return;
+        }
+        for (int32_t j = 0; j < UPRV_LENGTHOF(inputs); ++j) {
+            UnicodeString input = UnicodeString(inputs[j], -1, US_INV).unescape();
+            LocalPointer<RegexMatcher> m(pat->matcher(input, status));
+            LocalPointer<RegexMatcher> ref(pat->matcher(input, status));
+            ref->setFindProgressCallback(testProgressCallBackFn, &cbInfo, status);
+            if (U_FAILURE(status)) {
+                errln("%s:%d: matcher creation failed - %s", __FILE__, __LINE__, u_errorName(status));
+                return;
+            }
+            for (int32_t n = 0; n < 100; ++n) {
+                UBool found = m->find(status);
+                UBool expected = ref->find(status);
+                if (found != expected || m->hitEnd() != ref->hitEnd()) {
+                    errln("%s:%d: pattern %d \"%s\" input %d, match %d: find() %d, expected %d, hitEnd() %d, expected %d",
+                          __FILE__, __LINE__, i, patterns[i].pattern, j, n,
+                          found, expected, m->hitEnd(), ref->hitEnd());
+                    break;
+                }
+                if (!found) {
+                    break;
+                }
+                for (int32_t group = 0; group <= m->groupCount(); ++group) {
+                    if (m->start(group, status) != ref->start(group, status) ||
+                            m->end(group, status) != ref->end(group, status)) {
+                        errln("%s:%d: pattern %d \"%s\" input %d, match %d group %d: expected [%d, %d) got [%d, %d)",
+                              __FILE__, __LINE__, i, patterns[i].pattern, j, n, group,
+                              ref->start(group, status), ref->end(group, status),
+                              m->start(group, status), m->end(group, status));
+                    }
+                }
+            }
+            REGEX_CHECK_STATUS;
+        }
+    }
+
+    // Searching with the DFA takes time linear in the input length, for a pattern
+    //   that would make the match engine exceed its time limit at each position.
+    {
+        UErrorCode status = U_ZERO_ERROR;
+        UnicodeString input;
+        for (int32_t i = 0; i < 40; ++i) {
+            input.append((UChar)0x61);
+        }
+        RegexMatcher m(UNICODE_STRING_SIMPLE("(a|aa)*c"), input, 0, status);
+        m.setTimeLimit(100, status);
+        REGEX_ASSERT(m.find(status) == FALSE);
+        REGEX_CHECK_STATUS;
+    }
+}
+
+
+//--------------------------------------------------------------
+//
+//  TestRequiredString   find() skips input that is not followed, within
+//                       reach, by a literal string that every match contains.
+//                       Check that it finds the same matches as without the
+//                       skipping, which a find progress callback turns off,
+//                       for UTF-16 and UTF-8 input.
+//
+//---------------------------------------------------------------
+void RegexTest::TestRequiredString() {
+    static const char *patterns[] = {
+        "\\d+ERROR\\d+",
+        "[a-z]{3} \\d\\d:\\d\\d ERROR",
+        "\\d{4}-\\d{2}-\\d{2} WARN\\b",
+        "ab?cde",
+        "(?:abc|abd)x",
+        "x(abc)+y",
+        "x(abc)*yz",
+        "(\\w+)@(\\w+)\\.com",
+        "a{0,3}bc",
+        "(?:ab){2}cd",
+        ".hello",
+        "\\S\\U0001f600x",
+        "\\u00e9t\\u00e9\\w*",
+        "(\\w+)-\\1 ok",
+        "\\w*ok$",
+        "\\s+x",
+        "x\\X\\X\\Xyz",
+        "\\u00e9\\w*ERROR\\d"
+    };
+    static const char *inputs[] = {
+        "2016-10-17 WARN disk 12ERROR34 5ERROR jan 12:30 ERROR",
+        "abcde acde abdx abcx xabcabcy xyz xabcyz xabcabcyz",
+        "mail joe@example.com and ann@test.com.",
+        "aaabc abc bc ababcd abcd hhello \\u00e9hello \\U0001f600hello",
+        "\\U0001f600\\U0001f600x a\\U0001f600x \\u00e9t\\u00e9s \\u00c9t\\u00e9",
+        "foo-foo ok bar-baz ok ok\\nok\\r\\n x x\\u0301\\u0302yyz",
+        "no required string here",
+        "ERROR12",
+        "\\u00e9t\\u00e9 ERROR1 \\u00e9xERROR2 \\u00e9ERROR \\u00e9ERROR3",
+        ""
+    };
+    progressCallBackContext cbInfo;
+    cbInfo.reset(0x7fffffff);
+    for (int32_t i = 0; i < UPRV_LENGTHOF(patterns); ++i) {
+        UErrorCode status = U_ZERO_ERROR;
+        UnicodeString pattern(patterns[i], -1, US_INV);
+        LocalPointer<RegexPattern> pat(RegexPattern::compile(pattern, 0, status));
+        if (U_FAILURE(status)) {
+            dataerrln("%s:%d: RegexPattern::compile(%s) failed - %s",
+                      __FILE__, __LINE__, patterns[i], u_errorName(status));
+            return;
+        }
+        for (int32_t j = 0; j < UPRV_LENGTHOF(inputs); ++j) {
+            UnicodeString input = UnicodeString(inputs[j], -1, US_INV).unescape();
+            char input8[200];
+            int32_t length8 = 0;
+            u_strToUTF8(input8, UPRV_LENGTHOF(input8), &length8, input.getBuffer(), input.length(), &status);
+            UText ut8 = UTEXT_INITIALIZER;
+            utext_openUTF8(&ut8, input8, length8, &status);
+
+            LocalPointer<RegexMatcher> m16(pat->matcher(input, status));
+            LocalPointer<RegexMatcher> ref16(pat->matcher(input, status));
+            LocalPointer<RegexMatcher> m8(pat->matcher(status));
+            LocalPointer<RegexMatcher> ref8(pat->matcher(status));
+            if (U_FAILURE(status)) {
+                errln("%s:%d: matcher creation failed - %s", __FILE__, __LINE__, u_errorName(status));
+                return;
+            }
+            m8->reset(&ut8);
+            ref8->reset(&ut8);
+            ref16->setFindProgressCallback(testProgressCallBackFn, &cbInfo, status);
+            ref8->setFindProgressCallback(testProgressCallBackFn, &cbInfo, status);
+
+            RegexMatcher *matchers[] = { m16.getAlias(), m8.getAlias() };
+            RegexMatcher *refs[] = { ref16.getAlias(), ref8.getAlias() };
+            for (int32_t k = 0; k < UPRV_LENGTHOF(matchers); ++k) {
+                RegexMatcher *m = matchers[k];
+                RegexMatcher *ref = refs[k];
+                for (int32_t n = 0; n < 100; ++n) {
+                    UBool found = m->find(status);
+                    UBool expected = ref->find(status);
+                    if (found != expected || m->hitEnd() != ref->hitEnd()) {
+                        errln("%s:%d: pattern %d \"%s\" input %d%s, match %d: find() %d, expected %d, hitEnd() %d, expected %d",
+                              __FILE__, __LINE__, i, patterns[i], j, k == 0 ? "" : " UTF-8", n,
+                              found, expected, m->hitEnd(), ref->hitEnd());
+                        break;
+                    }
+                    if (!found) {
+                        break;
+                    }
+                    for (int32_t group = 0; group <= m->groupCount(); ++group) {
+                        if (m->start64(group, status) != ref->start64(group, status) ||
+                                m->end64(group, status) != ref->end64(group, status)) {
+                            errln("%s:%d: pattern %d \"%s\" input %d%s, match %d group %d: expected [%d, %d) got [%d, %d)",
+                                  __FILE__, __LINE__, i, patterns[i], j, k == 0 ? "" : " UTF-8", n, group,
+                                  (int32_t)ref->start64(group, status), (int32_t)ref->end64(group, status),
+                                  (int32_t)m->start64(group, status), (int32_t)m->end64(group, status));
+                        }
+                    }
+                }
+            }
+            REGEX_CHECK_STATUS;
+            utext_close(&ut8);
+        }
+    }
+}
+
+
+//---------------------------------------------------------------------------
+//
+//  TestRegexSet   RegexSet::find() reports the same patterns, and the same
+//                 first matches, as running each pattern's own matcher.
+//
+//---------------------------------------------------------------------------
+void RegexTest::TestRegexSet() {
+    static const char *patterns[] = {
+        "\\d+ERROR\\d+",                  // Patterns with an NFA ...
+        "[a-z]{3} \\d\\d:\\d\\d ERROR",
+        "(?i)warn(ing)?",
+        "(\\w+)@(\\w+)\\.com",
+        "x*",
+        "\\u00e9t\\u00e9|\\U0001f600",
+        "[\\p{Greek}]+",
+        "^ERROR",                           // ... and without.
+        "(\\w+)-\\1",
+        "disk(?= full)",
+        "\\bok\\b",
+        "\\u03b1{2,}",
+        "z{2}q"
+    };
+    static const char *inputs[] = {
+        "2016-10-17 WARN disk 12ERROR34 jan 12:30 ERROR",
+        "ERROR: disk full, mail joe@example.com, foo-foo ok",
+        "Warning: \\u00e9t\\u00e9 \\u03b1\\u03b1\\u03b2",
+        "\\U0001f600 zzq",
+        "nothing to see",
+        ""
+    };
+    UnicodeString patternStrings[UPRV_LENGTHOF(patterns)];
+    for (int32_t i = 0; i < UPRV_LENGTHOF(patterns); ++i) {
+        patternStrings[i] = UnicodeString(patterns[i], -1, US_INV);
+    }
+    UErrorCode status = U_ZERO_ERROR;
+    UParseError pe;
+    RegexSet set(patternStrings, UPRV_LENGTHOF(patterns), 0, pe, status);
+    if (U_FAILURE(status)) {
+        dataerrln("%s:%d: RegexSet construction failed - %s", __FILE__, __LINE__, u_errorName(status));
+        return;
+    }
+    REGEX_ASSERT(set.size() == UPRV_LENGTHOF(patterns));
+    REGEX_ASSERT(set.getPattern(1)->pattern() == patternStrings[1]);
+    REGEX_ASSERT(set.getPattern(UPRV_LENGTHOF(patterns)) == NULL);
+
+    for (int32_t j = 0; j < UPRV_LENGTHOF(inputs); ++j) {
+        UnicodeString input = UnicodeString(inputs[j], -1, US_INV).unescape();
+        int32_t indexes[UPRV_LENGTHOF(patterns)];
+        int32_t starts[UPRV_LENGTHOF(patterns)];
+        int32_t ends[UPRV_LENGTHOF(patterns)];
+        int32_t count = set.find(input, indexes, starts, ends, UPRV_LENGTHOF(indexes), status);
+        REGEX_CHECK_STATUS;
+
+        int32_t expectedCount = 0;
+        for (int32_t i = 0; i < UPRV_LENGTHOF(patterns); ++i) {
+            LocalPointer<RegexMatcher> m(set.getPattern(i)->matcher(input, status));
+            REGEX_CHECK_STATUS;
+            if (!m->find(status)) {
+                continue;
+            }
+            if (expectedCount >= count || indexes[expectedCount] != i) {
+                errln("%s:%d: input %d: pattern %d \"%s\" not reported", __FILE__, __LINE__, j, i, patterns[i]);
+                return;
+            }
+            if (starts[expectedCount] != m->start(status) || ends[expectedCount] != m->end(status)) {
+                errln("%s:%d: input %d: pattern %d \"%s\": expected [%d, %d) got [%d, %d)",
+                      __FILE__, __LINE__, j, i, patterns[i], m->start(status), m->end(status),
+                      starts[expectedCount], ends[expectedCount]);
+            }
+            ++expectedCount;
+        }
+        if (count != expectedCount) {
+            errln("%s:%d: input %d: %d patterns reported, expected %d", __FILE__, __LINE__, j, count, expectedCount);
+        }
+
+        // Preflighting, and a capacity too small for all of the matches.
+        int32_t preflightCount = set.find(input, NULL, NULL, NULL, 0, status);
+        REGEX_ASSERT(preflightCount == count);
+        REGEX_ASSERT(status == (count > 0 ? U_BUFFER_OVERFLOW_ERROR : U_ZERO_ERROR));
+        status = U_ZERO_ERROR;
+        if (count > 1) {
+            int32_t firstIndex = -1;
+            REGEX_ASSERT(set.find(input, &firstIndex, NULL, NULL, 1, status) == count);
+            REGEX_ASSERT(status == U_BUFFER_OVERFLOW_ERROR && firstIndex == indexes[0]);
+            status = U_ZERO_ERROR;
+        }
+    }
+
+    // Many literal patterns, all handled by the one scan.
+    UnicodeString words[300];
+    UnicodeString text;
+    for (int32_t i = 0; i < UPRV_LENGTHOF(words); ++i) {
+        words[i] = UnicodeString("w", -1, US_INV);
+        words[i].append((UChar)(0x61 + i % 26)).append((UChar)(0x61 + i / 26)).append((UChar)0x21);
+        if (i % 7 == 0) {
+            text.append(words[i]).append((UChar)0x20);
+        }
+    }
+    RegexSet bigSet(words, UPRV_LENGTHOF(words), 0, pe, status);
+    REGEX_CHECK_STATUS;
+    int32_t bigIndexes[UPRV_LENGTHOF(words)];
+    int32_t bigStarts[UPRV_LENGTHOF(words)];
+    int32_t bigCount = bigSet.find(text, bigIndexes, bigStarts, NULL, UPRV_LENGTHOF(bigIndexes), status);
+    REGEX_CHECK_STATUS;
+    REGEX_ASSERT(bigCount == (UPRV_LENGTHOF(words) + 6) / 7);
+    for (int32_t k = 0; k < bigCount; ++k) {
+        REGEX_ASSERT(bigIndexes[k] == 7 * k);
+        REGEX_ASSERT(bigStarts[k] == 5 * k);
+    }
+
+    // A syntax error in one pattern fails the set.
+    UnicodeString badPatterns[] = { UnicodeString("abc", -1, US_INV), UnicodeString("a(b", -1, US_INV) };
+    RegexSet badSet(badPatterns, UPRV_LENGTHOF(badPatterns), 0, pe, status);
+    REGEX_ASSERT(status == U_REGEX_MISMATCHED_PAREN);
+    status = U_ZERO_ERROR;
+    REGEX_ASSERT(badSet.find(text, bigIndexes, NULL, NULL, UPRV_LENGTHOF(bigIndexes), status) == 0);
+    REGEX_ASSERT(status == U_REGEX_MISMATCHED_PAREN);
+}
+
+
 #endif  /* !UCONFIG_NO_REGULAR_EXPRESSIONS  */
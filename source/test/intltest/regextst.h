@@ -56,6 +56,10 @@ public:
     virtual void TestBug11049();
     virtual void TestBug11371();
     virtual void TestBug11480();
+    virtual void TestUTF8ChunkMatch();
+    virtual void TestLazyDFA();
+    virtual void TestRequiredString();
+    virtual void TestRegexSet();
     
     // The following functions are internal to the regexp tests.
     virtual void assertUText(const char *expected, UText *actual, const char *file, int line);
@@ -12,10 +12,12 @@
 
 #include "unicode/uchar.h"
 #include "unicode/errorcode.h"
+#include "unicode/normalizer2.h"
 #include "unicode/normlzr.h"
 #include "unicode/uniset.h"
 #include "unicode/usetiter.h"
 #include "unicode/schriter.h"
+#include "unicode/std_string.h"
 #include "unicode/utf16.h"
 #include "cmemory.h"
 #include "cstring.h"
@@ -60,6 +62,8 @@ void BasicNormalizerTest::runIndexedTest(int32_t index, UBool exec,
         CASE(18,TestCustomFCC);
 #endif
         CASE(19,TestFilteredNormalizer2Coverage);
+        CASE(20,TestSpanLow);
+        CASE(21,TestNormalizeUTF8);
         default: name = ""; break;
     }
 }
@@ -1525,4 +1529,227 @@ BasicNormalizerTest::TestFilteredNormalizer2Coverage() {
     }
 }
 
+// Normalizer2Impl::spanLow() and spanLowUTF8() skip runs several units at a time;
+// check that they stop exactly at the first unit that is not skippable,
+// wherever it is relative to the vector blocks.
+void
+BasicNormalizerTest::TestSpanLow() {
+    static const UChar highUnits[]={ 0x300, 0x301, 0x4e00, 0xd800, 0xffff };
+    UChar s[40];
+    int32_t i, start, pos;
+    for(i=0; i<UPRV_LENGTHOF(highUnits); ++i) {
+        for(start=0; start<4; ++start) {
+            for(pos=start; pos<=UPRV_LENGTHOF(s); ++pos) {
+                int32_t j;
+                for(j=0; j<UPRV_LENGTHOF(s); ++j) {
+                    s[j]=(UChar)(j%3==0 ? 0x2ff : 0x61);
+                }
+                if(pos<UPRV_LENGTHOF(s)) {
+                    s[pos]=highUnits[i];
+                }
+                const UChar *limit=s+UPRV_LENGTHOF(s);
+                const UChar *p=Normalizer2Impl::spanLow(s+start, limit, 0x300);
+                if(p!=s+pos) {
+                    errln("spanLow(U+%04lx at %d, start %d, 0x300) stopped at %d",
+                          (long)highUnits[i], (int)pos, (int)start, (int)(p-s));
+                }
+                p=Normalizer2Impl::spanLow(s+start, limit, 0x62);
+                int32_t expected=start;
+                while(expected<UPRV_LENGTHOF(s) && s[expected]<0x62) { ++expected; }
+                if(p!=s+expected) {
+                    errln("spanLow(start %d, 0x62) stopped at %d not %d",
+                          (int)start, (int)(p-s), (int)expected);
+                }
+            }
+        }
+    }
+
+    // Each stop sequence is inserted into a run of ASCII letters and U+00E9 (C3 A9).
+    static const char *const stopSequences[]={
+        "\xcc\x81",  // U+0301
+        "\xe4\xb8\x80",  // U+4E00
+        "\xc0\x80",  // non-shortest form
+        "\x80",  // lone trail byte
+        "\xc3\x41"  // truncated sequence
+    };
+    uint8_t b[48];
+    for(i=0; i<UPRV_LENGTHOF(stopSequences); ++i) {
+        int32_t stopLength=(int32_t)uprv_strlen(stopSequences[i]);
+        for(start=0; start<4; ++start) {
+            for(pos=start; pos<=UPRV_LENGTHOF(b)-stopLength; ++pos) {
+                int32_t j;
+                for(j=0; j<UPRV_LENGTHOF(b); ++j) {
+                    b[j]=0x61;
+                }
+                // Put a two-byte U+00E9 right before the stop sequence if it fits.
+                if((pos-start)>=2) {
+                    b[pos-2]=0xc3;
+                    b[pos-1]=0xa9;
+                }
+                uprv_memcpy(b+pos, stopSequences[i], stopLength);
+                const uint8_t *p=Normalizer2Impl::spanLowUTF8(b+start, b+UPRV_LENGTHOF(b), 0x300);
+                if(p!=b+pos) {
+                    errln("spanLowUTF8(stop sequence %d at %d, start %d, 0x300) stopped at %d",
+                          (int)i, (int)pos, (int)start, (int)(p-b));
+                }
+                // With a low minimum, U+00E9 is not skippable.
+                p=Normalizer2Impl::spanLowUTF8(b+start, b+UPRV_LENGTHOF(b), 0xc0);
+                int32_t expected= (pos-start)>=2 ? pos-2 : pos;
+                if(p!=b+expected) {
+                    errln("spanLowUTF8(stop sequence %d at %d, start %d, 0xc0) stopped at %d",
+                          (int)i, (int)pos, (int)start, (int)(p-b));
+                }
+            }
+        }
+    }
+    // A two-byte sequence cut off by the limit is not skipped.
+    b[0]=0x61;
+    b[1]=0xc3;
+    b[2]=0xa9;
+    if(Normalizer2Impl::spanLowUTF8(b, b+2, 0x300)!=b+1) {
+        errln("spanLowUTF8() skipped a sequence that is truncated by the limit");
+    }
+}
+
+// The UTF-8 functions must give the same results as
+// converting to UTF-16, normalizing, and converting back;
+// ill-formed sequences must be passed through unchanged.
+void
+BasicNormalizerTest::TestNormalizeUTF8() {
+#if U_HAVE_STD_STRING
+    IcuTestErrorCode errorCode(*this, "TestNormalizeUTF8");
+    static const char *const names[]={ "NFC", "NFD", "NFKC", "NFKD", "FCD", "FCC" };
+    const Normalizer2 *norm2s[UPRV_LENGTHOF(names)];
+    norm2s[0]=Normalizer2::getNFCInstance(errorCode);
+    norm2s[1]=Normalizer2::getNFDInstance(errorCode);
+    norm2s[2]=Normalizer2::getNFKCInstance(errorCode);
+    norm2s[3]=Normalizer2::getNFKDInstance(errorCode);
+    norm2s[4]=Normalizer2::getInstance(NULL, "nfc", UNORM2_FCD, errorCode);
+    norm2s[5]=Normalizer2::getInstance(NULL, "nfc", UNORM2_COMPOSE_CONTIGUOUS, errorCode);
+    if(errorCode.logDataIfFailureAndReset("Normalizer2 getters")) {
+        return;
+    }
+
+    // Random strings from characters with interesting normalization behavior.
+    static const char *const pieces[]={
+        "a", "e", "\\u00e9", "\\u0301", "\\u0327", "\\u0316", "\\u0344", "\\u0323",
+        "\\u1100", "\\u1161", "\\u11a8", "\\uac00", "\\uac01", "\\u1e0a", "\\u00c5", "\\u212b",
+        "\\u0f71", "\\u0f72", "\\u0f73", "\\u0dd9", "\\u0dcf", "\\u304b", "\\u3099", "\\u00a0",
+        "\\ufb01", "\\ufb2c", "\\U0001d15e", "\\U0001d165", "\\u4e00", "\\u2126",
+        "abcdefghijklmnopqrstuvwxyz abcdefghijklmnopqrstuvwxyz"
+    };
+    UnicodeString units[UPRV_LENGTHOF(pieces)];
+    int32_t i;
+    for(i=0; i<UPRV_LENGTHOF(pieces); ++i) {
+        units[i]=UnicodeString(pieces[i], -1, US_INV).unescape();
+    }
+    uint32_t seed=1;
+    for(int32_t n=0; n<1000; ++n) {
+        // Well-formed parts of the string, separated by ill-formed 0xFF bytes.
+        UnicodeString parts[4];
+        int32_t numParts=1, j;
+        seed=seed*1103515245+12345;
+        int32_t length=(int32_t)((seed>>16)%48);
+        while(length-->0) {
+            seed=seed*1103515245+12345;
+            int32_t k=(int32_t)((seed>>16)%(UPRV_LENGTHOF(pieces)+1));
+            if(k<UPRV_LENGTHOF(pieces)) {
+                parts[numParts-1].append(units[k]);
+            } else if(numParts<UPRV_LENGTHOF(parts)) {
+                ++numParts;
+            }
+        }
+        std::string s8;
+        for(j=0; j<numParts; ++j) {
+            if(j>0) {
+                s8.push_back((char)0xff);
+            }
+            parts[j].toUTF8String(s8);
+        }
+        for(i=0; i<UPRV_LENGTHOF(names); ++i) {
+            const Normalizer2 &norm2=*norm2s[i];
+            std::string expected, actual;
+            UBool expectedIsNormalized=TRUE, expectedQuickCheckYes=TRUE;
+            for(j=0; j<numParts; ++j) {
+                if(j>0) {
+                    expected.push_back((char)0xff);
+                }
+                norm2.normalize(parts[j], errorCode).toUTF8String(expected);
+                expectedIsNormalized&=norm2.isNormalized(parts[j], errorCode);
+                expectedQuickCheckYes&=norm2.quickCheck(parts[j], errorCode)==UNORM_YES;
+            }
+            StringByteSink<std::string> sink(&actual);
+            norm2.normalizeUTF8(s8, sink, errorCode);
+            if(actual!=expected) {
+                errln("%s.normalizeUTF8(random string %d) differs from normalize()",
+                      names[i], (int)n);
+            }
+            if(norm2.isNormalizedUTF8(s8, errorCode)!=expectedIsNormalized) {
+                errln("%s.isNormalizedUTF8(random string %d) differs from isNormalized()",
+                      names[i], (int)n);
+            }
+            // fromUTF8() turns each 0xFF into an inert U+FFFD.
+            int32_t span=norm2.spanQuickCheckYesUTF8(s8, errorCode);
+            if(span<0 || span>(int32_t)s8.length() ||
+                    (span<(int32_t)s8.length() && U8_IS_TRAIL(s8[span])) ||
+                    !norm2.isNormalized(UnicodeString::fromUTF8(StringPiece(s8.data(), span)),
+                                        errorCode) ||
+                    (expectedQuickCheckYes && span!=(int32_t)s8.length())) {
+                errln("%s.spanQuickCheckYesUTF8(random string %d)=%d is not a normalized prefix",
+                      names[i], (int)n, (int)span);
+            }
+            if(errorCode.logIfFailureAndReset("%s UTF-8 functions", names[i])) {
+                return;
+            }
+        }
+    }
+
+    static const struct {
+        int32_t form;
+        const char *src, *expected;
+    } illFormed[]={
+        { 0, "e\xcc\x81\xff\xcc\x81", "\xc3\xa9\xff\xcc\x81" },
+        { 0, "a\xe4\xb8", "a\xe4\xb8" },
+        { 1, "\xc3\xa9\xc0\x80", "e\xcc\x81\xc0\x80" },
+        { 1, "\xcc\xa7\xcc\x81\xed\xa0\x80\xcc\x81\xcc\xa7", "\xcc\xa7\xcc\x81\xed\xa0\x80\xcc\xa7\xcc\x81" },
+        { 4, "\x80" "a\xcc\x81\xcc\xa7", "\x80" "a\xcc\xa7\xcc\x81" }
+    };
+    for(i=0; i<UPRV_LENGTHOF(illFormed); ++i) {
+        const Normalizer2 &norm2=*norm2s[illFormed[i].form];
+        std::string actual;
+        StringByteSink<std::string> sink(&actual);
+        norm2.normalizeUTF8(illFormed[i].src, sink, errorCode);
+        if(actual!=illFormed[i].expected) {
+            errln("%s.normalizeUTF8(ill-formed case %d) did not pass through the ill-formed bytes",
+                  names[illFormed[i].form], (int)i);
+        }
+        UBool srcIsNormalized=uprv_strcmp(illFormed[i].src, illFormed[i].expected)==0;
+        if(!norm2.isNormalizedUTF8(illFormed[i].expected, errorCode) ||
+                norm2.isNormalizedUTF8(illFormed[i].src, errorCode)!=srcIsNormalized) {
+            errln("%s.isNormalizedUTF8(ill-formed case %d) is wrong",
+                  names[illFormed[i].form], (int)i);
+        }
+    }
+    errorCode.logIfFailureAndReset("UTF-8 functions with ill-formed input");
+
+    // Long text that needs changes throughout is normalized in large chunks;
+    // ill-formed sequences in it must still be passed through.
+    std::string longSrc, longExpected, longActual;
+    for(i=0; i<200; ++i) {
+        longSrc.append("e\xcc\x81" "a");
+        longExpected.append("\xc3\xa9" "a");
+        if((i%50)==49) {
+            longSrc.append("\xff");
+            longExpected.append("\xff");
+        }
+    }
+    StringByteSink<std::string> longSink(&longActual);
+    norm2s[0]->normalizeUTF8(longSrc, longSink, errorCode);
+    if(longActual!=longExpected) {
+        errln("NFC.normalizeUTF8(long text with ill-formed bytes) is wrong");
+    }
+    errorCode.logIfFailureAndReset("NFC.normalizeUTF8(long text)");
+#endif
+}
+
 #endif /* #if !UCONFIG_NO_NORMALIZATION */
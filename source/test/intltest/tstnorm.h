@@ -47,6 +47,8 @@ public:
     void TestCustomComp();
     void TestCustomFCC();
     void TestFilteredNormalizer2Coverage();
+    void TestSpanLow();
+    void TestNormalizeUTF8();
 
 private:
     UnicodeString canonTests[24][3];
@@ -26,6 +26,7 @@
 #include "unicode/uversion.h"
 #include "cmemory.h"
 #include "hash.h"
+#include "uprops.h"
 
 #define TEST_ASSERT_SUCCESS(status) {if (U_FAILURE(status)) { \
     dataerrln("fail in file \"%s\", line %d: \"%s\"", __FILE__, __LINE__, \
@@ -94,6 +95,8 @@ UnicodeSetTest::runIndexedTest(int32_t index, UBool exec,
         CASE(22,TestSpan);
         CASE(23,TestStringSpan);
         CASE(24,TestUCAUnsafeBackwards);
+        CASE(25,TestSpanASCIIRuns);
+        CASE(26,TestPatternCache);
         default: name = ""; break;
     }
 }
@@ -3870,6 +3873,140 @@ void UnicodeSetTest::TestStringSpan() {
     }
 }
 
+// Frozen sets span ASCII text 16 characters at a time where the CPU supports it.
+// Check spans that stop at every position in and around such blocks
+// against the unfrozen set.
+void UnicodeSetTest::TestSpanASCIIRuns() {
+    static const char *const pattern="[_0-9a-z\\u00e4]";
+    static const UChar32 fillers[]={ 0x61, 0x20, 0xe4 };
+    static const UChar32 stops[]={ 0x20, 0x62, 0x7f, 0xe4, 0xe9, 0x4e00, 0x1f600 };
+
+    UErrorCode errorCode=U_ZERO_ERROR;
+    UnicodeSet set(UnicodeString(pattern, -1, US_INV).unescape(), errorCode);
+    if(U_FAILURE(errorCode)) {
+        errln("FAIL: Unable to create UnicodeSet(%s) - %s", pattern, u_errorName(errorCode));
+        return;
+    }
+    UnicodeSet frozen(set);
+    frozen.freeze();
+
+    static const USetSpanCondition conditions[]={ USET_SPAN_NOT_CONTAINED, USET_SPAN_CONTAINED };
+    UnicodeString s16;
+    char s8[200];
+    for(int32_t i=0; i<UPRV_LENGTHOF(fillers); ++i) {
+        for(int32_t j=0; j<UPRV_LENGTHOF(stops); ++j) {
+            for(int32_t length=1; length<=40; ++length) {
+                // stopIndex==length: no stop character
+                for(int32_t stopIndex=0; stopIndex<=length; ++stopIndex) {
+                    s16.remove();
+                    for(int32_t k=0; k<length; ++k) {
+                        s16.append(k==stopIndex ? stops[j] : fillers[i]);
+                    }
+                    int32_t length8=0;
+                    u_strToUTF8(s8, UPRV_LENGTHOF(s8), &length8, s16.getBuffer(), s16.length(), &errorCode);
+                    const UChar *p16=s16.getBuffer();
+                    for(int32_t k=0; k<UPRV_LENGTHOF(conditions); ++k) {
+                        USetSpanCondition c=conditions[k];
+                        if( frozen.span(p16, s16.length(), c)!=set.span(p16, s16.length(), c) ||
+                            frozen.spanBack(p16, s16.length(), c)!=set.spanBack(p16, s16.length(), c) ||
+                            frozen.spanUTF8(s8, length8, c)!=set.spanUTF8(s8, length8, c) ||
+                            frozen.spanBackUTF8(s8, length8, c)!=set.spanBackUTF8(s8, length8, c)
+                        ) {
+                            errln("FAIL: frozen UnicodeSet(%s) span(%d) differs for %d*U+%04lX with U+%04lX at %d",
+                                  pattern, c, (int)length, (long)fillers[i], (long)stops[j], (int)stopIndex);
+                            return;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Sets parsed from the same pattern share the parse result through the
+// UnifiedCache. Check that the result does not depend on whether the cache was hit.
+void UnicodeSetTest::TestPatternCache() {
+    // A pattern that no other test uses, so that the first parse misses.
+    UnicodeString pattern("[[:L:][:Mn:]-[:Han:] [\\u0024 q-z] ]", -1, US_INV);
+    int32_t hits0, misses0, hits1, misses1, hits2, misses2;
+    UErrorCode errorCode=U_ZERO_ERROR;
+    uniset_getPatternCacheCounts(&hits0, &misses0);
+    UnicodeSet first(pattern, errorCode);
+    uniset_getPatternCacheCounts(&hits1, &misses1);
+    UnicodeSet second(pattern, errorCode);
+    uniset_getPatternCacheCounts(&hits2, &misses2);
+    if(U_FAILURE(errorCode)) {
+        dataerrln("FAIL: UnicodeSet(pattern) failed - %s", u_errorName(errorCode));
+        return;
+    }
+    if(misses1==misses0 || hits2==hits1 || misses2!=misses1) {
+        errln("FAIL: pattern cache counts hits %d->%d->%d, misses %d->%d->%d",
+              (int)hits0, (int)hits1, (int)hits2, (int)misses0, (int)misses1, (int)misses2);
+    }
+    checkEqual(first, second, "pattern cache miss vs. hit");
+    UnicodeString pat1, pat2;
+    if(first.toPattern(pat1)!=second.toPattern(pat2)) {
+        errln("FAIL: pattern cache hit returns a different pattern");
+    }
+    // A set from the cache is a mutable copy.
+    if(second.isFrozen() || !second.add(0x4e00).contains(0x4e00)) {
+        errln("FAIL: set from the pattern cache is not modifiable");
+    }
+    UnicodeSet third;
+    third.applyPattern(pattern, USET_IGNORE_SPACE, NULL, errorCode);
+    if(U_FAILURE(errorCode) || third.contains(0x4e00) || third!=first) {
+        errln("FAIL: applyPattern(pattern) after modifying a cached copy - %s", u_errorName(errorCode));
+    }
+
+    // A set embedded in other text is shared under its own text.
+    UnicodeString embeddedText("xx[\\u0f10-\\u0f17 q]yy", -1, US_INV);
+    ParsePosition embeddedPos(2);
+    UnicodeSet fromText(embeddedText, embeddedPos, USET_IGNORE_SPACE, NULL, errorCode);
+    uniset_getPatternCacheCounts(&hits1, &misses1);
+    UnicodeSet fromSet(embeddedText.tempSubString(2, embeddedPos.getIndex()-2), errorCode);
+    uniset_getPatternCacheCounts(&hits2, &misses2);
+    if(U_FAILURE(errorCode) || hits2==hits1 || misses2!=misses1 || fromSet!=fromText) {
+        errln("FAIL: set parsed from the middle of a pattern is not shared - %s",
+              u_errorName(errorCode));
+    }
+
+    // Options are part of the cache key.
+    UnicodeString lower("[a-c]", -1, US_INV);
+    for(int32_t i=0; i<2; ++i) {
+        errorCode=U_ZERO_ERROR;
+        UnicodeSet caseless, plain;
+        caseless.applyPattern(lower, USET_IGNORE_SPACE|USET_CASE_INSENSITIVE, NULL, errorCode);
+        plain.applyPattern(lower, USET_IGNORE_SPACE, NULL, errorCode);
+        if(U_FAILURE(errorCode) || !caseless.contains(0x41) || plain.contains(0x41)) {
+            errln("FAIL: pattern cache mixes up sets with different options - %s", u_errorName(errorCode));
+        }
+    }
+
+    // A pattern embedded in other text, and errors.
+    UnicodeString text("xx[a-c]yy", -1, US_INV);
+    UnicodeString trailing("[a-c] x", -1, US_INV);
+    UnicodeString malformed("[a-", -1, US_INV);
+    for(int32_t i=0; i<2; ++i) {
+        errorCode=U_ZERO_ERROR;
+        ParsePosition pos(2);
+        UnicodeSet embedded(text, pos, USET_IGNORE_SPACE, NULL, errorCode);
+        if(U_FAILURE(errorCode) || pos.getIndex()!=7 || embedded.size()!=3) {
+            errln("FAIL: UnicodeSet(xx[a-c]yy, pos=2) -> pos=%d - %s",
+                  (int)pos.getIndex(), u_errorName(errorCode));
+        }
+        errorCode=U_ZERO_ERROR;
+        UnicodeSet withTrailing(trailing, errorCode);
+        if(errorCode!=U_ILLEGAL_ARGUMENT_ERROR) {
+            errln("FAIL: UnicodeSet([a-c] x) - %s", u_errorName(errorCode));
+        }
+        errorCode=U_ZERO_ERROR;
+        UnicodeSet bad(malformed, errorCode);
+        if(errorCode!=U_MALFORMED_SET) {
+            errln("FAIL: UnicodeSet([a-) - %s", u_errorName(errorCode));
+        }
+    }
+}
+
 /**
  * Including collationroot.h fails here with
 1>c:\Program Files (x86)\Microsoft SDKs\Windows\v7.0A\include\driverspecs.h(142): error C2008: '$' : unexpected in macro definition
@@ -90,6 +90,10 @@ private:
 
     void TestStringSpan();
 
+    void TestSpanASCIIRuns();
+
+    void TestPatternCache();
+
     void TestUCAUnsafeBackwards();
 
 private:
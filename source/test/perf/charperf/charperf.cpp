@@ -117,6 +117,8 @@ UPerfFunction* CharPerformanceTest::runIndexedTest(int32_t index, UBool exec,
         TESTCASE(19, TestStdLibToLower);
         TESTCASE(20, TestStdLibToUpper);
         TESTCASE(21, TestStdLibIsWhiteSpace);
+        TESTCASE(22, TestCharName);
+        TESTCASE(23, TestCharFromName);
         default: 
             name = ""; 
             return NULL;
@@ -184,6 +186,16 @@ UPerfFunction* CharPerformanceTest::TestIsWhiteSpace()
     return new CharPerfFunction(isWhiteSpace, MIN_, MAX_);
 }
 
+UPerfFunction* CharPerformanceTest::TestCharName()
+{
+    return new CharPerfFunction(charName, MIN_, MAX_);
+}
+
+UPerfFunction* CharPerformanceTest::TestCharFromName()
+{
+    return new CharFromNamePerfFunction(MIN_, MAX_);
+}
+
 UPerfFunction* CharPerformanceTest::TestStdLibIsAlpha()
 {
     return new StdLibCharPerfFunction(StdLibIsAlpha, (wchar_t)MIN_, 
@@ -13,6 +13,7 @@
 #include "unicode/uperf.h"
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <wchar.h>
 #include <wctype.h>
 
@@ -80,6 +81,60 @@ private:
     wchar_t MAX_;
 };
 
+/**
+ * Looks up the names of all named code points in [min, max[ with
+ * u_charFromName(), which goes through the name index after the first call.
+ */
+class CharFromNamePerfFunction : public UPerfFunction
+{
+public:
+    virtual void call(UErrorCode* status)
+    {
+        for (const char *name = names_; name < names_ + length_; name += strlen(name) + 1) {
+            u_charFromName(U_UNICODE_CHAR_NAME, name, status);
+        }
+    }
+
+    virtual long getOperationsPerIteration()
+    {
+        return count_;
+    }
+
+    CharFromNamePerfFunction(UChar32 min, UChar32 max)
+    {
+        // first pass: measure, second pass: store NUL-terminated names
+        names_ = NULL;
+        length_ = 0;
+        count_ = 0;
+        for (int pass = 0; pass < 2; ++pass) {
+            for (UChar32 c = min; c < max; ++c) {
+                UErrorCode errorCode = U_ZERO_ERROR;
+                char *dest = names_ != NULL ? names_ + length_ : NULL;
+                int32_t capacity = names_ != NULL ? 128 : 0;
+                int32_t length = u_charName(c, U_UNICODE_CHAR_NAME, dest, capacity, &errorCode);
+                if (length > 0) {
+                    length_ += length + 1;
+                    count_ += pass;
+                }
+            }
+            if (pass == 0) {
+                names_ = (char *)malloc(length_ + 128);
+                length_ = 0;
+            }
+        }
+    }
+
+    ~CharFromNamePerfFunction()
+    {
+        free(names_);
+    }
+
+private:
+    char *names_;
+    int32_t length_;
+    long count_;
+};
+
 class CharPerformanceTest : public UPerfTest
 {
 public:
@@ -99,6 +154,8 @@ public:
     UPerfFunction* TestToLower();
     UPerfFunction* TestToUpper();
     UPerfFunction* TestIsWhiteSpace();
+    UPerfFunction* TestCharName();
+    UPerfFunction* TestCharFromName();
     UPerfFunction* TestStdLibIsAlpha();
     UPerfFunction* TestStdLibIsUpper();
     UPerfFunction* TestStdLibIsLower();
@@ -176,6 +233,13 @@ inline void isWhiteSpace(UChar32 ch)
     u_isWhitespace(ch);
 }
 
+inline void charName(UChar32 ch)
+{
+    char buffer[128];
+    UErrorCode errorCode = U_ZERO_ERROR;
+    u_charName(ch, U_UNICODE_CHAR_NAME, buffer, sizeof(buffer), &errorCode);
+}
+
 inline void StdLibIsAlpha(wchar_t ch)
 {
     iswalpha(ch);
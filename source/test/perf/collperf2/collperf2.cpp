@@ -324,6 +324,68 @@ long GetSortKey::getOperationsPerIteration()
     return source->count;
 }
 
+//
+// Test case taking a single test data array, calling ucol_getSortKeys once for all of the strings
+// with the given number of threads
+//
+class GetSortKeys : public UPerfFunction
+{
+public:
+    GetSortKeys(const UCollator* coll, const CA_uchar* source, int32_t threadCount);
+    ~GetSortKeys();
+    virtual void call(UErrorCode* status);
+    virtual long getOperationsPerIteration();
+
+private:
+    const UCollator *coll;
+    const CA_uchar *source;
+    int32_t threadCount;
+    const UChar **strings;
+    int32_t *lengths;
+    int32_t *offsets;
+    uint8_t *keys;
+    int32_t keysCapacity;
+};
+
+GetSortKeys::GetSortKeys(const UCollator* coll, const CA_uchar* source, int32_t threadCount)
+    :   coll(coll),
+        source(source),
+        threadCount(threadCount),
+        keysCapacity(0)
+{
+    strings = new const UChar *[source->count];
+    lengths = new int32_t[source->count];
+    offsets = new int32_t[source->count + 1];
+    // The arena is sized exactly, as for an index build that preflighted the keys.
+    for (int32_t i = 0; i < source->count; i++) {
+        strings[i] = source->dataOf(i);
+        lengths[i] = source->lengthOf(i);
+        keysCapacity += ucol_getSortKey(coll, strings[i], lengths[i], NULL, 0);
+    }
+    keys = new uint8_t[keysCapacity];
+}
+
+GetSortKeys::~GetSortKeys()
+{
+    delete[] keys;
+    delete[] offsets;
+    delete[] lengths;
+    delete[] strings;
+}
+
+void GetSortKeys::call(UErrorCode* status)
+{
+    if (U_FAILURE(*status)) return;
+
+    ucol_getSortKeys(coll, strings, lengths, source->count,
+                     keys, keysCapacity, offsets, threadCount, status);
+}
+
+long GetSortKeys::getOperationsPerIteration()
+{
+    return source->count;
+}
+
 //
 // Test case taking a single test data array in UTF-16, calling ucol_nextSortKeyPart for each for the
 // given buffer size
@@ -946,6 +1008,85 @@ void StringPieceSortC::call(UErrorCode* status) {
     ops = cc.counter;
 }
 
+//
+// Test case sorting an array of UTF-16 strings with ucol_sortStrings().
+// Unlike the comparison-based sort test cases, operations are strings, not comparisons.
+//
+class SortStrings : public CollPerfFunction {
+public:
+    SortStrings(const Collator& coll, const UCollator *ucoll, const CA_uchar* data16,
+                int32_t threadCount)
+            : CollPerfFunction(coll, ucoll), d16(data16), threadCount(threadCount),
+              source(new const UChar *[d16->count]), lengths(new int32_t[d16->count]),
+              order(new int32_t[d16->count]) {
+        for (int32_t i = 0; i < d16->count; ++i) {
+            source[i] = d16->dataOf(i);
+            lengths[i] = d16->lengthOf(i);
+        }
+    }
+    virtual ~SortStrings();
+    virtual void call(UErrorCode* status);
+
+private:
+    const CA_uchar* d16;
+    int32_t threadCount;
+    const UChar **source;
+    int32_t *lengths;
+    int32_t *order;
+};
+
+SortStrings::~SortStrings() {
+    delete[] order;
+    delete[] lengths;
+    delete[] source;
+}
+
+void SortStrings::call(UErrorCode* status) {
+    if (U_FAILURE(*status)) return;
+
+    ucol_sortStrings(ucoll, source, lengths, d16->count, order, threadCount, status);
+    ops = d16->count;
+}
+
+//
+// Test case sorting an array of UTF-8 strings with ucol_sortStringsUTF8().
+//
+class SortStringsUTF8 : public CollPerfFunction {
+public:
+    SortStringsUTF8(const Collator& coll, const UCollator *ucoll, const CA_char* data8,
+                    int32_t threadCount)
+            : CollPerfFunction(coll, ucoll), d8(data8), threadCount(threadCount),
+              source(new const char *[d8->count]), lengths(new int32_t[d8->count]),
+              order(new int32_t[d8->count]) {
+        for (int32_t i = 0; i < d8->count; ++i) {
+            source[i] = d8->dataOf(i);
+            lengths[i] = d8->lengthOf(i);
+        }
+    }
+    virtual ~SortStringsUTF8();
+    virtual void call(UErrorCode* status);
+
+private:
+    const CA_char* d8;
+    int32_t threadCount;
+    const char **source;
+    int32_t *lengths;
+    int32_t *order;
+};
+
+SortStringsUTF8::~SortStringsUTF8() {
+    delete[] order;
+    delete[] lengths;
+    delete[] source;
+}
+
+void SortStringsUTF8::call(UErrorCode* status) {
+    if (U_FAILURE(*status)) return;
+
+    ucol_sortStringsUTF8(ucoll, source, lengths, d8->count, order, threadCount, status);
+    ops = d8->count;
+}
+
 //
 // Test case performing binary searches in a sorted array of UnicodeString pointers.
 //
@@ -1089,6 +1230,8 @@ private:
 
     UPerfFunction* TestGetSortKey();
     UPerfFunction* TestGetSortKeyNull();
+    UPerfFunction* TestGetSortKeys();
+    UPerfFunction* TestGetSortKeys4Threads();
 
     UPerfFunction* TestNextSortKeyPart_4All();
     UPerfFunction* TestNextSortKeyPart_4x2();
@@ -1118,6 +1261,9 @@ private:
     UPerfFunction* TestUniStrSort();
     UPerfFunction* TestStringPieceSortCpp();
     UPerfFunction* TestStringPieceSortC();
+    UPerfFunction* TestSortStrings();
+    UPerfFunction* TestSortStrings4Threads();
+    UPerfFunction* TestSortStringsUTF8();
 
     UPerfFunction* TestUniStrBinSearch();
     UPerfFunction* TestStringPieceBinSearchCpp();
@@ -1398,6 +1544,8 @@ CollPerf2Test::runIndexedTest(int32_t index, UBool exec, const char *&name, char
 
     TESTCASE_AUTO(TestGetSortKey);
     TESTCASE_AUTO(TestGetSortKeyNull);
+    TESTCASE_AUTO(TestGetSortKeys);
+    TESTCASE_AUTO(TestGetSortKeys4Threads);
 
     TESTCASE_AUTO(TestNextSortKeyPart_4All);
     TESTCASE_AUTO(TestNextSortKeyPart_4x4);
@@ -1425,6 +1573,9 @@ CollPerf2Test::runIndexedTest(int32_t index, UBool exec, const char *&name, char
     TESTCASE_AUTO(TestUniStrSort);
     TESTCASE_AUTO(TestStringPieceSortCpp);
     TESTCASE_AUTO(TestStringPieceSortC);
+    TESTCASE_AUTO(TestSortStrings);
+    TESTCASE_AUTO(TestSortStrings4Threads);
+    TESTCASE_AUTO(TestSortStringsUTF8);
 
     TESTCASE_AUTO(TestUniStrBinSearch);
     TESTCASE_AUTO(TestStringPieceBinSearchCpp);
@@ -1524,6 +1675,26 @@ UPerfFunction* CollPerf2Test::TestGetSortKeyNull()
     return testCase;
 }
 
+UPerfFunction* CollPerf2Test::TestGetSortKeys()
+{
+    UErrorCode status = U_ZERO_ERROR;
+    const CA_uchar *data = getData16(status);
+    if (U_FAILURE(status)) {
+        return NULL;
+    }
+    return new GetSortKeys(coll, data, 1 /* threadCount */);
+}
+
+UPerfFunction* CollPerf2Test::TestGetSortKeys4Threads()
+{
+    UErrorCode status = U_ZERO_ERROR;
+    const CA_uchar *data = getData16(status);
+    if (U_FAILURE(status)) {
+        return NULL;
+    }
+    return new GetSortKeys(coll, data, 4 /* threadCount */);
+}
+
 UPerfFunction* CollPerf2Test::TestNextSortKeyPart_4All()
 {
     UErrorCode status = U_ZERO_ERROR;
@@ -1752,6 +1923,33 @@ UPerfFunction* CollPerf2Test::TestStringPieceSortC() {
     return testCase;
 }
 
+UPerfFunction* CollPerf2Test::TestSortStrings() {
+    UErrorCode status = U_ZERO_ERROR;
+    const CA_uchar *data = getRandomData16(status);
+    if (U_FAILURE(status)) {
+        return NULL;
+    }
+    return new SortStrings(*collObj, coll, data, 1 /* threadCount */);
+}
+
+UPerfFunction* CollPerf2Test::TestSortStrings4Threads() {
+    UErrorCode status = U_ZERO_ERROR;
+    const CA_uchar *data = getRandomData16(status);
+    if (U_FAILURE(status)) {
+        return NULL;
+    }
+    return new SortStrings(*collObj, coll, data, 4 /* threadCount */);
+}
+
+UPerfFunction* CollPerf2Test::TestSortStringsUTF8() {
+    UErrorCode status = U_ZERO_ERROR;
+    const CA_char *data = getRandomData8(status);
+    if (U_FAILURE(status)) {
+        return NULL;
+    }
+    return new SortStringsUTF8(*collObj, coll, data, 1 /* threadCount */);
+}
+
 UPerfFunction* CollPerf2Test::TestUniStrBinSearch() {
     UErrorCode status = U_ZERO_ERROR;
     UPerfFunction *testCase = new UniStrBinSearch(*collObj, coll, getSortedData16(status));
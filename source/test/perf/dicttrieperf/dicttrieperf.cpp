@@ -20,16 +20,21 @@
  *  ./dicttrieperf --sourcedir <ICU build tree>/data/out/tmp --passes 3 --iterations 1000
  * or
  *  ./dicttrieperf -f <ICU source tree>/source/data/brkitr/thaidict.txt --passes 3 --iterations 250
+ * or, for CJK word segmentation
+ *  ./dicttrieperf -f <ICU source tree>/source/data/brkitr/dictionaries/cjdict.txt --passes 3 --iterations 5
  */
 
 #include <stdio.h>
 #include <stdlib.h>
+#include "unicode/brkiter.h"
 #include "unicode/bytestrie.h"
 #include "unicode/bytestriebuilder.h"
 #include "unicode/localpointer.h"
+#include "unicode/locid.h"
 #include "unicode/ucharstrie.h"
 #include "unicode/ucharstriebuilder.h"
 #include "unicode/uperf.h"
+#include "unicode/ustring.h"
 #include "unicode/utext.h"
 #include "charstr.h"
 #include "package.h"
@@ -638,6 +643,62 @@ public:
     }
 };
 
+// Segments a text made of the dictionary file's words with a Japanese word
+// BreakIterator, so that runs of Han and Kana characters go through the
+// CJK dictionary break engine.
+// Only meaningful with cjdict.txt, but works with any dictionary text file.
+class CjkWordBreak : public UPerfFunction {
+public:
+    CjkWordBreak(const DictionaryTriePerfTest &perfTest) {
+        IcuToolErrorCode errorCode("CjkWordBreak()");
+        const ULine *lines=perfTest.getCachedLines();
+        int32_t numLines=perfTest.getNumLines();
+        int32_t numWords=0;
+        for(int32_t i=0; i<numLines; ++i) {
+            // Skip comment lines (start with a character below 'A').
+            if(lines[i].name[0]<0x41) {
+                continue;
+            }
+            // Lines are of the form word<tab>value.
+            int32_t length=lines[i].len;
+            const UChar *tab=u_memchr(lines[i].name, 9, length);
+            if(tab!=NULL) {
+                length=(int32_t)(tab-lines[i].name);
+            }
+            text.append(lines[i].name, length);
+            // End a "sentence" every few words, so that the dictionary ranges
+            // have typical lengths.
+            if(++numWords%8==0) {
+                text.append((UChar)0x3002);  // Ideographic full stop
+            }
+        }
+        iter.adoptInstead(BreakIterator::createWordInstance(Locale::getJapanese(), errorCode));
+    }
+
+    virtual void call(UErrorCode * /*pErrorCode*/) {
+        if(iter.isNull()) {
+            return;
+        }
+        // Reset the text so that no boundaries are reused from the previous pass.
+        iter->setText(text);
+        int32_t count=0;
+        for(int32_t i=iter->first(); i!=BreakIterator::DONE; i=iter->next()) {
+            ++count;
+        }
+        if(count<=1) {
+            fprintf(stderr, "no word boundaries found\n");
+        }
+    }
+
+    virtual long getOperationsPerIteration() {
+        return text.length();
+    }
+
+protected:
+    UnicodeString text;
+    LocalPointer<BreakIterator> iter;
+};
+
 UPerfFunction *DictionaryTriePerfTest::runIndexedTest(int32_t index, UBool exec,
                                                       const char *&name, char * /*par*/) {
     if(hasFile()) {
@@ -666,6 +727,12 @@ UPerfFunction *DictionaryTriePerfTest::runIndexedTest(int32_t index, UBool exec,
                 return new BytesTrieDictContains(*this);
             }
             break;
+        case 4:
+            name="cjkwordbreak";
+            if(exec) {
+                return new CjkWordBreak(*this);
+            }
+            break;
         default:
             name="";
             break;
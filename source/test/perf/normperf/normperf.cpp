@@ -62,6 +62,28 @@ UPerfFunction* NormalizerPerformanceTest::runIndexedTest(int32_t index, UBool ex
         TESTCASE(31,TestIsNormalized_FCD_NFC_Text);
         TESTCASE(32,TestIsNormalized_FCD_Orig_Text);
 
+        TESTCASE(33,TestUTF8_NFC_NFD_Text);
+        TESTCASE(34,TestUTF8_NFC_NFC_Text);
+        TESTCASE(35,TestUTF8_NFC_Orig_Text);
+        TESTCASE(36,TestUTF8_NFD_NFD_Text);
+        TESTCASE(37,TestUTF8_NFD_NFC_Text);
+        TESTCASE(38,TestUTF8_FCD_NFC_Text);
+
+        TESTCASE(39,TestUTF8RoundTrip_NFC_NFD_Text);
+        TESTCASE(40,TestUTF8RoundTrip_NFC_NFC_Text);
+        TESTCASE(41,TestUTF8RoundTrip_NFC_Orig_Text);
+        TESTCASE(42,TestUTF8RoundTrip_NFD_NFD_Text);
+        TESTCASE(43,TestUTF8RoundTrip_NFD_NFC_Text);
+        TESTCASE(44,TestUTF8RoundTrip_FCD_NFC_Text);
+
+        TESTCASE(45,TestIsNormalizedUTF8_NFC_NFC_Text);
+        TESTCASE(46,TestIsNormalizedUTF8_NFD_NFD_Text);
+        TESTCASE(47,TestIsNormalizedUTF8_FCD_NFC_Text);
+
+        TESTCASE(48,TestIsNormalizedUTF8RoundTrip_NFC_NFC_Text);
+        TESTCASE(49,TestIsNormalizedUTF8RoundTrip_NFD_NFD_Text);
+        TESTCASE(50,TestIsNormalizedUTF8RoundTrip_FCD_NFC_Text);
+
         default: 
             name = ""; 
             return NULL;
@@ -490,6 +512,99 @@ UPerfFunction* NormalizerPerformanceTest::TestIsNormalized_FCD_Orig_Text(){
     }
 }
 
+// UTF-8 tests; the -o options do not apply to Normalizer2.
+UPerfFunction* NormalizerPerformanceTest::newUTF8Test(UTF8Fn fn, const Normalizer2* norm2, UNormalizationMode textMode){
+    if(norm2==NULL){
+        return NULL;
+    }
+    if(line_mode){
+        ULine* srcLines= textMode==UNORM_NFD ? NFDFileLines : textMode==UNORM_NFC ? NFCFileLines : lines;
+        return new UTF8PerfFunction(fn, norm2, srcLines, numLines);
+    }else{
+        if(textMode==UNORM_NFD){
+            return new UTF8PerfFunction(fn, norm2, NFDBuffer, NFDBufferLen);
+        }else if(textMode==UNORM_NFC){
+            return new UTF8PerfFunction(fn, norm2, NFCBuffer, NFCBufferLen);
+        }else{
+            return new UTF8PerfFunction(fn, norm2, buffer, bufferLen);
+        }
+    }
+}
+
+static const Normalizer2* getNFC(){
+    UErrorCode status = U_ZERO_ERROR;
+    const Normalizer2* norm2 = Normalizer2::getNFCInstance(status);
+    return U_SUCCESS(status) ? norm2 : NULL;
+}
+static const Normalizer2* getNFD(){
+    UErrorCode status = U_ZERO_ERROR;
+    const Normalizer2* norm2 = Normalizer2::getNFDInstance(status);
+    return U_SUCCESS(status) ? norm2 : NULL;
+}
+static const Normalizer2* getFCD(){
+    UErrorCode status = U_ZERO_ERROR;
+    const Normalizer2* norm2 = Normalizer2::getInstance(NULL, "nfc", UNORM2_FCD, status);
+    return U_SUCCESS(status) ? norm2 : NULL;
+}
+
+UPerfFunction* NormalizerPerformanceTest::TestUTF8_NFC_NFD_Text(){
+    return newUTF8Test(ICUNormUTF8, getNFC(), UNORM_NFD);
+}
+UPerfFunction* NormalizerPerformanceTest::TestUTF8_NFC_NFC_Text(){
+    return newUTF8Test(ICUNormUTF8, getNFC(), UNORM_NFC);
+}
+UPerfFunction* NormalizerPerformanceTest::TestUTF8_NFC_Orig_Text(){
+    return newUTF8Test(ICUNormUTF8, getNFC(), UNORM_NONE);
+}
+UPerfFunction* NormalizerPerformanceTest::TestUTF8_NFD_NFD_Text(){
+    return newUTF8Test(ICUNormUTF8, getNFD(), UNORM_NFD);
+}
+UPerfFunction* NormalizerPerformanceTest::TestUTF8_NFD_NFC_Text(){
+    return newUTF8Test(ICUNormUTF8, getNFD(), UNORM_NFC);
+}
+UPerfFunction* NormalizerPerformanceTest::TestUTF8_FCD_NFC_Text(){
+    return newUTF8Test(ICUNormUTF8, getFCD(), UNORM_NFC);
+}
+
+UPerfFunction* NormalizerPerformanceTest::TestUTF8RoundTrip_NFC_NFD_Text(){
+    return newUTF8Test(ICUNormUTF8RoundTrip, getNFC(), UNORM_NFD);
+}
+UPerfFunction* NormalizerPerformanceTest::TestUTF8RoundTrip_NFC_NFC_Text(){
+    return newUTF8Test(ICUNormUTF8RoundTrip, getNFC(), UNORM_NFC);
+}
+UPerfFunction* NormalizerPerformanceTest::TestUTF8RoundTrip_NFC_Orig_Text(){
+    return newUTF8Test(ICUNormUTF8RoundTrip, getNFC(), UNORM_NONE);
+}
+UPerfFunction* NormalizerPerformanceTest::TestUTF8RoundTrip_NFD_NFD_Text(){
+    return newUTF8Test(ICUNormUTF8RoundTrip, getNFD(), UNORM_NFD);
+}
+UPerfFunction* NormalizerPerformanceTest::TestUTF8RoundTrip_NFD_NFC_Text(){
+    return newUTF8Test(ICUNormUTF8RoundTrip, getNFD(), UNORM_NFC);
+}
+UPerfFunction* NormalizerPerformanceTest::TestUTF8RoundTrip_FCD_NFC_Text(){
+    return newUTF8Test(ICUNormUTF8RoundTrip, getFCD(), UNORM_NFC);
+}
+
+UPerfFunction* NormalizerPerformanceTest::TestIsNormalizedUTF8_NFC_NFC_Text(){
+    return newUTF8Test(ICUIsNormalizedUTF8, getNFC(), UNORM_NFC);
+}
+UPerfFunction* NormalizerPerformanceTest::TestIsNormalizedUTF8_NFD_NFD_Text(){
+    return newUTF8Test(ICUIsNormalizedUTF8, getNFD(), UNORM_NFD);
+}
+UPerfFunction* NormalizerPerformanceTest::TestIsNormalizedUTF8_FCD_NFC_Text(){
+    return newUTF8Test(ICUIsNormalizedUTF8, getFCD(), UNORM_NFC);
+}
+
+UPerfFunction* NormalizerPerformanceTest::TestIsNormalizedUTF8RoundTrip_NFC_NFC_Text(){
+    return newUTF8Test(ICUIsNormalizedUTF8RoundTrip, getNFC(), UNORM_NFC);
+}
+UPerfFunction* NormalizerPerformanceTest::TestIsNormalizedUTF8RoundTrip_NFD_NFD_Text(){
+    return newUTF8Test(ICUIsNormalizedUTF8RoundTrip, getNFD(), UNORM_NFD);
+}
+UPerfFunction* NormalizerPerformanceTest::TestIsNormalizedUTF8RoundTrip_FCD_NFC_Text(){
+    return newUTF8Test(ICUIsNormalizedUTF8RoundTrip, getFCD(), UNORM_NFC);
+}
+
 int main(int argc, const char* argv[]){
     UErrorCode status = U_ZERO_ERROR;
     NormalizerPerformanceTest test(argc, argv, status);
@@ -8,11 +8,14 @@
 #ifndef _NORMPERF_H
 #define _NORMPERF_H
 
+#include "unicode/normalizer2.h"
+#include "unicode/std_string.h"
 #include "unicode/unorm.h"
 #include "unicode/ustring.h"
 
 #include "unicode/uperf.h"
 #include <stdlib.h>
+#include <string>
 
 //  Stubs for Windows API functions when building on UNIXes.
 //
@@ -27,6 +30,7 @@ inline int FoldStringW(DWORD dwMapFlags, const UChar* lpSrcStr,int cchSrc, UChar
 #define DEST_BUFFER_CAPACITY 6000
 typedef int32_t (*NormFn)(const UChar* src,int32_t srcLen, UChar* dest,int32_t dstLen, int32_t options, UErrorCode* status);
 typedef int32_t (*QuickCheckFn)(const UChar* src,int32_t srcLen, UNormalizationMode mode, int32_t options, UErrorCode* status);
+typedef int32_t (*UTF8Fn)(const icu::Normalizer2 &norm2, const std::string &src, std::string &dest, UErrorCode* status);
 
 class QuickCheckPerfFunction : public UPerfFunction{
 private:
@@ -174,6 +178,53 @@ public:
 
 
 
+// Runs a Normalizer2 function on UTF-8 copies of the input.
+// The input is converted when the function object is created, outside the timed loop;
+// the operation count is in UTF-16 code units, as for the other tests.
+class UTF8PerfFunction : public UPerfFunction{
+private:
+    std::string* lines;
+    int32_t numLines;
+    int32_t numUnits;
+    UTF8Fn fn;
+    const icu::Normalizer2* norm2;
+    std::string dest;
+    int32_t retVal;
+
+public:
+    virtual void call(UErrorCode* status){
+        for(int32_t i = 0; i< numLines; i++){
+            retVal =  (*fn)(*norm2, lines[i], dest, status);
+        }
+    }
+    virtual long getOperationsPerIteration(){
+        return numUnits;
+    }
+    UTF8PerfFunction(UTF8Fn func, const icu::Normalizer2* n2, ULine* srcLines, int32_t srcNumLines) {
+        fn = func;
+        norm2 = n2;
+        numLines = srcNumLines;
+        numUnits = 0;
+        lines = new std::string[numLines];
+        for(int32_t i = 0; i< numLines; i++){
+            icu::UnicodeString(FALSE, srcLines[i].name, srcLines[i].len).toUTF8String(lines[i]);
+            numUnits += srcLines[i].len;
+        }
+    }
+    UTF8PerfFunction(UTF8Fn func, const icu::Normalizer2* n2, const UChar* source, int32_t sourceLen) {
+        fn = func;
+        norm2 = n2;
+        numLines = 1;
+        numUnits = sourceLen;
+        lines = new std::string[1];
+        icu::UnicodeString(FALSE, source, sourceLen).toUTF8String(lines[0]);
+    }
+    ~UTF8PerfFunction(){
+        delete[] lines;
+    }
+};
+
+
 class  NormalizerPerformanceTest : public UPerfTest{
 private:
     ULine* NFDFileLines;
@@ -188,6 +239,8 @@ private:
 
     void normalizeInput(ULine* dest,const UChar* src ,int32_t srcLen,UNormalizationMode mode, int32_t options);
     UChar* normalizeInput(int32_t& len, const UChar* src ,int32_t srcLen,UNormalizationMode mode, int32_t options);
+    // textMode selects the input: UNORM_NFD or UNORM_NFC text, or UNORM_NONE for the original.
+    UPerfFunction* newUTF8Test(UTF8Fn fn, const icu::Normalizer2* norm2, UNormalizationMode textMode);
 
 public:
 
@@ -245,6 +298,29 @@ public:
     UPerfFunction* TestIsNormalized_FCD_NFC_Text();
     UPerfFunction* TestIsNormalized_FCD_Orig_Text();
 
+    /* UTF-8 performance: native UTF-8 API vs. conversion to and from UTF-16 */
+    UPerfFunction* TestUTF8_NFC_NFD_Text();
+    UPerfFunction* TestUTF8_NFC_NFC_Text();
+    UPerfFunction* TestUTF8_NFC_Orig_Text();
+    UPerfFunction* TestUTF8_NFD_NFD_Text();
+    UPerfFunction* TestUTF8_NFD_NFC_Text();
+    UPerfFunction* TestUTF8_FCD_NFC_Text();
+
+    UPerfFunction* TestUTF8RoundTrip_NFC_NFD_Text();
+    UPerfFunction* TestUTF8RoundTrip_NFC_NFC_Text();
+    UPerfFunction* TestUTF8RoundTrip_NFC_Orig_Text();
+    UPerfFunction* TestUTF8RoundTrip_NFD_NFD_Text();
+    UPerfFunction* TestUTF8RoundTrip_NFD_NFC_Text();
+    UPerfFunction* TestUTF8RoundTrip_FCD_NFC_Text();
+
+    UPerfFunction* TestIsNormalizedUTF8_NFC_NFC_Text();
+    UPerfFunction* TestIsNormalizedUTF8_NFD_NFD_Text();
+    UPerfFunction* TestIsNormalizedUTF8_FCD_NFC_Text();
+
+    UPerfFunction* TestIsNormalizedUTF8RoundTrip_NFC_NFC_Text();
+    UPerfFunction* TestIsNormalizedUTF8RoundTrip_NFD_NFD_Text();
+    UPerfFunction* TestIsNormalizedUTF8RoundTrip_FCD_NFC_Text();
+
 };
 
 //---------------------------------------------------------------------------------------
@@ -315,6 +391,27 @@ int32_t ICUIsNormalized(const UChar* src,int32_t srcLen, UNormalizationMode mode
 }
 #endif
 
+int32_t ICUNormUTF8(const icu::Normalizer2 &norm2, const std::string &src, std::string &dest, UErrorCode* status) {
+    dest.clear();
+    icu::StringByteSink<std::string> sink(&dest);
+    norm2.normalizeUTF8(src, sink, *status);
+    return (int32_t)dest.length();
+}
+
+int32_t ICUNormUTF8RoundTrip(const icu::Normalizer2 &norm2, const std::string &src, std::string &dest, UErrorCode* status) {
+    dest.clear();
+    norm2.normalize(icu::UnicodeString::fromUTF8(src), *status).toUTF8String(dest);
+    return (int32_t)dest.length();
+}
+
+int32_t ICUIsNormalizedUTF8(const icu::Normalizer2 &norm2, const std::string &src, std::string &, UErrorCode* status) {
+    return norm2.isNormalizedUTF8(src, *status);
+}
+
+int32_t ICUIsNormalizedUTF8RoundTrip(const icu::Normalizer2 &norm2, const std::string &src, std::string &, UErrorCode* status) {
+    return norm2.isNormalized(icu::UnicodeString::fromUTF8(src), *status);
+}
+
 #if U_PLATFORM_HAS_WIN32_API
 
 int32_t WinNormNFD(const UChar* src, int32_t srcLen, UChar* dest, int32_t dstLen, int32_t options, UErrorCode* status) {
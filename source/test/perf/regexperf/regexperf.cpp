@@ -0,0 +1,191 @@
+// Copyright (C) 2016 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+/*
+**********************************************************************
+*   file name:  regexperf.cpp
+*   encoding:   US-ASCII
+*   tab size:   8 (not used)
+*   indentation:4
+*
+*   Log scanning throughput of RegexMatcher::find().
+*   Each pattern is run twice over the same generated log text:
+*   once as usual, which uses the lazy DFA for patterns that need no
+*   backtracking, and once with a find progress callback, which makes
+*   find() try each start position with the backtracking match engine.
+*   The reported time per operation is per input code unit.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "unicode/uperf.h"
+#include "unicode/regex.h"
+#include "unicode/unistr.h"
+#include "uoptions.h"
+#include "cmemory.h" // for UPRV_LENGTHOF
+
+#if !UCONFIG_NO_REGULAR_EXPRESSIONS
+
+// Command-line options specific to regexperf.
+// Options do not have abbreviations: Force readable command lines.
+// (Using U+0001 for abbreviation characters.)
+enum {
+    LINE_COUNT,
+    REGEXPERF_OPTIONS_COUNT
+};
+
+static UOption options[REGEXPERF_OPTIONS_COUNT]={
+    UOPTION_DEF("lines", '\x01', UOPT_REQUIRES_ARG)
+};
+
+static const char *const regexperf_usage =
+    "\t--lines     Number of lines of generated log text.\n"
+    "\t            Default: 10000\n";
+
+// Fields for the generated log lines.
+static const char *const levels[]={ "INFO", "INFO", "INFO", "DEBUG", "WARN", "ERROR" };
+static const char *const users[]={ "alice", "bob", "carol", "dave", "erin" };
+static const char *const paths[]={ "/index.html", "/api/v2/items", "/login", "/static/app.js" };
+
+static const char *const patterns[]={
+    "[a-z]+@[a-z.]+",                   // mail addresses
+    "ERROR [A-Za-z]+: [0-9]+",          // error lines
+    "(?i)timeout|refused|unreachable"   // case-insensitive keywords
+};
+
+// Test object with setup data.
+class RegexPerformanceTest : public UPerfTest {
+public:
+    RegexPerformanceTest(int32_t argc, const char *argv[], UErrorCode &status)
+            : UPerfTest(argc, argv, options, UPRV_LENGTHOF(options), regexperf_usage, status) {
+        if (U_FAILURE(status)) {
+            return;
+        }
+        int32_t lineCount = atoi(options[LINE_COUNT].value);
+        if (lineCount <= 0) {
+            status = U_ILLEGAL_ARGUMENT_ERROR;
+            return;
+        }
+        char line[200];
+        for (int32_t i = 0; i < lineCount; ++i) {
+            const char *level = levels[i % UPRV_LENGTHOF(levels)];
+            const char *user = users[(i / 3) % UPRV_LENGTHOF(users)];
+            if (strcmp(level, "ERROR") == 0) {
+                sprintf(line, "2016-10-%02d 12:%02d:%02d ERROR Upstream: %d connection %s\n",
+                        1 + i % 28, (i / 60) % 60, i % 60, 500 + i % 4,
+                        (i & 1) != 0 ? "timeout" : "refused");
+            } else if ((i % 50) == 7) {
+                sprintf(line, "2016-10-%02d 12:%02d:%02d %s notify %s@example.com\n",
+                        1 + i % 28, (i / 60) % 60, i % 60, level, user);
+            } else {
+                sprintf(line, "2016-10-%02d 12:%02d:%02d %s GET %s user=%s status=200 time=%dms\n",
+                        1 + i % 28, (i / 60) % 60, i % 60, level,
+                        paths[i % UPRV_LENGTHOF(paths)], user, 3 + i % 97);
+            }
+            text.append(UnicodeString(line, -1, US_INV));
+        }
+    }
+
+    virtual UPerfFunction* runIndexedTest(int32_t index, UBool exec, const char* &name, char* par = NULL);
+
+    UnicodeString text;
+};
+
+// Finds all matches of a pattern in the log text.
+class FindAll : public UPerfFunction {
+public:
+    FindAll(const RegexPerformanceTest &testcase, const char *pattern, UBool backtrack)
+            : testcase(testcase), matcher(NULL), matchCount(0) {
+        UErrorCode status = U_ZERO_ERROR;
+        matcher = new RegexMatcher(UnicodeString(pattern, -1, US_INV), testcase.text, 0, status);
+        if (U_SUCCESS(status) && backtrack) {
+            // Any find progress callback disables the DFA.
+            matcher->setFindProgressCallback(&continueFind, NULL, status);
+        }
+        if (U_FAILURE(status)) {
+            fprintf(stderr, "RegexMatcher(%s) failed - %s\n", pattern, u_errorName(status));
+            delete matcher;
+            matcher = NULL;
+        }
+    }
+    virtual ~FindAll() {
+        delete matcher;
+    }
+
+    virtual long getOperationsPerIteration() {
+        return testcase.text.length();
+    }
+
+    virtual void call(UErrorCode *pErrorCode) {
+        if (U_FAILURE(*pErrorCode)) {
+            return;
+        }
+        if (matcher == NULL) {
+            *pErrorCode = U_INTERNAL_PROGRAM_ERROR;
+            return;
+        }
+        matcher->reset();
+        matchCount = 0;
+        while (matcher->find()) {
+            ++matchCount;
+        }
+    }
+
+private:
+    static UBool U_CALLCONV continueFind(const void * /*context*/, int64_t /*matchIndex*/) {
+        return TRUE;
+    }
+
+    const RegexPerformanceTest &testcase;
+    RegexMatcher *matcher;
+    int32_t matchCount;
+};
+
+UPerfFunction* RegexPerformanceTest::runIndexedTest(int32_t index, UBool exec, const char* &name, char* /*par*/) {
+    static const char *const names[]={
+        "FindMailDFA",      "FindMailBacktrack",
+        "FindErrorDFA",     "FindErrorBacktrack",
+        "FindKeywordsDFA",  "FindKeywordsBacktrack"
+    };
+    if (index < 0 || index >= UPRV_LENGTHOF(names)) {
+        name = "";
+        return NULL;
+    }
+    name = names[index];
+    if (exec) {
+        return new FindAll(*this, patterns[index / 2], (index & 1) != 0);
+    }
+    return NULL;
+}
+
+int main(int argc, const char *argv[])
+{
+    // Default values for command-line options.
+    options[LINE_COUNT].value = "10000";
+
+    UErrorCode status = U_ZERO_ERROR;
+    RegexPerformanceTest test(argc, argv, status);
+
+    if (U_FAILURE(status)){
+        printf("The error is %s\n", u_errorName(status));
+        test.usage();
+        return status;
+    }
+
+    if (test.run() == FALSE){
+        fprintf(stderr, "FAILED: Tests could not be run, please check the "
+                        "arguments.\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+#else
+
+int main(int /*argc*/, const char * /*argv*/[]) {
+    fprintf(stderr, "regexperf: regular expressions are disabled (UCONFIG_NO_REGULAR_EXPRESSIONS)\n");
+    return 1;
+}
+
+#endif  // !UCONFIG_NO_REGULAR_EXPRESSIONS
@@ -155,6 +155,31 @@ UPerfFunction* BreakIteratorPerformanceTest::TestICUIsBound()
   return new ICUIsBound(locale, m_mode_, m_file_, m_fileLen_);
 }
 
+UPerfFunction* BreakIteratorPerformanceTest::TestICUBackward()
+{
+  return new ICUBackward(locale, m_mode_, m_file_, m_fileLen_);
+}
+
+UPerfFunction* BreakIteratorPerformanceTest::TestICUPreceding()
+{
+  return new ICUPreceding(locale, m_mode_, m_file_, m_fileLen_);
+}
+
+UPerfFunction* BreakIteratorPerformanceTest::TestICUForwardStatus()
+{
+  return new ICUForwardStatus(locale, m_mode_, m_file_, m_fileLen_);
+}
+
+UPerfFunction* BreakIteratorPerformanceTest::TestICUGetBoundaries()
+{
+  return new ICUGetBoundaries(locale, m_mode_, m_file_, m_fileLen_);
+}
+
+UPerfFunction* BreakIteratorPerformanceTest::TestICUGetBoundariesParallel()
+{
+  return new ICUGetBoundariesParallel(locale, m_mode_, m_file_, m_fileLen_);
+}
+
 UPerfFunction* BreakIteratorPerformanceTest::TestDarwinForward()
 {
   return NULL;
@@ -174,6 +199,11 @@ UPerfFunction* BreakIteratorPerformanceTest::runIndexedTest(int32_t index, UBool
 		TESTCASE(1, TestICUIsBound);
 		TESTCASE(2, TestDarwinForward);
 		TESTCASE(3, TestDarwinIsBound);
+		TESTCASE(4, TestICUBackward);
+		TESTCASE(5, TestICUPreceding);
+		TESTCASE(6, TestICUForwardStatus);
+		TESTCASE(7, TestICUGetBoundaries);
+		TESTCASE(8, TestICUGetBoundariesParallel);
         default: 
             name = ""; 
             return NULL;
@@ -187,14 +217,12 @@ UOption options[]={
 
 
 BreakIteratorPerformanceTest::BreakIteratorPerformanceTest(int32_t argc, const char* argv[], UErrorCode& status)
-: UPerfTest(argc,argv,status),
+: UPerfTest(argc,argv,options,UPRV_LENGTHOF(options),"",status),
 m_mode_(NULL),
 m_file_(NULL),
 m_fileLen_(0)
 {
 
-    _remainingArgc = u_parseArgs(_remainingArgc, (char**)argv, UPRV_LENGTHOF(options), options);
-
 
     if(options[0].doesOccur) {
       m_mode_ = options[0].value;
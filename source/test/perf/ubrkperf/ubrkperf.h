@@ -11,12 +11,14 @@
 #include "unicode/uperf.h"
 
 #include <unicode/brkiter.h>
+#include <unicode/ubrk.h>
 
 class ICUBreakFunction : public UPerfFunction {
 protected:
   BreakIterator *m_brkIt_;
   const UChar *m_file_;
   int32_t m_fileLen_;
+  UnicodeString m_text_;  // The break iterator aliases it, so it must outlive setText().
   int32_t m_noBreaks_;
   UErrorCode m_status_;
 public:
@@ -24,6 +26,7 @@ public:
       m_brkIt_(NULL),
       m_file_(file),
       m_fileLen_(file_len),
+      m_text_(FALSE, file, file_len),
       m_noBreaks_(-1),
       m_status_(U_ZERO_ERROR)
   {
@@ -60,7 +63,7 @@ public:
       ICUBreakFunction(locale, mode, file, file_len)
   {
     m_noBreaks_ = 0;
-    m_brkIt_->setText(UnicodeString(m_file_, m_fileLen_));
+    m_brkIt_->setText(m_text_);
     m_brkIt_->first();
     int32_t j = 0;
     for(j = 0; j < m_fileLen_; j++) {
@@ -87,7 +90,7 @@ public:
       ICUBreakFunction(locale, mode, file, file_len)
   {
     m_noBreaks_ = 0;
-    m_brkIt_->setText(UnicodeString(m_file_, m_fileLen_));
+    m_brkIt_->setText(m_text_);
     m_brkIt_->first();
     while(m_brkIt_->next() != BreakIterator::DONE) {
       m_noBreaks_++;
@@ -103,6 +106,145 @@ public:
   }
 };
 
+class ICUBackward : public ICUBreakFunction {
+public:
+  ICUBackward(const char *locale, const char *mode, const UChar *file, int32_t file_len) :
+      ICUBreakFunction(locale, mode, file, file_len)
+  {
+    m_noBreaks_ = 0;
+    m_brkIt_->setText(m_text_);
+    m_brkIt_->last();
+    while(m_brkIt_->previous() != BreakIterator::DONE) {
+      m_noBreaks_++;
+    }
+  }
+  virtual void call(UErrorCode *status) 
+  {
+    m_noBreaks_ = 0;
+    m_brkIt_->last();
+    while(m_brkIt_->previous() != BreakIterator::DONE) {
+      m_noBreaks_++;
+    }
+  }
+};
+
+// preceding() at each offset, from the end of the text back to its start,
+// as a text editor moving the caret backwards would.
+class ICUPreceding : public ICUBreakFunction {
+public:
+  ICUPreceding(const char *locale, const char *mode, const UChar *file, int32_t file_len) :
+      ICUBreakFunction(locale, mode, file, file_len)
+  {
+    m_noBreaks_ = 0;
+    m_brkIt_->setText(m_text_);
+    int32_t j = 0;
+    for(j = m_fileLen_; j > 0; j--) {
+      if(m_brkIt_->preceding(j) == j - 1) {
+        m_noBreaks_++;
+      }
+    }
+  }
+  virtual void call(UErrorCode *status) 
+  {
+    m_noBreaks_ = 0;
+    int32_t j = 0;
+    for(j = m_fileLen_; j > 0; j--) {
+      if(m_brkIt_->preceding(j) == j - 1) {
+        m_noBreaks_++;
+      }
+    }
+  }
+};
+
+// Boundaries and their rule status values, one at a time through the C API,
+// as a search indexer would collect them.
+class ICUForwardStatus : public ICUBreakFunction {
+public:
+  ICUForwardStatus(const char *locale, const char *mode, const UChar *file, int32_t file_len) :
+      ICUBreakFunction(locale, mode, file, file_len)
+  {
+    m_brkIt_->setText(m_text_);
+    call(&m_status_);
+  }
+  virtual void call(UErrorCode *status)
+  {
+    UBreakIterator *bi = (UBreakIterator *)m_brkIt_;
+    int32_t statusSum = 0;
+    m_noBreaks_ = 0;
+    ubrk_first(bi);
+    while(ubrk_next(bi) != UBRK_DONE) {
+      statusSum += ubrk_getRuleStatus(bi);
+      m_noBreaks_++;
+    }
+    m_statusSum_ = statusSum;
+  }
+  int32_t m_statusSum_;
+};
+
+// The same, collected in bulk with ubrk_getBoundaries().
+class ICUGetBoundaries : public ICUBreakFunction {
+public:
+  ICUGetBoundaries(const char *locale, const char *mode, const UChar *file, int32_t file_len) :
+      ICUBreakFunction(locale, mode, file, file_len)
+  {
+    m_brkIt_->setText(m_text_);
+    call(&m_status_);
+  }
+  virtual void call(UErrorCode *status)
+  {
+    UBreakIterator *bi = (UBreakIterator *)m_brkIt_;
+    int32_t offsets[256];
+    int32_t statuses[256];
+    int32_t statusSum = 0;
+    int32_t count;
+    m_noBreaks_ = 0;
+    ubrk_first(bi);
+    do {
+      count = ubrk_getBoundaries(bi, offsets, statuses, UPRV_LENGTHOF(offsets), status);
+      for(int32_t i = 0; i < count; i++) {
+        statusSum += statuses[i];
+      }
+      m_noBreaks_ += count;
+    } while(count == UPRV_LENGTHOF(offsets));
+    m_statusSum_ = statusSum;
+  }
+  int32_t m_statusSum_;
+};
+
+// The same with ubrk_getBoundariesParallel(), all at once, on several threads.
+class ICUGetBoundariesParallel : public ICUBreakFunction {
+public:
+  ICUGetBoundariesParallel(const char *locale, const char *mode, const UChar *file, int32_t file_len) :
+      ICUBreakFunction(locale, mode, file, file_len)
+  {
+    m_capacity_ = file_len + 1;
+    m_offsets_ = new int32_t[m_capacity_];
+    m_statuses_ = new int32_t[m_capacity_];
+    m_brkIt_->setText(m_text_);
+    call(&m_status_);
+  }
+  ~ICUGetBoundariesParallel()
+  {
+    delete[] m_offsets_;
+    delete[] m_statuses_;
+  }
+  virtual void call(UErrorCode *status)
+  {
+    UBreakIterator *bi = (UBreakIterator *)m_brkIt_;
+    int32_t statusSum = 0;
+    ubrk_first(bi);
+    m_noBreaks_ = ubrk_getBoundariesParallel(bi, m_offsets_, m_statuses_, m_capacity_, 4, status);
+    for(int32_t i = 0; i < m_noBreaks_; i++) {
+      statusSum += m_statuses_[i];
+    }
+    m_statusSum_ = statusSum;
+  }
+  int32_t m_capacity_;
+  int32_t *m_offsets_;
+  int32_t *m_statuses_;
+  int32_t m_statusSum_;
+};
+
 class DarwinBreakFunction : public UPerfFunction {
 public:
   virtual void call(UErrorCode *status) {};
@@ -123,6 +265,11 @@ public:
 
   UPerfFunction* TestICUForward();
   UPerfFunction* TestICUIsBound();
+  UPerfFunction* TestICUBackward();
+  UPerfFunction* TestICUPreceding();
+  UPerfFunction* TestICUForwardStatus();
+  UPerfFunction* TestICUGetBoundaries();
+  UPerfFunction* TestICUGetBoundariesParallel();
 
   UPerfFunction* TestDarwinForward();
   UPerfFunction* TestDarwinIsBound();
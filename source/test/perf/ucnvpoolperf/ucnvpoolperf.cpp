@@ -0,0 +1,280 @@
+// Copyright (C) 2016 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+/*
+**********************************************************************
+*   file name:  ucnvpoolperf.cpp
+*   encoding:   US-ASCII
+*   tab size:   8 (not used)
+*   indentation:4
+*
+*   Multithreaded throughput test for short-lived converters:
+*   ucnv_open()/ucnv_close() per operation versus a per-thread
+*   UConverterPool. Each test case runs --threads threads that each perform
+*   --ops operations, so contention on the converter cache mutex shows up
+*   directly in the reported time per operation.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "unicode/uperf.h"
+#include "unicode/ucnv.h"
+#include "unicode/ucnvpool.h"
+#include "uoptions.h"
+#include "cmemory.h" // for UPRV_LENGTHOF
+
+#if U_PLATFORM_IMPLEMENTS_POSIX
+#include <pthread.h>
+#endif
+
+// Command-line options specific to ucnvpoolperf.
+// Options do not have abbreviations: Force readable command lines.
+// (Using U+0001 for abbreviation characters.)
+enum {
+    THREAD_COUNT,
+    OPS_PER_THREAD,
+    NAME_COUNT,
+    POOL_CAPACITY,
+    UCNVPOOLPERF_OPTIONS_COUNT
+};
+
+static UOption options[UCNVPOOLPERF_OPTIONS_COUNT]={
+    UOPTION_DEF("threads",  '\x01', UOPT_REQUIRES_ARG),
+    UOPTION_DEF("ops",      '\x01', UOPT_REQUIRES_ARG),
+    UOPTION_DEF("names",    '\x01', UOPT_REQUIRES_ARG),
+    UOPTION_DEF("capacity", '\x01', UOPT_REQUIRES_ARG)
+};
+
+static const char *const ucnvpoolperf_usage =
+    "\t--threads   Number of threads converting concurrently.\n"
+    "\t            Default: 4\n"
+    "\t--ops       Number of open+convert+close operations per thread per iteration.\n"
+    "\t            Default: 10000\n"
+    "\t--names     Number of distinct converter names cycled through (at most 8).\n"
+    "\t            Default: 2\n"
+    "\t--capacity  Capacity of each thread's converter pool.\n"
+    "\t            Default: 4\n";
+
+// Aliases rather than canonical names, as they typically come from
+// protocol headers; the pool must canonicalize them.
+static const char *const converterNames[]={
+    "utf-8", "latin1", "windows-1252", "Shift_JIS",
+    "koi8-r", "UTF-16LE", "gb18030", "ibm-037"
+};
+
+// A typical short field, converted once per operation.
+static const UChar text[]={
+    0x48, 0x65, 0x6c, 0x6c, 0x6f, 0x2c, 0x20, 0x77, 0x6f, 0x72, 0x6c, 0x64, 0x21, 0
+};
+
+// Test object with setup data.
+class ConverterPoolPerformanceTest : public UPerfTest {
+public:
+    ConverterPoolPerformanceTest(int32_t argc, const char *argv[], UErrorCode &status)
+            : UPerfTest(argc, argv, options, UPRV_LENGTHOF(options), ucnvpoolperf_usage, status),
+              threadCount(atoi(options[THREAD_COUNT].value)),
+              opsPerThread(atoi(options[OPS_PER_THREAD].value)),
+              nameCount(atoi(options[NAME_COUNT].value)),
+              poolCapacity(atoi(options[POOL_CAPACITY].value)) {
+        if (U_FAILURE(status)) {
+            return;
+        }
+        if (threadCount <= 0 || opsPerThread <= 0 || poolCapacity <= 0 ||
+                nameCount <= 0 || nameCount > UPRV_LENGTHOF(converterNames)) {
+            status = U_ILLEGAL_ARGUMENT_ERROR;
+            return;
+        }
+    }
+
+    virtual UPerfFunction* runIndexedTest(int32_t index, UBool exec, const char* &name, char* par = NULL);
+
+    UBool isVerbose() const { return verbose; }
+
+    int32_t threadCount;
+    int32_t opsPerThread;
+    int32_t nameCount;
+    int32_t poolCapacity;
+};
+
+// Base class for the test functions: runs runThread() on threadCount threads.
+class ConverterThreadedFunction : public UPerfFunction {
+public:
+    ConverterThreadedFunction(const ConverterPoolPerformanceTest &testcase) : testcase(testcase) {}
+
+    virtual long getOperationsPerIteration() {
+        return (long)testcase.threadCount * testcase.opsPerThread;
+    }
+
+    virtual void call(UErrorCode *pErrorCode) {
+        if (U_FAILURE(*pErrorCode)) {
+            return;
+        }
+        runThreads();
+    }
+
+    virtual void runThread(int32_t threadIndex) = 0;
+
+protected:
+    const ConverterPoolPerformanceTest &testcase;
+
+private:
+    struct ThreadArgs {
+        ConverterThreadedFunction *function;
+        int32_t threadIndex;
+    };
+
+#if U_PLATFORM_IMPLEMENTS_POSIX
+    static void *threadMain(void *context) {
+        ThreadArgs *args = (ThreadArgs *)context;
+        args->function->runThread(args->threadIndex);
+        return NULL;
+    }
+
+    void runThreads() {
+        pthread_t *threads = new pthread_t[testcase.threadCount];
+        ThreadArgs *args = new ThreadArgs[testcase.threadCount];
+        for (int32_t i = 0; i < testcase.threadCount; ++i) {
+            args[i].function = this;
+            args[i].threadIndex = i;
+            pthread_create(&threads[i], NULL, &threadMain, &args[i]);
+        }
+        for (int32_t i = 0; i < testcase.threadCount; ++i) {
+            pthread_join(threads[i], NULL);
+        }
+        delete[] args;
+        delete[] threads;
+    }
+#else
+    // No portable threads here; run the per-thread work sequentially.
+    void runThreads() {
+        for (int32_t i = 0; i < testcase.threadCount; ++i) {
+            runThread(i);
+        }
+    }
+#endif
+};
+
+// The baseline: every operation opens and closes its own converter,
+// taking the global converter cache mutex twice.
+class OpenClose : public ConverterThreadedFunction {
+public:
+    static UPerfFunction* get(const ConverterPoolPerformanceTest &testcase) {
+        return new OpenClose(testcase);
+    }
+    OpenClose(const ConverterPoolPerformanceTest &testcase) : ConverterThreadedFunction(testcase) {}
+    virtual void runThread(int32_t threadIndex) {
+        UErrorCode status = U_ZERO_ERROR;
+        char dest[64];
+        int32_t nameIndex = threadIndex % testcase.nameCount;
+        for (int32_t i = 0; i < testcase.opsPerThread && U_SUCCESS(status); ++i) {
+            UConverter *cnv = ucnv_open(converterNames[nameIndex], &status);
+            ucnv_fromUChars(cnv, dest, UPRV_LENGTHOF(dest), text, -1, &status);
+            ucnv_close(cnv);
+            if (++nameIndex == testcase.nameCount) {
+                nameIndex = 0;
+            }
+        }
+    }
+};
+
+// The same work with a pool per thread. Statistics are summed over the
+// threads and printed in verbose mode.
+class PoolCheckout : public ConverterThreadedFunction {
+public:
+    static UPerfFunction* get(const ConverterPoolPerformanceTest &testcase) {
+        return new PoolCheckout(testcase);
+    }
+    PoolCheckout(const ConverterPoolPerformanceTest &testcase) : ConverterThreadedFunction(testcase) {
+        uprv_memset(statistics, 0, sizeof(statistics));
+    }
+    virtual void call(UErrorCode *pErrorCode) {
+        ConverterThreadedFunction::call(pErrorCode);
+        if (U_SUCCESS(*pErrorCode) && testcase.isVerbose()) {
+            printf("checkouts:%ld  hits:%ld  misses:%ld  evictions:%ld  discards:%ld  hit rate:%.4f\n",
+                   (long)statistics[UCNV_POOL_CHECKOUTS], (long)statistics[UCNV_POOL_HITS],
+                   (long)statistics[UCNV_POOL_MISSES], (long)statistics[UCNV_POOL_EVICTIONS],
+                   (long)statistics[UCNV_POOL_DISCARDS],
+                   (double)statistics[UCNV_POOL_HITS] / statistics[UCNV_POOL_CHECKOUTS]);
+        }
+        uprv_memset(statistics, 0, sizeof(statistics));
+    }
+    virtual void runThread(int32_t threadIndex) {
+        UErrorCode status = U_ZERO_ERROR;
+        char dest[64];
+        UConverterPool *pool = ucnv_openPool(testcase.poolCapacity, &status);
+        int32_t nameIndex = threadIndex % testcase.nameCount;
+        for (int32_t i = 0; i < testcase.opsPerThread && U_SUCCESS(status); ++i) {
+            UConverter *cnv = ucnv_checkoutConverter(pool, converterNames[nameIndex], &status);
+            ucnv_fromUChars(cnv, dest, UPRV_LENGTHOF(dest), text, -1, &status);
+            ucnv_checkinConverter(pool, cnv);
+            if (++nameIndex == testcase.nameCount) {
+                nameIndex = 0;
+            }
+        }
+        if (pool != NULL) {
+            // Pools are per thread, but the totals are shared.
+            // The counters are the statistics before UCNV_POOL_SIZE.
+            int32_t values[UCNV_POOL_SIZE];
+            for (int32_t s = 0; s < UCNV_POOL_SIZE; ++s) {
+                values[s] = ucnv_getPoolStatistic(pool, (UConverterPoolStatistic)s);
+            }
+            addStatistics(values);
+        }
+        ucnv_closePool(pool);
+    }
+private:
+    void addStatistics(const int32_t values[]);
+
+    int32_t statistics[UCNV_POOL_SIZE];
+};
+
+#if U_PLATFORM_IMPLEMENTS_POSIX
+static pthread_mutex_t statisticsMutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+void PoolCheckout::addStatistics(const int32_t values[]) {
+#if U_PLATFORM_IMPLEMENTS_POSIX
+    pthread_mutex_lock(&statisticsMutex);
+#endif
+    for (int32_t s = 0; s < UCNV_POOL_SIZE; ++s) {
+        statistics[s] += values[s];
+    }
+#if U_PLATFORM_IMPLEMENTS_POSIX
+    pthread_mutex_unlock(&statisticsMutex);
+#endif
+}
+
+UPerfFunction* ConverterPoolPerformanceTest::runIndexedTest(int32_t index, UBool exec, const char* &name, char* /*par*/) {
+    switch (index) {
+        case 0: name = "OpenClose";    if (exec) return OpenClose::get(*this); break;
+        case 1: name = "PoolCheckout"; if (exec) return PoolCheckout::get(*this); break;
+        default: name = ""; break;
+    }
+    return NULL;
+}
+
+int main(int argc, const char *argv[])
+{
+    // Default values for command-line options.
+    options[THREAD_COUNT].value = "4";
+    options[OPS_PER_THREAD].value = "10000";
+    options[NAME_COUNT].value = "2";
+    options[POOL_CAPACITY].value = "4";
+
+    UErrorCode status = U_ZERO_ERROR;
+    ConverterPoolPerformanceTest test(argc, argv, status);
+
+    if (U_FAILURE(status)){
+        printf("The error is %s\n", u_errorName(status));
+        test.usage();
+        return status;
+    }
+
+    if (test.run() == FALSE){
+        fprintf(stderr, "FAILED: Tests could not be run, please check the "
+                        "arguments.\n");
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,312 @@
+// Copyright (C) 2016 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+/*
+**********************************************************************
+*   file name:  unifiedcacheperf.cpp
+*   encoding:   US-ASCII
+*   tab size:   8 (not used)
+*   indentation:4
+*
+*   Multithreaded throughput and hit rate test for UnifiedCache.
+*   Each test case runs --threads threads that each perform --gets
+*   cache lookups, so contention on the cache locks shows up directly
+*   in the reported time per operation.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "unicode/uperf.h"
+#include "unicode/numfmt.h"
+#include "unifiedcache.h"
+#include "umutex.h"
+#include "uoptions.h"
+#include "cmemory.h" // for UPRV_LENGTHOF
+
+#if U_PLATFORM_IMPLEMENTS_POSIX
+#include <pthread.h>
+#endif
+
+// Command-line options specific to unifiedcacheperf.
+// Options do not have abbreviations: Force readable command lines.
+// (Using U+0001 for abbreviation characters.)
+enum {
+    THREAD_COUNT,
+    GETS_PER_THREAD,
+    KEY_COUNT,
+    UNIFIEDCACHEPERF_OPTIONS_COUNT
+};
+
+static UOption options[UNIFIEDCACHEPERF_OPTIONS_COUNT]={
+    UOPTION_DEF("threads", '\x01', UOPT_REQUIRES_ARG),
+    UOPTION_DEF("gets",    '\x01', UOPT_REQUIRES_ARG),
+    UOPTION_DEF("keys",    '\x01', UOPT_REQUIRES_ARG)
+};
+
+static const char *const unifiedcacheperf_usage =
+    "\t--threads   Number of threads doing lookups concurrently.\n"
+    "\t            Default: 4\n"
+    "\t--gets      Number of cache lookups per thread per iteration.\n"
+    "\t            Default: 10000\n"
+    "\t--keys      Number of distinct keys cycled through by the lookups.\n"
+    "\t            Default: 64\n";
+
+// Cached value type private to this test, so that the test controls
+// exactly which keys exist and can count cache misses.
+class CachePerfItem : public SharedObject {
+public:
+    CachePerfItem() {}
+    virtual ~CachePerfItem();
+};
+
+CachePerfItem::~CachePerfItem() {}
+
+static u_atomic_int32_t gCreateCount = ATOMIC_INT32_T_INITIALIZER(0);
+
+U_NAMESPACE_BEGIN
+
+template<> U_EXPORT
+const CachePerfItem *LocaleCacheKey<CachePerfItem>::createObject(
+        const void * /*unused*/, UErrorCode &status) const {
+    umtx_atomic_inc(&gCreateCount);
+    CachePerfItem *result = new CachePerfItem();
+    if (result == NULL) {
+        status = U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+    result->addRef();
+    return result;
+}
+
+U_NAMESPACE_END
+
+// Test object with setup data.
+class UnifiedCachePerformanceTest : public UPerfTest {
+public:
+    UnifiedCachePerformanceTest(int32_t argc, const char *argv[], UErrorCode &status)
+            : UPerfTest(argc, argv, options, UPRV_LENGTHOF(options), unifiedcacheperf_usage, status),
+              threadCount(atoi(options[THREAD_COUNT].value)),
+              getsPerThread(atoi(options[GETS_PER_THREAD].value)),
+              keyCount(atoi(options[KEY_COUNT].value)),
+              locales(NULL) {
+        if (U_FAILURE(status)) {
+            return;
+        }
+        if (threadCount <= 0 || getsPerThread <= 0 || keyCount <= 0) {
+            status = U_ILLEGAL_ARGUMENT_ERROR;
+            return;
+        }
+        // Distinct synthetic locale IDs, one per key.
+        locales = new Locale[keyCount];
+        for (int32_t i = 0; i < keyCount; ++i) {
+            char id[16];
+            sprintf(id, "x%d_US", (int)i);
+            locales[i] = Locale(id);
+        }
+    }
+
+    virtual ~UnifiedCachePerformanceTest() {
+        delete[] locales;
+    }
+
+    virtual UPerfFunction* runIndexedTest(int32_t index, UBool exec, const char* &name, char* par = NULL);
+
+    UBool isVerbose() const { return verbose; }
+    Locale getLocale() const { return locale != NULL ? Locale(locale) : Locale::getDefault(); }
+
+    int32_t threadCount;
+    int32_t getsPerThread;
+    int32_t keyCount;
+    Locale *locales;
+};
+
+// Base class for the test functions: runs runThread() on threadCount threads
+// and reports the hit rate in verbose mode.
+class CacheThreadedFunction : public UPerfFunction {
+public:
+    CacheThreadedFunction(const UnifiedCachePerformanceTest &testcase) : testcase(testcase) {}
+
+    virtual long getOperationsPerIteration() {
+        return (long)testcase.threadCount * testcase.getsPerThread;
+    }
+
+    virtual void call(UErrorCode *pErrorCode) {
+        if (U_FAILURE(*pErrorCode)) {
+            return;
+        }
+        int32_t createCountBefore = umtx_loadAcquire(gCreateCount);
+        runThreads();
+        int32_t misses = umtx_loadAcquire(gCreateCount) - createCountBefore;
+        if (misses > 0 && testcase.isVerbose()) {
+            long gets = getOperationsPerIteration();
+            printf("gets:%ld  misses:%ld  hit rate:%.4f\n",
+                   gets, (long)misses, (double)(gets - misses) / gets);
+        }
+    }
+
+    virtual void runThread(int32_t threadIndex) = 0;
+
+protected:
+    const UnifiedCachePerformanceTest &testcase;
+
+private:
+    struct ThreadArgs {
+        CacheThreadedFunction *function;
+        int32_t threadIndex;
+    };
+
+#if U_PLATFORM_IMPLEMENTS_POSIX
+    static void *threadMain(void *context) {
+        ThreadArgs *args = (ThreadArgs *)context;
+        args->function->runThread(args->threadIndex);
+        return NULL;
+    }
+
+    void runThreads() {
+        pthread_t *threads = new pthread_t[testcase.threadCount];
+        ThreadArgs *args = new ThreadArgs[testcase.threadCount];
+        for (int32_t i = 0; i < testcase.threadCount; ++i) {
+            args[i].function = this;
+            args[i].threadIndex = i;
+            pthread_create(&threads[i], NULL, &threadMain, &args[i]);
+        }
+        for (int32_t i = 0; i < testcase.threadCount; ++i) {
+            pthread_join(threads[i], NULL);
+        }
+        delete[] args;
+        delete[] threads;
+    }
+#else
+    // No portable threads here; run the per-thread work sequentially.
+    void runThreads() {
+        for (int32_t i = 0; i < testcase.threadCount; ++i) {
+            runThread(i);
+        }
+    }
+#endif
+};
+
+// Lookups of a hot set of keys that all stay present in the cache,
+// like formatter constructors fetching their shared data.
+class GetHit : public CacheThreadedFunction {
+public:
+    static UPerfFunction* get(const UnifiedCachePerformanceTest &testcase) {
+        return new GetHit(testcase);
+    }
+    GetHit(const UnifiedCachePerformanceTest &testcase) : CacheThreadedFunction(testcase) {
+        // Keep one reference per key so that the entries stay in the cache.
+        UErrorCode status = U_ZERO_ERROR;
+        const UnifiedCache *cache = UnifiedCache::getInstance(status);
+        held = new const CachePerfItem *[testcase.keyCount];
+        for (int32_t i = 0; i < testcase.keyCount; ++i) {
+            held[i] = NULL;
+            if (U_SUCCESS(status)) {
+                cache->get(LocaleCacheKey<CachePerfItem>(testcase.locales[i]), held[i], status);
+            }
+        }
+    }
+    virtual ~GetHit() {
+        for (int32_t i = 0; i < testcase.keyCount; ++i) {
+            SharedObject::clearPtr(held[i]);
+        }
+        delete[] held;
+    }
+    virtual void runThread(int32_t threadIndex) {
+        UErrorCode status = U_ZERO_ERROR;
+        const UnifiedCache *cache = UnifiedCache::getInstance(status);
+        const CachePerfItem *item = NULL;
+        int32_t keyIndex = threadIndex % testcase.keyCount;
+        for (int32_t i = 0; i < testcase.getsPerThread && U_SUCCESS(status); ++i) {
+            cache->get(LocaleCacheKey<CachePerfItem>(testcase.locales[keyIndex]), item, status);
+            if (++keyIndex == testcase.keyCount) {
+                keyIndex = 0;
+            }
+        }
+        SharedObject::clearPtr(item);
+    }
+private:
+    const CachePerfItem **held;
+};
+
+// Lookups of keys that nobody else holds, so that entries are evicted and
+// recreated according to the cache's eviction policy. With --keys larger
+// than the unused entry limit this measures the miss path.
+class GetUnheld : public CacheThreadedFunction {
+public:
+    static UPerfFunction* get(const UnifiedCachePerformanceTest &testcase) {
+        return new GetUnheld(testcase);
+    }
+    GetUnheld(const UnifiedCachePerformanceTest &testcase) : CacheThreadedFunction(testcase) {}
+    virtual void runThread(int32_t threadIndex) {
+        UErrorCode status = U_ZERO_ERROR;
+        const UnifiedCache *cache = UnifiedCache::getInstance(status);
+        const CachePerfItem *item = NULL;
+        int32_t keyIndex = threadIndex % testcase.keyCount;
+        for (int32_t i = 0; i < testcase.getsPerThread && U_SUCCESS(status); ++i) {
+            cache->get(LocaleCacheKey<CachePerfItem>(testcase.locales[keyIndex]), item, status);
+            SharedObject::clearPtr(item);
+            if (++keyIndex == testcase.keyCount) {
+                keyIndex = 0;
+            }
+        }
+    }
+};
+
+#if !UCONFIG_NO_FORMATTING
+// End-to-end NumberFormat::createInstance(), which fetches its
+// SharedNumberFormat from the cache.
+class CreateNumberFormat : public CacheThreadedFunction {
+public:
+    static UPerfFunction* get(const UnifiedCachePerformanceTest &testcase) {
+        return new CreateNumberFormat(testcase);
+    }
+    CreateNumberFormat(const UnifiedCachePerformanceTest &testcase)
+            : CacheThreadedFunction(testcase), locale(testcase.getLocale()) {}
+    virtual void runThread(int32_t /*threadIndex*/) {
+        UErrorCode status = U_ZERO_ERROR;
+        for (int32_t i = 0; i < testcase.getsPerThread && U_SUCCESS(status); ++i) {
+            NumberFormat *fmt = NumberFormat::createInstance(locale, status);
+            delete fmt;
+        }
+    }
+private:
+    Locale locale;
+};
+#endif
+
+UPerfFunction* UnifiedCachePerformanceTest::runIndexedTest(int32_t index, UBool exec, const char* &name, char* /*par*/) {
+    switch (index) {
+        case 0: name = "GetHit";       if (exec) return GetHit::get(*this); break;
+        case 1: name = "GetUnheld";    if (exec) return GetUnheld::get(*this); break;
+#if !UCONFIG_NO_FORMATTING
+        case 2: name = "CreateNumberFormat"; if (exec) return CreateNumberFormat::get(*this); break;
+#endif
+        default: name = ""; break;
+    }
+    return NULL;
+}
+
+int main(int argc, const char *argv[])
+{
+    // Default values for command-line options.
+    options[THREAD_COUNT].value = "4";
+    options[GETS_PER_THREAD].value = "10000";
+    options[KEY_COUNT].value = "64";
+
+    UErrorCode status = U_ZERO_ERROR;
+    UnifiedCachePerformanceTest test(argc, argv, status);
+
+    if (U_FAILURE(status)){
+        printf("The error is %s\n", u_errorName(status));
+        test.usage();
+        return status;
+    }
+
+    if (test.run() == FALSE){
+        fprintf(stderr, "FAILED: Tests could not be run, please check the "
+                        "arguments.\n");
+        return 1;
+    }
+
+    return 0;
+}
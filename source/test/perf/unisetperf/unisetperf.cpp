@@ -19,6 +19,7 @@
 #include "unicode/uniset.h"
 #include "unicode/unistr.h"
 #include "uoptions.h"
+#include "uvectr32.h"
 #include "cmemory.h" // for UPRV_LENGTHOF
 
 // Command-line options specific to unisetperf.
@@ -403,6 +404,122 @@ public:
     }
 };
 
+/*
+ * Span each line of the input text separately, the way tokenizers and
+ * validators check one input field at a time, and count the lines
+ * that are entirely in the set.
+ * With a pattern that contains most of the text, for example --pattern "[^\n]",
+ * the spans are as long as the lines.
+ */
+class SpanFieldsUTF16 : public Command {
+protected:
+    SpanFieldsUTF16(const UnicodeSetPerformanceTest &testcase)
+            : Command(testcase), errorCode(U_ZERO_ERROR), fieldLimits(errorCode), containedCount(0) {
+        const UChar *s=testcase.getBuffer();
+        int32_t length=testcase.getBufferLen();
+        int32_t start=0;
+        for(int32_t i=0; i<=length; ++i) {
+            if(i==length || s[i]==0xa) {
+                fieldLimits.addElement(i, errorCode);
+                if(i>start && testcase.span(s, i, start, TRUE)==i) {
+                    ++containedCount;
+                }
+                start=i+1;
+            }
+        }
+    }
+public:
+    static UPerfFunction* get(const UnicodeSetPerformanceTest &testcase) {
+        return new SpanFieldsUTF16(testcase);
+    }
+    virtual void call(UErrorCode* pErrorCode) {
+        const UnicodeSet &set=testcase.set;
+        const UChar *s=testcase.getBuffer();
+        int32_t fieldCount=fieldLimits.size();
+        int32_t count=0;
+        int32_t start=0;
+        for(int32_t i=0; i<fieldCount; ++i) {
+            int32_t limit=fieldLimits.elementAti(i);
+            if(limit>start && set.span(s+start, limit-start, USET_SPAN_CONTAINED)==limit-start) {
+                ++count;
+            }
+            start=limit+1;
+        }
+        if(count!=containedCount) {
+            fprintf(stderr, "error: SpanFieldsUTF16() count=%ld != %ld=contained lines\n",
+                    (long)count, (long)containedCount);
+        }
+    }
+    virtual long getOperationsPerIteration() {
+        return testcase.countInputCodePoints;
+    }
+    virtual long getEventsPerIteration() {
+        return fieldLimits.size();
+    }
+
+    UErrorCode errorCode;
+    UVector32 fieldLimits;
+    int32_t containedCount;
+};
+
+class SpanFieldsUTF8 : public Command {
+protected:
+    SpanFieldsUTF8(const UnicodeSetPerformanceTest &testcase)
+            : Command(testcase), errorCode(U_ZERO_ERROR), fieldLimits(errorCode), containedCount(0) {
+        const UChar *s16=testcase.getBuffer();
+        int32_t length16=testcase.getBufferLen();
+        int32_t start16=0;
+        const char *s=testcase.utf8;
+        int32_t length=testcase.utf8Length;
+        for(int32_t i=0; i<=length; ++i) {
+            if(i==length || s[i]==0xa) {
+                fieldLimits.addElement(i, errorCode);
+            }
+        }
+        // Count the contained lines in the UTF-16 text. Its lines match the UTF-8 ones.
+        for(int32_t i=0; i<=length16; ++i) {
+            if(i==length16 || s16[i]==0xa) {
+                if(i>start16 && testcase.span(s16, i, start16, TRUE)==i) {
+                    ++containedCount;
+                }
+                start16=i+1;
+            }
+        }
+    }
+public:
+    static UPerfFunction* get(const UnicodeSetPerformanceTest &testcase) {
+        return new SpanFieldsUTF8(testcase);
+    }
+    virtual void call(UErrorCode* pErrorCode) {
+        const UnicodeSet &set=testcase.set;
+        const char *s=testcase.utf8;
+        int32_t fieldCount=fieldLimits.size();
+        int32_t count=0;
+        int32_t start=0;
+        for(int32_t i=0; i<fieldCount; ++i) {
+            int32_t limit=fieldLimits.elementAti(i);
+            if(limit>start && set.spanUTF8(s+start, limit-start, USET_SPAN_CONTAINED)==limit-start) {
+                ++count;
+            }
+            start=limit+1;
+        }
+        if(count!=containedCount) {
+            fprintf(stderr, "error: SpanFieldsUTF8() count=%ld != %ld=contained lines\n",
+                    (long)count, (long)containedCount);
+        }
+    }
+    virtual long getOperationsPerIteration() {
+        return testcase.countInputCodePoints;
+    }
+    virtual long getEventsPerIteration() {
+        return fieldLimits.size();
+    }
+
+    UErrorCode errorCode;
+    UVector32 fieldLimits;
+    int32_t containedCount;
+};
+
 UPerfFunction* UnicodeSetPerformanceTest::runIndexedTest(int32_t index, UBool exec, const char* &name, char* par) {
     switch (index) {
         case 0: name = "Contains";     if (exec) return Contains::get(*this); break;
@@ -410,6 +527,8 @@ UPerfFunction* UnicodeSetPerformanceTest::runIndexedTest(int32_t index, UBool ex
         case 2: name = "SpanBackUTF16";if (exec) return SpanBackUTF16::get(*this); break;
         case 3: name = "SpanUTF8";     if (exec) return SpanUTF8::get(*this); break;
         case 4: name = "SpanBackUTF8"; if (exec) return SpanBackUTF8::get(*this); break;
+        case 5: name = "SpanFieldsUTF16"; if (exec) return SpanFieldsUTF16::get(*this); break;
+        case 6: name = "SpanFieldsUTF8";  if (exec) return SpanFieldsUTF8::get(*this); break;
         default: name = ""; break;
     }
     return NULL;
@@ -43,6 +43,16 @@ my $tests = {
     [
         "$p,SpanUTF16 --type Bv",
         "$p,SpanUTF16 --type Bv0"
+    ],
+    "SpanFieldsUTF16",
+    [
+        "$p,SpanFieldsUTF16 --type slow --pattern [^\\n]",
+        "$p,SpanFieldsUTF16 --type fast --pattern [^\\n]"
+    ],
+    "SpanFieldsUTF8",
+    [
+        "$p,SpanFieldsUTF8 --type slow --pattern [^\\n]",
+        "$p,SpanFieldsUTF8 --type fast --pattern [^\\n]"
     ]
 };
 
@@ -18,6 +18,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "unicode/uperf.h"
+#include "unicode/ustring.h"
 #include "cmemory.h" // for UPRV_LENGTHOF
 #include "uoptions.h"
 
@@ -46,13 +47,15 @@ enum {
     CHARSET,
     CHUNK_LENGTH,
     PIVOT_LENGTH,
+    CPU_GHZ,
     UTFPERF_OPTIONS_COUNT
 };
 
 static UOption options[UTFPERF_OPTIONS_COUNT]={
     UOPTION_DEF("charset",  '\x01', UOPT_REQUIRES_ARG),
     UOPTION_DEF("chunk",    '\x01', UOPT_REQUIRES_ARG),
-    UOPTION_DEF("pivot",    '\x01', UOPT_REQUIRES_ARG)
+    UOPTION_DEF("pivot",    '\x01', UOPT_REQUIRES_ARG),
+    UOPTION_DEF("ghz",      '\x01', UOPT_REQUIRES_ARG)
 };
 
 static const char *const utfperf_usage =
@@ -60,7 +63,9 @@ static const char *const utfperf_usage =
     "\t            Default: UTF-8\n"
     "\t--chunk     Length (in bytes) of charset output chunks. [4096]\n"
     "\t--pivot     Length (in UChars) of the UTF-16 pivot buffer, if applicable.\n"
-    "\t            [1024]\n";
+    "\t            [1024]\n"
+    "\t--ghz       CPU clock rate in GHz. If set, each test also reports\n"
+    "\t            charset bytes per clock cycle. [0]\n";
 
 // Test object.
 class  UtfPerformanceTest : public UPerfTest{
@@ -82,6 +87,8 @@ public:
                 status = U_ILLEGAL_ARGUMENT_ERROR;
             }
 
+            cpuGHz = atof(options[CPU_GHZ].value);
+
             int32_t inputLength;
             UPerfTest::getBuffer(inputLength, status);
             countInputCodePoints = u_countChar32(buffer, bufferLen);
@@ -96,6 +103,7 @@ public:
 
     const char *charset;
     int32_t chunkLength, pivotLength;
+    double cpuGHz;
 };
 
 U_CDECL_BEGIN
@@ -115,13 +123,13 @@ fromUCallback(const void *context,
 }
 U_CDECL_END
 
-// Base class for Roundtrip, FromUnicode and FromUTF8 with common setup.
+// Base class for the test functions with common setup.
 class Command : public UPerfFunction {
 protected:
     Command(const UtfPerformanceTest &testcase)
             : testcase(testcase),
               input(testcase.getBuffer()), inputLength(testcase.getBufferLen()),
-              errorCode(U_ZERO_ERROR) {
+              byteCount(0), bytesPerCycle(0), errorCode(U_ZERO_ERROR) {
         cnv=ucnv_open(testcase.charset, &errorCode);
         if (U_FAILURE(errorCode)) {
             fprintf(stderr, "error opening converter for \"%s\" - %s\n", testcase.charset, u_errorName(errorCode));
@@ -133,15 +141,30 @@ public:
         if(U_SUCCESS(errorCode)) {
             ucnv_close(cnv);
         }
+        if(bytesPerCycle>0) {
+            printf("= bytes/iteration: %ld  bytes/cycle: %.3f\n", (long)byteCount, bytesPerCycle);
+        }
     }
     // virtual void call(UErrorCode* pErrorCode) { ... }
     virtual long getOperationsPerIteration(){
         return countInputCodePoints;
     }
+    // Measures charset bytes per cycle, for the charset bytes that each
+    // call() read or wrote, if the CPU clock rate is known.
+    // The destructor reports the value from the last timed run.
+    virtual double time(int32_t n, UErrorCode* status) {
+        double seconds=UPerfFunction::time(n, status);
+        if(testcase.cpuGHz>0 && seconds>0 && U_SUCCESS(*status)) {
+            bytesPerCycle=((double)byteCount*n)/(seconds*testcase.cpuGHz*1e9);
+        }
+        return seconds;
+    }
 
     const UtfPerformanceTest &testcase;
     const UChar *input;
     int32_t inputLength;
+    int32_t byteCount;
+    double bytesPerCycle;
     UErrorCode errorCode;
     UConverter *cnv;
 };
@@ -205,6 +228,7 @@ public:
             /* intermediate must have been consumed (p==pInter) because of the converter semantics */
         } while(!flush);
 
+        byteCount=encodedLength;
         outputLength=pOut-output;
         if(inputLength!=outputLength) {
             fprintf(stderr, "error: roundtrip failed, inputLength %d!=outputLength %d\n", inputLength, outputLength);
@@ -255,6 +279,7 @@ public:
                 break;  // all done
             }
         }
+        byteCount=encodedLength;
     }
 };
 
@@ -317,6 +342,7 @@ public:
                 break;  // all done
             }
         }
+        byteCount=input8Length;
     }
 protected:
     UConverter *utf8Cnv;
@@ -324,11 +350,53 @@ protected:
     int32_t input8Length;
 };
 
+// Test u_strFromUTF8(), independent of the --charset.
+class StrFromUTF8 : public Command {
+protected:
+    StrFromUTF8(const UtfPerformanceTest &testcase) : Command(testcase) {}
+public:
+    static UPerfFunction* get(const UtfPerformanceTest &testcase) {
+        StrFromUTF8 * t = new StrFromUTF8(testcase);
+        if (U_SUCCESS(t->errorCode)){
+            return t;
+        } else {
+            delete t;
+            return NULL;
+        }
+    }
+    virtual void call(UErrorCode* pErrorCode){
+        u_strFromUTF8(output, OUTPUT_CAPACITY, &outputLength, utf8, utf8Length, pErrorCode);
+        byteCount=utf8Length;
+    }
+};
+
+// Test u_strToUTF8(), independent of the --charset.
+class StrToUTF8 : public Command {
+protected:
+    StrToUTF8(const UtfPerformanceTest &testcase) : Command(testcase) {}
+public:
+    static UPerfFunction* get(const UtfPerformanceTest &testcase) {
+        StrToUTF8 * t = new StrToUTF8(testcase);
+        if (U_SUCCESS(t->errorCode)){
+            return t;
+        } else {
+            delete t;
+            return NULL;
+        }
+    }
+    virtual void call(UErrorCode* pErrorCode){
+        u_strToUTF8(intermediate, OUTPUT_CAPACITY, &encodedLength, input, inputLength, pErrorCode);
+        byteCount=encodedLength;
+    }
+};
+
 UPerfFunction* UtfPerformanceTest::runIndexedTest(int32_t index, UBool exec, const char* &name, char* par) {
     switch (index) {
         case 0: name = "Roundtrip";     if (exec) return Roundtrip::get(*this); break;
         case 1: name = "FromUnicode";   if (exec) return FromUnicode::get(*this); break;
         case 2: name = "FromUTF8";      if (exec) return FromUTF8::get(*this); break;
+        case 3: name = "StrFromUTF8";   if (exec) return StrFromUTF8::get(*this); break;
+        case 4: name = "StrToUTF8";     if (exec) return StrToUTF8::get(*this); break;
         default: name = ""; break;
     }
     return NULL;
@@ -340,6 +408,7 @@ int main(int argc, const char *argv[])
     options[CHARSET].value = "UTF-8";
     options[CHUNK_LENGTH].value = "4096";
     options[PIVOT_LENGTH].value = "1024";
+    options[CPU_GHZ].value = "0";
 
     UErrorCode status = U_ZERO_ERROR;
     UtfPerformanceTest test(argc, argv, status);
@@ -376,6 +376,13 @@ udata_swapPackage(const char *inFilename, const char *outFilename,
         *pErrorCode=U_UNSUPPORTED_ERROR;
         return 0;
     }
+    if(pInfo->formatVersion[1]>=1) {
+        /* the ToC hash index would need to be rebuilt for the re-sorted names */
+        udata_printError(ds, "udata_swapPackage(): format version %02x.%02x packages with a ToC hash index are not supported, use icupkg\n",
+                         pInfo->formatVersion[0], pInfo->formatVersion[1]);
+        *pErrorCode=U_UNSUPPORTED_ERROR;
+        return 0;
+    }
 
     /*
      * We need to change the ToC name entries so that they have the correct
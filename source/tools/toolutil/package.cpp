@@ -55,7 +55,7 @@ static const UDataInfo dataInfo={
     0,
 
     {0x43, 0x6d, 0x6e, 0x44},     /* dataFormat="CmnD" */
-    {1, 0, 0, 0},                 /* formatVersion */
+    {1, 1, 0, 0},                 /* formatVersion: 1.1 has a ToC hash index */
     {3, 0, 0, 0}                  /* dataVersion */
 };
 
@@ -545,8 +545,22 @@ Package::readPackage(const char *filename) {
             exit(U_BUFFER_OVERFLOW_ERROR);
         }
 
-        /* swap the item name strings */
+        /* skip the ToC hash index, if any; the reader does not need it */
         int32_t stringsOffset=4+8*itemCount;
+        if(pInfo->formatVersion[1]>=1) {
+            int32_t hashLength=0;
+            if(length>=(stringsOffset+4)) {
+                hashLength=udata_readInt32(ds, *(const int32_t *)(inBytes+stringsOffset));
+            }
+            if(hashLength<=itemCount || length<(stringsOffset+4+4*hashLength)) {
+                fprintf(stderr, "icupkg: invalid ToC hash index length %ld in .dat package\n",
+                                (long)hashLength);
+                exit(U_INVALID_FORMAT_ERROR);
+            }
+            stringsOffset+=4+4*hashLength;
+        }
+
+        /* swap the item name strings */
         itemLength=(int32_t)(ds->readUInt32(inEntries[0].dataOffset))-stringsOffset;
 
         // don't include padding bytes at the end of the item names
@@ -692,6 +706,7 @@ Package::writePackage(const char *filename, char outType, const char *comment) {
     char *name;
     UErrorCode errorCode;
     int32_t i, length, prefixLength, maxItemLength, basenameOffset, offset, outInt32;
+    int32_t hashLength;
     uint8_t outCharset;
     UBool outIsBigEndian;
 
@@ -721,6 +736,10 @@ Package::writePackage(const char *filename, char outType, const char *comment) {
         pHeader->dataHeader.headerSize=(uint16_t)headerLength;
     }
 
+    // always write formatVersion 1.1 with a ToC hash index
+    // (older icupkg and icuswap cannot read such packages; see pkg_gencmn.c)
+    ((DataHeader *)header)->info.formatVersion[1]=1;
+
     makeTypeProps(outType, outCharset, outIsBigEndian);
 
     // open (TYPE_COUNT-2) swappers
@@ -804,9 +823,29 @@ Package::writePackage(const char *filename, char outType, const char *comment) {
         items[i].name=name;
     }
 
+    // build the ToC hash index over the output item names:
+    // a power-of-2 table at most half full, with linear probing
+    hashLength=1;
+    while(hashLength<2*itemCount) {
+        hashLength<<=1;
+    }
+    icu::LocalMemory<uint32_t> hashSlots((uint32_t *)uprv_malloc(hashLength*4));
+    if(hashSlots.isNull()) {
+        fprintf(stderr, "icupkg: malloc error allocating the ToC hash index\n");
+        exit(U_MEMORY_ALLOCATION_ERROR);
+    }
+    uprv_memset(hashSlots.getAlias(), 0, hashLength*4);
+    for(i=0; i<itemCount; ++i) {
+        uint32_t slot=udata_hashTOCEntryName(items[i].name)&(hashLength-1);
+        while(hashSlots[slot]!=0) {
+            slot=(slot+1)&(hashLength-1);
+        }
+        hashSlots[slot]=(uint32_t)(i+1);
+    }
+
     // calculate offsets for item names and items, pad to 16-align items
     // align only the first item; each item's length is a multiple of 16
-    basenameOffset=4+8*itemCount;
+    basenameOffset=4+8*itemCount+4+4*hashLength;
     offset=basenameOffset+outStringTop;
     if((length=(offset&15))!=0) {
         length=16-length;
@@ -855,6 +894,23 @@ Package::writePackage(const char *filename, char outType, const char *comment) {
         offset+=length;
     }
 
+    // then write the ToC hash index
+    outInt32=hashLength;
+    if(dsLocalToOut!=NULL) {
+        dsLocalToOut->swapArray32(dsLocalToOut, &outInt32, 4, &outInt32, &errorCode);
+        dsLocalToOut->swapArray32(dsLocalToOut, hashSlots.getAlias(), hashLength*4, hashSlots.getAlias(), &errorCode);
+        if(U_FAILURE(errorCode)) {
+            fprintf(stderr, "icupkg: swapArray32(ToC hash index) failed - %s\n", u_errorName(errorCode));
+            exit(errorCode);
+        }
+    }
+    if( fwrite(&outInt32, 1, 4, file)!=4 ||
+        (int32_t)fwrite(hashSlots.getAlias(), 4, hashLength, file)!=hashLength
+    ) {
+        fprintf(stderr, "icupkg: unable to write complete ToC hash index to file \"%s\"\n", filename);
+        exit(U_FILE_ACCESS_ERROR);
+    }
+
     // write the item names
     length=(int32_t)fwrite(outStrings, 1, outStringTop, file);
     if(length!=outStringTop) {
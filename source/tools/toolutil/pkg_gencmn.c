@@ -18,6 +18,7 @@
 #include "unicode/uclean.h"
 #include "unewdata.h"
 #include "putilimp.h"
+#include "ucmndata.h"
 #include "pkg_gencmn.h"
 
 #define STRING_STORE_SIZE 200000
@@ -43,10 +44,23 @@ UDataOffsetTOCEntry entry[count]; - pair of uint32_t values per item:
     uint32_t dataOffset; - offset of the item data
 both are byte offsets from the beginning of the data
 
+Format version 1.1 (written by icupkg and by pkgdata/gencmn) adds a hash index
+immediately after the ToC entries, for O(1) item lookup:
+
+uint32_t hashLength; - power of 2, greater than count
+uint32_t slots[hashLength]; - 0 for an empty slot, otherwise 1+the ToC entry index
+    An item is at or after slot udata_hashTOCEntryName(name)&(hashLength-1),
+    with linear probing up to the next empty slot.
+
+The ICU runtime of format version 1.0 ignores the index since it only
+follows the offsets in the ToC entries. Tools that parse the package layout
+do not: icupkg and icuswap from before format version 1.1 read the index
+as item names and cannot read 1.1 packages.
+
 2. item name strings
 
 All item names are stored as char * strings in one block between the ToC table
-and the data items.
+(and hash index, if any) and the data items.
 
 3. data items
 
@@ -72,7 +86,7 @@ static const UDataInfo dataInfo={
     0,
 
     {0x43, 0x6d, 0x6e, 0x44},     /* dataFormat="CmnD" */
-    {1, 0, 0, 0},                 /* formatVersion */
+    {1, 1, 0, 0},                 /* formatVersion: 1.1 has a ToC hash index */
     {3, 0, 0, 0}                  /* dataVersion */
 };
 
@@ -122,7 +136,7 @@ createCommonDataFile(const char *destDir, const char *name, const char *entrypoi
     char *linePtr;
     char *s = NULL;
     UErrorCode errorCode=U_ZERO_ERROR;
-    uint32_t i, fileOffset, basenameOffset, length, nread;
+    uint32_t i, fileOffset, basenameOffset, length, nread, hashLength;
     FileStream *in, *file;
 
     line = (char *)uprv_malloc(sizeof(char) * LINE_BUFFER_SIZE);
@@ -221,9 +235,32 @@ createCommonDataFile(const char *destDir, const char *name, const char *entrypoi
 
     if(!sourceTOC) {
         UNewDataMemory *out;
+        uint32_t *hashSlots;
+
+        /*
+         * build the ToC hash index over the basenames:
+         * a power-of-2 table at most half full, with linear probing
+         */
+        hashLength=1;
+        while(hashLength<2*fileCount) {
+            hashLength<<=1;
+        }
+        hashSlots=(uint32_t *)uprv_malloc(hashLength*4);
+        if(hashSlots==NULL) {
+            fprintf(stderr, "gencmn: malloc error allocating the ToC hash index\n");
+            exit(U_MEMORY_ALLOCATION_ERROR);
+        }
+        uprv_memset(hashSlots, 0, hashLength*4);
+        for(i=0; i<fileCount; ++i) {
+            uint32_t slot=udata_hashTOCEntryName(files[i].basename)&(hashLength-1);
+            while(hashSlots[slot]!=0) {
+                slot=(slot+1)&(hashLength-1);
+            }
+            hashSlots[slot]=i+1;
+        }
 
         /* determine the offsets of all basenames and files in this common one */
-        basenameOffset=4+8*fileCount;
+        basenameOffset=4+8*fileCount+4+4*hashLength;
         fileOffset=(basenameOffset+(basenameTotal+15))&~0xf;
         for(i=0; i<fileCount; ++i) {
             files[i].fileOffset=fileOffset;
@@ -251,11 +288,18 @@ createCommonDataFile(const char *destDir, const char *name, const char *entrypoi
             udata_write32(out, files[i].fileOffset);
         }
 
+        /* write the ToC hash index */
+        udata_write32(out, hashLength);
+        for(i=0; i<hashLength; ++i) {
+            udata_write32(out, hashSlots[i]);
+        }
+        uprv_free(hashSlots);
+
         /* write the basenames */
         for(i=0; i<fileCount; ++i) {
             udata_writeString(out, files[i].basename, files[i].basenameLength);
         }
-        length=4+8*fileCount+basenameTotal;
+        length=4+8*fileCount+4+4*hashLength+basenameTotal;
 
         /* copy the files */
         for(i=0; i<fileCount; ++i) {